@@ -4,6 +4,8 @@
 #include "AudioIOTypes.h"
 #include "AudioIOTypesFwd.h"
 
+#include <cstdint>
+
 namespace audio_io {
 
 using AudioCallback = void (*)(AudioBuffer buffer, void *context);
@@ -16,4 +18,31 @@ PLATFORM_START(startAudioSession);
 PLATFORM_STOP(stopAudioSession);
 PLATFORM_CLEANUP(cleanupAudioSession);
 
+// ==== Devices ====
+// Fills up to _maxDevices_ output devices, returns how many there are
+uint32_t listOutputDevices(DeviceInfo *devices, uint32_t maxDevices);
+
+// First output device whose name contains _name_ (DEFAULT_DEVICE_ID if none)
+uint32_t findOutputDevice(const char *name);
+
+// Device + buffer latency of a set up session (zeroed if unknown)
+DeviceLatency getDeviceLatency(hAudioSession sessionPtr);
+
+// Callback counts/timing, any thread (Backend::Null, see CallbackStats)
+CallbackStats getCallbackStats(hAudioSession sessionPtr);
+
+// ==== Audio Workgroup ====
+/* Helper threads that render for the IO callback (voice workers) join the
+ * device's os_workgroup: the scheduler then treats them as part of the IO
+ * thread's deadline (same cores/clusters, not just high priority)
+ * - call join on the thread itself; it also gets a real-time time
+ *   constraint policy for the session's buffer period
+ * - the membership keeps the workgroup alive until leave (even past cleanup)
+ * - returns nullptr where unsupported (macOS < 11, other platforms)
+ */
+hWorkgroupMembership joinAudioWorkgroup(hAudioSession sessionPtr);
+
+// Same thread that joined. nullptr is a no-op
+void leaveAudioWorkgroup(hWorkgroupMembership membership);
+
 } // namespace audio_io
@@ -7,18 +7,101 @@ namespace audio_io {
 inline constexpr uint32_t DEFAULT_SAMPLE_RATE = 48000;
 inline constexpr uint32_t DEFAULT_FRAMES = 512;
 inline constexpr uint16_t DEFAULT_CHANNELS = 2;
+inline constexpr uint32_t DEFAULT_DEVICE_ID = 0; // follow the system default
+inline constexpr uint32_t MAX_DEVICE_NAME = 128;
 
 enum class BufferFormat {
   NonInterleaved, // channels in separate arrays [LLLL] [RRRR]
   Interleaved,    // channels interwoven in single array [LRLRLRLR]
 };
 
+enum class Backend {
+  Device, // the platform's audio device (CoreAudio/ALSA)
+  Null,   // no device: a background thread calls back (CI, throughput runs)
+};
+
+/* Null backend, a deterministic clock instead of a device
+ * - paced: each callback waits for its buffer's deadline (start time +
+ *   frames so far / sampleRate), so it runs at real time without drift
+ * - free-running: callbacks back to back, as fast as the callback allows
+ */
+struct NullOptions {
+  bool isPaced = true;
+
+  // Stop calling back after this many frames, rounded up to whole buffers
+  // (0: until stopAudioSession). See CallbackStats::isFinished
+  uint64_t lengthFrames = 0;
+
+  // Also write the output here: raw interleaved 32-bit float, host byte
+  // order (e.g. sox -t f32 -r 48000 -c 2 out.f32 out.wav)
+  const char *outputPath = nullptr;
+};
+
 // --- Shared Types ---
 struct Config {
   uint32_t sampleRate = DEFAULT_SAMPLE_RATE;
   uint32_t numFrames = DEFAULT_FRAMES;
   uint16_t numChannels = DEFAULT_CHANNELS;
   BufferFormat bufferFormat = BufferFormat::NonInterleaved;
+
+  // Output device (DeviceInfo::id). numFrames is negotiated with it: the
+  // closest buffer size it accepts is used and written back here
+  uint32_t deviceId = DEFAULT_DEVICE_ID;
+
+  Backend backend = Backend::Device;
+  NullOptions nullOptions{}; // Backend::Null only
+};
+
+struct DeviceInfo {
+  uint32_t id = DEFAULT_DEVICE_ID;
+  char name[MAX_DEVICE_NAME] = {};
+  uint32_t numOutputChannels = 0;
+  double sampleRate = 0.0; // nominal
+
+  // Buffer sizes the hardware accepts (frames)
+  uint32_t minFrames = 0;
+  uint32_t maxFrames = 0;
+
+  bool isDefault = false;
+};
+
+/* Output latency of a running session, frames at the device sample rate
+ * - buffer: the negotiated IO buffer
+ * - device/stream: driver and hardware (DAC, transport) latency
+ * - safetyOffset: how far ahead of the hardware the driver writes
+ */
+struct DeviceLatency {
+  uint32_t deviceId = DEFAULT_DEVICE_ID;
+  double sampleRate = 0.0;
+
+  uint32_t bufferFrames = 0;
+  uint32_t deviceFrames = 0;
+  uint32_t streamFrames = 0;
+  uint32_t safetyOffsetFrames = 0;
+
+  double totalSeconds = 0.0; // sum of the above
+};
+
+/* Callback timing of a running session (Backend::Null only, zeroed for
+ * devices)
+ * - streamSeconds: frames called back / sampleRate (the backend's clock)
+ * - wallSeconds: real time since start (free-running: stream/wall is the
+ *   real-time factor)
+ */
+struct CallbackStats {
+  uint64_t callbackCount = 0;
+  uint64_t framesRendered = 0;
+  double streamSeconds = 0.0;
+  double wallSeconds = 0.0;
+
+  // Time spent in the callback
+  double averageCallbackUs = 0.0;
+  double maxCallbackUs = 0.0;
+
+  // Paced: callbacks that returned after their buffer's deadline
+  uint32_t lateCount = 0;
+
+  bool isFinished = false; // NullOptions::lengthFrames reached
 };
 
 struct AudioBuffer {
@@ -30,6 +113,11 @@ struct AudioBuffer {
     float **channelPtrs; // Non-Interleaved (Planar)
     float *interleavedPtr;
   };
+
+  // Host time (steady_clock ns) the first frame is expected to leave the
+  // output (device/driver latency included), set by the backend on every
+  // callback. 0 = unknown
+  uint64_t outputTime = 0;
 };
 
 } // namespace audio_io
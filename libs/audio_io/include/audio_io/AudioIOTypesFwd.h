@@ -4,8 +4,14 @@ namespace audio_io {
 // --- Shared Types ---
 struct Config;
 struct AudioBuffer;
+struct DeviceInfo;
+struct DeviceLatency;
+struct CallbackStats;
 
 struct AudioSession;
 using hAudioSession = AudioSession *;
 
+struct WorkgroupMembership;
+using hWorkgroupMembership = WorkgroupMembership *;
+
 } // namespace audio_io
@@ -1,16 +1,55 @@
 #include "audio_io/AudioIO.h"
-#include "adapters/core_audio/CoreAudioAdapter.h"
+#include "adapters/null/NullAdapter.h"
 #include "audio_io/AudioIOTypes.h"
 #include "shared/AudioSession.h"
 
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 
-// TODO(nico): This is where platform choice needs to occur
+// Platform choice happens at build time (AUDIO_BACKEND in the Makefile)
+#if AUDIO_IO_ALSA
+#include "adapters/alsa/AlsaAdapter.h"
+#else
+#include "adapters/core_audio/CoreAudioAdapter.h"
+#endif
 
 namespace audio_io {
 
+// ==== <Platform Helpers> ====
+namespace {
+#if AUDIO_IO_ALSA
+constexpr auto platformSetup = AlsaAdapter::alsaSetup;
+constexpr auto platformStart = AlsaAdapter::alsaStart;
+constexpr auto platformStop = AlsaAdapter::alsaStop;
+constexpr auto platformCleanup = AlsaAdapter::alsaCleanup;
+constexpr auto platformListDevices = AlsaAdapter::alsaListDevices;
+constexpr auto platformLatency = AlsaAdapter::alsaLatency;
+
+// No audio workgroups on Linux (workers keep their SCHED_FIFO priority)
+hWorkgroupMembership platformJoinWorkgroup(hAudioSession) { return nullptr; }
+void platformLeaveWorkgroup(hWorkgroupMembership) {}
+#else
+constexpr auto platformSetup = CoreAudioAdapter::coreAudioSetup;
+constexpr auto platformStart = CoreAudioAdapter::coreAudioStart;
+constexpr auto platformStop = CoreAudioAdapter::coreAudioStop;
+constexpr auto platformCleanup = CoreAudioAdapter::coreAudioCleanup;
+constexpr auto platformListDevices = CoreAudioAdapter::coreAudioListDevices;
+constexpr auto platformLatency = CoreAudioAdapter::coreAudioLatency;
+constexpr auto platformJoinWorkgroup =
+    CoreAudioAdapter::coreAudioJoinWorkgroup;
+constexpr auto platformLeaveWorkgroup =
+    CoreAudioAdapter::coreAudioLeaveWorkgroup;
+#endif
+
+// Config::backend, fixed for the session's lifetime
+bool isNullBackend(hAudioSession sessionPtr) {
+  return sessionPtr->userConfig.backend == Backend::Null;
+}
+} // namespace
+// ==== </Platform Helpers> ====
+
 hAudioSession setupAudioSession(const Config &userConfig,
                                 AudioCallback userCallback, void *userContext) {
 
@@ -22,8 +61,9 @@ hAudioSession setupAudioSession(const Config &userConfig,
   sessionPtr->userCallback = userCallback;
   sessionPtr->userContext = userContext;
 
-  // Get/Create platform context (CoreAudio for now.  more to come...)
-  int errCode = CoreAudioAdapter::coreAudioSetup(sessionPtr);
+  // Get/Create platform context
+  int errCode = isNullBackend(sessionPtr) ? NullAdapter::nullSetup(sessionPtr)
+                                          : platformSetup(sessionPtr);
   if (errCode) {
     printf("Platform setup failed: %d", errCode);
     delete sessionPtr;
@@ -53,6 +93,9 @@ hAudioSession setupAudioSession(const Config &userConfig,
 
     for (size_t i = 0; i < numChannels; i++)
       buffer.channelPtrs[i] = sessionPtr->bufferMemory + (numFrames * i);
+
+    // Zero-copy pointers (filled by the platform callback)
+    sessionPtr->nativeChannelPtrs = new float *[numChannels]();
   } else {
 
     // Interleaved == single buffer with interwoven channels (Wide Frame)
@@ -65,7 +108,9 @@ hAudioSession setupAudioSession(const Config &userConfig,
 }
 
 int startAudioSession(hAudioSession sessionPtr) {
-  int errCode = CoreAudioAdapter::coreAudioStart(sessionPtr);
+  int errCode = isNullBackend(sessionPtr)
+                    ? NullAdapter::nullStart(sessionPtr)
+                    : platformStart(sessionPtr);
   if (errCode) {
     printf("Platform audio start failed: %d", errCode);
     return errCode;
@@ -74,7 +119,9 @@ int startAudioSession(hAudioSession sessionPtr) {
 }
 
 int stopAudioSession(hAudioSession sessionPtr) {
-  int errCode = CoreAudioAdapter::coreAudioStop(sessionPtr);
+  int errCode = isNullBackend(sessionPtr)
+                    ? NullAdapter::nullStop(sessionPtr)
+                    : platformStop(sessionPtr);
   if (errCode) {
     printf("Platform audio stop failed: %d", errCode);
     return errCode;
@@ -83,18 +130,68 @@ int stopAudioSession(hAudioSession sessionPtr) {
 }
 
 int cleanupAudioSession(hAudioSession sessionPtr) {
-  int errCode = CoreAudioAdapter::coreAudioCleanup(sessionPtr);
+  int errCode = isNullBackend(sessionPtr)
+                    ? NullAdapter::nullCleanup(sessionPtr)
+                    : platformCleanup(sessionPtr);
   if (errCode) {
     printf("Platform cleanup failed: %d", errCode);
     return errCode;
   }
 
-  if (sessionPtr->buffer.format == BufferFormat::NonInterleaved)
+  if (sessionPtr->buffer.format == BufferFormat::NonInterleaved) {
     delete[] sessionPtr->buffer.channelPtrs;
+    delete[] sessionPtr->nativeChannelPtrs;
+  }
 
   delete[] sessionPtr->bufferMemory;
   delete sessionPtr;
   return 0;
 }
 
+// ==== Devices ====
+uint32_t listOutputDevices(DeviceInfo *devices, uint32_t maxDevices) {
+  return platformListDevices(devices, maxDevices);
+}
+
+uint32_t findOutputDevice(const char *name) {
+  constexpr uint32_t MAX_LISTED = 64;
+  DeviceInfo devices[MAX_LISTED];
+
+  uint32_t count = listOutputDevices(devices, MAX_LISTED);
+  if (count > MAX_LISTED)
+    count = MAX_LISTED;
+
+  for (uint32_t i = 0; i < count; i++) {
+    if (std::strstr(devices[i].name, name))
+      return devices[i].id;
+  }
+
+  return DEFAULT_DEVICE_ID;
+}
+
+DeviceLatency getDeviceLatency(hAudioSession sessionPtr) {
+  if (!sessionPtr)
+    return {};
+  if (isNullBackend(sessionPtr))
+    return NullAdapter::nullLatency(sessionPtr);
+  return platformLatency(sessionPtr);
+}
+
+CallbackStats getCallbackStats(hAudioSession sessionPtr) {
+  if (!sessionPtr || !isNullBackend(sessionPtr))
+    return {};
+  return NullAdapter::nullStats(sessionPtr);
+}
+
+// ==== Audio Workgroup ====
+hWorkgroupMembership joinAudioWorkgroup(hAudioSession sessionPtr) {
+  if (!sessionPtr || isNullBackend(sessionPtr))
+    return nullptr;
+  return platformJoinWorkgroup(sessionPtr);
+}
+
+void leaveAudioWorkgroup(hWorkgroupMembership membership) {
+  platformLeaveWorkgroup(membership);
+}
+
 } // namespace audio_io
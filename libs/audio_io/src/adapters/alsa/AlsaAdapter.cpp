@@ -0,0 +1,498 @@
+#include <alsa/asoundlib.h>
+
+#include "AlsaAdapter.h"
+#include "audio_io/AudioIOTypes.h"
+#include "shared/AudioSession.h"
+
+// Trace scopes: the only synth_io dependency of audio_io
+#include "synth_io/Trace.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace AlsaAdapter {
+
+// Periods in the device ring (2: one playing, one being rendered)
+constexpr unsigned int NUM_PERIODS = 2;
+
+// snd_pcm_wait timeout, only matters when the device stalls
+constexpr int WAIT_MS = 100;
+
+// Private to this file - no one else sees this type
+struct AlsaContext {
+  snd_pcm_t *pcm = nullptr;
+
+  // Negotiated native layout (mmap areas)
+  snd_pcm_format_t format = SND_PCM_FORMAT_FLOAT_LE;
+  bool isInterleaved = false;
+  uint32_t periodFrames = 0;
+  uint32_t bufferFrames = 0;
+  uint32_t sampleRate = 0;
+
+  std::thread ioThread{};
+  std::atomic<bool> isRunning{false};
+  std::atomic<uint32_t> xrunCount{0};
+};
+
+// ============ (Format Helpers) ============
+namespace {
+// Preferred first: float is the only zero-copy format
+constexpr snd_pcm_format_t FORMATS[] = {
+    SND_PCM_FORMAT_FLOAT_LE,
+    SND_PCM_FORMAT_S32_LE,
+    SND_PCM_FORMAT_S16_LE,
+};
+
+void encodeSample(float value, snd_pcm_format_t format, uint8_t *dst) {
+  if (format == SND_PCM_FORMAT_FLOAT_LE) {
+    std::memcpy(dst, &value, sizeof(value));
+    return;
+  }
+
+  double clamped = value < -1.0f ? -1.0 : value > 1.0f ? 1.0 : value;
+  if (format == SND_PCM_FORMAT_S32_LE) {
+    auto pcm = static_cast<int32_t>(clamped * 2147483647.0);
+    std::memcpy(dst, &pcm, sizeof(pcm));
+  } else {
+    auto pcm = static_cast<int16_t>(clamped * 32767.0);
+    std::memcpy(dst, &pcm, sizeof(pcm));
+  }
+}
+
+uint8_t *areaFrame(const snd_pcm_channel_area_t &area,
+                   snd_pcm_uframes_t frame) {
+  return static_cast<uint8_t *>(area.addr) + area.first / 8 +
+         frame * (area.step / 8);
+}
+
+/* Float areas laid out exactly like the session buffer: render in place
+ * - planar: each channel its own packed float run
+ * - interleaved: one run, channels at consecutive floats
+ */
+bool isZeroCopy(const AlsaContext &ctx, const audio_io::AudioBuffer &buffer,
+                const snd_pcm_channel_area_t *areas) {
+  if (ctx.format != SND_PCM_FORMAT_FLOAT_LE)
+    return false;
+
+  bool isSessionInterleaved =
+      buffer.format == audio_io::BufferFormat::Interleaved;
+  if (ctx.isInterleaved != isSessionInterleaved)
+    return false;
+
+  const unsigned int frameBits =
+      32 * (ctx.isInterleaved ? buffer.numChannels : 1);
+
+  for (uint32_t ch = 0; ch < buffer.numChannels; ch++) {
+    if (areas[ch].step != frameBits || areas[ch].first % 32 != 0)
+      return false;
+    if (ctx.isInterleaved &&
+        (areas[ch].addr != areas[0].addr || areas[ch].first != 32 * ch))
+      return false;
+  }
+
+  return true;
+}
+
+// Session buffer -> mmap areas (any layout/format the device took)
+void copyToAreas(const AlsaContext &ctx, const audio_io::AudioBuffer &buffer,
+                 const snd_pcm_channel_area_t *areas,
+                 snd_pcm_uframes_t offset, uint32_t numFrames) {
+  for (uint32_t ch = 0; ch < buffer.numChannels; ch++) {
+    for (uint32_t i = 0; i < numFrames; i++) {
+      float value = buffer.format == audio_io::BufferFormat::Interleaved
+                        ? buffer.interleavedPtr[i * buffer.numChannels + ch]
+                        : buffer.channelPtrs[ch][i];
+      encodeSample(value, ctx.format, areaFrame(areas[ch], offset + i));
+    }
+  }
+}
+
+// ============ (PCM Helpers) ============
+// Config::deviceId -> PCM name ("default" can be overridden for headless
+// boxes, e.g. SYNTH_ALSA_DEVICE=hw:1,0)
+void getPcmName(uint32_t deviceId, char *name, size_t size) {
+  if (deviceId == audio_io::DEFAULT_DEVICE_ID) {
+    const char *override = std::getenv("SYNTH_ALSA_DEVICE");
+    snprintf(name, size, "%s", override ? override : "default");
+    return;
+  }
+
+  snprintf(name, size, "hw:%u,0", deviceId - 1);
+}
+
+/* Negotiate mmap access, format, channels, rate and period size
+ * - prefers the session's layout (zero copy), then the other one
+ * - the period size the device took is written back to config.numFrames
+ */
+int configurePcm(AlsaContext &ctx, audio_io::Config &config) {
+  snd_pcm_t *pcm = ctx.pcm;
+
+  snd_pcm_hw_params_t *hwParams = nullptr;
+  snd_pcm_hw_params_alloca(&hwParams);
+  snd_pcm_hw_params_any(pcm, hwParams);
+
+  bool wantsInterleaved =
+      config.bufferFormat == audio_io::BufferFormat::Interleaved;
+  snd_pcm_access_t preferred = wantsInterleaved
+                                   ? SND_PCM_ACCESS_MMAP_INTERLEAVED
+                                   : SND_PCM_ACCESS_MMAP_NONINTERLEAVED;
+  snd_pcm_access_t fallback = wantsInterleaved
+                                  ? SND_PCM_ACCESS_MMAP_NONINTERLEAVED
+                                  : SND_PCM_ACCESS_MMAP_INTERLEAVED;
+
+  if (snd_pcm_hw_params_set_access(pcm, hwParams, preferred) == 0) {
+    ctx.isInterleaved = wantsInterleaved;
+  } else if (snd_pcm_hw_params_set_access(pcm, hwParams, fallback) == 0) {
+    ctx.isInterleaved = !wantsInterleaved;
+  } else {
+    printf("ALSA: device has no mmap access\n");
+    return 1;
+  }
+
+  bool hasFormat = false;
+  for (snd_pcm_format_t format : FORMATS) {
+    if (snd_pcm_hw_params_set_format(pcm, hwParams, format) == 0) {
+      ctx.format = format;
+      hasFormat = true;
+      break;
+    }
+  }
+  if (!hasFormat) {
+    printf("ALSA: no float/S32/S16 sample format\n");
+    return 2;
+  }
+
+  int err = snd_pcm_hw_params_set_channels(pcm, hwParams, config.numChannels);
+  if (err < 0) {
+    printf("ALSA: %u channels unsupported: %s\n", config.numChannels,
+           snd_strerror(err));
+    return 3;
+  }
+
+  unsigned int rate = config.sampleRate;
+  snd_pcm_hw_params_set_rate_near(pcm, hwParams, &rate, nullptr);
+  if (rate != config.sampleRate)
+    printf("Warning: device runs at %u Hz, session at %u Hz\n", rate,
+           config.sampleRate);
+
+  snd_pcm_uframes_t periodFrames = config.numFrames;
+  snd_pcm_hw_params_set_period_size_near(pcm, hwParams, &periodFrames,
+                                         nullptr);
+
+  unsigned int periods = NUM_PERIODS;
+  snd_pcm_hw_params_set_periods_near(pcm, hwParams, &periods, nullptr);
+
+  err = snd_pcm_hw_params(pcm, hwParams);
+  if (err < 0) {
+    printf("ALSA: unable to apply hw params: %s\n", snd_strerror(err));
+    return 4;
+  }
+
+  snd_pcm_uframes_t bufferFrames = 0;
+  snd_pcm_hw_params_get_period_size(hwParams, &periodFrames, nullptr);
+  snd_pcm_hw_params_get_buffer_size(hwParams, &bufferFrames);
+
+  // Wake once a period is free, start playing once the ring is full
+  snd_pcm_sw_params_t *swParams = nullptr;
+  snd_pcm_sw_params_alloca(&swParams);
+  snd_pcm_sw_params_current(pcm, swParams);
+  snd_pcm_sw_params_set_avail_min(pcm, swParams, periodFrames);
+  snd_pcm_sw_params_set_start_threshold(pcm, swParams, bufferFrames);
+
+  err = snd_pcm_sw_params(pcm, swParams);
+  if (err < 0) {
+    printf("ALSA: unable to apply sw params: %s\n", snd_strerror(err));
+    return 5;
+  }
+
+  ctx.periodFrames = static_cast<uint32_t>(periodFrames);
+  ctx.bufferFrames = static_cast<uint32_t>(bufferFrames);
+  ctx.sampleRate = rate;
+
+  if (ctx.periodFrames != config.numFrames)
+    printf("Audio buffer: %u frames (requested %u)\n", ctx.periodFrames,
+           config.numFrames);
+
+  // NOTE: AudioIO allocates the session buffer from this
+  config.numFrames = ctx.periodFrames;
+  return 0;
+}
+
+// Underrun/suspend: back to PREPARED, the IO loop refills and restarts
+void recoverPcm(AlsaContext &ctx, int err) {
+  ctx.xrunCount.fetch_add(1, std::memory_order_relaxed);
+  snd_pcm_recover(ctx.pcm, err, 1);
+}
+
+// Frames queued ahead of the next write -> AudioBuffer::outputTime
+uint64_t getOutputTime(const AlsaContext &ctx) {
+  snd_pcm_sframes_t delay = 0;
+  if (ctx.sampleRate == 0 || snd_pcm_delay(ctx.pcm, &delay) < 0 || delay < 0)
+    return 0;
+
+  auto now = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+  return now + static_cast<uint64_t>(static_cast<double>(delay) /
+                                     static_cast<double>(ctx.sampleRate) *
+                                     1.0e9);
+}
+
+// ============ (IO Thread) ============
+// Best effort: needs CAP_SYS_NICE / rtprio limits, stays normal otherwise
+void setIoThreadPriority() {
+  sched_param param{};
+  param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+  pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+}
+
+/* One period: render straight into the mmap areas when the layout allows
+ * (zero copy), otherwise into bufferMemory and convert
+ */
+void renderPeriod(audio_io::hAudioSession sessionPtr, AlsaContext &ctx) {
+  SYNTH_TRACE_SCOPE("nativeCallback");
+
+  const snd_pcm_channel_area_t *areas = nullptr;
+  snd_pcm_uframes_t offset = 0;
+  snd_pcm_uframes_t frames = ctx.periodFrames;
+
+  int err = snd_pcm_mmap_begin(ctx.pcm, &areas, &offset, &frames);
+  if (err < 0) {
+    recoverPcm(ctx, err);
+    return;
+  }
+
+  // Contiguous frames can be short at the ring's end (never more)
+  const audio_io::AudioBuffer &buffer = sessionPtr->buffer;
+  auto numFrames = static_cast<uint32_t>(frames);
+  if (numFrames > buffer.numFrames)
+    numFrames = buffer.numFrames;
+
+  uint64_t outputTime = getOutputTime(ctx);
+
+  if (isZeroCopy(ctx, buffer, areas)) {
+    audio_io::AudioBuffer nativeBuffer{buffer};
+    nativeBuffer.numFrames = numFrames;
+    nativeBuffer.outputTime = outputTime;
+
+    if (ctx.isInterleaved) {
+      nativeBuffer.interleavedPtr =
+          reinterpret_cast<float *>(areaFrame(areas[0], offset));
+    } else {
+      for (uint32_t ch = 0; ch < buffer.numChannels; ch++)
+        sessionPtr->nativeChannelPtrs[ch] =
+            reinterpret_cast<float *>(areaFrame(areas[ch], offset));
+      nativeBuffer.channelPtrs = sessionPtr->nativeChannelPtrs;
+    }
+
+    sessionPtr->userCallback(nativeBuffer, sessionPtr->userContext);
+  } else {
+    audio_io::AudioBuffer userBuffer{buffer};
+    userBuffer.numFrames = numFrames;
+    userBuffer.outputTime = outputTime;
+    sessionPtr->userCallback(userBuffer, sessionPtr->userContext);
+
+    SYNTH_TRACE_SCOPE("copyToDevice");
+    copyToAreas(ctx, userBuffer, areas, offset, numFrames);
+  }
+
+  snd_pcm_sframes_t committed = snd_pcm_mmap_commit(ctx.pcm, offset, numFrames);
+  if (committed < 0 || static_cast<uint32_t>(committed) != numFrames)
+    recoverPcm(ctx, committed < 0 ? static_cast<int>(committed) : -EPIPE);
+}
+
+void ioLoop(audio_io::hAudioSession sessionPtr) {
+  auto *ctx = static_cast<AlsaContext *>(sessionPtr->platformContext);
+
+  setIoThreadPriority();
+  synth_io::trace::setTraceThreadName("alsa io");
+
+  while (ctx->isRunning.load(std::memory_order_relaxed)) {
+    snd_pcm_sframes_t avail = snd_pcm_avail_update(ctx->pcm);
+    if (avail < 0) {
+      recoverPcm(*ctx, static_cast<int>(avail));
+      continue;
+    }
+
+    if (static_cast<snd_pcm_uframes_t>(avail) < ctx->periodFrames) {
+      // Ring full after (re)filling: start playback
+      if (snd_pcm_state(ctx->pcm) == SND_PCM_STATE_PREPARED) {
+        snd_pcm_start(ctx->pcm);
+        continue;
+      }
+
+      int err = snd_pcm_wait(ctx->pcm, WAIT_MS);
+      if (err < 0)
+        recoverPcm(*ctx, err);
+      continue;
+    }
+
+    renderPeriod(sessionPtr, *ctx);
+  }
+}
+
+} // namespace
+
+/* ============ (ALSA Setup/Init) ============
+ * Opens the PCM for Config::deviceId and negotiates an mmap layout. The
+ * device is driven by our own IO thread (started in alsaStart): it waits
+ * for a free period, renders into the mmap'd ring and commits.
+ */
+int alsaSetup(audio_io::hAudioSession sessionPtr) {
+  char pcmName[64];
+  getPcmName(sessionPtr->userConfig.deviceId, pcmName, sizeof(pcmName));
+
+  auto *ctx = new AlsaContext{};
+
+  int err = snd_pcm_open(&ctx->pcm, pcmName, SND_PCM_STREAM_PLAYBACK, 0);
+  if (err < 0) {
+    printf("ALSA: unable to open '%s': %s\n", pcmName, snd_strerror(err));
+    delete ctx;
+    return 1;
+  }
+
+  int configErr = configurePcm(*ctx, sessionPtr->userConfig);
+  if (configErr) {
+    snd_pcm_close(ctx->pcm);
+    delete ctx;
+    return 10 + configErr;
+  }
+
+  sessionPtr->platformContext = ctx;
+  return 0;
+}
+
+// ============ (ALSA Methods) ============
+int alsaStart(audio_io::hAudioSession sessionPtr) {
+  auto *ctx = static_cast<AlsaContext *>(sessionPtr->platformContext);
+  if (!ctx) {
+    printf("Unable to [start] AudioSession");
+    return 1;
+  }
+  if (ctx->ioThread.joinable())
+    return 0;
+
+  int err = snd_pcm_prepare(ctx->pcm);
+  if (err < 0) {
+    printf("ALSA: unable to prepare: %s\n", snd_strerror(err));
+    return 2;
+  }
+
+  ctx->isRunning.store(true, std::memory_order_relaxed);
+  ctx->ioThread = std::thread(ioLoop, sessionPtr);
+  return 0;
+}
+
+int alsaStop(audio_io::hAudioSession sessionPtr) {
+  auto *ctx = static_cast<AlsaContext *>(sessionPtr->platformContext);
+  if (!ctx) {
+    printf("Unable to [stop] AudioSession");
+    return 1;
+  }
+  if (!ctx->ioThread.joinable())
+    return 0;
+
+  ctx->isRunning.store(false, std::memory_order_relaxed);
+  ctx->ioThread.join();
+  snd_pcm_drop(ctx->pcm);
+  return 0;
+}
+
+int alsaCleanup(audio_io::hAudioSession sessionPtr) {
+  auto *ctx = static_cast<AlsaContext *>(sessionPtr->platformContext);
+  if (!ctx) {
+    printf("Platform context does not exit [cleanup]");
+    return 1;
+  }
+
+  alsaStop(sessionPtr);
+  snd_pcm_close(ctx->pcm);
+
+  delete ctx;
+  sessionPtr->platformContext = nullptr;
+  return 0;
+}
+
+// ============ (Devices) ============
+uint32_t alsaListDevices(audio_io::DeviceInfo *devices,
+                         uint32_t maxDevices) {
+  uint32_t count = 0;
+  int card = -1;
+
+  while (snd_card_next(&card) == 0 && card >= 0) {
+    char pcmName[32];
+    snprintf(pcmName, sizeof(pcmName), "hw:%d,0", card);
+
+    // No playback device (or busy): skip
+    snd_pcm_t *pcm = nullptr;
+    if (snd_pcm_open(&pcm, pcmName, SND_PCM_STREAM_PLAYBACK,
+                     SND_PCM_NONBLOCK) < 0)
+      continue;
+
+    if (count < maxDevices) {
+      audio_io::DeviceInfo &info = devices[count];
+      info = {};
+      info.id = static_cast<uint32_t>(card) + 1;
+
+      char *name = nullptr;
+      if (snd_card_get_name(card, &name) == 0 && name) {
+        snprintf(info.name, sizeof(info.name), "%s", name);
+        std::free(name);
+      }
+
+      snd_pcm_hw_params_t *hwParams = nullptr;
+      snd_pcm_hw_params_alloca(&hwParams);
+      if (snd_pcm_hw_params_any(pcm, hwParams) >= 0) {
+        unsigned int maxChannels = 0;
+        snd_pcm_hw_params_get_channels_max(hwParams, &maxChannels);
+        info.numOutputChannels = maxChannels;
+
+        snd_pcm_uframes_t minFrames = 0;
+        snd_pcm_uframes_t maxFrames = 0;
+        snd_pcm_hw_params_get_period_size_min(hwParams, &minFrames, nullptr);
+        snd_pcm_hw_params_get_period_size_max(hwParams, &maxFrames, nullptr);
+        info.minFrames = static_cast<uint32_t>(minFrames);
+        info.maxFrames = static_cast<uint32_t>(maxFrames);
+      }
+    }
+
+    snd_pcm_close(pcm);
+    count++;
+  }
+
+  return count;
+}
+
+audio_io::DeviceLatency alsaLatency(audio_io::hAudioSession sessionPtr) {
+  audio_io::DeviceLatency latency{};
+  auto *ctx = static_cast<AlsaContext *>(sessionPtr->platformContext);
+  if (!ctx)
+    return latency;
+
+  latency.deviceId = sessionPtr->userConfig.deviceId;
+  latency.sampleRate = ctx->sampleRate;
+
+  // Rendered one period ahead of the one playing (+ the rest of the ring)
+  latency.bufferFrames = ctx->periodFrames;
+  latency.deviceFrames = ctx->bufferFrames - ctx->periodFrames;
+
+  if (ctx->sampleRate > 0) {
+    latency.totalSeconds = static_cast<double>(ctx->bufferFrames) /
+                           static_cast<double>(ctx->sampleRate);
+  }
+
+  return latency;
+}
+
+} // namespace AlsaAdapter
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "audio_io/AudioIOMacros.h"
+#include "audio_io/AudioIOTypesFwd.h"
+
+#include <cstdint>
+
+namespace AlsaAdapter {
+
+PLATFORM_SETUP(alsaSetup);
+PLATFORM_START(alsaStart);
+PLATFORM_STOP(alsaStop);
+PLATFORM_CLEANUP(alsaCleanup);
+
+// Sound cards (id = card index + 1, 0 stays the "default" PCM)
+uint32_t alsaListDevices(audio_io::DeviceInfo *devices, uint32_t maxDevices);
+
+audio_io::DeviceLatency alsaLatency(audio_io::hAudioSession sessionPtr);
+
+} // namespace AlsaAdapter
@@ -1,34 +1,119 @@
 #include <AudioToolbox/AudioToolbox.h>
+#include <mach/mach.h>
+#include <mach/mach_time.h>
+#include <mach/thread_policy.h>
+#include <os/workgroup.h>
+#include <pthread.h>
 
 #include "CoreAudioAdapter.h"
 #include "audio_io/AudioIOTypes.h"
 #include "shared/AudioSession.h"
 
+// Trace scopes: the only synth_io dependency of audio_io
+#include "synth_io/Trace.h"
+
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace audio_io {
+// Opaque to users (see joinAudioWorkgroup)
+struct WorkgroupMembership {
+  os_workgroup_t workgroup; // +1 from the unit, released on leave
+  os_workgroup_join_token_s token;
+};
+} // namespace audio_io
 
 namespace CoreAudioAdapter {
 
 // Private to this file - no one else sees this type
 struct CoreAudioContext {
   AudioUnit audioUnit;
+  AudioDeviceID deviceId; // device the unit renders to
+
+  // inTimeStamp -> AudioBuffer::outputTime: host ticks to ns (steady_clock
+  // reads the same clock, CLOCK_UPTIME_RAW) + the latency past the IO proc
+  // (device + stream + safety offset, measured at start)
+  double hostTicksToNs = 1.0;
+  uint64_t presentationDelayNs = 0;
 };
 
+// ============ (Conversion Helpers) ============
+namespace {
+// Planar (src) -> Planar (dst). memcpy is already vectorized
+void copyPlanar(float *const *srcPtrs, const AudioBufferList *ioData,
+                size_t numChannels, size_t numFrames) {
+  for (size_t ch = 0; ch < numChannels; ch++) {
+    auto *dstPtr = static_cast<float *>(ioData->mBuffers[ch].mData);
+    assert(dstPtr);
+    std::memcpy(dstPtr, srcPtrs[ch], numFrames * sizeof(float));
+  }
+}
+
+/* Interleaved (src) -> Planar (dst)
+ * Stereo gets its own loop: both channels are written from a single pass
+ * over src (compiles to ld2/unpck shuffles instead of a strided gather)
+ */
+void deinterleave(const float *src, size_t stride,
+                  const AudioBufferList *ioData, size_t numChannels,
+                  size_t numFrames) {
+  if (numChannels == 2 && stride == 2) {
+    auto *__restrict left = static_cast<float *>(ioData->mBuffers[0].mData);
+    auto *__restrict right = static_cast<float *>(ioData->mBuffers[1].mData);
+    assert(left && right);
+
+    for (size_t i = 0; i < numFrames; i++) {
+      left[i] = src[2 * i];
+      right[i] = src[2 * i + 1];
+    }
+    return;
+  }
+
+  for (size_t ch = 0; ch < numChannels; ch++) {
+    auto *__restrict dstPtr = static_cast<float *>(ioData->mBuffers[ch].mData);
+    const float *__restrict srcPtr = src + ch;
+    assert(dstPtr);
+
+    for (size_t i = 0; i < numFrames; i++)
+      dstPtr[i] = srcPtr[i * stride];
+  }
+}
+// 0 when Core Audio didn't give a host time
+uint64_t toOutputTime(const CoreAudioContext &ctx,
+                      const AudioTimeStamp *timeStamp) {
+  if (!timeStamp || !(timeStamp->mFlags & kAudioTimeStampHostTimeValid))
+    return 0;
+
+  return static_cast<uint64_t>(static_cast<double>(timeStamp->mHostTime) *
+                               ctx.hostTicksToNs) +
+         ctx.presentationDelayNs;
+}
+} // namespace
+
 /* ============ (Core Audio Native Callback) ============
  * This is the function signature required by Core Audio
  * Library and user logic needs to occur in here
  *
- * TODO(nico): Figure out way to pass native buffer if buffer.format
- * matches native.  Avoids copy altogether
+ * Non-Interleaved sessions match the native layout (float32, one buffer per
+ * channel) so the user callback renders straight into ioData (zero copy).
+ * Interleaved sessions render into bufferMemory and are deinterleaved after.
  */
 static OSStatus
 nativeCallback(void *inRefCon, // ← CoreAudio gives us back what we registered
                AudioUnitRenderActionFlags * /*ioActionFlags*/,
-               const AudioTimeStamp * /*inTimeStamp*/, UInt32 /*inBusNumber*/,
+               const AudioTimeStamp *inTimeStamp, UInt32 /*inBusNumber*/,
                UInt32 inNumberFrames, AudioBufferList *ioData) {
 
+  SYNTH_TRACE_SCOPE("nativeCallback");
+
   auto sessionPtr = static_cast<audio_io::hAudioSession>(inRefCon);
+  const audio_io::AudioBuffer &buffer = sessionPtr->buffer;
+  const auto *ctx =
+      static_cast<const CoreAudioContext *>(sessionPtr->platformContext);
+  uint64_t outputTime = toOutputTime(*ctx, inTimeStamp);
 
   /* NOTE(nico): ioData->mNumberBuffers value should match the number of buffer
    * pointers within AudioBuffer. These are determined during config/setup and
@@ -36,58 +121,210 @@ nativeCallback(void *inRefCon, // ← CoreAudio gives us back what we registered
    *
    * Non-Interleaved = mNumberBuffers == number of channelPtrs (aka numChannels)
    * Interleaved: mNumberBuffers == interleavedPtr (aka 1)
+   *
+   * NOTE: the native side is always planar (see configToASBD) so ioData holds
+   * numChannels buffers in both cases
    */
-
-#ifndef NDEBUG
-  assert(sessionPtr->buffer.numFrames == inNumberFrames);
-
-  if (sessionPtr->buffer.format == audio_io::BufferFormat::NonInterleaved) {
-    assert(ioData->mNumberBuffers == sessionPtr->buffer.numChannels);
-  } else {
-    assert(ioData->mNumberBuffers == 1);
+  assert(ioData->mNumberBuffers == buffer.numChannels);
+
+  // Core Audio may hand us fewer frames than configured (never more)
+  assert(inNumberFrames <= buffer.numFrames);
+  size_t numFrames =
+      inNumberFrames < buffer.numFrames ? inNumberFrames : buffer.numFrames;
+
+  if (buffer.format == audio_io::BufferFormat::NonInterleaved &&
+      ioData->mNumberBuffers == buffer.numChannels) {
+    // Zero copy: point the user buffer at Core Audio's channel buffers
+    for (size_t ch = 0; ch < buffer.numChannels; ch++)
+      sessionPtr->nativeChannelPtrs[ch] =
+          static_cast<float *>(ioData->mBuffers[ch].mData);
+
+    audio_io::AudioBuffer nativeBuffer{buffer};
+    nativeBuffer.channelPtrs = sessionPtr->nativeChannelPtrs;
+    nativeBuffer.numFrames = static_cast<uint32_t>(numFrames);
+    nativeBuffer.outputTime = outputTime;
+
+    sessionPtr->userCallback(nativeBuffer, sessionPtr->userContext);
+    return noErr;
   }
-#endif
 
-  sessionPtr->userCallback(sessionPtr->buffer, sessionPtr->userContext);
+  audio_io::AudioBuffer userBuffer{buffer};
+  userBuffer.numFrames = static_cast<uint32_t>(numFrames);
+  userBuffer.outputTime = outputTime;
+
+  sessionPtr->userCallback(userBuffer, sessionPtr->userContext);
 
   /* Copy (and convert if required) bufferMemory to Core Audio's buffer
    * NOTE: _src_ is user configurable but _dst_ is not at this time
    */
-  if (sessionPtr->buffer.format == audio_io::BufferFormat::NonInterleaved) {
-    // Non-Interleaved (src) -> Non-Interleaved (dst)
-    assert(sessionPtr->buffer.channelPtrs);
+  SYNTH_TRACE_SCOPE("copyToDevice");
+  size_t numChannels = ioData->mNumberBuffers < buffer.numChannels
+                           ? ioData->mNumberBuffers
+                           : buffer.numChannels;
+
+  if (buffer.format == audio_io::BufferFormat::NonInterleaved) {
+    // Non-Interleaved (src) -> Non-Interleaved (dst), mismatched layout only
+    assert(buffer.channelPtrs);
+    copyPlanar(buffer.channelPtrs, ioData, numChannels, numFrames);
+  } else {
+    // Interleaved (src) -> Non-Interleaved (dst)
+    assert(buffer.interleavedPtr);
+    deinterleave(buffer.interleavedPtr, buffer.numChannels, ioData,
+                 numChannels, numFrames);
+  }
 
-    for (size_t ch = 0; ch < sessionPtr->buffer.numChannels; ch++) {
-      float *dstPtr = static_cast<float *>(ioData->mBuffers[ch].mData);
-      float *srcPtr = sessionPtr->buffer.channelPtrs[ch];
+  return noErr;
+}
 
-      assert(dstPtr);
+// ============ (Device Helpers) ============
+namespace {
+// kAudioObjectPropertyElementMain (macOS 12+, same value as the old Master)
+constexpr AudioObjectPropertyElement ELEMENT_MAIN = 0;
+
+template <typename T>
+bool getProperty(AudioObjectID object, AudioObjectPropertySelector selector,
+                 AudioObjectPropertyScope scope, T &value) {
+  AudioObjectPropertyAddress address{selector, scope, ELEMENT_MAIN};
+  UInt32 size = sizeof(T);
+  return AudioObjectGetPropertyData(object, &address, 0, nullptr, &size,
+                                    &value) == noErr;
+}
 
-      for (size_t i = 0; i < sessionPtr->buffer.numFrames; i++)
-        dstPtr[i] = srcPtr[i];
-    }
-  } else {
-    // Interleaved (src) -> Non-Interleaved (dst)
-    assert(sessionPtr->buffer.interleavedPtr);
+// Variable sized properties (arrays, buffer lists)
+std::vector<uint8_t> getPropertyBytes(AudioObjectID object,
+                                      AudioObjectPropertySelector selector,
+                                      AudioObjectPropertyScope scope) {
+  AudioObjectPropertyAddress address{selector, scope, ELEMENT_MAIN};
+  UInt32 size = 0;
+  if (AudioObjectGetPropertyDataSize(object, &address, 0, nullptr, &size) !=
+      noErr)
+    return {};
+
+  std::vector<uint8_t> bytes(size);
+  if (AudioObjectGetPropertyData(object, &address, 0, nullptr, &size,
+                                 bytes.data()) != noErr)
+    return {};
+
+  bytes.resize(size);
+  return bytes;
+}
 
-    size_t stride = sessionPtr->buffer.numChannels;
+uint32_t countOutputChannels(AudioDeviceID device) {
+  std::vector<uint8_t> bytes = getPropertyBytes(
+      device, kAudioDevicePropertyStreamConfiguration,
+      kAudioObjectPropertyScopeOutput);
+  if (bytes.size() < sizeof(AudioBufferList))
+    return 0;
 
-    for (size_t ch = 0; ch < sessionPtr->buffer.numChannels; ch++) {
-      float *dstPtr = static_cast<float *>(ioData->mBuffers[ch].mData);
-      float *srcPtr = sessionPtr->buffer.interleavedPtr + ch;
+  const auto *bufferList = reinterpret_cast<const AudioBufferList *>(
+      bytes.data());
+  uint32_t numChannels = 0;
+  for (UInt32 i = 0; i < bufferList->mNumberBuffers; i++)
+    numChannels += bufferList->mBuffers[i].mNumberChannels;
 
-      assert(dstPtr);
+  return numChannels;
+}
 
-      // Fill channel
-      for (size_t i = 0; i < sessionPtr->buffer.numFrames; i++) {
-        dstPtr[i] = srcPtr[i * stride];
-      }
-    }
+void copyDeviceName(AudioDeviceID device, char *name, size_t maxLength) {
+  name[0] = '\0';
+
+  CFStringRef cfName = nullptr;
+  if (!getProperty(device, kAudioObjectPropertyName,
+                   kAudioObjectPropertyScopeGlobal, cfName) ||
+      !cfName)
+    return;
+
+  CFStringGetCString(cfName, name, static_cast<CFIndex>(maxLength),
+                     kCFStringEncodingUTF8);
+  CFRelease(cfName);
+}
+
+AudioDeviceID getDefaultOutputDevice() {
+  AudioDeviceID device = kAudioObjectUnknown;
+  getProperty(kAudioObjectSystemObject,
+              kAudioHardwarePropertyDefaultOutputDevice,
+              kAudioObjectPropertyScopeGlobal, device);
+  return device;
+}
+
+/* Smallest buffer size the device takes that is >= _requested_
+ * - clamped to kAudioDevicePropertyBufferFrameSizeRange first
+ * - a size the driver refuses (some only take powers of 2) doubles until
+ *   one sticks
+ * Returns the size the device actually runs at
+ */
+uint32_t negotiateBufferFrames(AudioDeviceID device, uint32_t requested) {
+  AudioValueRange range{};
+  if (getProperty(device, kAudioDevicePropertyBufferFrameSizeRange,
+                  kAudioObjectPropertyScopeGlobal, range)) {
+    auto minFrames = static_cast<uint32_t>(range.mMinimum);
+    auto maxFrames = static_cast<uint32_t>(range.mMaximum);
+    if (requested < minFrames)
+      requested = minFrames;
+    if (maxFrames && requested > maxFrames)
+      requested = maxFrames;
   }
 
-  return noErr;
+  AudioObjectPropertyAddress address{kAudioDevicePropertyBufferFrameSize,
+                                     kAudioObjectPropertyScopeGlobal,
+                                     ELEMENT_MAIN};
+
+  for (uint32_t frames = requested; frames && frames <= 8192; frames *= 2) {
+    UInt32 value = frames;
+    if (AudioObjectSetPropertyData(device, &address, 0, nullptr,
+                                   sizeof(value), &value) == noErr)
+      break;
+  }
+
+  UInt32 actual = requested;
+  getProperty(device, kAudioDevicePropertyBufferFrameSize,
+              kAudioObjectPropertyScopeGlobal, actual);
+  return actual;
+}
+
+uint32_t getStreamLatency(AudioDeviceID device) {
+  std::vector<uint8_t> bytes = getPropertyBytes(
+      device, kAudioDevicePropertyStreams, kAudioObjectPropertyScopeOutput);
+  if (bytes.size() < sizeof(AudioStreamID))
+    return 0;
+
+  AudioStreamID stream = kAudioObjectUnknown;
+  std::memcpy(&stream, bytes.data(), sizeof(stream));
+
+  UInt32 latency = 0;
+  getProperty(stream, kAudioStreamPropertyLatency,
+              kAudioObjectPropertyScopeGlobal, latency);
+  return latency;
 }
 
+// Joining threads run like the IO thread: period = one buffer, up to half
+// of it computing
+void setTimeConstraintPolicy(uint32_t sampleRate, uint32_t numFrames) {
+  if (sampleRate == 0 || numFrames == 0)
+    return;
+
+  mach_timebase_info_data_t timebase;
+  mach_timebase_info(&timebase);
+
+  double ticksPerNs = static_cast<double>(timebase.denom) /
+                      static_cast<double>(timebase.numer);
+  double periodNs = static_cast<double>(numFrames) /
+                    static_cast<double>(sampleRate) * 1.0e9;
+
+  thread_time_constraint_policy_data_t policy;
+  policy.period = static_cast<uint32_t>(periodNs * ticksPerNs);
+  policy.computation = static_cast<uint32_t>(periodNs * 0.5 * ticksPerNs);
+  policy.constraint = policy.period;
+  policy.preemptible = 1;
+
+  thread_policy_set(pthread_mach_thread_np(pthread_self()),
+                    THREAD_TIME_CONSTRAINT_POLICY,
+                    reinterpret_cast<thread_policy_t>(&policy),
+                    THREAD_TIME_CONSTRAINT_POLICY_COUNT);
+}
+
+} // namespace
+
 /* ============ (Config Helper) ============
  * This function is for converting the user provided config
  * data to AudioStreamBasicDescription, which is required for
@@ -116,8 +353,10 @@ AudioStreamBasicDescription configToASBD(const audio_io::Config &config) {
  * to setup and initialize Core Audio compatability and
  * will be called by AudioSession.
  *
- * TODO(nico): AudioComponentDescription should be user config
- * TODO(nico): AudioObjectGetPropertyData w\ kAudioHardwarePropertyDevices
+ * Config::deviceId picks the output device (the system default follows
+ * changes to the default, a chosen device stays put) and numFrames is
+ * negotiated with it (written back to userConfig).
+ *
  * TODO(later): handle config incompatability
  * TODO(later): error handling in general
  */
@@ -130,7 +369,11 @@ int coreAudioSetup(audio_io::hAudioSession sessionPtr) {
 
   // Give us whatever the user has as default for the
   // desired componentType (i.e. mic, speakers, soundcard, etc)
-  acDesc.componentSubType = kAudioUnitSubType_DefaultOutput;
+  // unless a device was chosen (HAL output talks to one device)
+  const uint32_t requestedDevice = sessionPtr->userConfig.deviceId;
+  acDesc.componentSubType = requestedDevice == audio_io::DEFAULT_DEVICE_ID
+                                ? kAudioUnitSubType_DefaultOutput
+                                : kAudioUnitSubType_HALOutput;
 
   // Searches plugins dir?
   acDesc.componentManufacturer = kAudioUnitManufacturer_Apple;
@@ -154,6 +397,56 @@ int coreAudioSetup(audio_io::hAudioSession sessionPtr) {
   // IMPORTANT(nico-nunez):  MUST DISPOSE __audioUnit__ ON ERROR!!!!
   // WARNING(nico-nunez):  MUST DISPOSE __audioUnit__ ON ERROR!!!!
 
+  // 3a. Select the device, negotiate its buffer size
+  AudioDeviceID deviceId = requestedDevice;
+  if (deviceId != audio_io::DEFAULT_DEVICE_ID) {
+    OSStatus deviceErr = AudioUnitSetProperty(
+        audioUnit, kAudioOutputUnitProperty_CurrentDevice,
+        kAudioUnitScope_Global, 0, &deviceId, sizeof(deviceId));
+
+    if (deviceErr) {
+      printf("Unable to select audio device %u: %i\n", deviceId, deviceErr);
+      AudioComponentInstanceDispose(audioUnit);
+      return 6;
+    }
+  } else {
+    UInt32 size = sizeof(deviceId);
+    if (AudioUnitGetProperty(audioUnit, kAudioOutputUnitProperty_CurrentDevice,
+                             kAudioUnitScope_Global, 0, &deviceId, &size))
+      deviceId = getDefaultOutputDevice();
+  }
+
+  // A device at another rate gets resampled by the unit: slices stop
+  // matching the IO buffer (and cost extra latency)
+  Float64 deviceRate = 0.0;
+  if (getProperty(deviceId, kAudioDevicePropertyNominalSampleRate,
+                  kAudioObjectPropertyScopeGlobal, deviceRate) &&
+      static_cast<uint32_t>(deviceRate) != sessionPtr->userConfig.sampleRate)
+    printf("Warning: device runs at %.0f Hz, session at %u Hz\n", deviceRate,
+           sessionPtr->userConfig.sampleRate);
+
+  uint32_t requestedFrames = sessionPtr->userConfig.numFrames;
+  uint32_t bufferFrames = negotiateBufferFrames(deviceId, requestedFrames);
+  if (bufferFrames != requestedFrames)
+    printf("Audio buffer: %u frames (requested %u)\n", bufferFrames,
+           requestedFrames);
+
+  // Renders never exceed the IO buffer (raise the slice limit if needed)
+  UInt32 maxSlice = 0;
+  UInt32 sliceSize = sizeof(maxSlice);
+  if (AudioUnitGetProperty(audioUnit, kAudioUnitProperty_MaximumFramesPerSlice,
+                           kAudioUnitScope_Global, 0, &maxSlice,
+                           &sliceSize) == noErr &&
+      maxSlice < bufferFrames) {
+    maxSlice = bufferFrames;
+    AudioUnitSetProperty(audioUnit, kAudioUnitProperty_MaximumFramesPerSlice,
+                         kAudioUnitScope_Global, 0, &maxSlice,
+                         sizeof(maxSlice));
+  }
+
+  // NOTE: AudioIO allocates the session buffer from this
+  sessionPtr->userConfig.numFrames = bufferFrames;
+
   // 4. Configure stream format
   AudioStreamBasicDescription streamDescription{
       configToASBD(sessionPtr->userConfig)};
@@ -171,6 +464,7 @@ int coreAudioSetup(audio_io::hAudioSession sessionPtr) {
   // 4a. Create and set Core Audio context to Handle context
   auto *platformContext = new CoreAudioContext{};
   platformContext->audioUnit = audioUnit;
+  platformContext->deviceId = deviceId;
 
   sessionPtr->platformContext = platformContext;
 
@@ -215,6 +509,20 @@ int coreAudioStart(audio_io::hAudioSession sessionPtr) {
     printf("Unable to [start] AudioSession");
     return 1; // TODO(nico-nunez): return better error
   }
+  mach_timebase_info_data_t timebase;
+  mach_timebase_info(&timebase);
+  ctx->hostTicksToNs = static_cast<double>(timebase.numer) /
+                       static_cast<double>(timebase.denom);
+
+  // Before the unit runs: the callback only reads it
+  audio_io::DeviceLatency latency = coreAudioLatency(sessionPtr);
+  if (latency.sampleRate > 0.0) {
+    uint32_t delayFrames = latency.deviceFrames + latency.streamFrames +
+                           latency.safetyOffsetFrames;
+    ctx->presentationDelayNs = static_cast<uint64_t>(
+        static_cast<double>(delayFrames) / latency.sampleRate * 1.0e9);
+  }
+
   return AudioOutputUnitStart(ctx->audioUnit);
 }
 
@@ -250,4 +558,139 @@ int coreAudioCleanup(audio_io::hAudioSession sessionPtr) {
   return 0;
 }
 
+// ============ (Devices) ============
+uint32_t coreAudioListDevices(audio_io::DeviceInfo *devices,
+                              uint32_t maxDevices) {
+  std::vector<uint8_t> bytes =
+      getPropertyBytes(kAudioObjectSystemObject, kAudioHardwarePropertyDevices,
+                       kAudioObjectPropertyScopeGlobal);
+
+  size_t numDevices = bytes.size() / sizeof(AudioDeviceID);
+  AudioDeviceID defaultDevice = getDefaultOutputDevice();
+  uint32_t count = 0;
+
+  for (size_t i = 0; i < numDevices; i++) {
+    AudioDeviceID device = kAudioObjectUnknown;
+    std::memcpy(&device, bytes.data() + i * sizeof(AudioDeviceID),
+                sizeof(device));
+
+    // Input only devices (mics) can't play
+    uint32_t numChannels = countOutputChannels(device);
+    if (numChannels == 0)
+      continue;
+
+    if (count < maxDevices) {
+      audio_io::DeviceInfo &info = devices[count];
+      info = {};
+      info.id = device;
+      info.numOutputChannels = numChannels;
+      info.isDefault = device == defaultDevice;
+      copyDeviceName(device, info.name, sizeof(info.name));
+
+      Float64 sampleRate = 0.0;
+      getProperty(device, kAudioDevicePropertyNominalSampleRate,
+                  kAudioObjectPropertyScopeGlobal, sampleRate);
+      info.sampleRate = sampleRate;
+
+      AudioValueRange range{};
+      if (getProperty(device, kAudioDevicePropertyBufferFrameSizeRange,
+                      kAudioObjectPropertyScopeGlobal, range)) {
+        info.minFrames = static_cast<uint32_t>(range.mMinimum);
+        info.maxFrames = static_cast<uint32_t>(range.mMaximum);
+      }
+    }
+    count++;
+  }
+
+  return count;
+}
+
+audio_io::DeviceLatency coreAudioLatency(audio_io::hAudioSession sessionPtr) {
+  audio_io::DeviceLatency latency{};
+  auto *ctx = static_cast<CoreAudioContext *>(sessionPtr->platformContext);
+  if (!ctx)
+    return latency;
+
+  AudioDeviceID device = ctx->deviceId;
+  latency.deviceId = device;
+
+  Float64 sampleRate = 0.0;
+  getProperty(device, kAudioDevicePropertyNominalSampleRate,
+              kAudioObjectPropertyScopeGlobal, sampleRate);
+  latency.sampleRate = sampleRate;
+
+  UInt32 value = 0;
+  if (getProperty(device, kAudioDevicePropertyBufferFrameSize,
+                  kAudioObjectPropertyScopeGlobal, value))
+    latency.bufferFrames = value;
+
+  value = 0;
+  if (getProperty(device, kAudioDevicePropertyLatency,
+                  kAudioObjectPropertyScopeOutput, value))
+    latency.deviceFrames = value;
+
+  value = 0;
+  if (getProperty(device, kAudioDevicePropertySafetyOffset,
+                  kAudioObjectPropertyScopeOutput, value))
+    latency.safetyOffsetFrames = value;
+
+  latency.streamFrames = getStreamLatency(device);
+
+  if (sampleRate > 0.0) {
+    uint32_t totalFrames = latency.bufferFrames + latency.deviceFrames +
+                           latency.streamFrames + latency.safetyOffsetFrames;
+    latency.totalSeconds = static_cast<double>(totalFrames) / sampleRate;
+  }
+
+  return latency;
+}
+
+// ============ (Audio Workgroup) ============
+audio_io::hWorkgroupMembership
+coreAudioJoinWorkgroup(audio_io::hAudioSession sessionPtr) {
+  auto *ctx = static_cast<CoreAudioContext *>(sessionPtr->platformContext);
+  if (!ctx)
+    return nullptr;
+
+  setTimeConstraintPolicy(sessionPtr->userConfig.sampleRate,
+                          sessionPtr->userConfig.numFrames);
+
+  if (__builtin_available(macOS 11.0, *)) {
+    os_workgroup_t workgroup = nullptr;
+    UInt32 size = sizeof(workgroup);
+    OSStatus err = AudioUnitGetProperty(
+        ctx->audioUnit, kAudioOutputUnitProperty_OSWorkgroup,
+        kAudioUnitScope_Global, 0, &workgroup, &size);
+    if (err || !workgroup)
+      return nullptr;
+
+    auto *membership = new audio_io::WorkgroupMembership{};
+    membership->workgroup = workgroup;
+
+    // Fails if the workgroup was cancelled (device went away) or this
+    // thread already is in one
+    if (os_workgroup_join(workgroup, &membership->token) != 0) {
+      os_release(workgroup);
+      delete membership;
+      return nullptr;
+    }
+
+    return membership;
+  }
+
+  return nullptr;
+}
+
+void coreAudioLeaveWorkgroup(audio_io::hWorkgroupMembership membership) {
+  if (!membership)
+    return;
+
+  if (__builtin_available(macOS 11.0, *)) {
+    os_workgroup_leave(membership->workgroup, &membership->token);
+    os_release(membership->workgroup);
+  }
+
+  delete membership;
+}
+
 } // namespace CoreAudioAdapter
@@ -5,6 +5,8 @@
 
 #include <AudioToolbox/AudioToolbox.h>
 
+#include <cstdint>
+
 namespace CoreAudioAdapter {
 
 AudioStreamBasicDescription configToASBD(const audio_io::Config &config);
@@ -14,4 +16,15 @@ PLATFORM_START(coreAudioStart);
 PLATFORM_STOP(coreAudioStop);
 PLATFORM_CLEANUP(coreAudioCleanup);
 
+// kAudioHardwarePropertyDevices, output capable devices only
+uint32_t coreAudioListDevices(audio_io::DeviceInfo *devices,
+                              uint32_t maxDevices);
+
+audio_io::DeviceLatency coreAudioLatency(audio_io::hAudioSession sessionPtr);
+
+// kAudioOutputUnitProperty_OSWorkgroup of the output unit (calling thread)
+audio_io::hWorkgroupMembership
+coreAudioJoinWorkgroup(audio_io::hAudioSession sessionPtr);
+void coreAudioLeaveWorkgroup(audio_io::hWorkgroupMembership membership);
+
 } // namespace CoreAudioAdapter
@@ -0,0 +1,266 @@
+#include "NullAdapter.h"
+#include "audio_io/AudioIOTypes.h"
+#include "shared/AudioSession.h"
+
+// Trace scopes: the only synth_io dependency of audio_io
+#include "synth_io/Trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+namespace NullAdapter {
+using SteadyClock = std::chrono::steady_clock;
+
+// Private to this file - no one else sees this type
+struct NullContext {
+  audio_io::NullOptions options{};
+  uint32_t sampleRate = 0;
+  uint16_t numChannels = 0;
+
+  // Output file (NullOptions::outputPath), planar buffers are interleaved
+  // into _interleaved_ first (numFrames * numChannels, allocated in setup)
+  FILE *outputFile = nullptr;
+  float *interleaved = nullptr;
+
+  std::thread renderThread{};
+  std::atomic<bool> isRunning{false};
+
+  // Written by the render thread only, read by getCallbackStats
+  std::atomic<uint64_t> callbackCount{0};
+  std::atomic<uint64_t> framesRendered{0};
+  std::atomic<uint64_t> callbackNs{0}; // total time in the callback
+  std::atomic<uint64_t> maxCallbackNs{0};
+  std::atomic<uint64_t> wallNs{0}; // since start (summed over restarts)
+  std::atomic<uint32_t> lateCount{0};
+  std::atomic<bool> isFinished{false};
+};
+
+// ============ (Render Helpers) ============
+namespace {
+// Stream clock: where frame _frames_ falls after the (re)start
+SteadyClock::duration framesToDuration(uint64_t frames, uint32_t sampleRate) {
+  return std::chrono::nanoseconds(
+      static_cast<int64_t>(frames * 1000000000ull / sampleRate));
+}
+
+uint64_t toNs(SteadyClock::duration duration) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+// Single writer: plain load + store, no read-modify-write
+void addRelaxed(std::atomic<uint64_t> &counter, uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+void writeOutput(NullContext &ctx, const audio_io::AudioBuffer &buffer) {
+  if (!ctx.outputFile)
+    return;
+
+  SYNTH_TRACE_SCOPE("copyToDevice");
+  const size_t numSamples = size_t{buffer.numFrames} * buffer.numChannels;
+
+  if (buffer.format == audio_io::BufferFormat::Interleaved) {
+    fwrite(buffer.interleavedPtr, sizeof(float), numSamples, ctx.outputFile);
+    return;
+  }
+
+  for (uint32_t i = 0; i < buffer.numFrames; i++)
+    for (uint32_t ch = 0; ch < buffer.numChannels; ch++)
+      ctx.interleaved[i * buffer.numChannels + ch] = buffer.channelPtrs[ch][i];
+
+  fwrite(ctx.interleaved, sizeof(float), numSamples, ctx.outputFile);
+}
+
+/* Calls back until stopped (or lengthFrames is reached)
+ * - paced: buffer k starts at startTime + k * numFrames / sampleRate
+ *   (absolute deadlines: a late callback doesn't shift the ones after it)
+ */
+void renderLoop(audio_io::hAudioSession sessionPtr) {
+  auto *ctx = static_cast<NullContext *>(sessionPtr->platformContext);
+  // Copy: outputTime is set per callback
+  audio_io::AudioBuffer buffer{sessionPtr->buffer};
+  const uint64_t lengthFrames = ctx->options.lengthFrames;
+
+  synth_io::trace::setTraceThreadName("null io");
+
+  const SteadyClock::time_point startTime = SteadyClock::now();
+  const uint64_t startFrames =
+      ctx->framesRendered.load(std::memory_order_relaxed);
+  const uint64_t startWallNs = ctx->wallNs.load(std::memory_order_relaxed);
+  uint64_t frames = startFrames;
+
+  while (ctx->isRunning.load(std::memory_order_relaxed)) {
+    if (lengthFrames && frames >= lengthFrames) {
+      ctx->isFinished.store(true, std::memory_order_release);
+      break;
+    }
+
+    if (ctx->options.isPaced)
+      std::this_thread::sleep_until(
+          startTime + framesToDuration(frames - startFrames, ctx->sampleRate));
+
+    SteadyClock::time_point callbackStart = SteadyClock::now();
+
+    // No device: "played" as soon as it's rendered
+    buffer.outputTime = toNs(callbackStart.time_since_epoch());
+    {
+      SYNTH_TRACE_SCOPE("nativeCallback");
+      sessionPtr->userCallback(buffer, sessionPtr->userContext);
+    }
+    SteadyClock::time_point callbackEnd = SteadyClock::now();
+
+    frames += buffer.numFrames;
+    if (ctx->options.isPaced &&
+        callbackEnd > startTime + framesToDuration(frames - startFrames,
+                                                   ctx->sampleRate))
+      ctx->lateCount.store(ctx->lateCount.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_relaxed);
+
+    writeOutput(*ctx, buffer);
+
+    uint64_t callbackNs = toNs(callbackEnd - callbackStart);
+    if (callbackNs > ctx->maxCallbackNs.load(std::memory_order_relaxed))
+      ctx->maxCallbackNs.store(callbackNs, std::memory_order_relaxed);
+
+    addRelaxed(ctx->callbackNs, callbackNs);
+    addRelaxed(ctx->callbackCount, 1);
+    ctx->wallNs.store(startWallNs + toNs(callbackEnd - startTime),
+                      std::memory_order_relaxed);
+    ctx->framesRendered.store(frames, std::memory_order_release);
+  }
+}
+
+} // namespace
+
+/* ============ (Null Setup/Init) ============
+ * No device: buffers are rendered by our own thread (started in nullStart)
+ * on the NullOptions clock. The session's config is used as is.
+ */
+int nullSetup(audio_io::hAudioSession sessionPtr) {
+  const audio_io::Config &config = sessionPtr->userConfig;
+  if (config.sampleRate == 0 || config.numFrames == 0 ||
+      config.numChannels == 0) {
+    printf("Null backend: invalid config\n");
+    return 1;
+  }
+
+  auto *ctx = new NullContext{};
+  ctx->options = config.nullOptions;
+  ctx->sampleRate = config.sampleRate;
+  ctx->numChannels = config.numChannels;
+
+  if (ctx->options.outputPath) {
+    ctx->outputFile = fopen(ctx->options.outputPath, "wb");
+    if (!ctx->outputFile) {
+      printf("Null backend: unable to open %s\n", ctx->options.outputPath);
+      delete ctx;
+      return 2;
+    }
+
+    ctx->interleaved = new float[config.numFrames * config.numChannels]();
+  }
+
+  sessionPtr->platformContext = ctx;
+  return 0;
+}
+
+// ============ (Null Methods) ============
+int nullStart(audio_io::hAudioSession sessionPtr) {
+  auto *ctx = static_cast<NullContext *>(sessionPtr->platformContext);
+  if (!ctx) {
+    printf("Unable to [start] AudioSession");
+    return 1;
+  }
+  if (ctx->renderThread.joinable())
+    return 0;
+
+  ctx->isRunning.store(true, std::memory_order_relaxed);
+  ctx->renderThread = std::thread(renderLoop, sessionPtr);
+  return 0;
+}
+
+int nullStop(audio_io::hAudioSession sessionPtr) {
+  auto *ctx = static_cast<NullContext *>(sessionPtr->platformContext);
+  if (!ctx) {
+    printf("Unable to [stop] AudioSession");
+    return 1;
+  }
+  if (!ctx->renderThread.joinable())
+    return 0;
+
+  ctx->isRunning.store(false, std::memory_order_relaxed);
+  ctx->renderThread.join();
+
+  if (ctx->outputFile)
+    fflush(ctx->outputFile);
+  return 0;
+}
+
+int nullCleanup(audio_io::hAudioSession sessionPtr) {
+  auto *ctx = static_cast<NullContext *>(sessionPtr->platformContext);
+  if (!ctx) {
+    printf("Platform context does not exit [cleanup]");
+    return 1;
+  }
+
+  nullStop(sessionPtr);
+
+  // NOTE: reported only, the session is still torn down
+  if (ctx->outputFile) {
+    bool hasWriteError = ferror(ctx->outputFile) != 0;
+    if (fclose(ctx->outputFile) != 0 || hasWriteError)
+      printf("Null backend: error writing %s\n", ctx->options.outputPath);
+  }
+
+  delete[] ctx->interleaved;
+  delete ctx;
+  sessionPtr->platformContext = nullptr;
+  return 0;
+}
+
+// ============ (Stats) ============
+audio_io::DeviceLatency nullLatency(audio_io::hAudioSession sessionPtr) {
+  audio_io::DeviceLatency latency{};
+  const audio_io::Config &config = sessionPtr->userConfig;
+
+  latency.sampleRate = config.sampleRate;
+  latency.bufferFrames = config.numFrames;
+  latency.totalSeconds = static_cast<double>(config.numFrames) /
+                         static_cast<double>(config.sampleRate);
+  return latency;
+}
+
+audio_io::CallbackStats nullStats(audio_io::hAudioSession sessionPtr) {
+  audio_io::CallbackStats stats{};
+  auto *ctx = static_cast<NullContext *>(sessionPtr->platformContext);
+  if (!ctx)
+    return stats;
+
+  stats.framesRendered = ctx->framesRendered.load(std::memory_order_acquire);
+  stats.callbackCount = ctx->callbackCount.load(std::memory_order_relaxed);
+  stats.streamSeconds = static_cast<double>(stats.framesRendered) /
+                        static_cast<double>(ctx->sampleRate);
+  stats.wallSeconds =
+      static_cast<double>(ctx->wallNs.load(std::memory_order_relaxed)) * 1e-9;
+
+  if (stats.callbackCount > 0) {
+    stats.averageCallbackUs =
+        static_cast<double>(ctx->callbackNs.load(std::memory_order_relaxed)) /
+        static_cast<double>(stats.callbackCount) * 1e-3;
+  }
+  stats.maxCallbackUs =
+      static_cast<double>(ctx->maxCallbackNs.load(std::memory_order_relaxed)) *
+      1e-3;
+
+  stats.lateCount = ctx->lateCount.load(std::memory_order_relaxed);
+  stats.isFinished = ctx->isFinished.load(std::memory_order_acquire);
+  return stats;
+}
+
+} // namespace NullAdapter
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "audio_io/AudioIOMacros.h"
+#include "audio_io/AudioIOTypesFwd.h"
+
+namespace NullAdapter {
+
+PLATFORM_SETUP(nullSetup);
+PLATFORM_START(nullStart);
+PLATFORM_STOP(nullStop);
+PLATFORM_CLEANUP(nullCleanup);
+
+// One buffer of latency (there is no device behind it)
+audio_io::DeviceLatency nullLatency(audio_io::hAudioSession sessionPtr);
+
+audio_io::CallbackStats nullStats(audio_io::hAudioSession sessionPtr);
+
+} // namespace NullAdapter
@@ -6,6 +6,10 @@ struct AudioSession {
   float *bufferMemory; // Actual memory buffer
   AudioBuffer buffer;  // user facing with pointers to bufferMemory
 
+  // Non-Interleaved only: repointed at the platform's buffers every callback
+  // so the user renders in place (numChannels entries, allocated in setup)
+  float **nativeChannelPtrs;
+
   Config userConfig;
 
   AudioCallback userCallback;
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+/* Circular delay line with a power of two capacity (wrap = mask)
+ * - storage is allocated once by createDelayLine, never while processing
+ * - delays are whole samples (tempo delays and reverb lines don't need
+ *   fractional reads)
+ */
+namespace dsp::delay {
+struct DelayLine {
+  float *buffer = nullptr;
+  size_t mask = 0; // capacity - 1
+  size_t writeIndex = 0;
+};
+
+// Holds delays up to _maxDelaySamples_ (capacity rounds up to a power of 2)
+// NOTE: allocates, call before the audio session starts
+DelayLine createDelayLine(size_t maxDelaySamples);
+void disposeDelayLine(DelayLine &line);
+
+void clearDelayLine(DelayLine &line);
+
+inline size_t maxDelaySamples(const DelayLine &line) { return line.mask; }
+
+// Sample written _delaySamples_ writes ago
+inline float readDelay(const DelayLine &line, size_t delaySamples) {
+  return line.buffer[(line.writeIndex - delaySamples) & line.mask];
+}
+
+inline void writeDelay(DelayLine &line, float sample) {
+  line.buffer[line.writeIndex] = sample;
+  line.writeIndex = (line.writeIndex + 1) & line.mask;
+}
+
+/* Feedback delay over a block
+ *   wet[i]   = line[i - delaySamples]
+ *   line[i]  = input[i] + wet[i] * feedback
+ * Runs in contiguous spans no longer than the delay (reads never see this
+ * call's writes), so the inner loops are straight SIMD
+ * (_wet_ may alias _input_)
+ * NOTE: 1 <= delaySamples <= maxDelaySamples(line)
+ */
+void processFeedbackDelayBlock(DelayLine &line, const float *input,
+                               float *wet, size_t numSamples,
+                               size_t delaySamples, float feedback);
+} // namespace dsp::delay
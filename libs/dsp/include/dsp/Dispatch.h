@@ -0,0 +1,74 @@
+#pragma once
+
+#include "dsp/Waveforms.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/* Runtime CPU dispatch for the block kernels
+ * - one binary for every Mac: the best kernel set is picked at startup
+ * - Baseline = the plain dsp:: block functions (SSE2 / NEON / scalar, 4 wide)
+ * - Avx2     = 8 wide x86 kernels (same operations: bit-identical results,
+ *              within 1 ulp once -ffast-math reassociates)
+ *
+ * Hot paths call through kernels() instead of the dsp:: functions directly.
+ * NOTE: arm64 always has NEON, so Apple Silicon stays on Baseline
+ * NOTE: filters are per-sample recursive (nothing to widen), not dispatched
+ */
+namespace dsp::dispatch {
+enum class KernelIsa : uint8_t { Baseline, Avx2, ISA_COUNT };
+
+struct CpuFeatures {
+  bool sse2 = false;
+  bool avx2 = false;
+  bool neon = false;
+};
+
+using UnaryBlockFn = void (*)(const float *input, float *output,
+                              size_t numSamples);
+
+struct KernelTable {
+  KernelIsa isa;
+
+  // dsp::math
+  UnaryBlockFn fastExp2Block;
+  UnaryBlockFn semitonesToFreqRatioBlock;
+  UnaryBlockFn fastSinPhaseBlock;
+  UnaryBlockFn fastTanhBlock;
+
+  // dsp::waveforms
+  void (*processWaveformBlock)(waveforms::WaveformType type,
+                               const float *phases,
+                               const float *phaseIncrements, float *output,
+                               size_t numSamples, float pulseWidth);
+
+  // dsp::effects
+  void (*softClipFastBlock)(const float *input, float *output,
+                            size_t numSamples, float inputGain);
+};
+
+namespace detail {
+extern const KernelTable *activeTable;
+}
+
+// Queried once and cached
+const CpuFeatures &getCpuFeatures();
+
+/* Bind the best kernel set for this CPU
+ * - called from createEngine, no-op once a set is bound (keeps a forced
+ *   setKernelIsa)
+ * - NOT thread safe: call before any audio/worker thread renders
+ */
+void initKernelDispatch();
+
+// Force a kernel set (bench/debug). Returns false if this CPU can't run it
+bool setKernelIsa(KernelIsa isa);
+
+KernelIsa getKernelIsa();
+const char *getKernelIsaName(KernelIsa isa);
+
+// Case sensitive ("baseline", "avx2"), ISA_COUNT if unknown
+KernelIsa findKernelIsaByName(const char *name);
+
+inline const KernelTable &kernels() { return *detail::activeTable; }
+} // namespace dsp::dispatch
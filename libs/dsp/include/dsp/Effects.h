@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace dsp::effects {
 float hardClip(float sample, float threshold);
 
@@ -14,6 +16,10 @@ float calcInvDrive(float drive);
 float softClip(float sample, float drive, float invDrive, float mix = 1.0);
 float softClipFast(float sample);
 
+// Block form of softClipFast(input * inputGain), SIMD across the block
+void softClipFastBlock(const float *input, float *output, size_t numSamples,
+                       float inputGain = 1.0f);
+
 // NOTE(nico): _drive_ should be denormalized
 // _bias_ should be normalized
 float tapeSimulation(float sample, float drive, float bias);
@@ -33,6 +39,21 @@ float tapeSimulation(float sample, float drive, float bias);
  */
 float dcBlock(float sample, float &state, float coefficient = 0.995f);
 
+// ==== Block forms (master FX chain) ====
+// _input_ and _output_ may alias (in-place)
+
+// softClip with a fastTanh curve (|x * drive| clamped at 3), SIMD
+void softClipBlock(const float *input, float *output, size_t numSamples,
+                   float drive, float invDrive, float mix = 1.0f);
+
+// dcBlock over the block (recursive, stays scalar)
+void dcBlockBlock(const float *input, float *output, size_t numSamples,
+                  float &state, float coefficient = 0.995f);
+
+// output = dry + (wet - dry) * mix, SIMD (_output_ may alias _dry_)
+void mixDryWetBlock(const float *dry, const float *wet, float *output,
+                    size_t numSamples, float mix);
+
 // ==== Alternatives ====
 // tanh — smooth, symmetric, expensive. The "classic" sound.
 float saturate_tanh(float x);
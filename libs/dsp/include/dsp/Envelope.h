@@ -1,11 +1,65 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 namespace dsp::envelopes {
 
 enum class Status { Idle, Attack, Decay, Sustain, Release };
 
+/* ==== Curve Tables ====
+ * Stage shapes as lookup tables indexed by stage progress (0-1), so a
+ * curved stage costs one interpolated read per sample (no exp/pow)
+ * - curvature -1..1: < 0 slow start (exponential), 0 linear, > 0 fast
+ *   start (logarithmic, the analog RC shape)
+ * - the same shape works for every stage: attack rises along it, decay
+ *   and release fall along it (fast start = a fast initial drop)
+ * - curvature is quantized to NUM_CURVE_TABLES steps, picked once when the
+ *   param changes (not per sample)
+ */
+inline constexpr uint32_t CURVE_TABLE_SIZE = 256; // segments (power of 2)
+inline constexpr uint32_t NUM_CURVE_TABLES = 17;  // -1, -0.875, ... 1
+inline constexpr float CURVE_STEEPNESS = 6.0f;    // exp() rate at |1|
+
+// Per-stage tables (nullptr = linear ramp, the closed-form path)
+struct StageCurves {
+  const float *attack = nullptr;
+  const float *decay = nullptr;
+  const float *release = nullptr;
+};
+
+// NOTE: call once at startup, NOT on the audio thread
+void initCurveTables();
+
+// Table for _curvature_ (nearest step), nullptr when it rounds to linear
+const float *getCurveTable(float curvature);
+
+// Shaped value at _progress_ (0-1), linear interpolation between entries
+float readCurve(const float *curve, float progress);
+
+// Progress giving _value_ (monotonic table, binary search; note-on rate)
+float invertCurve(const float *curve, float value);
+
 float processADSR(Status &state, float &amplitude, float &progress,
                   float &releaseStartLevel, float attackInc, float decayInc,
-                  float releaseInc, float sustainLevel);
+                  float releaseInc, float sustainLevel,
+                  const StageCurves &curves = {});
+
+/* Block form of processADSR (same stages and transitions)
+ * - finds how many samples are left until the next stage boundary and fills
+ *   each segment with a closed-form ramp (no per-sample state branch)
+ * - progress is start + inc * k instead of an accumulated sum, so values
+ *   can differ from processADSR by float rounding
+ * - linear stages keep their closed-form ramps, curved ones shape the same
+ *   progress ramp through their table
+ * - returns the number of samples before the envelope is Idle (including
+ *   the sample reaching it), numSamples if it never gets there.
+ *   _output_ past that point is zero filled
+ */
+size_t processADSRBlock(Status &state, float &amplitude, float &progress,
+                        float &releaseStartLevel, float attackInc,
+                        float decayInc, float releaseInc, float sustainLevel,
+                        float *output, size_t numSamples,
+                        const StageCurves &curves = {});
 
 } // namespace dsp::envelopes
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+/* In-place radix-2 complex FFT (split real/imaginary arrays)
+ * - size must be a power of 2
+ * - forward: X[k] = sum x[n] e^(-2πi kn / size), unscaled
+ * - inverse: includes the 1 / size scale (inverse(forward(x)) == x)
+ *
+ * Offline use (building tables), twiddles are computed per call
+ * NOTE: not for the audio thread
+ */
+namespace dsp::fft {
+
+inline bool isPowerOfTwo(uint32_t size) {
+  return size != 0 && (size & (size - 1)) == 0;
+}
+
+void forwardFft(float *re, float *im, uint32_t size);
+void inverseFft(float *re, float *im, uint32_t size);
+
+} // namespace dsp::fft
@@ -41,4 +41,8 @@ struct LadderState {
 float processLadder(float input, float f, float resonance, LadderState &st);
 float processLadderNonlinear(float input, float f, float resonance, float drive,
                              LadderState &st);
+
+// Same as processLadderNonlinear with math::fastTanh (draft quality)
+float processLadderNonlinearFast(float input, float f, float resonance,
+                                 float drive, LadderState &st);
 } // namespace dsp::filters
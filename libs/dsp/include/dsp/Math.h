@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace dsp::math {
 inline constexpr float PI_F = 3.1415927f;
 inline constexpr double PI_DOUBLE = 3.141592653589793;
@@ -10,7 +12,59 @@ inline constexpr float SEMITONE_PER_OCTAVE = 1.0f / 12.0f;
 // Pre-caluated value of 2^(1/12)
 inline constexpr float SEMITONE_RATIO = 1.059463094f;
 
+/* ==== Fast approximations ====
+ * Error bounds (abs = absolute, rel = relative, against double precision
+ * libm over the listed range) are design budgets, not measurements; they
+ * must hold in the release build (-ffast-math) and are checked by
+ * `make math-accuracy` (tools/math_accuracy)
+ */
+
+// 2^x, |x| <= 16: rel 1e-5 (0.02 cent as a pitch ratio)
 float fastExp2(float x);
 float semitonesToFreqRatio(float x);
 
+// sin(2π * phase), phase in cycles, |phase| < 2^30: abs 5e-7
+// (the half cycle fold is exact, so the error does not grow with |phase|)
+float fastSinPhase(float phase);
+
+// Radian forms of fastSinPhase: abs 5e-7 + 2e-7 * |x|
+// NOTE: the |x| term is rounding x / 2π (and the quarter cycle shift for
+// cos) to float, one float ulp of phase is 2π ulps of output
+float fastSin(float x);
+float fastCos(float x);
+
+// fastSin / fastCos, |x| <= 1.5: rel 2e-5 (fastCos's budget over
+// cos(1.5) ~ 0.07, blows up right next to π/2)
+float fastTan(float x);
+
+/* Rational (Pade) saturation curve x(27 + x^2) / (27 + 9x^2), clamped to
+ * +-1 past |x| = 3: abs 3e-2 against tanh (worst around |x| = 1.6)
+ * NOTE: deliberately NOT an accurate tanh. It is odd, monotonic, has slope
+ * 1 at 0 and reaches +-1 with zero slope at |x| = 3, so the clamp joins
+ * smoothly. Its callers only need that shape: softClipBlock (saturator,
+ * master soft clip) and the draft quality ladder; render quality ladder
+ * uses std::tanh
+ */
+float fastTanh(float x);
+
+// log2(x), 2^-16 <= x <= 2^16: abs 5e-6 (0.006 cent as octaves)
+// NOTE: zero, negative, denormal and inf inputs are NOT handled
+float fastLog2(float x);
+
+// ==== Block (array) forms ====
+// Same results as the scalar versions, SIMD across the block
+// NOTE: 4 wide (dsp::simd::f32x4)
+void fastExp2Block(const float *input, float *output, size_t numSamples);
+void semitonesToFreqRatioBlock(const float *input, float *output,
+                               size_t numSamples);
+void fastSinPhaseBlock(const float *input, float *output, size_t numSamples);
+void fastSinBlock(const float *input, float *output, size_t numSamples);
+void fastTanBlock(const float *input, float *output, size_t numSamples);
+void fastTanhBlock(const float *input, float *output, size_t numSamples);
+void fastLog2Block(const float *input, float *output, size_t numSamples);
+
+// libm std::exp2 per sample (offline/render quality, not SIMD)
+void semitonesToFreqRatioExactBlock(const float *input, float *output,
+                                    size_t numSamples);
+
 } // namespace dsp::math
@@ -2,11 +2,17 @@
 
 #include "Waveforms.h"
 
+#include <cstddef>
+
 namespace dsp::modulation {
 // Generate LFO waveform at given phase
 float processLFO(float phase, waveforms::WaveformType type,
                  float pulseWidth = 0.5f);
 
+// Batch form: one waveform for _count_ phases (e.g. one per voice)
+void processLFOBlock(const float *phases, float *output, size_t count,
+                     waveforms::WaveformType type, float pulseWidth = 0.5f);
+
 // Modulation curves (for velocity, mod wheel, etc.)
 float exponentialCurve(float linear); // 0-1 → exponential curve
 float logarithmicCurve(float linear); // 0-1 → logarithmic curve
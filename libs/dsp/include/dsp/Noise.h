@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/* White noise from xorshift32 streams (no rand(), no locks, no allocation)
+ * - one independent stream per SIMD lane, 4 samples per step
+ * - output is uniform in [-1.0, 1.0) (mantissa bits -> float, no divide)
+ */
+namespace dsp::noise {
+inline constexpr size_t NOISE_LANES = 4;
+
+struct NoiseState {
+  uint32_t lanes[NOISE_LANES] = {1, 2, 3, 4}; // never all zero
+};
+
+// Any seed is fine (zero included): lanes are hashed and forced non zero
+void seedNoise(NoiseState &state, uint32_t seed);
+
+// One value (advances lane 0 only, e.g. block-rate modulation)
+float processNoise(NoiseState &state);
+
+void processNoiseBlock(NoiseState &state, float *output, size_t numSamples);
+} // namespace dsp::noise
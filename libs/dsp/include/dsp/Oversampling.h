@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+
+/* Polyphase half-band 2x up/down sampling
+ * - 47 tap Kaiser windowed half-band (~56 dB stopband past 0.6 * Nyquist)
+ * - every other tap is zero, so each branch only runs the 12 odd taps
+ * - cascade two stages for 4x (stage 0: 1x <-> 2x, stage 1: 2x <-> 4x)
+ *
+ * Wrap only the nonlinear part of a chain (tanh drive, saturation):
+ * upsample -> nonlinearity at N * sampleRate -> downsample
+ *
+ * NOTE: a full up/down round trip delays the signal by ~HALF_BAND_PAIRS samples
+ * at the base rate
+ */
+namespace dsp::oversampling {
+inline constexpr size_t HALF_BAND_PAIRS = 12; // non zero odd tap pairs
+inline constexpr size_t MAX_FACTOR_LOG2 = 2;  // up to 4x
+inline constexpr size_t MAX_FACTOR = 1u << MAX_FACTOR_LOG2;
+
+// History of one 2x stage (previous block's tail)
+struct HalfBandState {
+  float up[2 * HALF_BAND_PAIRS] = {};   // base rate input
+  float down[4 * HALF_BAND_PAIRS] = {}; // 2x rate input
+};
+
+struct OversamplerState {
+  HalfBandState stages[MAX_FACTOR_LOG2];
+};
+
+void resetOversampler(OversamplerState &state);
+
+// _output_ receives 2 * numSamples samples
+void upsample2x(HalfBandState &state, const float *input, float *output,
+                size_t numSamples);
+
+// _input_ holds 2 * numSamples samples, _output_ receives numSamples
+void downsample2x(HalfBandState &state, const float *input, float *output,
+                  size_t numSamples);
+} // namespace dsp::oversampling
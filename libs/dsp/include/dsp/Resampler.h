@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/* Fixed ratio polyphase resampler (e.g. 48 kHz render -> 96 kHz device)
+ * - the ratio is reduced to upFactor/downFactor (output/input rate over
+ *   their gcd): positions are integer math, no drift over any length
+ * - Kaiser windowed sinc (beta = 8), RESAMPLER_TAPS taps per phase, cutoff
+ *   just below the lower of the two Nyquist frequencies
+ * - each output runs a single phase (RESAMPLER_TAPS multiply-adds)
+ *
+ * Exact counts both ways: getResamplerInputFrames(N) is the input N outputs
+ * consume, getResamplerOutputFrames the outputs the pushed input covers
+ * (the caller renders exactly what's needed, in any chunking)
+ *
+ * NOTE: delays the signal by ~RESAMPLER_TAPS / 2 input samples
+ */
+namespace dsp::resampler {
+inline constexpr uint32_t RESAMPLER_TAPS = 48;
+
+// Phase table limit (44.1 <-> 48 kHz needs 160): ratios above it are refused
+inline constexpr uint32_t MAX_RESAMPLER_PHASES = 1024;
+
+struct Resampler {
+  uint32_t upFactor = 1;   // output rate / gcd
+  uint32_t downFactor = 1; // input rate / gcd
+
+  // upFactor phases of RESAMPLER_TAPS taps, each stored oldest tap first
+  float *phases = nullptr;
+
+  // RESAMPLER_TAPS of history, then the pushed input
+  float *window = nullptr;
+  uint32_t windowCapacity = 0;
+  uint32_t windowCount = 0;
+
+  // Next output's position past the newest consumed input (upFactor units)
+  uint32_t position = 0;
+};
+
+/* Up to _maxInputFrames_ pushed between processResampler calls
+ * Returns an empty Resampler (phases == nullptr) when the reduced ratio
+ * needs more than MAX_RESAMPLER_PHASES phases
+ * NOTE: allocates, call before the audio session starts
+ */
+Resampler createResampler(uint32_t inputRate, uint32_t outputRate,
+                          uint32_t maxInputFrames);
+void disposeResampler(Resampler &resampler);
+
+void resetResampler(Resampler &resampler);
+
+// Input frames processResampler consumes for its next _numOutputFrames_
+// (exact: push this many, no more)
+inline uint32_t getResamplerInputFrames(const Resampler &resampler,
+                                        uint32_t numOutputFrames) {
+  if (numOutputFrames == 0)
+    return 0;
+
+  uint64_t end = resampler.position +
+                 uint64_t{numOutputFrames - 1} * resampler.downFactor;
+  return static_cast<uint32_t>(end / resampler.upFactor);
+}
+
+// Outputs the pushed (not yet consumed) input covers
+inline uint32_t getResamplerOutputFrames(const Resampler &resampler) {
+  uint32_t pending = resampler.windowCount - RESAMPLER_TAPS;
+
+  // Largest N with getResamplerInputFrames(N) <= pending
+  uint64_t reach = uint64_t{pending} * resampler.upFactor +
+                   resampler.upFactor - 1;
+  if (reach < resampler.position)
+    return 0;
+  return static_cast<uint32_t>((reach - resampler.position) /
+                               resampler.downFactor) +
+         1;
+}
+
+void pushResamplerInput(Resampler &resampler, const float *input,
+                        uint32_t numFrames);
+
+// After pushing getResamplerInputFrames(numOutputFrames) input frames
+void processResampler(Resampler &resampler, float *output,
+                      uint32_t numOutputFrames);
+} // namespace dsp::resampler
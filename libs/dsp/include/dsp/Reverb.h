@@ -0,0 +1,53 @@
+#pragma once
+
+#include "dsp/Delay.h"
+
+#include <cstddef>
+
+/* Algorithmic reverb: 8 line feedback delay network (FDN)
+ * - Householder feedback matrix (lossless, y = x - 2/N * sum(x))
+ * - per line one-pole damping and RT60 decay gain
+ * - lines run as SIMD lanes (2 x 4), only the taps are gathered
+ *
+ * Mono in, mono (wet only) out, or stereo: the pair is summed into the
+ * network, L/R read the lines through two orthogonal tap sign patterns
+ * (decorrelated tails for the price of one network)
+ */
+namespace dsp::reverb {
+inline constexpr size_t REVERB_LINES = 8;
+
+inline constexpr float REVERB_SIZE_MIN = 0.1f;
+inline constexpr float REVERB_SIZE_MAX = 1.0f;
+
+struct ReverbState {
+  delay::DelayLine lines[REVERB_LINES];
+  size_t lengths[REVERB_LINES] = {}; // samples, scaled by size
+  float gains[REVERB_LINES] = {};    // decay per pass through a line
+  float lowpass[REVERB_LINES] = {};  // damping filter states
+  float damping = 0.0f;
+};
+
+// Lines sized for REVERB_SIZE_MAX at _sampleRate_
+// NOTE: allocates, call before the audio session starts
+ReverbState createReverb(float sampleRate);
+void disposeReverb(ReverbState &state);
+
+void clearReverb(ReverbState &state);
+
+/* _size_ [REVERB_SIZE_MIN, REVERB_SIZE_MAX] scales the line lengths
+ * _decaySeconds_ = RT60, _damping_ [0, 1) high frequency loss per pass
+ * Cheap (8 pow), fine at block boundaries
+ */
+void updateReverb(ReverbState &state, float size, float decaySeconds,
+                  float damping, float sampleRate);
+
+// _wet_ may alias _input_
+void processReverbBlock(ReverbState &state, const float *input, float *wet,
+                        size_t numSamples);
+
+// Wet only, each _wet_ may alias its input. L == R input: _wetLeft_ is the
+// mono block's wet output
+void processReverbBlockStereo(ReverbState &state, const float *inputLeft,
+                              const float *inputRight, float *wetLeft,
+                              float *wetRight, size_t numSamples);
+} // namespace dsp::reverb
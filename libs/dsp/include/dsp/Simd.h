@@ -0,0 +1,266 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/* Minimal 4-wide float vector wrapper for the block kernels
+ * - SSE2 on x86_64 (baseline, always available)
+ * - NEON on Apple Silicon
+ * - Scalar fallback everywhere else
+ *
+ * NOTE: only what the dsp kernels actually need. Everything is inline so
+ * the wrapper disappears after optimization.
+ */
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DSP_SIMD_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DSP_SIMD_NEON 1
+#endif
+
+namespace dsp::simd {
+inline constexpr size_t WIDTH = 4;
+
+// Round down to a multiple of WIDTH (main loop bound, remainder is the tail)
+inline constexpr size_t alignedCount(size_t count) {
+  return count & ~(WIDTH - 1);
+}
+
+#if DSP_SIMD_SSE2
+// ==== SSE2 ====
+using f32x4 = __m128;
+using i32x4 = __m128i;
+using mask4 = __m128;
+
+inline f32x4 load(const float *ptr) { return _mm_loadu_ps(ptr); }
+inline void store(float *ptr, f32x4 v) { _mm_storeu_ps(ptr, v); }
+inline f32x4 set1(float value) { return _mm_set1_ps(value); }
+
+inline f32x4 add(f32x4 a, f32x4 b) { return _mm_add_ps(a, b); }
+inline f32x4 sub(f32x4 a, f32x4 b) { return _mm_sub_ps(a, b); }
+inline f32x4 mul(f32x4 a, f32x4 b) { return _mm_mul_ps(a, b); }
+inline f32x4 div(f32x4 a, f32x4 b) { return _mm_div_ps(a, b); }
+inline f32x4 min(f32x4 a, f32x4 b) { return _mm_min_ps(a, b); }
+inline f32x4 max(f32x4 a, f32x4 b) { return _mm_max_ps(a, b); }
+
+inline f32x4 abs(f32x4 v) {
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); // clear sign bit
+}
+
+inline mask4 cmpLt(f32x4 a, f32x4 b) { return _mm_cmplt_ps(a, b); }
+inline mask4 cmpGt(f32x4 a, f32x4 b) { return _mm_cmpgt_ps(a, b); }
+inline mask4 cmpGe(f32x4 a, f32x4 b) { return _mm_cmpge_ps(a, b); }
+inline mask4 maskAndNot(mask4 a, mask4 b) { return _mm_andnot_ps(b, a); }
+
+// mask ? a : b (per lane)
+inline f32x4 select(mask4 mask, f32x4 a, f32x4 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Truncate toward zero (same as static_cast<int32_t>)
+inline i32x4 truncToInt(f32x4 v) { return _mm_cvttps_epi32(v); }
+// Round to nearest (even on ties)
+inline i32x4 roundToInt(f32x4 v) { return _mm_cvtps_epi32(v); }
+inline f32x4 toFloat(i32x4 v) { return _mm_cvtepi32_ps(v); }
+inline i32x4 set1Int(int32_t value) { return _mm_set1_epi32(value); }
+inline i32x4 addInt(i32x4 a, i32x4 b) { return _mm_add_epi32(a, b); }
+inline i32x4 subInt(i32x4 a, i32x4 b) { return _mm_sub_epi32(a, b); }
+inline i32x4 andInt(i32x4 a, i32x4 b) { return _mm_and_si128(a, b); }
+inline i32x4 orInt(i32x4 a, i32x4 b) { return _mm_or_si128(a, b); }
+inline i32x4 xorInt(i32x4 a, i32x4 b) { return _mm_xor_si128(a, b); }
+inline i32x4 loadInt(const int32_t *ptr) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+}
+inline void storeInt(int32_t *ptr, i32x4 v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr), v);
+}
+template <int Shift> inline i32x4 shiftLeft(i32x4 v) {
+  return _mm_slli_epi32(v, Shift);
+}
+// Logical (zero filling)
+template <int Shift> inline i32x4 shiftRight(i32x4 v) {
+  return _mm_srli_epi32(v, Shift);
+}
+inline i32x4 asInt(f32x4 v) { return _mm_castps_si128(v); }
+inline f32x4 asFloat(i32x4 v) { return _mm_castsi128_ps(v); }
+
+#elif DSP_SIMD_NEON
+// ==== NEON ====
+using f32x4 = float32x4_t;
+using i32x4 = int32x4_t;
+using mask4 = uint32x4_t;
+
+inline f32x4 load(const float *ptr) { return vld1q_f32(ptr); }
+inline void store(float *ptr, f32x4 v) { vst1q_f32(ptr, v); }
+inline f32x4 set1(float value) { return vdupq_n_f32(value); }
+
+inline f32x4 add(f32x4 a, f32x4 b) { return vaddq_f32(a, b); }
+inline f32x4 sub(f32x4 a, f32x4 b) { return vsubq_f32(a, b); }
+inline f32x4 mul(f32x4 a, f32x4 b) { return vmulq_f32(a, b); }
+inline f32x4 div(f32x4 a, f32x4 b) { return vdivq_f32(a, b); }
+inline f32x4 min(f32x4 a, f32x4 b) { return vminq_f32(a, b); }
+inline f32x4 max(f32x4 a, f32x4 b) { return vmaxq_f32(a, b); }
+inline f32x4 abs(f32x4 v) { return vabsq_f32(v); }
+
+inline mask4 cmpLt(f32x4 a, f32x4 b) { return vcltq_f32(a, b); }
+inline mask4 cmpGt(f32x4 a, f32x4 b) { return vcgtq_f32(a, b); }
+inline mask4 cmpGe(f32x4 a, f32x4 b) { return vcgeq_f32(a, b); }
+inline mask4 maskAndNot(mask4 a, mask4 b) { return vbicq_u32(a, b); }
+
+// mask ? a : b (per lane)
+inline f32x4 select(mask4 mask, f32x4 a, f32x4 b) {
+  return vbslq_f32(mask, a, b);
+}
+
+// Truncate toward zero (same as static_cast<int32_t>)
+inline i32x4 truncToInt(f32x4 v) { return vcvtq_s32_f32(v); }
+// Round to nearest (even on ties)
+inline i32x4 roundToInt(f32x4 v) { return vcvtnq_s32_f32(v); }
+inline f32x4 toFloat(i32x4 v) { return vcvtq_f32_s32(v); }
+inline i32x4 set1Int(int32_t value) { return vdupq_n_s32(value); }
+inline i32x4 addInt(i32x4 a, i32x4 b) { return vaddq_s32(a, b); }
+inline i32x4 subInt(i32x4 a, i32x4 b) { return vsubq_s32(a, b); }
+inline i32x4 andInt(i32x4 a, i32x4 b) { return vandq_s32(a, b); }
+inline i32x4 orInt(i32x4 a, i32x4 b) { return vorrq_s32(a, b); }
+inline i32x4 xorInt(i32x4 a, i32x4 b) { return veorq_s32(a, b); }
+inline i32x4 loadInt(const int32_t *ptr) { return vld1q_s32(ptr); }
+inline void storeInt(int32_t *ptr, i32x4 v) { vst1q_s32(ptr, v); }
+template <int Shift> inline i32x4 shiftLeft(i32x4 v) {
+  return vshlq_n_s32(v, Shift);
+}
+// Logical (zero filling)
+template <int Shift> inline i32x4 shiftRight(i32x4 v) {
+  return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(v), Shift));
+}
+inline i32x4 asInt(f32x4 v) { return vreinterpretq_s32_f32(v); }
+inline f32x4 asFloat(i32x4 v) { return vreinterpretq_f32_s32(v); }
+
+#else
+// ==== Scalar fallback ====
+struct f32x4 {
+  float v[WIDTH];
+};
+struct i32x4 {
+  int32_t v[WIDTH];
+};
+struct mask4 {
+  uint32_t v[WIDTH];
+};
+
+inline f32x4 load(const float *ptr) {
+  f32x4 r;
+  std::memcpy(r.v, ptr, sizeof(r.v));
+  return r;
+}
+inline void store(float *ptr, f32x4 v) { std::memcpy(ptr, v.v, sizeof(v.v)); }
+inline f32x4 set1(float value) { return {{value, value, value, value}}; }
+
+#define DSP_SIMD_LANEWISE(expr)                                                \
+  f32x4 r;                                                                     \
+  for (size_t i = 0; i < WIDTH; i++)                                           \
+    r.v[i] = (expr);                                                           \
+  return r
+
+inline f32x4 add(f32x4 a, f32x4 b) { DSP_SIMD_LANEWISE(a.v[i] + b.v[i]); }
+inline f32x4 sub(f32x4 a, f32x4 b) { DSP_SIMD_LANEWISE(a.v[i] - b.v[i]); }
+inline f32x4 mul(f32x4 a, f32x4 b) { DSP_SIMD_LANEWISE(a.v[i] * b.v[i]); }
+inline f32x4 div(f32x4 a, f32x4 b) { DSP_SIMD_LANEWISE(a.v[i] / b.v[i]); }
+inline f32x4 min(f32x4 a, f32x4 b) {
+  DSP_SIMD_LANEWISE(a.v[i] < b.v[i] ? a.v[i] : b.v[i]);
+}
+inline f32x4 max(f32x4 a, f32x4 b) {
+  DSP_SIMD_LANEWISE(a.v[i] > b.v[i] ? a.v[i] : b.v[i]);
+}
+inline f32x4 abs(f32x4 v) { DSP_SIMD_LANEWISE(v.v[i] < 0.0f ? -v.v[i] : v.v[i]); }
+
+#undef DSP_SIMD_LANEWISE
+
+#define DSP_SIMD_MASKWISE(expr)                                                \
+  mask4 r;                                                                     \
+  for (size_t i = 0; i < WIDTH; i++)                                           \
+    r.v[i] = (expr) ? 0xFFFFFFFFu : 0u;                                        \
+  return r
+
+inline mask4 cmpLt(f32x4 a, f32x4 b) { DSP_SIMD_MASKWISE(a.v[i] < b.v[i]); }
+inline mask4 cmpGt(f32x4 a, f32x4 b) { DSP_SIMD_MASKWISE(a.v[i] > b.v[i]); }
+inline mask4 cmpGe(f32x4 a, f32x4 b) { DSP_SIMD_MASKWISE(a.v[i] >= b.v[i]); }
+inline mask4 maskAndNot(mask4 a, mask4 b) {
+  DSP_SIMD_MASKWISE(a.v[i] && !b.v[i]);
+}
+
+#undef DSP_SIMD_MASKWISE
+
+// mask ? a : b (per lane)
+inline f32x4 select(mask4 mask, f32x4 a, f32x4 b) {
+  f32x4 r;
+  for (size_t i = 0; i < WIDTH; i++)
+    r.v[i] = mask.v[i] ? a.v[i] : b.v[i];
+  return r;
+}
+
+inline i32x4 truncToInt(f32x4 v) {
+  i32x4 r;
+  for (size_t i = 0; i < WIDTH; i++)
+    r.v[i] = static_cast<int32_t>(v.v[i]);
+  return r;
+}
+inline i32x4 roundToInt(f32x4 v) {
+  i32x4 r;
+  for (size_t i = 0; i < WIDTH; i++)
+    r.v[i] = static_cast<int32_t>(std::lrint(v.v[i]));
+  return r;
+}
+inline f32x4 toFloat(i32x4 v) {
+  f32x4 r;
+  for (size_t i = 0; i < WIDTH; i++)
+    r.v[i] = static_cast<float>(v.v[i]);
+  return r;
+}
+inline i32x4 set1Int(int32_t value) { return {{value, value, value, value}}; }
+
+#define DSP_SIMD_INTWISE(expr)                                                 \
+  i32x4 r;                                                                     \
+  for (size_t i = 0; i < WIDTH; i++)                                           \
+    r.v[i] = (expr);                                                           \
+  return r
+
+inline i32x4 addInt(i32x4 a, i32x4 b) { DSP_SIMD_INTWISE(a.v[i] + b.v[i]); }
+inline i32x4 subInt(i32x4 a, i32x4 b) { DSP_SIMD_INTWISE(a.v[i] - b.v[i]); }
+inline i32x4 andInt(i32x4 a, i32x4 b) { DSP_SIMD_INTWISE(a.v[i] & b.v[i]); }
+inline i32x4 orInt(i32x4 a, i32x4 b) { DSP_SIMD_INTWISE(a.v[i] | b.v[i]); }
+inline i32x4 xorInt(i32x4 a, i32x4 b) { DSP_SIMD_INTWISE(a.v[i] ^ b.v[i]); }
+template <int Shift> inline i32x4 shiftLeft(i32x4 v) {
+  DSP_SIMD_INTWISE(
+      static_cast<int32_t>(static_cast<uint32_t>(v.v[i]) << Shift));
+}
+// Logical (zero filling)
+template <int Shift> inline i32x4 shiftRight(i32x4 v) {
+  DSP_SIMD_INTWISE(
+      static_cast<int32_t>(static_cast<uint32_t>(v.v[i]) >> Shift));
+}
+
+#undef DSP_SIMD_INTWISE
+inline i32x4 loadInt(const int32_t *ptr) {
+  i32x4 r;
+  std::memcpy(r.v, ptr, sizeof(r.v));
+  return r;
+}
+inline void storeInt(int32_t *ptr, i32x4 v) {
+  std::memcpy(ptr, v.v, sizeof(v.v));
+}
+inline i32x4 asInt(f32x4 v) {
+  i32x4 r;
+  std::memcpy(r.v, v.v, sizeof(r.v));
+  return r;
+}
+inline f32x4 asFloat(i32x4 v) {
+  f32x4 r;
+  std::memcpy(r.v, v.v, sizeof(r.v));
+  return r;
+}
+#endif
+
+} // namespace dsp::simd
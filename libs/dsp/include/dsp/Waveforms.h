@@ -1,8 +1,19 @@
 #pragma once
 
+#include <cstddef>
+
 namespace dsp::waveforms {
 
-enum class WaveformType { Sine, Saw, Square, Triangle, WAVEFORM_COUNT };
+// NOTE: Wavetable reads from a table owned by the caller (see dsp/Wavetable.h)
+// Functions here that don't take a table fall back to Sine for it
+enum class WaveformType {
+  Sine,
+  Saw,
+  Square,
+  Triangle,
+  Wavetable,
+  WAVEFORM_COUNT
+};
 
 // Sine wave (band-limited as-is)
 float sine(float phase);
@@ -28,4 +39,16 @@ float triangle(float phase);
 // Process block
 float processWaveform(WaveformType type, float phase,
                       float phaseIncrement = 0.0, float pulseWidth = 0.5f);
+
+// Process a whole block of (phase, phaseIncrement) pairs
+// Waveform is resolved once per call; SIMD across the block
+void processWaveformBlock(WaveformType type, const float *phases,
+                          const float *phaseIncrements, float *output,
+                          size_t numSamples, float pulseWidth = 0.5f);
+
+// Naive (aliasing) block form for draft quality: saw/square skip polyBLEP
+// NOTE: Sine/Triangle match processWaveformBlock
+void processWaveformNaiveBlock(WaveformType type, const float *phases,
+                               float *output, size_t numSamples,
+                               float pulseWidth = 0.5f);
 } // namespace dsp::waveforms
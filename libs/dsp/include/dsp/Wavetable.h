@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Waveforms.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/* Mipmapped, band-limited single-cycle wavetables
+ *
+ * Each table holds one pre-filtered copy of the cycle per octave ("mip").
+ * Level 0 keeps MAX_HARMONICS harmonics and every level above halves that,
+ * so playback picks the level whose highest harmonic stays below Nyquist
+ * for the current phase increment. Playback is then just a table lookup
+ * with linear interpolation -- no trig, no BLEP branches.
+ */
+namespace dsp::wavetable {
+inline constexpr uint32_t TABLE_SIZE = 2048; // samples per cycle (power of 2)
+inline constexpr uint32_t TABLE_MASK = TABLE_SIZE - 1;
+
+inline constexpr uint32_t MIP_LEVELS = 10; // 512, 256, ... 1 harmonic(s)
+inline constexpr uint32_t MAX_HARMONICS = 512;
+
+// Longest cycle buildFromCycle transforms directly (power of 2 lengths)
+inline constexpr uint32_t MAX_CYCLE_LENGTH = 2 * TABLE_SIZE;
+
+struct Wavetable {
+  // +1 guard sample (copy of sample 0) so interpolation never has to wrap
+  float mips[MIP_LEVELS][TABLE_SIZE + 1];
+};
+
+// Multi-frame table: frameCount Wavetables back to back (not owned)
+struct WavetableFrames {
+  const Wavetable *frames = nullptr;
+  uint32_t frameCount = 0;
+};
+
+// Number of harmonics kept at mip _level_
+uint32_t maxHarmonicsForLevel(uint32_t level);
+
+// Lowest mip level that does not alias at _phaseIncrement_
+uint32_t selectMipLevel(float phaseIncrement);
+
+/* Build every mip level from a harmonic series
+ * - index 0 is the fundamental
+ * - sinAmps/cosAmps: amplitude per harmonic (either may be nullptr)
+ */
+void buildFromHarmonics(Wavetable &table, const float *sinAmps,
+                        const float *cosAmps, uint32_t numHarmonics);
+
+/* Build every mip level from one cycle of samples (e.g. a WAV frame)
+ * - power of 2 lengths up to MAX_CYCLE_LENGTH are transformed as they are,
+ *   any other length is linearly resampled to TABLE_SIZE first
+ * - DC is removed, each level zeroes the FFT bins above its harmonics
+ * - thread-safe (stack scratch only), a few FFTs per level
+ */
+void buildFromCycle(Wavetable &table, const float *cycle, uint32_t length);
+
+// ==== Built-in Tables ====
+// Band-limited versions of the analog shapes (phase aligned with the
+// polyBLEP versions in dsp::waveforms)
+// NOTE: call once at startup, NOT on the audio thread (builds every mip)
+void initBuiltinWavetables();
+const Wavetable &getBuiltinWavetable(waveforms::WaveformType type);
+
+// ==== Processing ====
+float readMipLevel(const Wavetable &table, uint32_t level, float phase);
+float processWavetable(const Wavetable &table, float phase,
+                       float phaseIncrement);
+
+// Mip level is picked once per block from the highest increment in the block
+void processWavetableBlock(const Wavetable &table, const float *phases,
+                           const float *phaseIncrements, float *output,
+                           size_t numSamples);
+
+/* ==== Frame Scanning ====
+ * _position_ (0-1, clamped) spans the frames: position * (frameCount - 1)
+ * picks two adjacent frames and crossfades them
+ * - both frames read one mip level (picked per block, as above)
+ * - no per-sample branches or divisions: a swept position costs the same as
+ *   a fixed one
+ * - single frame tables play processWavetableBlock (position ignored)
+ */
+float processWavetableFrames(const WavetableFrames &table, float phase,
+                             float phaseIncrement, float position);
+
+void processWavetableFramesBlock(const WavetableFrames &table,
+                                 const float *phases,
+                                 const float *phaseIncrements,
+                                 const float *positions, float *output,
+                                 size_t numSamples);
+
+} // namespace dsp::wavetable
@@ -0,0 +1,94 @@
+#include "dsp/Delay.h"
+#include "dsp/Simd.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+namespace dsp::delay {
+
+// ==== Allocation Helpers ====
+namespace {
+constexpr size_t DELAY_ALIGNMENT = 64;
+
+size_t nextPowerOfTwo(size_t value) {
+  size_t capacity = 1;
+  while (capacity < value)
+    capacity <<= 1;
+  return capacity;
+}
+} // namespace
+
+DelayLine createDelayLine(size_t maxDelaySamples) {
+  DelayLine line{};
+
+  // + 1: the slot being written never aliases the oldest readable one
+  size_t capacity = nextPowerOfTwo(maxDelaySamples + 1);
+
+  line.buffer = new (std::align_val_t{DELAY_ALIGNMENT}) float[capacity]();
+  line.mask = capacity - 1;
+
+  return line;
+}
+
+void disposeDelayLine(DelayLine &line) {
+  if (line.buffer)
+    operator delete[](line.buffer, std::align_val_t{DELAY_ALIGNMENT});
+
+  line = DelayLine{};
+}
+
+void clearDelayLine(DelayLine &line) {
+  if (line.buffer)
+    std::memset(line.buffer, 0, (line.mask + 1) * sizeof(float));
+
+  line.writeIndex = 0;
+}
+
+void processFeedbackDelayBlock(DelayLine &line, const float *input,
+                               float *wet, size_t numSamples,
+                               size_t delaySamples, float feedback) {
+  namespace simd = dsp::simd;
+
+  assert(delaySamples >= 1 && delaySamples <= maxDelaySamples(line));
+
+  const size_t capacity = line.mask + 1;
+  const simd::f32x4 gain = simd::set1(feedback);
+
+  size_t done = 0;
+  while (done < numSamples) {
+    size_t readIndex = (line.writeIndex - delaySamples) & line.mask;
+
+    // Span: behind the write head, and contiguous for both read and write
+    size_t count = std::min(numSamples - done, delaySamples);
+    count = std::min(count, capacity - readIndex);
+    count = std::min(count, capacity - line.writeIndex);
+
+    const float *read = line.buffer + readIndex;
+    float *write = line.buffer + line.writeIndex;
+    const float *in = input + done;
+    float *out = wet + done;
+
+    size_t vecCount = simd::alignedCount(count);
+    size_t i = 0;
+    for (; i < vecCount; i += simd::WIDTH) {
+      simd::f32x4 dry = simd::load(in + i);
+      simd::f32x4 delayed = simd::load(read + i);
+      simd::store(write + i, simd::add(dry, simd::mul(delayed, gain)));
+      simd::store(out + i, delayed);
+    }
+
+    for (; i < count; i++) {
+      float dry = in[i];
+      float delayed = read[i];
+      write[i] = dry + delayed * feedback;
+      out[i] = delayed;
+    }
+
+    line.writeIndex = (line.writeIndex + count) & line.mask;
+    done += count;
+  }
+}
+} // namespace dsp::delay
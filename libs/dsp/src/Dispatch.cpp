@@ -0,0 +1,119 @@
+#include "dsp/Dispatch.h"
+#include "dsp/Effects.h"
+#include "dsp/Math.h"
+#include "dsp/Waveforms.h"
+
+#include "KernelsAvx2.h"
+
+#include <cstring>
+
+namespace dsp::dispatch {
+
+// ==== Kernel Tables ====
+namespace {
+constexpr KernelTable BASELINE_KERNELS = {
+    KernelIsa::Baseline,
+    math::fastExp2Block,
+    math::semitonesToFreqRatioBlock,
+    math::fastSinPhaseBlock,
+    math::fastTanhBlock,
+    waveforms::processWaveformBlock,
+    effects::softClipFastBlock,
+};
+
+#if DSP_HAS_AVX2_KERNELS
+constexpr KernelTable AVX2_KERNELS = {
+    KernelIsa::Avx2,
+    avx2::fastExp2Block,
+    avx2::semitonesToFreqRatioBlock,
+    avx2::fastSinPhaseBlock,
+    avx2::fastTanhBlock,
+    avx2::processWaveformBlock,
+    avx2::softClipFastBlock,
+};
+#endif
+
+constexpr const char *KERNEL_ISA_NAMES[] = {"baseline", "avx2"};
+
+// Set by the first successful setKernelIsa (init or forced)
+bool isKernelIsaBound = false;
+
+CpuFeatures detectCpuFeatures() {
+  CpuFeatures features{};
+
+#if defined(__x86_64__) || defined(_M_X64)
+  features.sse2 = true; // x86_64 baseline
+  // Also checks the OS saves the YMM registers (XGETBV)
+  features.avx2 = __builtin_cpu_supports("avx2") != 0;
+#elif defined(__ARM_NEON)
+  features.neon = true; // arm64 baseline
+#endif
+
+  return features;
+}
+
+const KernelTable *findKernelTable(KernelIsa isa) {
+  switch (isa) {
+  case KernelIsa::Baseline:
+    return &BASELINE_KERNELS;
+
+  case KernelIsa::Avx2:
+#if DSP_HAS_AVX2_KERNELS
+    if (getCpuFeatures().avx2)
+      return &AVX2_KERNELS;
+#endif
+    return nullptr;
+
+  case KernelIsa::ISA_COUNT:
+    return nullptr;
+  }
+  return nullptr;
+}
+} // namespace
+
+// Baseline until initKernelDispatch (always safe to call through)
+const KernelTable *detail::activeTable = &BASELINE_KERNELS;
+
+// ==== APIs ====
+const CpuFeatures &getCpuFeatures() {
+  static const CpuFeatures features = detectCpuFeatures();
+  return features;
+}
+
+void initKernelDispatch() {
+  if (isKernelIsaBound)
+    return;
+
+  // Best first
+  if (!setKernelIsa(KernelIsa::Avx2))
+    setKernelIsa(KernelIsa::Baseline);
+}
+
+bool setKernelIsa(KernelIsa isa) {
+  const KernelTable *table = findKernelTable(isa);
+  if (!table)
+    return false;
+
+  detail::activeTable = table;
+  isKernelIsaBound = true;
+  return true;
+}
+
+KernelIsa getKernelIsa() { return detail::activeTable->isa; }
+
+const char *getKernelIsaName(KernelIsa isa) {
+  auto index = static_cast<size_t>(isa);
+  if (index >= static_cast<size_t>(KernelIsa::ISA_COUNT))
+    return "unknown";
+
+  return KERNEL_ISA_NAMES[index];
+}
+
+KernelIsa findKernelIsaByName(const char *name) {
+  for (size_t i = 0; i < static_cast<size_t>(KernelIsa::ISA_COUNT); i++) {
+    if (strcmp(KERNEL_ISA_NAMES[i], name) == 0)
+      return static_cast<KernelIsa>(i);
+  }
+  return KernelIsa::ISA_COUNT;
+}
+} // namespace dsp::dispatch
@@ -1,8 +1,11 @@
 #include "dsp/Effects.h"
+#include "dsp/Math.h"
+#include "dsp/Simd.h"
 
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 
 namespace dsp::effects {
 float denormalizeDrive(float drive) { return 1 + drive * 4.0f; }
@@ -42,6 +45,28 @@ float softClipFast(float x) {
   return (x * (27.0f + x * x)) / (27.0f + 9.0f * x * x);
 }
 
+void softClipFastBlock(const float *input, float *output, size_t numSamples,
+                       float inputGain) {
+  namespace simd = dsp::simd;
+
+  size_t vecCount = simd::alignedCount(numSamples);
+  size_t i = 0;
+
+  const simd::f32x4 gain = simd::set1(inputGain);
+  const simd::f32x4 c27 = simd::set1(27.0f);
+  const simd::f32x4 c9 = simd::set1(9.0f);
+
+  for (; i < vecCount; i += simd::WIDTH) {
+    simd::f32x4 x = simd::mul(simd::load(input + i), gain);
+    simd::f32x4 num = simd::mul(x, simd::add(c27, simd::mul(x, x)));
+    simd::f32x4 den = simd::add(c27, simd::mul(simd::mul(c9, x), x));
+    simd::store(output + i, simd::div(num, den));
+  }
+
+  for (; i < numSamples; i++)
+    output[i] = softClipFast(input[i] * inputGain);
+}
+
 float hardClip(float sample, float threshold) {
   return std::clamp(sample, -threshold, threshold);
 }
@@ -71,6 +96,72 @@ float dcBlock(float sample, float &state, float coefficient) {
   return output;
 }
 
+void softClipBlock(const float *input, float *output, size_t numSamples,
+                   float drive, float invDrive, float mix) {
+  namespace simd = dsp::simd;
+
+  size_t vecCount = simd::alignedCount(numSamples);
+  size_t i = 0;
+
+  const simd::f32x4 gain = simd::set1(drive);
+  const simd::f32x4 wetGain = simd::set1(invDrive * mix);
+  const simd::f32x4 dryGain = simd::set1(1.0f - mix);
+  const simd::f32x4 upper = simd::set1(3.0f);
+  const simd::f32x4 lower = simd::set1(-3.0f);
+  const simd::f32x4 c27 = simd::set1(27.0f);
+  const simd::f32x4 c9 = simd::set1(9.0f);
+
+  for (; i < vecCount; i += simd::WIDTH) {
+    simd::f32x4 dry = simd::load(input + i);
+    simd::f32x4 x = simd::mul(dry, gain);
+    x = simd::min(simd::max(x, lower), upper);
+
+    simd::f32x4 num = simd::mul(x, simd::add(c27, simd::mul(x, x)));
+    simd::f32x4 den = simd::add(c27, simd::mul(simd::mul(c9, x), x));
+    simd::f32x4 wet = simd::div(num, den);
+
+    simd::store(output + i,
+                simd::add(simd::mul(dry, dryGain), simd::mul(wet, wetGain)));
+  }
+
+  for (; i < numSamples; i++) {
+    float saturated = math::fastTanh(input[i] * drive) * invDrive;
+    output[i] = input[i] * (1.0f - mix) + saturated * mix;
+  }
+}
+
+void dcBlockBlock(const float *input, float *output, size_t numSamples,
+                  float &state, float coefficient) {
+  // Local copy keeps the recursive state in a register
+  float lowpass = state;
+
+  for (size_t i = 0; i < numSamples; i++) {
+    float sample = input[i];
+    output[i] = sample - lowpass;
+    lowpass = sample * (1.0f - coefficient) + lowpass * coefficient;
+  }
+
+  state = lowpass;
+}
+
+void mixDryWetBlock(const float *dry, const float *wet, float *output,
+                    size_t numSamples, float mix) {
+  namespace simd = dsp::simd;
+
+  size_t vecCount = simd::alignedCount(numSamples);
+  size_t i = 0;
+
+  const simd::f32x4 amount = simd::set1(mix);
+  for (; i < vecCount; i += simd::WIDTH) {
+    simd::f32x4 d = simd::load(dry + i);
+    simd::f32x4 w = simd::load(wet + i);
+    simd::store(output + i, simd::add(d, simd::mul(simd::sub(w, d), amount)));
+  }
+
+  for (; i < numSamples; i++)
+    output[i] = dry[i] + (wet[i] - dry[i]) * mix;
+}
+
 // tanh — smooth, symmetric, expensive. The "classic" sound.
 float saturate_tanh(float x) { return std::tanh(x); }
 
@@ -1,10 +1,99 @@
 #include "dsp/Envelope.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
 namespace dsp::envelopes {
 
+// ==== Curve Tables ====
+namespace {
+constexpr uint32_t LINEAR_CURVE = (NUM_CURVE_TABLES - 1) / 2;
+
+// +1 guard entry (progress == 1) so reads never have to clamp the index
+float curveTables[NUM_CURVE_TABLES][CURVE_TABLE_SIZE + 1];
+
+// Linear stages skip the table (closed form, same values as before curves)
+float shapeProgress(const float *curve, float progress) {
+  return curve ? readCurve(curve, progress) : progress;
+}
+} // namespace
+
+void initCurveTables() {
+  static bool isInitialized = false;
+  if (isInitialized)
+    return;
+
+  for (uint32_t t = 0; t < NUM_CURVE_TABLES; t++) {
+    double curvature = -1.0 + 2.0 * t / (NUM_CURVE_TABLES - 1);
+    double k = -curvature * static_cast<double>(CURVE_STEEPNESS);
+    float *table = curveTables[t];
+
+    for (uint32_t n = 0; n <= CURVE_TABLE_SIZE; n++) {
+      double x = static_cast<double>(n) / CURVE_TABLE_SIZE;
+
+      // (e^kx - 1) / (e^k - 1): 0 -> 0, 1 -> 1, k < 0 rises fast first
+      double value = t == LINEAR_CURVE
+                         ? x
+                         : std::expm1(k * x) / std::expm1(k);
+      table[n] = static_cast<float>(value);
+    }
+
+    // Exact endpoints: stages finish on their target levels
+    table[0] = 0.0f;
+    table[CURVE_TABLE_SIZE] = 1.0f;
+  }
+
+  isInitialized = true;
+}
+
+const float *getCurveTable(float curvature) {
+  if (!(std::fabs(curvature) <= 1.0f)) // NaN as well
+    curvature = curvature > 0.0f ? 1.0f : -1.0f;
+
+  auto t = static_cast<uint32_t>(std::lround(
+      (curvature + 1.0f) * 0.5f * static_cast<float>(NUM_CURVE_TABLES - 1)));
+  if (t == LINEAR_CURVE)
+    return nullptr;
+
+  return curveTables[t];
+}
+
+float readCurve(const float *curve, float progress) {
+  float position = progress * static_cast<float>(CURVE_TABLE_SIZE);
+  uint32_t index =
+      std::min(static_cast<uint32_t>(position), CURVE_TABLE_SIZE - 1);
+  float frac = position - static_cast<float>(index);
+
+  return curve[index] + frac * (curve[index + 1] - curve[index]);
+}
+
+float invertCurve(const float *curve, float value) {
+  value = std::clamp(value, 0.0f, 1.0f);
+
+  // Last entry <= value (tables rise strictly, curve[0] == 0)
+  uint32_t low = 0;
+  uint32_t high = CURVE_TABLE_SIZE;
+  while (high - low > 1) {
+    uint32_t mid = (low + high) / 2;
+    if (curve[mid] <= value)
+      low = mid;
+    else
+      high = mid;
+  }
+
+  float span = curve[low + 1] - curve[low];
+  float frac = span > 0.0f ? (value - curve[low]) / span : 0.0f;
+  return (static_cast<float>(low) + std::min(frac, 1.0f)) /
+         static_cast<float>(CURVE_TABLE_SIZE);
+}
+
+// ==== Processing ====
 float processADSR(Status &state, float &amplitude, float &progress,
                   float &releaseStartLevel, float attackInc, float decayInc,
-                  float releaseInc, float sustainLevel) {
+                  float releaseInc, float sustainLevel,
+                  const StageCurves &curves) {
   switch (state) {
   case Status::Attack:
     progress += attackInc;
@@ -13,7 +102,7 @@ float processADSR(Status &state, float &amplitude, float &progress,
       progress = 0.0f;
       amplitude = 1.0f;
     } else {
-      amplitude = progress;
+      amplitude = shapeProgress(curves.attack, progress);
     }
     break;
 
@@ -23,7 +112,8 @@ float processADSR(Status &state, float &amplitude, float &progress,
       state = Status::Sustain;
       amplitude = sustainLevel;
     } else {
-      amplitude = 1.0f - progress * (1.0f - sustainLevel);
+      amplitude = 1.0f - shapeProgress(curves.decay, progress) *
+                             (1.0f - sustainLevel);
     }
     break;
 
@@ -37,7 +127,8 @@ float processADSR(Status &state, float &amplitude, float &progress,
       state = Status::Idle;
       amplitude = 0.0f;
     } else {
-      amplitude = releaseStartLevel * (1.0f - progress);
+      amplitude =
+          releaseStartLevel * (1.0f - shapeProgress(curves.release, progress));
     }
     break;
 
@@ -48,4 +139,182 @@ float processADSR(Status &state, float &amplitude, float &progress,
 
   return amplitude;
 };
+
+// ==== Block Helpers ====
+namespace {
+/* Samples (1-based) until progress + inc * k >= 1, i.e. the sample that
+ * completes the stage. Capped at limit + 1 (= no boundary within _limit_)
+ */
+size_t samplesUntilBoundary(float progress, float inc, size_t limit) {
+  if (!(inc > 0.0f))
+    return limit + 1;
+
+  float remaining = (1.0f - progress) / inc;
+  if (remaining >= static_cast<float>(limit) + 1.0f)
+    return limit + 1;
+
+  auto k = static_cast<size_t>(std::ceil(remaining));
+  if (k < 1)
+    k = 1;
+
+  // ceil() of a rounded quotient can be one off from the closed form
+  while (k > 1 && progress + inc * static_cast<float>(k - 1) >= 1.0f)
+    k--;
+  while (k <= limit && progress + inc * static_cast<float>(k) < 1.0f)
+    k++;
+
+  return k;
+}
+
+// Branch-free segments (vectorizable)
+void fillConstant(float *output, size_t count, float value) {
+  for (size_t i = 0; i < count; i++)
+    output[i] = value;
+}
+
+// progress(k) = start + inc * (k + 1)
+void fillAttack(float *output, size_t count, float start, float inc) {
+  for (size_t i = 0; i < count; i++)
+    output[i] = start + inc * static_cast<float>(i + 1);
+}
+
+void fillDecay(float *output, size_t count, float start, float inc,
+               float sustainLevel) {
+  float depth = 1.0f - sustainLevel;
+  for (size_t i = 0; i < count; i++)
+    output[i] = 1.0f - (start + inc * static_cast<float>(i + 1)) * depth;
+}
+
+void fillRelease(float *output, size_t count, float start, float inc,
+                 float releaseStartLevel) {
+  for (size_t i = 0; i < count; i++)
+    output[i] = releaseStartLevel *
+                (1.0f - (start + inc * static_cast<float>(i + 1)));
+}
+
+// Curved segments: offset + scale * curve(start + inc * (k + 1))
+void fillCurve(float *output, size_t count, float start, float inc,
+               const float *curve, float offset, float scale) {
+  for (size_t i = 0; i < count; i++)
+    output[i] =
+        offset +
+        scale * readCurve(curve, start + inc * static_cast<float>(i + 1));
+}
+
+void fillAttackSegment(float *output, size_t count, float start, float inc,
+                       const float *curve) {
+  if (curve)
+    fillCurve(output, count, start, inc, curve, 0.0f, 1.0f);
+  else
+    fillAttack(output, count, start, inc);
+}
+
+void fillDecaySegment(float *output, size_t count, float start, float inc,
+                      float sustainLevel, const float *curve) {
+  if (curve)
+    fillCurve(output, count, start, inc, curve, 1.0f, sustainLevel - 1.0f);
+  else
+    fillDecay(output, count, start, inc, sustainLevel);
+}
+
+void fillReleaseSegment(float *output, size_t count, float start, float inc,
+                        float releaseStartLevel, const float *curve) {
+  if (curve)
+    fillCurve(output, count, start, inc, curve, releaseStartLevel,
+              -releaseStartLevel);
+  else
+    fillRelease(output, count, start, inc, releaseStartLevel);
+}
+} // namespace
+
+size_t processADSRBlock(Status &state, float &amplitude, float &progress,
+                        float &releaseStartLevel, float attackInc,
+                        float decayInc, float releaseInc, float sustainLevel,
+                        float *output, size_t numSamples,
+                        const StageCurves &curves) {
+  size_t pos = 0;
+
+  // One iteration per stage segment (at most one per stage per block)
+  while (pos < numSamples) {
+    size_t remaining = numSamples - pos;
+    float *out = output + pos;
+
+    switch (state) {
+    case Status::Attack: {
+      size_t k = samplesUntilBoundary(progress, attackInc, remaining);
+      if (k > remaining) {
+        fillAttackSegment(out, remaining, progress, attackInc, curves.attack);
+        progress += attackInc * static_cast<float>(remaining);
+        amplitude = out[remaining - 1];
+        pos = numSamples;
+        break;
+      }
+
+      fillAttackSegment(out, k - 1, progress, attackInc, curves.attack);
+      out[k - 1] = 1.0f;
+      state = Status::Decay;
+      progress = 0.0f;
+      amplitude = 1.0f;
+      pos += k;
+      break;
+    }
+
+    case Status::Decay: {
+      size_t k = samplesUntilBoundary(progress, decayInc, remaining);
+      if (k > remaining) {
+        fillDecaySegment(out, remaining, progress, decayInc, sustainLevel,
+                         curves.decay);
+        progress += decayInc * static_cast<float>(remaining);
+        amplitude = out[remaining - 1];
+        pos = numSamples;
+        break;
+      }
+
+      fillDecaySegment(out, k - 1, progress, decayInc, sustainLevel,
+                       curves.decay);
+      out[k - 1] = sustainLevel;
+      state = Status::Sustain;
+      progress = 1.0f;
+      amplitude = sustainLevel;
+      pos += k;
+      break;
+    }
+
+    case Status::Sustain:
+      fillConstant(out, remaining, sustainLevel);
+      amplitude = sustainLevel;
+      pos = numSamples;
+      break;
+
+    case Status::Release: {
+      size_t k = samplesUntilBoundary(progress, releaseInc, remaining);
+      if (k > remaining) {
+        fillReleaseSegment(out, remaining, progress, releaseInc,
+                           releaseStartLevel, curves.release);
+        progress += releaseInc * static_cast<float>(remaining);
+        amplitude = out[remaining - 1];
+        pos = numSamples;
+        break;
+      }
+
+      fillReleaseSegment(out, k - 1, progress, releaseInc, releaseStartLevel,
+                         curves.release);
+      out[k - 1] = 0.0f;
+      state = Status::Idle;
+      amplitude = 0.0f;
+      pos += k;
+
+      fillConstant(output + pos, numSamples - pos, 0.0f);
+      return pos;
+    }
+
+    case Status::Idle:
+      amplitude = 0.0f;
+      fillConstant(out, remaining, 0.0f);
+      return pos;
+    }
+  }
+
+  return numSamples;
+}
 } // namespace dsp::envelopes
@@ -0,0 +1,77 @@
+#include "dsp/Fft.h"
+#include "dsp/Math.h"
+
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+namespace dsp::fft {
+
+// ==== Transform Helpers ====
+namespace {
+void bitReverse(float *re, float *im, uint32_t size) {
+  for (uint32_t i = 1, j = 0; i < size; i++) {
+    uint32_t bit = size >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j |= bit;
+
+    if (i < j) {
+      std::swap(re[i], re[j]);
+      std::swap(im[i], im[j]);
+    }
+  }
+}
+
+// _sign_: -1 forward, +1 inverse
+void transform(float *re, float *im, uint32_t size, double sign) {
+  bitReverse(re, im, size);
+
+  for (uint32_t length = 2; length <= size; length <<= 1) {
+    // Twiddles by recurrence, in double so the error doesn't build up
+    double angle = sign * 2.0 * math::PI_DOUBLE / static_cast<double>(length);
+    double stepRe = std::cos(angle);
+    double stepIm = std::sin(angle);
+    uint32_t half = length >> 1;
+
+    double wRe = 1.0;
+    double wIm = 0.0;
+    for (uint32_t k = 0; k < half; k++) {
+      auto twRe = static_cast<float>(wRe);
+      auto twIm = static_cast<float>(wIm);
+
+      for (uint32_t start = 0; start < size; start += length) {
+        uint32_t a = start + k;
+        uint32_t b = a + half;
+
+        float bRe = re[b] * twRe - im[b] * twIm;
+        float bIm = re[b] * twIm + im[b] * twRe;
+        re[b] = re[a] - bRe;
+        im[b] = im[a] - bIm;
+        re[a] += bRe;
+        im[a] += bIm;
+      }
+
+      double nextRe = wRe * stepRe - wIm * stepIm;
+      wIm = wRe * stepIm + wIm * stepRe;
+      wRe = nextRe;
+    }
+  }
+}
+} // namespace
+
+void forwardFft(float *re, float *im, uint32_t size) {
+  transform(re, im, size, -1.0);
+}
+
+void inverseFft(float *re, float *im, uint32_t size) {
+  transform(re, im, size, 1.0);
+
+  float scale = 1.0f / static_cast<float>(size);
+  for (uint32_t i = 0; i < size; i++) {
+    re[i] *= scale;
+    im[i] *= scale;
+  }
+}
+
+} // namespace dsp::fft
@@ -89,4 +89,17 @@ float processLadderNonlinear(float input, float f, float resonance, float drive,
 
   return st.s[3];
 }
+
+float processLadderNonlinearFast(float input, float f, float resonance,
+                                 float drive, LadderState &st) {
+  float feedback = resonance * math::fastTanh(st.s[3]);
+  float x = math::fastTanh(drive * input - feedback);
+
+  st.s[0] += f * (x - st.s[0]);
+  st.s[1] += f * (st.s[0] - st.s[1]);
+  st.s[2] += f * (st.s[1] - st.s[2]);
+  st.s[3] += f * (st.s[2] - st.s[3]);
+
+  return st.s[3];
+}
 } // namespace dsp::filters
@@ -0,0 +1,259 @@
+#include "KernelsAvx2.h"
+
+#if DSP_HAS_AVX2_KERNELS
+
+#include "dsp/Effects.h"
+#include "dsp/Math.h"
+#include "dsp/Waveforms.h"
+
+#include "MathPolynomials.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+// Everything below is compiled for AVX2 (NOT fma: keeps mul + add rounding
+// identical to the 4 wide kernels)
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))),               \
+                             apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace dsp::dispatch::avx2 {
+using namespace dsp::math::poly;
+
+// ==== <8 Wide Helpers> ====
+// Same names/semantics as dsp::simd (internal linkage, never mixed with it)
+namespace {
+constexpr size_t WIDTH = 8;
+
+using f32x8 = __m256;
+using i32x8 = __m256i;
+using mask8 = __m256;
+
+size_t alignedCount(size_t count) { return count & ~(WIDTH - 1); }
+
+f32x8 load(const float *ptr) { return _mm256_loadu_ps(ptr); }
+void store(float *ptr, f32x8 v) { _mm256_storeu_ps(ptr, v); }
+f32x8 set1(float value) { return _mm256_set1_ps(value); }
+
+f32x8 add(f32x8 a, f32x8 b) { return _mm256_add_ps(a, b); }
+f32x8 sub(f32x8 a, f32x8 b) { return _mm256_sub_ps(a, b); }
+f32x8 mul(f32x8 a, f32x8 b) { return _mm256_mul_ps(a, b); }
+f32x8 div(f32x8 a, f32x8 b) { return _mm256_div_ps(a, b); }
+f32x8 min(f32x8 a, f32x8 b) { return _mm256_min_ps(a, b); }
+f32x8 max(f32x8 a, f32x8 b) { return _mm256_max_ps(a, b); }
+f32x8 abs(f32x8 v) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v); }
+
+mask8 cmpLt(f32x8 a, f32x8 b) { return _mm256_cmp_ps(a, b, _CMP_LT_OS); }
+mask8 cmpGt(f32x8 a, f32x8 b) { return _mm256_cmp_ps(a, b, _CMP_GT_OS); }
+mask8 maskAndNot(mask8 a, mask8 b) { return _mm256_andnot_ps(b, a); }
+
+// mask ? a : b (per lane)
+f32x8 select(mask8 mask, f32x8 a, f32x8 b) {
+  return _mm256_blendv_ps(b, a, mask);
+}
+
+i32x8 truncToInt(f32x8 v) { return _mm256_cvttps_epi32(v); }
+i32x8 roundToInt(f32x8 v) { return _mm256_cvtps_epi32(v); }
+f32x8 toFloat(i32x8 v) { return _mm256_cvtepi32_ps(v); }
+i32x8 set1Int(int32_t value) { return _mm256_set1_epi32(value); }
+i32x8 addInt(i32x8 a, i32x8 b) { return _mm256_add_epi32(a, b); }
+i32x8 andInt(i32x8 a, i32x8 b) { return _mm256_and_si256(a, b); }
+i32x8 xorInt(i32x8 a, i32x8 b) { return _mm256_xor_si256(a, b); }
+i32x8 shiftLeft23(i32x8 v) { return _mm256_slli_epi32(v, 23); }
+i32x8 shiftLeft31(i32x8 v) { return _mm256_slli_epi32(v, 31); }
+i32x8 asInt(f32x8 v) { return _mm256_castps_si256(v); }
+f32x8 asFloat(i32x8 v) { return _mm256_castsi256_ps(v); }
+
+// ==== Math ====
+f32x8 fastExp2x8(f32x8 x) {
+  f32x8 xFloor = toFloat(truncToInt(x));
+  xFloor = select(cmpGt(xFloor, x), sub(xFloor, set1(1.0f)), xFloor);
+  i32x8 xi = truncToInt(xFloor);
+  f32x8 xf = sub(x, xFloor);
+
+  f32x8 p = add(set1(EXP2_C3), mul(xf, set1(EXP2_C4)));
+  p = add(set1(EXP2_C2), mul(xf, p));
+  p = add(set1(EXP2_C1), mul(xf, p));
+  p = add(set1(1.0f), mul(xf, p));
+
+  return asFloat(addInt(asInt(p), shiftLeft23(xi)));
+}
+
+f32x8 fastSinPhasex8(f32x8 phase) {
+  i32x8 k = roundToInt(mul(set1(2.0f), phase));
+  f32x8 t = sub(phase, mul(set1(0.5f), toFloat(k)));
+
+  f32x8 t2 = mul(t, t);
+  f32x8 p = add(set1(SIN_C7), mul(t2, set1(SIN_C9)));
+  p = add(set1(SIN_C5), mul(t2, p));
+  p = add(set1(SIN_C3), mul(t2, p));
+  p = add(set1(SIN_C1), mul(t2, p));
+
+  i32x8 sign = shiftLeft31(andInt(k, set1Int(1)));
+  return asFloat(xorInt(asInt(mul(t, p)), sign));
+}
+
+f32x8 fastTanhx8(f32x8 x) {
+  x = min(max(x, set1(-3.0f)), set1(3.0f));
+
+  f32x8 x2 = mul(x, x);
+  f32x8 num = mul(x, add(set1(27.0f), x2));
+  f32x8 den = add(set1(27.0f), mul(set1(9.0f), x2));
+  return div(num, den);
+}
+
+// ==== Waveforms ====
+f32x8 polyBlepAfter(f32x8 t) {
+  return add(sub(mul(t, t), mul(set1(2.0f), t)), set1(1.0f));
+}
+
+f32x8 polyBlepBefore(f32x8 t) {
+  return add(add(mul(t, t), mul(set1(2.0f), t)), set1(1.0f));
+}
+
+f32x8 polyBlepCorrection(f32x8 phase, f32x8 inc) {
+  const f32x8 one = set1(1.0f);
+
+  mask8 isAfter = cmpLt(phase, inc);
+  mask8 isBefore = maskAndNot(cmpGt(phase, sub(one, inc)), isAfter);
+
+  f32x8 after = polyBlepAfter(div(phase, inc));
+  f32x8 before = polyBlepBefore(div(sub(phase, one), inc));
+
+  return select(isAfter, after, select(isBefore, before, set1(0.0f)));
+}
+
+f32x8 saw8(f32x8 phase, f32x8 inc) {
+  f32x8 value = sub(mul(set1(2.0f), phase), set1(1.0f));
+  return sub(value, polyBlepCorrection(phase, inc));
+}
+
+f32x8 square8(f32x8 phase, f32x8 inc, f32x8 pulseWidth) {
+  const f32x8 one = set1(1.0f);
+  f32x8 value = select(cmpLt(phase, pulseWidth), one, set1(-1.0f));
+
+  value = add(value, polyBlepCorrection(phase, inc));
+
+  f32x8 pwmPhase = sub(phase, pulseWidth);
+  pwmPhase = select(cmpLt(pwmPhase, set1(0.0f)), add(pwmPhase, one), pwmPhase);
+
+  return sub(value, polyBlepCorrection(pwmPhase, inc));
+}
+
+f32x8 triangle8(f32x8 phase) {
+  f32x8 dist = abs(sub(phase, set1(0.5f)));
+  return sub(set1(1.0f), mul(set1(4.0f), dist));
+}
+} // namespace
+// ==== </8 Wide Helpers> ====
+
+// Remainders (< 8 samples) go through the 4 wide kernels
+void fastExp2Block(const float *input, float *output, size_t numSamples) {
+  size_t vecCount = alignedCount(numSamples);
+  for (size_t i = 0; i < vecCount; i += WIDTH)
+    store(output + i, fastExp2x8(load(input + i)));
+
+  math::fastExp2Block(input + vecCount, output + vecCount,
+                      numSamples - vecCount);
+}
+
+void semitonesToFreqRatioBlock(const float *input, float *output,
+                               size_t numSamples) {
+  size_t vecCount = alignedCount(numSamples);
+  const f32x8 semitones = set1(12.0f);
+  for (size_t i = 0; i < vecCount; i += WIDTH)
+    store(output + i, fastExp2x8(div(load(input + i), semitones)));
+
+  math::semitonesToFreqRatioBlock(input + vecCount, output + vecCount,
+                                  numSamples - vecCount);
+}
+
+void fastSinPhaseBlock(const float *input, float *output, size_t numSamples) {
+  size_t vecCount = alignedCount(numSamples);
+  for (size_t i = 0; i < vecCount; i += WIDTH)
+    store(output + i, fastSinPhasex8(load(input + i)));
+
+  math::fastSinPhaseBlock(input + vecCount, output + vecCount,
+                          numSamples - vecCount);
+}
+
+void fastTanhBlock(const float *input, float *output, size_t numSamples) {
+  size_t vecCount = alignedCount(numSamples);
+  for (size_t i = 0; i < vecCount; i += WIDTH)
+    store(output + i, fastTanhx8(load(input + i)));
+
+  math::fastTanhBlock(input + vecCount, output + vecCount,
+                      numSamples - vecCount);
+}
+
+void processWaveformBlock(waveforms::WaveformType type, const float *phases,
+                          const float *phaseIncrements, float *output,
+                          size_t numSamples, float pulseWidth) {
+  using WaveformType = waveforms::WaveformType;
+  size_t vecCount = alignedCount(numSamples);
+
+  switch (type) {
+  case WaveformType::WAVEFORM_COUNT:
+  case WaveformType::Wavetable:
+  case WaveformType::Sine:
+    for (size_t i = 0; i < vecCount; i += WIDTH)
+      store(output + i, fastSinPhasex8(load(phases + i)));
+    break;
+
+  case WaveformType::Saw:
+    for (size_t i = 0; i < vecCount; i += WIDTH)
+      store(output + i, saw8(load(phases + i), load(phaseIncrements + i)));
+    break;
+
+  case WaveformType::Square: {
+    const f32x8 pw = set1(pulseWidth);
+    for (size_t i = 0; i < vecCount; i += WIDTH)
+      store(output + i,
+            square8(load(phases + i), load(phaseIncrements + i), pw));
+    break;
+  }
+
+  case WaveformType::Triangle:
+    for (size_t i = 0; i < vecCount; i += WIDTH)
+      store(output + i, triangle8(load(phases + i)));
+    break;
+  }
+
+  waveforms::processWaveformBlock(type, phases + vecCount,
+                                  phaseIncrements + vecCount,
+                                  output + vecCount, numSamples - vecCount,
+                                  pulseWidth);
+}
+
+void softClipFastBlock(const float *input, float *output, size_t numSamples,
+                       float inputGain) {
+  size_t vecCount = alignedCount(numSamples);
+
+  const f32x8 gain = set1(inputGain);
+  const f32x8 c27 = set1(27.0f);
+  const f32x8 c9 = set1(9.0f);
+
+  for (size_t i = 0; i < vecCount; i += WIDTH) {
+    f32x8 x = mul(load(input + i), gain);
+    f32x8 num = mul(x, add(c27, mul(x, x)));
+    f32x8 den = add(c27, mul(mul(c9, x), x));
+    store(output + i, div(num, den));
+  }
+
+  effects::softClipFastBlock(input + vecCount, output + vecCount,
+                             numSamples - vecCount, inputGain);
+}
+} // namespace dsp::dispatch::avx2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // DSP_HAS_AVX2_KERNELS
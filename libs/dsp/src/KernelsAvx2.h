@@ -0,0 +1,30 @@
+#pragma once
+
+#include "dsp/Waveforms.h"
+
+#include <cstddef>
+
+/* 8 wide AVX2 kernels (x86_64 only, see dsp/Dispatch.h)
+ * - compiled with a per-function target attribute, no global -mavx2
+ * - same operation order as the 4 wide kernels (bit-identical output,
+ *   within 1 ulp under -ffast-math)
+ * NOTE: only call after the CPU reported AVX2 support
+ */
+#if defined(__x86_64__) || defined(_M_X64)
+#define DSP_HAS_AVX2_KERNELS 1
+
+namespace dsp::dispatch::avx2 {
+void fastExp2Block(const float *input, float *output, size_t numSamples);
+void semitonesToFreqRatioBlock(const float *input, float *output,
+                               size_t numSamples);
+void fastSinPhaseBlock(const float *input, float *output, size_t numSamples);
+void fastTanhBlock(const float *input, float *output, size_t numSamples);
+
+void processWaveformBlock(waveforms::WaveformType type, const float *phases,
+                          const float *phaseIncrements, float *output,
+                          size_t numSamples, float pulseWidth);
+
+void softClipFastBlock(const float *input, float *output, size_t numSamples,
+                       float inputGain);
+} // namespace dsp::dispatch::avx2
+#endif
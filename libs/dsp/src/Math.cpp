@@ -1,21 +1,47 @@
 #include "dsp/Math.h"
+#include "dsp/Simd.h"
 
+#include "MathPolynomials.h"
+
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 
 namespace dsp::math {
+using namespace poly;
+
+// ==== Polynomial Helpers ====
+namespace {
+constexpr float INV_TWO_PI_F = 1.0f / TWO_PI_F;
+
+float sinQuarterPoly(float t) {
+  float t2 = t * t;
+  return t * (SIN_C1 + t2 * (SIN_C3 + t2 * (SIN_C5 + t2 * (SIN_C7 +
+                                                          t2 * SIN_C9))));
+}
+
+float log2MantissaPoly(float u) {
+  return u * (LOG2_C1 +
+              u * (LOG2_C2 +
+                   u * (LOG2_C3 +
+                        u * (LOG2_C4 + u * (LOG2_C5 + u * LOG2_C6)))));
+}
+} // namespace
+
 float fastExp2(float x) {
-  int32_t xi = static_cast<int32_t>(x);
-  float xf = x - static_cast<float>(xi);
+  // Floor (not truncate) so xf lands in [0, 1), the range the polynomial fits
+  float xFloor = std::floor(x);
+  int32_t xi = static_cast<int32_t>(xFloor);
+  float xf = x - xFloor;
 
-  float p =
-      1.0f + xf * (0.6931472f +
-                   xf * (0.2402265f + xf * (0.0555041f + xf * 0.0096181f)));
+  float p = 1.0f + xf * (EXP2_C1 + xf * (EXP2_C2 + xf * (EXP2_C3 +
+                                                          xf * EXP2_C4)));
 
   int32_t bits;
   std::memcpy(&bits, &p, 4);
 
-  bits += xi << 23;
+  bits += static_cast<int32_t>(static_cast<uint32_t>(xi) << 23);
 
   std::memcpy(&p, &bits, 4);
   return p;
@@ -23,4 +49,213 @@ float fastExp2(float x) {
 
 float semitonesToFreqRatio(float x) { return fastExp2(x / 12); }
 
+float fastSinPhase(float phase) {
+  // Nearest half cycle k off -> [-0.25, 0.25], odd k flips the sign
+  // (sin(2π (t + k / 2)) = (-1)^k sin(2π t)). 2 * phase, 0.5 * k and the
+  // remainder are all exact, so -ffast-math has nothing to reassociate
+  int32_t k = static_cast<int32_t>(std::lrint(2.0f * phase));
+  float s = sinQuarterPoly(phase - 0.5f * static_cast<float>(k));
+  return (k & 1) ? -s : s;
+}
+
+float fastSin(float x) { return fastSinPhase(x * INV_TWO_PI_F); }
+
+float fastCos(float x) { return fastSinPhase(x * INV_TWO_PI_F + 0.25f); }
+
+float fastTan(float x) {
+  float phase = x * INV_TWO_PI_F;
+  return fastSinPhase(phase) / fastSinPhase(phase + 0.25f);
+}
+
+float fastLog2(float x) {
+  int32_t bits;
+  std::memcpy(&bits, &x, 4);
+
+  int32_t exponent = (bits >> 23) - FLOAT_EXPONENT_BIAS;
+
+  // Mantissa as a float in [1, 2)
+  int32_t mantissaBits = (bits & FLOAT_MANTISSA_MASK) | FLOAT_ONE_BITS;
+  float mantissa;
+  std::memcpy(&mantissa, &mantissaBits, 4);
+
+  return static_cast<float>(exponent) + log2MantissaPoly(mantissa - 1.0f);
+}
+
+float fastTanh(float x) {
+  if (x > 3.0f)
+    return 1.0f;
+  if (x < -3.0f)
+    return -1.0f;
+
+  float x2 = x * x;
+  return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+}
+
+// ==== Block (array) forms ====
+namespace {
+// Lane-wise fastExp2 (same operations/order as the scalar version)
+simd::f32x4 fastExp2x4(simd::f32x4 x) {
+  // Floor as truncate, minus one where that rounded up (x < 0)
+  simd::f32x4 xFloor = simd::toFloat(simd::truncToInt(x));
+  xFloor = simd::select(simd::cmpGt(xFloor, x),
+                        simd::sub(xFloor, simd::set1(1.0f)), xFloor);
+  simd::i32x4 xi = simd::truncToInt(xFloor);
+  simd::f32x4 xf = simd::sub(x, xFloor);
+
+  simd::f32x4 p =
+      simd::add(simd::set1(EXP2_C3), simd::mul(xf, simd::set1(EXP2_C4)));
+  p = simd::add(simd::set1(EXP2_C2), simd::mul(xf, p));
+  p = simd::add(simd::set1(EXP2_C1), simd::mul(xf, p));
+  p = simd::add(simd::set1(1.0f), simd::mul(xf, p));
+
+  simd::i32x4 bits = simd::addInt(simd::asInt(p), simd::shiftLeft<23>(xi));
+  return simd::asFloat(bits);
+}
+
+// Lane-wise fastSinPhase (odd half cycles flip the sign bit, no branches)
+simd::f32x4 fastSinPhasex4(simd::f32x4 phase) {
+  simd::i32x4 k = simd::roundToInt(simd::mul(simd::set1(2.0f), phase));
+  simd::f32x4 t =
+      simd::sub(phase, simd::mul(simd::set1(0.5f), simd::toFloat(k)));
+
+  simd::f32x4 t2 = simd::mul(t, t);
+  simd::f32x4 p =
+      simd::add(simd::set1(SIN_C7), simd::mul(t2, simd::set1(SIN_C9)));
+  p = simd::add(simd::set1(SIN_C5), simd::mul(t2, p));
+  p = simd::add(simd::set1(SIN_C3), simd::mul(t2, p));
+  p = simd::add(simd::set1(SIN_C1), simd::mul(t2, p));
+
+  simd::i32x4 sign =
+      simd::shiftLeft<31>(simd::andInt(k, simd::set1Int(1)));
+  return simd::asFloat(simd::xorInt(simd::asInt(simd::mul(t, p)), sign));
+}
+
+simd::f32x4 fastTanhx4(simd::f32x4 x) {
+  // Pade is exactly +-1 at |x| = 3, so clamping the input is the same as
+  // clamping the output
+  x = simd::min(simd::max(x, simd::set1(-3.0f)), simd::set1(3.0f));
+
+  simd::f32x4 x2 = simd::mul(x, x);
+  simd::f32x4 num = simd::mul(x, simd::add(simd::set1(27.0f), x2));
+  simd::f32x4 den =
+      simd::add(simd::set1(27.0f), simd::mul(simd::set1(9.0f), x2));
+  return simd::div(num, den);
+}
+
+simd::f32x4 fastLog2x4(simd::f32x4 x) {
+  simd::i32x4 bits = simd::asInt(x);
+
+  simd::i32x4 exponent = simd::subInt(simd::shiftRight<23>(bits),
+                                      simd::set1Int(FLOAT_EXPONENT_BIAS));
+  simd::i32x4 mantissaBits =
+      simd::orInt(simd::andInt(bits, simd::set1Int(FLOAT_MANTISSA_MASK)),
+                  simd::set1Int(FLOAT_ONE_BITS));
+  simd::f32x4 u = simd::sub(simd::asFloat(mantissaBits), simd::set1(1.0f));
+
+  simd::f32x4 p =
+      simd::add(simd::set1(LOG2_C5), simd::mul(u, simd::set1(LOG2_C6)));
+  p = simd::add(simd::set1(LOG2_C4), simd::mul(u, p));
+  p = simd::add(simd::set1(LOG2_C3), simd::mul(u, p));
+  p = simd::add(simd::set1(LOG2_C2), simd::mul(u, p));
+  p = simd::add(simd::set1(LOG2_C1), simd::mul(u, p));
+
+  return simd::add(simd::toFloat(exponent), simd::mul(u, p));
+}
+} // namespace
+
+void fastExp2Block(const float *input, float *output, size_t numSamples) {
+  size_t vecCount = simd::alignedCount(numSamples);
+  size_t i = 0;
+
+  for (; i < vecCount; i += simd::WIDTH)
+    simd::store(output + i, fastExp2x4(simd::load(input + i)));
+
+  for (; i < numSamples; i++)
+    output[i] = fastExp2(input[i]);
+}
+
+void semitonesToFreqRatioBlock(const float *input, float *output,
+                               size_t numSamples) {
+  size_t vecCount = simd::alignedCount(numSamples);
+  size_t i = 0;
+
+  const simd::f32x4 semitones = simd::set1(12.0f);
+  for (; i < vecCount; i += simd::WIDTH) {
+    simd::f32x4 octaves = simd::div(simd::load(input + i), semitones);
+    simd::store(output + i, fastExp2x4(octaves));
+  }
+
+  for (; i < numSamples; i++)
+    output[i] = semitonesToFreqRatio(input[i]);
+}
+
+void fastSinPhaseBlock(const float *input, float *output, size_t numSamples) {
+  size_t vecCount = simd::alignedCount(numSamples);
+  size_t i = 0;
+
+  for (; i < vecCount; i += simd::WIDTH)
+    simd::store(output + i, fastSinPhasex4(simd::load(input + i)));
+
+  for (; i < numSamples; i++)
+    output[i] = fastSinPhase(input[i]);
+}
+
+void fastSinBlock(const float *input, float *output, size_t numSamples) {
+  size_t vecCount = simd::alignedCount(numSamples);
+  size_t i = 0;
+
+  const simd::f32x4 invTwoPi = simd::set1(INV_TWO_PI_F);
+  for (; i < vecCount; i += simd::WIDTH)
+    simd::store(output + i, fastSinPhasex4(simd::mul(simd::load(input + i),
+                                                     invTwoPi)));
+
+  for (; i < numSamples; i++)
+    output[i] = fastSin(input[i]);
+}
+
+void fastTanBlock(const float *input, float *output, size_t numSamples) {
+  size_t vecCount = simd::alignedCount(numSamples);
+  size_t i = 0;
+
+  const simd::f32x4 invTwoPi = simd::set1(INV_TWO_PI_F);
+  const simd::f32x4 quarter = simd::set1(0.25f);
+  for (; i < vecCount; i += simd::WIDTH) {
+    simd::f32x4 phase = simd::mul(simd::load(input + i), invTwoPi);
+    simd::store(output + i,
+                simd::div(fastSinPhasex4(phase),
+                          fastSinPhasex4(simd::add(phase, quarter))));
+  }
+
+  for (; i < numSamples; i++)
+    output[i] = fastTan(input[i]);
+}
+
+void fastTanhBlock(const float *input, float *output, size_t numSamples) {
+  size_t vecCount = simd::alignedCount(numSamples);
+  size_t i = 0;
+
+  for (; i < vecCount; i += simd::WIDTH)
+    simd::store(output + i, fastTanhx4(simd::load(input + i)));
+
+  for (; i < numSamples; i++)
+    output[i] = fastTanh(input[i]);
+}
+
+void fastLog2Block(const float *input, float *output, size_t numSamples) {
+  size_t vecCount = simd::alignedCount(numSamples);
+  size_t i = 0;
+
+  for (; i < vecCount; i += simd::WIDTH)
+    simd::store(output + i, fastLog2x4(simd::load(input + i)));
+
+  for (; i < numSamples; i++)
+    output[i] = fastLog2(input[i]);
+}
+
+void semitonesToFreqRatioExactBlock(const float *input, float *output,
+                                    size_t numSamples) {
+  for (size_t i = 0; i < numSamples; i++)
+    output[i] = std::exp2(input[i] * SEMITONE_PER_OCTAVE);
+}
+
 } // namespace dsp::math
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+// Polynomial coefficients shared by the scalar, 4 wide and 8 wide kernels
+// (keeps every dispatch target bit-identical)
+namespace dsp::math::poly {
+// 2^f for f in [0, 1), minimax relative error polynomial (degree 4, rel
+// 3.3e-6), ends pinned at 1 and 2 so 2^x stays continuous across integers
+inline constexpr float EXP2_C1 = 0.693032146f;
+inline constexpr float EXP2_C2 = 0.241379768f;
+inline constexpr float EXP2_C3 = 0.0520323701f;
+inline constexpr float EXP2_C4 = 0.0135557475f;
+
+// sin(2π t) for |t| <= 0.25, odd minimax polynomial (degree 9)
+inline constexpr float SIN_C1 = 6.28318516f;
+inline constexpr float SIN_C3 = -41.341655f;
+inline constexpr float SIN_C5 = 81.6010048f;
+inline constexpr float SIN_C7 = -76.5497971f;
+inline constexpr float SIN_C9 = 39.5368077f;
+
+// log2(1 + u) for u in [0, 1), minimax polynomial (degree 6, no constant)
+inline constexpr float LOG2_C1 = 1.4425531f;
+inline constexpr float LOG2_C2 = -0.71828133f;
+inline constexpr float LOG2_C3 = 0.458268115f;
+inline constexpr float LOG2_C4 = -0.279532743f;
+inline constexpr float LOG2_C5 = 0.123446566f;
+inline constexpr float LOG2_C6 = -0.0264557783f;
+
+inline constexpr int32_t FLOAT_EXPONENT_BIAS = 127;
+inline constexpr int32_t FLOAT_MANTISSA_MASK = 0x007FFFFF;
+inline constexpr int32_t FLOAT_ONE_BITS = 0x3F800000;
+} // namespace dsp::math::poly
@@ -1,6 +1,7 @@
 #include "dsp/Modulation.h"
 #include "dsp/Waveforms.h"
 #include <cmath>
+#include <cstddef>
 
 namespace dsp::modulation {
 // Generate LFO waveform at given phase
@@ -8,6 +9,7 @@ float processLFO(float phase, waveforms::WaveformType type, float pulseWidth) {
   // LFOs often centered around 0 with range -1 to +1
   switch (type) {
   case waveforms::WaveformType::WAVEFORM_COUNT:
+  case waveforms::WaveformType::Wavetable:
   case waveforms::WaveformType::Sine:
     return waveforms::sine(phase);
   case waveforms::WaveformType::Saw:
@@ -19,6 +21,13 @@ float processLFO(float phase, waveforms::WaveformType type, float pulseWidth) {
   }
 }
 
+// Same shapes as processLFO: naive (un-BLEPed) saw/square
+void processLFOBlock(const float *phases, float *output, size_t count,
+                     waveforms::WaveformType type, float pulseWidth) {
+  waveforms::processWaveformNaiveBlock(type, phases, output, count,
+                                       pulseWidth);
+}
+
 // TODO(nico): spend more time understanding these...
 // Modulation curves (for velocity, mod wheel, etc.)
 float exponentialCurve(float linear) {
@@ -0,0 +1,92 @@
+#include "dsp/Noise.h"
+#include "dsp/Simd.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace dsp::noise {
+using namespace dsp::simd;
+
+// ==== Noise Helpers ====
+namespace {
+constexpr uint32_t ONE_BITS = 0x3F800000u; // 1.0f
+
+// splitmix32 finalizer: decorrelates nearby seeds (voice 0, 1, 2...)
+uint32_t hashSeed(uint32_t x) {
+  x += 0x9E3779B9u;
+  x = (x ^ (x >> 16)) * 0x85EBCA6Bu;
+  x = (x ^ (x >> 13)) * 0xC2B2AE35u;
+  return x ^ (x >> 16);
+}
+
+uint32_t xorshift32(uint32_t x) {
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return x;
+}
+
+// Top 23 bits as mantissa: [1, 2) -> [-1, 1)
+float toBipolar(uint32_t x) {
+  uint32_t bits = (x >> 9) | ONE_BITS;
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value * 2.0f - 3.0f;
+}
+
+i32x4 xorshift32x4(i32x4 x) {
+  x = xorInt(x, shiftLeft<13>(x));
+  x = xorInt(x, shiftRight<17>(x));
+  x = xorInt(x, shiftLeft<5>(x));
+  return x;
+}
+
+f32x4 toBipolarx4(i32x4 x) {
+  f32x4 value = asFloat(
+      orInt(shiftRight<9>(x), set1Int(static_cast<int32_t>(ONE_BITS))));
+  return sub(mul(value, set1(2.0f)), set1(3.0f));
+}
+} // namespace
+
+void seedNoise(NoiseState &state, uint32_t seed) {
+  for (size_t i = 0; i < NOISE_LANES; i++) {
+    auto laneIndex = static_cast<uint32_t>(i);
+    uint32_t lane =
+        hashSeed(seed * static_cast<uint32_t>(NOISE_LANES) + laneIndex);
+    state.lanes[i] = lane ? lane : 1u; // xorshift sticks at 0
+  }
+}
+
+float processNoise(NoiseState &state) {
+  state.lanes[0] = xorshift32(state.lanes[0]);
+  return toBipolar(state.lanes[0]);
+}
+
+void processNoiseBlock(NoiseState &state, float *output, size_t numSamples) {
+  static_assert(NOISE_LANES == WIDTH, "one xorshift stream per SIMD lane");
+
+  int32_t lanes[NOISE_LANES];
+  std::memcpy(lanes, state.lanes, sizeof(lanes));
+  i32x4 x = loadInt(lanes);
+
+  size_t vecCount = alignedCount(numSamples);
+  for (size_t i = 0; i < vecCount; i += WIDTH) {
+    x = xorshift32x4(x);
+    store(output + i, toBipolarx4(x));
+  }
+
+  // Tail: one more step, unused lanes are dropped
+  if (vecCount < numSamples) {
+    x = xorshift32x4(x);
+
+    alignas(16) float tail[WIDTH];
+    store(tail, toBipolarx4(x));
+    for (size_t i = vecCount; i < numSamples; i++)
+      output[i] = tail[i - vecCount];
+  }
+
+  storeInt(lanes, x);
+  std::memcpy(state.lanes, lanes, sizeof(lanes));
+}
+} // namespace dsp::noise
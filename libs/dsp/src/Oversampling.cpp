@@ -0,0 +1,100 @@
+#include "dsp/Oversampling.h"
+
+#include <cstring>
+
+namespace dsp::oversampling {
+
+// ==== Half-band Helpers ====
+namespace {
+constexpr size_t K = HALF_BAND_PAIRS;
+
+// Odd taps h[c +- (2j + 1)] of the 4K - 1 tap half-band (center tap = 0.5)
+// Kaiser window (beta = 8), normalized to unity DC gain
+constexpr float HALF_BAND_TAPS[K] = {
+    0.316060026f,  -0.099533667f, 0.053239109f,  -0.031905918f,
+    0.019511503f,  -0.011685277f, 0.006670786f,  -0.003539435f,
+    0.001690635f,  -0.000689997f, 0.000214602f,  -0.000032368f,
+};
+
+constexpr size_t UP_HISTORY = 2 * K;
+constexpr size_t DOWN_HISTORY = 4 * K;
+
+// Input is processed in chunks so the history + chunk fits on the stack
+constexpr size_t CHUNK_SIZE = 64;
+} // namespace
+
+void resetOversampler(OversamplerState &state) { state = OversamplerState{}; }
+
+/* Zero stuffing + half-band, split into its two polyphase branches
+ * (upsampled gain of 2 folded in):
+ *   out[2p]     = 2 * sum_j h_j * (x[p - K + 1 + j] + x[p - K - j])
+ *   out[2p + 1] = x[p - K + 1]   (center tap only)
+ */
+void upsample2x(HalfBandState &state, const float *input, float *output,
+                size_t numSamples) {
+  float ext[UP_HISTORY + CHUNK_SIZE];
+  std::memcpy(ext, state.up, sizeof(state.up));
+
+  for (size_t offset = 0; offset < numSamples; offset += CHUNK_SIZE) {
+    size_t count = numSamples - offset;
+    if (count > CHUNK_SIZE)
+      count = CHUNK_SIZE;
+
+    std::memcpy(ext + UP_HISTORY, input + offset, count * sizeof(float));
+
+    float *out = output + 2 * offset;
+    for (size_t p = 0; p < count; p++) {
+      // ext[UP_HISTORY + i] = x[i]
+      const float *x = ext + UP_HISTORY + p - K;
+
+      float sum = 0.0f;
+      for (size_t j = 0; j < K; j++)
+        sum += HALF_BAND_TAPS[j] * (x[1 + j] + x[-static_cast<ptrdiff_t>(j)]);
+
+      out[2 * p] = 2.0f * sum;
+      out[2 * p + 1] = x[1];
+    }
+
+    // Keep the newest samples as the next chunk's history
+    std::memmove(ext, ext + count, UP_HISTORY * sizeof(float));
+  }
+
+  std::memcpy(state.up, ext, sizeof(state.up));
+}
+
+/* Half-band + decimation, only the kept (even) outputs are computed:
+ *   out[p] = 0.5 * v[2p - 2K + 1]
+ *          + sum_j h_j * (v[2p - 2K + 2 + 2j] + v[2p - 2K - 2j])
+ */
+void downsample2x(HalfBandState &state, const float *input, float *output,
+                  size_t numSamples) {
+  float ext[DOWN_HISTORY + 2 * CHUNK_SIZE];
+  std::memcpy(ext, state.down, sizeof(state.down));
+
+  for (size_t offset = 0; offset < numSamples; offset += CHUNK_SIZE) {
+    size_t count = numSamples - offset;
+    if (count > CHUNK_SIZE)
+      count = CHUNK_SIZE;
+
+    std::memcpy(ext + DOWN_HISTORY, input + 2 * offset,
+                2 * count * sizeof(float));
+
+    for (size_t p = 0; p < count; p++) {
+      // Center tap: v[2p - 2K + 1]
+      const float *v = ext + DOWN_HISTORY + 2 * p - 2 * K + 1;
+
+      float sum = 0.5f * v[0];
+      for (size_t j = 0; j < K; j++) {
+        auto tap = static_cast<ptrdiff_t>(2 * j + 1);
+        sum += HALF_BAND_TAPS[j] * (v[tap] + v[-tap]);
+      }
+
+      output[offset + p] = sum;
+    }
+
+    std::memmove(ext, ext + 2 * count, DOWN_HISTORY * sizeof(float));
+  }
+
+  std::memcpy(state.down, ext, sizeof(state.down));
+}
+} // namespace dsp::oversampling
@@ -0,0 +1,169 @@
+#include "dsp/Resampler.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace dsp::resampler {
+
+// ==== Filter Helpers ====
+namespace {
+constexpr double KAISER_BETA = 8.0;
+
+// Cutoff as a fraction of the lower Nyquist (the rest is transition band)
+constexpr double CUTOFF = 0.9;
+
+constexpr double PI = 3.14159265358979323846;
+
+uint32_t greatestCommonDivisor(uint32_t a, uint32_t b) {
+  while (b != 0) {
+    uint32_t rest = a % b;
+    a = b;
+    b = rest;
+  }
+  return a;
+}
+
+// Zeroth order modified Bessel function (Kaiser window), power series
+double besselI0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+  for (int k = 1; k < 32; k++) {
+    double half = x / (2.0 * k);
+    term *= half * half;
+    sum += term;
+  }
+  return sum;
+}
+
+/* Prototype low-pass at upFactor * inputRate, split into phases:
+ *   phase p, tap k (k = 0: newest input) = h[k * upFactor + p]
+ * stored oldest tap first, each phase normalized to unity DC gain
+ */
+void buildPhases(Resampler &resampler) {
+  const uint32_t up = resampler.upFactor;
+  const uint32_t length = up * RESAMPLER_TAPS;
+  const double center = (length - 1) * 0.5;
+
+  // Normalized to the upsampled rate (cycles per sample)
+  uint32_t maxFactor = up > resampler.downFactor ? up : resampler.downFactor;
+  const double cutoff = CUTOFF * 0.5 / maxFactor;
+  const double windowNorm = 1.0 / besselI0(KAISER_BETA);
+
+  for (uint32_t p = 0; p < up; p++) {
+    float *phase = resampler.phases + size_t{p} * RESAMPLER_TAPS;
+    double sum = 0.0;
+
+    for (uint32_t k = 0; k < RESAMPLER_TAPS; k++) {
+      double t = k * up + p - center;
+      double x = 2.0 * cutoff * t;
+      double sinc = t == 0.0 ? 1.0 : std::sin(PI * x) / (PI * x);
+
+      double w = 2.0 * (k * up + p) / (length - 1) - 1.0;
+      double window =
+          besselI0(KAISER_BETA * std::sqrt(1.0 - w * w)) * windowNorm;
+
+      double tap = sinc * window;
+      phase[RESAMPLER_TAPS - 1 - k] = static_cast<float>(tap);
+      sum += tap;
+    }
+
+    for (uint32_t k = 0; k < RESAMPLER_TAPS; k++)
+      phase[k] = static_cast<float>(phase[k] / sum);
+  }
+}
+} // namespace
+
+Resampler createResampler(uint32_t inputRate, uint32_t outputRate,
+                          uint32_t maxInputFrames) {
+  Resampler resampler{};
+  if (inputRate == 0 || outputRate == 0)
+    return resampler;
+
+  uint32_t divisor = greatestCommonDivisor(inputRate, outputRate);
+  resampler.upFactor = outputRate / divisor;
+  resampler.downFactor = inputRate / divisor;
+  if (resampler.upFactor > MAX_RESAMPLER_PHASES)
+    return Resampler{};
+
+  resampler.phases =
+      new float[size_t{resampler.upFactor} * RESAMPLER_TAPS]();
+  buildPhases(resampler);
+
+  // Input left over after a process call is less than one output's worth
+  // (down / up, rounded up)
+  uint32_t leftover = resampler.downFactor / resampler.upFactor + 1;
+  resampler.windowCapacity = RESAMPLER_TAPS + maxInputFrames + leftover;
+  resampler.window = new float[resampler.windowCapacity]();
+
+  resetResampler(resampler);
+  return resampler;
+}
+
+void disposeResampler(Resampler &resampler) {
+  delete[] resampler.phases;
+  delete[] resampler.window;
+  resampler = Resampler{};
+}
+
+void resetResampler(Resampler &resampler) {
+  if (resampler.window)
+    std::memset(resampler.window, 0,
+                resampler.windowCapacity * sizeof(float));
+
+  resampler.windowCount = RESAMPLER_TAPS;
+  resampler.position = 0;
+}
+
+void pushResamplerInput(Resampler &resampler, const float *input,
+                        uint32_t numFrames) {
+  uint32_t room = resampler.windowCapacity - resampler.windowCount;
+  if (numFrames > room)
+    numFrames = room;
+
+  std::memcpy(resampler.window + resampler.windowCount, input,
+              numFrames * sizeof(float));
+  resampler.windowCount += numFrames;
+}
+
+void processResampler(Resampler &resampler, float *output,
+                      uint32_t numOutputFrames) {
+  const uint32_t up = resampler.upFactor;
+  const uint32_t down = resampler.downFactor;
+
+  // Index of the newest consumed input (history ends at RESAMPLER_TAPS - 1)
+  uint32_t newest = RESAMPLER_TAPS - 1;
+  uint32_t position = resampler.position;
+
+  for (uint32_t n = 0; n < numOutputFrames; n++) {
+    // Missing input (caller pushed too little) holds the last sample
+    while (position >= up && newest + 1 < resampler.windowCount) {
+      newest++;
+      position -= up;
+    }
+    if (position >= up)
+      position = up - 1;
+
+    const float *x = resampler.window + newest + 1 - RESAMPLER_TAPS;
+    const float *h = resampler.phases + size_t{position} * RESAMPLER_TAPS;
+
+    float sum = 0.0f;
+    for (uint32_t k = 0; k < RESAMPLER_TAPS; k++)
+      sum += h[k] * x[k];
+
+    output[n] = sum;
+    position += down;
+  }
+
+  resampler.position = position;
+
+  // Keep the newest RESAMPLER_TAPS consumed inputs (and anything pushed
+  // past them) as the next call's history
+  uint32_t keepStart = newest + 1 - RESAMPLER_TAPS;
+  std::memmove(resampler.window, resampler.window + keepStart,
+               (resampler.windowCount - keepStart) * sizeof(float));
+  resampler.windowCount -= keepStart;
+}
+
+} // namespace dsp::resampler
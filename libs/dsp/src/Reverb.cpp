@@ -0,0 +1,153 @@
+#include "dsp/Reverb.h"
+#include "dsp/Delay.h"
+#include "dsp/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace dsp::reverb {
+
+// ==== FDN Helpers ====
+namespace {
+constexpr size_t N = REVERB_LINES;
+
+// Mutually prime line lengths at 48 kHz (25 - 58 ms)
+constexpr float BASE_SAMPLE_RATE = 48000.0f;
+constexpr size_t BASE_LENGTHS[N] = {1201, 1433, 1637, 1873,
+                                    2053, 2311, 2503, 2777};
+
+// Alternating signs decorrelate the input/output taps
+constexpr float TAP_SIGNS[N] = {1.0f, -1.0f, 1.0f, -1.0f,
+                                1.0f, -1.0f, 1.0f, -1.0f};
+
+// Right output taps: orthogonal to TAP_SIGNS (another Hadamard row)
+constexpr float RIGHT_TAP_SIGNS[N] = {1.0f, 1.0f, -1.0f, -1.0f,
+                                      1.0f, 1.0f, -1.0f, -1.0f};
+
+constexpr float INPUT_GAIN = 0.25f;
+constexpr float OUTPUT_GAIN = 0.35f; // ~1 / sqrt(N)
+constexpr float HOUSEHOLDER_GAIN = 2.0f / static_cast<float>(N);
+
+size_t lineLength(size_t line, float size, float sampleRate) {
+  float length = static_cast<float>(BASE_LENGTHS[line]) * size * sampleRate /
+                 BASE_SAMPLE_RATE;
+  return std::max<size_t>(static_cast<size_t>(length), 1);
+}
+
+// Stereo: (L + R) / 2 in, L taps with TAP_SIGNS, R taps with RIGHT_TAP_SIGNS
+template <bool IsStereo>
+void processFDN(ReverbState &state, const float *inputLeft,
+                const float *inputRight, float *wetLeft, float *wetRight,
+                size_t numSamples) {
+  namespace simd = dsp::simd;
+  static_assert(N == 2 * simd::WIDTH, "FDN lines run as two SIMD vectors");
+
+  const simd::f32x4 damping = simd::set1(state.damping);
+  const simd::f32x4 gainsLo = simd::load(state.gains);
+  const simd::f32x4 gainsHi = simd::load(state.gains + simd::WIDTH);
+
+  // Damping states stay in registers for the whole block
+  simd::f32x4 lowpassLo = simd::load(state.lowpass);
+  simd::f32x4 lowpassHi = simd::load(state.lowpass + simd::WIDTH);
+
+  alignas(16) float taps[N];
+  alignas(16) float decayed[N];
+
+  for (size_t s = 0; s < numSamples; s++) {
+    float in = inputLeft[s] * INPUT_GAIN;
+    if constexpr (IsStereo)
+      in = (inputLeft[s] + inputRight[s]) * (0.5f * INPUT_GAIN);
+
+    for (size_t i = 0; i < N; i++)
+      taps[i] = delay::readDelay(state.lines[i], state.lengths[i]);
+
+    // lowpass += (1 - damping) * (tap - lowpass), then decay
+    simd::f32x4 tapsLo = simd::load(taps);
+    simd::f32x4 tapsHi = simd::load(taps + simd::WIDTH);
+    lowpassLo =
+        simd::add(tapsLo, simd::mul(damping, simd::sub(lowpassLo, tapsLo)));
+    lowpassHi =
+        simd::add(tapsHi, simd::mul(damping, simd::sub(lowpassHi, tapsHi)));
+    simd::store(decayed, simd::mul(lowpassLo, gainsLo));
+    simd::store(decayed + simd::WIDTH, simd::mul(lowpassHi, gainsHi));
+
+    float sum = 0.0f;
+    float out = 0.0f;
+    float outRight = 0.0f;
+    for (size_t i = 0; i < N; i++) {
+      sum += decayed[i];
+      out += taps[i] * TAP_SIGNS[i];
+      if constexpr (IsStereo)
+        outRight += taps[i] * RIGHT_TAP_SIGNS[i];
+    }
+
+    // Householder feedback + input
+    float reflection = sum * HOUSEHOLDER_GAIN;
+    for (size_t i = 0; i < N; i++)
+      delay::writeDelay(state.lines[i],
+                        decayed[i] - reflection + in * TAP_SIGNS[i]);
+
+    wetLeft[s] = out * OUTPUT_GAIN;
+    if constexpr (IsStereo)
+      wetRight[s] = outRight * OUTPUT_GAIN;
+  }
+
+  simd::store(state.lowpass, lowpassLo);
+  simd::store(state.lowpass + simd::WIDTH, lowpassHi);
+}
+} // namespace
+
+ReverbState createReverb(float sampleRate) {
+  ReverbState state{};
+
+  for (size_t i = 0; i < N; i++)
+    state.lines[i] = delay::createDelayLine(
+        lineLength(i, REVERB_SIZE_MAX, sampleRate));
+
+  updateReverb(state, REVERB_SIZE_MAX, 2.0f, 0.0f, sampleRate);
+  return state;
+}
+
+void disposeReverb(ReverbState &state) {
+  for (delay::DelayLine &line : state.lines)
+    delay::disposeDelayLine(line);
+}
+
+void clearReverb(ReverbState &state) {
+  for (size_t i = 0; i < N; i++) {
+    delay::clearDelayLine(state.lines[i]);
+    state.lowpass[i] = 0.0f;
+  }
+}
+
+void updateReverb(ReverbState &state, float size, float decaySeconds,
+                  float damping, float sampleRate) {
+  size = std::clamp(size, REVERB_SIZE_MIN, REVERB_SIZE_MAX);
+  decaySeconds = std::max(decaySeconds, 0.01f);
+
+  for (size_t i = 0; i < N; i++) {
+    size_t length = std::min(lineLength(i, size, sampleRate),
+                             delay::maxDelaySamples(state.lines[i]));
+    state.lengths[i] = length;
+
+    // -60 dB after decaySeconds: g = 10^(-3 * length / (RT60 * sr))
+    float passes = decaySeconds * sampleRate / static_cast<float>(length);
+    state.gains[i] = std::pow(10.0f, -3.0f / passes);
+  }
+
+  state.damping = std::clamp(damping, 0.0f, 0.99f);
+}
+
+void processReverbBlock(ReverbState &state, const float *input, float *wet,
+                        size_t numSamples) {
+  processFDN<false>(state, input, input, wet, nullptr, numSamples);
+}
+
+void processReverbBlockStereo(ReverbState &state, const float *inputLeft,
+                              const float *inputRight, float *wetLeft,
+                              float *wetRight, size_t numSamples) {
+  processFDN<true>(state, inputLeft, inputRight, wetLeft, wetRight,
+                   numSamples);
+}
+} // namespace dsp::reverb
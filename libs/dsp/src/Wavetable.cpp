@@ -0,0 +1,307 @@
+#include "dsp/Wavetable.h"
+#include "dsp/Fft.h"
+#include "dsp/Math.h"
+#include "dsp/Waveforms.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp::wavetable {
+using WaveformType = waveforms::WaveformType;
+
+// ==========================
+// Mip Level Helpers
+// ==========================
+uint32_t maxHarmonicsForLevel(uint32_t level) {
+  return level < MIP_LEVELS ? MAX_HARMONICS >> level : 1;
+}
+
+uint32_t selectMipLevel(float phaseIncrement) {
+  /* Level L is alias free while (MAX_HARMONICS >> L) * inc <= 0.5
+   *   -> L = ceil(log2(2 * MAX_HARMONICS * inc))
+   */
+  float ratio = phaseIncrement * static_cast<float>(2 * MAX_HARMONICS);
+  if (!(ratio > 1.0f))
+    return 0;
+
+  // ratio = mantissa * 2^exponent, mantissa in [0.5, 1)
+  int exponent = 0;
+  float mantissa = std::frexp(ratio, &exponent);
+  int level = mantissa > 0.5f ? exponent : exponent - 1;
+
+  if (level >= static_cast<int>(MIP_LEVELS))
+    return MIP_LEVELS - 1;
+
+  return static_cast<uint32_t>(level);
+}
+
+// ==========================
+// Table Generation
+// ==========================
+void buildFromHarmonics(Wavetable &table, const float *sinAmps,
+                        const float *cosAmps, uint32_t numHarmonics) {
+  // One cycle of sine for exact integer-indexed harmonic lookups:
+  // sin(2π * k * n / N) == sineCycle[(k * n) & TABLE_MASK]
+  static float sineCycle[TABLE_SIZE];
+  for (uint32_t n = 0; n < TABLE_SIZE; n++)
+    sineCycle[n] = static_cast<float>(
+        std::sin(2.0 * math::PI_DOUBLE * n / static_cast<double>(TABLE_SIZE)));
+
+  constexpr uint32_t QUARTER_CYCLE = TABLE_SIZE / 4; // cos(x) == sin(x + π/2)
+
+  for (uint32_t level = 0; level < MIP_LEVELS; level++) {
+    uint32_t harmonics = maxHarmonicsForLevel(level);
+    if (harmonics > numHarmonics)
+      harmonics = numHarmonics;
+
+    float *mip = table.mips[level];
+
+    for (uint32_t n = 0; n < TABLE_SIZE; n++) {
+      double sample = 0.0;
+
+      for (uint32_t h = 0; h < harmonics; h++) {
+        uint32_t k = h + 1;
+
+        if (sinAmps)
+          sample += sinAmps[h] * sineCycle[(k * n) & TABLE_MASK];
+        if (cosAmps)
+          sample += cosAmps[h] * sineCycle[(k * n + QUARTER_CYCLE) & TABLE_MASK];
+      }
+
+      mip[n] = static_cast<float>(sample);
+    }
+
+    mip[TABLE_SIZE] = mip[0]; // guard sample
+  }
+}
+
+void buildFromCycle(Wavetable &table, const float *cycle, uint32_t length) {
+  // Spectrum of the cycle (transformed at its own length when possible)
+  float re[MAX_CYCLE_LENGTH];
+  float im[MAX_CYCLE_LENGTH];
+
+  uint32_t size = length;
+  if (fft::isPowerOfTwo(length) && length <= MAX_CYCLE_LENGTH) {
+    for (uint32_t n = 0; n < length; n++)
+      re[n] = cycle[n];
+  } else {
+    size = TABLE_SIZE;
+    for (uint32_t n = 0; n < TABLE_SIZE; n++) {
+      double position = static_cast<double>(n) * length / TABLE_SIZE;
+      auto index = static_cast<uint32_t>(position);
+      auto frac = static_cast<float>(position - index);
+      float a = cycle[index];
+      float b = cycle[index + 1 < length ? index + 1 : 0];
+      re[n] = a + frac * (b - a);
+    }
+  }
+
+  for (uint32_t n = 0; n < size; n++)
+    im[n] = 0.0f;
+  fft::forwardFft(re, im, size);
+
+  // Harmonic h sits at bin h for any transform size: rescale to TABLE_SIZE
+  // and drop Nyquist (it has no phase to keep)
+  uint32_t numHarmonics = size / 2 - 1;
+  if (numHarmonics > MAX_HARMONICS)
+    numHarmonics = MAX_HARMONICS;
+
+  float scale = static_cast<float>(TABLE_SIZE) / static_cast<float>(size);
+
+  float levelRe[TABLE_SIZE];
+  float levelIm[TABLE_SIZE];
+
+  for (uint32_t level = 0; level < MIP_LEVELS; level++) {
+    uint32_t harmonics = maxHarmonicsForLevel(level);
+    if (harmonics > numHarmonics)
+      harmonics = numHarmonics;
+
+    for (uint32_t k = 0; k < TABLE_SIZE; k++) {
+      levelRe[k] = 0.0f;
+      levelIm[k] = 0.0f;
+    }
+
+    // Conjugate symmetric, bin 0 (DC) stays empty
+    for (uint32_t k = 1; k <= harmonics; k++) {
+      levelRe[k] = re[k] * scale;
+      levelIm[k] = im[k] * scale;
+      levelRe[TABLE_SIZE - k] = levelRe[k];
+      levelIm[TABLE_SIZE - k] = -levelIm[k];
+    }
+
+    fft::inverseFft(levelRe, levelIm, TABLE_SIZE);
+
+    float *mip = table.mips[level];
+    for (uint32_t n = 0; n < TABLE_SIZE; n++)
+      mip[n] = levelRe[n];
+    mip[TABLE_SIZE] = mip[0]; // guard sample
+  }
+}
+
+// ==== Built-in Tables ====
+namespace {
+constexpr size_t BUILTIN_COUNT =
+    static_cast<size_t>(WaveformType::Triangle) + 1;
+
+Wavetable builtinTables[BUILTIN_COUNT];
+} // namespace
+
+void initBuiltinWavetables() {
+  static bool isInitialized = false;
+  if (isInitialized)
+    return;
+
+  static float sinAmps[MAX_HARMONICS];
+  static float cosAmps[MAX_HARMONICS];
+
+  const float invPi = 1.0f / math::PI_F;
+
+  // Sine: fundamental only
+  for (uint32_t h = 0; h < MAX_HARMONICS; h++)
+    sinAmps[h] = h == 0 ? 1.0f : 0.0f;
+  buildFromHarmonics(builtinTables[static_cast<size_t>(WaveformType::Sine)],
+                     sinAmps, nullptr, MAX_HARMONICS);
+
+  // Saw (rising ramp -1 → 1): -(2/π) Σ sin(kx) / k
+  for (uint32_t h = 0; h < MAX_HARMONICS; h++)
+    sinAmps[h] = -2.0f * invPi / static_cast<float>(h + 1);
+  buildFromHarmonics(builtinTables[static_cast<size_t>(WaveformType::Saw)],
+                     sinAmps, nullptr, MAX_HARMONICS);
+
+  // Square (50% pulse, +1 first half): (4/π) Σ odd sin(kx) / k
+  for (uint32_t h = 0; h < MAX_HARMONICS; h++) {
+    uint32_t k = h + 1;
+    sinAmps[h] = (k & 1) ? 4.0f * invPi / static_cast<float>(k) : 0.0f;
+  }
+  buildFromHarmonics(builtinTables[static_cast<size_t>(WaveformType::Square)],
+                     sinAmps, nullptr, MAX_HARMONICS);
+
+  // Triangle (-1 at phase 0, +1 at 0.5): -(8/π²) Σ odd cos(kx) / k²
+  for (uint32_t h = 0; h < MAX_HARMONICS; h++) {
+    uint32_t k = h + 1;
+    float k2 = static_cast<float>(k * k);
+    cosAmps[h] = (k & 1) ? -8.0f * invPi * invPi / k2 : 0.0f;
+  }
+  buildFromHarmonics(
+      builtinTables[static_cast<size_t>(WaveformType::Triangle)], nullptr,
+      cosAmps, MAX_HARMONICS);
+
+  isInitialized = true;
+}
+
+const Wavetable &getBuiltinWavetable(WaveformType type) {
+  size_t index = static_cast<size_t>(type);
+  if (index >= BUILTIN_COUNT)
+    index = static_cast<size_t>(WaveformType::Sine);
+
+  return builtinTables[index];
+}
+
+// ==========================
+// Processing
+// ==========================
+float readMipLevel(const Wavetable &table, uint32_t level, float phase) {
+  const float *mip = table.mips[level];
+
+  float position = phase * static_cast<float>(TABLE_SIZE);
+  uint32_t index = static_cast<uint32_t>(position);
+  float frac = position - static_cast<float>(index);
+
+  index &= TABLE_MASK;
+  return mip[index] + frac * (mip[index + 1] - mip[index]);
+}
+
+float processWavetable(const Wavetable &table, float phase,
+                       float phaseIncrement) {
+  return readMipLevel(table, selectMipLevel(phaseIncrement), phase);
+}
+
+void processWavetableBlock(const Wavetable &table, const float *phases,
+                           const float *phaseIncrements, float *output,
+                           size_t numSamples) {
+  // Highest increment decides the level (no aliasing anywhere in the block)
+  float maxIncrement = 0.0f;
+  for (size_t i = 0; i < numSamples; i++)
+    maxIncrement =
+        phaseIncrements[i] > maxIncrement ? phaseIncrements[i] : maxIncrement;
+
+  uint32_t level = selectMipLevel(maxIncrement);
+
+  for (size_t i = 0; i < numSamples; i++)
+    output[i] = readMipLevel(table, level, phases[i]);
+}
+
+// ==== Frame Scanning ====
+namespace {
+constexpr size_t FRAME_STRIDE = sizeof(Wavetable) / sizeof(float);
+
+// Frame pair + crossfade for one position (frameCount >= 2)
+struct FramePair {
+  size_t offset = 0; // lower frame, in floats from frames[0]
+  float mix = 0.0f;  // 0 = lower frame, 1 = upper frame
+};
+
+FramePair locateFrames(float position, float lastFrame, uint32_t maxFrame) {
+  float scaled = std::min(std::max(position, 0.0f), 1.0f) * lastFrame;
+
+  // Position 1.0 stays on the pair below the last frame (mix = 1)
+  uint32_t frame = std::min(static_cast<uint32_t>(scaled), maxFrame);
+  return {frame * FRAME_STRIDE, scaled - static_cast<float>(frame)};
+}
+
+float readFramePair(const float *mip, FramePair pair, float phase) {
+  float position = phase * static_cast<float>(TABLE_SIZE);
+  uint32_t index = static_cast<uint32_t>(position);
+  float frac = position - static_cast<float>(index);
+  index &= TABLE_MASK;
+
+  const float *a = mip + pair.offset;
+  const float *b = a + FRAME_STRIDE;
+  float sampleA = a[index] + frac * (a[index + 1] - a[index]);
+  float sampleB = b[index] + frac * (b[index + 1] - b[index]);
+  return sampleA + pair.mix * (sampleB - sampleA);
+}
+} // namespace
+
+float processWavetableFrames(const WavetableFrames &table, float phase,
+                             float phaseIncrement, float position) {
+  if (table.frameCount < 2)
+    return processWavetable(table.frames[0], phase, phaseIncrement);
+
+  const float *mip = table.frames[0].mips[selectMipLevel(phaseIncrement)];
+  FramePair pair = locateFrames(position,
+                                static_cast<float>(table.frameCount - 1),
+                                table.frameCount - 2);
+  return readFramePair(mip, pair, phase);
+}
+
+void processWavetableFramesBlock(const WavetableFrames &table,
+                                 const float *phases,
+                                 const float *phaseIncrements,
+                                 const float *positions, float *output,
+                                 size_t numSamples) {
+  if (table.frameCount < 2) {
+    processWavetableBlock(table.frames[0], phases, phaseIncrements, output,
+                          numSamples);
+    return;
+  }
+
+  float maxIncrement = 0.0f;
+  for (size_t i = 0; i < numSamples; i++)
+    maxIncrement =
+        phaseIncrements[i] > maxIncrement ? phaseIncrements[i] : maxIncrement;
+
+  // Mip _level_ of frame f sits at mip + f * FRAME_STRIDE
+  const float *mip = table.frames[0].mips[selectMipLevel(maxIncrement)];
+  const auto lastFrame = static_cast<float>(table.frameCount - 1);
+  const uint32_t maxFrame = table.frameCount - 2;
+
+  for (size_t i = 0; i < numSamples; i++) {
+    FramePair pair = locateFrames(positions[i], lastFrame, maxFrame);
+    output[i] = readFramePair(mip, pair, phases[i]);
+  }
+}
+
+} // namespace dsp::wavetable
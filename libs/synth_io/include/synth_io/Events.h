@@ -5,15 +5,52 @@
 namespace synth_io {
 enum class NoteEventType { NoteOff, NoteOn };
 
+/* ==== Event timing ====
+ * timestamp:   producer time (steady_clock ns), 0 = "as soon as possible"
+ * frameOffset: frame inside the audio buffer the event applies at. Set by
+ *              synth_io from the timestamp right before the buffer renders
+ */
 struct NoteEvent {
   NoteEventType type = NoteEventType::NoteOff;
   uint8_t midiNote = 0;
   uint8_t velocity = 0;
+
+  uint32_t frameOffset = 0;
+  uint64_t timestamp = 0;
+
+  // MIDI channel (0-15). MPE: each note gets its own channel, which carries
+  // that note's expression (CONTROLLER_NOTE_*)
+  uint8_t channel = 0;
 };
 
 struct ParamEvent {
   uint8_t id = 0;
   float value = 0.0f; // Normalized [0, 1]
+
+  uint32_t frameOffset = 0;
+  uint64_t timestamp = 0;
+};
+
+/* ==== Continuous controllers ====
+ * MIDI CCs, pitch bend and pressure, one id per controller (per note for
+ * poly pressure). Always coalesced (see setController): no frameOffset,
+ * the latest value applies at the start of the buffer
+ * - CONTROLLER_CC/PITCH_BEND/CHANNEL_PRESSURE: whatever channel sent them
+ * - CONTROLLER_NOTE_*: per channel expression lanes (MPE), heard by the
+ *   voices whose note came in on that channel
+ */
+inline constexpr uint16_t CONTROLLER_CC = 0; // + CC number (0-127)
+inline constexpr uint16_t CONTROLLER_PITCH_BEND = 128;
+inline constexpr uint16_t CONTROLLER_CHANNEL_PRESSURE = 129;
+inline constexpr uint16_t CONTROLLER_POLY_PRESSURE = 256; // + MIDI note
+inline constexpr uint16_t CONTROLLER_NOTE_BEND = 384;     // + channel
+inline constexpr uint16_t CONTROLLER_NOTE_PRESSURE = 400; // + channel
+inline constexpr uint16_t CONTROLLER_NOTE_SLIDE = 416;    // + channel (CC 74)
+inline constexpr uint16_t CONTROLLER_COUNT = 448; // multiple of 64
+
+struct ControllerEvent {
+  uint16_t id = 0;
+  float value = 0.0f; // [0, 1], pitch bend [-1, 1]
 };
 
 } // namespace synth_io
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+/* Real-time safety audit (debug builds: make debug RT_AUDIT=1)
+ * - threads inside an RtSection (audio callback, voice worker renders) must
+ *   not allocate, lock or block
+ * - with SYNTH_RT_AUDIT the hooks in RtAuditHooks.cpp (malloc family,
+ *   operator new/delete, pthread mutex/cond, sleeps, file IO) record every
+ *   hit inside a section: type + backtrace, into a fixed lock-free buffer
+ *   (the first MAX_RT_VIOLATIONS are kept, later ones only counted)
+ * - a section also turns on flush-to-zero / denormals-are-zero, so denormal
+ *   slowdowns (decaying filter states) show up the same on every run
+ *
+ * Without SYNTH_RT_AUDIT every call here is an inline no-op.
+ * NOTE: read with printRtViolations from a non-real-time thread
+ */
+namespace synth_io::rt_audit {
+inline constexpr uint32_t MAX_RT_VIOLATIONS = 256;
+inline constexpr uint32_t MAX_RT_BACKTRACE = 24;
+
+enum class RtViolationType : uint8_t {
+  Allocation,   // malloc/calloc/realloc/operator new
+  Deallocation, // free/operator delete
+  Lock,         // pthread mutex lock, cond wait
+  BlockingCall, // sleeps, file IO
+  NonRealtime,  // function marked with markNonRealtime (e.g. debug prints)
+  TYPE_COUNT
+};
+
+struct RtViolation {
+  RtViolationType type = RtViolationType::Allocation;
+  const char *what = nullptr; // hooked function name (static string)
+  uint32_t depth = 0;
+  void *backtrace[MAX_RT_BACKTRACE] = {};
+};
+
+struct RtAuditStats {
+  uint32_t violationCount = 0; // recorded + dropped
+  uint32_t droppedCount = 0;   // past MAX_RT_VIOLATIONS (counted only)
+};
+
+#if SYNTH_RT_AUDIT
+namespace detail {
+struct FloatEnv {
+  uint64_t bits = 0;
+};
+
+// Returns true for the outermost section (the one that owns _saved_)
+bool enterRtSection(FloatEnv &saved);
+void exitRtSection(const FloatEnv &saved, bool isOuter);
+} // namespace detail
+
+// Record _what_ as a violation when called inside an RtSection
+void markNonRealtime(const char *what);
+
+// True while the calling thread is inside an RtSection
+bool isInRtSection();
+
+// Loads the backtrace unwinder and hook targets up front (it allocates on
+// first use); called by initSession
+void initRtAudit();
+
+RtAuditStats getRtAuditStats();
+
+// Prints and clears the recorded violations (symbolized backtraces)
+void printRtViolations(FILE *stream = stderr);
+#else
+inline void markNonRealtime(const char *) {}
+inline bool isInRtSection() { return false; }
+inline void initRtAudit() {}
+inline RtAuditStats getRtAuditStats() { return {}; }
+inline void printRtViolations(FILE * = stderr) {}
+#endif
+
+/* RAII: the calling thread is real-time until the end of the scope
+ * - nests (inner sections keep the outer float environment)
+ */
+struct ScopedRtSection {
+#if SYNTH_RT_AUDIT
+  detail::FloatEnv saved{};
+  bool isOuter = detail::enterRtSection(saved);
+
+  ScopedRtSection() = default;
+  ~ScopedRtSection() { detail::exitRtSection(saved, isOuter); }
+#else
+  ScopedRtSection() {} // user provided: no unused variable warning
+#endif
+
+  ScopedRtSection(const ScopedRtSection &) = delete;
+  ScopedRtSection &operator=(const ScopedRtSection &) = delete;
+};
+
+} // namespace synth_io::rt_audit
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace synth_io {
+
+/* ==== Shared Audio Ring (memory layout) ====
+ * What publishSharedAudio maps at /<name> (POSIX shared memory): this
+ * header, then capacityFrames interleaved float frames. Header only, so
+ * recorder/streamer processes include it without linking synth_io:
+ *
+ *   int fd = shm_open("/meh-synth", O_RDONLY, 0);
+ *   fstat(fd, &info);
+ *   auto *ring = static_cast<const SharedAudioHeader *>(
+ *       mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0));
+ *   uint64_t readFrame = ring->writeFrame.load();
+ *   while (ring->isLive.load())
+ *     readSharedAudio(*ring, readFrame, block, blockFrames);
+ *
+ * - one writer (the audio callback), any number of readers, no locks and no
+ *   syscalls on either side once mapped
+ * - the writer never waits: a reader more than capacityFrames behind loses
+ *   the oldest frames (readSharedAudio skips them and counts them)
+ * - frame counters are monotonic stream frames (the writer's output clock,
+ *   from the first published buffer)
+ */
+inline constexpr uint32_t SHARED_AUDIO_MAGIC = 0x4D454841; // "MEHA"
+inline constexpr uint32_t SHARED_AUDIO_VERSION = 1;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "Shared ring counters must be address free");
+
+struct alignas(64) SharedAudioHeader {
+  uint32_t magic = SHARED_AUDIO_MAGIC;
+  uint32_t version = SHARED_AUDIO_VERSION;
+  uint32_t sampleRate = 0;
+  uint32_t numChannels = 0;
+  uint32_t capacityFrames = 0;
+
+  // Cleared when the writer unpublishes (the name is gone, the mapping
+  // stays valid until the reader unmaps it)
+  std::atomic<uint32_t> isLive{0};
+
+  // Frames published so far (release: every frame below it is written)
+  std::atomic<uint64_t> writeFrame{0};
+
+  // Frames the writer is about to publish: ring slots of frames below
+  // reserveFrame - capacityFrames may be mid-overwrite
+  std::atomic<uint64_t> reserveFrame{0};
+};
+
+inline const float *getSharedAudioSamples(const SharedAudioHeader &header) {
+  return reinterpret_cast<const float *>(&header + 1);
+}
+
+inline size_t getSharedAudioBytes(uint32_t capacityFrames,
+                                  uint32_t numChannels) {
+  return sizeof(SharedAudioHeader) +
+         size_t{capacityFrames} * numChannels * sizeof(float);
+}
+
+/* Copies up to _maxFrames_ interleaved frames from _readFrame_ on (the
+ * reader's own cursor, advanced past what was read or lost)
+ * - frames overwritten before/while copying are skipped and added to
+ *   _droppedFrames_ (when given)
+ * Returns the frames copied to _interleaved_
+ */
+inline uint32_t readSharedAudio(const SharedAudioHeader &header,
+                                uint64_t &readFrame, float *interleaved,
+                                uint32_t maxFrames,
+                                uint64_t *droppedFrames = nullptr) {
+  const uint32_t capacity = header.capacityFrames;
+  const uint32_t numChannels = header.numChannels;
+  const float *samples = getSharedAudioSamples(header);
+  uint64_t lost = 0;
+
+  uint64_t writeFrame = header.writeFrame.load(std::memory_order_acquire);
+  if (writeFrame - readFrame > capacity) {
+    lost += writeFrame - capacity - readFrame;
+    readFrame = writeFrame - capacity;
+  }
+
+  uint64_t available = writeFrame - readFrame;
+  auto numFrames =
+      static_cast<uint32_t>(available < maxFrames ? available : maxFrames);
+
+  auto first = static_cast<uint32_t>(readFrame % capacity);
+  uint32_t headFrames = capacity - first;
+  if (headFrames > numFrames)
+    headFrames = numFrames;
+
+  std::memcpy(interleaved, samples + size_t{first} * numChannels,
+              size_t{headFrames} * numChannels * sizeof(float));
+  std::memcpy(interleaved + size_t{headFrames} * numChannels, samples,
+              size_t{numFrames - headFrames} * numChannels * sizeof(float));
+
+  // Seqlock check: anything the writer started overwriting during the
+  // copy is dropped from the front
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t reserveFrame = header.reserveFrame.load(std::memory_order_relaxed);
+  uint64_t validFrame = reserveFrame > capacity ? reserveFrame - capacity : 0;
+  if (validFrame > readFrame) {
+    uint64_t overwritten = validFrame - readFrame;
+    auto skipped = static_cast<uint32_t>(
+        overwritten < numFrames ? overwritten : numFrames);
+
+    std::memmove(interleaved, interleaved + size_t{skipped} * numChannels,
+                 size_t{numFrames - skipped} * numChannels * sizeof(float));
+    lost += skipped;
+    readFrame += skipped;
+    numFrames -= skipped;
+  }
+
+  readFrame += numFrames;
+  if (droppedFrames)
+    *droppedFrames += lost;
+  return numFrames;
+}
+
+} // namespace synth_io
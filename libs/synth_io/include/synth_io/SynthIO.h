@@ -9,6 +9,9 @@ namespace synth_io {
 struct SynthSession;
 using hSynthSession = SynthSession *;
 
+struct OutputTap;
+using hOutputTap = OutputTap *;
+
 // --- Constants ---
 inline constexpr uint32_t DEFAULT_SAMPLE_RATE = 48000;
 inline constexpr uint32_t DEFAULT_FRAMES = 512;
@@ -19,11 +22,67 @@ enum class BufferFormat {
   Interleaved,    // channels interwoven in single array [LRLRLRLR]
 };
 
+// No audio device: a background thread calls back on a deterministic clock
+// (CI, throughput runs), see audio_io::NullOptions
+struct NullOutputConfig {
+  bool isEnabled = false;
+  bool isPaced = true;       // real time, false: as fast as possible
+  uint64_t lengthFrames = 0; // stop after this many (0: until stopSession)
+  const char *outputPath = nullptr; // raw interleaved float32 (optional)
+};
+
 struct SessionConfig {
   uint32_t sampleRate = DEFAULT_SAMPLE_RATE;
   uint32_t numFrames = DEFAULT_FRAMES;
   uint16_t numChannels = DEFAULT_CHANNELS;
   BufferFormat bufferFormat = BufferFormat::NonInterleaved;
+
+  /* true:  events are placed at their exact frame, one buffer late
+   *        (fixed latency, no jitter)
+   * false: events apply at the start of the next buffer (lowest latency,
+   *        up to one buffer of jitter)
+   */
+  bool isSampleAccurate = true;
+
+  /* true:  setParam writes a per-param slot; each changed param is applied
+   *        once per buffer (last value wins, never drops, start of buffer)
+   * false: setParam pushes onto the event queue (every value, placed per
+   *        isSampleAccurate, drops when the 256-slot queue is full)
+   */
+  bool isParamCoalesced = false;
+
+  // Output device (audio_io::listOutputDevices ids, 0: system default)
+  // numFrames is negotiated with it, see getOutputLatency for the result
+  uint32_t deviceId = 0;
+
+  // Replaces the device when enabled (deviceId is ignored)
+  NullOutputConfig nullOutput{};
+
+  // Key-to-sound latency measurement, see getLatencyStats (scans channel 0
+  // of every rendered buffer while notes are pending)
+  bool isLatencyProbeEnabled = false;
+};
+
+// Output path latency, frames at the device rate (see audio_io::DeviceLatency)
+struct OutputLatency {
+  double sampleRate = 0.0;
+  uint32_t bufferFrames = 0; // negotiated device buffer
+  uint32_t deviceFrames = 0; // driver + hardware + stream
+  uint32_t safetyOffsetFrames = 0;
+  double totalSeconds = 0.0;
+};
+
+// Null output callback timing (zeroed for devices), see
+// audio_io::CallbackStats
+struct CallbackStats {
+  uint64_t callbackCount = 0;
+  uint64_t framesRendered = 0;
+  double streamSeconds = 0.0; // framesRendered / sampleRate
+  double wallSeconds = 0.0;   // real time since start
+  double averageCallbackUs = 0.0;
+  double maxCallbackUs = 0.0;
+  uint32_t lateCount = 0;  // paced: missed the buffer deadline
+  bool isFinished = false; // lengthFrames reached
 };
 
 typedef void (*NoteEventHandler)(NoteEvent noteEvent, void *userContext);
@@ -32,10 +91,102 @@ typedef void (*AudioBufferHandler)(float **outputBuffer, size_t numChannels,
 
 typedef void (*ParamEventHandler)(ParamEvent paramEvent, void *userContext);
 
+typedef void (*ControllerEventHandler)(ControllerEvent controllerEvent,
+                                       void *userContext);
+
+// Audio callback timing (load 1.0 == the whole buffer deadline was used)
+struct DspLoadStats {
+  float lastLoad = 0.0f;
+  float averageLoad = 0.0f; // rolling average
+  float peakLoad = 0.0f;    // since start/last reset
+  uint32_t overrunCount = 0; // callbacks that missed the deadline
+  uint64_t callbackCount = 0;
+};
+
+// Input timestamp -> first audible output sample (> -60 dBFS) reaching the
+// device, ms. Percentiles are 0.1 ms histogram bins (centers)
+struct LatencyStats {
+  uint32_t count = 0;        // notes measured
+  uint32_t maskedCount = 0;  // output already audible where the note began
+  uint32_t timeoutCount = 0; // silent 0.5 s later (or too many pending)
+  double minMs = 0.0;
+  double meanMs = 0.0;
+  double p50Ms = 0.0;
+  double p90Ms = 0.0;
+  double p99Ms = 0.0;
+  double maxMs = 0.0;
+  double meanQueueMs = 0.0; // input -> the callback that picked it up
+};
+
+// Output tap fill/loss, frames (see attachOutputTap)
+struct OutputTapStats {
+  uint32_t numChannels = 0;
+  uint32_t capacityFrames = 0;
+  uint32_t availableFrames = 0; // ready to read
+  uint64_t framesWritten = 0;
+  uint64_t droppedFrames = 0; // reader fell behind (whole buffers)
+};
+
+inline constexpr uint32_t MAX_OUTPUT_TAPS = 8;
+
+// One event queue's fill/loss (see getEventTelemetry)
+struct QueueTelemetry {
+  uint32_t capacity = 0;
+  uint32_t highWater = 0;    // most events waiting at one callback
+  uint64_t droppedCount = 0; // pushes that found it full (event lost)
+};
+
+// Event path counters since start/last reset
+struct EventTelemetry {
+  QueueTelemetry noteQueue{};
+  QueueTelemetry paramQueue{};
+  QueueTelemetry batchQueue{}; // whole batches (see sendEventBatch)
+  uint64_t callbackCount = 0;
+  uint64_t eventCount = 0; // note + param + controller events delivered
+  uint32_t lastCallbackEvents = 0;
+  uint32_t peakCallbackEvents = 0;
+};
+
+// Sized for a whole-patch scene change (every param) plus a chord
+inline constexpr uint32_t MAX_BATCH_PARAMS = 128;
+inline constexpr uint32_t MAX_BATCH_NOTES = 64;
+
+/* Params + notes published together (see sendEventBatch)
+ * - event frameOffset/timestamp fields are ignored, the batch has one
+ *   timestamp (set by sendEventBatch)
+ */
+struct EventBatch {
+  ParamEvent params[MAX_BATCH_PARAMS];
+  NoteEvent notes[MAX_BATCH_NOTES];
+  uint32_t paramCount = 0;
+  uint32_t noteCount = 0;
+  uint64_t timestamp = 0;
+};
+
+/* Event timeline: events placed ahead of time on the stream clock (frames
+ * the session has rendered, see getStreamFrame), one slot per
+ * TIMELINE_BLOCK_FRAMES block. The ring holds TIMELINE_BLOCKS blocks, so
+ * producers can't run further ahead than that (~170 ms at 48 kHz)
+ */
+inline constexpr uint32_t TIMELINE_BLOCK_FRAMES = 64;
+inline constexpr uint32_t TIMELINE_BLOCKS = 128;
+inline constexpr uint32_t MAX_TIMELINE_BLOCK_EVENTS = 32;
+
+enum class TimelineEventType : uint8_t { Note, Param };
+
+// frame: stream frame it applies at (frameOffset/timestamp are ignored)
+struct TimelineEvent {
+  uint64_t frame = 0;
+  TimelineEventType type = TimelineEventType::Note;
+  NoteEvent note{};
+  ParamEvent param{};
+};
+
 struct SynthCallbacks {
   ParamEventHandler processParamEvent = nullptr;
   NoteEventHandler processNoteEvent = nullptr;
   AudioBufferHandler processAudioBlock = nullptr;
+  ControllerEventHandler processControllerEvent = nullptr;
 };
 
 // ==== Session Handlers ====
@@ -47,11 +198,134 @@ int startSession(hSynthSession sessionPtr);
 int stopSession(hSynthSession sessionPtr);
 int disposeSession(hSynthSession sessionPtr);
 
+// Producer side timestamp for events (steady_clock, ns)
+// noteOn/noteOff/setParam stamp events with this automatically
+uint64_t getEventTimestamp();
+
+// Latency of the session's output device (after initSession)
+OutputLatency getOutputLatency(hSynthSession sessionPtr);
+
+// Null output progress/timing, any thread (see NullOutputConfig)
+CallbackStats getCallbackStats(hSynthSession sessionPtr);
+
+// ==== Audio Workgroup ====
+/* Helper render threads (voice workers) join the output device's audio
+ * workgroup so they're scheduled against the IO deadline
+ * - call from the helper thread itself, after initSession
+ * - returns an opaque membership for leaveAudioWorkgroup (nullptr where
+ *   unsupported)
+ */
+void *joinAudioWorkgroup(hSynthSession sessionPtr);
+
+// Same thread that joined. nullptr is a no-op
+void leaveAudioWorkgroup(void *membership);
+
 // ==== Note Event Handlers ====
-bool noteOn(hSynthSession sessionPtr, uint8_t midiNote, uint8_t velocity);
-bool noteOff(hSynthSession sessionPtr, uint8_t midiNote, uint8_t velocity);
+bool noteOn(hSynthSession sessionPtr, uint8_t midiNote, uint8_t velocity,
+            uint8_t channel = 0);
+bool noteOff(hSynthSession sessionPtr, uint8_t midiNote, uint8_t velocity,
+             uint8_t channel = 0);
 
 // ==== Parameter Event Handlers ====
 bool setParam(hSynthSession sessionPtr, uint8_t id, float value);
 
+// Always coalesced, whatever isParamCoalesced says: for producers that
+// repeat a param at a high rate (e.g. a MIDI learned knob), never drops
+void storeParam(hSynthSession sessionPtr, uint8_t id, float value);
+
+// ==== Controller Event Handlers ====
+/* Continuous controllers (CC, pitch bend, pressure), any thread
+ * - coalesced: never queued, only the latest value per controller reaches
+ *   the audio thread, once per buffer (drained after the param events)
+ * - _id_: a CONTROLLER_* id (see Events.h), unknown ids are ignored
+ */
+void setController(hSynthSession sessionPtr, uint16_t id, float value);
+
+// ==== Event Batches ====
+/* Any thread. Every event of _batch_ reaches the audio thread in the same
+ * buffer, at the same frame (params first, then notes in order): scene
+ * changes never render half applied
+ * - params are queued events (isParamCoalesced doesn't apply)
+ * - returns false when the batch queue (16 batches) is full (dropped whole)
+ */
+bool sendEventBatch(hSynthSession sessionPtr, const EventBatch &batch);
+
+// ==== Event Timeline ====
+// Frames rendered so far (any thread, updated after every callback)
+uint64_t getStreamFrame(hSynthSession sessionPtr);
+
+/* Places _events_ (frames inside the block, any order) on timeline block
+ * _blockIndex_ (frames [blockIndex, blockIndex + 1) * TIMELINE_BLOCK_FRAMES)
+ * - one producer thread, each block written once, in increasing order
+ * - the audio thread applies each event at its exact frame (the buffer
+ *   playing it, frameOffset from the stream clock: no timestamp jitter)
+ * - events already played when the block lands are lost (write earlier)
+ * Returns false for blocks already played, more than TIMELINE_BLOCKS
+ * ahead, or with more than MAX_TIMELINE_BLOCK_EVENTS events
+ */
+bool writeTimelineBlock(hSynthSession sessionPtr, uint64_t blockIndex,
+                        const TimelineEvent *events, uint32_t numEvents);
+
+// ==== DSP Load ====
+// Safe to poll from any thread (lock-free, never blocks the audio thread)
+DspLoadStats getDspLoadStats(hSynthSession sessionPtr);
+
+// Clears peak/overrun counts (applied on the next audio callback)
+void resetDspLoadStats(hSynthSession sessionPtr);
+
+// ==== Latency Probe ====
+// Any thread. Zeroed unless SessionConfig::isLatencyProbeEnabled
+LatencyStats getLatencyStats(hSynthSession sessionPtr);
+
+// Clears the distribution (applied on the next audio callback)
+void resetLatencyStats(hSynthSession sessionPtr);
+
+// ==== Event Telemetry ====
+/* Queue drops/high-water marks and events per callback, for sizing the
+ * queues (every push counts its own drop, whether the caller checks the
+ * return value or not)
+ * Any thread, lock-free
+ */
+EventTelemetry getEventTelemetry(hSynthSession sessionPtr);
+
+// Clears every counter (callback side on the next audio callback)
+void resetEventTelemetry(hSynthSession sessionPtr);
+
+// ==== Output Taps ====
+/* Copies of every rendered buffer for off-thread readers (scopes, spectrum
+ * views, recorders, meters), one ring buffer per tap
+ * - the audio thread only copies (no locks, no allocation) and skips the
+ *   taps entirely when none are attached
+ * - a reader that falls behind loses whole buffers (droppedFrames), it never
+ *   stalls the callback: size capacityFrames for the reader's worst pause
+ *   (a recorder writing to disk: ~1 s)
+ */
+
+// Any non-real-time thread. Returns nullptr when all MAX_OUTPUT_TAPS are used
+hOutputTap attachOutputTap(hSynthSession sessionPtr, uint32_t capacityFrames);
+
+// Frees the tap (waits for a callback in progress to finish with it)
+// NOTE: its reader must be done with it first
+void detachOutputTap(hSynthSession sessionPtr, hOutputTap tap);
+
+// Reader thread: copy up to maxFrames interleaved frames, returns frames read
+uint32_t readOutputTap(hOutputTap tap, float *interleaved, uint32_t maxFrames);
+
+OutputTapStats getOutputTapStats(hOutputTap tap);
+
+// ==== Shared Audio ====
+/* Publishes every rendered buffer into a POSIX shared-memory ring for other
+ * processes (recorders, streamers): one copy on the audio thread, no device
+ * in between. Layout + the reader side: synth_io/SharedAudio.h
+ * - one ring per session, _capacityFrames_ covers the slowest reader's
+ *   worst pause (readers that fall further behind lose the oldest frames)
+ * - any non-real-time thread; disposeSession unpublishes it
+ * Returns false when already published or the ring can't be mapped
+ */
+bool publishSharedAudio(hSynthSession sessionPtr, const char *name,
+                        uint32_t capacityFrames);
+
+// Marks the ring dead for readers, removes the name and unmaps it
+void unpublishSharedAudio(hSynthSession sessionPtr);
+
 } // namespace synth_io
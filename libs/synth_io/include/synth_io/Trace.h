@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+
+#if SYNTH_TRACE && !(defined(__x86_64__) || defined(__aarch64__))
+#include <chrono>
+#endif
+
+/* Audio thread trace recorder (on by default, make TRACE=0 compiles it out)
+ * - SYNTH_TRACE_SCOPE("name") times the enclosing scope: two counter reads
+ *   and one store into the calling thread's ring buffer (no locks, no
+ *   allocation, drops when the ring is full)
+ * - startTraceWriter runs a background thread that drains every ring into
+ *   a rolling history (the last few seconds)
+ * - requestTraceDump writes that history as Chrome trace JSON (open in
+ *   ui.perfetto.dev or chrome://tracing)
+ *
+ * Scopes record nothing until the writer is running.
+ * NOTE: names must be string literals (only the pointer is stored)
+ */
+namespace synth_io::trace {
+inline constexpr uint32_t MAX_TRACE_THREADS = 16;     // audio + workers + ...
+inline constexpr uint32_t TRACE_RING_CAPACITY = 4096; // per thread, power of 2
+inline constexpr uint32_t TRACE_DRAIN_MS = 10;        // writer drain period
+
+// Writer side rolling history (~5 s of a busy 64 voice session)
+inline constexpr uint32_t TRACE_HISTORY_EVENTS = 1u << 18;
+
+struct TraceStats {
+  uint32_t threadCount = 0;  // threads with a trace ring
+  uint32_t historyCount = 0; // events currently held by the writer
+  uint64_t droppedCount = 0; // ring full (writer fell behind)
+  uint32_t dumpCount = 0;    // dumps written
+};
+
+#if SYNTH_TRACE
+// Raw cycle/tick counter (converted to time by the writer)
+inline uint64_t readTraceClock() {
+#if defined(__x86_64__)
+  return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+  uint64_t ticks = 0;
+  __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+  return ticks;
+#else
+  return static_cast<uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+namespace detail {
+void recordTraceEvent(const char *name, uint64_t startTicks,
+                      uint64_t endTicks);
+} // namespace detail
+
+// Label the calling thread in the trace (string literal, e.g. "audio")
+void setTraceThreadName(const char *name);
+
+// Background drain thread; scopes record while it runs
+void startTraceWriter();
+void stopTraceWriter();
+
+// Ask the writer to save its history to _path_ (async, returns false when
+// the writer isn't running)
+bool requestTraceDump(const char *path);
+
+TraceStats getTraceStats();
+#else
+inline void setTraceThreadName(const char *) {}
+inline void startTraceWriter() {}
+inline void stopTraceWriter() {}
+inline bool requestTraceDump(const char *) { return false; }
+inline TraceStats getTraceStats() { return {}; }
+#endif
+
+#if SYNTH_TRACE
+// RAII: one trace event spanning the lifetime of the scope
+struct ScopedTrace {
+  const char *name;
+  uint64_t startTicks;
+
+  explicit ScopedTrace(const char *traceName)
+      : name(traceName), startTicks(readTraceClock()) {}
+  ~ScopedTrace() {
+    detail::recordTraceEvent(name, startTicks, readTraceClock());
+  }
+
+  ScopedTrace(const ScopedTrace &) = delete;
+  ScopedTrace &operator=(const ScopedTrace &) = delete;
+};
+#endif
+
+} // namespace synth_io::trace
+
+#define SYNTH_TRACE_CONCAT_(a, b) a##b
+#define SYNTH_TRACE_CONCAT(a, b) SYNTH_TRACE_CONCAT_(a, b)
+
+#if SYNTH_TRACE
+#define SYNTH_TRACE_SCOPE(name)                                                \
+  ::synth_io::trace::ScopedTrace SYNTH_TRACE_CONCAT(traceScope, __LINE__) {    \
+    name                                                                       \
+  }
+#else
+#define SYNTH_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
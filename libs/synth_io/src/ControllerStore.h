@@ -0,0 +1,66 @@
+#pragma once
+
+#include "synth_io/Events.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace synth_io {
+
+/* Coalescing controller transport (same scheme as ParamStore)
+ * - one atomic value slot per controller id + a dirty bitmask
+ * - any number of producers, one consumer (audio thread)
+ * - a mod wheel sweep or pressure stream sending hundreds of messages a
+ *   second costs one event per controller per buffer, never drops and
+ *   never fills up
+ */
+struct ControllerStore {
+  static constexpr size_t SIZE{CONTROLLER_COUNT};
+  static constexpr size_t NUM_WORDS{SIZE / 64};
+  static_assert(SIZE % 64 == 0);
+
+  // Float bits (std::atomic<float> has no fetch ops, bits keep it lock-free)
+  std::atomic<uint32_t> values[SIZE]{};
+  std::atomic<uint64_t> dirtyMask[NUM_WORDS]{};
+
+  // Producer side (ids >= SIZE are ignored)
+  void store(uint16_t id, float value);
+
+  // Consumer side: calls handler(event) once per controller changed since
+  // the last drain. Returns the number of controllers applied
+  template <typename Handler> uint32_t drain(Handler &&handler);
+};
+
+template <typename Handler>
+uint32_t ControllerStore::drain(Handler &&handler) {
+  uint32_t numApplied = 0;
+
+  for (size_t w = 0; w < NUM_WORDS; w++) {
+    if (dirtyMask[w].load(std::memory_order_relaxed) == 0)
+      continue;
+
+    // Acquire pairs with store()'s release: values are at least this fresh
+    uint64_t mask = dirtyMask[w].exchange(0, std::memory_order_acquire);
+
+    while (mask) {
+      auto bit = static_cast<size_t>(__builtin_ctzll(mask));
+      mask &= mask - 1;
+
+      ControllerEvent event{};
+      event.id = static_cast<uint16_t>(w * 64 + bit);
+
+      uint32_t bits = values[event.id].load(std::memory_order_relaxed);
+      static_assert(sizeof(bits) == sizeof(event.value));
+      std::memcpy(&event.value, &bits, sizeof(bits));
+
+      handler(event);
+      numApplied++;
+    }
+  }
+
+  return numApplied;
+}
+
+} // namespace synth_io
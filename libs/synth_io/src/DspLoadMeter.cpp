@@ -0,0 +1,53 @@
+#include "DspLoadMeter.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace synth_io {
+
+void DspLoadMeter::record(double elapsedSeconds, double deadlineSeconds) {
+  if (deadlineSeconds <= 0.0)
+    return;
+
+  float load = static_cast<float>(elapsedSeconds / deadlineSeconds);
+
+  if (isResetRequested.exchange(false, std::memory_order_relaxed)) {
+    averageLoad.store(load, std::memory_order_relaxed);
+    peakLoad.store(0.0f, std::memory_order_relaxed);
+    overrunCount.store(0, std::memory_order_relaxed);
+    callbackCount.store(0, std::memory_order_relaxed);
+  }
+
+  // Only this thread writes, so plain load/store pairs are enough
+  float average = averageLoad.load(std::memory_order_relaxed);
+  average += (load - average) * AVERAGE_WEIGHT;
+
+  lastLoad.store(load, std::memory_order_relaxed);
+  averageLoad.store(average, std::memory_order_relaxed);
+
+  if (load > peakLoad.load(std::memory_order_relaxed))
+    peakLoad.store(load, std::memory_order_relaxed);
+
+  if (load > 1.0f)
+    overrunCount.store(overrunCount.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+
+  callbackCount.store(callbackCount.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+}
+
+DspLoadStats DspLoadMeter::read() const {
+  DspLoadStats stats{};
+  stats.lastLoad = lastLoad.load(std::memory_order_relaxed);
+  stats.averageLoad = averageLoad.load(std::memory_order_relaxed);
+  stats.peakLoad = peakLoad.load(std::memory_order_relaxed);
+  stats.overrunCount = overrunCount.load(std::memory_order_relaxed);
+  stats.callbackCount = callbackCount.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void DspLoadMeter::requestReset() {
+  isResetRequested.store(true, std::memory_order_relaxed);
+}
+
+} // namespace synth_io
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "synth_io/SynthIO.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace synth_io {
+
+/* Callback timing against the buffer deadline (numFrames / sampleRate)
+ * - single writer (audio thread), any number of readers
+ * - load is a ratio: 1.0 == the whole deadline was used
+ */
+struct DspLoadMeter {
+  // Rolling average weight of the newest callback (~32 callback window)
+  static constexpr float AVERAGE_WEIGHT{1.0f / 32.0f};
+
+  std::atomic<float> lastLoad{0.0f};
+  std::atomic<float> averageLoad{0.0f};
+  std::atomic<float> peakLoad{0.0f};
+
+  std::atomic<uint32_t> overrunCount{0};
+  std::atomic<uint64_t> callbackCount{0};
+
+  // Set by readers, applied by the audio thread (keeps a single writer)
+  std::atomic<bool> isResetRequested{false};
+
+  // Audio thread
+  void record(double elapsedSeconds, double deadlineSeconds);
+
+  // Any thread
+  DspLoadStats read() const;
+  void requestReset();
+};
+
+} // namespace synth_io
@@ -0,0 +1,15 @@
+#include "EventBatchQueue.h"
+
+#include <atomic>
+
+namespace synth_io {
+
+bool EventBatchQueue::push(const EventBatch &batch) {
+  if (queue.push(batch))
+    return true;
+
+  droppedCount.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+} // namespace synth_io
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "MpscQueue.h"
+
+#include "synth_io/SynthIO.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace synth_io {
+
+/* Whole event batches (see sendEventBatch): push from any number of
+ * threads, consume from the audio thread only
+ * - one slot per batch, so the consumer sees all of a batch or none of it
+ * - batches are a few KB: the audio thread reads them in place (consume)
+ */
+struct EventBatchQueue {
+  static constexpr size_t SIZE{16};
+
+  MpscQueue<EventBatch, SIZE> queue{};
+
+  // Pushes that found the queue full (producers, relaxed)
+  std::atomic<uint64_t> droppedCount{0};
+
+  // Returns false (and counts the drop) when full
+  bool push(const EventBatch &batch);
+
+  // visit(const EventBatch &) on the oldest batch. Returns false when empty
+  template <typename Visitor> bool consume(Visitor &&visit) {
+    return queue.consume(visit);
+  }
+};
+
+} // namespace synth_io
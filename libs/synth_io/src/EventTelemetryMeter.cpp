@@ -0,0 +1,62 @@
+#include "EventTelemetryMeter.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace synth_io {
+
+namespace {
+// Only the audio thread writes, so plain load/store pairs are enough
+void storeMax(std::atomic<uint32_t> &peak, uint32_t value) {
+  if (value > peak.load(std::memory_order_relaxed))
+    peak.store(value, std::memory_order_relaxed);
+}
+} // namespace
+
+void EventTelemetryMeter::record(uint32_t noteEvents, uint32_t paramEvents,
+                                 uint32_t batches, uint32_t otherEvents) {
+  if (isResetRequested.exchange(false, std::memory_order_relaxed)) {
+    noteHighWater.store(0, std::memory_order_relaxed);
+    paramHighWater.store(0, std::memory_order_relaxed);
+    batchHighWater.store(0, std::memory_order_relaxed);
+    peakCallbackEvents.store(0, std::memory_order_relaxed);
+    eventCount.store(0, std::memory_order_relaxed);
+    callbackCount.store(0, std::memory_order_relaxed);
+  }
+
+  uint32_t events = noteEvents + paramEvents + otherEvents;
+
+  storeMax(noteHighWater, noteEvents);
+  storeMax(paramHighWater, paramEvents);
+  storeMax(batchHighWater, batches);
+  storeMax(peakCallbackEvents, events);
+  lastCallbackEvents.store(events, std::memory_order_relaxed);
+
+  eventCount.store(eventCount.load(std::memory_order_relaxed) + events,
+                   std::memory_order_relaxed);
+  callbackCount.store(callbackCount.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+}
+
+EventTelemetry EventTelemetryMeter::read() const {
+  EventTelemetry telemetry{};
+  telemetry.noteQueue.highWater =
+      noteHighWater.load(std::memory_order_relaxed);
+  telemetry.paramQueue.highWater =
+      paramHighWater.load(std::memory_order_relaxed);
+  telemetry.batchQueue.highWater =
+      batchHighWater.load(std::memory_order_relaxed);
+  telemetry.callbackCount = callbackCount.load(std::memory_order_relaxed);
+  telemetry.eventCount = eventCount.load(std::memory_order_relaxed);
+  telemetry.lastCallbackEvents =
+      lastCallbackEvents.load(std::memory_order_relaxed);
+  telemetry.peakCallbackEvents =
+      peakCallbackEvents.load(std::memory_order_relaxed);
+  return telemetry;
+}
+
+void EventTelemetryMeter::requestReset() {
+  isResetRequested.store(true, std::memory_order_relaxed);
+}
+
+} // namespace synth_io
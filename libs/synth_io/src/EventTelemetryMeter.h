@@ -0,0 +1,38 @@
+#pragma once
+
+#include "synth_io/SynthIO.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace synth_io {
+
+/* Events the audio callback drained (see EventTelemetry)
+ * - single writer (audio thread), any number of readers
+ * - a callback drains its queues completely, so the events drained from one
+ *   queue are that queue's fill at the callback (high-water mark)
+ * - drop counts live in the queues (their producers count them)
+ */
+struct EventTelemetryMeter {
+  std::atomic<uint32_t> noteHighWater{0};
+  std::atomic<uint32_t> paramHighWater{0};
+  std::atomic<uint32_t> batchHighWater{0};
+  std::atomic<uint32_t> lastCallbackEvents{0};
+  std::atomic<uint32_t> peakCallbackEvents{0};
+  std::atomic<uint64_t> eventCount{0};
+  std::atomic<uint64_t> callbackCount{0};
+
+  // Set by readers, applied by the audio thread (keeps a single writer)
+  std::atomic<bool> isResetRequested{false};
+
+  // Audio thread, once per callback (events drained per source, batch
+  // events count as other events)
+  void record(uint32_t noteEvents, uint32_t paramEvents, uint32_t batches,
+              uint32_t otherEvents);
+
+  // Any thread (queue fields besides the high-water marks are the caller's)
+  EventTelemetry read() const;
+  void requestReset();
+};
+
+} // namespace synth_io
@@ -0,0 +1,34 @@
+#include "EventTimeline.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace synth_io {
+
+bool EventTimeline::write(uint64_t blockIndex, const TimelineEvent *events,
+                          uint32_t numEvents) {
+  if (numEvents > MAX_TIMELINE_BLOCK_EVENTS)
+    return false;
+
+  /* The consumer reads from playingBlock on (its current buffer starts at
+   * streamFrame): earlier blocks are gone, and a block a full ring ahead
+   * shares its slot with one that is still to be played
+   */
+  uint64_t playingBlock =
+      streamFrame.load(std::memory_order_acquire) / TIMELINE_BLOCK_FRAMES;
+  if (blockIndex < playingBlock || blockIndex >= playingBlock + TIMELINE_BLOCKS)
+    return false;
+
+  Block &block = blocks[blockIndex % TIMELINE_BLOCKS];
+
+  // The old tag never matches a block the consumer looks for (written
+  // once), so it skips the slot until the new tag is published
+  for (uint32_t i = 0; i < numEvents; i++)
+    block.events[i] = events[i];
+  block.numEvents = numEvents;
+
+  block.tag.store(blockIndex + 1, std::memory_order_release);
+  return true;
+}
+
+} // namespace synth_io
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "synth_io/SynthIO.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace synth_io {
+
+/* Block-indexed event ring on the stream clock (see writeTimelineBlock)
+ * - slot = blockIndex % TIMELINE_BLOCKS; its tag (blockIndex + 1, release)
+ *   says which block the events belong to, so stale or half-written slots
+ *   are never read
+ * - single producer, single consumer (audio thread). The producer only
+ *   reuses a slot once the consumer has published a stream frame past the
+ *   slot's old block (streamFrame is stored after each callback), so the
+ *   consumer never reads a slot that is being rewritten
+ * - the consumer never writes slots, a block nobody wrote is skipped
+ */
+struct EventTimeline {
+  struct Block {
+    std::atomic<uint64_t> tag{0}; // blockIndex + 1 once written, 0 = never
+    uint32_t numEvents = 0;
+    TimelineEvent events[MAX_TIMELINE_BLOCK_EVENTS];
+  };
+
+  Block blocks[TIMELINE_BLOCKS];
+
+  // Stream clock: frames rendered (audio thread writes, after the callback)
+  std::atomic<uint64_t> streamFrame{0};
+
+  // Producer side
+  bool write(uint64_t blockIndex, const TimelineEvent *events,
+             uint32_t numEvents);
+
+  /* Consumer side: handler(event, frameOffset) for every event in
+   * [startFrame, startFrame + numFrames), block by block (each block's
+   * events in the order written). Returns the number of events applied
+   */
+  template <typename Handler>
+  uint32_t drain(uint64_t startFrame, uint32_t numFrames, Handler &&handler);
+};
+
+template <typename Handler>
+uint32_t EventTimeline::drain(uint64_t startFrame, uint32_t numFrames,
+                              Handler &&handler) {
+  uint64_t endFrame = startFrame + numFrames;
+  uint32_t numApplied = 0;
+
+  // A buffer rarely lines up with blocks: edge blocks are read by both of
+  // the buffers they straddle, each taking its own frames
+  for (uint64_t b = startFrame / TIMELINE_BLOCK_FRAMES;
+       b * TIMELINE_BLOCK_FRAMES < endFrame; b++) {
+    const Block &block = blocks[b % TIMELINE_BLOCKS];
+    if (block.tag.load(std::memory_order_acquire) != b + 1)
+      continue;
+
+    for (uint32_t i = 0; i < block.numEvents; i++) {
+      const TimelineEvent &event = block.events[i];
+      if (event.frame < startFrame || event.frame >= endFrame)
+        continue;
+
+      handler(event, static_cast<uint32_t>(event.frame - startFrame));
+      numApplied++;
+    }
+  }
+
+  return numApplied;
+}
+
+} // namespace synth_io
@@ -0,0 +1,179 @@
+#include "LatencyProbe.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace synth_io {
+
+// ==== <Probe Helpers> ====
+namespace {
+
+// Single writer: plain load + store, no read-modify-write
+template <typename T> void addRelaxed(std::atomic<T> &counter, T value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+float readSample(const audio_io::AudioBuffer &buffer, uint32_t frame) {
+  if (buffer.format == audio_io::BufferFormat::Interleaved)
+    return buffer.interleavedPtr[size_t{frame} * buffer.numChannels];
+
+  return buffer.channelPtrs[0][frame];
+}
+
+// Frame of the first sample above the threshold (numFrames = none)
+uint32_t findOnset(const audio_io::AudioBuffer &buffer, uint32_t start) {
+  for (uint32_t f = start; f < buffer.numFrames; f++) {
+    if (std::fabs(readSample(buffer, f)) > LatencyProbe::THRESHOLD)
+      return f;
+  }
+  return buffer.numFrames;
+}
+
+// Histogram value at _fraction_ of _total_ (bin center, ms)
+double findPercentile(const LatencyProbe &probe, uint32_t total,
+                      double fraction) {
+  auto target = static_cast<uint32_t>(std::ceil(total * fraction));
+  uint32_t seen = 0;
+
+  for (uint32_t b = 0; b < LatencyProbe::NUM_BINS; b++) {
+    seen += probe.bins[b].load(std::memory_order_relaxed);
+    if (seen >= target && seen > 0)
+      return (b + 0.5) * LatencyProbe::BIN_MS;
+  }
+  return LatencyProbe::NUM_BINS * LatencyProbe::BIN_MS;
+}
+
+void resetProbe(LatencyProbe &probe) {
+  for (std::atomic<uint32_t> &bin : probe.bins)
+    bin.store(0, std::memory_order_relaxed);
+
+  probe.count.store(0, std::memory_order_relaxed);
+  probe.maskedCount.store(0, std::memory_order_relaxed);
+  probe.timeoutCount.store(0, std::memory_order_relaxed);
+  probe.minNs.store(0, std::memory_order_relaxed);
+  probe.maxNs.store(0, std::memory_order_relaxed);
+  probe.sumNs.store(0, std::memory_order_relaxed);
+  probe.queueSumNs.store(0, std::memory_order_relaxed);
+  probe.openCount = 0;
+}
+
+void recordLatency(LatencyProbe &probe, uint64_t latencyNs,
+                   uint64_t queueNs) {
+  double ms = static_cast<double>(latencyNs) * 1.0e-6;
+  auto bin = static_cast<uint32_t>(ms / LatencyProbe::BIN_MS);
+  if (bin >= LatencyProbe::NUM_BINS)
+    bin = LatencyProbe::NUM_BINS - 1;
+
+  uint32_t count = probe.count.load(std::memory_order_relaxed);
+  if (count == 0 || latencyNs < probe.minNs.load(std::memory_order_relaxed))
+    probe.minNs.store(latencyNs, std::memory_order_relaxed);
+  if (latencyNs > probe.maxNs.load(std::memory_order_relaxed))
+    probe.maxNs.store(latencyNs, std::memory_order_relaxed);
+
+  addRelaxed(probe.bins[bin], 1u);
+  addRelaxed(probe.sumNs, latencyNs);
+  addRelaxed(probe.queueSumNs, queueNs);
+  probe.count.store(count + 1, std::memory_order_relaxed);
+}
+
+} // namespace
+// ==== </Probe Helpers> ====
+
+void LatencyProbe::open(const NoteEvent &event, uint64_t callbackTime) {
+  if (event.timestamp == 0 || event.timestamp > callbackTime)
+    return;
+
+  if (openCount >= MAX_OPEN_PROBES) {
+    addRelaxed(timeoutCount, 1u); // a chord/burst: nothing to measure
+    return;
+  }
+
+  OpenProbe &probe = openProbes[openCount++];
+  probe.timestamp = event.timestamp;
+  probe.queueNs = callbackTime - event.timestamp;
+  probe.frameOffset = event.frameOffset;
+  probe.waitedFrames = 0;
+}
+
+void LatencyProbe::scan(const audio_io::AudioBuffer &buffer,
+                        double sampleRate, uint64_t callbackTime) {
+  if (isResetRequested.exchange(false, std::memory_order_relaxed))
+    resetProbe(*this);
+
+  if (buffer.numFrames == 0 || buffer.numChannels == 0 || sampleRate <= 0.0)
+    return;
+
+  uint64_t frameZeroTime = buffer.outputTime ? buffer.outputTime : callbackTime;
+  auto timeoutFrames = static_cast<uint32_t>(TIMEOUT_SECONDS * sampleRate);
+
+  uint32_t i = 0;
+  while (i < openCount) {
+    OpenProbe &probe = openProbes[i];
+    uint32_t start = probe.frameOffset < buffer.numFrames
+                         ? probe.frameOffset
+                         : buffer.numFrames - 1;
+
+    // Already audible where the note starts: its onset is hidden
+    float before = start > 0 ? std::fabs(readSample(buffer, start - 1))
+                             : lastLevel;
+    bool isDone = true;
+
+    if (probe.waitedFrames == 0 && before > THRESHOLD) {
+      addRelaxed(maskedCount, 1u);
+    } else if (uint32_t onset = findOnset(buffer, start);
+               onset < buffer.numFrames) {
+      auto onsetNs = static_cast<uint64_t>(static_cast<double>(onset) /
+                                           sampleRate * 1.0e9);
+      uint64_t soundTime = frameZeroTime + onsetNs;
+      if (soundTime > probe.timestamp)
+        recordLatency(*this, soundTime - probe.timestamp, probe.queueNs);
+    } else if (probe.waitedFrames + buffer.numFrames >= timeoutFrames) {
+      addRelaxed(timeoutCount, 1u);
+    } else {
+      // Slow attack: keep looking from the next buffer's first frame
+      probe.waitedFrames += buffer.numFrames;
+      probe.frameOffset = 0;
+      isDone = false;
+    }
+
+    if (isDone)
+      openProbes[i] = openProbes[--openCount];
+    else
+      i++;
+  }
+
+  lastLevel = std::fabs(readSample(buffer, buffer.numFrames - 1));
+}
+
+LatencyStats LatencyProbe::read() const {
+  LatencyStats stats{};
+  stats.count = count.load(std::memory_order_relaxed);
+  stats.maskedCount = maskedCount.load(std::memory_order_relaxed);
+  stats.timeoutCount = timeoutCount.load(std::memory_order_relaxed);
+  if (stats.count == 0)
+    return stats;
+
+  double invCount = 1.0 / stats.count;
+  stats.minMs = static_cast<double>(minNs.load(std::memory_order_relaxed)) *
+                1.0e-6;
+  stats.maxMs = static_cast<double>(maxNs.load(std::memory_order_relaxed)) *
+                1.0e-6;
+  stats.meanMs = static_cast<double>(sumNs.load(std::memory_order_relaxed)) *
+                 1.0e-6 * invCount;
+  stats.meanQueueMs =
+      static_cast<double>(queueSumNs.load(std::memory_order_relaxed)) *
+      1.0e-6 * invCount;
+
+  stats.p50Ms = findPercentile(*this, stats.count, 0.50);
+  stats.p90Ms = findPercentile(*this, stats.count, 0.90);
+  stats.p99Ms = findPercentile(*this, stats.count, 0.99);
+  return stats;
+}
+
+void LatencyProbe::requestReset() {
+  isResetRequested.store(true, std::memory_order_relaxed);
+}
+
+} // namespace synth_io
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "synth_io/Events.h"
+#include "synth_io/SynthIO.h"
+
+#include "audio_io/AudioIOTypes.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace synth_io {
+
+/* Key-to-sound latency (SessionConfig::isLatencyProbeEnabled)
+ * - each NoteOn the callback drains opens a probe: its input timestamp
+ *   (stamped by noteOn) + the frame it renders at
+ * - after the buffer renders, open probes look for the first output sample
+ *   above THRESHOLD from their frame on. Found at frame f:
+ *     latency = buffer.outputTime + f / sampleRate - timestamp
+ *   (outputTime is the backend's estimate of when frame 0 leaves the
+ *   device; unknown -> the callback start)
+ * - a note landing on output that's already audible can't be told apart
+ *   from it (masked), one that never crosses THRESHOLD times out
+ * - single writer (audio thread), any number of readers: a histogram of
+ *   relaxed atomics
+ * NOTE: measure with isolated notes (silence between hits)
+ */
+struct LatencyProbe {
+  static constexpr uint32_t MAX_OPEN_PROBES{16};
+  static constexpr float THRESHOLD{0.001f}; // -60 dBFS
+  static constexpr double TIMEOUT_SECONDS{0.5};
+
+  // 0.1 ms bins up to 200 ms, the last one holds everything beyond
+  static constexpr double BIN_MS{0.1};
+  static constexpr uint32_t NUM_BINS{2000};
+
+  struct OpenProbe {
+    uint64_t timestamp = 0;
+    uint64_t queueNs = 0; // input -> the callback that rendered it
+    uint32_t frameOffset = 0;
+    uint32_t waitedFrames = 0;
+  };
+
+  // ==== Audio thread only ====
+  OpenProbe openProbes[MAX_OPEN_PROBES];
+  uint32_t openCount = 0;
+  float lastLevel = 0.0f; // |last sample| of the previous buffer
+
+  // ==== Results (audio thread writes) ====
+  std::atomic<uint32_t> bins[NUM_BINS]{};
+  std::atomic<uint32_t> count{0};
+  std::atomic<uint32_t> maskedCount{0};
+  std::atomic<uint32_t> timeoutCount{0};
+  std::atomic<uint64_t> minNs{0};
+  std::atomic<uint64_t> maxNs{0};
+  std::atomic<uint64_t> sumNs{0};
+  std::atomic<uint64_t> queueSumNs{0};
+
+  // Set by readers, applied by the audio thread (keeps a single writer)
+  std::atomic<bool> isResetRequested{false};
+
+  // Audio thread: a drained NoteOn (before the buffer renders)
+  void open(const NoteEvent &event, uint64_t callbackTime);
+
+  // Audio thread: the rendered buffer (channel 0 is scanned)
+  void scan(const audio_io::AudioBuffer &buffer, double sampleRate,
+            uint64_t callbackTime);
+
+  // Any thread
+  LatencyStats read() const;
+  void requestReset();
+};
+
+} // namespace synth_io
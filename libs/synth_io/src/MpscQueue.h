@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace synth_io {
+
+/* Bounded lock-free multi-producer / single-consumer ring
+ * - producers (MIDI, key capture, terminal threads) claim a slot with a CAS
+ *   on enqueuePos; each slot's sequence number says whether it's free/filled
+ * - the consumer (audio thread) never CASes or blocks
+ * - acquire/release only (no seq_cst), indices padded to their own lines
+ *
+ * Slot s is free for the producer at position p when sequence == p,
+ * readable by the consumer when sequence == p + 1
+ */
+template <typename T, size_t Size> struct MpscQueue {
+  // NOTE(nico): SIZE value need to be power of to use bitmasking for wrapping
+  // Alternative is modulo (%) which is more expensive
+  static_assert(Size > 1 && (Size & (Size - 1)) == 0, "Size must be pow2");
+  static constexpr size_t SIZE{Size};
+  static constexpr size_t WRAP{Size - 1};
+  static constexpr size_t CACHE_LINE{64};
+
+  struct Slot {
+    std::atomic<size_t> sequence{0};
+    T value{};
+  };
+
+  Slot slots[Size]{};
+
+  alignas(CACHE_LINE) std::atomic<size_t> enqueuePos{0};
+  alignas(CACHE_LINE) std::atomic<size_t> dequeuePos{0}; // consumer owned
+
+  MpscQueue() {
+    for (size_t i = 0; i < Size; i++)
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  // Any thread. Returns false when full
+  bool push(const T &value) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+
+    for (;;) {
+      slot = &slots[pos & WRAP];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+      if (diff == 0) {
+        // Slot free at our position, try to claim it
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false; // consumer hasn't freed this slot yet (full)
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed); // lost the race
+      }
+    }
+
+    slot->value = value;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer thread only. Returns false when empty
+  bool pop(T &value) {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Slot &slot = slots[pos & WRAP];
+
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+      return false;
+
+    value = slot.value;
+
+    // Hand the slot back to producers for the next lap
+    slot.sequence.store(pos + Size, std::memory_order_release);
+    dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Consumer thread only: visit(value) on the next entry in place, then
+  // free it (large T: no copy out). Returns false when empty
+  template <typename Visitor> bool consume(Visitor &&visit) {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Slot &slot = slots[pos & WRAP];
+
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+      return false;
+
+    visit(static_cast<const T &>(slot.value));
+
+    slot.sequence.store(pos + Size, std::memory_order_release);
+    dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Debug only: visit readable entries without consuming them
+  template <typename Visitor> void peekAll(Visitor &&visit) {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+
+    for (size_t n = 0; n < Size; n++, pos++) {
+      Slot &slot = slots[pos & WRAP];
+      if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+        break;
+
+      visit(slot.value);
+    }
+  }
+};
+
+} // namespace synth_io
@@ -1,34 +1,25 @@
 #include "NoteEventQueue.h"
+
+#include "synth_io/RtAudit.h"
+
+#include <atomic>
 #include <cstddef>
 
 namespace synth_io {
 
 bool NoteEventQueue::push(const NoteEvent &event) {
-  size_t currentIndex = writeIndex.load();
-  size_t nextIndex = (currentIndex + 1) & WRAP;
-
-  if (nextIndex == readIndex.load())
-    return false;
+  if (queue.push(event))
+    return true;
 
-  queue[currentIndex] = event;
-  writeIndex.store(nextIndex);
-
-  return true;
+  droppedCount.fetch_add(1, std::memory_order_relaxed);
+  return false;
 }
 
-bool NoteEventQueue::pop(NoteEvent &event) {
-  size_t currentIndex = readIndex.load();
-
-  if (currentIndex == writeIndex.load())
-    return false;
-
-  event = queue[currentIndex];
-  readIndex.store((currentIndex + 1) & WRAP);
-
-  return true;
-}
+bool NoteEventQueue::pop(NoteEvent &event) { return queue.pop(event); }
 
 void NoteEventQueue::printEvent(NoteEvent &event) {
+  rt_audit::markNonRealtime("NoteEventQueue::printEvent");
+
   printf("==== Event ====\n");
   printf("type: %d\n", (int)event.type);
   printf("midi: %d\n", event.midiNote);
@@ -36,14 +27,11 @@ void NoteEventQueue::printEvent(NoteEvent &event) {
 }
 
 void NoteEventQueue::printQueue() {
-  size_t currentIndex = readIndex.load();
-  size_t endIndex = writeIndex.load();
+  rt_audit::markNonRealtime("NoteEventQueue::printQueue");
 
   // Only print events that are able to be read
   printf("======== Event Queue ========\n");
-  for (; currentIndex < endIndex; currentIndex++) {
-    printEvent(queue[currentIndex]);
-  }
+  queue.peekAll([this](NoteEvent &event) { printEvent(event); });
 }
 
 } // namespace synth_io
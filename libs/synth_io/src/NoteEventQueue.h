@@ -1,24 +1,26 @@
 #pragma once
 
+#include "MpscQueue.h"
+
 #include "synth_io/Events.h"
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
 
 namespace synth_io {
 
+// Safe to push from any number of threads, pop from the audio thread only
 struct NoteEventQueue {
-  // NOTE(nico): SIZE value need to be power of to use bitmasking for wrapping
-  // Alternative is modulo (%) which is more expensive
   static constexpr size_t SIZE{256};
-  static constexpr size_t WRAP{SIZE - 1};
 
-  NoteEvent queue[SIZE];
+  MpscQueue<NoteEvent, SIZE> queue{};
 
-  std::atomic<size_t> readIndex{0};
-  std::atomic<size_t> writeIndex{0};
+  // Pushes that found the queue full (producers, relaxed)
+  std::atomic<uint64_t> droppedCount{0};
 
+  // Returns false (and counts the drop) when full
   bool push(const NoteEvent &event);
   bool pop(NoteEvent &event);
 
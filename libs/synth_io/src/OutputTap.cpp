@@ -0,0 +1,180 @@
+#include "OutputTap.h"
+
+#include "synth_io/Trace.h"
+
+#include "audio_io/AudioIOTypes.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+namespace synth_io {
+using AudioBuffer = audio_io::AudioBuffer;
+
+// ==== <Tap Helpers> ====
+namespace {
+
+// Copy _numFrames_ interleaved frames starting at ring frame _start_
+// (split in two where the ring wraps)
+void copyIntoRing(OutputTap &tap, uint64_t start, const float *src,
+                  uint32_t numFrames) {
+  auto first = static_cast<uint32_t>(start % tap.capacityFrames);
+  uint32_t headFrames = tap.capacityFrames - first;
+  if (headFrames > numFrames)
+    headFrames = numFrames;
+
+  std::memcpy(tap.samples + first * tap.numChannels, src,
+              headFrames * tap.numChannels * sizeof(float));
+  std::memcpy(tap.samples, src + headFrames * tap.numChannels,
+              (numFrames - headFrames) * tap.numChannels * sizeof(float));
+}
+
+// Planar buffers interleave straight into the ring (no temp buffer)
+void interleaveIntoRing(OutputTap &tap, uint64_t start,
+                        float *const *channelPtrs, uint32_t numFrames) {
+  auto frame = static_cast<uint32_t>(start % tap.capacityFrames);
+
+  for (uint32_t i = 0; i < numFrames; i++) {
+    float *dst = tap.samples + frame * tap.numChannels;
+    for (uint32_t ch = 0; ch < tap.numChannels; ch++)
+      dst[ch] = channelPtrs[ch][i];
+
+    if (++frame == tap.capacityFrames)
+      frame = 0;
+  }
+}
+
+void writeTap(OutputTap &tap, const AudioBuffer &buffer) {
+  uint64_t writeFrame = tap.writeFrame.load(std::memory_order_relaxed);
+  uint64_t readFrame = tap.readFrame.load(std::memory_order_acquire);
+
+  if (writeFrame - readFrame + buffer.numFrames > tap.capacityFrames) {
+    tap.droppedFrames.store(
+        tap.droppedFrames.load(std::memory_order_relaxed) + buffer.numFrames,
+        std::memory_order_relaxed);
+    return;
+  }
+
+  if (buffer.format == audio_io::BufferFormat::Interleaved)
+    copyIntoRing(tap, writeFrame, buffer.interleavedPtr, buffer.numFrames);
+  else
+    interleaveIntoRing(tap, writeFrame, buffer.channelPtrs, buffer.numFrames);
+
+  tap.writeFrame.store(writeFrame + buffer.numFrames,
+                       std::memory_order_release);
+}
+
+} // namespace
+// ==== </Tap Helpers> ====
+
+void OutputTapSet::write(const AudioBuffer &buffer) {
+  if (activeCount.load(std::memory_order_relaxed) == 0)
+    return;
+
+  SYNTH_TRACE_SCOPE("writeOutputTaps");
+
+  // seq_cst pairs with detach: either detach sees isWriting, or this pass
+  // sees the cleared slot
+  isWriting.store(true, std::memory_order_seq_cst);
+
+  for (auto &slot : slots) {
+    OutputTap *tap = slot.load(std::memory_order_seq_cst);
+    if (tap)
+      writeTap(*tap, buffer);
+  }
+
+  isWriting.store(false, std::memory_order_release);
+}
+
+OutputTap *OutputTapSet::attach(uint32_t capacityFrames,
+                                uint32_t numChannels) {
+  if (capacityFrames == 0 || numChannels == 0)
+    return nullptr;
+
+  auto *tap = new OutputTap();
+  tap->samples = new float[capacityFrames * numChannels]();
+  tap->capacityFrames = capacityFrames;
+  tap->numChannels = numChannels;
+
+  for (auto &slot : slots) {
+    OutputTap *expected = nullptr;
+    if (slot.compare_exchange_strong(expected, tap,
+                                     std::memory_order_seq_cst)) {
+      activeCount.fetch_add(1, std::memory_order_relaxed);
+      return tap;
+    }
+  }
+
+  // All MAX_OUTPUT_TAPS slots in use
+  delete[] tap->samples;
+  delete tap;
+  return nullptr;
+}
+
+void OutputTapSet::detach(OutputTap *tap) {
+  if (!tap)
+    return;
+
+  for (auto &slot : slots) {
+    OutputTap *expected = tap;
+    if (!slot.compare_exchange_strong(expected, nullptr,
+                                      std::memory_order_seq_cst))
+      continue;
+
+    activeCount.fetch_sub(1, std::memory_order_relaxed);
+
+    // At most one callback's worth of copying
+    while (isWriting.load(std::memory_order_seq_cst))
+      std::this_thread::yield();
+
+    delete[] tap->samples;
+    delete tap;
+    return;
+  }
+}
+
+void OutputTapSet::detachAll() {
+  for (auto &slot : slots)
+    detach(slot.load(std::memory_order_relaxed));
+}
+
+// ==== PUBLIC APIS ====
+
+uint32_t readOutputTap(hOutputTap tap, float *interleaved,
+                       uint32_t maxFrames) {
+  uint64_t readFrame = tap->readFrame.load(std::memory_order_relaxed);
+  uint64_t writeFrame = tap->writeFrame.load(std::memory_order_acquire);
+
+  uint64_t available = writeFrame - readFrame;
+  auto numFrames =
+      static_cast<uint32_t>(available < maxFrames ? available : maxFrames);
+
+  auto first = static_cast<uint32_t>(readFrame % tap->capacityFrames);
+  uint32_t headFrames = tap->capacityFrames - first;
+  if (headFrames > numFrames)
+    headFrames = numFrames;
+
+  std::memcpy(interleaved, tap->samples + first * tap->numChannels,
+              headFrames * tap->numChannels * sizeof(float));
+  std::memcpy(interleaved + headFrames * tap->numChannels, tap->samples,
+              (numFrames - headFrames) * tap->numChannels * sizeof(float));
+
+  tap->readFrame.store(readFrame + numFrames, std::memory_order_release);
+  return numFrames;
+}
+
+OutputTapStats getOutputTapStats(hOutputTap tap) {
+  OutputTapStats stats{};
+  uint64_t writeFrame = tap->writeFrame.load(std::memory_order_acquire);
+  uint64_t readFrame = tap->readFrame.load(std::memory_order_relaxed);
+
+  stats.numChannels = tap->numChannels;
+  stats.capacityFrames = tap->capacityFrames;
+  stats.availableFrames = static_cast<uint32_t>(writeFrame - readFrame);
+  stats.framesWritten = writeFrame;
+  stats.droppedFrames = tap->droppedFrames.load(std::memory_order_relaxed);
+  return stats;
+}
+
+} // namespace synth_io
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "synth_io/SynthIO.h"
+
+#include "audio_io/AudioIOTypes.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace synth_io {
+
+/* Single producer (audio thread) / single consumer (the tap's reader)
+ * - interleaved frames, indices count frames and only grow
+ * - a buffer that doesn't fit is dropped whole (the reader sees the gap in
+ *   droppedFrames), the audio thread never waits
+ */
+struct OutputTap {
+  float *samples = nullptr; // capacityFrames * numChannels
+  uint32_t capacityFrames = 0;
+  uint32_t numChannels = 0;
+
+  std::atomic<uint64_t> writeFrame{0}; // audio thread
+  std::atomic<uint64_t> readFrame{0};  // reader
+  std::atomic<uint64_t> droppedFrames{0};
+
+  OutputTap() = default;
+  OutputTap(const OutputTap &) = delete;
+  OutputTap &operator=(const OutputTap &) = delete;
+};
+
+/* Fixed tap slots of a session
+ * - attach/detach: any non-real-time thread
+ * - write: audio thread, once per callback (one relaxed load when nothing
+ *   is attached)
+ */
+struct OutputTapSet {
+  std::atomic<OutputTap *> slots[MAX_OUTPUT_TAPS] = {};
+  std::atomic<uint32_t> activeCount{0};
+
+  // Set by the audio thread while it walks _slots_; detach waits on it
+  // before freeing a tap
+  std::atomic<bool> isWriting{false};
+
+  // Audio thread
+  void write(const audio_io::AudioBuffer &buffer);
+
+  // Any thread
+  OutputTap *attach(uint32_t capacityFrames, uint32_t numChannels);
+  void detach(OutputTap *tap);
+  void detachAll();
+};
+
+} // namespace synth_io
@@ -1,48 +1,36 @@
 #include "ParamEventQueue.h"
+
+#include "synth_io/RtAudit.h"
+
+#include <atomic>
 #include <cstddef>
 
 namespace synth_io {
 
 bool ParamEventQueue::push(const ParamEvent &event) {
-  size_t currentIndex = writeIndex.load();
-  size_t nextIndex = (currentIndex + 1) & WRAP;
-
-  if (nextIndex == readIndex.load())
-    return false;
+  if (queue.push(event))
+    return true;
 
-  queue[currentIndex] = event;
-  writeIndex.store(nextIndex);
-
-  return true;
+  droppedCount.fetch_add(1, std::memory_order_relaxed);
+  return false;
 }
 
-bool ParamEventQueue::pop(ParamEvent &event) {
-  size_t currentIndex = readIndex.load();
-
-  if (currentIndex == writeIndex.load())
-    return false;
-
-  event = queue[currentIndex];
-  readIndex.store((currentIndex + 1) & WRAP);
-
-  return true;
-}
+bool ParamEventQueue::pop(ParamEvent &event) { return queue.pop(event); }
 
 void ParamEventQueue::printEvent(ParamEvent &event) {
+  rt_audit::markNonRealtime("ParamEventQueue::printEvent");
+
   printf("==== Event ====\n");
   printf("paramID: %d\n", (int)event.id);
   printf("value: %f\n", event.value);
 }
 
 void ParamEventQueue::printQueue() {
-  size_t currentIndex = readIndex.load();
-  size_t endIndex = writeIndex.load();
+  rt_audit::markNonRealtime("ParamEventQueue::printQueue");
 
   // Only print events that are able to be read
   printf("======== Event Queue ========\n");
-  for (; currentIndex < endIndex; currentIndex++) {
-    printEvent(queue[currentIndex]);
-  }
+  queue.peekAll([this](ParamEvent &event) { printEvent(event); });
 }
 
 } // namespace synth_io
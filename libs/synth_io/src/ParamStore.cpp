@@ -0,0 +1,19 @@
+#include "ParamStore.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace synth_io {
+
+void ParamStore::store(uint8_t id, float value) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  values[id].store(bits, std::memory_order_relaxed);
+
+  // Release: a consumer that sees the bit also sees the value
+  uint64_t bit = uint64_t{1} << (id % 64);
+  dirtyMask[id / 64].fetch_or(bit, std::memory_order_release);
+}
+
+} // namespace synth_io
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "synth_io/Events.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace synth_io {
+
+/* Coalescing parameter transport (alternative to ParamEventQueue)
+ * - one atomic value slot per param id + a dirty bitmask
+ * - any number of producers, one consumer (audio thread)
+ * - never full: the last value written before a block always wins and is
+ *   applied once, so traffic is O(params) per block instead of O(events)
+ *
+ * NOTE: values apply at the start of the buffer (no frameOffset)
+ */
+struct ParamStore {
+  // ParamEvent::id is a uint8_t
+  static constexpr size_t SIZE{256};
+  static constexpr size_t NUM_WORDS{SIZE / 64};
+
+  // Float bits (std::atomic<float> has no fetch ops, bits keep it lock-free)
+  std::atomic<uint32_t> values[SIZE]{};
+  std::atomic<uint64_t> dirtyMask[NUM_WORDS]{};
+
+  // Producer side
+  void store(uint8_t id, float value);
+
+  // Consumer side: calls handler(event) once per param changed since the
+  // last drain. Returns the number of params applied
+  template <typename Handler> uint32_t drain(Handler &&handler);
+};
+
+template <typename Handler> uint32_t ParamStore::drain(Handler &&handler) {
+  uint32_t numApplied = 0;
+
+  for (size_t w = 0; w < NUM_WORDS; w++) {
+    if (dirtyMask[w].load(std::memory_order_relaxed) == 0)
+      continue;
+
+    // Acquire pairs with store()'s release: values are at least this fresh
+    uint64_t mask = dirtyMask[w].exchange(0, std::memory_order_acquire);
+
+    while (mask) {
+      auto bit = static_cast<size_t>(__builtin_ctzll(mask));
+      mask &= mask - 1;
+
+      ParamEvent event{};
+      event.id = static_cast<uint8_t>(w * 64 + bit);
+
+      uint32_t bits = values[event.id].load(std::memory_order_relaxed);
+      static_assert(sizeof(bits) == sizeof(event.value));
+      std::memcpy(&event.value, &bits, sizeof(bits));
+
+      handler(event);
+      numApplied++;
+    }
+  }
+
+  return numApplied;
+}
+
+} // namespace synth_io
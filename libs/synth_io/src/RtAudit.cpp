@@ -0,0 +1,216 @@
+#include "synth_io/RtAudit.h"
+
+#include "RtAuditDetail.h"
+
+#if SYNTH_RT_AUDIT
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+#include <execinfo.h>
+#include <pthread.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+namespace synth_io::rt_audit {
+
+// ==== <Audit Helpers> ====
+namespace {
+constexpr const char *VIOLATION_TYPE_NAMES[] = {
+    "allocation", "deallocation", "lock", "blocking call", "non real-time",
+};
+
+/* Per-thread section state in a pthread key, NOT thread_local: macOS
+ * allocates thread_local storage lazily (malloc inside the malloc hook)
+ * value = depth | RECORDING_BIT
+ */
+constexpr uintptr_t RECORDING_BIT = uintptr_t{1} << 16;
+constexpr uintptr_t DEPTH_MASK = RECORDING_BIT - 1;
+
+pthread_key_t sectionKey;
+std::atomic<bool> isSectionKeyReady{false};
+
+// Hooks run before main (static init mallocs): key created on first use
+// of a section, everything before that is outside any section anyway
+bool ensureSectionKey() {
+  if (isSectionKeyReady.load(std::memory_order_acquire))
+    return true;
+
+  static const bool isCreated = pthread_key_create(&sectionKey, nullptr) == 0;
+  isSectionKeyReady.store(isCreated, std::memory_order_release);
+  return isCreated;
+}
+
+uintptr_t getSectionState() {
+  if (!isSectionKeyReady.load(std::memory_order_acquire))
+    return 0;
+
+  return reinterpret_cast<uintptr_t>(pthread_getspecific(sectionKey));
+}
+
+void setSectionState(uintptr_t state) {
+  pthread_setspecific(sectionKey, reinterpret_cast<void *>(state));
+}
+
+// ==== Violation store ====
+// Slots are claimed with one fetch_add, published with _isReady_
+struct ViolationSlot {
+  RtViolation violation;
+  std::atomic<bool> isReady{false};
+};
+
+ViolationSlot violationSlots[MAX_RT_VIOLATIONS];
+std::atomic<uint32_t> claimedCount{0};
+
+// ==== FTZ/DAZ ====
+uint64_t readFloatEnv() {
+#if defined(__SSE2__) || defined(_M_X64)
+  return _mm_getcsr();
+#elif defined(__aarch64__)
+  uint64_t fpcr = 0;
+  __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+  return fpcr;
+#else
+  return 0;
+#endif
+}
+
+void writeFloatEnv(uint64_t bits) {
+#if defined(__SSE2__) || defined(_M_X64)
+  _mm_setcsr(static_cast<unsigned int>(bits));
+#elif defined(__aarch64__)
+  __asm__ __volatile__("msr fpcr, %0" : : "r"(bits));
+#else
+  (void)bits;
+#endif
+}
+
+uint64_t withFlushToZero(uint64_t bits) {
+#if defined(__SSE2__) || defined(_M_X64)
+  return bits | 0x8040; // FTZ (bit 15) | DAZ (bit 6)
+#elif defined(__aarch64__)
+  return bits | (uint64_t{1} << 24); // FZ (inputs and outputs)
+#else
+  return bits;
+#endif
+}
+
+} // namespace
+// ==== </Audit Helpers> ====
+
+namespace detail {
+
+bool enterRtSection(FloatEnv &saved) {
+  if (!ensureSectionKey())
+    return false;
+
+  uintptr_t state = getSectionState();
+  setSectionState(state + 1);
+
+  if ((state & DEPTH_MASK) != 0)
+    return false;
+
+  saved.bits = readFloatEnv();
+  writeFloatEnv(withFlushToZero(saved.bits));
+  return true;
+}
+
+void exitRtSection(const FloatEnv &saved, bool isOuter) {
+  if (!isSectionKeyReady.load(std::memory_order_acquire))
+    return;
+
+  if (isOuter)
+    writeFloatEnv(saved.bits);
+  setSectionState(getSectionState() - 1);
+}
+
+void recordViolation(RtViolationType type, const char *what) {
+  uintptr_t state = getSectionState();
+  if ((state & DEPTH_MASK) == 0 || (state & RECORDING_BIT) != 0)
+    return;
+
+  setSectionState(state | RECORDING_BIT);
+
+  uint32_t index = claimedCount.fetch_add(1, std::memory_order_relaxed);
+  if (index < MAX_RT_VIOLATIONS) {
+    ViolationSlot &slot = violationSlots[index];
+    slot.violation.type = type;
+    slot.violation.what = what;
+
+    // Skip this frame (the hook's frame stays: it names the call site)
+    int depth = backtrace(slot.violation.backtrace,
+                          static_cast<int>(MAX_RT_BACKTRACE));
+    slot.violation.depth = depth > 1 ? static_cast<uint32_t>(depth - 1) : 0;
+    if (depth > 1) {
+      for (uint32_t i = 0; i < slot.violation.depth; i++)
+        slot.violation.backtrace[i] = slot.violation.backtrace[i + 1];
+    }
+
+    slot.isReady.store(true, std::memory_order_release);
+  }
+
+  setSectionState(state);
+}
+
+} // namespace detail
+
+void markNonRealtime(const char *what) {
+  detail::recordViolation(RtViolationType::NonRealtime, what);
+}
+
+bool isInRtSection() { return (getSectionState() & DEPTH_MASK) != 0; }
+
+void initRtAudit() {
+  ensureSectionKey();
+
+  // glibc loads its unwinder on the first backtrace (dlopen, malloc)
+  void *frames[4];
+  (void)backtrace(frames, 4);
+}
+
+RtAuditStats getRtAuditStats() {
+  RtAuditStats stats{};
+  stats.violationCount = claimedCount.load(std::memory_order_relaxed);
+  stats.droppedCount = stats.violationCount > MAX_RT_VIOLATIONS
+                           ? stats.violationCount - MAX_RT_VIOLATIONS
+                           : 0;
+  return stats;
+}
+
+// NOTE: a violation recorded while clearing can be lost (debug report only)
+void printRtViolations(FILE *stream) {
+  RtAuditStats stats = getRtAuditStats();
+  uint32_t count = stats.violationCount < MAX_RT_VIOLATIONS
+                       ? stats.violationCount
+                       : MAX_RT_VIOLATIONS;
+
+  fprintf(stream, "RT audit: %u violations (%u not recorded)\n",
+          stats.violationCount, stats.droppedCount);
+
+  for (uint32_t i = 0; i < count; i++) {
+    ViolationSlot &slot = violationSlots[i];
+    if (!slot.isReady.load(std::memory_order_acquire))
+      continue; // still being written
+
+    const RtViolation &violation = slot.violation;
+    fprintf(stream, "[%u] %s: %s\n", i,
+            VIOLATION_TYPE_NAMES[static_cast<size_t>(violation.type)],
+            violation.what ? violation.what : "?");
+    fflush(stream);
+
+    // Symbolized straight to the fd (no malloc, unlike backtrace_symbols)
+    backtrace_symbols_fd(violation.backtrace,
+                         static_cast<int>(violation.depth), fileno(stream));
+  }
+
+  for (uint32_t i = 0; i < count; i++)
+    violationSlots[i].isReady.store(false, std::memory_order_relaxed);
+  claimedCount.store(0, std::memory_order_relaxed);
+}
+
+} // namespace synth_io::rt_audit
+
+#endif // SYNTH_RT_AUDIT
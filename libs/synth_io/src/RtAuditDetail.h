@@ -0,0 +1,14 @@
+#pragma once
+
+#include "synth_io/RtAudit.h"
+
+namespace synth_io::rt_audit::detail {
+#if SYNTH_RT_AUDIT
+/* Hook side of the audit (RtAuditHooks.cpp -> RtAudit.cpp)
+ * - no-op outside an RtSection, and while a violation is being recorded
+ *   (backtrace/formatting can land back in a hook)
+ * - never allocates, never locks
+ */
+void recordViolation(RtViolationType type, const char *what);
+#endif
+} // namespace synth_io::rt_audit::detail
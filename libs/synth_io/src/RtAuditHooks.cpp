@@ -0,0 +1,351 @@
+#include "RtAuditDetail.h"
+
+#if SYNTH_RT_AUDIT
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Hooks for everything the audio thread must never call
+ * Each hook records (inside an RtSection only) and forwards to the real
+ * function, so an audit build behaves exactly like a normal one.
+ *
+ * macOS: dyld interposing (__DATA,__interpose), which dyld only applies
+ *        from dylibs: this TU is built as build/librtaudit.dylib and
+ *        inserted at launch (make rt-audit, see Makefile)
+ * Linux: same-name definitions in the executable; malloc family forwards
+ *        to glibc's __libc_* entry points (dlsym itself allocates), the
+ *        rest to the next definition (RTLD_NEXT)
+ *
+ * NOTE: mutex trylock and the lock-free queues are allowed, only calls that
+ * can wait are hooked
+ */
+namespace audit = synth_io::rt_audit;
+using ViolationType = audit::RtViolationType;
+using audit::detail::recordViolation;
+
+#if defined(__APPLE__)
+// ==== macOS: dyld interposing ====
+// The replacement calls the original by name (dyld never interposes the
+// interposing image itself)
+#define RT_AUDIT_INTERPOSE(replacement, replacee)                              \
+  __attribute__((used)) static struct {                                        \
+    const void *replacementFn;                                                 \
+    const void *replaceeFn;                                                    \
+  } interpose_##replacee __attribute__((section("__DATA,__interpose"))) = {    \
+      reinterpret_cast<const void *>(&replacement),                            \
+      reinterpret_cast<const void *>(&replacee)}
+
+namespace {
+// ==== Allocation ====
+void *auditMalloc(size_t size) {
+  recordViolation(ViolationType::Allocation, "malloc");
+  return malloc(size);
+}
+
+void *auditCalloc(size_t count, size_t size) {
+  recordViolation(ViolationType::Allocation, "calloc");
+  return calloc(count, size);
+}
+
+void *auditRealloc(void *ptr, size_t size) {
+  recordViolation(ViolationType::Allocation, "realloc");
+  return realloc(ptr, size);
+}
+
+int auditPosixMemalign(void **ptr, size_t alignment, size_t size) {
+  recordViolation(ViolationType::Allocation, "posix_memalign");
+  return posix_memalign(ptr, alignment, size);
+}
+
+void auditFree(void *ptr) {
+  if (ptr)
+    recordViolation(ViolationType::Deallocation, "free");
+  free(ptr);
+}
+
+// ==== Locks ====
+int auditMutexLock(pthread_mutex_t *mutex) {
+  recordViolation(ViolationType::Lock, "pthread_mutex_lock");
+  return pthread_mutex_lock(mutex);
+}
+
+int auditRwlockRdlock(pthread_rwlock_t *lock) {
+  recordViolation(ViolationType::Lock, "pthread_rwlock_rdlock");
+  return pthread_rwlock_rdlock(lock);
+}
+
+int auditRwlockWrlock(pthread_rwlock_t *lock) {
+  recordViolation(ViolationType::Lock, "pthread_rwlock_wrlock");
+  return pthread_rwlock_wrlock(lock);
+}
+
+int auditCondWait(pthread_cond_t *cond, pthread_mutex_t *mutex) {
+  recordViolation(ViolationType::Lock, "pthread_cond_wait");
+  return pthread_cond_wait(cond, mutex);
+}
+
+int auditCondTimedwait(pthread_cond_t *cond, pthread_mutex_t *mutex,
+                       const struct timespec *time) {
+  recordViolation(ViolationType::Lock, "pthread_cond_timedwait");
+  return pthread_cond_timedwait(cond, mutex, time);
+}
+
+// ==== Blocking calls ====
+int auditNanosleep(const struct timespec *request, struct timespec *remain) {
+  recordViolation(ViolationType::BlockingCall, "nanosleep");
+  return nanosleep(request, remain);
+}
+
+int auditUsleep(useconds_t usec) {
+  recordViolation(ViolationType::BlockingCall, "usleep");
+  return usleep(usec);
+}
+
+unsigned int auditSleep(unsigned int seconds) {
+  recordViolation(ViolationType::BlockingCall, "sleep");
+  return sleep(seconds);
+}
+
+int auditOpen(const char *path, int flags, ...) {
+  recordViolation(ViolationType::BlockingCall, "open");
+
+  mode_t mode = 0;
+  if (flags & O_CREAT) {
+    va_list args;
+    va_start(args, flags);
+    mode = static_cast<mode_t>(va_arg(args, int));
+    va_end(args);
+  }
+  return open(path, flags, mode);
+}
+
+ssize_t auditRead(int fd, void *buffer, size_t count) {
+  recordViolation(ViolationType::BlockingCall, "read");
+  return read(fd, buffer, count);
+}
+
+ssize_t auditWrite(int fd, const void *buffer, size_t count) {
+  recordViolation(ViolationType::BlockingCall, "write");
+  return write(fd, buffer, count);
+}
+
+int auditPrintf(const char *format, ...) {
+  recordViolation(ViolationType::BlockingCall, "printf");
+
+  va_list args;
+  va_start(args, format);
+  int result = vprintf(format, args);
+  va_end(args);
+  return result;
+}
+
+int auditFprintf(FILE *stream, const char *format, ...) {
+  recordViolation(ViolationType::BlockingCall, "fprintf");
+
+  va_list args;
+  va_start(args, format);
+  int result = vfprintf(stream, format, args);
+  va_end(args);
+  return result;
+}
+
+int auditPuts(const char *str) {
+  recordViolation(ViolationType::BlockingCall, "puts");
+  return puts(str);
+}
+} // namespace
+
+RT_AUDIT_INTERPOSE(auditMalloc, malloc);
+RT_AUDIT_INTERPOSE(auditCalloc, calloc);
+RT_AUDIT_INTERPOSE(auditRealloc, realloc);
+RT_AUDIT_INTERPOSE(auditPosixMemalign, posix_memalign);
+RT_AUDIT_INTERPOSE(auditFree, free);
+RT_AUDIT_INTERPOSE(auditMutexLock, pthread_mutex_lock);
+RT_AUDIT_INTERPOSE(auditRwlockRdlock, pthread_rwlock_rdlock);
+RT_AUDIT_INTERPOSE(auditRwlockWrlock, pthread_rwlock_wrlock);
+RT_AUDIT_INTERPOSE(auditCondWait, pthread_cond_wait);
+RT_AUDIT_INTERPOSE(auditCondTimedwait, pthread_cond_timedwait);
+RT_AUDIT_INTERPOSE(auditNanosleep, nanosleep);
+RT_AUDIT_INTERPOSE(auditUsleep, usleep);
+RT_AUDIT_INTERPOSE(auditSleep, sleep);
+RT_AUDIT_INTERPOSE(auditOpen, open);
+RT_AUDIT_INTERPOSE(auditRead, read);
+RT_AUDIT_INTERPOSE(auditWrite, write);
+RT_AUDIT_INTERPOSE(auditPrintf, printf);
+RT_AUDIT_INTERPOSE(auditFprintf, fprintf);
+RT_AUDIT_INTERPOSE(auditPuts, puts);
+
+#else
+// ==== Linux: symbol interposition ====
+#include <dlfcn.h>
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+}
+
+namespace {
+// Resolved on first call (outside the audio thread in practice: initRtAudit
+// and startup code hit most of them first)
+template <typename Fn> Fn nextSymbol(Fn &cached, const char *name) {
+  if (!cached)
+    cached = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name));
+  return cached;
+}
+} // namespace
+
+extern "C" {
+// ==== Allocation ====
+void *malloc(size_t size) noexcept {
+  recordViolation(ViolationType::Allocation, "malloc");
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) noexcept {
+  recordViolation(ViolationType::Allocation, "calloc");
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) noexcept {
+  recordViolation(ViolationType::Allocation, "realloc");
+  return __libc_realloc(ptr, size);
+}
+
+int posix_memalign(void **ptr, size_t alignment, size_t size) noexcept {
+  recordViolation(ViolationType::Allocation, "posix_memalign");
+  void *result = __libc_memalign(alignment, size);
+  if (!result)
+    return 12; // ENOMEM
+  *ptr = result;
+  return 0;
+}
+
+void *aligned_alloc(size_t alignment, size_t size) noexcept {
+  recordViolation(ViolationType::Allocation, "aligned_alloc");
+  return __libc_memalign(alignment, size);
+}
+
+void free(void *ptr) noexcept {
+  if (ptr)
+    recordViolation(ViolationType::Deallocation, "free");
+  __libc_free(ptr);
+}
+
+// ==== Locks ====
+int pthread_mutex_lock(pthread_mutex_t *mutex) noexcept {
+  static int (*next)(pthread_mutex_t *) = nullptr;
+  recordViolation(ViolationType::Lock, "pthread_mutex_lock");
+  return nextSymbol(next, "pthread_mutex_lock")(mutex);
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t *lock) noexcept {
+  static int (*next)(pthread_rwlock_t *) = nullptr;
+  recordViolation(ViolationType::Lock, "pthread_rwlock_rdlock");
+  return nextSymbol(next, "pthread_rwlock_rdlock")(lock);
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t *lock) noexcept {
+  static int (*next)(pthread_rwlock_t *) = nullptr;
+  recordViolation(ViolationType::Lock, "pthread_rwlock_wrlock");
+  return nextSymbol(next, "pthread_rwlock_wrlock")(lock);
+}
+
+int pthread_cond_wait(pthread_cond_t *cond, pthread_mutex_t *mutex) {
+  static int (*next)(pthread_cond_t *, pthread_mutex_t *) = nullptr;
+  recordViolation(ViolationType::Lock, "pthread_cond_wait");
+  return nextSymbol(next, "pthread_cond_wait")(cond, mutex);
+}
+
+int pthread_cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *mutex,
+                           const struct timespec *time) {
+  static int (*next)(pthread_cond_t *, pthread_mutex_t *,
+                     const struct timespec *) = nullptr;
+  recordViolation(ViolationType::Lock, "pthread_cond_timedwait");
+  return nextSymbol(next, "pthread_cond_timedwait")(cond, mutex, time);
+}
+
+// ==== Blocking calls ====
+int nanosleep(const struct timespec *request, struct timespec *remain) {
+  static int (*next)(const struct timespec *, struct timespec *) = nullptr;
+  recordViolation(ViolationType::BlockingCall, "nanosleep");
+  return nextSymbol(next, "nanosleep")(request, remain);
+}
+
+int usleep(useconds_t usec) {
+  static int (*next)(useconds_t) = nullptr;
+  recordViolation(ViolationType::BlockingCall, "usleep");
+  return nextSymbol(next, "usleep")(usec);
+}
+
+unsigned int sleep(unsigned int seconds) {
+  static unsigned int (*next)(unsigned int) = nullptr;
+  recordViolation(ViolationType::BlockingCall, "sleep");
+  return nextSymbol(next, "sleep")(seconds);
+}
+
+int open(const char *path, int flags, ...) {
+  static int (*next)(const char *, int, ...) = nullptr;
+  recordViolation(ViolationType::BlockingCall, "open");
+
+  mode_t mode = 0;
+  if (flags & O_CREAT) {
+    va_list args;
+    va_start(args, flags);
+    mode = static_cast<mode_t>(va_arg(args, int));
+    va_end(args);
+  }
+  return nextSymbol(next, "open")(path, flags, mode);
+}
+
+ssize_t read(int fd, void *buffer, size_t count) {
+  static ssize_t (*next)(int, void *, size_t) = nullptr;
+  recordViolation(ViolationType::BlockingCall, "read");
+  return nextSymbol(next, "read")(fd, buffer, count);
+}
+
+ssize_t write(int fd, const void *buffer, size_t count) {
+  static ssize_t (*next)(int, const void *, size_t) = nullptr;
+  recordViolation(ViolationType::BlockingCall, "write");
+  return nextSymbol(next, "write")(fd, buffer, count);
+}
+
+// glibc's stdio writes through its own internal write (never the hook above)
+int printf(const char *format, ...) {
+  recordViolation(ViolationType::BlockingCall, "printf");
+
+  va_list args;
+  va_start(args, format);
+  int result = vprintf(format, args);
+  va_end(args);
+  return result;
+}
+
+int fprintf(FILE *stream, const char *format, ...) {
+  recordViolation(ViolationType::BlockingCall, "fprintf");
+
+  va_list args;
+  va_start(args, format);
+  int result = vfprintf(stream, format, args);
+  va_end(args);
+  return result;
+}
+
+int puts(const char *str) {
+  static int (*next)(const char *) = nullptr;
+  recordViolation(ViolationType::BlockingCall, "puts");
+  return nextSymbol(next, "puts")(str);
+}
+} // extern "C"
+#endif
+
+#endif // SYNTH_RT_AUDIT
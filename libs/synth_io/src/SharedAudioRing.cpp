@@ -0,0 +1,159 @@
+#include "SharedAudioRing.h"
+
+#include "synth_io/Trace.h"
+
+#include "audio_io/AudioIOTypes.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <thread>
+
+namespace synth_io {
+using AudioBuffer = audio_io::AudioBuffer;
+
+// ==== <Ring Helpers> ====
+namespace {
+
+float *getSamples(SharedAudioHeader &header) {
+  return reinterpret_cast<float *>(&header + 1);
+}
+
+// Interleaved buffers: one memcpy (two where the ring wraps)
+void copyIntoRing(SharedAudioHeader &header, uint64_t start, const float *src,
+                  uint32_t numFrames) {
+  float *samples = getSamples(header);
+  uint32_t numChannels = header.numChannels;
+
+  auto first = static_cast<uint32_t>(start % header.capacityFrames);
+  uint32_t headFrames = header.capacityFrames - first;
+  if (headFrames > numFrames)
+    headFrames = numFrames;
+
+  std::memcpy(samples + first * numChannels, src,
+              headFrames * numChannels * sizeof(float));
+  std::memcpy(samples, src + headFrames * numChannels,
+              (numFrames - headFrames) * numChannels * sizeof(float));
+}
+
+// Planar buffers interleave straight into the ring (no temp buffer)
+void interleaveIntoRing(SharedAudioHeader &header, uint64_t start,
+                        float *const *channelPtrs, uint32_t numFrames) {
+  float *samples = getSamples(header);
+  uint32_t numChannels = header.numChannels;
+  auto frame = static_cast<uint32_t>(start % header.capacityFrames);
+
+  for (uint32_t i = 0; i < numFrames; i++) {
+    float *dst = samples + frame * numChannels;
+    for (uint32_t ch = 0; ch < numChannels; ch++)
+      dst[ch] = channelPtrs[ch][i];
+
+    if (++frame == header.capacityFrames)
+      frame = 0;
+  }
+}
+
+} // namespace
+// ==== </Ring Helpers> ====
+
+void SharedAudioRing::write(const AudioBuffer &buffer) {
+  if (!header.load(std::memory_order_relaxed))
+    return;
+
+  SYNTH_TRACE_SCOPE("writeSharedAudio");
+
+  // seq_cst pairs with unpublish: either it sees isWriting, or this pass
+  // sees the cleared header
+  isWriting.store(true, std::memory_order_seq_cst);
+
+  SharedAudioHeader *ring = header.load(std::memory_order_seq_cst);
+  if (ring && buffer.numChannels == ring->numChannels &&
+      buffer.numFrames <= ring->capacityFrames) {
+    uint64_t writeFrame = ring->writeFrame.load(std::memory_order_relaxed);
+    uint64_t endFrame = writeFrame + buffer.numFrames;
+
+    // Readers check reserveFrame after copying (seqlock): announce the
+    // overwrite before touching the slots
+    ring->reserveFrame.store(endFrame, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (buffer.format == audio_io::BufferFormat::Interleaved)
+      copyIntoRing(*ring, writeFrame, buffer.interleavedPtr, buffer.numFrames);
+    else
+      interleaveIntoRing(*ring, writeFrame, buffer.channelPtrs,
+                         buffer.numFrames);
+
+    ring->writeFrame.store(endFrame, std::memory_order_release);
+  }
+
+  isWriting.store(false, std::memory_order_release);
+}
+
+bool SharedAudioRing::publish(const char *ringName, uint32_t capacityFrames,
+                              uint32_t sampleRate, uint32_t numChannels) {
+  if (header.load(std::memory_order_relaxed) || capacityFrames == 0 ||
+      numChannels == 0)
+    return false;
+
+  // POSIX names are "/name"
+  int length = std::snprintf(name, sizeof(name), "%s%s",
+                             ringName[0] == '/' ? "" : "/", ringName);
+  if (length <= 1 || static_cast<size_t>(length) >= sizeof(name)) {
+    printf("Shared audio: invalid name '%s'\n", ringName);
+    return false;
+  }
+
+  int fd = shm_open(name, O_CREAT | O_RDWR, 0600);
+  if (fd < 0) {
+    printf("Shared audio: unable to open '%s'\n", name);
+    return false;
+  }
+
+  size_t numBytes = getSharedAudioBytes(capacityFrames, numChannels);
+  void *mapped = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(numBytes)) == 0)
+    mapped = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (mapped == MAP_FAILED) {
+    printf("Shared audio: unable to map %zu bytes at '%s'\n", numBytes, name);
+    shm_unlink(name);
+    return false;
+  }
+
+  // Fresh header (a stale ring under the same name is reset), then
+  // pre-fault the sample pages so the audio thread never page faults
+  std::memset(mapped, 0, numBytes);
+  auto *ring = new (mapped) SharedAudioHeader();
+  ring->sampleRate = sampleRate;
+  ring->numChannels = numChannels;
+  ring->capacityFrames = capacityFrames;
+  ring->isLive.store(1, std::memory_order_release);
+
+  mappedBytes = numBytes;
+  header.store(ring, std::memory_order_seq_cst);
+  return true;
+}
+
+void SharedAudioRing::unpublish() {
+  SharedAudioHeader *ring = header.exchange(nullptr, std::memory_order_seq_cst);
+  if (!ring)
+    return;
+
+  // At most one callback's worth of copying
+  while (isWriting.load(std::memory_order_seq_cst))
+    std::this_thread::yield();
+
+  ring->isLive.store(0, std::memory_order_release);
+  shm_unlink(name);
+  munmap(ring, mappedBytes);
+  mappedBytes = 0;
+}
+
+} // namespace synth_io
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "synth_io/SharedAudio.h"
+
+#include "audio_io/AudioIOTypes.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace synth_io {
+
+inline constexpr size_t MAX_SHARED_AUDIO_NAME = 64;
+
+/* The session's shared-memory ring (see synth_io/SharedAudio.h)
+ * - publish/unpublish: any non-real-time thread
+ * - write: audio thread, once per callback (one relaxed load when nothing
+ *   is published)
+ */
+struct SharedAudioRing {
+  std::atomic<SharedAudioHeader *> header{nullptr};
+  size_t mappedBytes = 0;
+  char name[MAX_SHARED_AUDIO_NAME] = {};
+
+  // Set by the audio thread while it writes; unpublish waits on it before
+  // unmapping (same handshake as OutputTapSet)
+  std::atomic<bool> isWriting{false};
+
+  // Audio thread
+  void write(const audio_io::AudioBuffer &buffer);
+
+  // Any thread
+  bool publish(const char *ringName, uint32_t capacityFrames,
+               uint32_t sampleRate, uint32_t numChannels);
+  void unpublish();
+};
+
+} // namespace synth_io
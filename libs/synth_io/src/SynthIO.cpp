@@ -1,12 +1,26 @@
 #include "synth_io/SynthIO.h"
 
+#include "ControllerStore.h"
+#include "DspLoadMeter.h"
+#include "EventBatchQueue.h"
+#include "EventTelemetryMeter.h"
+#include "EventTimeline.h"
+#include "LatencyProbe.h"
 #include "NoteEventQueue.h"
+#include "OutputTap.h"
 #include "ParamEventQueue.h"
+#include "ParamStore.h"
+#include "SharedAudioRing.h"
+
+#include "synth_io/RtAudit.h"
+#include "synth_io/Trace.h"
 
 #include "audio_io/AudioIO.h"
 #include "audio_io/AudioIOTypes.h"
 #include "audio_io/AudioIOTypesFwd.h"
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 
@@ -17,51 +31,223 @@ using hAudioSession = audio_io::hAudioSession;
 struct SynthSession {
   NoteEventQueue noteEventQueue{};
   ParamEventQueue paramEventQueue{};
+  EventBatchQueue eventBatchQueue{};
+  EventTimeline eventTimeline{};
+  ParamStore paramStore{};
+  ControllerStore controllerStore{};
+
+  DspLoadMeter loadMeter{};
+  EventTelemetryMeter eventTelemetry{};
+  OutputTapSet outputTaps{};
+  SharedAudioRing sharedAudio{};
+  LatencyProbe latencyProbe{};
+  uint16_t numChannels = DEFAULT_CHANNELS;
+  double sampleRate = DEFAULT_SAMPLE_RATE;
+  double invSampleRate = 1.0 / DEFAULT_SAMPLE_RATE;
+  bool isSampleAccurate = true;
+  bool isParamCoalesced = false;
+  bool isLatencyProbeEnabled = false;
 
   AudioBufferHandler processAudioBlock;
 
   NoteEventHandler processNoteEvent;
   ParamEventHandler processParamEvent;
+  ControllerEventHandler processControllerEvent;
 
   hAudioSession audioSession;
   void *userContext;
 };
 using hSynthSession = SynthSession *;
 
+/* Map an event timestamp into the buffer about to render
+ * Events produced during the last buffer period land at the same relative
+ * position in this buffer (one buffer of fixed latency instead of up to one
+ * buffer of jitter). Older/unstamped events land on frame 0.
+ */
+static uint32_t toFrameOffset(const SynthSession &session, uint64_t timestamp,
+                              uint64_t callbackTime, uint32_t numFrames) {
+  if (!session.isSampleAccurate || timestamp == 0 || numFrames == 0)
+    return 0;
+
+  uint64_t windowNs = static_cast<uint64_t>(
+      static_cast<double>(numFrames) * session.invSampleRate * 1.0e9);
+  uint64_t windowStart = callbackTime > windowNs ? callbackTime - windowNs : 0;
+
+  if (timestamp <= windowStart)
+    return 0;
+
+  auto frame = static_cast<uint32_t>(static_cast<double>(timestamp - windowStart) *
+                                     session.sampleRate * 1.0e-9);
+  return frame < numFrames ? frame : numFrames - 1;
+}
+
+// Every event of _batch_ at the batch's frame. Returns the events applied
+static uint32_t applyEventBatch(SynthSession &session, const EventBatch &batch,
+                                uint64_t callbackTime, uint32_t numFrames) {
+  uint32_t frameOffset =
+      toFrameOffset(session, batch.timestamp, callbackTime, numFrames);
+
+  for (uint32_t i = 0; i < batch.paramCount; i++) {
+    ParamEvent paramEvent = batch.params[i];
+    paramEvent.frameOffset = frameOffset;
+    session.processParamEvent(paramEvent, session.userContext);
+  }
+
+  for (uint32_t i = 0; i < batch.noteCount; i++) {
+    NoteEvent noteEvent = batch.notes[i];
+    noteEvent.frameOffset = frameOffset;
+    noteEvent.timestamp = batch.timestamp;
+    if (session.isLatencyProbeEnabled &&
+        noteEvent.type == NoteEventType::NoteOn)
+      session.latencyProbe.open(noteEvent, callbackTime);
+    session.processNoteEvent(noteEvent, session.userContext);
+  }
+
+  return batch.paramCount + batch.noteCount;
+}
+
 static void audioCallback(AudioBuffer buffer, void *context) {
   auto *ctx = static_cast<SynthSession *>(context);
 
+  // RT_AUDIT builds: no allocation/lock/blocking call until we return
+  rt_audit::ScopedRtSection rtSection;
+  SYNTH_TRACE_SCOPE("audioCallback");
+  trace::setTraceThreadName("audio");
+
+  // steady_clock is a plain counter read (mach_absolute_time on macOS)
+  auto startTime = std::chrono::steady_clock::now();
+  uint64_t callbackTime = getEventTimestamp();
+
+  // Drained per source (telemetry): queued notes/params, batches, the rest
+  // (coalesced stores, batch events)
+  uint32_t noteEvents = 0;
+  uint32_t paramEvents = 0;
+  uint32_t batches = 0;
+  uint32_t otherEvents = 0;
+
   if (ctx->processParamEvent) {
+    SYNTH_TRACE_SCOPE("drainParamEvents");
+    // storeParam fills the store either way, setParam only when coalescing
+    // (the queue stays empty then). A clean store is 4 loads
+    otherEvents += ctx->paramStore.drain([ctx](const ParamEvent &paramEvent) {
+      ctx->processParamEvent(paramEvent, ctx->userContext);
+    });
+
     ParamEvent paramEvent;
     while (ctx->paramEventQueue.pop(paramEvent)) {
+      paramEvent.frameOffset = toFrameOffset(*ctx, paramEvent.timestamp,
+                                             callbackTime, buffer.numFrames);
       ctx->processParamEvent(paramEvent, ctx->userContext);
+      paramEvents++;
     }
   }
 
+  if (ctx->processControllerEvent) {
+    SYNTH_TRACE_SCOPE("drainControllerEvents");
+    otherEvents += ctx->controllerStore.drain(
+        [ctx](const ControllerEvent &controllerEvent) {
+          ctx->processControllerEvent(controllerEvent, ctx->userContext);
+        });
+  }
+
+  // Batches between the queues: whole, after loose params (scene changes
+  // win over knob moves in the same buffer), before loose notes
+  if (ctx->processParamEvent && ctx->processNoteEvent) {
+    SYNTH_TRACE_SCOPE("drainEventBatches");
+    auto applyBatch = [ctx, callbackTime, &buffer,
+                       &otherEvents](const EventBatch &batch) {
+      otherEvents +=
+          applyEventBatch(*ctx, batch, callbackTime, buffer.numFrames);
+    };
+    while (ctx->eventBatchQueue.consume(applyBatch))
+      batches++;
+  }
+
+  // Timeline: pre-placed events (scripts), already frame exact
+  uint64_t streamFrame =
+      ctx->eventTimeline.streamFrame.load(std::memory_order_relaxed);
+  if (ctx->processParamEvent && ctx->processNoteEvent) {
+    SYNTH_TRACE_SCOPE("drainEventTimeline");
+    otherEvents += ctx->eventTimeline.drain(
+        streamFrame, buffer.numFrames,
+        [ctx](const TimelineEvent &event, uint32_t frameOffset) {
+          if (event.type == TimelineEventType::Param) {
+            ParamEvent paramEvent = event.param;
+            paramEvent.frameOffset = frameOffset;
+            ctx->processParamEvent(paramEvent, ctx->userContext);
+            return;
+          }
+
+          NoteEvent noteEvent = event.note;
+          noteEvent.frameOffset = frameOffset;
+          ctx->processNoteEvent(noteEvent, ctx->userContext);
+        });
+  }
+
   if (ctx->processNoteEvent) {
+    SYNTH_TRACE_SCOPE("drainNoteEvents");
     NoteEvent noteEvent;
     while (ctx->noteEventQueue.pop(noteEvent)) {
+      noteEvents++;
+      noteEvent.frameOffset = toFrameOffset(*ctx, noteEvent.timestamp,
+                                            callbackTime, buffer.numFrames);
+      if (ctx->isLatencyProbeEnabled &&
+          noteEvent.type == NoteEventType::NoteOn)
+        ctx->latencyProbe.open(noteEvent, callbackTime);
       ctx->processNoteEvent(noteEvent, ctx->userContext);
     }
   }
 
   if (ctx->processAudioBlock) {
+    SYNTH_TRACE_SCOPE("processAudioBlock");
     ctx->processAudioBlock(buffer.channelPtrs, buffer.numChannels,
                            buffer.numFrames, ctx->userContext);
   }
+
+  if (ctx->isLatencyProbeEnabled) {
+    SYNTH_TRACE_SCOPE("latencyProbe");
+    ctx->latencyProbe.scan(buffer, ctx->sampleRate, callbackTime);
+  }
+
+  ctx->outputTaps.write(buffer);
+  ctx->sharedAudio.write(buffer);
+  ctx->eventTimeline.streamFrame.store(streamFrame + buffer.numFrames,
+                                       std::memory_order_release);
+  ctx->eventTelemetry.record(noteEvents, paramEvents, batches, otherEvents);
+
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - startTime;
+  ctx->loadMeter.record(elapsed.count(), buffer.numFrames * ctx->invSampleRate);
 }
 
 // ==== PUBLIC APIS ====
 
+uint64_t getEventTimestamp() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
 // ==== Session Handlers ====
 hSynthSession initSession(SessionConfig userConfig,
                           SynthCallbacks userCallbacks, void *userContext) {
 
+  rt_audit::initRtAudit();
+  trace::startTraceWriter();
+
   hSynthSession sessionPtr = new SynthSession();
   sessionPtr->processParamEvent = userCallbacks.processParamEvent;
   sessionPtr->processNoteEvent = userCallbacks.processNoteEvent;
   sessionPtr->processAudioBlock = userCallbacks.processAudioBlock;
+  sessionPtr->processControllerEvent = userCallbacks.processControllerEvent;
   sessionPtr->userContext = userContext;
+  sessionPtr->sampleRate = userConfig.sampleRate;
+  sessionPtr->numChannels = userConfig.numChannels;
+  sessionPtr->invSampleRate = 1.0 / userConfig.sampleRate;
+  sessionPtr->isSampleAccurate = userConfig.isSampleAccurate;
+  sessionPtr->isParamCoalesced = userConfig.isParamCoalesced;
+  sessionPtr->isLatencyProbeEnabled = userConfig.isLatencyProbeEnabled;
 
   // 2. Setup audio_io
   audio_io::Config config{};
@@ -70,6 +256,14 @@ hSynthSession initSession(SessionConfig userConfig,
   config.numFrames = userConfig.numFrames;
   config.bufferFormat =
       static_cast<audio_io::BufferFormat>(userConfig.bufferFormat);
+  config.deviceId = userConfig.deviceId;
+
+  if (userConfig.nullOutput.isEnabled) {
+    config.backend = audio_io::Backend::Null;
+    config.nullOptions.isPaced = userConfig.nullOutput.isPaced;
+    config.nullOptions.lengthFrames = userConfig.nullOutput.lengthFrames;
+    config.nullOptions.outputPath = userConfig.nullOutput.outputPath;
+  }
 
   sessionPtr->audioSession =
       audio_io::setupAudioSession(config, audioCallback, sessionPtr);
@@ -92,28 +286,174 @@ int disposeSession(hSynthSession sessionPtr) {
     return 1;
   }
 
+  sessionPtr->outputTaps.detachAll();
+  sessionPtr->sharedAudio.unpublish();
   delete sessionPtr;
+  trace::stopTraceWriter();
 
   return 0;
 }
 
+OutputLatency getOutputLatency(hSynthSession sessionPtr) {
+  audio_io::DeviceLatency device =
+      audio_io::getDeviceLatency(sessionPtr->audioSession);
+
+  OutputLatency latency{};
+  latency.sampleRate = device.sampleRate;
+  latency.bufferFrames = device.bufferFrames;
+  latency.deviceFrames = device.deviceFrames + device.streamFrames;
+  latency.safetyOffsetFrames = device.safetyOffsetFrames;
+  latency.totalSeconds = device.totalSeconds;
+  return latency;
+}
+
+CallbackStats getCallbackStats(hSynthSession sessionPtr) {
+  audio_io::CallbackStats audio =
+      audio_io::getCallbackStats(sessionPtr->audioSession);
+
+  CallbackStats stats{};
+  stats.callbackCount = audio.callbackCount;
+  stats.framesRendered = audio.framesRendered;
+  stats.streamSeconds = audio.streamSeconds;
+  stats.wallSeconds = audio.wallSeconds;
+  stats.averageCallbackUs = audio.averageCallbackUs;
+  stats.maxCallbackUs = audio.maxCallbackUs;
+  stats.lateCount = audio.lateCount;
+  stats.isFinished = audio.isFinished;
+  return stats;
+}
+
+// ==== Audio Workgroup ====
+void *joinAudioWorkgroup(hSynthSession sessionPtr) {
+  return audio_io::joinAudioWorkgroup(sessionPtr->audioSession);
+}
+
+void leaveAudioWorkgroup(void *membership) {
+  audio_io::leaveAudioWorkgroup(
+      static_cast<audio_io::hWorkgroupMembership>(membership));
+}
+
 // ==== Note Event Handlers ====
-bool noteOn(hSynthSession sessionPtr, uint8_t midiNote, uint8_t velocity) {
+bool noteOn(hSynthSession sessionPtr, uint8_t midiNote, uint8_t velocity,
+            uint8_t channel) {
   // TODO(nico): replicate emplace_back() to reduce copy;
-  return sessionPtr->noteEventQueue.push(
-      {NoteEventType::NoteOn, midiNote, velocity});
+  return sessionPtr->noteEventQueue.push({NoteEventType::NoteOn, midiNote,
+                                          velocity, 0, getEventTimestamp(),
+                                          channel});
 }
 
-bool noteOff(hSynthSession sessionPtr, uint8_t midiNote, uint8_t velocity) {
+bool noteOff(hSynthSession sessionPtr, uint8_t midiNote, uint8_t velocity,
+             uint8_t channel) {
   // TODO(nico): replicate emplace_back() to reduce copy;
-  return sessionPtr->noteEventQueue.push(
-      {NoteEventType::NoteOff, midiNote, velocity});
+  return sessionPtr->noteEventQueue.push({NoteEventType::NoteOff, midiNote,
+                                          velocity, 0, getEventTimestamp(),
+                                          channel});
 }
 
 // ==== Parameter Event Handlers ====
 bool setParam(hSynthSession sessionPtr, uint8_t id, float value) {
+  if (sessionPtr->isParamCoalesced) {
+    sessionPtr->paramStore.store(id, value);
+    return true;
+  }
+
   // TODO(nico): replicate emplace_back() to reduce copy;
-  return sessionPtr->paramEventQueue.push({id, value});
+  return sessionPtr->paramEventQueue.push({id, value, 0, getEventTimestamp()});
+}
+
+void storeParam(hSynthSession sessionPtr, uint8_t id, float value) {
+  sessionPtr->paramStore.store(id, value);
+}
+
+// ==== Controller Event Handlers ====
+void setController(hSynthSession sessionPtr, uint16_t id, float value) {
+  sessionPtr->controllerStore.store(id, value);
+}
+
+// ==== Event Batches ====
+bool sendEventBatch(hSynthSession sessionPtr, const EventBatch &batch) {
+  if (batch.paramCount > MAX_BATCH_PARAMS || batch.noteCount > MAX_BATCH_NOTES)
+    return false;
+
+  EventBatch stamped = batch;
+  stamped.timestamp = getEventTimestamp();
+  return sessionPtr->eventBatchQueue.push(stamped);
+}
+
+// ==== Event Timeline ====
+uint64_t getStreamFrame(hSynthSession sessionPtr) {
+  return sessionPtr->eventTimeline.streamFrame.load(std::memory_order_acquire);
+}
+
+bool writeTimelineBlock(hSynthSession sessionPtr, uint64_t blockIndex,
+                        const TimelineEvent *events, uint32_t numEvents) {
+  return sessionPtr->eventTimeline.write(blockIndex, events, numEvents);
+}
+
+// ==== DSP Load ====
+DspLoadStats getDspLoadStats(hSynthSession sessionPtr) {
+  return sessionPtr->loadMeter.read();
+}
+
+void resetDspLoadStats(hSynthSession sessionPtr) {
+  sessionPtr->loadMeter.requestReset();
+}
+
+// ==== Latency Probe ====
+LatencyStats getLatencyStats(hSynthSession sessionPtr) {
+  return sessionPtr->latencyProbe.read();
+}
+
+void resetLatencyStats(hSynthSession sessionPtr) {
+  sessionPtr->latencyProbe.requestReset();
+}
+
+// ==== Event Telemetry ====
+EventTelemetry getEventTelemetry(hSynthSession sessionPtr) {
+  EventTelemetry telemetry = sessionPtr->eventTelemetry.read();
+
+  telemetry.noteQueue.capacity = static_cast<uint32_t>(NoteEventQueue::SIZE);
+  telemetry.noteQueue.droppedCount =
+      sessionPtr->noteEventQueue.droppedCount.load(std::memory_order_relaxed);
+  telemetry.paramQueue.capacity =
+      static_cast<uint32_t>(ParamEventQueue::SIZE);
+  telemetry.paramQueue.droppedCount =
+      sessionPtr->paramEventQueue.droppedCount.load(std::memory_order_relaxed);
+  telemetry.batchQueue.capacity =
+      static_cast<uint32_t>(EventBatchQueue::SIZE);
+  telemetry.batchQueue.droppedCount =
+      sessionPtr->eventBatchQueue.droppedCount.load(std::memory_order_relaxed);
+  return telemetry;
+}
+
+void resetEventTelemetry(hSynthSession sessionPtr) {
+  // Producer counters: a drop racing the reset may survive it (harmless)
+  sessionPtr->noteEventQueue.droppedCount.store(0, std::memory_order_relaxed);
+  sessionPtr->paramEventQueue.droppedCount.store(0, std::memory_order_relaxed);
+  sessionPtr->eventBatchQueue.droppedCount.store(0, std::memory_order_relaxed);
+  sessionPtr->eventTelemetry.requestReset();
+}
+
+// ==== Output Taps ====
+hOutputTap attachOutputTap(hSynthSession sessionPtr, uint32_t capacityFrames) {
+  return sessionPtr->outputTaps.attach(capacityFrames,
+                                       sessionPtr->numChannels);
+}
+
+void detachOutputTap(hSynthSession sessionPtr, hOutputTap tap) {
+  sessionPtr->outputTaps.detach(tap);
+}
+
+// ==== Shared Audio ====
+bool publishSharedAudio(hSynthSession sessionPtr, const char *name,
+                        uint32_t capacityFrames) {
+  return sessionPtr->sharedAudio.publish(
+      name, capacityFrames, static_cast<uint32_t>(sessionPtr->sampleRate),
+      sessionPtr->numChannels);
+}
+
+void unpublishSharedAudio(hSynthSession sessionPtr) {
+  sessionPtr->sharedAudio.unpublish();
 }
 
 } // namespace synth_io
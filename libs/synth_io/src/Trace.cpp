@@ -0,0 +1,312 @@
+#include "synth_io/Trace.h"
+
+#if SYNTH_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+
+namespace synth_io::trace {
+using SteadyClock = std::chrono::steady_clock;
+
+// ==== <Trace Helpers> ====
+namespace {
+constexpr uint32_t RING_MASK = TRACE_RING_CAPACITY - 1;
+static_assert((TRACE_RING_CAPACITY & RING_MASK) == 0,
+              "TRACE_RING_CAPACITY must be a power of 2");
+
+struct TraceEvent {
+  const char *name;
+  uint64_t startTicks;
+  uint64_t endTicks;
+};
+
+/* Single producer (the owning thread) / single consumer (the writer)
+ * - writeIndex/readIndex only grow (wrap at 2^32, differences stay valid)
+ * - the producer caches readIndex: it only touches the writer's cache line
+ *   when the ring looks full
+ */
+struct alignas(64) TraceRing {
+  std::atomic<uint32_t> writeIndex{0};
+  uint32_t cachedReadIndex = 0; // producer only
+  std::atomic<uint64_t> droppedCount{0};
+  std::atomic<const char *> threadName{nullptr};
+
+  alignas(64) std::atomic<uint32_t> readIndex{0};
+
+  TraceEvent events[TRACE_RING_CAPACITY];
+};
+
+// Writer side copy (ring index doubles as the Chrome trace tid)
+struct TraceRecord {
+  TraceEvent event;
+  uint32_t threadIndex;
+};
+
+// ==== Thread rings ====
+// Claimed once per thread (fetch_add), never released: threads that come
+// and go (device restarts) use up slots, extra threads record nothing
+TraceRing traceRings[MAX_TRACE_THREADS];
+std::atomic<uint32_t> claimedRingCount{0};
+
+// TraceRing * of the calling thread (created before main: threads can
+// name themselves before the writer starts)
+pthread_key_t ringKey;
+const bool isKeyCreated = pthread_key_create(&ringKey, nullptr) == 0;
+
+std::atomic<bool> isTracing{false};
+
+// ==== Writer state ====
+struct TraceWriter {
+  std::thread thread{};
+  std::mutex mutex{};
+  std::condition_variable wake{};
+  bool isRunning = false;    // guarded by mutex
+  std::string pendingPath{}; // guarded by mutex
+
+  // Writer thread only
+  std::vector<TraceRecord> history{};
+  uint32_t historyHead = 0; // next slot to overwrite
+  uint32_t historyCount = 0;
+
+  // Tick -> time: measured against steady_clock between start and dump
+  uint64_t startTicks = 0;
+  SteadyClock::time_point startTime{};
+
+  std::atomic<uint32_t> historySize{0};
+  std::atomic<uint32_t> dumpCount{0};
+};
+
+TraceWriter writer{};
+
+TraceRing *claimRing() {
+  if (claimedRingCount.load(std::memory_order_relaxed) >= MAX_TRACE_THREADS)
+    return nullptr;
+
+  uint32_t index = claimedRingCount.fetch_add(1, std::memory_order_relaxed);
+  if (index >= MAX_TRACE_THREADS)
+    return nullptr;
+
+  TraceRing *ring = &traceRings[index];
+  pthread_setspecific(ringKey, ring);
+  return ring;
+}
+
+TraceRing *getThreadRing() {
+  if (!isKeyCreated)
+    return nullptr;
+
+  auto *ring = static_cast<TraceRing *>(pthread_getspecific(ringKey));
+  return ring ? ring : claimRing();
+}
+
+uint32_t getRingCount() {
+  uint32_t count = claimedRingCount.load(std::memory_order_acquire);
+  return count < MAX_TRACE_THREADS ? count : MAX_TRACE_THREADS;
+}
+
+void appendHistory(const TraceEvent &event, uint32_t threadIndex) {
+  writer.history[writer.historyHead] = {event, threadIndex};
+  writer.historyHead = (writer.historyHead + 1) % TRACE_HISTORY_EVENTS;
+  if (writer.historyCount < TRACE_HISTORY_EVENTS)
+    writer.historyCount++;
+}
+
+void drainRings() {
+  uint32_t ringCount = getRingCount();
+
+  for (uint32_t i = 0; i < ringCount; i++) {
+    TraceRing &ring = traceRings[i];
+    uint32_t read = ring.readIndex.load(std::memory_order_relaxed);
+    uint32_t write = ring.writeIndex.load(std::memory_order_acquire);
+
+    for (; read != write; read++)
+      appendHistory(ring.events[read & RING_MASK], i);
+
+    ring.readIndex.store(read, std::memory_order_release);
+  }
+
+  writer.historySize.store(writer.historyCount, std::memory_order_relaxed);
+}
+
+// ==== Chrome trace JSON ====
+// {"traceEvents": [...]}: one "X" (complete) event per scope, ts/dur in us
+bool writeChromeTrace(const char *path) {
+  FILE *file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Trace: unable to open %s\n", path);
+    return false;
+  }
+
+  // Ticks per microsecond over the whole session so far
+  std::chrono::duration<double, std::micro> elapsed =
+      SteadyClock::now() - writer.startTime;
+  uint64_t elapsedTicks = readTraceClock() - writer.startTicks;
+  double ticksPerUs = elapsed.count() > 0.0
+                          ? static_cast<double>(elapsedTicks) / elapsed.count()
+                          : 1.0;
+
+  fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+  uint32_t ringCount = getRingCount();
+  for (uint32_t i = 0; i < ringCount; i++) {
+    const char *name = traceRings[i].threadName.load(std::memory_order_relaxed);
+    fprintf(file,
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+            "\"args\":{\"name\":\"%s\"}},\n",
+            i, name ? name : "thread");
+  }
+
+  // Oldest first
+  uint32_t first = (writer.historyHead + TRACE_HISTORY_EVENTS -
+                    writer.historyCount) % TRACE_HISTORY_EVENTS;
+  for (uint32_t n = 0; n < writer.historyCount; n++) {
+    const TraceRecord &record =
+        writer.history[(first + n) % TRACE_HISTORY_EVENTS];
+    const TraceEvent &event = record.event;
+
+    // Events from before startTraceWriter (shouldn't happen) clamp to 0
+    uint64_t start = event.startTicks > writer.startTicks
+                         ? event.startTicks - writer.startTicks
+                         : 0;
+    uint64_t duration =
+        event.endTicks > event.startTicks ? event.endTicks - event.startTicks
+                                          : 0;
+
+    fprintf(file,
+            "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+            "\"ts\":%.3f,\"dur\":%.3f}%s\n",
+            event.name, record.threadIndex,
+            static_cast<double>(start) / ticksPerUs,
+            static_cast<double>(duration) / ticksPerUs,
+            n + 1 < writer.historyCount ? "," : "");
+  }
+
+  fprintf(file, "]}\n");
+  fclose(file);
+
+  printf("Trace: wrote %u events to %s\n", writer.historyCount, path);
+  return true;
+}
+
+void writerLoop() {
+  std::unique_lock<std::mutex> lock(writer.mutex);
+
+  while (writer.isRunning) {
+    writer.wake.wait_for(lock, std::chrono::milliseconds(TRACE_DRAIN_MS));
+
+    std::string path;
+    path.swap(writer.pendingPath);
+
+    // Producers never wait on this lock, only dump requests/stop do
+    lock.unlock();
+    drainRings();
+    if (!path.empty() && writeChromeTrace(path.c_str()))
+      writer.dumpCount.fetch_add(1, std::memory_order_relaxed);
+    lock.lock();
+  }
+}
+
+} // namespace
+// ==== </Trace Helpers> ====
+
+namespace detail {
+
+void recordTraceEvent(const char *name, uint64_t startTicks,
+                      uint64_t endTicks) {
+  if (!isTracing.load(std::memory_order_relaxed))
+    return;
+
+  TraceRing *ring = getThreadRing();
+  if (!ring)
+    return;
+
+  uint32_t write = ring->writeIndex.load(std::memory_order_relaxed);
+  if (write - ring->cachedReadIndex >= TRACE_RING_CAPACITY) {
+    ring->cachedReadIndex = ring->readIndex.load(std::memory_order_acquire);
+
+    if (write - ring->cachedReadIndex >= TRACE_RING_CAPACITY) {
+      // Single producer: no read-modify-write needed
+      ring->droppedCount.store(
+          ring->droppedCount.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed);
+      return;
+    }
+  }
+
+  ring->events[write & RING_MASK] = {name, startTicks, endTicks};
+  ring->writeIndex.store(write + 1, std::memory_order_release);
+}
+
+} // namespace detail
+
+void setTraceThreadName(const char *name) {
+  if (TraceRing *ring = getThreadRing())
+    ring->threadName.store(name, std::memory_order_relaxed);
+}
+
+void startTraceWriter() {
+  if (writer.thread.joinable() || !isKeyCreated)
+    return;
+
+  writer.history.resize(TRACE_HISTORY_EVENTS);
+  writer.historyHead = 0;
+  writer.historyCount = 0;
+  writer.startTicks = readTraceClock();
+  writer.startTime = SteadyClock::now();
+  writer.isRunning = true;
+  writer.thread = std::thread(writerLoop);
+
+  isTracing.store(true, std::memory_order_release);
+}
+
+void stopTraceWriter() {
+  if (!writer.thread.joinable())
+    return;
+
+  isTracing.store(false, std::memory_order_relaxed);
+
+  {
+    std::lock_guard<std::mutex> lock(writer.mutex);
+    writer.isRunning = false;
+  }
+  writer.wake.notify_one();
+  writer.thread.join();
+}
+
+bool requestTraceDump(const char *path) {
+  {
+    std::lock_guard<std::mutex> lock(writer.mutex);
+    if (!writer.isRunning)
+      return false;
+    writer.pendingPath = path;
+  }
+
+  writer.wake.notify_one();
+  return true;
+}
+
+TraceStats getTraceStats() {
+  TraceStats stats{};
+  stats.threadCount = getRingCount();
+  stats.historyCount = writer.historySize.load(std::memory_order_relaxed);
+  stats.dumpCount = writer.dumpCount.load(std::memory_order_relaxed);
+
+  for (uint32_t i = 0; i < stats.threadCount; i++)
+    stats.droppedCount +=
+        traceRings[i].droppedCount.load(std::memory_order_relaxed);
+
+  return stats;
+}
+
+} // namespace synth_io::trace
+
+#endif // SYNTH_TRACE
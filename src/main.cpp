@@ -1,16 +1,23 @@
 #include "utils/InputProcessor.h"
 #include "utils/KeyProcessor.h"
+#include "utils/MidiLearn.h"
+#include "utils/OscServer.h"
+#include "utils/Startup.h"
 
 #include "device_io/KeyCapture.h"
 #include "synth_io/Events.h"
 #include "synth_io/SynthIO.h"
 
 #include "synth/Engine.h"
+#include "synth/Rack.h"
 #include "synth/VoicePool.h"
 
 #include <audio_io/AudioIO.h>
+#include <chrono>
 #include <csignal>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <string>
@@ -26,14 +33,104 @@ static void processNoteEvent(synth_io::NoteEvent event, void *myContext) {
   engine->processNoteEvent(event);
 }
 
+static void processControllerEvent(synth_io::ControllerEvent event,
+                                   void *myContext) {
+  auto engine = static_cast<synth::Engine *>(myContext);
+  engine->processControllerEvent(event);
+}
+
 static void processAudioBlock(float **outputBuffer, size_t numChannels,
                               size_t numFrames, void *myContext) {
   auto engine = static_cast<synth::Engine *>(myContext);
   engine->processAudioBlock(outputBuffer, numChannels, numFrames);
 }
 
+// Multitimbral (--layer): same callbacks, the rack as context
+static void processRackParamEvent(synth_io::ParamEvent event,
+                                  void *myContext) {
+  static_cast<synth::rack::Rack *>(myContext)->processParamEvent(event);
+}
+
+static void processRackNoteEvent(synth_io::NoteEvent event, void *myContext) {
+  static_cast<synth::rack::Rack *>(myContext)->processNoteEvent(event);
+}
+
+static void processRackControllerEvent(synth_io::ControllerEvent event,
+                                       void *myContext) {
+  static_cast<synth::rack::Rack *>(myContext)->processControllerEvent(event);
+}
+
+static void processRackAudioBlock(float **outputBuffer, size_t numChannels,
+                                  size_t numFrames, void *myContext) {
+  static_cast<synth::rack::Rack *>(myContext)->processAudioBlock(
+      outputBuffer, numChannels, numFrames);
+}
+
+#if !OLD
+// Voice worker hooks: render helpers share the IO thread's deadline
+static void *joinAudioWorkgroup(void *context) {
+  return synth_io::joinAudioWorkgroup(
+      static_cast<synth_io::hSynthSession>(context));
+}
+
+static void leaveAudioWorkgroup(void *membership) {
+  synth_io::leaveAudioWorkgroup(membership);
+}
+#endif
+
+static void listOutputDevices() {
+  constexpr uint32_t MAX_LISTED = 32;
+  audio_io::DeviceInfo devices[MAX_LISTED];
+
+  uint32_t count = audio_io::listOutputDevices(devices, MAX_LISTED);
+  for (uint32_t i = 0; i < count && i < MAX_LISTED; i++) {
+    const audio_io::DeviceInfo &device = devices[i];
+    printf("%c %3u  %-40s %2u ch  %6.0f Hz  %u-%u frames\n",
+           device.isDefault ? '*' : ' ', device.id, device.name,
+           device.numOutputChannels, device.sampleRate, device.minFrames,
+           device.maxFrames);
+  }
+}
+
+// Numeric id, otherwise a name substring
+static uint32_t parseDevice(const char *arg) {
+  char *end = nullptr;
+  unsigned long id = std::strtoul(arg, &end, 10);
+  if (end != arg && *end == '\0')
+    return static_cast<uint32_t>(id);
+
+  return audio_io::findOutputDevice(arg);
+}
+
+// Headless run on the null output (no device/keyboard): hold a chord until
+// lengthFrames is rendered, then print the callback timing
+static void runNullOutput(synth_io::hSynthSession sessionPtr) {
+  constexpr uint8_t CHORD[] = {36, 48, 55, 60, 63, 67, 70, 72};
+  for (uint8_t note : CHORD)
+    synth_io::noteOn(sessionPtr, note, 100);
+
+  synth_io::CallbackStats stats = synth_io::getCallbackStats(sessionPtr);
+  while (!stats.isFinished) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    stats = synth_io::getCallbackStats(sessionPtr);
+  }
+
+  synth_io::DspLoadStats load = synth_io::getDspLoadStats(sessionPtr);
+  double realTimeFactor =
+      stats.wallSeconds > 0.0 ? stats.streamSeconds / stats.wallSeconds : 0.0;
+
+  printf("Null output: %llu callbacks, %.2f s audio in %.2f s (%.1fx real "
+         "time)\n",
+         static_cast<unsigned long long>(stats.callbackCount),
+         stats.streamSeconds, stats.wallSeconds, realTimeFactor);
+  printf("Callback: %.1f us avg, %.1f us max, %u late, peak load %.2f\n",
+         stats.averageCallbackUs, stats.maxCallbackUs, stats.lateCount,
+         static_cast<double>(load.peakLoad));
+}
+
 static void getUserInput(synth::Engine &engine,
-                         synth_io::hSynthSession sessionPtr) {
+                         synth_io::hSynthSession sessionPtr,
+                         synth::utils::MidiLearn &midiLearn) {
   bool isRunning = true;
   std::string input;
 
@@ -41,7 +138,7 @@ static void getUserInput(synth::Engine &engine,
     printf(">");
     std::getline(std::cin, input);
 
-    synth::utils::parseCommand(input, engine, sessionPtr);
+    synth::utils::parseCommand(input, engine, sessionPtr, midiLearn);
 
     if (input == "quit") {
       device_io::terminateKeyCaptureLoop();
@@ -50,29 +147,155 @@ static void getUserInput(synth::Engine &engine,
   }
 }
 
-int main() {
-  constexpr float SAMPLE_RATE = 48000.0f;
+int main(int argc, char **argv) {
+  // Launch time: every startup phase is measured from here
+  static synth::utils::StartupTimer startupTimer{};
+
+  float sampleRate = 48000.0f;
+  float renderSampleRate = 0.0f; // 0 = sampleRate
+
+  // Device buffer size (latency vs CPU), e.g. `main --frames 256`
+  // Output device by name (substring) or id, e.g. `main --device "Babyface"`
+  // No device (CI): `main --null-seconds 30 [--null-fast] [--null-out f]`
+  // Device rate + internal render rate: `main --rate 96000 --render-rate 48000`
+  // Key-to-sound latency (see the `latency` command): `main --latency-probe`
+  // Multitimbral: `main --layer bass.preset,keys=0-59 --layer init,ch=2`
+  // (repeatable, see rack::parseLayerSpec; the terminal edits layer 1)
+  // Control rate: `main --control-rate 128 --fast-control-rate 16`
+  // Network control (see utils::OscServer): `main --osc-port 9000`
+  // Output to other processes (see synth_io/SharedAudio.h):
+  // `main --shm-audio meh-synth`
+  // MIDI input, connected in the background once audio runs (default: every
+  // source): `main --midi KeyStep` (index or name substring), `--no-midi`
+  // Patch loaded in the background, posted when ready: `main --preset f`
+  uint32_t numFrames = synth_io::DEFAULT_FRAMES;
+  uint32_t deviceId = audio_io::DEFAULT_DEVICE_ID;
+  synth_io::NullOutputConfig nullOutput{};
+  double nullSeconds = 0.0;
+  bool isLatencyProbeEnabled = false;
+  synth::rack::LayerConfig layers[synth::rack::MAX_LAYERS];
+  uint32_t layerCount = 0;
+  uint32_t controlBlockSize = synth::DEFAULT_CONTROL_BLOCK_SIZE;
+  uint32_t fastControlBlockSize = 0;
+  uint16_t oscPort = 0; // 0 = off
+  const char *sharedAudioName = nullptr;
+  const char *midiSource = nullptr;
+  const char *presetPath = nullptr;
+  bool isMidiEnabled = true;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--list-devices") == 0) {
+      listOutputDevices();
+      return 0;
+    }
+
+    if (strcmp(argv[i], "--null-fast") == 0) {
+      nullOutput.isPaced = false;
+      continue;
+    }
+
+    if (strcmp(argv[i], "--latency-probe") == 0) {
+      isLatencyProbeEnabled = true;
+      continue;
+    }
+
+    if (strcmp(argv[i], "--no-midi") == 0) {
+      isMidiEnabled = false;
+      continue;
+    }
+
+    if (i + 1 >= argc)
+      break;
+
+    if (strcmp(argv[i], "--frames") == 0) {
+      numFrames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (strcmp(argv[i], "--device") == 0) {
+      deviceId = parseDevice(argv[++i]);
+      if (deviceId == audio_io::DEFAULT_DEVICE_ID) {
+        printf("Unknown device '%s' (see --list-devices)\n", argv[i]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--rate") == 0) {
+      sampleRate = std::strtof(argv[++i], nullptr);
+    } else if (strcmp(argv[i], "--render-rate") == 0) {
+      renderSampleRate = std::strtof(argv[++i], nullptr);
+    } else if (strcmp(argv[i], "--null-seconds") == 0) {
+      nullSeconds = std::strtod(argv[++i], nullptr);
+    } else if (strcmp(argv[i], "--null-out") == 0) {
+      nullOutput.outputPath = argv[++i];
+    } else if (strcmp(argv[i], "--layer") == 0) {
+      if (layerCount == synth::rack::MAX_LAYERS ||
+          !synth::rack::parseLayerSpec(argv[++i], layers[layerCount++]))
+        return 1;
+    } else if (strcmp(argv[i], "--control-rate") == 0) {
+      controlBlockSize =
+          static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (strcmp(argv[i], "--fast-control-rate") == 0) {
+      fastControlBlockSize =
+          static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (strcmp(argv[i], "--osc-port") == 0) {
+      oscPort = static_cast<uint16_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (strcmp(argv[i], "--shm-audio") == 0) {
+      sharedAudioName = argv[++i];
+    } else if (strcmp(argv[i], "--midi") == 0) {
+      midiSource = argv[++i];
+    } else if (strcmp(argv[i], "--preset") == 0) {
+      presetPath = argv[++i];
+    }
+  }
+  if (numFrames == 0)
+    numFrames = synth_io::DEFAULT_FRAMES;
+  if (sampleRate <= 0.0f)
+    sampleRate = 48000.0f;
+
+  nullOutput.isEnabled = nullSeconds > 0.0;
+  nullOutput.lengthFrames =
+      static_cast<uint64_t>(nullSeconds * static_cast<double>(sampleRate));
 
   // 1. Setup synth engine
+  double phaseStart = synth::utils::getStartupMs(startupTimer);
 #if OLD
-  Synth::Engine engine{SAMPLE_RATE, Synth::OscillatorType::Square};
+  Synth::Engine engine{sampleRate, Synth::OscillatorType::Square};
 #else
   using Engine = synth::Engine;
   using EngineConfig = synth::EngineConfig;
 
   EngineConfig engineConfig{};
-  engineConfig.sampleRate = SAMPLE_RATE;
+  engineConfig.sampleRate = sampleRate;
+  engineConfig.renderSampleRate = renderSampleRate;
+  engineConfig.numFrames = numFrames;
+  engineConfig.controlBlockSize = controlBlockSize;
+  engineConfig.fastControlBlockSize = fastControlBlockSize;
   engineConfig.osc1.waveform = synth::WaveformType::Saw;
   engineConfig.osc1.detuneAmount = 10.0f;
   engineConfig.osc2 = {synth::WaveformType::Saw, 0.5f, -1, -10.0f, true};
   engineConfig.subOsc.mixLevel = 0.7f;
 
-  Engine engine = synth::createEngine(engineConfig);
+  // Spread voices over a few extra cores (leave the rest to the OS/UI)
+  unsigned int numCores = std::thread::hardware_concurrency();
+  engineConfig.numVoiceWorkers = numCores > 4 ? 3 : 0;
+
+  // Layers: the same cores render whole layers instead of voices
+  synth::rack::Rack *rack = nullptr;
+  if (layerCount > 0) {
+    rack = synth::rack::createRack(engineConfig, layers, layerCount,
+                                   engineConfig.numVoiceWorkers);
+    if (!rack)
+      return 1;
+  }
+
+  Engine *engine =
+      rack ? rack->layers[rack->editLayer].engine
+           : synth::createEngine(engineConfig);
 #endif
+  synth::utils::recordStartupPhase(startupTimer, "engine", phaseStart);
 
   // 2. Setup audio_io
   synth_io::SessionConfig sessionConfig{};
-  sessionConfig.sampleRate = static_cast<uint32_t>(SAMPLE_RATE);
+  sessionConfig.sampleRate = static_cast<uint32_t>(sampleRate);
+  sessionConfig.numFrames = numFrames;
+  sessionConfig.deviceId = deviceId;
+  sessionConfig.nullOutput = nullOutput;
+  sessionConfig.isLatencyProbeEnabled = isLatencyProbeEnabled;
 
   synth_io::SynthCallbacks sessionCallbacks{};
   sessionCallbacks.processAudioBlock = processAudioBlock;
@@ -80,19 +303,98 @@ int main() {
 
 #if !OLD
   sessionCallbacks.processParamEvent = processParamEvent;
+  sessionCallbacks.processControllerEvent = processControllerEvent;
 #endif
 
+  void *sessionContext = engine;
+  if (rack) {
+    sessionCallbacks.processAudioBlock = processRackAudioBlock;
+    sessionCallbacks.processNoteEvent = processRackNoteEvent;
+    sessionCallbacks.processParamEvent = processRackParamEvent;
+    sessionCallbacks.processControllerEvent = processRackControllerEvent;
+    sessionContext = rack;
+  }
+
+  phaseStart = synth::utils::getStartupMs(startupTimer);
   synth_io::hSynthSession session =
-      synth_io::initSession(sessionConfig, sessionCallbacks, &engine);
+      synth_io::initSession(sessionConfig, sessionCallbacks, sessionContext);
+
+  // Before the stream starts: readers see it from frame 0 (1 s of slack)
+  if (sharedAudioName &&
+      !synth_io::publishSharedAudio(session, sharedAudioName,
+                                    static_cast<uint32_t>(sampleRate)))
+    return 1;
+  synth::utils::recordStartupPhase(startupTimer, "audio setup", phaseStart);
 
+  // 3. Audio first: the engine is playable from here on
+  phaseStart = synth::utils::getStartupMs(startupTimer);
   synth_io::startSession(session);
+  synth::utils::recordStartupPhase(startupTimer, "audio start", phaseStart);
+  printf("Audio running %.1f ms after launch\n",
+         synth::utils::getStartupMs(startupTimer));
+
+#if !OLD
+  synth::setVoiceWorkerHooks(
+      *engine, {joinAudioWorkgroup, leaveAudioWorkgroup, session});
+  if (rack)
+    synth::rack::setRackWorkerHooks(
+        *rack, {joinAudioWorkgroup, leaveAudioWorkgroup, session});
+#endif
+
+  // Scene changes from the network (also drives headless runs)
+  static synth::utils::OscServer oscServer{};
+  if (oscPort > 0) {
+    phaseStart = synth::utils::getStartupMs(startupTimer);
+    if (!synth::utils::startOscServer(oscServer, session, oscPort))
+      return 1;
+    synth::utils::recordStartupPhase(startupTimer, "osc", phaseStart);
+  }
 
-  auto midiSession = synth::utils::initMidiSession(session);
+  // 4. MIDI sources + assets on background threads, pushed into the running
+  // engine when ready (knob -> param mappings shared with the terminal)
+  static synth::utils::MidiLearn midiLearn{};
+  static synth::utils::BackgroundStartup backgroundStartup{};
+  synth::utils::StartupAssets startupAssets{};
+  startupAssets.engine = engine;
+  startupAssets.session = session;
+  startupAssets.midiLearn = &midiLearn;
+  startupAssets.isMidiEnabled = isMidiEnabled && !nullOutput.isEnabled;
+  startupAssets.midiSource = midiSource;
+  startupAssets.presetPath = presetPath;
+  synth::utils::startBackgroundStartup(backgroundStartup, startupTimer,
+                                       startupAssets);
 
-  std::thread terminalWorker(getUserInput, std::ref(engine), session);
+  if (nullOutput.isEnabled) {
+    runNullOutput(session);
+    synth::utils::stopOscServer(oscServer);
+    synth::utils::finishBackgroundStartup(backgroundStartup);
+
+#if !OLD
+    synth::setVoiceWorkerHooks(*engine, {});
+    if (rack)
+      synth::rack::setRackWorkerHooks(*rack, {});
+#endif
+    synth_io::stopSession(session);
+    synth_io::disposeSession(session);
+
+#if !OLD
+    if (rack)
+      synth::rack::disposeRack(rack);
+    else
+      synth::disposeEngine(engine);
+#endif
+    return 0;
+  }
+
+  synth_io::OutputLatency latency = synth_io::getOutputLatency(session);
+  printf("Output: %u frame buffer, %.1f ms total latency\n",
+         latency.bufferFrames, latency.totalSeconds * 1000.0);
+
+  std::thread terminalWorker(getUserInput, std::ref(*engine), session,
+                             std::ref(midiLearn));
   terminalWorker.detach();
 
-  synth::utils::startKeyInputCapture(session, midiSession);
+  synth::utils::startKeyInputCapture(session);
 
   /* This currently unreachable on MacOS due to `terminal:nil` being called
    * in `stopKeyCaptureLoop()` and immediately exits app.
@@ -105,9 +407,24 @@ int main() {
    * changes need to be made.
    */
   printf("Goodbye and thanks for playing :)\n");
+  synth::utils::stopOscServer(oscServer);
+  synth::utils::disposeMidiSession(
+      synth::utils::finishBackgroundStartup(backgroundStartup));
 
+#if !OLD
+  synth::setVoiceWorkerHooks(*engine, {});
+  if (rack)
+    synth::rack::setRackWorkerHooks(*rack, {});
+#endif
   synth_io::stopSession(session);
   synth_io::disposeSession(session);
 
+#if !OLD
+  if (rack)
+    synth::rack::disposeRack(rack);
+  else
+    synth::disposeEngine(engine);
+#endif
+
   return 0;
 }
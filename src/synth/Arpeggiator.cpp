@@ -0,0 +1,232 @@
+#include "Arpeggiator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace synth::arp {
+using NoteEventType = synth_io::NoteEventType;
+
+// ==== <Arp Helpers> ====
+namespace {
+constexpr uint32_t NO_EVENT = std::numeric_limits<uint32_t>::max();
+
+// First whole frame at or after a fractional time
+uint32_t toFrames(double frames) {
+  if (frames <= 0.0)
+    return 0;
+  double whole = std::ceil(frames);
+  return whole >= static_cast<double>(NO_EVENT) ? NO_EVENT - 1
+                                                : static_cast<uint32_t>(whole);
+}
+
+uint32_t nextRandom(uint32_t &state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+NoteEvent makeNote(NoteEventType type, const ArpNote &note) {
+  NoteEvent event{};
+  event.type = type;
+  event.midiNote = note.midiNote;
+  event.velocity = type == NoteEventType::NoteOn ? note.velocity : 0;
+  event.channel = note.channel;
+  return event;
+}
+
+uint32_t releaseSounding(Arpeggiator &arp, NoteEvent *events) {
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < arp.soundingCount; i++)
+    events[count++] = makeNote(NoteEventType::NoteOff, arp.sounding[i]);
+  arp.soundingCount = 0;
+  return count;
+}
+
+// Held keys in pitch order (insertion sort, at most MAX_ARP_NOTES)
+void sortHeld(const Arpeggiator &arp, ArpNote *sorted) {
+  for (uint32_t i = 0; i < arp.heldCount; i++) {
+    uint32_t j = i;
+    while (j > 0 && sorted[j - 1].midiNote > arp.held[i].midiNote) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = arp.held[i];
+  }
+}
+
+void addSounding(Arpeggiator &arp, const ArpNote &note, int32_t octave,
+                 NoteEvent *events, uint32_t &count) {
+  int32_t midiNote = note.midiNote + 12 * octave;
+  if (midiNote < 1 || midiNote > 127 || arp.soundingCount == MAX_ARP_NOTES)
+    return;
+
+  ArpNote played = note;
+  played.midiNote = static_cast<uint8_t>(midiNote);
+  arp.sounding[arp.soundingCount++] = played;
+  events[count++] = makeNote(NoteEventType::NoteOn, played);
+}
+
+// One played step: the mode's next note(s) appended to _events_
+void playStep(Arpeggiator &arp, NoteEvent *events, uint32_t &count) {
+  ArpNote sorted[MAX_ARP_NOTES];
+  sortHeld(arp, sorted);
+
+  auto numNotes = static_cast<int32_t>(arp.heldCount);
+  int32_t octaves = std::max<int32_t>(arp.octaves, 1);
+  int32_t total = numNotes * octaves;
+  auto position = static_cast<int32_t>(arp.noteIndex++ % 1048576u);
+
+  int32_t index = 0;
+  switch (static_cast<ArpMode>(arp.mode)) {
+  case ArpMode::Chord: {
+    int32_t octave = position % octaves;
+    for (int32_t n = 0; n < numNotes; n++)
+      addSounding(arp, sorted[n], octave, events, count);
+    return;
+  }
+  case ArpMode::Order:
+    index = position % total;
+    addSounding(arp, arp.held[index % numNotes], index / numNotes, events,
+                count);
+    return;
+  case ArpMode::Down:
+    index = total - 1 - position % total;
+    break;
+  case ArpMode::UpDown: {
+    int32_t period = std::max(2 * total - 2, 1);
+    index = position % period;
+    if (index >= total)
+      index = period - index;
+    break;
+  }
+  case ArpMode::Random:
+    index = static_cast<int32_t>(nextRandom(arp.rngState) %
+                                 static_cast<uint32_t>(total));
+    break;
+  case ArpMode::Up:
+  case ArpMode::MODE_COUNT:
+    index = position % total;
+    break;
+  }
+
+  addSounding(arp, sorted[index % numNotes], index / numNotes, events, count);
+}
+
+bool isStepOn(const Arpeggiator &arp, uint32_t step) {
+  auto mask = static_cast<uint32_t>(std::max(arp.pattern, 0.0f));
+  return (mask >> step) & 1u;
+}
+
+} // namespace
+// ==== </Arp Helpers> ====
+
+void arpNoteOn(Arpeggiator &arp, const NoteEvent &event) {
+  // Re-pressed key: keep its place, take the new velocity
+  for (uint32_t i = 0; i < arp.heldCount; i++) {
+    ArpNote &held = arp.held[i];
+    if (held.midiNote == event.midiNote && held.channel == event.channel) {
+      held.velocity = event.velocity;
+      return;
+    }
+  }
+
+  if (arp.heldCount == MAX_ARP_NOTES)
+    return;
+
+  arp.held[arp.heldCount++] = {event.midiNote, event.velocity, event.channel};
+
+  // First key: step 1 plays right on it
+  if (!arp.isRunning) {
+    arp.isRunning = true;
+    arp.framesToStep = 0.0;
+    arp.stepIndex = 0;
+    arp.noteIndex = 0;
+  }
+}
+
+void arpNoteOff(Arpeggiator &arp, const NoteEvent &event) {
+  for (uint32_t i = 0; i < arp.heldCount; i++) {
+    if (arp.held[i].midiNote != event.midiNote ||
+        arp.held[i].channel != event.channel)
+      continue;
+
+    // Keep press order (Order mode)
+    std::copy(arp.held + i + 1, arp.held + arp.heldCount, arp.held + i);
+    arp.heldCount--;
+    break;
+  }
+
+  // Last key up: the clock stops, sounding notes still get their gate
+  if (arp.heldCount == 0)
+    arp.isRunning = false;
+}
+
+uint32_t framesUntilArpEvent(const Arpeggiator &arp) {
+  if (!arp.enabled)
+    return isArpIdle(arp) ? NO_EVENT : 0;
+
+  uint32_t frames = NO_EVENT;
+  if (arp.isRunning)
+    frames = toFrames(arp.framesToStep);
+  if (arp.soundingCount > 0 && arp.framesToGateOff >= 0.0)
+    frames = std::min(frames, toFrames(arp.framesToGateOff));
+  return frames;
+}
+
+uint32_t runArp(Arpeggiator &arp, float sampleRate, float tempo,
+                NoteEvent *events) {
+  if (!arp.enabled) {
+    arp.heldCount = 0;
+    arp.isRunning = false;
+    arp.framesToGateOff = -1.0;
+    return releaseSounding(arp, events);
+  }
+
+  uint32_t count = 0;
+  if (arp.framesToGateOff >= 0.0 && toFrames(arp.framesToGateOff) == 0) {
+    count += releaseSounding(arp, events);
+    arp.framesToGateOff = -1.0;
+  }
+
+  if (!arp.isRunning || toFrames(arp.framesToStep) > 0)
+    return count;
+
+  double stepFrames =
+      static_cast<double>(sampleRate) * 60.0 / static_cast<double>(tempo) *
+      static_cast<double>(
+          fx::delayDivisionBeats(static_cast<fx::DelayDivision>(arp.division)));
+  stepFrames = std::max(stepFrames, 1.0);
+
+  // Gate 1.0 (legato): the last step's notes end as the next ones start
+  count += releaseSounding(arp, events + count);
+
+  uint32_t numSteps =
+      std::clamp<uint32_t>(static_cast<uint32_t>(std::max<int8_t>(arp.steps, 1)),
+                           1, MAX_ARP_STEPS);
+  if (isStepOn(arp, arp.stepIndex % numSteps))
+    playStep(arp, events, count);
+  arp.stepIndex = (arp.stepIndex + 1) % numSteps;
+
+  // Both relative to the step's exact (fractional) time
+  float gate = std::clamp(arp.gate, 0.0f, 1.0f);
+  arp.framesToGateOff =
+      arp.soundingCount > 0
+          ? std::max(arp.framesToStep + static_cast<double>(gate) * stepFrames,
+                     0.0)
+          : -1.0;
+  arp.framesToStep += stepFrames;
+  return count;
+}
+
+void advanceArp(Arpeggiator &arp, uint32_t numFrames) {
+  auto frames = static_cast<double>(numFrames);
+  if (arp.isRunning)
+    arp.framesToStep -= frames;
+  if (arp.framesToGateOff >= 0.0)
+    arp.framesToGateOff = std::max(arp.framesToGateOff - frames, 0.0);
+}
+
+} // namespace synth::arp
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "MasterFX.h"
+
+#include "synth_io/Events.h"
+
+#include <cstdint>
+
+namespace synth::arp {
+using NoteEvent = synth_io::NoteEvent;
+
+/* Arpeggiator / step sequencer (Engine stage, before processVoices)
+ * - while enabled, key note-ons are held here instead of reaching the
+ *   voice pool; the arp plays them back on its own clock (Engine::tempo,
+ *   _division_ per step)
+ * - its note events are made on the audio thread, at exact frames: the
+ *   engine ends render blocks at framesUntilArpEvent, then applies
+ *   runArp's events (no queue, no timestamps, no jitter)
+ * - step sequencer: a _steps_ long pattern, bit s of _pattern_ set = step s
+ *   plays, clear = rest (the clock keeps running)
+ * - fixed arrays only, nothing allocated
+ * NOTE: disabling it drops the held keys (re-press to play them directly)
+ */
+inline constexpr uint32_t MAX_ARP_NOTES = 16;
+inline constexpr uint32_t MAX_ARP_STEPS = 16;
+inline constexpr float ALL_STEPS_PATTERN = 65535.0f; // every step plays
+
+// Note-offs for every sounding note + one step's note-ons
+inline constexpr uint32_t MAX_ARP_EVENTS = 2 * MAX_ARP_NOTES;
+
+enum class ArpMode : int8_t {
+  Up,     // lowest to highest, then the next octave
+  Down,   // highest to lowest, then the octave below
+  UpDown, // up then down, ends not repeated
+  Random,
+  Order, // as pressed
+  Chord, // every held note each step, octaves cycling
+  MODE_COUNT,
+};
+
+struct ArpNote {
+  uint8_t midiNote = 0;
+  uint8_t velocity = 0;
+  uint8_t channel = 0;
+};
+
+struct Arpeggiator {
+  bool enabled = false;
+  int8_t mode = static_cast<int8_t>(ArpMode::Up);
+  int8_t division = static_cast<int8_t>(fx::DelayDivision::Sixteenth);
+  int8_t octaves = 1; // range the pattern climbs
+  float gate = 0.5f;  // fraction of a step each note sounds
+  int8_t steps = static_cast<int8_t>(MAX_ARP_STEPS);
+  float pattern = ALL_STEPS_PATTERN; // step bit mask (16 bits in a float)
+
+  // Held keys (press order) and the notes the arp has sounding
+  ArpNote held[MAX_ARP_NOTES];
+  uint32_t heldCount = 0;
+  ArpNote sounding[MAX_ARP_NOTES];
+  uint32_t soundingCount = 0;
+
+  // Clock, render frames from now (fractional: steps never drift)
+  bool isRunning = false;       // keys held
+  double framesToStep = 0.0;
+  double framesToGateOff = -1.0; // < 0: no gate pending
+  uint32_t stepIndex = 0;        // pattern position
+  uint32_t noteIndex = 0;        // position in the note order
+  uint32_t rngState = 0x2545F491u;
+};
+
+// Key events while enabled (the first key starts the clock on its frame)
+void arpNoteOn(Arpeggiator &arp, const NoteEvent &event);
+void arpNoteOff(Arpeggiator &arp, const NoteEvent &event);
+
+// Nothing to play or release: the engine skips the stage
+inline bool isArpIdle(const Arpeggiator &arp) {
+  return arp.heldCount == 0 && arp.soundingCount == 0;
+}
+
+// Render frames until runArp has events again (UINT32_MAX: none pending)
+uint32_t framesUntilArpEvent(const Arpeggiator &arp);
+
+/* Events due now into _events_ (MAX_ARP_EVENTS), note-offs first
+ * - step length from _sampleRate_ (render rate) and _tempo_, read per step
+ * - disabled: releases whatever is sounding and drops the held keys
+ * Returns the number of events
+ */
+uint32_t runArp(Arpeggiator &arp, float sampleRate, float tempo,
+                NoteEvent *events);
+
+// The engine rendered _numFrames_ since the last call
+void advanceArp(Arpeggiator &arp, uint32_t numFrames);
+
+} // namespace synth::arp
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// Little-endian field access for on-disk formats (presets, preset library)
+// Byte at a time: no alignment requirements, same files on every host
+namespace synth::byte_order {
+
+inline void writeU16(uint8_t *bytes, uint16_t value) {
+  bytes[0] = static_cast<uint8_t>(value);
+  bytes[1] = static_cast<uint8_t>(value >> 8);
+}
+
+inline void writeU32(uint8_t *bytes, uint32_t value) {
+  for (int i = 0; i < 4; i++)
+    bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+inline void writeF32(uint8_t *bytes, float value) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  writeU32(bytes, bits);
+}
+
+inline uint16_t readU16(const uint8_t *bytes) {
+  return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+inline uint32_t readU32(const uint8_t *bytes) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++)
+    value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+  return value;
+}
+
+inline float readF32(const uint8_t *bytes) {
+  uint32_t bits = readU32(bytes);
+  float value = 0.0f;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+} // namespace synth::byte_order
@@ -0,0 +1,135 @@
+#include "Controllers.h"
+#include "Types.h"
+
+#include "synth_io/Events.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::controllers {
+
+namespace {
+// ==== <Smoothing Helpers> ====
+
+// Below this the value snaps to its target (no denormal tail)
+constexpr float SNAP_DISTANCE = 1.0e-5f;
+
+float smoothToward(float value, float target, float coeff) {
+  float distance = target - value;
+  if (std::fabs(distance) < SNAP_DISTANCE)
+    return target;
+
+  return value + distance * coeff;
+}
+
+} // namespace
+// ==== </Smoothing Helpers> ====
+
+void setControllerTarget(Controllers &controllers, uint16_t id, float value) {
+  if (id >= synth_io::CONTROLLER_NOTE_BEND) {
+    uint32_t lane = id - synth_io::CONTROLLER_NOTE_BEND;
+    uint32_t channel = lane % NUM_MIDI_CHANNELS;
+
+    switch (lane / NUM_MIDI_CHANNELS) {
+    case 0:
+      controllers.noteBendTargets[channel] = value;
+      break;
+    case 1:
+      controllers.notePressureTargets[channel] = value;
+      break;
+    case 2:
+      controllers.noteSlideTargets[channel] = value;
+      break;
+    default:
+      break;
+    }
+    return;
+  }
+
+  if (id >= synth_io::CONTROLLER_POLY_PRESSURE) {
+    uint32_t note = id - synth_io::CONTROLLER_POLY_PRESSURE;
+    if (note < NUM_CONTROLLER_NOTES)
+      controllers.polyPressureTargets[note] = value;
+    return;
+  }
+
+  switch (id) {
+  case synth_io::CONTROLLER_CC + MOD_WHEEL_CC:
+    controllers.modWheelTarget = value;
+    break;
+  case synth_io::CONTROLLER_PITCH_BEND:
+    controllers.pitchBendTarget = value;
+    break;
+  case synth_io::CONTROLLER_CHANNEL_PRESSURE:
+    controllers.channelPressureTarget = value;
+    break;
+  default:
+    break;
+  }
+}
+
+void initControllers(Controllers &controllers, uint32_t voiceIndex,
+                     uint8_t midiNote) {
+  controllers.polyPressures[voiceIndex] =
+      controllers.polyPressureTargets[midiNote % NUM_CONTROLLER_NOTES];
+}
+
+void initNoteExpression(const Controllers &controllers,
+                        NoteExpression &expression, uint32_t voiceIndex,
+                        uint8_t channel) {
+  channel %= NUM_MIDI_CHANNELS;
+
+  expression.channels[voiceIndex] = channel;
+  expression.bends[voiceIndex] = controllers.noteBendTargets[channel];
+  expression.pressures[voiceIndex] = controllers.notePressureTargets[channel];
+  expression.slides[voiceIndex] = controllers.noteSlideTargets[channel];
+}
+
+float computeSmoothingCoeff(uint32_t blockLength, float invSampleRate) {
+  float blockSeconds = static_cast<float>(blockLength) * invSampleRate;
+  return 1.0f - std::exp(-blockSeconds / CONTROLLER_SMOOTHING_SECONDS);
+}
+
+void processControllers(Controllers &controllers, const uint32_t *voiceIndices,
+                        const uint8_t *midiNotes, uint32_t count,
+                        float coeff) {
+  controllers.modWheel = smoothToward(controllers.modWheel,
+                                      controllers.modWheelTarget, coeff);
+  controllers.pitchBend = smoothToward(controllers.pitchBend,
+                                       controllers.pitchBendTarget, coeff);
+  controllers.channelPressure =
+      smoothToward(controllers.channelPressure,
+                   controllers.channelPressureTarget, coeff);
+
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t voiceIndex = voiceIndices[i];
+    float target =
+        controllers.polyPressureTargets[midiNotes[voiceIndex] %
+                                        NUM_CONTROLLER_NOTES];
+    controllers.polyPressures[voiceIndex] =
+        smoothToward(controllers.polyPressures[voiceIndex], target, coeff);
+  }
+}
+
+void processNoteExpression(const Controllers &controllers,
+                           NoteExpression &expression,
+                           const uint32_t *voiceIndices, uint32_t count,
+                           float coeff) {
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t voiceIndex = voiceIndices[i];
+    uint8_t channel = expression.channels[voiceIndex];
+
+    expression.bends[voiceIndex] =
+        smoothToward(expression.bends[voiceIndex],
+                     controllers.noteBendTargets[channel], coeff);
+    expression.pressures[voiceIndex] =
+        smoothToward(expression.pressures[voiceIndex],
+                     controllers.notePressureTargets[channel], coeff);
+    expression.slides[voiceIndex] =
+        smoothToward(expression.slides[voiceIndex],
+                     controllers.noteSlideTargets[channel], coeff);
+  }
+}
+
+} // namespace synth::controllers
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Types.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::controllers {
+
+/* MIDI controllers as mod sources (ModSrc::ModWheel, PitchBend,
+ * ChannelPressure, PolyPressure, and the per-note MPE lanes NoteBend,
+ * NotePressure, NoteSlide)
+ * - targets: the latest value from synth_io (coalesced, once per buffer)
+ * - values: one-pole smoothed toward the targets once per block; the fast
+ *   destinations (pitch, wavetable position) also ramp per sample, so a
+ *   7-bit CC sweep doesn't zipper
+ */
+inline constexpr uint8_t MOD_WHEEL_CC = 1;
+inline constexpr uint32_t NUM_CONTROLLER_NOTES = 128;
+inline constexpr uint32_t NUM_MIDI_CHANNELS = 16;
+
+// Smoothing time constant (~63% of a jump per 5 ms)
+inline constexpr float CONTROLLER_SMOOTHING_SECONDS = 0.005f;
+
+struct Controllers {
+  // === Per-voice state (hot data) ===
+  // Poly pressure of the voice's note, smoothed
+  alignas(CACHE_LINE_SIZE) float polyPressures[MAX_VOICES];
+
+  // === Channel-wide, smoothed ===
+  float modWheel = 0.0f;        // 0.0-1.0
+  float pitchBend = 0.0f;       // -1.0-1.0
+  float channelPressure = 0.0f; // 0.0-1.0
+
+  // === Targets (cold data: written per controller event) ===
+  float modWheelTarget = 0.0f;
+  float pitchBendTarget = 0.0f;
+  float channelPressureTarget = 0.0f;
+  float polyPressureTargets[NUM_CONTROLLER_NOTES] = {};
+
+  // MPE lanes, per MIDI channel
+  float noteBendTargets[NUM_MIDI_CHANNELS] = {};     // -1.0-1.0
+  float notePressureTargets[NUM_MIDI_CHANNELS] = {}; // 0.0-1.0
+  float noteSlideTargets[NUM_MIDI_CHANNELS] = {};    // 0.0-1.0
+};
+
+// Per-note expression (MPE), per voice, smoothed from the voice's channel
+// (VoicePool keeps it next to the velocities)
+struct NoteExpression {
+  alignas(CACHE_LINE_SIZE) float bends[MAX_VOICES]; // -1.0-1.0
+  alignas(CACHE_LINE_SIZE) float pressures[MAX_VOICES];
+  alignas(CACHE_LINE_SIZE) float slides[MAX_VOICES];
+  uint8_t channels[MAX_VOICES]; // note-on MIDI channel (0-15)
+};
+
+// synth_io::ControllerEvent id/value. Controllers without a source are
+// ignored
+void setControllerTarget(Controllers &controllers, uint16_t id, float value);
+
+// NoteOn: start at the note's current pressure/expression (no glide from
+// the voice's previous note)
+void initControllers(Controllers &controllers, uint32_t voiceIndex,
+                     uint8_t midiNote);
+void initNoteExpression(const Controllers &controllers,
+                        NoteExpression &expression, uint32_t voiceIndex,
+                        uint8_t channel);
+
+// One-pole coefficient for a block (one exp, shared by the calls below)
+float computeSmoothingCoeff(uint32_t blockLength, float invSampleRate);
+
+/* Advance the smoothing by one block
+ * - channel-wide values once, poly pressure for voiceIndices[0..count)
+ * - _midiNotes_: per voice (VoicePool::midiNotes)
+ */
+void processControllers(Controllers &controllers, const uint32_t *voiceIndices,
+                        const uint8_t *midiNotes, uint32_t count, float coeff);
+
+// Each voice in voiceIndices[0..count) toward its channel's lanes
+void processNoteExpression(const Controllers &controllers,
+                           NoteExpression &expression,
+                           const uint32_t *voiceIndices, uint32_t count,
+                           float coeff);
+
+} // namespace synth::controllers
@@ -1,67 +1,739 @@
 #include "Engine.h"
 #include "ParamBindings.h"
+#include "Patch.h"
+#include "Snapshot.h"
+#include "Tuning.h"
 #include "VoicePool.h"
+#include "VoiceWorkers.h"
+
+#include "dsp/Dispatch.h"
+#include "dsp/Envelope.h"
+#include "dsp/Wavetable.h"
 
 #include "synth_io/Events.h"
+#include "synth_io/Trace.h"
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <new>
 
 namespace synth {
 using NoteEvent = synth_io::NoteEvent;
 using ParamEvent = synth_io::ParamEvent;
 
-Engine createEngine(const EngineConfig &config) {
-  Engine engine{};
+// ==== <Buffer Helpers> ====
+namespace {
+
+float *allocateBuffer(uint32_t numFrames) {
+  auto *buffer = new (std::align_val_t{Engine::BUFFER_ALIGNMENT})
+      float[numFrames]();
+  return buffer;
+}
+
+void freeBuffer(float *buffer) {
+  operator delete[](buffer, std::align_val_t{Engine::BUFFER_ALIGNMENT});
+}
+
+} // namespace
+// ==== </Buffer Helpers> ====
+
+// Engine arena worst case (voices render from it without workers): mod
+// sources, one voice, the FX wet buffers (stereo)
+static_assert(sizeof(float) * MAX_VOICES * mod_matrix::ModSrc::SRC_COUNT +
+                      voices::VOICE_SCRATCH_WORST_BYTES +
+                      sizeof(float) * ENGINE_BLOCK_SIZE * STEREO_CHANNELS <=
+                  scratch::ENGINE_SCRATCH_BYTES,
+              "engine scratch budget below the render worst case");
+
+// ==== <Runtime Setting Helpers> ====
+namespace {
+// Clamped pair, packed for Engine::pendingControlRate (never 0)
+uint64_t packControlRate(uint32_t blockSize, uint32_t fastBlockSize) {
+  blockSize = std::clamp(blockSize, MIN_CONTROL_BLOCK_SIZE, ENGINE_BLOCK_SIZE);
+
+  // Only a faster rate adapts anything
+  fastBlockSize = fastBlockSize > 0 ? std::clamp(fastBlockSize,
+                                                 MIN_CONTROL_BLOCK_SIZE,
+                                                 blockSize)
+                                    : 0;
+
+  return static_cast<uint64_t>(blockSize) << 32 | fastBlockSize;
+}
+
+void applyControlRate(Engine &engine, uint64_t packed) {
+  engine.controlBlockSize = static_cast<uint32_t>(packed >> 32);
+  engine.fastControlBlockSize = static_cast<uint32_t>(packed);
+}
+
+// Audio thread, block boundary
+void applyPendingControlRate(Engine &engine) {
+  if (uint64_t packed =
+          engine.pendingControlRate.exchange(0, std::memory_order_acquire))
+    applyControlRate(engine, packed);
+}
+
+// Audio thread, block boundary (voice workers are idle)
+void applyPendingQuality(Engine &engine) {
+  if (uint32_t pending =
+          engine.pendingQuality.exchange(0, std::memory_order_acquire))
+    engine.voicePool.quality = static_cast<QualityMode>(pending - 1);
+}
+} // namespace
+// ==== </Runtime Setting Helpers> ====
+
+Engine *createEngine(const EngineConfig &config) {
+  // One aligned block (alignof(Engine) picks the aligned operator new),
+  // value initialized like the old by-value Engine{}
+  auto *engine = new Engine();
+  engine->sampleRate = config.sampleRate;
+  engine->outputSampleRate = config.sampleRate;
+
+  // All render scratch is sized here, never on the audio thread
+  engine->maxFrames = std::max(config.maxFrames ? config.maxFrames
+                                                : config.numFrames,
+                               ENGINE_BLOCK_SIZE);
+  for (float *&buffer : engine->poolBuffers)
+    buffer = allocateBuffer(engine->maxFrames);
+  engine->scratch =
+      scratch::createScratchArena(scratch::ENGINE_SCRATCH_BYTES);
+
+  // Fixed internal render rate: everything below runs at it
+  if (config.renderSampleRate > 0.0f &&
+      config.renderSampleRate != config.sampleRate) {
+    for (dsp::resampler::Resampler &resampler : engine->resamplers)
+      resampler = dsp::resampler::createResampler(
+          static_cast<uint32_t>(config.renderSampleRate),
+          static_cast<uint32_t>(config.sampleRate), engine->maxFrames);
+
+    // Unsupported ratio: render at the device rate (see printEngineLayout)
+    engine->isResampling = engine->resamplers[0].phases != nullptr;
+    if (engine->isResampling)
+      engine->sampleRate = config.renderSampleRate;
+  }
 
-  voices::updateVoicePoolConfig(engine.voicePool, config);
+  // Build band-limited tables up front (never on the audio thread)
+  dsp::wavetable::initBuiltinWavetables();
+  dsp::envelopes::initCurveTables();
 
-  param::bindings::initParamBindings(engine);
+  // Bind the best block kernels for this CPU (before any render)
+  dsp::dispatch::initKernelDispatch();
+
+  voices::resetVoiceAllocator(engine->voicePool);
+  tuning::initEqualTemperament(engine->voicePool.tuning);
+  VoiceConfig voiceConfig = config;
+  voiceConfig.sampleRate = engine->sampleRate;
+  voices::updateVoicePoolConfig(engine->voicePool, voiceConfig);
+
+  governor::initVoiceGovernor(engine->governor, config.isVoiceGovernorEnabled,
+                              engine->sampleRate);
+
+  // Not running yet: set directly (readable before the first block)
+  applyControlRate(*engine, packControlRate(config.controlBlockSize,
+                                            config.fastControlBlockSize));
+
+  // Delay line + reverb network sized for this sample rate
+  fx::initFXChain(engine->fxChain, engine->sampleRate, engine->tempo);
+
+  param::bindings::initParamBindings(*engine);
+
+  // Capturing threads build on this until the first publish
+  engine->patchShadows = new patch::Patch[Engine::PATCH_SHADOW_COUNT];
+  patch::publishPatchShadow(*engine);
+
+  // Workers render what the engine renders: render rate, maxFrames chunks
+  if (config.numVoiceWorkers > 0)
+    engine->voicePool.workers = voices::createVoiceWorkers(
+        config.numVoiceWorkers, engine->sampleRate, engine->maxFrames);
 
   return engine;
 }
 
-void Engine::processParamEvent(const ParamEvent &event) {
-  param::bindings::setParamValueByID(*this, static_cast<ParamID>(event.id),
-                                     event.value);
+// ==== <Wavetable Helpers> ====
+namespace {
+// Published for nullptr (a null pending slot means "nothing new")
+const dsp::wavetable::WavetableFrames BUILTIN_WAVETABLE{};
+
+oscillator::Oscillator &getOscillator(VoicePool &pool, fm_matrix::FMOsc osc) {
+  switch (osc) {
+  case fm_matrix::Osc1:
+    return pool.osc1;
+  case fm_matrix::Osc2:
+    return pool.osc2;
+  case fm_matrix::Osc3:
+    return pool.osc3;
+  default:
+    return pool.subOsc;
+  }
 }
 
-void Engine::processNoteEvent(const synth_io::NoteEvent &event) {
-  if (!event.midiNote)
+// Audio thread, block boundary
+void applyPendingWavetables(Engine &engine) {
+  for (uint8_t k = 0; k < fm_matrix::FM_OSC_COUNT; k++) {
+    const dsp::wavetable::WavetableFrames *frames =
+        engine.pendingWavetables[k].exchange(nullptr,
+                                             std::memory_order_acquire);
+    if (!frames)
+      continue;
+
+    oscillator::setWavetable(
+        getOscillator(engine.voicePool, static_cast<fm_matrix::FMOsc>(k)),
+        frames->frames, frames->frameCount);
+  }
+}
+} // namespace
+// ==== </Wavetable Helpers> ====
+
+void publishWavetable(Engine &engine, fm_matrix::FMOsc osc,
+                      const dsp::wavetable::WavetableFrames *frames) {
+  if (osc >= fm_matrix::FM_OSC_COUNT)
+    return;
+
+  engine.pendingWavetables[osc].store(frames ? frames : &BUILTIN_WAVETABLE,
+                                      std::memory_order_release);
+}
+
+EngineTelemetry getEngineTelemetry(const Engine &engine) {
+  const TelemetryCounters &counters = engine.telemetry;
+  const governor::VoiceGovernor &governor = engine.governor;
+
+  EngineTelemetry telemetry{};
+  telemetry.activeVoices =
+      counters.activeVoices.load(std::memory_order_relaxed);
+  telemetry.peakActiveVoices =
+      counters.peakActiveVoices.load(std::memory_order_relaxed);
+  telemetry.voiceSteals = counters.voiceSteals.load(std::memory_order_relaxed);
+  telemetry.governorSteals =
+      governor.stolenCount.load(std::memory_order_relaxed);
+  telemetry.governorCulls =
+      governor.culledCount.load(std::memory_order_relaxed);
+  telemetry.peakScheduledEvents =
+      counters.peakScheduledEvents.load(std::memory_order_relaxed);
+  telemetry.scheduleOverflows =
+      counters.scheduleOverflows.load(std::memory_order_relaxed);
+  return telemetry;
+}
+
+void resetEngineTelemetry(Engine &engine) {
+  engine.telemetry.isResetRequested.store(true, std::memory_order_relaxed);
+}
+
+void setQualityMode(Engine &engine, QualityMode quality) {
+  // Voice workers read the pool's tier mid-block: posted like the control
+  // rate
+  engine.pendingQuality.store(static_cast<uint32_t>(quality) + 1,
+                              std::memory_order_release);
+}
+
+void setControlRate(Engine &engine, uint32_t blockSize,
+                    uint32_t fastBlockSize) {
+  // renderChunk reads both fields mid-block: posted, applied at the next
+  // block boundary
+  engine.pendingControlRate.store(packControlRate(blockSize, fastBlockSize),
+                                  std::memory_order_release);
+}
+
+void setVoiceWorkerHooks(Engine &engine,
+                         const voices::WorkerThreadHooks &hooks) {
+  if (engine.voicePool.workers)
+    voices::setWorkerThreadHooks(*engine.voicePool.workers, hooks);
+}
+
+void disposeEngine(Engine *engine) {
+  if (!engine)
     return;
 
+  for (float *&buffer : engine->poolBuffers) {
+    freeBuffer(buffer);
+    buffer = nullptr;
+  }
+  engine->maxFrames = 0;
+
+  scratch::disposeScratchArena(engine->scratch);
+  fx::disposeFXChain(engine->fxChain);
+  for (dsp::resampler::Resampler &resampler : engine->resamplers)
+    dsp::resampler::disposeResampler(resampler);
+
+  voices::disposeVoiceWorkers(engine->voicePool.workers);
+  engine->voicePool.workers = nullptr;
+
+  patch::disposePatches(*engine);
+  delete[] engine->patchShadows;
+  engine->patchShadows = nullptr;
+
+  delete engine;
+}
+
+void printScratchReport(const Engine &engine) {
+  scratch::printScratchReport(engine.scratch, "engine");
+
+  const voices::VoiceWorkers *workers = engine.voicePool.workers;
+  if (!workers)
+    return;
+
+  for (uint32_t i = 0; i < workers->numWorkers; i++) {
+    char name[32];
+    snprintf(name, sizeof(name), "worker %u", i);
+    scratch::printScratchReport(workers->slots[i].scratch, name);
+  }
+}
+
+// ==== <Layout Helpers> ====
+namespace {
+void printLayoutRow(const char *name, const void *base, const void *member,
+                    size_t size) {
+  auto offset = static_cast<size_t>(static_cast<const char *>(member) -
+                                    static_cast<const char *>(base));
+
+  printf("  %-32s offset %6zu  size %6zu%s\n", name, offset, size,
+         offset % CACHE_LINE_SIZE == 0 ? "" : "  (unaligned)");
+}
+} // namespace
+// ==== </Layout Helpers> ====
+
+void printEngineLayout(const Engine &engine) {
+  printf("Engine: %zu bytes (align %zu)\n", sizeof(Engine), alignof(Engine));
+
+#define LAYOUT_ROW(member)                                                     \
+  printLayoutRow(#member, &engine, &engine.member, sizeof(engine.member))
+
+  // Hot: every block
+  LAYOUT_ROW(scratch);
+  LAYOUT_ROW(voicePool);
+  LAYOUT_ROW(voicePool.activeIndices);
+  LAYOUT_ROW(voicePool.velocities);
+  LAYOUT_ROW(voicePool.fadeGains);
+  LAYOUT_ROW(voicePool.osc1);
+  LAYOUT_ROW(voicePool.osc2);
+  LAYOUT_ROW(voicePool.osc3);
+  LAYOUT_ROW(voicePool.subOsc);
+  LAYOUT_ROW(voicePool.noise);
+  LAYOUT_ROW(voicePool.modMatrix);
+  LAYOUT_ROW(voicePool.modMatrix.destValues);
+  LAYOUT_ROW(voicePool.fmMatrix);
+  LAYOUT_ROW(voicePool.ampEnv);
+  LAYOUT_ROW(voicePool.filterEnv);
+  LAYOUT_ROW(voicePool.modEnv);
+  LAYOUT_ROW(voicePool.svf);
+  LAYOUT_ROW(voicePool.ladder);
+  LAYOUT_ROW(voicePool.lfo1);
+  LAYOUT_ROW(voicePool.lfo2);
+  LAYOUT_ROW(voicePool.lfo3);
+
+  // Cold: noteOn/noteOff, param and event handling
+  LAYOUT_ROW(voicePool.midiNotes);
+  LAYOUT_ROW(voicePool.noteLists);
+  LAYOUT_ROW(fxChain);
+  LAYOUT_ROW(arp);
+  LAYOUT_ROW(governor);
+  LAYOUT_ROW(telemetry);
+  LAYOUT_ROW(paramBindings);
+  LAYOUT_ROW(scheduledEvents);
+
+#undef LAYOUT_ROW
+
+  // Separate heap blocks (allocated once in createEngine)
+  printf("Heap: poolBuffers %zu, scratch %zu, delay %zu bytes\n",
+         STEREO_CHANNELS * static_cast<size_t>(engine.maxFrames) *
+             sizeof(float),
+         engine.scratch.capacity,
+         STEREO_CHANNELS * (engine.fxChain.delay.lines[0].mask + 1) *
+             sizeof(float));
+
+  // A render rate the resampler can't do falls back to the device rate
+  printf("Rates: render %.0f Hz, output %.0f Hz (%s)\n",
+         static_cast<double>(engine.sampleRate),
+         static_cast<double>(engine.outputSampleRate),
+         engine.isResampling ? "resampled" : "not resampled");
+}
+
+// ==== <Event Helpers> ====
+namespace {
+
+void applyParamEvent(Engine &engine, const ParamEvent &event) {
+  param::bindings::setParamValueByID(engine, static_cast<ParamID>(event.id),
+                                     event.value);
+
+  // Published once at the end of the block (see patch::publishPatchShadow)
+  engine.isPatchShadowStale = true;
+}
+
+// Straight to the voice pool (keys, or the arpeggiator's notes)
+void playNoteEvent(Engine &engine, const NoteEvent &event) {
   if (event.type == synth_io::NoteEventType::NoteOff) {
-    voices::releaseVoice(voicePool, event.midiNote);
+    voices::releaseVoice(engine.voicePool, event.midiNote, event.channel);
   } else {
-    voices::handleNoteOn(voicePool, event.midiNote, event.velocity, noteCount++,
-                         sampleRate);
+    // New voices copy envelope/filter state, bring it up to date first
+    param::bindings::updateDirtyModules(engine);
+    voices::handleNoteOn(engine.voicePool, event.midiNote, event.velocity,
+                         engine.noteCount++, engine.sampleRate, event.channel);
+
+    // Over the current voice cap: fade out the quietest (never this note)
+    if (engine.governor.enabled)
+      governor::enforceVoiceCap(engine.governor, engine.voicePool);
   }
 }
 
+void applyNoteEvent(Engine &engine, const NoteEvent &event) {
+  if (!event.midiNote)
+    return;
+
+  // Arp on: keys feed it. Note-offs still reach the pool, for voices
+  // started before it was switched on
+  if (engine.arp.enabled) {
+    if (event.type == synth_io::NoteEventType::NoteOn) {
+      arp::arpNoteOn(engine.arp, event);
+      return;
+    }
+    arp::arpNoteOff(engine.arp, event);
+  }
+
+  playNoteEvent(engine, event);
+}
+
+void applyScheduledEvent(Engine &engine, const ScheduledEvent &event) {
+  if (event.isNote)
+    applyNoteEvent(engine, event.note);
+  else
+    applyParamEvent(engine, event.param);
+}
+
+// Stable insert by frame (events on the same frame keep arrival order)
+bool scheduleEvent(Engine &engine, const ScheduledEvent &event) {
+  if (engine.scheduledCount >= Engine::MAX_SCHEDULED_EVENTS) {
+    engine.scheduleOverflowCount++;
+    return false;
+  }
+
+  uint32_t i = engine.scheduledCount++;
+  while (i > 0 &&
+         engine.scheduledEvents[i - 1].frameOffset > event.frameOffset) {
+    engine.scheduledEvents[i] = engine.scheduledEvents[i - 1];
+    i--;
+  }
+  engine.scheduledEvents[i] = event;
+
+  return true;
+}
+
+} // namespace
+// ==== </Event Helpers> ====
+
+// ==== <Render Helpers> ====
+namespace {
+
+// Control rate of the next block: fast while routed sources move fast
+uint32_t selectControlBlockSize(const Engine &engine) {
+  if (engine.fastControlBlockSize == 0 ||
+      engine.fastControlBlockSize == engine.controlBlockSize)
+    return engine.controlBlockSize;
+
+  return voices::hasFastModulation(engine.voicePool, engine.controlBlockSize)
+             ? engine.fastControlBlockSize
+             : engine.controlBlockSize;
+}
+
+// Once per processAudioBlock: audio thread counts -> TelemetryCounters
+// (_scheduledEvents_: events this block held)
+void publishTelemetry(Engine &engine, uint32_t scheduledEvents) {
+  TelemetryCounters &counters = engine.telemetry;
+  VoicePool &pool = engine.voicePool;
+
+  if (counters.isResetRequested.exchange(false, std::memory_order_relaxed)) {
+    pool.stealCount = 0;
+    pool.peakActiveCount = pool.activeCount;
+    engine.scheduleOverflowCount = 0;
+    counters.peakScheduledEvents.store(0, std::memory_order_relaxed);
+    engine.governor.stolenCount.store(0, std::memory_order_relaxed);
+    engine.governor.culledCount.store(0, std::memory_order_relaxed);
+  }
+
+  counters.activeVoices.store(pool.activeCount, std::memory_order_relaxed);
+  counters.peakActiveVoices.store(pool.peakActiveCount,
+                                  std::memory_order_relaxed);
+  counters.voiceSteals.store(pool.stealCount, std::memory_order_relaxed);
+  counters.scheduleOverflows.store(engine.scheduleOverflowCount,
+                                   std::memory_order_relaxed);
+
+  // Only this thread writes, so a plain load/store pair is enough
+  if (scheduledEvents >
+      counters.peakScheduledEvents.load(std::memory_order_relaxed))
+    counters.peakScheduledEvents.store(scheduledEvents,
+                                       std::memory_order_relaxed);
+}
+
+// Arp notes due on this frame, straight to the voices
+void runArpeggiator(Engine &engine) {
+  SYNTH_TRACE_SCOPE("runArpeggiator");
+  NoteEvent events[arp::MAX_ARP_EVENTS];
+  uint32_t count =
+      arp::runArp(engine.arp, engine.sampleRate, engine.tempo, events);
+  for (uint32_t i = 0; i < count; i++)
+    playNoteEvent(engine, events[i]);
+}
+
+/* Renders frames [chunkStart, chunkEnd) of this call into _chunk_ (L/R,
+ * pointing at frame chunkStart), split at the control rate, at scheduled
+ * event frames and at arpeggiator steps/gates
+ */
+void renderChunk(Engine &engine, uint32_t chunkStart, uint32_t chunkEnd,
+                 uint32_t &nextEvent, float *const *chunk) {
+  uint32_t frame = chunkStart;
+  while (frame < chunkEnd) {
+    while (nextEvent < engine.scheduledCount &&
+           engine.scheduledEvents[nextEvent].frameOffset <= frame)
+      applyScheduledEvent(engine, engine.scheduledEvents[nextEvent++]);
+
+    // After the events: a key pressed on this frame plays its step here
+    bool isArpActive = !arp::isArpIdle(engine.arp);
+    if (isArpActive)
+      runArpeggiator(engine);
+
+    // Recompute derived param data once per boundary (not per event)
+    {
+      SYNTH_TRACE_SCOPE("updateDirtyModules");
+      param::bindings::updateDirtyModules(engine);
+    }
+
+    uint32_t blockEnd =
+        std::min(frame + selectControlBlockSize(engine), chunkEnd);
+    if (nextEvent < engine.scheduledCount)
+      blockEnd =
+          std::min(blockEnd, engine.scheduledEvents[nextEvent].frameOffset);
+    if (isArpActive) {
+      // At least one frame: a zero gate still moves the clock
+      uint32_t untilArp =
+          std::max(arp::framesUntilArpEvent(engine.arp), uint32_t{1});
+      if (untilArp < blockEnd - frame)
+        blockEnd = frame + untilArp;
+    }
+
+    float *block[STEREO_CHANNELS] = {chunk[0] + (frame - chunkStart),
+                                     chunk[1] + (frame - chunkStart)};
+    {
+      SYNTH_TRACE_SCOPE("processVoices");
+      voices::processVoices(engine.voicePool, block[0], block[1],
+                            blockEnd - frame, engine.scratch);
+    }
+    {
+      SYNTH_TRACE_SCOPE("processFXChain");
+      fx::processFXChain(engine.fxChain, block, blockEnd - frame,
+                         engine.scratch);
+    }
+    {
+      // TODO(nico): Basic soft clip for now.
+      // Mainly for protection and not as an effect: last, so the FX output
+      // (delay feedback, reverb build up) is covered too
+      SYNTH_TRACE_SCOPE("softClipOutput");
+      const dsp::dispatch::KernelTable &kernels = dsp::dispatch::kernels();
+      for (float *channel : block)
+        kernels.softClipFastBlock(channel, channel, blockEnd - frame,
+                                  engine.voicePool.masterGain);
+    }
+    arp::advanceArp(engine.arp, blockEnd - frame);
+    frame = blockEnd;
+  }
+}
+
+// Mono device: (L + R) / 2 (centered voices come out unchanged)
+void foldToMono(float *output, const float *const *pair, uint32_t numFrames) {
+  SYNTH_TRACE_SCOPE("foldToMono");
+  const float *left = pair[0];
+  const float *right = pair[1];
+  for (uint32_t s = 0; s < numFrames; s++)
+    output[s] = (left[s] + right[s]) * 0.5f;
+}
+
+// Channels past the pair repeat it (L on even, R on odd channels)
+void copyToExtraChannels(float **outputBuffer, size_t numChannels,
+                         uint32_t outputStart, uint32_t numFrames) {
+  if (numChannels <= STEREO_CHANNELS)
+    return;
+
+  SYNTH_TRACE_SCOPE("copyToOutput");
+  size_t numBytes = numFrames * sizeof(float);
+  for (size_t ch = STEREO_CHANNELS; ch < numChannels; ch++)
+    std::memcpy(outputBuffer[ch] + outputStart,
+                outputBuffer[ch % STEREO_CHANNELS] + outputStart, numBytes);
+}
+
+/* Render rate != device rate: the call's render frames (exact, from the
+ * resampler position) are rendered in maxFrames chunks, each chunk is
+ * resampled into as much output as it covers
+ * - scheduled frame offsets are mapped to render frames up front (the same
+ *   position math, so events stay sample accurate at the render rate)
+ * - mono device: folded before resampling (one resampler runs)
+ */
+void renderResampled(Engine &engine, float **outputBuffer, size_t numChannels,
+                     uint32_t totalFrames, uint32_t &nextEvent) {
+  dsp::resampler::Resampler *resamplers = engine.resamplers;
+  const uint32_t renderFrames =
+      dsp::resampler::getResamplerInputFrames(resamplers[0], totalFrames);
+  const uint32_t numResampled =
+      numChannels >= STEREO_CHANNELS ? STEREO_CHANNELS : 1;
+
+  for (uint32_t i = 0; i < engine.scheduledCount; i++) {
+    uint32_t &offset = engine.scheduledEvents[i].frameOffset;
+    offset = dsp::resampler::getResamplerInputFrames(
+        resamplers[0], std::min(offset, totalFrames));
+  }
+
+  uint32_t renderFrame = 0;
+  uint32_t outputStart = 0;
+  while (outputStart < totalFrames) {
+    if (renderFrame < renderFrames) {
+      uint32_t chunkEnd =
+          std::min(renderFrame + engine.maxFrames, renderFrames);
+      uint32_t chunkFrames = chunkEnd - renderFrame;
+      renderChunk(engine, renderFrame, chunkEnd, nextEvent,
+                  engine.poolBuffers);
+
+      if (numResampled == 1)
+        foldToMono(engine.poolBuffers[0], engine.poolBuffers, chunkFrames);
+
+      for (uint32_t c = 0; c < numResampled; c++)
+        dsp::resampler::pushResamplerInput(resamplers[c],
+                                           engine.poolBuffers[c], chunkFrames);
+      renderFrame = chunkEnd;
+    }
+
+    // Everything left once the last chunk is in
+    uint32_t outputEnd =
+        renderFrame < renderFrames
+            ? std::min(outputStart + dsp::resampler::getResamplerOutputFrames(
+                                         resamplers[0]),
+                       totalFrames)
+            : totalFrames;
+    if (outputEnd == outputStart)
+      continue;
+
+    // Resample straight into the device channels
+    {
+      SYNTH_TRACE_SCOPE("resampleOutput");
+      for (uint32_t c = 0; c < numResampled; c++)
+        dsp::resampler::processResampler(resamplers[c],
+                                         outputBuffer[c] + outputStart,
+                                         outputEnd - outputStart);
+    }
+    copyToExtraChannels(outputBuffer, numChannels, outputStart,
+                        outputEnd - outputStart);
+
+    outputStart = outputEnd;
+  }
+}
+
+} // namespace
+// ==== </Render Helpers> ====
+
+void Engine::processParamEvent(const ParamEvent &event) {
+  if (event.frameOffset > 0 &&
+      scheduleEvent(*this, {event.frameOffset, false, {}, event}))
+    return;
+
+  // Frame 0 (or schedule full): apply before the block renders
+  applyParamEvent(*this, event);
+}
+
+void Engine::processNoteEvent(const synth_io::NoteEvent &event) {
+  if (event.frameOffset > 0 &&
+      scheduleEvent(*this, {event.frameOffset, true, event, {}}))
+    return;
+
+  // Frame 0 (or schedule full): apply before the block renders
+  applyNoteEvent(*this, event);
+}
+
+void Engine::processControllerEvent(const ControllerEvent &event) {
+  controllers::setControllerTarget(voicePool.controllers, event.id,
+                                   event.value);
+}
+
 void Engine::processAudioBlock(float **outputBuffer, size_t numChannels,
                                size_t numFrames) {
   /* NOTE(nico): Use internal Engine block size to allow processing of
    * expensive calculation that need to occur more often than once per audio
    * buffer block but NOT on every sample either.  E.g. Modulation
    *
-   * TODO(nico): mess with ENGINE_BLOCK_SIZE value (currently 64) to see
-   * how it effects things
+   * The block size is the control rate (EngineConfig::controlBlockSize,
+   * optionally shorter while modulation moves fast).
+   *
+   * Blocks are also split at scheduled event frames, so notes/params land
+   * on their exact frame instead of the start of the buffer.
+   *
+   * Stereo outputs are rendered in place; otherwise host buffers larger
+   * than maxFrames are rendered in maxFrames chunks (scheduled frame
+   * offsets are relative to the whole buffer).
+   *
+   * With a separate render rate the chunks are resampled to the device
+   * rate on the way out (see renderResampled).
    */
-  uint32_t offset = 0;
-  while (offset < numFrames) {
-    uint32_t blockSize =
-        std::min(ENGINE_BLOCK_SIZE, static_cast<uint32_t>(numFrames) - offset);
-    voices::processVoices(voicePool, poolBuffer + offset, blockSize);
-    offset += blockSize;
+  auto totalFrames = static_cast<uint32_t>(numFrames);
+  uint32_t nextEvent = 0;
+  const uint32_t heldEvents = scheduledCount;
+
+  // Voice governor: the block is timed against its deadline
+  // (steady_clock is a plain counter read, same as synth_io's load meter)
+  auto startTime = std::chrono::steady_clock::time_point{};
+  if (governor.enabled) {
+    startTime = std::chrono::steady_clock::now();
+    SYNTH_TRACE_SCOPE("cullInaudibleVoices");
+    governor::cullInaudibleVoices(governor, voicePool);
   }
 
-  for (size_t frame = 0; frame < numFrames; frame++) {
-    for (size_t ch = 0; ch < numChannels; ch++) {
-      outputBuffer[ch][frame] = poolBuffer[frame];
+  // Nothing allocated from the arena outlives a processAudioBlock call
+  scratch::resetScratchArena(scratch);
+
+  // Program change: one pointer swap, the patch was built off this thread
+  patch::applyPendingPatch(*this);
+  applyPendingWavetables(*this);
+  applyPendingControlRate(*this);
+  applyPendingQuality(*this);
+
+  // Snapshots: plain copies at this boundary (A/B, live capture)
+  snapshot::applyPendingSnapshots(*this);
+
+  if (isResampling) {
+    renderResampled(*this, outputBuffer, numChannels, totalFrames, nextEvent);
+  } else if (numChannels >= STEREO_CHANNELS) {
+    // Voices + FX write the device's L/R buffers in place (no copy pass)
+    renderChunk(*this, 0, totalFrames, nextEvent, outputBuffer);
+    copyToExtraChannels(outputBuffer, numChannels, 0, totalFrames);
+  } else {
+    uint32_t chunkStart = 0;
+    while (chunkStart < totalFrames) {
+      uint32_t chunkEnd = std::min(chunkStart + maxFrames, totalFrames);
+      renderChunk(*this, chunkStart, chunkEnd, nextEvent, poolBuffers);
+      if (numChannels == 1)
+        foldToMono(outputBuffer[0] + chunkStart, poolBuffers,
+                   chunkEnd - chunkStart);
+      chunkStart = chunkEnd;
     }
   }
+
+  // Anything past the end of this buffer (shouldn't happen) applies now
+  while (nextEvent < scheduledCount)
+    applyScheduledEvent(*this, scheduledEvents[nextEvent++]);
+  scheduledCount = 0;
+
+  publishTelemetry(*this, heldEvents);
+
+  // Param events only (patches publish when applied)
+  if (isPatchShadowStale) {
+    SYNTH_TRACE_SCOPE("publishPatchShadow");
+    patch::publishPatchShadow(*this);
+  }
+
+  if (governor.enabled) {
+    SYNTH_TRACE_SCOPE("updateVoiceGovernor");
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - startTime;
+    governor::updateVoiceGovernor(governor, voicePool, elapsed.count(),
+                                  static_cast<double>(totalFrames) /
+                                      static_cast<double>(outputSampleRate));
+  }
 }
 
 } // namespace synth
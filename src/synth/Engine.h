@@ -1,17 +1,34 @@
 #pragma once
 
+#include "Arpeggiator.h"
+#include "MasterFX.h"
 #include "ParamBindings.h"
+#include "ScratchArena.h"
+#include "VoiceGovernor.h"
 #include "VoicePool.h"
+#include "VoiceWorkers.h"
 
+#include "dsp/Resampler.h"
 #include "dsp/Waveforms.h"
+#include "dsp/Wavetable.h"
 
 #include "synth_io/Events.h"
 #include "synth_io/SynthIO.h"
 
+#include <atomic>
 #include <cstdint>
+#include <mutex>
 
 namespace synth {
+namespace patch {
+struct Patch;
+}
+namespace snapshot {
+struct Snapshot;
+}
+
 using NoteEvent = synth_io::NoteEvent;
+using ControllerEvent = synth_io::ControllerEvent;
 using ParamEvent = synth_io::ParamEvent;
 
 using VoicePool = voices::VoicePool;
@@ -23,29 +40,250 @@ using ParamBinding = param::bindings::ParamBinding;
 using ParamID = param::bindings::ParamID;
 
 struct EngineConfig : VoiceConfig {
-  float sampleRate = synth_io::DEFAULT_SAMPLE_RATE;
+  float sampleRate = synth_io::DEFAULT_SAMPLE_RATE; // device rate
   uint32_t numFrames = synth_io::DEFAULT_FRAMES;
+
+  // Voices + FX render at this rate, resampled to sampleRate at the output
+  // (0 = render at sampleRate), e.g. 48000 on a 96/192 kHz interface
+  // NOTE: whole Hz; ratios that need more than MAX_RESAMPLER_PHASES fall
+  // back to sampleRate (Engine::isResampling false, see printEngineLayout)
+  float renderSampleRate = 0.0f;
+
+  // Largest buffer processAudioBlock renders in one pass (0 = numFrames)
+  // Bigger host buffers still work, they're rendered in maxFrames chunks
+  uint32_t maxFrames = 0;
+
+  // Voice rendering threads besides the audio thread (0 = single-threaded)
+  uint32_t numVoiceWorkers = 0;
+
+  // Load based voice cap + inaudible voice culling (see VoiceGovernor.h)
+  // NOTE: turn off for offline renders (output must not depend on timing)
+  bool isVoiceGovernorEnabled = true;
+
+  // Control rate: samples per engine block (see Types.h), clamped to
+  // [MIN_CONTROL_BLOCK_SIZE, ENGINE_BLOCK_SIZE]
+  // Smaller = smoother block-rate modulation, more per-block overhead
+  uint32_t controlBlockSize = DEFAULT_CONTROL_BLOCK_SIZE;
+
+  // Adaptive control rate: blocks of this size while a routed mod source
+  // moves fast (see voices::hasFastModulation), 0 = always controlBlockSize
+  // NOTE: engine-wide, block-rate modulation runs over all voices at once
+  uint32_t fastControlBlockSize = 0;
+};
+
+// Voice/event counters since start/last reset (see getEngineTelemetry)
+struct EngineTelemetry {
+  uint32_t activeVoices = 0;
+  uint32_t peakActiveVoices = 0;
+  uint32_t voiceSteals = 0;         // note-ons that took a sounding voice
+  uint32_t governorSteals = 0;      // faded out to meet the voice cap
+  uint32_t governorCulls = 0;       // retired below the audible level
+  uint32_t peakScheduledEvents = 0; // most held for one processAudioBlock
+  uint32_t scheduleOverflows = 0;   // applied at frame 0, schedule was full
+};
+
+// Published side of EngineTelemetry: the audio thread writes once per
+// processAudioBlock, any thread reads (relaxed)
+struct TelemetryCounters {
+  std::atomic<uint32_t> activeVoices{0};
+  std::atomic<uint32_t> peakActiveVoices{0};
+  std::atomic<uint32_t> voiceSteals{0};
+  std::atomic<uint32_t> peakScheduledEvents{0};
+  std::atomic<uint32_t> scheduleOverflows{0};
+
+  // Set by readers, applied by the audio thread (keeps a single writer)
+  std::atomic<bool> isResetRequested{false};
+};
+
+// Event waiting for its frame inside the current audio buffer
+struct ScheduledEvent {
+  uint32_t frameOffset = 0;
+  bool isNote = false;
+  NoteEvent note{};
+  ParamEvent param{};
 };
 
+/* Engine state lives in ONE cache line aligned heap block (createEngine)
+ * - never copied: param bindings point into the engine itself
+ * - render state first, cold param/event tables last
+ *   (see printEngineLayout)
+ */
 struct Engine {
-  static constexpr uint32_t NUM_FRAMES = synth_io::DEFAULT_FRAMES;
-  float sampleRate = synth_io::DEFAULT_SAMPLE_RATE;
+  // Scratch buffers are aligned for SIMD loads/stores (and cache lines)
+  static constexpr size_t BUFFER_ALIGNMENT = CACHE_LINE_SIZE;
 
-  VoicePool voicePool;
-  ParamBinding paramBindings[ParamID::PARAM_COUNT];
+  // Both synth_io queues can drain into one buffer
+  static constexpr uint32_t MAX_SCHEDULED_EVENTS = 512;
+
+  // Applied patches waiting to be freed (at most two retire between two
+  // serialized patch::postPatch calls)
+  static constexpr uint32_t MAX_RETIRED_PATCHES = 4;
+
+  // Patch shadow triple buffer (see patchShadows), the flag marks a
+  // publish nobody has read yet
+  static constexpr uint32_t PATCH_SHADOW_COUNT = 3;
+  static constexpr uint32_t PATCH_SHADOW_FRESH = 1u << 31;
+
+  Engine() = default;
+  Engine(const Engine &) = delete;
+  Engine &operator=(const Engine &) = delete;
+
+  // ==== Render state (hot) ====
+  float sampleRate = synth_io::DEFAULT_SAMPLE_RATE; // render rate
+  float outputSampleRate = synth_io::DEFAULT_SAMPLE_RATE; // device rate
+  float tempo = 120.0f; // BPM (tempo synced FX)
+
+  // L/R render scratch, maxFrames long (allocated once in createEngine)
+  // Only used when the output can't take the pair directly (mono device,
+  // resampling); stereo outputs are rendered in place
+  float *poolBuffers[STEREO_CHANNELS] = {};
+  uint32_t maxFrames = 0;
 
-  // TODO(nico): this probably needs to live on heap
-  // since the number of frames won't be known at compile time
-  float poolBuffer[NUM_FRAMES];
+  // Render rate -> device rate (EngineConfig::renderSampleRate), per channel
+  bool isResampling = false;
+  dsp::resampler::Resampler resamplers[STEREO_CHANNELS] = {};
+
+  // param::bindings::DirtyModule bits, flushed at block boundaries
+  uint32_t dirtyModules = 0;
+
+  // Samples per engine block (EngineConfig, clamped), fast = 0: fixed rate
+  uint32_t controlBlockSize = DEFAULT_CONTROL_BLOCK_SIZE;
+  uint32_t fastControlBlockSize = 0;
 
   uint32_t noteCount = 0;
+  uint32_t scheduledCount = 0;
+
+  // Per-block temporaries of the audio thread (reset every processAudioBlock)
+  scratch::ScratchArena scratch;
+
+  VoicePool voicePool;
+  fx::FXChain fxChain;
+
+  // Holds key notes while enabled, plays them on exact frames (renderChunk)
+  arp::Arpeggiator arp;
 
+  governor::VoiceGovernor governor;
+
+  // Audio thread counts, published per block (see getEngineTelemetry)
+  uint32_t scheduleOverflowCount = 0;
+  TelemetryCounters telemetry;
+
+  // ==== Param/event tables (cold: touched per event, not per sample) ====
+  alignas(CACHE_LINE_SIZE) ParamBinding paramBindings[ParamID::PARAM_COUNT];
+
+  // ==== Sample-accurate events (frameOffset > 0) ====
+  // Sorted by frameOffset (scheduledCount entries), consumed by
+  // processAudioBlock
+  ScheduledEvent scheduledEvents[MAX_SCHEDULED_EVENTS];
+
+  // ==== Program changes (see Patch.h) ====
+  // Posted by patch::postPatch, taken at the start of processAudioBlock
+  std::atomic<patch::Patch *> pendingPatch{nullptr};
+
+  // Applied by the audio thread, freed by the next postPatch
+  std::atomic<patch::Patch *> retiredPatches[MAX_RETIRED_PATCHES] = {};
+
+  // Posting threads only (terminal, preset library prefetch)
+  std::mutex patchPostMutex;
+
+  // Last tuning::Tuning::generation posted (patchPostMutex)
+  uint32_t tuningGeneration = 0;
+
+  // ==== Patch shadow (see patch::publishPatchShadow) ====
+  // Params, routes and tuning as the audio thread last left them, for the
+  // threads that build patches (never read from the live engine)
+  // - triple buffer of PATCH_SHADOW_COUNT patches (values only): the audio
+  //   thread fills shadowWriteIndex and swaps it into shadowMiddleIndex,
+  //   readers swap the latest out into shadowReadIndex (patchPostMutex)
+  patch::Patch *patchShadows = nullptr;
+  uint32_t shadowWriteIndex = 0; // audio thread
+  std::atomic<uint32_t> shadowMiddleIndex{1};
+  uint32_t shadowReadIndex = 2; // patchPostMutex
+
+  // A param event changed a value since the last publish (audio thread)
+  bool isPatchShadowStale = false;
+
+  // ==== Snapshots (see Snapshot.h) ====
+  // Posted by snapshot::postSnapshotCapture/postSnapshotRestore, cleared by
+  // the audio thread once copied (start of processAudioBlock)
+  std::atomic<snapshot::Snapshot *> pendingSnapshotCapture{nullptr};
+  std::atomic<const snapshot::Snapshot *> pendingSnapshotRestore{nullptr};
+
+  // ==== Control rate changes (see setControlRate) ====
+  // Clamped (controlBlockSize << 32 | fastControlBlockSize), 0 = none,
+  // taken at the start of processAudioBlock
+  std::atomic<uint64_t> pendingControlRate{0};
+
+  // ==== Quality changes (see setQualityMode) ====
+  // QualityMode + 1, 0 = none, taken at the start of processAudioBlock
+  std::atomic<uint32_t> pendingQuality{0};
+
+  // ==== Wavetable swaps (see publishWavetable) ====
+  // Per fm_matrix::FMOsc, taken at the start of processAudioBlock
+  std::atomic<const dsp::wavetable::WavetableFrames *>
+      pendingWavetables[fm_matrix::FM_OSC_COUNT] = {};
+
+  // Events with a frameOffset are held until that frame of the next
+  // processAudioBlock call; frameOffset == 0 applies immediately
   void processNoteEvent(const NoteEvent &event);
   void processParamEvent(const ParamEvent &event);
+
+  // Coalesced by synth_io: sets the controller's target, smoothed from the
+  // next block on (see controllers::Controllers)
+  void processControllerEvent(const ControllerEvent &event);
+
+  /* Renders L/R into outputBuffer[0]/[1] directly
+   * - one channel: the pair folded to mono
+   * - more than two: the pair repeats (L on even, R on odd channels)
+   */
   void processAudioBlock(float **outputBuffer, size_t numChannels,
                          size_t numFrames);
 };
 
-Engine createEngine(const EngineConfig &config);
+// Heap allocated (cache line aligned), release with disposeEngine
+// NOTE: allocates, call before the audio session starts
+Engine *createEngine(const EngineConfig &config);
+
+/* Give _osc_ a new table at the start of the next processAudioBlock
+ * - any thread, never blocks (latest publish wins)
+ * - nullptr = back to the built-in saw
+ * NOTE: neither _frames_ nor the tables are copied: both must outlive the
+ * engine's use of them (e.g. tables held by a utils::WavetableImporter)
+ */
+void publishWavetable(Engine &engine, fm_matrix::FMOsc osc,
+                      const dsp::wavetable::WavetableFrames *frames);
+
+// Switch algorithm tier at runtime (takes effect on the next block)
+// NOTE: any thread, lock-free (the latest call before a block wins)
+void setQualityMode(Engine &engine, QualityMode quality);
+
+// Change the control rate at runtime (see EngineConfig::controlBlockSize,
+// fastControlBlockSize), takes effect on the next block
+// NOTE: any thread, lock-free (the latest call before a block wins)
+void setControlRate(Engine &engine, uint32_t blockSize,
+                    uint32_t fastBlockSize);
+
+// Any thread, lock-free (as of the last processAudioBlock)
+EngineTelemetry getEngineTelemetry(const Engine &engine);
+
+// Clears every counter (applied on the next processAudioBlock)
+void resetEngineTelemetry(Engine &engine);
+
+// Hooks run on each voice worker thread (e.g. joining the audio device's
+// workgroup), no-op without workers. Empty hooks: workers leave
+void setVoiceWorkerHooks(Engine &engine,
+                         const voices::WorkerThreadHooks &hooks);
+
+// Releases engine-owned resources (scratch buffers, voice workers, FX memory)
+// and the engine itself
+// NOTE: audio session must be stopped first
+void disposeEngine(Engine *engine);
+
+// Debug: scratch arena high-water marks (audio thread + each voice worker)
+// NOTE: reads worker arenas unsynchronized, call after rendering stopped
+void printScratchReport(const Engine &engine);
+
+// Debug: sizes/offsets of the engine's state blocks (hot vs cold layout)
+void printEngineLayout(const Engine &engine);
 
 } // namespace synth
@@ -2,6 +2,7 @@
 
 #include "dsp/Envelope.h"
 
+#include <cstddef>
 #include <cstdint>
 
 namespace synth::envelope {
@@ -20,18 +21,62 @@ void triggerRelease(Envelope &env, uint32_t voiceIndex) {
   env.progress[voiceIndex] = 0.0f;
 }
 
+void retriggerEnvelope(Envelope &env, uint32_t voiceIndex) {
+  // Attack level == shaped progress (linear: progress itself)
+  env.states[voiceIndex] = EnvelopeStatus::Attack;
+
+  float level = env.levels[voiceIndex];
+  env.progress[voiceIndex] =
+      env.curves.attack ? dsp::envelopes::invertCurve(env.curves.attack, level)
+                        : level;
+}
+
 void updateIncrements(Envelope &env, float sampleRate) {
-  env.attackIncrement = 1.0f / (env.attackMs * 0.001f * sampleRate);
-  env.decayIncrement = 1.0f / (env.decayMs * 0.001f * sampleRate);
-  env.releaseIncrement = 1.0f / (env.releaseMs * 0.001f * sampleRate);
+  env.attackIncrement = computeIncrement(env.attackMs, sampleRate);
+  env.decayIncrement = computeIncrement(env.decayMs, sampleRate);
+  env.releaseIncrement = computeIncrement(env.releaseMs, sampleRate);
+  env.curves = computeCurves(env.attackCurve, env.decayCurve, env.releaseCurve);
+}
+
+float computeIncrement(float timeMs, float sampleRate) {
+  return 1.0f / (timeMs * 0.001f * sampleRate);
+}
+
+StageCurves computeCurves(float attackCurve, float decayCurve,
+                          float releaseCurve) {
+  StageCurves curves{};
+  curves.attack = dsp::envelopes::getCurveTable(attackCurve);
+  curves.decay = dsp::envelopes::getCurveTable(decayCurve);
+  curves.release = dsp::envelopes::getCurveTable(releaseCurve);
+  return curves;
 }
 
 float processEnvelope(Envelope &env, uint32_t voiceIndex) {
   float level = dsp::envelopes::processADSR(
       env.states[voiceIndex], env.levels[voiceIndex], env.progress[voiceIndex],
       env.releaseStartLevels[voiceIndex], env.attackIncrement,
-      env.decayIncrement, env.releaseIncrement, env.sustainLevel);
+      env.decayIncrement, env.releaseIncrement, env.sustainLevel, env.curves);
 
   return level;
 }
+
+float processEnvelope(Envelope &env, uint32_t voiceIndex,
+                      uint32_t numSamples) {
+  auto step = static_cast<float>(numSamples);
+
+  return dsp::envelopes::processADSR(
+      env.states[voiceIndex], env.levels[voiceIndex], env.progress[voiceIndex],
+      env.releaseStartLevels[voiceIndex], env.attackIncrement * step,
+      env.decayIncrement * step, env.releaseIncrement * step, env.sustainLevel,
+      env.curves);
+}
+
+size_t processEnvelopeBlock(Envelope &env, uint32_t voiceIndex, float *output,
+                            size_t numSamples) {
+  return dsp::envelopes::processADSRBlock(
+      env.states[voiceIndex], env.levels[voiceIndex], env.progress[voiceIndex],
+      env.releaseStartLevels[voiceIndex], env.attackIncrement,
+      env.decayIncrement, env.releaseIncrement, env.sustainLevel, output,
+      numSamples, env.curves);
+}
 } // namespace synth::envelope
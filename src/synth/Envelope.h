@@ -4,14 +4,16 @@
 
 #include "dsp/Envelope.h"
 
+#include <cstddef>
 #include <cstdint>
 
 namespace synth::envelope {
 using EnvelopeStatus = dsp::envelopes::Status;
+using StageCurves = dsp::envelopes::StageCurves;
 
 struct Envelope {
   // === Per-voice state (hot data) ===
-  EnvelopeStatus states[MAX_VOICES];    // Current stage
+  alignas(CACHE_LINE_SIZE) EnvelopeStatus states[MAX_VOICES]; // Current stage
   float levels[MAX_VOICES];             // Current output (0.0-1.0)
   float progress[MAX_VOICES];           // Progress in stage (0.0-1.0)
   float releaseStartLevels[MAX_VOICES]; // Captured on release
@@ -22,19 +24,46 @@ struct Envelope {
   float sustainLevel = 0.7f;
   float releaseMs = 200.0f;
 
+  // Stage curvature (-1..1): < 0 slow start, 0 linear, > 0 fast start
+  float attackCurve = 0.0f;
+  float decayCurve = 0.0f;
+  float releaseCurve = 0.0f;
+
   // Pre-calculated increments (updated when UI changes)
   float attackIncrement = 0.0f; // 1.0 / (attackMs * 0.001 * sampleRate)
   float decayIncrement = 0.0f;
   float releaseIncrement = 0.0f;
+
+  // Tables picked from the curvatures (updated with the increments)
+  StageCurves curves{};
 };
 
 void initEnvelope(Envelope &env, uint32_t voiceIndex, float sampleRate);
 
 void triggerRelease(Envelope &env, uint32_t voiceIndex);
 
-// Helper to recalculate increments when ADSR changes
+// Mono retrigger: attack again from the current level (no reset click)
+void retriggerEnvelope(Envelope &env, uint32_t voiceIndex);
+
+// Helper to recalculate increments (and curve tables) when ADSR changes
 void updateIncrements(Envelope &env, float sampleRate);
 
+// Per-sample increment of a stage lasting _timeMs_ (no envelope needed)
+float computeIncrement(float timeMs, float sampleRate);
+
+// Curve tables for the stage curvatures (no envelope needed)
+StageCurves computeCurves(float attackCurve, float decayCurve,
+                          float releaseCurve);
+
 float processEnvelope(Envelope &env, uint32_t voiceIndex);
 
+// Block-rate envelopes: advance _numSamples_ worth of time in one step
+// (keeps timing in ms independent of the block size)
+float processEnvelope(Envelope &env, uint32_t voiceIndex, uint32_t numSamples);
+
+// Sample-rate block: fills _output_ with _numSamples_ levels, per segment
+// Returns the samples before the voice went Idle (numSamples if still active)
+size_t processEnvelopeBlock(Envelope &env, uint32_t voiceIndex, float *output,
+                            size_t numSamples);
+
 } // namespace synth::envelope
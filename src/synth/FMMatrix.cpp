@@ -0,0 +1,86 @@
+#include "FMMatrix.h"
+
+#include "dsp/Math.h"
+
+#include <cstdint>
+
+namespace synth::fm_matrix {
+
+bool setFMAmount(FMMatrix &matrix, FMOsc modulator, FMOsc carrier,
+                 float amount) {
+  if (modulator >= FM_OSC_COUNT || carrier >= FM_OSC_COUNT ||
+      modulator == carrier)
+    return false;
+
+  matrix.amounts[modulator][carrier] = amount;
+  compileFMOrder(matrix);
+  return true;
+}
+
+/* Kahn's topological sort over the non zero routes
+ * Oscillators left over are on (or fed by) a loop: they render in index
+ * order after the rest, keeping only routes from already placed modulators
+ */
+void compileFMOrder(FMMatrix &matrix) {
+  bool isRouted[FM_OSC_COUNT][FM_OSC_COUNT] = {};
+  uint8_t inDegree[FM_OSC_COUNT] = {};
+
+  for (uint8_t m = 0; m < FM_OSC_COUNT; m++) {
+    for (uint8_t c = 0; c < FM_OSC_COUNT; c++) {
+      if (m == c || matrix.amounts[m][c] == 0.0f)
+        continue;
+
+      isRouted[m][c] = true;
+      inDegree[c]++;
+    }
+  }
+
+  bool isPlaced[FM_OSC_COUNT] = {};
+  uint8_t placed = 0;
+
+  // Lowest ready index first: keeps the order stable for equal graphs
+  for (bool progress = true; progress;) {
+    progress = false;
+    for (uint8_t osc = 0; osc < FM_OSC_COUNT; osc++) {
+      if (isPlaced[osc] || inDegree[osc] != 0)
+        continue;
+
+      isPlaced[osc] = true;
+      matrix.order[placed++] = static_cast<FMOsc>(osc);
+      progress = true;
+
+      for (uint8_t c = 0; c < FM_OSC_COUNT; c++) {
+        if (isRouted[osc][c])
+          inDegree[c]--;
+      }
+    }
+  }
+
+  // Loops: drop the routes that point back into the order
+  for (uint8_t osc = 0; osc < FM_OSC_COUNT; osc++) {
+    if (isPlaced[osc])
+      continue;
+
+    for (uint8_t m = 0; m < FM_OSC_COUNT; m++) {
+      if (!isPlaced[m])
+        isRouted[m][osc] = false;
+    }
+
+    isPlaced[osc] = true;
+    matrix.order[placed++] = static_cast<FMOsc>(osc);
+  }
+
+  matrix.isActive = false;
+  for (uint8_t c = 0; c < FM_OSC_COUNT; c++) {
+    matrix.isCarrier[c] = false;
+
+    for (uint8_t m = 0; m < FM_OSC_COUNT; m++) {
+      matrix.activeAmounts[m][c] =
+          isRouted[m][c] ? matrix.amounts[m][c] / dsp::math::TWO_PI_F : 0.0f;
+
+      matrix.isCarrier[c] = matrix.isCarrier[c] || isRouted[m][c];
+    }
+    matrix.isActive = matrix.isActive || matrix.isCarrier[c];
+  }
+}
+} // namespace synth::fm_matrix
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+namespace synth::fm_matrix {
+// ==== FM Operators (the pool's oscillators) ====
+enum FMOsc : uint8_t { Osc1, Osc2, Osc3, SubOsc, FM_OSC_COUNT };
+
+/* Phase modulation between the oscillators (FM as in the DX7/Vital, i.e. PM)
+ *   carrier phase += index / (2 * pi) * modulator output
+ * - amounts[modulator][carrier] are indices in radians, 0 = no route
+ * - modulators render before their carriers (compiled order); routes that
+ *   would close a loop (feedback) are ignored
+ * - ModDest::FMDepth scales every index per voice (1 + mod, >= 0)
+ */
+struct FMMatrix {
+  float amounts[FM_OSC_COUNT][FM_OSC_COUNT] = {}; // self routes unused
+
+  // ==== Compiled by compileFMOrder (read by the audio thread) ====
+  float activeAmounts[FM_OSC_COUNT][FM_OSC_COUNT] = {}; // cycles, loops dropped
+  FMOsc order[FM_OSC_COUNT] = {Osc1, Osc2, Osc3, SubOsc};
+  bool isCarrier[FM_OSC_COUNT] = {};
+  bool isActive = false; // any active route
+};
+
+// Returns false for a self route (index kept out of the matrix)
+bool setFMAmount(FMMatrix &matrix, FMOsc modulator, FMOsc carrier,
+                 float amount);
+
+/* Rebuild the evaluation order and active amounts from matrix.amounts
+ * NOTE: called by setFMAmount; only call directly after editing
+ * matrix.amounts by hand (param bindings write it directly)
+ */
+void compileFMOrder(FMMatrix &matrix);
+
+} // namespace synth::fm_matrix
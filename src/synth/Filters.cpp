@@ -1,13 +1,84 @@
 #include "Filters.h"
 
 #include "dsp/Math.h"
+#include "dsp/Oversampling.h"
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 
 namespace synth::filters {
 
+// ==== Ladder Oversampling Helpers ====
+namespace {
+namespace os = dsp::oversampling;
+
+// f = 2 * sin(π * fc / sr) -> the same cutoff at _factor_ * sr
+float oversampledLadderCoeff(float f, float invFactor) {
+  float theta = std::asin(std::min(f * 0.5f, 1.0f));
+  return 2.0f * std::sin(theta * invFactor);
+}
+
+// upsample -> nonlinear ladder at (1 << factorLog2) * sr -> downsample
+void processLadderOversampled(LadderFilter &filter, float *buffer,
+                              size_t numSamples, uint32_t voiceIndex,
+                              float res, uint32_t factorLog2,
+                              scratch::ScratchArena &scratch) {
+  assert(numSamples <= ENGINE_BLOCK_SIZE);
+
+  scratch::ScratchMark mark = scratch::markScratch(scratch);
+  float *stage1 = scratch::allocateScratch<float>(scratch, numSamples * 2);
+  float *oversampled =
+      scratch::allocateScratch<float>(scratch, numSamples << factorLog2);
+
+  os::OversamplerState &oversampler = filter.oversamplers[voiceIndex];
+  size_t numOversampled = numSamples << factorLog2;
+
+  if (factorLog2 == 1) {
+    os::upsample2x(oversampler.stages[0], buffer, oversampled, numSamples);
+  } else {
+    os::upsample2x(oversampler.stages[0], buffer, stage1, numSamples);
+    os::upsample2x(oversampler.stages[1], stage1, oversampled,
+                   numSamples * 2);
+  }
+
+  // Ramp endpoints converted once per block (2 asin + 2 sin)
+  float invFactor = 1.0f / static_cast<float>(1u << factorLog2);
+  float coeff =
+      oversampledLadderCoeff(filter.prevVoiceCoeffs[voiceIndex], invFactor);
+  float step =
+      (oversampledLadderCoeff(filter.voiceCoeffs[voiceIndex], invFactor) -
+       coeff) /
+      static_cast<float>(numOversampled);
+
+  float drive = filter.drive;
+  LadderState state = filter.voiceStates[voiceIndex];
+
+  for (size_t s = 0; s < numOversampled; s++)
+    oversampled[s] = dsp::filters::processLadderNonlinear(
+        oversampled[s], coeff + step * static_cast<float>(s), res, drive,
+        state);
+
+  filter.voiceStates[voiceIndex] = state;
+
+  if (factorLog2 == 1) {
+    os::downsample2x(oversampler.stages[0], oversampled, buffer, numSamples);
+  } else {
+    os::downsample2x(oversampler.stages[1], oversampled, stage1,
+                     numSamples * 2);
+    os::downsample2x(oversampler.stages[0], stage1, buffer, numSamples);
+  }
+
+  scratch::releaseScratch(scratch, mark);
+}
+} // namespace
+
 // ==== Filter Helpers ====
-float computeEffectiveCutoff(float baseCutoff, float cutoffModOctaves) {
+float computeEffectiveCutoff(float baseCutoff, float cutoffModOctaves,
+                             QualityMode quality) {
+  if (quality == QualityMode::Render)
+    return baseCutoff * std::exp2(cutoffModOctaves);
+
   return baseCutoff * dsp::math::fastExp2(cutoffModOctaves);
 }
 
@@ -24,12 +95,24 @@ void enableSVFilter(SVFilter &filter, bool enable) {
 
 void initSVFilter(SVFilter &filter, size_t voiceIndex) {
   filter.voiceStates[voiceIndex] = SVFState{};
+
+  // New voices start from the unmodulated coefficients (no ramp from the
+  // previous note)
+  filter.voiceCoeffs.a1[voiceIndex] = filter.coeffs.a1;
+  filter.voiceCoeffs.a2[voiceIndex] = filter.coeffs.a2;
+  filter.voiceCoeffs.a3[voiceIndex] = filter.coeffs.a3;
+  filter.voiceCoeffs.k[voiceIndex] = filter.coeffs.k;
 }
 
 void updateSVFCoefficients(SVFilter &filter, float invSampleRate) {
-  float Q = 0.5f + filter.resonance * 20.0f;
   filter.coeffs =
-      dsp::filters::computeSVFCoeffs(filter.cutoff, Q, invSampleRate);
+      computeSVFCoefficients(filter.cutoff, filter.resonance, invSampleRate);
+}
+
+SVFCoeffs computeSVFCoefficients(float cutoff, float resonance,
+                                 float invSampleRate) {
+  float Q = 0.5f + resonance * 20.0f;
+  return dsp::filters::computeSVFCoeffs(cutoff, Q, invSampleRate);
 }
 
 // Use when NOT passing modulation values (cutoff and/or resonance)
@@ -54,11 +137,18 @@ float processSVFilter(SVFilter &filter, float input, uint32_t voiceIndex) {
   return out.lp;
 }
 
-// Use when passing modulation values (cutoff and/or resonance)
-float processSVFilter(SVFilter &filter, float input, uint32_t voiceIndex,
-                      float cutoffHz, float resonance, float invSampleRate) {
-  if (!filter.enabled)
-    return input;
+// ==== SVF Block Processing ====
+void updateSVFVoiceCoeffs(SVFilter &filter, uint32_t voiceIndex,
+                          float cutoffHz, float resonance,
+                          float invSampleRate) {
+  SVFVoiceCoeffs &cur = filter.voiceCoeffs;
+  SVFVoiceCoeffs &prev = filter.prevVoiceCoeffs;
+
+  // Last block's target is this block's starting point
+  prev.a1[voiceIndex] = cur.a1[voiceIndex];
+  prev.a2[voiceIndex] = cur.a2[voiceIndex];
+  prev.a3[voiceIndex] = cur.a3[voiceIndex];
+  prev.k[voiceIndex] = cur.k[voiceIndex];
 
   bool isModulated = std::abs(filter.cutoff - cutoffHz) > 0.001f ||
                      std::abs(filter.resonance - resonance) > 0.001f;
@@ -68,21 +158,82 @@ float processSVFilter(SVFilter &filter, float input, uint32_t voiceIndex,
                         cutoffHz, 0.5f + resonance * 20.0f, invSampleRate)
                   : filter.coeffs;
 
-  SVFOutputs out =
-      dsp::filters::processSVF(input, coeffs, filter.voiceStates[voiceIndex]);
+  cur.a1[voiceIndex] = coeffs.a1;
+  cur.a2[voiceIndex] = coeffs.a2;
+  cur.a3[voiceIndex] = coeffs.a3;
+  cur.k[voiceIndex] = coeffs.k;
+}
+
+// ==== SVF Block Helpers ====
+namespace {
+template <SVFMode Mode> float selectSVFOutput(const SVFOutputs &out) {
+  if constexpr (Mode == SVFMode::HP)
+    return out.hp;
+  else if constexpr (Mode == SVFMode::BP)
+    return out.bp;
+  else if constexpr (Mode == SVFMode::Notch)
+    return out.lp + out.hp;
+  else
+    return out.lp;
+}
+
+// One instance per mode: the output tap is resolved at compile time
+template <SVFMode Mode>
+void processSVFilterBlockMode(SVFilter &filter, float *buffer,
+                              size_t numSamples, uint32_t voiceIndex) {
+  const SVFVoiceCoeffs &cur = filter.voiceCoeffs;
+  const SVFVoiceCoeffs &prev = filter.prevVoiceCoeffs;
+
+  float invNumSamples = 1.0f / static_cast<float>(numSamples);
+
+  SVFCoeffs coeffs = {prev.a1[voiceIndex], prev.a2[voiceIndex],
+                      prev.a3[voiceIndex], prev.k[voiceIndex]};
+  SVFCoeffs steps = {(cur.a1[voiceIndex] - coeffs.a1) * invNumSamples,
+                     (cur.a2[voiceIndex] - coeffs.a2) * invNumSamples,
+                     (cur.a3[voiceIndex] - coeffs.a3) * invNumSamples,
+                     (cur.k[voiceIndex] - coeffs.k) * invNumSamples};
+
+  // Local copy keeps the recursive state in registers
+  SVFState state = filter.voiceStates[voiceIndex];
+
+  for (size_t s = 0; s < numSamples; s++) {
+    float t = static_cast<float>(s);
+    SVFCoeffs c = {coeffs.a1 + steps.a1 * t, coeffs.a2 + steps.a2 * t,
+                   coeffs.a3 + steps.a3 * t, coeffs.k + steps.k * t};
 
+    SVFOutputs out = dsp::filters::processSVF(buffer[s], c, state);
+    buffer[s] = selectSVFOutput<Mode>(out);
+  }
+
+  filter.voiceStates[voiceIndex] = state;
+}
+} // namespace
+
+void processSVFilterBlock(SVFilter &filter, float *buffer, size_t numSamples,
+                          uint32_t voiceIndex) {
+  if (!filter.enabled || numSamples == 0)
+    return;
+
+  // Mode resolved once per block, not per sample
   switch (filter.mode) {
   case SVFMode::MODE_COUNT:
   case SVFMode::LP:
-    return out.lp;
+    processSVFilterBlockMode<SVFMode::LP>(filter, buffer, numSamples,
+                                          voiceIndex);
+    return;
   case SVFMode::HP:
-    return out.hp;
+    processSVFilterBlockMode<SVFMode::HP>(filter, buffer, numSamples,
+                                          voiceIndex);
+    return;
   case SVFMode::BP:
-    return out.bp;
+    processSVFilterBlockMode<SVFMode::BP>(filter, buffer, numSamples,
+                                          voiceIndex);
+    return;
   case SVFMode::Notch:
-    return out.lp + out.hp;
+    processSVFilterBlockMode<SVFMode::Notch>(filter, buffer, numSamples,
+                                             voiceIndex);
+    return;
   }
-  return out.lp;
 }
 
 // ==== Ladder Helpers ====
@@ -90,6 +241,7 @@ void enableLadderFilter(LadderFilter &filter, bool enable) {
   if (enable && !filter.enabled) {
     for (uint32_t i = 0; i < MAX_VOICES; i++) {
       filter.voiceStates[i] = dsp::filters::LadderState{};
+      dsp::oversampling::resetOversampler(filter.oversamplers[i]);
     }
   }
   filter.enabled = enable;
@@ -97,11 +249,18 @@ void enableLadderFilter(LadderFilter &filter, bool enable) {
 
 void initLadderFilter(LadderFilter &filter, size_t voiceIndex) {
   filter.voiceStates[voiceIndex] = LadderState{};
+  dsp::oversampling::resetOversampler(filter.oversamplers[voiceIndex]);
+
+  // New voices start from the unmodulated coefficient
+  filter.voiceCoeffs[voiceIndex] = filter.coeff;
 }
 
 void updateLadderCoefficient(LadderFilter &filter, float invSampleRate) {
-  filter.coeff =
-      2.0f * std::sin(dsp::math::PI_F * filter.cutoff * invSampleRate);
+  filter.coeff = computeLadderCoefficient(filter.cutoff, invSampleRate);
+}
+
+float computeLadderCoefficient(float cutoff, float invSampleRate) {
+  return 2.0f * std::sin(dsp::math::PI_F * cutoff * invSampleRate);
 }
 
 // Use when NOT passing modulation values (cutoff and/or resonance)
@@ -120,25 +279,74 @@ float processLadderFilter(LadderFilter &filter, float input,
                                            filter.voiceStates[voiceIndex]);
 }
 
-// Use when passing modulation values (cutoff and/or resonance)
-float processLadderFilter(LadderFilter &filter, float input,
-                          uint32_t voiceIndex, float cutoffHz, float resonance,
-                          float invSampleRate) {
-  if (!filter.enabled)
-    return input;
+// ==== Ladder Block Processing ====
+void updateLadderVoiceCoeff(LadderFilter &filter, uint32_t voiceIndex,
+                            float cutoffHz, float invSampleRate) {
+  // Last block's target is this block's starting point
+  filter.prevVoiceCoeffs[voiceIndex] = filter.voiceCoeffs[voiceIndex];
 
-  float coeff =
+  filter.voiceCoeffs[voiceIndex] =
       std::abs(filter.cutoff - cutoffHz) > 0.001f
           ? 2.0f * std::sin(dsp::math::PI_F * cutoffHz * invSampleRate)
           : filter.coeff;
+}
+
+uint32_t ladderOversamplingLog2(const LadderFilter &filter,
+                                QualityMode quality) {
+  if (quality == QualityMode::Draft)
+    return 0;
+
+  auto factorLog2 = static_cast<uint32_t>(std::clamp(
+      static_cast<int>(filter.oversampling), 0,
+      static_cast<int>(dsp::oversampling::MAX_FACTOR_LOG2)));
+
+  if (quality == QualityMode::Render)
+    return std::max(factorLog2, 1u);
+
+  return factorLog2;
+}
+
+void processLadderFilterBlock(LadderFilter &filter, float *buffer,
+                              size_t numSamples, uint32_t voiceIndex,
+                              float resonance, scratch::ScratchArena &scratch,
+                              QualityMode quality) {
+  if (!filter.enabled || numSamples == 0)
+    return;
 
   float res = resonance * 4.0f; // map 0–1 to Ladder's 0–4 range
+  float drive = filter.drive;
 
-  return (filter.drive > 1.001f)
-             ? dsp::filters::processLadderNonlinear(
-                   input, coeff, res, filter.drive,
-                   filter.voiceStates[voiceIndex])
-             : dsp::filters::processLadder(input, coeff, res,
-                                           filter.voiceStates[voiceIndex]);
+  // Only driven voices pay for the up/down filters
+  if (drive > 1.001f) {
+    uint32_t factorLog2 = ladderOversamplingLog2(filter, quality);
+    if (factorLog2 > 0) {
+      processLadderOversampled(filter, buffer, numSamples, voiceIndex, res,
+                               factorLog2, scratch);
+      return;
+    }
+  }
+
+  float coeff = filter.prevVoiceCoeffs[voiceIndex];
+  float step = (filter.voiceCoeffs[voiceIndex] - coeff) /
+               static_cast<float>(numSamples);
+
+  // Local copy keeps the recursive state in registers
+  LadderState state = filter.voiceStates[voiceIndex];
+
+  if (drive > 1.001f && quality == QualityMode::Draft) {
+    for (size_t s = 0; s < numSamples; s++)
+      buffer[s] = dsp::filters::processLadderNonlinearFast(
+          buffer[s], coeff + step * static_cast<float>(s), res, drive, state);
+  } else if (drive > 1.001f) {
+    for (size_t s = 0; s < numSamples; s++)
+      buffer[s] = dsp::filters::processLadderNonlinear(
+          buffer[s], coeff + step * static_cast<float>(s), res, drive, state);
+  } else {
+    for (size_t s = 0; s < numSamples; s++)
+      buffer[s] = dsp::filters::processLadder(
+          buffer[s], coeff + step * static_cast<float>(s), res, state);
+  }
+
+  filter.voiceStates[voiceIndex] = state;
 }
 } // namespace synth::filters
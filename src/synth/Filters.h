@@ -1,9 +1,13 @@
 #pragma once
 
+#include "synth/ScratchArena.h"
 #include "synth/Types.h"
 
 #include "dsp/Filters.h"
+#include "dsp/Oversampling.h"
+
 #include <cstddef>
+#include <cstdint>
 
 namespace synth::filters {
 
@@ -13,10 +17,24 @@ using SVFCoeffs = dsp::filters::SVFCoeffs;
 using SVFOutputs = dsp::filters::SVFOutputs;
 
 using LadderState = dsp::filters::LadderState;
+using OversamplerState = dsp::oversampling::OversamplerState;
 
 // ==== State Variable Filter (SVF) ====
+// Per-voice coefficients (SoA), computed once per block from the modulated
+// cutoff/resonance and ramped from the previous block's values
+struct SVFVoiceCoeffs {
+  float a1[MAX_VOICES];
+  float a2[MAX_VOICES];
+  float a3[MAX_VOICES];
+  float k[MAX_VOICES];
+};
+
 struct SVFilter {
-  SVFState voiceStates[MAX_VOICES]; // (hot path)
+  alignas(CACHE_LINE_SIZE) SVFState voiceStates[MAX_VOICES]; // (hot path)
+
+  // Block-rate coefficients (hot path, written once per block)
+  SVFVoiceCoeffs voiceCoeffs{};
+  SVFVoiceCoeffs prevVoiceCoeffs{};
 
   // Cached coefficients (cold, recomputed on param change)
   SVFCoeffs coeffs{};
@@ -31,7 +49,15 @@ struct SVFilter {
 
 // ==== Ladder Filter (Moog Style) ====
 struct LadderFilter {
-  LadderState voiceStates[MAX_VOICES]; // (hot path)
+  alignas(CACHE_LINE_SIZE) LadderState voiceStates[MAX_VOICES]; // (hot path)
+
+  // Block-rate coefficients (hot path, written once per block)
+  float voiceCoeffs[MAX_VOICES] = {};
+  float prevVoiceCoeffs[MAX_VOICES] = {};
+
+  // Half-band up/down history for the oversampled drive path
+  // (only touched by voices rendering with drive > 1)
+  OversamplerState oversamplers[MAX_VOICES];
 
   // Cached coefficient (cold, recomputed on param change)
   // frequency coefficient: 2 * sin(π * cutoff / sampleRate)
@@ -43,36 +69,67 @@ struct LadderFilter {
   float resonance = 0.3f; // 0.0–1.0 (mapped to 0–4 internally)
   float drive =
       1.0f; // 1.0 = neutral, higher = more saturation (nonlinear path)
+  int8_t oversampling = 0; // drive path factor (log2): 0 = 1x, 1 = 2x, 2 = 4x
   bool enabled = false;
 };
 
 // ==== FILTER HELPERS ====
 
-float computeEffectiveCutoff(float baseCutoff, float cutoffModOctaves);
+// Render quality uses libm exp2 instead of fastExp2
+float computeEffectiveCutoff(float baseCutoff, float cutoffModOctaves,
+                             QualityMode quality = QualityMode::Live);
 
 // ==== SVF Helpers ====
 void initSVFilter(SVFilter &filter, size_t voiceIndex);
 
 void updateSVFCoefficients(SVFilter &filter, float invSampleRate);
 
+// Cached coefficients for _cutoff_/_resonance_ (no filter needed)
+SVFCoeffs computeSVFCoefficients(float cutoff, float resonance,
+                                 float invSampleRate);
+
 // No modulation parameters
 float processSVFilter(SVFilter &filter, float input, uint32_t voiceIndex);
 
-// With modulation parameters
-float processSVFilter(SVFilter &filter, float input, uint32_t voiceIndex,
-                      float cutoffHz, float resonance, float invSampleRate);
+// ==== SVF Block Processing (modulated) ====
+// Once per block per voice: tan() and division happen here, NOT per sample
+void updateSVFVoiceCoeffs(SVFilter &filter, uint32_t voiceIndex,
+                          float cutoffHz, float resonance, float invSampleRate);
+
+// In-place, coefficients ramp linearly from the previous block's values
+void processSVFilterBlock(SVFilter &filter, float *buffer, size_t numSamples,
+                          uint32_t voiceIndex);
 
 // ==== Ladder Helpers ====
 void initLadderFilter(LadderFilter &filter, size_t voiceIndex);
 
 void updateLadderCoefficient(LadderFilter &filter, float invSampleRate);
 
+// Cached coefficient for _cutoff_ (no filter needed)
+float computeLadderCoefficient(float cutoff, float invSampleRate);
+
 // No modulation parameters
 float processLadderFilter(LadderFilter &filter, float input,
                           uint32_t voiceIndex);
-// With modulation parameters
-float processLadderFilter(LadderFilter &filter, float input,
-                          uint32_t voiceIndex, float cutoffHz, float resonance,
-                          float invSampleRate);
+
+// ==== Ladder Block Processing (modulated) ====
+// Once per block per voice: sin() happens here, NOT per sample
+void updateLadderVoiceCoeff(LadderFilter &filter, uint32_t voiceIndex,
+                            float cutoffHz, float invSampleRate);
+
+// Oversampling factor (log2) for the drive path
+// Draft never oversamples, Render oversamples at least 2x
+uint32_t ladderOversamplingLog2(const LadderFilter &filter,
+                                QualityMode quality);
+
+// In-place, coefficient ramps linearly from the previous block's value
+// Draft quality drives through math::fastTanh instead of std::tanh
+// Drive > 1 runs at 2x/4x the sample rate (see ladderOversamplingLog2)
+// (rate converted buffers come from _scratch_)
+// NOTE: numSamples must be <= ENGINE_BLOCK_SIZE when oversampling
+void processLadderFilterBlock(LadderFilter &filter, float *buffer,
+                              size_t numSamples, uint32_t voiceIndex,
+                              float resonance, scratch::ScratchArena &scratch,
+                              QualityMode quality = QualityMode::Live);
 
 } // namespace synth::filters
@@ -0,0 +1,49 @@
+#include "Glide.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::glide {
+
+void resetGlide(Glide &glide, uint32_t voiceIndex) {
+  glide.starts[voiceIndex] = 0.0f;
+  glide.steps[voiceIndex] = 0.0f;
+  glide.offsets[voiceIndex] = 0.0f;
+  glide.rates[voiceIndex] = 0.0f;
+}
+
+void startGlide(Glide &glide, uint32_t voiceIndex, float fromSemitones,
+                float sampleRate) {
+  float glideSamples = glide.timeMs * 0.001f * sampleRate;
+  if (glideSamples < 1.0f || fromSemitones == 0.0f) {
+    resetGlide(glide, voiceIndex);
+    return;
+  }
+
+  glide.offsets[voiceIndex] = fromSemitones;
+  glide.rates[voiceIndex] = std::fabs(fromSemitones) / glideSamples;
+}
+
+void processGlide(Glide &glide, const uint32_t *voiceIndices, uint32_t count,
+                  uint32_t blockLength) {
+  auto length = static_cast<float>(blockLength);
+  float invLength = 1.0f / length;
+
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t v = voiceIndices[i];
+    float start = glide.offsets[v];
+
+    // Lands exactly on the note (never overshoots it)
+    float distance = glide.rates[v] * length;
+    float end = 0.0f;
+    if (std::fabs(start) > distance)
+      end = start > 0.0f ? start - distance : start + distance;
+
+    glide.starts[v] = start;
+    glide.steps[v] = (end - start) * invLength;
+    glide.offsets[v] = end;
+  }
+}
+
+} // namespace synth::glide
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Types.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::glide {
+
+/* Portamento (mono/legato voices, see voices::handleNoteOn)
+ * - a retargeted voice starts at its old pitch: _offsets_ holds how far it
+ *   still is from its note (semitones), moved toward 0 once per block
+ * - the render reads each block as a start + per-sample step, added to the
+ *   oscillator pitch ramp (same path as the Osc*Pitch destinations)
+ * - constant time: every interval takes timeMs
+ */
+struct Glide {
+  // === Per-voice state (hot data) ===
+  alignas(CACHE_LINE_SIZE) float starts[MAX_VOICES]; // this block (semitones)
+  float steps[MAX_VOICES];   // per sample, this block
+  float offsets[MAX_VOICES]; // at the next block start
+  float rates[MAX_VOICES];   // semitones per sample (this glide)
+
+  // === Settings (cold data) ===
+  float timeMs = 0.0f; // 0 = jump
+};
+
+// NoteOn (full voice init): no glide
+void resetGlide(Glide &glide, uint32_t voiceIndex);
+
+// Retarget: the voice is _fromSemitones_ away from its new note
+void startGlide(Glide &glide, uint32_t voiceIndex, float fromSemitones,
+                float sampleRate);
+
+// Current distance from the voice's note (semitones), for a glide that
+// starts mid-glide
+inline float currentOffset(const Glide &glide, uint32_t voiceIndex) {
+  return glide.offsets[voiceIndex];
+}
+
+// Advance every voice in voiceIndices[0..count) by one block
+void processGlide(Glide &glide, const uint32_t *voiceIndices, uint32_t count,
+                  uint32_t blockLength);
+
+} // namespace synth::glide
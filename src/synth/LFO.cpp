@@ -0,0 +1,46 @@
+#include "LFO.h"
+#include "Types.h"
+
+#include "dsp/Modulation.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace synth::lfo {
+
+// ==== LFO Helpers ====
+namespace {
+float wrapPhase(float phase) { return phase - std::floor(phase); }
+} // namespace
+
+void initLFO(LFO &lfo, uint32_t voiceIndex) { lfo.phases[voiceIndex] = 0.0f; }
+
+void processLFOBlock(LFO &lfo, const uint32_t *voiceIndices, uint32_t count,
+                     uint32_t numSamples, float invSampleRate, float *output) {
+  float phaseIncrement =
+      lfo.rate * static_cast<float>(numSamples) * invSampleRate;
+
+  // Global: once per block, broadcast to every voice
+  if (!lfo.retrigger) {
+    // Same batch kernel as per voice (identical shapes in both modes)
+    float value = 0.0f;
+    dsp::modulation::processLFOBlock(&lfo.globalPhase, &value, 1, lfo.waveform);
+    for (uint32_t i = 0; i < count; i++)
+      output[i] = value;
+
+    // Free running, also while no voice is playing
+    lfo.globalPhase = wrapPhase(lfo.globalPhase + phaseIncrement);
+    return;
+  }
+
+  // Per voice: gather -> one batch -> advance and scatter
+  alignas(16) float phases[MAX_VOICES];
+  for (uint32_t i = 0; i < count; i++)
+    phases[i] = lfo.phases[voiceIndices[i]];
+
+  dsp::modulation::processLFOBlock(phases, output, count, lfo.waveform);
+
+  for (uint32_t i = 0; i < count; i++)
+    lfo.phases[voiceIndices[i]] = wrapPhase(phases[i] + phaseIncrement);
+}
+} // namespace synth::lfo
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Types.h"
+
+#include "dsp/Waveforms.h"
+
+#include <cstdint>
+
+namespace synth::lfo {
+using WaveformType = dsp::waveforms::WaveformType;
+
+/* Block-rate LFO (bipolar -1.0 to +1.0), feeds ModSrc::LFO1-3
+ * - global (retrigger = false): one free running phase shared by every voice,
+ *   evaluated once per block
+ * - per voice (retrigger = true): each voice has its own phase, reset at
+ *   noteOn; all voices are evaluated as one SoA batch
+ */
+struct LFO {
+  // === Per-voice state (hot data, retrigger only) ===
+  alignas(CACHE_LINE_SIZE) float phases[MAX_VOICES];
+
+  // === Global state ===
+  float globalPhase = 0.0f;
+
+  // === Settings (cold data) ===
+  WaveformType waveform = WaveformType::Sine;
+  float rate = 1.0f; // Hz
+  bool retrigger = false;
+};
+
+// NoteOn: restart the voice's phase
+void initLFO(LFO &lfo, uint32_t voiceIndex);
+
+/* Sample every voice's LFO for this block, then advance by _numSamples_
+ * - _output_[i] is the value for voiceIndices[i] (dense, count rows)
+ * - global mode writes one value to every row
+ */
+void processLFOBlock(LFO &lfo, const uint32_t *voiceIndices, uint32_t count,
+                     uint32_t numSamples, float invSampleRate, float *output);
+
+} // namespace synth::lfo
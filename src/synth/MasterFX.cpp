@@ -0,0 +1,193 @@
+#include "MasterFX.h"
+
+#include "dsp/Delay.h"
+#include "dsp/Effects.h"
+#include "dsp/Reverb.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::fx {
+
+// ==== <FX Helpers> ====
+namespace {
+constexpr float DIVISION_BEATS[] = {
+    4.0f,        // Whole
+    2.0f,        // Half
+    1.0f,        // Quarter
+    0.5f,        // Eighth
+    0.25f,       // Sixteenth
+    1.5f,        // DottedQuarter
+    0.75f,       // DottedEighth
+    2.0f / 3.0f, // TripletQuarter
+    1.0f / 3.0f, // TripletEighth
+};
+static_assert(sizeof(DIVISION_BEATS) / sizeof(DIVISION_BEATS[0]) ==
+                  static_cast<size_t>(DelayDivision::DIVISION_COUNT),
+              "every delay division needs a length");
+
+size_t msToSamples(float ms, float sampleRate) {
+  return static_cast<size_t>(ms * 0.001f * sampleRate);
+}
+
+void updateDelayLength(FXDelay &delay, float sampleRate, float tempo) {
+  float timeMs = delay.timeMs;
+  if (delay.sync && tempo > 0.0f) {
+    auto division = static_cast<DelayDivision>(delay.division);
+    timeMs = delayDivisionBeats(division) * 60000.0f / tempo;
+  }
+
+  timeMs = std::min(timeMs, MAX_DELAY_MS);
+
+  size_t samples = msToSamples(timeMs, sampleRate);
+  delay.delaySamples = std::clamp<size_t>(
+      samples, 1, dsp::delay::maxDelaySamples(delay.lines[0]));
+}
+} // namespace
+// ==== </FX Helpers> ====
+
+void initFXChain(FXChain &chain, float sampleRate, float tempo) {
+  for (dsp::delay::DelayLine &line : chain.delay.lines)
+    line = dsp::delay::createDelayLine(msToSamples(MAX_DELAY_MS, sampleRate));
+  chain.reverb.state = dsp::reverb::createReverb(sampleRate);
+
+  updateFXChain(chain, sampleRate, tempo);
+}
+
+void disposeFXChain(FXChain &chain) {
+  for (dsp::delay::DelayLine &line : chain.delay.lines)
+    dsp::delay::disposeDelayLine(line);
+  dsp::reverb::disposeReverb(chain.reverb.state);
+}
+
+void clearFXChain(FXChain &chain) {
+  for (uint32_t c = 0; c < STEREO_CHANNELS; c++) {
+    chain.dcBlocker.states[c] = 0.0f;
+    dsp::delay::clearDelayLine(chain.delay.lines[c]);
+  }
+  dsp::reverb::clearReverb(chain.reverb.state);
+}
+
+void updateFXChain(FXChain &chain, float sampleRate, float tempo) {
+  Saturator &saturator = chain.saturator;
+  saturator.denormDrive = dsp::effects::denormalizeDrive(saturator.drive);
+  saturator.invDrive = dsp::effects::calcInvDrive(saturator.denormDrive);
+
+  if (chain.delay.lines[0].buffer)
+    updateDelayLength(chain.delay, sampleRate, tempo);
+
+  FXReverb &reverb = chain.reverb;
+  if (reverb.state.lines[0].buffer)
+    dsp::reverb::updateReverb(reverb.state, reverb.size, reverb.decay,
+                              reverb.damping, sampleRate);
+}
+
+bool setFXOrder(FXChain &chain, const FXType *order, uint8_t count) {
+  if (count > MAX_FX_SLOTS)
+    return false;
+
+  bool isUsed[MAX_FX_SLOTS] = {};
+  for (uint8_t i = 0; i < count; i++) {
+    auto index = static_cast<size_t>(order[i]);
+    if (index >= MAX_FX_SLOTS || isUsed[index])
+      return false;
+    isUsed[index] = true;
+  }
+
+  for (uint8_t i = 0; i < count; i++)
+    chain.order[i] = order[i];
+  chain.count = count;
+
+  return true;
+}
+
+float delayDivisionBeats(DelayDivision division) {
+  auto index = static_cast<size_t>(division);
+  if (index >= static_cast<size_t>(DelayDivision::DIVISION_COUNT))
+    return 1.0f; // quarter note
+
+  return DIVISION_BEATS[index];
+}
+
+// ==== Block processing ====
+void processSaturator(Saturator &saturator, const float *const *input,
+                      float *const *output, size_t numSamples) {
+  for (uint32_t c = 0; c < STEREO_CHANNELS; c++)
+    dsp::effects::softClipBlock(input[c], output[c], numSamples,
+                                saturator.denormDrive, saturator.invDrive,
+                                saturator.mix);
+}
+
+void processDCBlocker(DCBlocker &dcBlocker, const float *const *input,
+                      float *const *output, size_t numSamples) {
+  for (uint32_t c = 0; c < STEREO_CHANNELS; c++)
+    dsp::effects::dcBlockBlock(input[c], output[c], numSamples,
+                               dcBlocker.states[c]);
+}
+
+void processDelay(FXDelay &delay, const float *const *input,
+                  float *const *output, size_t numSamples,
+                  scratch::ScratchArena &scratch) {
+  scratch::ScratchMark mark = scratch::markScratch(scratch);
+  float *wet = scratch::allocateScratch<float>(scratch, numSamples);
+
+  for (uint32_t c = 0; c < STEREO_CHANNELS; c++) {
+    dsp::delay::processFeedbackDelayBlock(delay.lines[c], input[c], wet,
+                                          numSamples, delay.delaySamples,
+                                          delay.feedback);
+    dsp::effects::mixDryWetBlock(input[c], wet, output[c], numSamples,
+                                 delay.mix);
+  }
+
+  scratch::releaseScratch(scratch, mark);
+}
+
+void processReverb(FXReverb &reverb, const float *const *input,
+                   float *const *output, size_t numSamples,
+                   scratch::ScratchArena &scratch) {
+  scratch::ScratchMark mark = scratch::markScratch(scratch);
+  float *wetLeft = scratch::allocateScratch<float>(scratch, numSamples);
+  float *wetRight = scratch::allocateScratch<float>(scratch, numSamples);
+
+  dsp::reverb::processReverbBlockStereo(reverb.state, input[0], input[1],
+                                        wetLeft, wetRight, numSamples);
+  dsp::effects::mixDryWetBlock(input[0], wetLeft, output[0], numSamples,
+                               reverb.mix);
+  dsp::effects::mixDryWetBlock(input[1], wetRight, output[1], numSamples,
+                               reverb.mix);
+
+  scratch::releaseScratch(scratch, mark);
+}
+
+void processFXChain(FXChain &chain, float *const *buffers, size_t numSamples,
+                    scratch::ScratchArena &scratch) {
+  for (uint8_t i = 0; i < chain.count; i++) {
+    switch (chain.order[i]) {
+    case FXType::Saturator:
+      if (chain.saturator.enabled)
+        processSaturator(chain.saturator, buffers, buffers, numSamples);
+      break;
+
+    case FXType::DCBlocker:
+      if (chain.dcBlocker.enabled)
+        processDCBlocker(chain.dcBlocker, buffers, buffers, numSamples);
+      break;
+
+    case FXType::Delay:
+      if (chain.delay.enabled)
+        processDelay(chain.delay, buffers, buffers, numSamples, scratch);
+      break;
+
+    case FXType::Reverb:
+      if (chain.reverb.enabled)
+        processReverb(chain.reverb, buffers, buffers, numSamples, scratch);
+      break;
+
+    case FXType::FX_COUNT:
+      break;
+    }
+  }
+}
+
+} // namespace synth::fx
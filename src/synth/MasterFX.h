@@ -0,0 +1,125 @@
+#pragma once
+
+#include "ScratchArena.h"
+#include "Types.h"
+
+#include "dsp/Delay.h"
+#include "dsp/Reverb.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::fx {
+/* Master effects chain (stereo, after the voice pool's protection clip)
+ * - every effect is a block process(in, out, numSamples) over one engine
+ *   block and both channels; in == out is fine, wet/send buffers come from
+ *   the scratch arena
+ * - per channel state (DC blocker, delay lines); the reverb runs one
+ *   network with a stereo output (see dsp::reverb)
+ * - slots run in _order_, disabled effects are skipped (cost nothing)
+ * - delay/reverb memory is allocated once by initFXChain
+ */
+enum class FXType : uint8_t { Saturator, DCBlocker, Delay, Reverb, FX_COUNT };
+
+inline constexpr size_t MAX_FX_SLOTS = static_cast<size_t>(FXType::FX_COUNT);
+
+inline constexpr float MAX_DELAY_MS = 2000.0f;
+
+// Tempo synced delay lengths (FXDelay::division)
+enum class DelayDivision : int8_t {
+  Whole,
+  Half,
+  Quarter,
+  Eighth,
+  Sixteenth,
+  DottedQuarter,
+  DottedEighth,
+  TripletQuarter,
+  TripletEighth,
+  DIVISION_COUNT,
+};
+
+struct Saturator {
+  bool enabled = false;
+  float drive = 0.5f; // normalized (see dsp::effects::denormalizeDrive)
+  float mix = 1.0f;
+
+  // Derived (updateFXChain)
+  float denormDrive = 1.0f;
+  float invDrive = 1.0f;
+};
+
+struct DCBlocker {
+  bool enabled = false;
+  float states[STEREO_CHANNELS] = {};
+};
+
+struct FXDelay {
+  bool enabled = false;
+  float timeMs = 375.0f; // free running length
+  bool sync = false;     // true = length from tempo + division
+  int8_t division = static_cast<int8_t>(DelayDivision::DottedEighth);
+  float feedback = 0.35f;
+  float mix = 0.25f;
+
+  dsp::delay::DelayLine lines[STEREO_CHANNELS];
+  size_t delaySamples = 1; // derived (updateFXChain)
+};
+
+struct FXReverb {
+  bool enabled = false;
+  float size = 0.7f;
+  float decay = 2.0f; // RT60 seconds
+  float damping = 0.4f;
+  float mix = 0.2f;
+
+  dsp::reverb::ReverbState state;
+};
+
+struct FXChain {
+  FXType order[MAX_FX_SLOTS] = {FXType::Saturator, FXType::DCBlocker,
+                                FXType::Delay, FXType::Reverb};
+  uint8_t count = static_cast<uint8_t>(MAX_FX_SLOTS);
+
+  Saturator saturator;
+  DCBlocker dcBlocker;
+  FXDelay delay;
+  FXReverb reverb;
+};
+
+// Allocates the delay lines and reverb network (NOT on the audio thread)
+void initFXChain(FXChain &chain, float sampleRate, float tempo);
+void disposeFXChain(FXChain &chain);
+
+// Silence delay/reverb tails and filter states
+void clearFXChain(FXChain &chain);
+
+// Recompute derived values after param changes (block boundary)
+void updateFXChain(FXChain &chain, float sampleRate, float tempo);
+
+/* Replace the slot order (each effect at most once)
+ * Returns false (and keeps the old order) for invalid/duplicate entries
+ */
+bool setFXOrder(FXChain &chain, const FXType *order, uint8_t count);
+
+// Length of a tempo division in beats (quarter notes)
+float delayDivisionBeats(DelayDivision division);
+
+// ==== Block processing (in-place safe) ====
+// _input_/_output_: STEREO_CHANNELS channel pointers
+void processSaturator(Saturator &saturator, const float *const *input,
+                      float *const *output, size_t numSamples);
+void processDCBlocker(DCBlocker &dcBlocker, const float *const *input,
+                      float *const *output, size_t numSamples);
+void processDelay(FXDelay &delay, const float *const *input,
+                  float *const *output, size_t numSamples,
+                  scratch::ScratchArena &scratch);
+void processReverb(FXReverb &reverb, const float *const *input,
+                   float *const *output, size_t numSamples,
+                   scratch::ScratchArena &scratch);
+
+// Runs every enabled slot in order over both channels (in-place)
+void processFXChain(FXChain &chain, float *const *buffers, size_t numSamples,
+                    scratch::ScratchArena &scratch);
+
+} // namespace synth::fx
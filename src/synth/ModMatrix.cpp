@@ -14,6 +14,7 @@ bool addRoute(ModMatrix &matrix, ModSrc src, ModDest dest, float amount) {
   matrix.routes[matrix.count] = {src, dest, amount};
   matrix.count++;
 
+  compileRoutes(matrix);
   return true;
 }
 
@@ -24,6 +25,7 @@ bool addRoute(ModMatrix &matrix, const ModRoute &route) {
   matrix.routes[matrix.count] = route;
   matrix.count++;
 
+  compileRoutes(matrix);
   return true;
 }
 
@@ -40,6 +42,7 @@ bool removeRoute(ModMatrix &matrix, uint8_t index) {
   matrix.routes[matrix.count].dest = ModDest::NoDest;
   matrix.routes[matrix.count].amount = 0.0f;
 
+  compileRoutes(matrix);
   return true;
 }
 
@@ -51,18 +54,61 @@ bool clearRoutes(ModMatrix &matrix) {
   }
 
   matrix.count = 0;
+
+  compileRoutes(matrix);
   return true;
 }
 
-// ====== Steps Management =======
-void clearModDestSteps(ModMatrix &matrix) {
-  for (uint8_t d = 0; d < ModDest::DEST_COUNT; d++) {
-    for (uint8_t v = 0; v < MAX_VOICES; v++) {
-      matrix.destStepValues[d][v] = 0;
+void compileRoutes(ModMatrix &matrix) {
+  setCompiledRoutes(matrix, buildCompiledRoutes(matrix.routes, matrix.count));
+}
+
+CompiledRoutes buildCompiledRoutes(const ModRoute *routes, uint8_t count) {
+  CompiledRoutes compiled{};
+
+  // Unique destinations (first use order)
+  for (uint8_t r = 0; r < count; r++) {
+    const ModRoute &route = routes[r];
+    if (route.src == ModSrc::NoSrc || route.dest == ModDest::NoDest)
+      continue;
+
+    if (!compiled.isDestRouted[route.dest]) {
+      compiled.isDestRouted[route.dest] = true;
+      compiled.dests[compiled.destCount++] = route.dest;
+    }
+  }
+
+  // Group routes by destination (stable, so summation order is unchanged)
+  for (uint8_t d = 0; d < compiled.destCount; d++) {
+    for (uint8_t r = 0; r < count; r++) {
+      const ModRoute &route = routes[r];
+      if (route.src == ModSrc::NoSrc || route.dest != compiled.dests[d])
+        continue;
+
+      compiled.routes[compiled.count++] = route;
     }
   }
+
+  return compiled;
+}
+
+void setCompiledRoutes(ModMatrix &matrix, const CompiledRoutes &compiled) {
+  // The audio thread only writes routed destinations, clear the rest once
+  for (int d = 0; d < ModDest::DEST_COUNT; d++) {
+    if (!matrix.compiled.isDestRouted[d] || compiled.isDestRouted[d])
+      continue;
+
+    for (uint32_t v = 0; v < MAX_VOICES; v++) {
+      matrix.destValues[d][v] = 0.0f;
+      matrix.prevDestValues[d][v] = 0.0f;
+      matrix.destStepValues[d][v] = 0.0f;
+    }
+  }
+
+  matrix.compiled = compiled;
 }
 
+// ====== Steps Management =======
 void setModDestStep(ModMatrix &matrix, ModDest dest, uint32_t voiceIndex,
                     float invNumSamples) {
   matrix.destStepValues[dest][voiceIndex] =
@@ -108,13 +154,14 @@ const char *modDestToString(ModDest dest) {
   return "unknown";
 }
 
-void parseAddModCommand(std::istringstream &iss, ModMatrix &modMatrix) {
+bool parseAddModCommand(std::istringstream &iss, ModRoute *routes,
+                        uint8_t &count) {
   std::string srcStr, destStr;
   float amount;
 
   if (!(iss >> srcStr >> destStr >> amount)) {
     printf("Usage: mod add <source> <dest> <amount>\n");
-    return;
+    return false;
   }
 
   ModSrc src = modSrcFromString(srcStr.c_str());
@@ -122,57 +169,69 @@ void parseAddModCommand(std::istringstream &iss, ModMatrix &modMatrix) {
 
   if (src == ModSrc::NoSrc) {
     printf("Error: Unknown mod source '%s'\n", srcStr.c_str());
-    return;
+    return false;
   }
   if (dest == ModDest::NoDest) {
     printf("Error: Unknown mod destination '%s'\n", destStr.c_str());
-    return;
+    return false;
   }
 
-  if (!addRoute(modMatrix, src, dest, amount)) {
+  if (count >= MAX_MOD_ROUTES) {
     printf("Error: Mod matrix full (max %d routes)\n", MAX_MOD_ROUTES);
-    return;
+    return false;
   }
 
-  printf("OK: [%d] %s → %s  x%.2f\n", modMatrix.count - 1, srcStr.c_str(),
+  routes[count++] = {src, dest, amount};
+
+  printf("OK: [%d] %s → %s  x%.2f\n", count - 1, srcStr.c_str(),
          destStr.c_str(), amount);
+  return true;
 }
 
-void parseRemoveModCommand(std::istringstream &iss, ModMatrix &modMatrix) {
+bool parseRemoveModCommand(std::istringstream &iss, ModRoute *routes,
+                           uint8_t &count) {
   int index;
 
   if (!(iss >> index) || index < 0) {
     printf("Usage: mod remove <index>\n");
-    return;
+    return false;
   }
 
-  if (!removeRoute(modMatrix, static_cast<uint8_t>(index))) {
-    printf("Error: No route at index %d (count = %d)\n", index,
-           modMatrix.count);
-    return;
+  if (index >= count) {
+    printf("Error: No route at index %d (count = %d)\n", index, count);
+    return false;
   }
 
+  // Same as removeRoute: the last route takes its slot
+  count--;
+  routes[index] = routes[count];
+  routes[count] = ModRoute{};
+
   printf("OK: route %d removed\n", index);
+  return true;
 }
 
-void parseListModCommand(ModMatrix &modMatrix) {
-  const ModMatrix &matrix = modMatrix;
-
-  if (matrix.count == 0) {
+void parseListModCommand(const ModRoute *routes, uint8_t count) {
+  if (count == 0) {
     printf("No active mod routes.\n");
     return;
   }
 
-  printf("Mod routes (%d/%d):\n", matrix.count, MAX_MOD_ROUTES);
-  for (uint8_t i = 0; i < matrix.count; i++) {
-    const ModRoute &r = matrix.routes[i];
+  printf("Mod routes (%d/%d):\n", count, MAX_MOD_ROUTES);
+  for (uint8_t i = 0; i < count; i++) {
+    const ModRoute &r = routes[i];
     printf("  [%d] %-12s → %-20s  x%.2f\n", i, modSrcToString(r.src),
            modDestToString(r.dest), r.amount);
   }
 }
-void parseClearModCommand(ModMatrix &modMatrix) {
-  clearRoutes(modMatrix);
+
+bool parseClearModCommand(ModRoute *routes, uint8_t &count) {
+  for (uint8_t r = 0; r < count; r++)
+    routes[r] = ModRoute{};
+  count = 0;
+
   printf("OK: mod matrix cleared\n");
+  return true;
 }
 
 void parseHelpModCommand() {
@@ -194,21 +253,23 @@ void parseHelpModCommand() {
 } // namespace
 // ==== </ Internal Helpers> ====
 
-void parseModCommand(std::istringstream &iss, ModMatrix &modMatrix) {
+bool parseModCommand(std::istringstream &iss, ModRoute *routes,
+                     uint8_t &count) {
   std::string subcmd;
   iss >> subcmd;
 
+  bool isChanged = false;
   if (subcmd == "add") {
-    parseAddModCommand(iss, modMatrix);
+    isChanged = parseAddModCommand(iss, routes, count);
 
   } else if (subcmd == "remove") {
-    parseRemoveModCommand(iss, modMatrix);
+    isChanged = parseRemoveModCommand(iss, routes, count);
 
   } else if (subcmd == "list") {
-    parseListModCommand(modMatrix);
+    parseListModCommand(routes, count);
 
   } else if (subcmd == "clear") {
-    parseClearModCommand(modMatrix);
+    isChanged = parseClearModCommand(routes, count);
 
   } else if (subcmd == "help") {
     parseHelpModCommand();
@@ -217,6 +278,8 @@ void parseModCommand(std::istringstream &iss, ModMatrix &modMatrix) {
     printf("Error: Unknown mod subcommand '%s'. Try 'mod help'.\n",
            subcmd.c_str());
   }
+
+  return isChanged;
 }
 
 } // namespace synth::mod_matrix
@@ -23,6 +23,17 @@ enum ModSrc {
   Velocity, // 0.0–1.0 from MIDI note-on velocity
   Noise,
 
+  // MIDI controllers — smoothed at block rate (see Controllers.h)
+  ModWheel,        // 0.0–1.0, CC 1
+  PitchBend,       // -1.0–1.0
+  ChannelPressure, // 0.0–1.0, channel aftertouch
+  PolyPressure,    // 0.0–1.0, aftertouch of the voice's own note
+
+  // MPE — the voice's own channel (per-note expression)
+  NoteBend,     // -1.0–1.0
+  NotePressure, // 0.0–1.0
+  NoteSlide,    // 0.0–1.0, CC 74
+
   SRC_COUNT // used to size arrays, not a valid source
 };
 
@@ -50,6 +61,15 @@ enum ModDest {
   Osc3Mix,
   SubOscMix,
 
+  // Wavetable position — units are the 0-1 frame range (bipolar ±1.0)
+  Osc1WTPos,
+  Osc2WTPos,
+  Osc3WTPos,
+  SubOscWTPos,
+
+  // FM index scale — units are linear ±1.0 (index * (1 + mod))
+  FMDepth,
+
   DEST_COUNT // used to size arrays, not a valid dest
 };
 
@@ -64,18 +84,42 @@ struct ModRoute {
   float amount = 0.0f;
 };
 
+// Pitch + wavetable position destinations ramp across the block
+// (prev -> current)
+inline constexpr bool isInterpolatedDest(ModDest dest) {
+  return (dest >= ModDest::Osc1Pitch && dest <= ModDest::SubOscPitch) ||
+         (dest >= ModDest::Osc1WTPos && dest <= ModDest::SubOscWTPos);
+}
+
+/* Routes flattened for the audio thread (rebuilt by compileRoutes)
+ * - NoSrc/NoDest routes dropped
+ * - grouped by destination (route order kept within a group) so each
+ *   routed destination is accumulated once, across all voices
+ */
+struct CompiledRoutes {
+  ModRoute routes[MAX_MOD_ROUTES];
+  uint8_t count = 0;
+
+  // Unique destinations in _routes_ order
+  ModDest dests[ModDest::DEST_COUNT];
+  uint8_t destCount = 0;
+
+  bool isDestRouted[ModDest::DEST_COUNT] = {};
+};
+
 struct ModMatrix {
   ModRoute routes[MAX_MOD_ROUTES];
   uint8_t count = 0;
 
-  // engine block-rate output of pre-pass
-  ModDest2D destValues = {};
+  CompiledRoutes compiled;
+
+  // engine block-rate output of pre-pass (hot: read by every voice render)
+  alignas(CACHE_LINE_SIZE) ModDest2D destValues = {};
 
   // interpolation state, persists between engine blocks
   ModDest2D prevDestValues = {};
 
-  // Stack-local inside processVoices
-  // Need to zero out each loop if I keep it here
+  // Per-sample ramp for interpolated (pitch, position) dests, routed only
   ModDest2D destStepValues = {};
 };
 
@@ -84,8 +128,20 @@ bool addRoute(ModMatrix &matrix, const ModRoute &route);
 bool removeRoute(ModMatrix &matrix, uint8_t index);
 bool clearRoutes(ModMatrix &matrix);
 
+/* Rebuild matrix.compiled from matrix.routes
+ * Destinations that lost their last route are zeroed for every voice.
+ * NOTE: called by every route mutator above; only call directly after
+ * editing matrix.routes by hand
+ */
+void compileRoutes(ModMatrix &matrix);
+
+// The compile step alone (no matrix needed, e.g. building a patch off-thread)
+CompiledRoutes buildCompiledRoutes(const ModRoute *routes, uint8_t count);
+
+// Install _compiled_ (zeroes destinations that lost their last route)
+void setCompiledRoutes(ModMatrix &matrix, const CompiledRoutes &compiled);
+
 void clearPrevModDests(ModMatrix &matrix);
-void clearModDestSteps(ModMatrix &matrix);
 void setModDestStep(ModMatrix &matrix, ModDest dest, uint32_t voiceIndex,
                     float invNumSamples);
 
@@ -111,6 +167,17 @@ inline constexpr ModSrcMapping
         // Per-note
         {"velocity", ModSrc::Velocity},
         {"noise", ModSrc::Noise},
+
+        // MIDI controllers
+        {"modWheel", ModSrc::ModWheel},
+        {"pitchBend", ModSrc::PitchBend},
+        {"pressure", ModSrc::ChannelPressure},
+        {"polyPressure", ModSrc::PolyPressure},
+
+        // MPE
+        {"noteBend", ModSrc::NoteBend},
+        {"notePressure", ModSrc::NotePressure},
+        {"noteSlide", ModSrc::NoteSlide},
 };
 
 struct ModDestMapping {
@@ -139,7 +206,21 @@ inline constexpr ModDestMapping
         {"osc2.mixLevel", ModDest::Osc2Mix},
         {"osc3.mixLevel", ModDest::Osc3Mix},
         {"subOsc.mixLevel", ModDest::SubOscMix},
+
+        // Wavetable Position
+        {"osc1.wtPosition", ModDest::Osc1WTPos},
+        {"osc2.wtPosition", ModDest::Osc2WTPos},
+        {"osc3.wtPosition", ModDest::Osc3WTPos},
+        {"subOsc.wtPosition", ModDest::SubOscWTPos},
+
+        // FM
+        {"fm.depth", ModDest::FMDepth},
 };
 
-void parseModCommand(std::istringstream &iss, ModMatrix &modMatrix);
+/* Terminal `mod` command on a route list (a patch's, see patch::Patch):
+ * the live matrix is the audio thread's, post the edited patch instead
+ * Returns true when _routes_/_count_ changed
+ */
+bool parseModCommand(std::istringstream &iss, ModRoute *routes,
+                     uint8_t &count);
 } // namespace synth::mod_matrix
@@ -0,0 +1,33 @@
+#include "Noise.h"
+#include "Types.h"
+
+#include "dsp/Noise.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::noise {
+
+void initNoise(NoiseGenerator &noise, uint32_t voiceIndex, uint32_t seed) {
+  uint32_t voiceSeed = seed * MAX_VOICES + voiceIndex;
+
+  dsp::noise::seedNoise(noise.states[voiceIndex], 2 * voiceSeed);
+  dsp::noise::seedNoise(noise.modStates[voiceIndex], 2 * voiceSeed + 1);
+}
+
+void mixNoiseBlock(NoiseGenerator &noise, uint32_t voiceIndex, float *output,
+                   size_t numSamples) {
+  alignas(16) float buffer[ENGINE_BLOCK_SIZE];
+  dsp::noise::processNoiseBlock(noise.states[voiceIndex], buffer, numSamples);
+
+  const float mixLevel = noise.mixLevel;
+  for (size_t s = 0; s < numSamples; s++)
+    output[s] += buffer[s] * mixLevel;
+}
+
+void processNoiseSource(NoiseGenerator &noise, const uint32_t *voiceIndices,
+                        uint32_t count, float *output) {
+  for (uint32_t i = 0; i < count; i++)
+    output[i] = dsp::noise::processNoise(noise.modStates[voiceIndices[i]]);
+}
+} // namespace synth::noise
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Types.h"
+
+#include "dsp/Noise.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::noise {
+using NoiseState = dsp::noise::NoiseState;
+
+/* Per-voice white noise
+ * - audio layer: mixed with the oscillators when enabled
+ * - ModSrc::Noise: a new random value per voice every block (sample & hold),
+ *   produced whether or not the audio layer is enabled
+ */
+struct NoiseGenerator {
+  // === Per-voice state (hot data) ===
+  alignas(CACHE_LINE_SIZE) NoiseState states[MAX_VOICES];
+  NoiseState modStates[MAX_VOICES]; // separate stream for ModSrc::Noise
+
+  // === Global settings (cold data) ===
+  float mixLevel = 1.0f; // 0.0-4.0 like the oscillators
+  bool enabled = false;
+};
+
+// NoteOn: fresh streams per voice (seed from voice index + noteOn counter)
+void initNoise(NoiseGenerator &noise, uint32_t voiceIndex, uint32_t seed);
+
+// ADD mixLevel * noise into _output_
+void mixNoiseBlock(NoiseGenerator &noise, uint32_t voiceIndex, float *output,
+                   size_t numSamples);
+
+// One block-rate value per voice, _output_[i] for voiceIndices[i]
+void processNoiseSource(NoiseGenerator &noise, const uint32_t *voiceIndices,
+                        uint32_t count, float *output);
+
+} // namespace synth::noise
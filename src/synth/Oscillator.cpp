@@ -1,9 +1,13 @@
 #include "Oscillator.h"
 
 #include "synth/ParamRanges.h"
-#include "utils/Utils.h"
 
+#include "dsp/Dispatch.h"
+#include "dsp/Simd.h"
+
+#include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 
 namespace synth::oscillator {
@@ -19,15 +23,23 @@ Oscillator createOscillator(const OscConfig &config) {
 // =================================
 // Initialization and Configuration
 // =================================
-void initOscillator(Oscillator &osc, uint32_t voiceIndex, uint8_t midiNote,
-                    float sampleRate) {
+void initOscillator(Oscillator &osc, uint32_t voiceIndex, uint8_t midiNote) {
+  osc.phases[voiceIndex] = 0.0f;
+  osc.phaseIncrements[voiceIndex] =
+      osc.noteIncrements[midiNote % tuning::NUM_TUNING_NOTES];
 
-  float freq = utils::midiToFrequency(midiNote) *
-               std::pow(2.0f, static_cast<float>(osc.octaveOffset)) *
-               std::pow(2.0f, osc.detuneAmount / 1200.0f);
+  // Spread copy start phases (golden ratio): avoids the comb-filter swell
+  // of every copy starting in phase
+  for (size_t c = 0; c < MAX_UNISON; c++) {
+    float phase = static_cast<float>(c) * 0.618034f;
+    osc.unisonPhases[voiceIndex][c] = phase - std::floor(phase);
+  }
+}
 
-  osc.phases[voiceIndex] = 0.0f;
-  osc.phaseIncrements[voiceIndex] = freq / sampleRate;
+void retargetOscillator(Oscillator &osc, uint32_t voiceIndex,
+                        uint8_t midiNote) {
+  osc.phaseIncrements[voiceIndex] =
+      osc.noteIncrements[midiNote % tuning::NUM_TUNING_NOTES];
 }
 
 // Helper for updating global settings
@@ -46,6 +58,56 @@ void updateConfig(Oscillator &osc, const OscConfig &config) {
 
   if (osc.waveform != config.waveform)
     osc.waveform = config.waveform;
+
+  if (osc.wavetable != config.wavetable)
+    setWavetable(osc, config.wavetable);
+
+  updateUnison(osc);
+}
+
+void updateUnison(Oscillator &osc) {
+  UnisonSpread spread = computeUnison(osc.unisonCount, osc.unisonDetune);
+
+  for (size_t c = 0; c < MAX_UNISON; c++)
+    osc.unisonRatios[c] = spread.ratios[c];
+  osc.unisonGain = spread.gain;
+}
+
+void updateNoteIncrements(Oscillator &osc, const tuning::Tuning &tuning,
+                          float sampleRate) {
+  computeNoteIncrements(tuning, osc.octaveOffset, osc.detuneAmount,
+                        sampleRate, osc.noteIncrements);
+}
+
+void computeNoteIncrements(const tuning::Tuning &tuning, int8_t octaveOffset,
+                           float detuneAmount, float sampleRate,
+                           float *increments) {
+  // Both factors are powers of two apart: one multiply, same rounding as
+  // applying them one after the other
+  float ratio = std::pow(2.0f, static_cast<float>(octaveOffset)) *
+                std::pow(2.0f, detuneAmount / 1200.0f);
+
+  for (uint32_t n = 0; n < tuning::NUM_TUNING_NOTES; n++)
+    increments[n] = tuning.frequencies[n] * ratio / sampleRate;
+}
+
+UnisonSpread computeUnison(int8_t unisonCount, float unisonDetune) {
+  UnisonSpread spread{};
+  auto count =
+      static_cast<size_t>(param::ranges::osc::clampUnison(unisonCount));
+
+  for (size_t c = 0; c < MAX_UNISON; c++) {
+    // -1 .. +1 across the used copies (unused lanes stay at the voice pitch)
+    float offset = 0.0f;
+    if (c < count && count > 1)
+      offset = 2.0f * static_cast<float>(c) / static_cast<float>(count - 1) -
+               1.0f;
+
+    spread.ratios[c] = std::pow(2.0f, offset * unisonDetune / 1200.0f);
+  }
+
+  spread.gain = 1.0f / std::sqrt(static_cast<float>(count));
+  return spread;
 }
 
 // TODO(nico): are the following even necessary
@@ -81,9 +143,145 @@ void setDetuneAmount(Oscillator &osc, float newDetuneAmount) {
 
 void toggleEnabled(Oscillator &osc, bool isEnabled) { osc.enabled = isEnabled; }
 
+// NOTE: table must outlive the oscillator (not owned)
+void setWavetable(Oscillator &osc, const Wavetable *table,
+                  uint32_t frameCount) {
+  osc.wavetable = table;
+  osc.wavetableFrameCount = table && frameCount > 0 ? frameCount : 1;
+}
+
+const Wavetable &getWavetable(const Oscillator &osc) {
+  return osc.wavetable
+             ? *osc.wavetable
+             : dsp::wavetable::getBuiltinWavetable(WaveformType::Saw);
+}
+
 // =================================
 // Processing
 // =================================
+namespace {
+float evalWaveform(const Oscillator &osc, float phase, float phaseIncrement) {
+  if (isScanningWavetable(osc))
+    return dsp::wavetable::processWavetableFrames(
+        {osc.wavetable, osc.wavetableFrameCount}, phase, phaseIncrement,
+        osc.wavetablePosition);
+
+  if (osc.waveform == WaveformType::Wavetable)
+    return dsp::wavetable::processWavetable(getWavetable(osc), phase,
+                                            phaseIncrement);
+
+  return dsp::waveforms::processWaveform(osc.waveform, phase, phaseIncrement);
+}
+
+// Waveform evaluation has no dependency between samples (SIMD)
+// _positions_: one per entry, only read by scanning wavetables
+void evalWaveformBlock(const Oscillator &osc, const float *phases,
+                       const float *phaseIncrements, const float *positions,
+                       float *samples, size_t count, QualityMode quality) {
+  if (isScanningWavetable(osc)) {
+    dsp::wavetable::processWavetableFramesBlock(
+        {osc.wavetable, osc.wavetableFrameCount}, phases, phaseIncrements,
+        positions, samples, count);
+  } else if (osc.waveform == WaveformType::Wavetable) {
+    dsp::wavetable::processWavetableBlock(getWavetable(osc), phases,
+                                          phaseIncrements, samples, count);
+  } else if (quality == QualityMode::Draft) {
+    dsp::waveforms::processWaveformNaiveBlock(osc.waveform, phases, samples,
+                                              count);
+  } else {
+    dsp::dispatch::kernels().processWaveformBlock(
+        osc.waveform, phases, phaseIncrements, samples, count, 0.5f);
+  }
+}
+
+// PM: phase + offset wrapped back to [0, 1) (offsets can span many cycles)
+float offsetPhase(float phase, float offset) {
+  float shifted = phase + offset;
+  shifted -= static_cast<float>(static_cast<int32_t>(shifted));
+  return shifted < 0.0f ? shifted + 1.0f : shifted;
+}
+
+/* Unison: copies are SIMD lanes, interleaved sample-major
+ *   buffer[s * lanes + c] = copy c at sample s
+ * so each step of the phase accumulator advances 4 copies at once and the
+ * waveform kernel runs over numSamples * lanes independent entries
+ */
+void renderUnisonBlock(Oscillator &osc, uint32_t voiceIndex,
+                       const float *phaseIncrements, const float *phaseOffsets,
+                       const float *positions, float *output,
+                       size_t numSamples, scratch::ScratchArena &scratch,
+                       QualityMode quality) {
+  using namespace dsp::simd;
+
+  auto count = static_cast<size_t>(param::ranges::osc::clampUnison(
+      osc.unisonCount));
+  size_t lanes = (count + WIDTH - 1) & ~(WIDTH - 1);
+
+  // 3 x 4 KB at 16 copies (+ positions when scanning): too big for the
+  // worker stacks
+  scratch::ScratchMark mark = scratch::markScratch(scratch);
+  float *phases = scratch::allocateScratch<float>(scratch, numSamples * lanes);
+  float *increments =
+      scratch::allocateScratch<float>(scratch, numSamples * lanes);
+  float *samples = scratch::allocateScratch<float>(scratch, numSamples * lanes);
+
+  float *copyPhases = osc.unisonPhases[voiceIndex];
+  const f32x4 one = set1(1.0f);
+
+  for (size_t c = 0; c < lanes; c += WIDTH) {
+    f32x4 phase = load(copyPhases + c);
+    const f32x4 ratio = load(osc.unisonRatios + c);
+
+    for (size_t s = 0; s < numSamples; s++) {
+      f32x4 inc = mul(set1(phaseIncrements[s]), ratio);
+      store(phases + s * lanes + c, phase);
+      store(increments + s * lanes + c, inc);
+
+      phase = add(phase, inc);
+      phase = select(cmpGe(phase, one), sub(phase, one), phase);
+    }
+
+    store(copyPhases + c, phase);
+  }
+
+  // Every copy gets the same modulator sample
+  if (phaseOffsets) {
+    for (size_t s = 0; s < numSamples; s++) {
+      float *copies = phases + s * lanes;
+      for (size_t c = 0; c < lanes; c++)
+        copies[c] = offsetPhase(copies[c], phaseOffsets[s]);
+    }
+  }
+
+  // Every copy scans the same position too
+  float *copyPositions = nullptr;
+  if (positions) {
+    copyPositions =
+        scratch::allocateScratch<float>(scratch, numSamples * lanes);
+    for (size_t s = 0; s < numSamples; s++) {
+      for (size_t c = 0; c < lanes; c++)
+        copyPositions[s * lanes + c] = positions[s];
+    }
+  }
+
+  evalWaveformBlock(osc, phases, increments, copyPositions, samples,
+                    numSamples * lanes, quality);
+
+  // Padding lanes (count..lanes) are rendered but not summed
+  for (size_t s = 0; s < numSamples; s++) {
+    const float *copies = samples + s * lanes;
+
+    float sum = 0.0f;
+    for (size_t c = 0; c < count; c++)
+      sum += copies[c];
+
+    output[s] = sum * osc.unisonGain;
+  }
+
+  scratch::releaseScratch(scratch, mark);
+}
+} // namespace
+
 void incrementPhase(Oscillator &osc, uint32_t voiceIndex) {
   osc.phases[voiceIndex] += osc.phaseIncrements[voiceIndex];
 
@@ -94,10 +292,9 @@ void incrementPhase(Oscillator &osc, uint32_t voiceIndex) {
 
 // Use this if NOT passing pitch and/or mix modulation
 float processOscillator(Oscillator &osc, uint32_t voiceIndex) {
-  float sample =
-      dsp::waveforms::processWaveform(osc.waveform, osc.phases[voiceIndex],
-                                      osc.phaseIncrements[voiceIndex]) *
-      osc.mixLevel;
+  float sample = evalWaveform(osc, osc.phases[voiceIndex],
+                              osc.phaseIncrements[voiceIndex]) *
+                 osc.mixLevel;
 
   incrementPhase(osc, voiceIndex);
 
@@ -108,8 +305,7 @@ float processOscillator(Oscillator &osc, uint32_t voiceIndex) {
 // NOTE(nico): values are expected to be calculated by caller
 float processOscillator(Oscillator &osc, uint32_t voiceIndex,
                         float phaseIncrement, float mixLevel) {
-  float sample = dsp::waveforms::processWaveform(
-                     osc.waveform, osc.phases[voiceIndex], phaseIncrement) *
+  float sample = evalWaveform(osc, osc.phases[voiceIndex], phaseIncrement) *
                  param::ranges::osc::clampMixLevel(mixLevel);
 
   // Advance using the modulated increment, not the stored one
@@ -120,4 +316,65 @@ float processOscillator(Oscillator &osc, uint32_t voiceIndex,
   return sample;
 }
 
+// Block version (voice-major render path)
+void renderOscillatorBlock(Oscillator &osc, uint32_t voiceIndex,
+                           const float *phaseIncrements,
+                           const float *phaseOffsets, const float *positions,
+                           float *output, size_t numSamples,
+                           scratch::ScratchArena &scratch,
+                           QualityMode quality) {
+  assert(numSamples <= ENGINE_BLOCK_SIZE);
+
+  // Unmodulated scan: the base position for every sample
+  alignas(16) float basePositions[ENGINE_BLOCK_SIZE];
+  if (!isScanningWavetable(osc)) {
+    positions = nullptr;
+  } else if (!positions) {
+    for (size_t i = 0; i < numSamples; i++)
+      basePositions[i] = osc.wavetablePosition;
+    positions = basePositions;
+  }
+
+  if (osc.unisonCount > 1) {
+    renderUnisonBlock(osc, voiceIndex, phaseIncrements, phaseOffsets,
+                      positions, output, numSamples, scratch, quality);
+    return;
+  }
+
+  alignas(16) float phases[ENGINE_BLOCK_SIZE];
+
+  // Phase accumulation is the only sequential part (cheap)
+  float phase = osc.phases[voiceIndex];
+  for (size_t i = 0; i < numSamples; i++) {
+    phases[i] = phase;
+
+    phase += phaseIncrements[i];
+    if (phase >= 1.0f)
+      phase -= 1.0f;
+  }
+  osc.phases[voiceIndex] = phase;
+
+  // PM shifts the read position only, the accumulator is untouched
+  if (phaseOffsets) {
+    for (size_t i = 0; i < numSamples; i++)
+      phases[i] = offsetPhase(phases[i], phaseOffsets[i]);
+  }
+
+  evalWaveformBlock(osc, phases, phaseIncrements, positions, output,
+                    numSamples, quality);
+}
+
+void mixOscillatorBlock(Oscillator &osc, uint32_t voiceIndex,
+                        const float *phaseIncrements, const float *positions,
+                        float mixLevel, float *output, size_t numSamples,
+                        scratch::ScratchArena &scratch, QualityMode quality) {
+  alignas(16) float samples[ENGINE_BLOCK_SIZE];
+  renderOscillatorBlock(osc, voiceIndex, phaseIncrements, nullptr, positions,
+                        samples, numSamples, scratch, quality);
+
+  float level = param::ranges::osc::clampMixLevel(mixLevel);
+  for (size_t i = 0; i < numSamples; i++)
+    output[i] += samples[i] * level;
+}
+
 } // namespace synth::oscillator
@@ -1,13 +1,22 @@
 #pragma once
 
+#include "ScratchArena.h"
+#include "Tuning.h"
 #include "Types.h"
 
 #include "dsp/Waveforms.h"
+#include "dsp/Wavetable.h"
 
+#include <cstddef>
 #include <cstdint>
 
 namespace synth::oscillator {
 using WaveformType = dsp::waveforms::WaveformType;
+using Wavetable = dsp::wavetable::Wavetable;
+using WavetableFrames = dsp::wavetable::WavetableFrames;
+
+// Unison copies per oscillator (multiple of the SIMD width)
+inline constexpr size_t MAX_UNISON = 16;
 
 struct OscConfig {
   WaveformType waveform = WaveformType::Sine;
@@ -15,12 +24,22 @@ struct OscConfig {
   int8_t octaveOffset = 0;   // -2 to +2
   float detuneAmount = 0.0f; // Cents: -100 to +100
   bool enabled = true;
+
+  // Table played by WaveformType::Wavetable (nullptr = built-in saw)
+  const Wavetable *wavetable = nullptr;
+};
+
+// Unison tuning for a copy count + detune (see Oscillator::unisonRatios)
+struct UnisonSpread {
+  float ratios[MAX_UNISON] = {};
+  float gain = 1.0f;
 };
 
 struct Oscillator {
   // === Per-voice state (hot data) ===
-  float phases[MAX_VOICES];
+  alignas(CACHE_LINE_SIZE) float phases[MAX_VOICES];
   float phaseIncrements[MAX_VOICES];
+  float unisonPhases[MAX_VOICES][MAX_UNISON]; // read when unisonCount > 1
 
   // === Global settings (cold data) ===
   WaveformType waveform = WaveformType::Sine;
@@ -28,6 +47,27 @@ struct Oscillator {
   int8_t octaveOffset = 0;   // -2 to +2
   float detuneAmount = 0.0f; // Cents: -100 to +100
   bool enabled = true;
+
+  // Phase increment per MIDI note: tuning, octave, detune and sample rate
+  // folded in (updateNoteIncrements), note-on is a lookup
+  float noteIncrements[tuning::NUM_TUNING_NOTES] = {};
+
+  // Not owned. Only read when waveform == WaveformType::Wavetable
+  // Multi-frame tables: wavetableFrameCount frames from here
+  const Wavetable *wavetable = nullptr;
+  uint32_t wavetableFrameCount = 1;
+  float wavetablePosition = 0.0f; // 0-1 across the frames (scan base)
+
+  /* Unison: copies of this oscillator inside ONE voice (no extra polyphony)
+   * rendered together as SIMD lanes, spread evenly over +-unisonDetune
+   * NOTE: the voice path is mono, copies are not spread in stereo
+   */
+  int8_t unisonCount = 1;    // 1 to MAX_UNISON
+  float unisonDetune = 0.0f; // Cents at the outermost copies
+
+  // Derived by updateUnison
+  float unisonRatios[MAX_UNISON] = {}; // copy increment / voice increment
+  float unisonGain = 1.0f;             // 1 / sqrt(unisonCount)
 };
 
 Oscillator createOscillator(const OscConfig &settings);
@@ -38,9 +78,37 @@ void setMixLevel(Oscillator &osc, float newLevel);
 void setOctiveOffset(Oscillator &osc, int8_t newOffest);
 void setDetuneAmount(Oscillator &osc, float newDetuneAmount);
 void toggleEnabled(Oscillator &osc, bool isEnabled);
+void setWavetable(Oscillator &osc, const Wavetable *table,
+                  uint32_t frameCount = 1);
+
+// Recalculate unison ratios/gain after unisonCount or unisonDetune changed
+void updateUnison(Oscillator &osc);
 
-void initOscillator(Oscillator &osc, uint32_t voiceIndex, uint8_t midiNote,
-                    float sampleRate);
+// Same values, no oscillator needed (e.g. building a patch off-thread)
+UnisonSpread computeUnison(int8_t unisonCount, float unisonDetune);
+
+/* Rebuild noteIncrements after octaveOffset, detuneAmount, the sample rate
+ * or the tuning changed
+ * NOTE: playing voices keep their pitch (no clicks), the next note-on uses
+ * the new table
+ */
+void updateNoteIncrements(Oscillator &osc, const tuning::Tuning &tuning,
+                          float sampleRate);
+
+// Same values, no oscillator needed (e.g. building a patch off-thread)
+void computeNoteIncrements(const tuning::Tuning &tuning, int8_t octaveOffset,
+                           float detuneAmount, float sampleRate,
+                           float *increments);
+
+// Table used by WaveformType::Wavetable (falls back to the built-in saw)
+const Wavetable &getWavetable(const Oscillator &osc);
+
+// Starts at noteIncrements[midiNote] (see updateNoteIncrements)
+void initOscillator(Oscillator &osc, uint32_t voiceIndex, uint8_t midiNote);
+
+// Mono/legato: switch a playing voice to _midiNote_ (phases carry on)
+void retargetOscillator(Oscillator &osc, uint32_t voiceIndex,
+                        uint8_t midiNote);
 
 void incrementPhase(Oscillator &osc, uint32_t voiceIndex);
 
@@ -51,4 +119,37 @@ float processOscillator(Oscillator &osc, uint32_t voiceIndex);
 float processOscillator(Oscillator &osc, uint32_t voiceIndex,
                         float phaseIncrement, float mixLevel);
 
+/* Block version: advance one voice through a whole engine block and WRITE
+ * the raw waveform (before mix level) to _output_
+ * - _phaseOffsets_ (cycles, nullable) shift the read phase per sample (PM)
+ * - _positions_ (0-1, nullable = wavetablePosition) scan multi-frame tables
+ *   per sample, ignored by every other waveform
+ * - unison copy buffers come from _scratch_ (released before returning)
+ * NOTE: numSamples must be <= ENGINE_BLOCK_SIZE
+ */
+void renderOscillatorBlock(Oscillator &osc, uint32_t voiceIndex,
+                           const float *phaseIncrements,
+                           const float *phaseOffsets, const float *positions,
+                           float *output, size_t numSamples,
+                           scratch::ScratchArena &scratch,
+                           QualityMode quality = QualityMode::Live);
+
+// Multi-frame wavetable playing (the only case positions are read)
+inline bool isScanningWavetable(const Oscillator &osc) {
+  return osc.waveform == WaveformType::Wavetable &&
+         osc.wavetableFrameCount > 1;
+}
+
+// Block version: advance one voice through a whole engine block using
+// per-sample (already modulated) phase increments and ADD into _output_
+// NOTE: numSamples must be <= ENGINE_BLOCK_SIZE
+// Draft quality renders saw/square without polyBLEP
+// unisonCount > 1 renders every copy from the same per-sample increments
+// (and positions, see renderOscillatorBlock)
+void mixOscillatorBlock(Oscillator &osc, uint32_t voiceIndex,
+                        const float *phaseIncrements, const float *positions,
+                        float mixLevel, float *output, size_t numSamples,
+                        scratch::ScratchArena &scratch,
+                        QualityMode quality = QualityMode::Live);
+
 } // namespace synth::oscillator
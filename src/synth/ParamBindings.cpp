@@ -2,11 +2,15 @@
 
 #include "Engine.h"
 #include "Envelope.h"
+#include "FMMatrix.h"
+#include "LFO.h"
+#include "MasterFX.h"
 #include "synth/Filters.h"
 #include "synth/ParamRanges.h"
 
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 namespace synth::param::bindings {
@@ -89,6 +93,25 @@ void bindLadderFilter(ParamBinding *bindings, ParamID baseId,
 
   bindings[baseId + 3] = makeParamBinding(
       &filter.drive, ranges::filter::DRIVE_MIN, ranges::filter::DRIVE_MAX);
+
+  bindings[baseId + 4] = makeParamBinding(&filter.oversampling,
+                                          ranges::filter::OVERSAMPLING_MIN,
+                                          ranges::filter::OVERSAMPLING_MAX);
+}
+
+// Per-voice saturator + DC blocker Bindings
+void bindSaturator(ParamBinding *bindings, saturator::Saturator &saturator,
+                   saturator::DCBlocker &dcBlocker) {
+  bindings[SATURATOR_ENABLED] = makeParamBinding(&saturator.enabled);
+  bindings[SATURATOR_DRIVE] = makeParamBinding(
+      &saturator.drive, ranges::fx::DRIVE_MIN, ranges::fx::DRIVE_MAX);
+  bindings[SATURATOR_MIX] = makeParamBinding(
+      &saturator.mix, ranges::fx::MIX_MIN, ranges::fx::MIX_MAX);
+  bindings[SATURATOR_OVERSAMPLING] = makeParamBinding(
+      &saturator.oversampling, ranges::filter::OVERSAMPLING_MIN,
+      ranges::filter::OVERSAMPLING_MAX);
+
+  bindings[DC_BLOCKER_ENABLED] = makeParamBinding(&dcBlocker.enabled);
 }
 
 // Oscillator Bindings
@@ -107,6 +130,82 @@ void bindOscillator(ParamBinding *bindings, ParamID baseId,
       &osc.octaveOffset, ranges::osc::OCTAVE_MIN, ranges::osc::OCTAVE_MAX);
 
   bindings[baseId + 4] = makeParamBinding(&osc.enabled);
+
+  bindings[baseId + 5] = makeParamBinding(
+      &osc.unisonCount, ranges::osc::UNISON_MIN, ranges::osc::UNISON_MAX);
+
+  bindings[baseId + 6] =
+      makeParamBinding(&osc.unisonDetune, ranges::osc::UNISON_DETUNE_MIN,
+                       ranges::osc::UNISON_DETUNE_MAX);
+
+  bindings[baseId + 7] =
+      makeParamBinding(&osc.wavetablePosition, ranges::osc::WT_POSITION_MIN,
+                       ranges::osc::WT_POSITION_MAX);
+}
+
+// LFO Bindings
+void bindLFO(ParamBinding *bindings, ParamID baseId, lfo::LFO &lfo) {
+  bindings[baseId + 0] = makeParamBinding(
+      &lfo.waveform, ranges::osc::WAVEFORM_MIN, ranges::osc::WAVEFORM_MAX);
+
+  bindings[baseId + 1] = makeParamBinding(&lfo.rate, ranges::lfo::RATE_MIN,
+                                          ranges::lfo::RATE_MAX);
+
+  bindings[baseId + 2] = makeParamBinding(&lfo.retrigger);
+}
+
+// FM Bindings (modulator-major, self routes skipped)
+void bindFMMatrix(ParamBinding *bindings, ParamID baseId,
+                  fm_matrix::FMMatrix &fm) {
+  int offset = 0;
+  for (uint8_t m = 0; m < fm_matrix::FM_OSC_COUNT; m++) {
+    for (uint8_t c = 0; c < fm_matrix::FM_OSC_COUNT; c++) {
+      if (m == c)
+        continue;
+
+      bindings[baseId + offset++] =
+          makeParamBinding(&fm.amounts[m][c], ranges::fm::AMOUNT_MIN,
+                           ranges::fm::AMOUNT_MAX);
+    }
+  }
+}
+
+// Master FX Bindings (enum layout must match!)
+void bindFXChain(ParamBinding *bindings, fx::FXChain &chain) {
+  bindings[FX_SATURATOR_ENABLED] = makeParamBinding(&chain.saturator.enabled);
+  bindings[FX_SATURATOR_DRIVE] = makeParamBinding(
+      &chain.saturator.drive, ranges::fx::DRIVE_MIN, ranges::fx::DRIVE_MAX);
+  bindings[FX_SATURATOR_MIX] = makeParamBinding(
+      &chain.saturator.mix, ranges::fx::MIX_MIN, ranges::fx::MIX_MAX);
+
+  bindings[FX_DC_BLOCKER_ENABLED] = makeParamBinding(&chain.dcBlocker.enabled);
+
+  bindings[FX_DELAY_ENABLED] = makeParamBinding(&chain.delay.enabled);
+  bindings[FX_DELAY_TIME] =
+      makeParamBinding(&chain.delay.timeMs, ranges::fx::DELAY_TIME_MIN,
+                       ranges::fx::DELAY_TIME_MAX);
+  bindings[FX_DELAY_SYNC] = makeParamBinding(&chain.delay.sync);
+  bindings[FX_DELAY_DIVISION] =
+      makeParamBinding(&chain.delay.division, ranges::fx::DELAY_DIVISION_MIN,
+                       ranges::fx::DELAY_DIVISION_MAX);
+  bindings[FX_DELAY_FEEDBACK] =
+      makeParamBinding(&chain.delay.feedback, ranges::fx::DELAY_FEEDBACK_MIN,
+                       ranges::fx::DELAY_FEEDBACK_MAX);
+  bindings[FX_DELAY_MIX] = makeParamBinding(
+      &chain.delay.mix, ranges::fx::MIX_MIN, ranges::fx::MIX_MAX);
+
+  bindings[FX_REVERB_ENABLED] = makeParamBinding(&chain.reverb.enabled);
+  bindings[FX_REVERB_SIZE] =
+      makeParamBinding(&chain.reverb.size, ranges::fx::REVERB_SIZE_MIN,
+                       ranges::fx::REVERB_SIZE_MAX);
+  bindings[FX_REVERB_DECAY] =
+      makeParamBinding(&chain.reverb.decay, ranges::fx::REVERB_DECAY_MIN,
+                       ranges::fx::REVERB_DECAY_MAX);
+  bindings[FX_REVERB_DAMPING] =
+      makeParamBinding(&chain.reverb.damping, ranges::fx::REVERB_DAMPING_MIN,
+                       ranges::fx::REVERB_DAMPING_MAX);
+  bindings[FX_REVERB_MIX] = makeParamBinding(
+      &chain.reverb.mix, ranges::fx::MIX_MIN, ranges::fx::MIX_MAX);
 }
 
 // Envelope Bindings
@@ -123,42 +222,100 @@ void bindEnvelope(ParamBinding *bindings, ParamID baseId,
 
   bindings[baseId + 3] = makeParamBinding(&env.releaseMs, ranges::env::TIME_MIN,
                                           ranges::env::TIME_MAX);
+
+  bindings[baseId + 4] = makeParamBinding(
+      &env.attackCurve, ranges::env::CURVE_MIN, ranges::env::CURVE_MAX);
+
+  bindings[baseId + 5] = makeParamBinding(
+      &env.decayCurve, ranges::env::CURVE_MIN, ranges::env::CURVE_MAX);
+
+  bindings[baseId + 6] = makeParamBinding(
+      &env.releaseCurve, ranges::env::CURVE_MIN, ranges::env::CURVE_MAX);
 }
 
-// Handle updates to params with derived values
-void onParamUpdate(Engine &engine, ParamID id) {
+// Params with derived values only flag their module here, the recompute
+// is deferred to updateDirtyModules (many events -> one recompute)
+uint32_t dirtyModuleForParam(ParamID id) {
   switch (id) {
-  // Update Amp Envelope on param changes
+  // Amp Envelope increments + curve tables
   case AMP_ENV_ATTACK:
   case AMP_ENV_DECAY:
   case AMP_ENV_RELEASE:
-    envelope::updateIncrements(engine.voicePool.ampEnv, engine.sampleRate);
-    break;
+  case AMP_ENV_ATTACK_CURVE:
+  case AMP_ENV_DECAY_CURVE:
+  case AMP_ENV_RELEASE_CURVE:
+    return DIRTY_AMP_ENV;
 
-  // Update Filter Envelope on param changes
+  // Filter Envelope increments + curve tables
   case FILTER_ENV_ATTACK:
   case FILTER_ENV_DECAY:
   case FILTER_ENV_RELEASE:
-    envelope::updateIncrements(engine.voicePool.filterEnv, engine.sampleRate);
-    break;
+  case FILTER_ENV_ATTACK_CURVE:
+  case FILTER_ENV_DECAY_CURVE:
+  case FILTER_ENV_RELEASE_CURVE:
+    return DIRTY_FILTER_ENV;
 
-  // Update Filter Coefficient(s) on param changes
+  // Filter Coefficient(s)
   case SVF_CUTOFF:
   case SVF_RESONANCE:
-    filters::updateSVFCoefficients(engine.voicePool.svf,
-                                   engine.voicePool.invSampleRate);
-    break;
+    return DIRTY_SVF;
 
   case LADDER_CUTOFF:
   case LADDER_RESONANCE:
-    filters::updateLadderCoefficient(engine.voicePool.ladder,
-                                     engine.voicePool.invSampleRate);
-    break;
-
-    // No special handling needed for other params like
-    // Oscillator pitch params - no active voice updates (avoid clicks)
+    return DIRTY_LADDER;
+
+  // FM evaluation order
+  case FM_OSC1_OSC2:
+  case FM_OSC1_OSC3:
+  case FM_OSC1_SUB_OSC:
+  case FM_OSC2_OSC1:
+  case FM_OSC2_OSC3:
+  case FM_OSC2_SUB_OSC:
+  case FM_OSC3_OSC1:
+  case FM_OSC3_OSC2:
+  case FM_OSC3_SUB_OSC:
+  case FM_SUB_OSC_OSC1:
+  case FM_SUB_OSC_OSC2:
+  case FM_SUB_OSC_OSC3:
+    return DIRTY_FM;
+
+  // Note -> phase increment tables (the next note-on, playing voices keep
+  // their pitch: no clicks)
+  case OSC1_DETUNE_AMOUNT:
+  case OSC1_OCTAVE_OFFSET:
+  case OSC2_DETUNE_AMOUNT:
+  case OSC2_OCTAVE_OFFSET:
+  case OSC3_DETUNE_AMOUNT:
+  case OSC3_OCTAVE_OFFSET:
+  case SUB_OSC_DETUNE_AMOUNT:
+  case SUB_OSC_OCTAVE_OFFSET:
+    return DIRTY_PITCH;
+
+  // Unison detune ratios
+  case OSC1_UNISON:
+  case OSC1_UNISON_DETUNE:
+  case OSC2_UNISON:
+  case OSC2_UNISON_DETUNE:
+  case OSC3_UNISON:
+  case OSC3_UNISON_DETUNE:
+  case SUB_OSC_UNISON:
+  case SUB_OSC_UNISON_DETUNE:
+    return DIRTY_UNISON;
+
+  // Delay length, reverb gains, saturator drive
+  case FX_SATURATOR_DRIVE:
+  case FX_DELAY_TIME:
+  case FX_DELAY_SYNC:
+  case FX_DELAY_DIVISION:
+  case FX_REVERB_SIZE:
+  case FX_REVERB_DECAY:
+  case FX_REVERB_DAMPING:
+  case MASTER_TEMPO:
+    return DIRTY_FX;
+
+    // No special handling needed for other params
   default:
-    break;
+    return DIRTY_NONE;
   }
 }
 
@@ -166,14 +323,21 @@ void onParamUpdate(Engine &engine, ParamID id) {
 
 // ==== APIs ====
 void initParamBindings(Engine &engine) {
-  // Oscillators - 5 params each, enum layout must match!
+  // Oscillators - 8 params each, enum layout must match!
   bindOscillator(engine.paramBindings, OSC1_WAVEFORM, engine.voicePool.osc1);
   bindOscillator(engine.paramBindings, OSC2_WAVEFORM, engine.voicePool.osc2);
   bindOscillator(engine.paramBindings, OSC3_WAVEFORM, engine.voicePool.osc3);
   bindOscillator(engine.paramBindings, SUB_OSC_WAVEFORM,
                  engine.voicePool.subOsc);
 
-  // Envelopes
+  // Noise
+  engine.paramBindings[NOISE_MIX_LEVEL] =
+      makeParamBinding(&engine.voicePool.noise.mixLevel,
+                       ranges::osc::MIX_LEVEL_MIN, ranges::osc::MIX_LEVEL_MAX);
+  engine.paramBindings[NOISE_ENABLED] =
+      makeParamBinding(&engine.voicePool.noise.enabled);
+
+  // Envelopes - 7 params each, enum layout must match!
   bindEnvelope(engine.paramBindings, AMP_ENV_ATTACK, engine.voicePool.ampEnv);
   bindEnvelope(engine.paramBindings, FILTER_ENV_ATTACK,
                engine.voicePool.filterEnv);
@@ -182,11 +346,61 @@ void initParamBindings(Engine &engine) {
   bindSVFilter(engine.paramBindings, SVF_ENABLED, engine.voicePool.svf);
   bindLadderFilter(engine.paramBindings, LADDER_ENABLED,
                    engine.voicePool.ladder);
+  bindSaturator(engine.paramBindings, engine.voicePool.saturator,
+                engine.voicePool.dcBlocker);
+
+  // LFOs - 3 params each
+  bindLFO(engine.paramBindings, LFO1_WAVEFORM, engine.voicePool.lfo1);
+  bindLFO(engine.paramBindings, LFO2_WAVEFORM, engine.voicePool.lfo2);
+  bindLFO(engine.paramBindings, LFO3_WAVEFORM, engine.voicePool.lfo3);
+
+  // FM - 12 routes, enum layout must match!
+  bindFMMatrix(engine.paramBindings, FM_OSC1_OSC2, engine.voicePool.fmMatrix);
+
+  // Master FX
+  bindFXChain(engine.paramBindings, engine.fxChain);
 
   // Voice Pool
+  engine.paramBindings[VOICE_MODE] = makeParamBinding(
+      &engine.voicePool.voiceMode, ranges::voice::MODE_MIN,
+      ranges::voice::MODE_MAX);
+
+  engine.paramBindings[VOICE_GLIDE_TIME] = makeParamBinding(
+      &engine.voicePool.glide.timeMs, ranges::voice::GLIDE_TIME_MIN,
+      ranges::voice::GLIDE_TIME_MAX);
+
+  engine.paramBindings[VOICE_PAN] =
+      makeParamBinding(&engine.voicePool.pan, ranges::voice::PAN_MIN,
+                       ranges::voice::PAN_MAX);
+
+  engine.paramBindings[VOICE_SPREAD] =
+      makeParamBinding(&engine.voicePool.spread, ranges::voice::SPREAD_MIN,
+                       ranges::voice::SPREAD_MAX);
+
+  // Arpeggiator
+  engine.paramBindings[ARP_ENABLED] = makeParamBinding(&engine.arp.enabled);
+  engine.paramBindings[ARP_MODE] = makeParamBinding(
+      &engine.arp.mode, ranges::arp::MODE_MIN, ranges::arp::MODE_MAX);
+  engine.paramBindings[ARP_DIVISION] =
+      makeParamBinding(&engine.arp.division, ranges::arp::DIVISION_MIN,
+                       ranges::arp::DIVISION_MAX);
+  engine.paramBindings[ARP_OCTAVES] =
+      makeParamBinding(&engine.arp.octaves, ranges::arp::OCTAVES_MIN,
+                       ranges::arp::OCTAVES_MAX);
+  engine.paramBindings[ARP_GATE] = makeParamBinding(
+      &engine.arp.gate, ranges::arp::GATE_MIN, ranges::arp::GATE_MAX);
+  engine.paramBindings[ARP_STEPS] = makeParamBinding(
+      &engine.arp.steps, ranges::arp::STEPS_MIN, ranges::arp::STEPS_MAX);
+  engine.paramBindings[ARP_PATTERN] = makeParamBinding(
+      &engine.arp.pattern, ranges::arp::PATTERN_MIN, ranges::arp::PATTERN_MAX);
+
   engine.paramBindings[MASTER_GAIN] = makeParamBinding(
       &engine.voicePool.masterGain, ranges::global::MASTER_GAIN_MIN,
       ranges::global::MASTER_GAIN_MAX);
+
+  engine.paramBindings[MASTER_TEMPO] =
+      makeParamBinding(&engine.tempo, ranges::global::TEMPO_MIN,
+                       ranges::global::TEMPO_MAX);
 }
 
 // ==== Param Getter/Setter ====
@@ -280,8 +494,46 @@ void setParamValueByID(Engine &engine, ParamID id, float value,
     break;
   }
 
-  // Handle post-update logic for params with derived values (i.e. Envelopes)
-  onParamUpdate(engine, id);
+  // Params with derived values (i.e. Envelopes) recompute at the next block
+  engine.dirtyModules |= dirtyModuleForParam(id);
+}
+
+void updateDirtyModules(Engine &engine) {
+  uint32_t dirty = engine.dirtyModules;
+  if (dirty == DIRTY_NONE)
+    return;
+
+  if (dirty & DIRTY_AMP_ENV)
+    envelope::updateIncrements(engine.voicePool.ampEnv, engine.sampleRate);
+
+  if (dirty & DIRTY_FILTER_ENV)
+    envelope::updateIncrements(engine.voicePool.filterEnv, engine.sampleRate);
+
+  if (dirty & DIRTY_SVF)
+    filters::updateSVFCoefficients(engine.voicePool.svf,
+                                   engine.voicePool.invSampleRate);
+
+  if (dirty & DIRTY_LADDER)
+    filters::updateLadderCoefficient(engine.voicePool.ladder,
+                                     engine.voicePool.invSampleRate);
+
+  if (dirty & DIRTY_UNISON) {
+    oscillator::updateUnison(engine.voicePool.osc1);
+    oscillator::updateUnison(engine.voicePool.osc2);
+    oscillator::updateUnison(engine.voicePool.osc3);
+    oscillator::updateUnison(engine.voicePool.subOsc);
+  }
+
+  if (dirty & DIRTY_PITCH)
+    voices::updatePitchTables(engine.voicePool);
+
+  if (dirty & DIRTY_FM)
+    fm_matrix::compileFMOrder(engine.voicePool.fmMatrix);
+
+  if (dirty & DIRTY_FX)
+    fx::updateFXChain(engine.fxChain, engine.sampleRate, engine.tempo);
+
+  engine.dirtyModules = DIRTY_NONE;
 }
 
 // String → ParamID (for parsing 'set' commands)
@@ -352,7 +604,30 @@ WaveformType getWaveformType(const char *inputValue) {
   if (strcasecmp(inputValue, "triangle") == 0)
     return WaveformType::Triangle;
 
+  if (strcasecmp(inputValue, "wavetable") == 0)
+    return WaveformType::Wavetable;
+
   // default to Sine
   return WaveformType::Sine;
 }
+
+float parseParamValue(ParamValueType type, const char *inputValue) {
+  switch (type) {
+  case ParamValueType::WAVEFORM:
+    return static_cast<float>(getWaveformType(inputValue));
+
+  case ParamValueType::BOOL:
+    return strcasecmp(inputValue, "true") == 0 ? 1.0f : 0.0f;
+
+  case ParamValueType::FILTER_MODE:
+    return static_cast<float>(getSVFModeType(inputValue));
+
+  // Treat all other params values as floats (denormalized)
+  case ParamValueType::FLOAT:
+  case ParamValueType::INT8:
+    break;
+  }
+
+  return std::strtof(inputValue, nullptr);
+}
 } // namespace synth::param::bindings
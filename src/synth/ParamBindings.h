@@ -3,6 +3,7 @@
 #include "synth/Filters.h"
 #include "synth/Oscillator.h"
 #include <cstddef>
+#include <cstdint>
 
 namespace synth {
 struct Engine;
@@ -19,6 +20,9 @@ enum ParamID {
   OSC1_DETUNE_AMOUNT,
   OSC1_OCTAVE_OFFSET,
   OSC1_ENABLED,
+  OSC1_UNISON,
+  OSC1_UNISON_DETUNE,
+  OSC1_WT_POSITION,
 
   // Oscillator 2
   OSC2_WAVEFORM,
@@ -26,6 +30,9 @@ enum ParamID {
   OSC2_DETUNE_AMOUNT,
   OSC2_OCTAVE_OFFSET,
   OSC2_ENABLED,
+  OSC2_UNISON,
+  OSC2_UNISON_DETUNE,
+  OSC2_WT_POSITION,
 
   // Oscillator 3
   OSC3_WAVEFORM,
@@ -33,6 +40,9 @@ enum ParamID {
   OSC3_DETUNE_AMOUNT,
   OSC3_OCTAVE_OFFSET,
   OSC3_ENABLED,
+  OSC3_UNISON,
+  OSC3_UNISON_DETUNE,
+  OSC3_WT_POSITION,
 
   // Sub Oscillator
   SUB_OSC_WAVEFORM,
@@ -40,18 +50,31 @@ enum ParamID {
   SUB_OSC_DETUNE_AMOUNT,
   SUB_OSC_OCTAVE_OFFSET,
   SUB_OSC_ENABLED,
+  SUB_OSC_UNISON,
+  SUB_OSC_UNISON_DETUNE,
+  SUB_OSC_WT_POSITION,
+
+  // Noise
+  NOISE_MIX_LEVEL,
+  NOISE_ENABLED,
 
   // Amp Envelope
   AMP_ENV_ATTACK,
   AMP_ENV_DECAY,
   AMP_ENV_SUSTAIN_LEVEL,
   AMP_ENV_RELEASE,
+  AMP_ENV_ATTACK_CURVE,
+  AMP_ENV_DECAY_CURVE,
+  AMP_ENV_RELEASE_CURVE,
 
   // Filter Envelope
   FILTER_ENV_ATTACK,
   FILTER_ENV_DECAY,
   FILTER_ENV_SUSTAIN_LEVEL,
   FILTER_ENV_RELEASE,
+  FILTER_ENV_ATTACK_CURVE,
+  FILTER_ENV_DECAY_CURVE,
+  FILTER_ENV_RELEASE_CURVE,
 
   // SVF Filter
   SVF_ENABLED,
@@ -64,8 +87,80 @@ enum ParamID {
   LADDER_CUTOFF,
   LADDER_RESONANCE,
   LADDER_DRIVE,
+  LADDER_OVERSAMPLING,
+
+  // Per-voice saturation (after the filters)
+  SATURATOR_ENABLED,
+  SATURATOR_DRIVE,
+  SATURATOR_MIX,
+  SATURATOR_OVERSAMPLING,
+
+  DC_BLOCKER_ENABLED,
+
+  // LFOs
+  LFO1_WAVEFORM,
+  LFO1_RATE,
+  LFO1_RETRIGGER,
+
+  LFO2_WAVEFORM,
+  LFO2_RATE,
+  LFO2_RETRIGGER,
+
+  LFO3_WAVEFORM,
+  LFO3_RATE,
+  LFO3_RETRIGGER,
+
+  // FM: modulator -> carrier index (no self routes), modulator-major
+  FM_OSC1_OSC2,
+  FM_OSC1_OSC3,
+  FM_OSC1_SUB_OSC,
+  FM_OSC2_OSC1,
+  FM_OSC2_OSC3,
+  FM_OSC2_SUB_OSC,
+  FM_OSC3_OSC1,
+  FM_OSC3_OSC2,
+  FM_OSC3_SUB_OSC,
+  FM_SUB_OSC_OSC1,
+  FM_SUB_OSC_OSC2,
+  FM_SUB_OSC_OSC3,
+
+  // Master FX
+  FX_SATURATOR_ENABLED,
+  FX_SATURATOR_DRIVE,
+  FX_SATURATOR_MIX,
+
+  FX_DC_BLOCKER_ENABLED,
+
+  FX_DELAY_ENABLED,
+  FX_DELAY_TIME,
+  FX_DELAY_SYNC,
+  FX_DELAY_DIVISION,
+  FX_DELAY_FEEDBACK,
+  FX_DELAY_MIX,
+
+  FX_REVERB_ENABLED,
+  FX_REVERB_SIZE,
+  FX_REVERB_DECAY,
+  FX_REVERB_DAMPING,
+  FX_REVERB_MIX,
+
+  // Voice (mono/legato, portamento, stereo placement)
+  VOICE_MODE,
+  VOICE_GLIDE_TIME,
+  VOICE_PAN,
+  VOICE_SPREAD,
+
+  // Arpeggiator / step sequencer
+  ARP_ENABLED,
+  ARP_MODE,
+  ARP_DIVISION,
+  ARP_OCTAVES,
+  ARP_GATE,
+  ARP_STEPS,
+  ARP_PATTERN,
 
   MASTER_GAIN,
+  MASTER_TEMPO,
 
   PARAM_COUNT,
 };
@@ -77,6 +172,19 @@ enum ParamValueFormat {
 
 enum ParamValueType { FLOAT, INT8, BOOL, WAVEFORM, FILTER_MODE };
 
+// Modules with data derived from params (Engine::dirtyModules bits)
+enum DirtyModule : uint32_t {
+  DIRTY_NONE = 0,
+  DIRTY_AMP_ENV = 1 << 0,    // Envelope increments + curve tables
+  DIRTY_FILTER_ENV = 1 << 1, // Envelope increments + curve tables
+  DIRTY_SVF = 1 << 2,        // SVFilter::coeffs
+  DIRTY_LADDER = 1 << 3,     // LadderFilter::coeff
+  DIRTY_UNISON = 1 << 4,     // Oscillator::unisonRatios (every oscillator)
+  DIRTY_FM = 1 << 5,         // FMMatrix order/active amounts
+  DIRTY_FX = 1 << 6,         // FXChain delay length, reverb gains, drive
+  DIRTY_PITCH = 1 << 7,      // Oscillator::noteIncrements (every oscillator)
+};
+
 struct ParamBinding {
   union {
     float *floatPtr;
@@ -103,29 +211,47 @@ constexpr ParamMapping PARAM_NAMES[] = {
     {OSC1_DETUNE_AMOUNT, "osc1.detune", ParamValueType::FLOAT},
     {OSC1_OCTAVE_OFFSET, "osc1.octave", ParamValueType::INT8},
     {OSC1_ENABLED, "osc1.enabled", ParamValueType::BOOL},
+    {OSC1_UNISON, "osc1.unison", ParamValueType::INT8},
+    {OSC1_UNISON_DETUNE, "osc1.unisonDetune", ParamValueType::FLOAT},
+    {OSC1_WT_POSITION, "osc1.wtPosition", ParamValueType::FLOAT},
 
     {OSC2_WAVEFORM, "osc2.waveform", ParamValueType::WAVEFORM},
     {OSC2_MIX_LEVEL, "osc2.mixLevel", ParamValueType::FLOAT},
     {OSC2_DETUNE_AMOUNT, "osc2.detune", ParamValueType::FLOAT},
     {OSC2_OCTAVE_OFFSET, "osc2.octave", ParamValueType::INT8},
     {OSC2_ENABLED, "osc2.enabled", ParamValueType::BOOL},
+    {OSC2_UNISON, "osc2.unison", ParamValueType::INT8},
+    {OSC2_UNISON_DETUNE, "osc2.unisonDetune", ParamValueType::FLOAT},
+    {OSC2_WT_POSITION, "osc2.wtPosition", ParamValueType::FLOAT},
 
     {OSC3_WAVEFORM, "osc3.waveform", ParamValueType::WAVEFORM},
     {OSC3_MIX_LEVEL, "osc3.mixLevel", ParamValueType::FLOAT},
     {OSC3_DETUNE_AMOUNT, "osc3.detune", ParamValueType::FLOAT},
     {OSC3_OCTAVE_OFFSET, "osc3.octave", ParamValueType::INT8},
     {OSC3_ENABLED, "osc3.enabled", ParamValueType::BOOL},
+    {OSC3_UNISON, "osc3.unison", ParamValueType::INT8},
+    {OSC3_UNISON_DETUNE, "osc3.unisonDetune", ParamValueType::FLOAT},
+    {OSC3_WT_POSITION, "osc3.wtPosition", ParamValueType::FLOAT},
 
     {SUB_OSC_WAVEFORM, "subOsc.waveform", ParamValueType::WAVEFORM},
     {SUB_OSC_MIX_LEVEL, "subOsc.mixLevel", ParamValueType::FLOAT},
     {SUB_OSC_DETUNE_AMOUNT, "subOsc.detune", ParamValueType::FLOAT},
     {SUB_OSC_OCTAVE_OFFSET, "subOsc.octave", ParamValueType::INT8},
     {SUB_OSC_ENABLED, "subOsc.enabled", ParamValueType::BOOL},
+    {SUB_OSC_UNISON, "subOsc.unison", ParamValueType::INT8},
+    {SUB_OSC_UNISON_DETUNE, "subOsc.unisonDetune", ParamValueType::FLOAT},
+    {SUB_OSC_WT_POSITION, "subOsc.wtPosition", ParamValueType::FLOAT},
+
+    {NOISE_MIX_LEVEL, "noise.mixLevel", ParamValueType::FLOAT},
+    {NOISE_ENABLED, "noise.enabled", ParamValueType::BOOL},
 
     {AMP_ENV_ATTACK, "ampEnv.attack", ParamValueType::FLOAT},
     {AMP_ENV_DECAY, "ampEnv.decay", ParamValueType::FLOAT},
     {AMP_ENV_SUSTAIN_LEVEL, "ampEnv.sustain", ParamValueType::FLOAT},
     {AMP_ENV_RELEASE, "ampEnv.release", ParamValueType::FLOAT},
+    {AMP_ENV_ATTACK_CURVE, "ampEnv.attackCurve", ParamValueType::FLOAT},
+    {AMP_ENV_DECAY_CURVE, "ampEnv.decayCurve", ParamValueType::FLOAT},
+    {AMP_ENV_RELEASE_CURVE, "ampEnv.releaseCurve", ParamValueType::FLOAT},
 
     {SVF_MODE, "svf.mode", ParamValueType::FILTER_MODE},
     {SVF_CUTOFF, "svf.cutoff", ParamValueType::FLOAT},
@@ -135,14 +261,83 @@ constexpr ParamMapping PARAM_NAMES[] = {
     {LADDER_CUTOFF, "ladder.cutoff", ParamValueType::FLOAT},
     {LADDER_RESONANCE, "ladder.resonance", ParamValueType::FLOAT},
     {LADDER_DRIVE, "ladder.drive", ParamValueType::FLOAT},
+    {LADDER_OVERSAMPLING, "ladder.oversampling", ParamValueType::INT8},
     {LADDER_ENABLED, "ladder.enabled", ParamValueType::BOOL},
 
+    {SATURATOR_ENABLED, "saturator.enabled", ParamValueType::BOOL},
+    {SATURATOR_DRIVE, "saturator.drive", ParamValueType::FLOAT},
+    {SATURATOR_MIX, "saturator.mix", ParamValueType::FLOAT},
+    {SATURATOR_OVERSAMPLING, "saturator.oversampling", ParamValueType::INT8},
+
+    {DC_BLOCKER_ENABLED, "dcBlocker.enabled", ParamValueType::BOOL},
+
     {FILTER_ENV_ATTACK, "filterEnv.attack", ParamValueType::FLOAT},
     {FILTER_ENV_DECAY, "filterEnv.decay", ParamValueType::FLOAT},
     {FILTER_ENV_SUSTAIN_LEVEL, "filterEnv.sustain", ParamValueType::FLOAT},
     {FILTER_ENV_RELEASE, "filterEnv.release", ParamValueType::FLOAT},
+    {FILTER_ENV_ATTACK_CURVE, "filterEnv.attackCurve", ParamValueType::FLOAT},
+    {FILTER_ENV_DECAY_CURVE, "filterEnv.decayCurve", ParamValueType::FLOAT},
+    {FILTER_ENV_RELEASE_CURVE, "filterEnv.releaseCurve", ParamValueType::FLOAT},
+
+    {LFO1_WAVEFORM, "lfo1.waveform", ParamValueType::WAVEFORM},
+    {LFO1_RATE, "lfo1.rate", ParamValueType::FLOAT},
+    {LFO1_RETRIGGER, "lfo1.retrigger", ParamValueType::BOOL},
+
+    {LFO2_WAVEFORM, "lfo2.waveform", ParamValueType::WAVEFORM},
+    {LFO2_RATE, "lfo2.rate", ParamValueType::FLOAT},
+    {LFO2_RETRIGGER, "lfo2.retrigger", ParamValueType::BOOL},
+
+    {LFO3_WAVEFORM, "lfo3.waveform", ParamValueType::WAVEFORM},
+    {LFO3_RATE, "lfo3.rate", ParamValueType::FLOAT},
+    {LFO3_RETRIGGER, "lfo3.retrigger", ParamValueType::BOOL},
+
+    {FM_OSC1_OSC2, "fm.osc1>osc2", ParamValueType::FLOAT},
+    {FM_OSC1_OSC3, "fm.osc1>osc3", ParamValueType::FLOAT},
+    {FM_OSC1_SUB_OSC, "fm.osc1>subOsc", ParamValueType::FLOAT},
+    {FM_OSC2_OSC1, "fm.osc2>osc1", ParamValueType::FLOAT},
+    {FM_OSC2_OSC3, "fm.osc2>osc3", ParamValueType::FLOAT},
+    {FM_OSC2_SUB_OSC, "fm.osc2>subOsc", ParamValueType::FLOAT},
+    {FM_OSC3_OSC1, "fm.osc3>osc1", ParamValueType::FLOAT},
+    {FM_OSC3_OSC2, "fm.osc3>osc2", ParamValueType::FLOAT},
+    {FM_OSC3_SUB_OSC, "fm.osc3>subOsc", ParamValueType::FLOAT},
+    {FM_SUB_OSC_OSC1, "fm.subOsc>osc1", ParamValueType::FLOAT},
+    {FM_SUB_OSC_OSC2, "fm.subOsc>osc2", ParamValueType::FLOAT},
+    {FM_SUB_OSC_OSC3, "fm.subOsc>osc3", ParamValueType::FLOAT},
+
+    {FX_SATURATOR_ENABLED, "fx.saturator.enabled", ParamValueType::BOOL},
+    {FX_SATURATOR_DRIVE, "fx.saturator.drive", ParamValueType::FLOAT},
+    {FX_SATURATOR_MIX, "fx.saturator.mix", ParamValueType::FLOAT},
+
+    {FX_DC_BLOCKER_ENABLED, "fx.dcBlocker.enabled", ParamValueType::BOOL},
+
+    {FX_DELAY_ENABLED, "fx.delay.enabled", ParamValueType::BOOL},
+    {FX_DELAY_TIME, "fx.delay.time", ParamValueType::FLOAT},
+    {FX_DELAY_SYNC, "fx.delay.sync", ParamValueType::BOOL},
+    {FX_DELAY_DIVISION, "fx.delay.division", ParamValueType::INT8},
+    {FX_DELAY_FEEDBACK, "fx.delay.feedback", ParamValueType::FLOAT},
+    {FX_DELAY_MIX, "fx.delay.mix", ParamValueType::FLOAT},
+
+    {FX_REVERB_ENABLED, "fx.reverb.enabled", ParamValueType::BOOL},
+    {FX_REVERB_SIZE, "fx.reverb.size", ParamValueType::FLOAT},
+    {FX_REVERB_DECAY, "fx.reverb.decay", ParamValueType::FLOAT},
+    {FX_REVERB_DAMPING, "fx.reverb.damping", ParamValueType::FLOAT},
+    {FX_REVERB_MIX, "fx.reverb.mix", ParamValueType::FLOAT},
+
+    {VOICE_MODE, "voice.mode", ParamValueType::INT8},
+    {VOICE_GLIDE_TIME, "voice.glide", ParamValueType::FLOAT},
+    {VOICE_PAN, "voice.pan", ParamValueType::FLOAT},
+    {VOICE_SPREAD, "voice.spread", ParamValueType::FLOAT},
+
+    {ARP_ENABLED, "arp.enabled", ParamValueType::BOOL},
+    {ARP_MODE, "arp.mode", ParamValueType::INT8},
+    {ARP_DIVISION, "arp.division", ParamValueType::INT8},
+    {ARP_OCTAVES, "arp.octaves", ParamValueType::INT8},
+    {ARP_GATE, "arp.gate", ParamValueType::FLOAT},
+    {ARP_STEPS, "arp.steps", ParamValueType::INT8},
+    {ARP_PATTERN, "arp.pattern", ParamValueType::FLOAT},
 
     {MASTER_GAIN, "master.gain", ParamValueType::FLOAT},
+    {MASTER_TEMPO, "master.tempo", ParamValueType::FLOAT},
 
 };
 
@@ -161,10 +356,15 @@ float getParamValueByID(
 
 void printParamList(const char *optionalParam);
 
+// Writes the value and marks dependent modules dirty (no recompute here)
 void setParamValueByID(
     Engine &engine, ParamID id, float value,
     ParamValueFormat valueFormat = ParamValueFormat::DENORMALIZED);
 
+// Recompute derived data for every dirty module once, then clear the flags
+// Engine calls this at block boundaries (and before a noteOn reads it)
+void updateDirtyModules(Engine &engine);
+
 // String parsing helpers
 ParamMapping findParamByName(const char *name);
 const char *getParamName(ParamID id);
@@ -173,4 +373,8 @@ const char *getParamName(ParamID id);
 SVFMode getSVFModeType(const char *inputValue);
 WaveformType getWaveformType(const char *inputValue);
 
+// Convert a user-entered value (e.g. "saw", "true", "800") to the
+// (denormalized) float value used by ParamEvents
+float parseParamValue(ParamValueType type, const char *inputValue);
+
 } // namespace synth::param::bindings
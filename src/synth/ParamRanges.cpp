@@ -14,6 +14,9 @@ float clampDetune(float detuneAmount) {
 float clampOctave(int8_t octaveOffset) {
   return std::clamp(octaveOffset, OCTAVE_MIN, OCTAVE_MAX);
 }
+int8_t clampUnison(int8_t unisonCount) {
+  return std::clamp(unisonCount, UNISON_MIN, UNISON_MAX);
+}
 } // namespace osc
 
 // Envelope Param Helpers
@@ -26,6 +29,11 @@ float clampSustain(float sustainLevel) {
 }
 } // namespace env
 
+// LFO Param Helpers
+namespace lfo {
+float clampRate(float rate) { return std::clamp(rate, RATE_MIN, RATE_MAX); }
+} // namespace lfo
+
 // Filter Param Helpers
 namespace filter {
 float clampCutoff(float cutoff) {
@@ -53,6 +61,9 @@ float clampMixLevelMod(float mixLevel) {
 float clampResonanceMod(float resonanceMod) {
   return std::clamp(resonanceMod, RESONANCE_MOD_MIN, RESONANCE_MOD_MAX);
 }
+float clampFMDepthMod(float fmDepthMod) {
+  return std::clamp(fmDepthMod, FM_DEPTH_MOD_MIN, FM_DEPTH_MOD_MAX);
+}
 } // namespace mod
 
 // Global Param Helpers
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "synth/Arpeggiator.h"
 #include "synth/Filters.h"
+#include "synth/MasterFX.h"
 #include "synth/Oscillator.h"
+#include "synth/VoicePool.h"
 #include <cstdint>
 
 namespace synth::param::ranges {
@@ -17,10 +20,19 @@ inline constexpr float DETUNE_MIN = -100.0f; // cents
 inline constexpr float DETUNE_MAX = 100.0f;
 inline constexpr int8_t OCTAVE_MIN = -2;
 inline constexpr int8_t OCTAVE_MAX = 2;
+inline constexpr int8_t UNISON_MIN = 1; // copies
+inline constexpr int8_t UNISON_MAX = 16;
+inline constexpr float UNISON_DETUNE_MIN = 0.0f; // cents
+inline constexpr float UNISON_DETUNE_MAX = 100.0f;
+inline constexpr float WT_POSITION_MIN = 0.0f; // first frame
+inline constexpr float WT_POSITION_MAX = 1.0f; // last frame
+static_assert(UNISON_MAX <= static_cast<int8_t>(oscillator::MAX_UNISON),
+              "unison range exceeds the oscillator's copy storage");
 
 float clampMixLevel(float mixLevel);
 float clampDetune(float detuneAmount);
 float clampOctave(int8_t octaveOffset);
+int8_t clampUnison(int8_t unisonCount);
 } // namespace osc
 
 namespace env {
@@ -28,6 +40,8 @@ inline constexpr float TIME_MIN = 0.0f;     // ms
 inline constexpr float TIME_MAX = 10000.0f; // ms
 inline constexpr float SUSTAIN_MIN = 0.0f;
 inline constexpr float SUSTAIN_MAX = 1.0f;
+inline constexpr float CURVE_MIN = -1.0f; // slow start (exponential)
+inline constexpr float CURVE_MAX = 1.0f;  // fast start (logarithmic)
 
 float clampTime(float timeAmount);
 float clampSustain(float sustainLevel);
@@ -43,12 +57,47 @@ inline constexpr float RESONANCE_MIN = 0.0f;
 inline constexpr float RESONANCE_MAX = 1.0f;
 inline constexpr float DRIVE_MIN = 1.0f; // neutral / linear path
 inline constexpr float DRIVE_MAX = 10.0f;
+// Drive path oversampling (log2 factor): 0 = off, 1 = 2x, 2 = 4x
+inline constexpr int8_t OVERSAMPLING_MIN = 0;
+inline constexpr int8_t OVERSAMPLING_MAX = 2;
 
 float clampCutoff(float cutoff);
 float clampResonance(float resonance);
 float clampDrive(float drive);
 } // namespace filter
 
+namespace lfo {
+inline constexpr float RATE_MIN = 0.01f; // Hz
+inline constexpr float RATE_MAX = 50.0f; // Hz
+
+float clampRate(float rate);
+} // namespace lfo
+
+namespace fm {
+inline constexpr float AMOUNT_MIN = 0.0f; // Modulation index (radians)
+inline constexpr float AMOUNT_MAX = 10.0f;
+} // namespace fm
+
+namespace fx {
+inline constexpr float DRIVE_MIN = 0.0f; // normalized
+inline constexpr float DRIVE_MAX = 1.0f;
+inline constexpr float MIX_MIN = 0.0f; // dry -> wet
+inline constexpr float MIX_MAX = 1.0f;
+inline constexpr float DELAY_TIME_MIN = 1.0f; // ms
+inline constexpr float DELAY_TIME_MAX = synth::fx::MAX_DELAY_MS;
+inline constexpr float DELAY_FEEDBACK_MIN = 0.0f;
+inline constexpr float DELAY_FEEDBACK_MAX = 0.95f;
+inline constexpr int8_t DELAY_DIVISION_MIN = 0;
+inline constexpr int8_t DELAY_DIVISION_MAX =
+    static_cast<int8_t>(synth::fx::DelayDivision::DIVISION_COUNT) - 1;
+inline constexpr float REVERB_SIZE_MIN = dsp::reverb::REVERB_SIZE_MIN;
+inline constexpr float REVERB_SIZE_MAX = dsp::reverb::REVERB_SIZE_MAX;
+inline constexpr float REVERB_DECAY_MIN = 0.1f; // RT60 seconds
+inline constexpr float REVERB_DECAY_MAX = 20.0f;
+inline constexpr float REVERB_DAMPING_MIN = 0.0f;
+inline constexpr float REVERB_DAMPING_MAX = 0.95f;
+} // namespace fx
+
 namespace mod {
 // Cutoff modulation depth (octaves, bipolar)
 inline constexpr float CUTOFF_MOD_MIN = -4.0f;
@@ -66,16 +115,53 @@ inline constexpr float MIX_LEVEL_MOD_MAX = 1.0f;
 inline constexpr float RESONANCE_MOD_MIN = -1.0f;
 inline constexpr float RESONANCE_MOD_MAX = 1.0f;
 
+// FM depth modulation (linear, bipolar) — scales every FM index
+inline constexpr float FM_DEPTH_MOD_MIN = -1.0f;
+inline constexpr float FM_DEPTH_MOD_MAX = 1.0f;
+
 float clampCutoffMod(float cutoffMod);
 float clampPitchMod(float pitchMod);
 float clampMixLevelMod(float mixLevel);
 float clampResonanceMod(float resonanceMod);
+float clampFMDepthMod(float fmDepthMod);
 
 } // namespace mod
 
+namespace voice {
+// Poly, Mono, Legato (voices::VoiceMode)
+inline constexpr int8_t MODE_MIN = 0;
+inline constexpr int8_t MODE_MAX =
+    static_cast<int8_t>(voices::VoiceMode::MODE_COUNT) - 1;
+inline constexpr float GLIDE_TIME_MIN = 0.0f; // ms (0 = no glide)
+inline constexpr float GLIDE_TIME_MAX = 5000.0f;
+inline constexpr float PAN_MIN = -1.0f; // hard left
+inline constexpr float PAN_MAX = 1.0f;  // hard right
+inline constexpr float SPREAD_MIN = 0.0f; // every voice at _pan_
+inline constexpr float SPREAD_MAX = 1.0f; // voices across the full width
+} // namespace voice
+
+namespace arp {
+inline constexpr int8_t MODE_MIN = 0;
+inline constexpr int8_t MODE_MAX =
+    static_cast<int8_t>(synth::arp::ArpMode::MODE_COUNT) - 1;
+inline constexpr int8_t DIVISION_MIN = 0; // fx::DelayDivision
+inline constexpr int8_t DIVISION_MAX =
+    static_cast<int8_t>(synth::fx::DelayDivision::DIVISION_COUNT) - 1;
+inline constexpr int8_t OCTAVES_MIN = 1;
+inline constexpr int8_t OCTAVES_MAX = 4;
+inline constexpr float GATE_MIN = 0.01f; // fraction of a step
+inline constexpr float GATE_MAX = 1.0f;  // legato
+inline constexpr int8_t STEPS_MIN = 1;
+inline constexpr int8_t STEPS_MAX = static_cast<int8_t>(synth::arp::MAX_ARP_STEPS);
+inline constexpr float PATTERN_MIN = 0.0f; // step bit mask
+inline constexpr float PATTERN_MAX = synth::arp::ALL_STEPS_PATTERN;
+} // namespace arp
+
 namespace global {
 inline constexpr float MASTER_GAIN_MIN = 0.0f;
 inline constexpr float MASTER_GAIN_MAX = 2.0f; // 2.0 ≈ +6 dB
+inline constexpr float TEMPO_MIN = 20.0f; // BPM
+inline constexpr float TEMPO_MAX = 300.0f;
 
 float clampMasterGain(float masterGain);
 } // namespace global
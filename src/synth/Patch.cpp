@@ -0,0 +1,547 @@
+#include "Patch.h"
+
+#include "ByteOrder.h"
+#include "Engine.h"
+#include "Envelope.h"
+
+#include "synth_io/Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace synth::patch {
+namespace pb = param::bindings;
+namespace mm = mod_matrix;
+using namespace byte_order;
+
+// Oscillator params are 8 per oscillator (see bindOscillator)
+inline constexpr int UNISON_OFFSET = pb::OSC1_UNISON - pb::OSC1_WAVEFORM;
+inline constexpr int UNISON_DETUNE_OFFSET =
+    pb::OSC1_UNISON_DETUNE - pb::OSC1_WAVEFORM;
+inline constexpr int DETUNE_OFFSET = pb::OSC1_DETUNE_AMOUNT - pb::OSC1_WAVEFORM;
+inline constexpr int OCTAVE_OFFSET = pb::OSC1_OCTAVE_OFFSET - pb::OSC1_WAVEFORM;
+
+// Larger files are not presets (sanity check before reading)
+inline constexpr long MAX_PRESET_FILE_BYTES = 1 << 16;
+
+// ==== <Preset Helpers> ====
+namespace {
+
+// FNV-1a: stable across builds, so are the preset keys
+uint32_t hashName(const char *name) {
+  uint32_t hash = 2166136261u;
+  for (const char *c = name; *c; c++) {
+    hash ^= static_cast<uint8_t>(*c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+const char *findSrcName(mm::ModSrc src) {
+  for (const auto &mapping : mm::modSrcMappings)
+    if (mapping.src == src)
+      return mapping.name;
+  return nullptr;
+}
+
+const char *findDestName(mm::ModDest dest) {
+  for (const auto &mapping : mm::modDestMappings)
+    if (mapping.dest == dest)
+      return mapping.name;
+  return nullptr;
+}
+
+mm::ModSrc findSrcByHash(uint32_t hash) {
+  for (const auto &mapping : mm::modSrcMappings)
+    if (hashName(mapping.name) == hash)
+      return mapping.src;
+  return mm::ModSrc::NoSrc;
+}
+
+mm::ModDest findDestByHash(uint32_t hash) {
+  for (const auto &mapping : mm::modDestMappings)
+    if (hashName(mapping.name) == hash)
+      return mapping.dest;
+  return mm::ModDest::NoDest;
+}
+
+// Same value setParamValueByID would store (range clamped, ints rounded)
+float canonicalValue(const pb::ParamBinding &binding, float value) {
+  value = std::clamp(value, binding.min, binding.max);
+
+  if (binding.type == pb::FLOAT)
+    return value;
+  if (binding.type == pb::BOOL)
+    return value >= 0.5f ? 1.0f : 0.0f;
+  return std::round(value);
+}
+
+// Copies a NUL terminated string (truncated to _capacity_ - 1 chars)
+void copyInfoString(char *dest, size_t capacity, const char *src) {
+  size_t length = strnlen(src, capacity - 1);
+  std::memcpy(dest, src, length);
+  dest[length] = '\0';
+}
+
+// Appends _text_ with its terminator, returns the bytes written
+size_t writeInfoString(uint8_t *bytes, const char *text, size_t capacity) {
+  size_t length = strnlen(text, capacity - 1);
+  std::memcpy(bytes, text, length);
+  bytes[length] = 0;
+  return length + 1;
+}
+
+// Live engine values: audio thread (or nothing rendering) only
+void captureValues(const Engine &engine, Patch &patch) {
+  for (int id = 0; id < ParamID::PARAM_COUNT; id++)
+    patch.paramValues[id] =
+        pb::getParamValueByID(engine, static_cast<ParamID>(id));
+
+  const mm::ModMatrix &matrix = engine.voicePool.modMatrix;
+  patch.routeCount = matrix.count;
+  for (uint8_t r = 0; r < matrix.count; r++)
+    patch.routes[r] = matrix.routes[r];
+
+  patch.tuning = engine.voicePool.tuning;
+}
+
+// Any other thread: the latest published shadow (see publishPatchShadow)
+void captureShadowValues(Engine &engine, Patch &patch) {
+  std::lock_guard<std::mutex> lock(engine.patchPostMutex);
+
+  if (engine.shadowMiddleIndex.load(std::memory_order_relaxed) &
+      Engine::PATCH_SHADOW_FRESH)
+    engine.shadowReadIndex =
+        engine.shadowMiddleIndex.exchange(engine.shadowReadIndex,
+                                          std::memory_order_acq_rel) &
+        ~Engine::PATCH_SHADOW_FRESH;
+
+  const Patch &shadow = engine.patchShadows[engine.shadowReadIndex];
+  std::memcpy(patch.paramValues, shadow.paramValues,
+              sizeof(patch.paramValues));
+  patch.routeCount = shadow.routeCount;
+  for (uint8_t r = 0; r < shadow.routeCount; r++)
+    patch.routes[r] = shadow.routes[r];
+  patch.tuning = shadow.tuning;
+}
+
+EnvelopeIncrements computeEnvelope(const float *values, ParamID attackId,
+                                   float sampleRate) {
+  EnvelopeIncrements increments{};
+  increments.attack =
+      envelope::computeIncrement(values[attackId], sampleRate);
+  increments.decay =
+      envelope::computeIncrement(values[attackId + 1], sampleRate);
+  increments.release =
+      envelope::computeIncrement(values[attackId + 3], sampleRate);
+  increments.curves = envelope::computeCurves(
+      values[attackId + 4], values[attackId + 5], values[attackId + 6]);
+  return increments;
+}
+
+// Applied patches go back to the posting thread (never freed here)
+void retirePatch(Engine &engine, Patch *patch) {
+  for (auto &slot : engine.retiredPatches) {
+    Patch *expected = nullptr;
+    if (slot.compare_exchange_strong(expected, patch,
+                                     std::memory_order_acq_rel))
+      return;
+  }
+
+  // NOTE: unreachable while posts are serialized, leaking the patch beats
+  // freeing it on the audio thread
+}
+
+void freeRetiredPatches(Engine &engine) {
+  for (auto &slot : engine.retiredPatches)
+    disposePatch(slot.exchange(nullptr, std::memory_order_acq_rel));
+}
+
+} // namespace
+// ==== </Preset Helpers> ====
+
+// ==== Building ====
+Patch *capturePatch(Engine &engine) {
+  auto *patch = new Patch();
+  captureShadowValues(engine, *patch);
+  buildPatch(engine, *patch);
+  return patch;
+}
+
+void disposePatch(Patch *patch) { delete patch; }
+
+void buildPatch(const Engine &engine, Patch &patch) {
+  const float *values = patch.paramValues;
+  const float sampleRate = engine.sampleRate;
+  const float invSampleRate = engine.voicePool.invSampleRate;
+
+  patch.ampEnv = computeEnvelope(values, pb::AMP_ENV_ATTACK, sampleRate);
+  patch.filterEnv =
+      computeEnvelope(values, pb::FILTER_ENV_ATTACK, sampleRate);
+
+  patch.svfCoeffs = filters::computeSVFCoefficients(
+      values[pb::SVF_CUTOFF], values[pb::SVF_RESONANCE], invSampleRate);
+  patch.ladderCoeff = filters::computeLadderCoefficient(
+      values[pb::LADDER_CUTOFF], invSampleRate);
+
+  constexpr ParamID OSC_BASE_IDS[fm_matrix::FM_OSC_COUNT] = {
+      pb::OSC1_WAVEFORM, pb::OSC2_WAVEFORM, pb::OSC3_WAVEFORM,
+      pb::SUB_OSC_WAVEFORM};
+
+  for (size_t o = 0; o < fm_matrix::FM_OSC_COUNT; o++) {
+    int base = OSC_BASE_IDS[o];
+    patch.unison[o] = oscillator::computeUnison(
+        static_cast<int8_t>(values[base + UNISON_OFFSET]),
+        values[base + UNISON_DETUNE_OFFSET]);
+
+    oscillator::computeNoteIncrements(
+        patch.tuning, static_cast<int8_t>(values[base + OCTAVE_OFFSET]),
+        values[base + DETUNE_OFFSET], sampleRate, patch.noteIncrements[o]);
+  }
+
+  // Modulator-major, self routes skipped (same order as the FM ParamIDs)
+  patch.fmMatrix = fm_matrix::FMMatrix{};
+  int fmId = pb::FM_OSC1_OSC2;
+  for (uint8_t m = 0; m < fm_matrix::FM_OSC_COUNT; m++) {
+    for (uint8_t c = 0; c < fm_matrix::FM_OSC_COUNT; c++) {
+      if (m != c)
+        patch.fmMatrix.amounts[m][c] = values[fmId++];
+    }
+  }
+  fm_matrix::compileFMOrder(patch.fmMatrix);
+
+  patch.compiledRoutes =
+      mm::buildCompiledRoutes(patch.routes, patch.routeCount);
+}
+
+// ==== Preset Files ====
+size_t encodePreset(const Patch &patch, const PresetInfo *info,
+                    uint8_t *bytes, size_t capacity) {
+  if (capacity < MAX_PRESET_BYTES)
+    return 0;
+
+  uint8_t *cursor = bytes + PRESET_HEADER_BYTES;
+  uint16_t paramCount = 0;
+  uint16_t routeCount = 0;
+
+  for (const auto &mapping : pb::PARAM_NAMES) {
+    writeU32(cursor, hashName(mapping.name));
+    writeF32(cursor + 4, patch.paramValues[mapping.id]);
+    cursor += PRESET_PARAM_BYTES;
+    paramCount++;
+  }
+
+  for (uint8_t r = 0; r < patch.routeCount; r++) {
+    const ModRoute &route = patch.routes[r];
+    const char *srcName = findSrcName(route.src);
+    const char *destName = findDestName(route.dest);
+    if (!srcName || !destName)
+      continue;
+
+    writeU32(cursor, hashName(srcName));
+    writeU32(cursor + 4, hashName(destName));
+    writeF32(cursor + 8, route.amount);
+    cursor += PRESET_ROUTE_BYTES;
+    routeCount++;
+  }
+
+  uint8_t *infoStart = cursor;
+  if (info) {
+    cursor += writeInfoString(cursor, info->name, PRESET_NAME_CHARS);
+    cursor += writeInfoString(cursor, info->category, PRESET_CATEGORY_CHARS);
+    cursor += writeInfoString(cursor, info->tags, PRESET_TAGS_CHARS);
+  }
+
+  writeU32(bytes, PRESET_MAGIC);
+  writeU16(bytes + 4, PRESET_VERSION);
+  writeU16(bytes + 6, paramCount);
+  writeU16(bytes + 8, routeCount);
+  writeU16(bytes + 10, static_cast<uint16_t>(cursor - infoStart));
+
+  return static_cast<size_t>(cursor - bytes);
+}
+
+bool decodePreset(const Engine &engine, const uint8_t *bytes,
+                  size_t numBytes, Patch &patch) {
+  if (numBytes < PRESET_HEADER_BYTES || readU32(bytes) != PRESET_MAGIC ||
+      readU16(bytes + 4) != PRESET_VERSION)
+    return false;
+
+  const size_t paramCount = readU16(bytes + 6);
+  const size_t routeCount = readU16(bytes + 8);
+  if (numBytes < PRESET_HEADER_BYTES + paramCount * PRESET_PARAM_BYTES +
+                     routeCount * PRESET_ROUTE_BYTES)
+    return false;
+
+  uint32_t paramHashes[pb::PARAM_NAME_COUNT];
+  for (size_t i = 0; i < pb::PARAM_NAME_COUNT; i++)
+    paramHashes[i] = hashName(pb::PARAM_NAMES[i].name);
+
+  const uint8_t *cursor = bytes + PRESET_HEADER_BYTES;
+  for (size_t p = 0; p < paramCount; p++, cursor += PRESET_PARAM_BYTES) {
+    uint32_t hash = readU32(cursor);
+    float value = readF32(cursor + 4);
+    if (!std::isfinite(value))
+      continue;
+
+    for (size_t i = 0; i < pb::PARAM_NAME_COUNT; i++) {
+      if (paramHashes[i] != hash)
+        continue;
+
+      ParamID id = pb::PARAM_NAMES[i].id;
+      patch.paramValues[id] = canonicalValue(engine.paramBindings[id], value);
+      break;
+    }
+  }
+
+  // The preset's routing replaces the old one (no merging)
+  patch.routeCount = 0;
+  for (size_t r = 0; r < routeCount; r++, cursor += PRESET_ROUTE_BYTES) {
+    ModRoute route{};
+    route.src = findSrcByHash(readU32(cursor));
+    route.dest = findDestByHash(readU32(cursor + 4));
+    route.amount = readF32(cursor + 8);
+
+    if (route.src == mm::ModSrc::NoSrc || route.dest == mm::ModDest::NoDest ||
+        !std::isfinite(route.amount) ||
+        patch.routeCount == mm::MAX_MOD_ROUTES)
+      continue;
+
+    patch.routes[patch.routeCount++] = route;
+  }
+
+  return true;
+}
+
+bool decodePresetInfo(const uint8_t *bytes, size_t numBytes,
+                      PresetInfo &info) {
+  info = PresetInfo{};
+  if (numBytes < PRESET_HEADER_BYTES || readU32(bytes) != PRESET_MAGIC ||
+      readU16(bytes + 4) != PRESET_VERSION)
+    return false;
+
+  const size_t infoStart = PRESET_HEADER_BYTES +
+                           readU16(bytes + 6) * PRESET_PARAM_BYTES +
+                           readU16(bytes + 8) * PRESET_ROUTE_BYTES;
+  const size_t infoBytes = readU16(bytes + 10);
+  if (numBytes < infoStart + infoBytes)
+    return false;
+
+  // name\0category\0tags\0 (a field missing its terminator ends the info)
+  char *fields[3] = {info.name, info.category, info.tags};
+  const size_t capacities[3] = {PRESET_NAME_CHARS, PRESET_CATEGORY_CHARS,
+                                PRESET_TAGS_CHARS};
+
+  const auto *cursor = reinterpret_cast<const char *>(bytes + infoStart);
+  const char *infoEnd = cursor + infoBytes;
+  for (size_t f = 0; f < 3; f++) {
+    const auto *terminator = static_cast<const char *>(
+        std::memchr(cursor, '\0', static_cast<size_t>(infoEnd - cursor)));
+    if (!terminator)
+      break;
+
+    copyInfoString(fields[f], capacities[f], cursor);
+    cursor = terminator + 1;
+  }
+
+  return true;
+}
+
+bool savePresetFile(Engine &engine, const char *path,
+                    const PresetInfo *info) {
+  Patch patch{};
+  captureShadowValues(engine, patch);
+
+  uint8_t bytes[MAX_PRESET_BYTES];
+  size_t numBytes = encodePreset(patch, info, bytes, sizeof(bytes));
+
+  FILE *file = fopen(path, "wb");
+  if (!file)
+    return false;
+
+  bool isWritten = fwrite(bytes, 1, numBytes, file) == numBytes;
+  return fclose(file) == 0 && isWritten;
+}
+
+Patch *loadPresetFile(Engine &engine, const char *path) {
+  FILE *file = fopen(path, "rb");
+  if (!file) {
+    printf("Preset: unable to open %s\n", path);
+    return nullptr;
+  }
+
+  std::vector<uint8_t> bytes;
+  if (fseek(file, 0, SEEK_END) == 0) {
+    long size = ftell(file);
+    if (size > 0 && size <= MAX_PRESET_FILE_BYTES) {
+      bytes.resize(static_cast<size_t>(size));
+      rewind(file);
+      if (fread(bytes.data(), 1, bytes.size(), file) != bytes.size())
+        bytes.clear();
+    }
+  }
+  fclose(file);
+
+  auto *patch = new Patch();
+  captureShadowValues(engine, *patch);
+
+  if (bytes.empty() ||
+      !decodePreset(engine, bytes.data(), bytes.size(), *patch)) {
+    printf("Preset: %s is not a preset (or from a newer version)\n", path);
+    disposePatch(patch);
+    return nullptr;
+  }
+
+  buildPatch(engine, *patch);
+  return patch;
+}
+
+// ==== Program Change ====
+void postPatch(Engine &engine, Patch *patch) {
+  // Serialized posts keep the retire slots from filling up (see Engine.h)
+  std::lock_guard<std::mutex> lock(engine.patchPostMutex);
+
+  // Still pending = never seen by the audio thread, safe to free here
+  disposePatch(engine.pendingPatch.exchange(patch, std::memory_order_acq_rel));
+  freeRetiredPatches(engine);
+}
+
+void postTuning(Engine &engine, const tuning::Tuning &tuning) {
+  Patch *patch = new Patch();
+  captureShadowValues(engine, *patch);
+  patch->tuning = tuning;
+  {
+    std::lock_guard<std::mutex> lock(engine.patchPostMutex);
+    patch->tuning.generation = ++engine.tuningGeneration;
+  }
+
+  buildPatch(engine, *patch);
+  postPatch(engine, patch);
+}
+
+void applyPendingPatch(Engine &engine) {
+  // One relaxed load per block when no program change is waiting
+  if (!engine.pendingPatch.load(std::memory_order_relaxed))
+    return;
+
+  Patch *patch =
+      engine.pendingPatch.exchange(nullptr, std::memory_order_acq_rel);
+  if (!patch)
+    return;
+
+  SYNTH_TRACE_SCOPE("applyPatch");
+  applyPatch(engine, *patch);
+  retirePatch(engine, patch);
+}
+
+void applyPatch(Engine &engine, const Patch &patch) {
+  for (int id = 0; id < ParamID::PARAM_COUNT; id++)
+    pb::setParamValueByID(engine, static_cast<ParamID>(id),
+                          patch.paramValues[id]);
+
+  voices::VoicePool &pool = engine.voicePool;
+
+  pool.ampEnv.attackIncrement = patch.ampEnv.attack;
+  pool.ampEnv.decayIncrement = patch.ampEnv.decay;
+  pool.ampEnv.releaseIncrement = patch.ampEnv.release;
+  pool.ampEnv.curves = patch.ampEnv.curves;
+
+  pool.filterEnv.attackIncrement = patch.filterEnv.attack;
+  pool.filterEnv.decayIncrement = patch.filterEnv.decay;
+  pool.filterEnv.releaseIncrement = patch.filterEnv.release;
+  pool.filterEnv.curves = patch.filterEnv.curves;
+
+  pool.svf.coeffs = patch.svfCoeffs;
+  pool.ladder.coeff = patch.ladderCoeff;
+
+  oscillator::Oscillator *oscs[fm_matrix::FM_OSC_COUNT] = {
+      &pool.osc1, &pool.osc2, &pool.osc3, &pool.subOsc};
+  for (size_t o = 0; o < fm_matrix::FM_OSC_COUNT; o++) {
+    std::memcpy(oscs[o]->unisonRatios, patch.unison[o].ratios,
+                sizeof(oscs[o]->unisonRatios));
+    oscs[o]->unisonGain = patch.unison[o].gain;
+  }
+
+  // Tables built for an older tuning (e.g. prefetched before a retune):
+  // keep the engine's, rebuild here (4 x 128 divides)
+  if (patch.tuning.generation > pool.tuning.generation)
+    pool.tuning = patch.tuning;
+
+  if (patch.tuning.generation == pool.tuning.generation) {
+    for (size_t o = 0; o < fm_matrix::FM_OSC_COUNT; o++)
+      std::memcpy(oscs[o]->noteIncrements, patch.noteIncrements[o],
+                  sizeof(oscs[o]->noteIncrements));
+  } else {
+    voices::updatePitchTables(pool);
+  }
+
+  pool.fmMatrix = patch.fmMatrix;
+
+  mm::ModMatrix &matrix = pool.modMatrix;
+  matrix.count = patch.routeCount;
+  for (uint8_t r = 0; r < patch.routeCount; r++)
+    matrix.routes[r] = patch.routes[r];
+  mm::setCompiledRoutes(matrix, patch.compiledRoutes);
+
+  // Everything but the FX lengths is already current
+  engine.dirtyModules &= pb::DIRTY_FX;
+
+  publishPatchShadow(engine);
+}
+
+void publishPatchShadow(Engine &engine) {
+  if (!engine.patchShadows)
+    return;
+
+  // Values only: the derived section is rebuilt by whoever captures
+  captureValues(engine, engine.patchShadows[engine.shadowWriteIndex]);
+  engine.shadowWriteIndex =
+      engine.shadowMiddleIndex.exchange(engine.shadowWriteIndex |
+                                            Engine::PATCH_SHADOW_FRESH,
+                                        std::memory_order_acq_rel) &
+      ~Engine::PATCH_SHADOW_FRESH;
+  engine.isPatchShadowStale = false;
+}
+
+void capturePatchState(const Engine &engine, Patch &patch) {
+  captureValues(engine, patch);
+
+  const voices::VoicePool &pool = engine.voicePool;
+
+  patch.ampEnv = {pool.ampEnv.attackIncrement, pool.ampEnv.decayIncrement,
+                  pool.ampEnv.releaseIncrement, pool.ampEnv.curves};
+  patch.filterEnv = {pool.filterEnv.attackIncrement,
+                     pool.filterEnv.decayIncrement,
+                     pool.filterEnv.releaseIncrement, pool.filterEnv.curves};
+
+  patch.svfCoeffs = pool.svf.coeffs;
+  patch.ladderCoeff = pool.ladder.coeff;
+
+  const oscillator::Oscillator *oscs[fm_matrix::FM_OSC_COUNT] = {
+      &pool.osc1, &pool.osc2, &pool.osc3, &pool.subOsc};
+  for (size_t o = 0; o < fm_matrix::FM_OSC_COUNT; o++) {
+    std::memcpy(patch.unison[o].ratios, oscs[o]->unisonRatios,
+                sizeof(patch.unison[o].ratios));
+    patch.unison[o].gain = oscs[o]->unisonGain;
+    std::memcpy(patch.noteIncrements[o], oscs[o]->noteIncrements,
+                sizeof(patch.noteIncrements[o]));
+  }
+
+  patch.fmMatrix = pool.fmMatrix;
+  patch.compiledRoutes = pool.modMatrix.compiled;
+}
+
+void disposePatches(Engine &engine) {
+  std::lock_guard<std::mutex> lock(engine.patchPostMutex);
+  disposePatch(
+      engine.pendingPatch.exchange(nullptr, std::memory_order_acq_rel));
+  freeRetiredPatches(engine);
+}
+
+} // namespace synth::patch
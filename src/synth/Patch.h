@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Envelope.h"
+#include "FMMatrix.h"
+#include "Filters.h"
+#include "ModMatrix.h"
+#include "Oscillator.h"
+#include "ParamBindings.h"
+#include "Tuning.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace synth {
+struct Engine;
+}
+
+namespace synth::patch {
+using ParamID = param::bindings::ParamID;
+using ModRoute = mod_matrix::ModRoute;
+
+/* ==== Preset file ====
+ * Compact, little-endian, fixed size records (one fread, no parsing):
+ *   header | magic u32 | version u16 | paramCount u16 | routeCount u16 |
+ *            infoBytes u16
+ *   params | nameHash u32 | value f32 (denormalized)       x paramCount
+ *   routes | srcHash u32 | destHash u32 | amount f32       x routeCount
+ *   info   | name, category, tags (NUL terminated)         infoBytes
+ *
+ * Params/sources/destinations are keyed by a hash of their name, not their
+ * enum value: presets survive enum reordering, unknown records are skipped
+ * and params missing from the file keep the value they were loaded onto.
+ */
+inline constexpr uint32_t PRESET_MAGIC = 0x5048454D; // "MEHP"
+inline constexpr uint16_t PRESET_VERSION = 1;
+
+inline constexpr size_t PRESET_HEADER_BYTES = 12;
+inline constexpr size_t PRESET_PARAM_BYTES = 8;
+inline constexpr size_t PRESET_ROUTE_BYTES = 12;
+
+// PresetInfo fields, terminator included
+inline constexpr size_t PRESET_NAME_CHARS = 48;
+inline constexpr size_t PRESET_CATEGORY_CHARS = 24;
+inline constexpr size_t PRESET_TAGS_CHARS = 64; // comma separated
+
+inline constexpr size_t MAX_PRESET_BYTES =
+    PRESET_HEADER_BYTES + PRESET_PARAM_BYTES * ParamID::PARAM_COUNT +
+    PRESET_ROUTE_BYTES * mod_matrix::MAX_MOD_ROUTES + PRESET_NAME_CHARS +
+    PRESET_CATEGORY_CHARS + PRESET_TAGS_CHARS;
+
+// Browsing metadata (empty strings when a preset has none)
+struct PresetInfo {
+  char name[PRESET_NAME_CHARS] = {};
+  char category[PRESET_CATEGORY_CHARS] = {};
+  char tags[PRESET_TAGS_CHARS] = {};
+};
+
+struct EnvelopeIncrements {
+  float attack = 0.0f;
+  float decay = 0.0f;
+  float release = 0.0f;
+  envelope::StageCurves curves{};
+};
+
+/* Complete patch state: every param + the mod matrix routes, and the data
+ * the engine derives from them, precomputed by buildPatch
+ * - built on any non-real-time thread
+ * - applied at a block boundary with plain copies (applyPatch), nothing is
+ *   recomputed on the audio thread except the FX delay/reverb lengths
+ *   (they depend on the engine's delay memory, see updateFXChain)
+ */
+struct Patch {
+  float paramValues[ParamID::PARAM_COUNT] = {}; // denormalized
+
+  ModRoute routes[mod_matrix::MAX_MOD_ROUTES];
+  uint8_t routeCount = 0;
+
+  // The engine's tuning when captured (not part of preset files)
+  tuning::Tuning tuning{};
+
+  // ==== Derived (buildPatch, at the engine's render rate) ====
+  EnvelopeIncrements ampEnv{};
+  EnvelopeIncrements filterEnv{};
+  filters::SVFCoeffs svfCoeffs{};
+  float ladderCoeff = 0.0f;
+  oscillator::UnisonSpread unison[fm_matrix::FM_OSC_COUNT]; // FMOsc order
+  float noteIncrements[fm_matrix::FM_OSC_COUNT][tuning::NUM_TUNING_NOTES];
+  fm_matrix::FMMatrix fmMatrix{};
+  mod_matrix::CompiledRoutes compiledRoutes{};
+};
+
+// ==== Building (any non-real-time thread) ====
+
+/* Heap allocated copy of the engine's current params + routes (built)
+ * - read from the patch shadow (what the audio thread last published, see
+ *   publishPatchShadow), never from the live engine
+ * NOTE: allocates, release with disposePatch (or hand it to postPatch)
+ */
+Patch *capturePatch(Engine &engine);
+void disposePatch(Patch *patch);
+
+// Recompute the derived section from paramValues/routes
+void buildPatch(const Engine &engine, Patch &patch);
+
+// ==== Preset Files ====
+
+// Returns the bytes written (0 = _capacity_ is too small)
+// _info_ is optional (nullptr = no info section)
+size_t encodePreset(const Patch &patch, const PresetInfo *info,
+                    uint8_t *bytes, size_t capacity);
+
+// Decodes onto _patch_ (values are clamped to their param range)
+// NOTE: doesn't build, call buildPatch after
+bool decodePreset(const Engine &engine, const uint8_t *bytes,
+                  size_t numBytes, Patch &patch);
+
+// Just the info section (no params decoded, e.g. indexing a library)
+bool decodePresetInfo(const uint8_t *bytes, size_t numBytes,
+                      PresetInfo &info);
+
+bool savePresetFile(Engine &engine, const char *path,
+                    const PresetInfo *info = nullptr);
+
+// The engine's current patch with the file's params/routes on top (built)
+// Returns nullptr (and prints why) on error
+Patch *loadPresetFile(Engine &engine, const char *path);
+
+// ==== Program Change ====
+
+/* Hand _patch_ (built) to the audio thread, it's applied at the start of
+ * the next processAudioBlock
+ * - takes ownership; a patch still waiting from an earlier post is freed
+ *   (latest wins, a burst of program changes costs one apply)
+ * - frees the patches the audio thread is done with
+ * NOTE: any thread but the audio thread (posts are serialized)
+ */
+void postPatch(Engine &engine, Patch *patch);
+
+/* Retune: the engine's current patch with _tuning_, built and posted
+ * (playing voices keep their pitch, the next note-ons use it)
+ * NOTE: same threads as postPatch
+ */
+void postTuning(Engine &engine, const tuning::Tuning &tuning);
+
+// Audio thread, block boundary: apply the posted patch (if any)
+void applyPendingPatch(Engine &engine);
+
+// Writes params, routes and derived data into the engine, no allocation
+// (applyPendingPatch, or directly when nothing is rendering)
+// Publishes the patch shadow
+void applyPatch(Engine &engine, const Patch &patch);
+
+/* Copy the engine's params, routes and tuning into the patch shadow the
+ * building threads read (capturePatch, presets, postTuning)
+ * - applyPatch, and processAudioBlock after param events
+ * - no allocation, no lock (one index swap)
+ * NOTE: audio thread, or directly when nothing is rendering
+ */
+void publishPatchShadow(Engine &engine);
+
+// Inverse of applyPatch: params, routes and the engine's derived data as
+// they are (copies, nothing rebuilt), no allocation
+// NOTE: block boundary, after updateDirtyModules (see snapshot::Snapshot)
+void capturePatchState(const Engine &engine, Patch &patch);
+
+// Frees posted/retired patches (audio session stopped, disposeEngine)
+// NOTE: not the shadow (disposeEngine frees it)
+void disposePatches(Engine &engine);
+
+} // namespace synth::patch
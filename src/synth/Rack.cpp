@@ -0,0 +1,273 @@
+#include "Rack.h"
+#include "Patch.h"
+
+#include "synth_io/Trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace synth::rack {
+
+// ==== <Rack Helpers> ====
+namespace {
+
+float *allocateBuffer(uint32_t numFrames) {
+  return new (std::align_val_t{Engine::BUFFER_ALIGNMENT}) float[numFrames]();
+}
+
+void freeBuffer(float *buffer) {
+  operator delete[](buffer, std::align_val_t{Engine::BUFFER_ALIGNMENT});
+}
+
+bool isLayerNote(const LayerConfig &config, const NoteEvent &event) {
+  if (config.channel != ANY_CHANNEL && config.channel != event.channel)
+    return false;
+
+  return event.midiNote >= config.lowKey && event.midiNote <= config.highKey;
+}
+
+// WorkerTaskFn: renders layer _index_ into its own buffers
+void renderLayer(void *context, uint32_t index) {
+  auto &rack = *static_cast<Rack *>(context);
+  Layer &layer = rack.layers[index];
+
+  SYNTH_TRACE_SCOPE("renderLayer");
+  layer.engine->processAudioBlock(layer.buffers, LAYER_CHANNELS,
+                                  rack.chunkFrames);
+}
+
+// Accumulates every layer's pair into _outputBuffer_ (frames from _start_)
+void mixLayers(Rack &rack, float **outputBuffer, size_t numChannels,
+               size_t start, size_t numFrames) {
+  for (uint32_t i = 0; i < rack.layerCount; i++) {
+    const Layer &layer = rack.layers[i];
+    const float *left = layer.buffers[0];
+    const float *right = layer.buffers[1];
+    float gain = layer.config.gain;
+
+    if (numChannels == 1) {
+      float *out = outputBuffer[0] + start;
+      float foldGain = gain * 0.5f;
+      for (size_t s = 0; s < numFrames; s++)
+        out[s] += (left[s] + right[s]) * foldGain;
+      continue;
+    }
+
+    size_t first = static_cast<size_t>(layer.config.bus) * LAYER_CHANNELS;
+    if (first + 1 >= numChannels)
+      first = 0;
+
+    float *outLeft = outputBuffer[first] + start;
+    float *outRight = outputBuffer[first + 1] + start;
+    for (size_t s = 0; s < numFrames; s++) {
+      outLeft[s] += left[s] * gain;
+      outRight[s] += right[s] * gain;
+    }
+  }
+}
+
+bool parseKeyRange(const char *value, LayerConfig &config) {
+  char *end = nullptr;
+  long low = std::strtol(value, &end, 10);
+  if (end == value || *end != '-')
+    return false;
+
+  const char *highStart = end + 1;
+  long high = std::strtol(highStart, &end, 10);
+  if (end == highStart || low < 0 || high > 127 || low > high)
+    return false;
+
+  config.lowKey = static_cast<uint8_t>(low);
+  config.highKey = static_cast<uint8_t>(high);
+  return true;
+}
+
+// One `key=value` field of a layer spec (_length_ chars)
+bool parseLayerField(const char *field, size_t length, LayerConfig &config) {
+  char buffer[64];
+  if (length >= sizeof(buffer))
+    return false;
+
+  memcpy(buffer, field, length);
+  buffer[length] = '\0';
+
+  char *value = strchr(buffer, '=');
+  if (!value)
+    return false;
+  *value++ = '\0';
+
+  if (strcmp(buffer, "ch") == 0) {
+    long channel = std::strtol(value, nullptr, 10);
+    if (channel < 1 || channel > 16)
+      return false;
+    config.channel = static_cast<uint8_t>(channel - 1);
+  } else if (strcmp(buffer, "keys") == 0) {
+    return parseKeyRange(value, config);
+  } else if (strcmp(buffer, "bus") == 0) {
+    long bus = std::strtol(value, nullptr, 10);
+    if (bus < 0 || bus > 127)
+      return false;
+    config.bus = static_cast<uint8_t>(bus);
+  } else if (strcmp(buffer, "gain") == 0) {
+    config.gain = std::max(std::strtof(value, nullptr), 0.0f);
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace
+// ==== </Rack Helpers> ====
+
+Rack *createRack(const EngineConfig &config, const LayerConfig *layers,
+                 uint32_t layerCount, uint32_t numWorkers) {
+  auto *rack = new Rack();
+  rack->layerCount = std::min(layerCount, MAX_LAYERS);
+
+  EngineConfig layerEngineConfig = config;
+  layerEngineConfig.numVoiceWorkers = 0;
+
+  for (uint32_t i = 0; i < rack->layerCount; i++) {
+    Layer &layer = rack->layers[i];
+    layer.config = layers[i];
+    layer.engine = createEngine(layerEngineConfig);
+
+    // Every layer engine clamps maxFrames the same way
+    rack->maxFrames = layer.engine->maxFrames;
+    for (float *&buffer : layer.buffers)
+      buffer = allocateBuffer(rack->maxFrames);
+
+    // Nothing renders yet: apply directly (no pointer swap needed)
+    if (layer.config.presetPath[0] == '\0')
+      continue;
+
+    patch::Patch *patch =
+        patch::loadPresetFile(*layer.engine, layer.config.presetPath);
+    if (!patch) {
+      printf("Layer %u: could not load '%s'\n", i + 1,
+             layer.config.presetPath);
+      disposeRack(rack);
+      return nullptr;
+    }
+
+    patch::applyPatch(*layer.engine, *patch);
+    patch::disposePatch(patch);
+  }
+
+  // A single layer gains nothing from workers
+  if (numWorkers > 0 && rack->layerCount > 1)
+    rack->workers = voices::createVoiceWorkers(
+        std::min(numWorkers, rack->layerCount - 1),
+        rack->layers[0].engine->sampleRate, rack->maxFrames);
+
+  return rack;
+}
+
+void disposeRack(Rack *rack) {
+  if (!rack)
+    return;
+
+  voices::disposeVoiceWorkers(rack->workers);
+  rack->workers = nullptr;
+
+  for (uint32_t i = 0; i < rack->layerCount; i++) {
+    Layer &layer = rack->layers[i];
+    for (float *&buffer : layer.buffers) {
+      freeBuffer(buffer);
+      buffer = nullptr;
+    }
+
+    disposeEngine(layer.engine);
+    layer.engine = nullptr;
+  }
+
+  delete rack;
+}
+
+void setRackWorkerHooks(Rack &rack, const voices::WorkerThreadHooks &hooks) {
+  if (rack.workers)
+    voices::setWorkerThreadHooks(*rack.workers, hooks);
+}
+
+bool parseLayerSpec(const char *spec, LayerConfig &config) {
+  config = LayerConfig{};
+
+  const char *fieldStart = strchr(spec, ',');
+  size_t pathLength = fieldStart ? static_cast<size_t>(fieldStart - spec)
+                                 : strlen(spec);
+  if (pathLength == 0 || pathLength >= MAX_PRESET_PATH) {
+    printf("Error: Invalid layer '%s'\n", spec);
+    return false;
+  }
+
+  // `init` = the engine's init patch
+  if (!(pathLength == 4 && strncmp(spec, "init", 4) == 0)) {
+    memcpy(config.presetPath, spec, pathLength);
+    config.presetPath[pathLength] = '\0';
+  }
+
+  while (fieldStart) {
+    const char *field = fieldStart + 1;
+    fieldStart = strchr(field, ',');
+    size_t length = fieldStart ? static_cast<size_t>(fieldStart - field)
+                               : strlen(field);
+
+    if (!parseLayerField(field, length, config)) {
+      printf("Error: Invalid layer field '%.*s' in '%s'\n",
+             static_cast<int>(length), field, spec);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Rack::processNoteEvent(const NoteEvent &event) {
+  for (uint32_t i = 0; i < layerCount; i++) {
+    if (isLayerNote(layers[i].config, event))
+      layers[i].engine->processNoteEvent(event);
+  }
+}
+
+void Rack::processParamEvent(const ParamEvent &event) {
+  if (editLayer < layerCount)
+    layers[editLayer].engine->processParamEvent(event);
+}
+
+void Rack::processControllerEvent(const ControllerEvent &event) {
+  for (uint32_t i = 0; i < layerCount; i++)
+    layers[i].engine->processControllerEvent(event);
+}
+
+void Rack::processAudioBlock(float **outputBuffer, size_t numChannels,
+                             size_t numFrames) {
+  for (size_t c = 0; c < numChannels; c++)
+    std::fill(outputBuffer[c], outputBuffer[c] + numFrames, 0.0f);
+
+  size_t chunkStart = 0;
+  while (chunkStart < numFrames) {
+    chunkFrames = std::min(numFrames - chunkStart,
+                           static_cast<size_t>(maxFrames));
+
+    // Layers are independent engines: one task each
+    if (workers) {
+      voices::runTasksParallel(*workers, layerCount, renderLayer, this);
+    } else {
+      for (uint32_t i = 0; i < layerCount; i++)
+        renderLayer(this, i);
+    }
+
+    {
+      SYNTH_TRACE_SCOPE("mixLayers");
+      mixLayers(*this, outputBuffer, numChannels, chunkStart, chunkFrames);
+    }
+
+    chunkStart += chunkFrames;
+  }
+}
+
+} // namespace synth::rack
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Engine.h"
+#include "VoiceWorkers.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::rack {
+
+/* Multitimbral host: N independent engines ("layers") in front of one output
+ *
+ * Each layer is a full Engine with its own patch, listening to one MIDI
+ * channel (or all) and a key range, rendering to one stereo output bus.
+ * Layers share nothing, so the rack renders them concurrently on its own
+ * worker pool (one task per layer) and mixes their buses at the end.
+ *
+ * Same event/render interface as Engine, so hosts drive either one:
+ * - notes: every layer whose channel + key range matches
+ * - params: the edit layer only (terminal, MIDI learn)
+ * - controllers: every layer (ControllerEvent carries no channel; per note
+ *   expression lanes are only heard by voices on that channel anyway)
+ *
+ * NOTE: layer engines render without voice workers of their own, the
+ * layers are the unit of parallelism
+ */
+inline constexpr uint32_t MAX_LAYERS = 8;
+inline constexpr uint8_t ANY_CHANNEL = 0xFF;
+
+// Every layer renders one stereo pair (bus b -> output channels 2b, 2b + 1)
+inline constexpr uint32_t LAYER_CHANNELS = STEREO_CHANNELS;
+
+inline constexpr size_t MAX_PRESET_PATH = 256;
+
+struct LayerConfig {
+  char presetPath[MAX_PRESET_PATH] = {}; // empty = init patch
+  uint8_t channel = ANY_CHANNEL;         // MIDI channel 0-15
+  uint8_t lowKey = 0;                    // inclusive
+  uint8_t highKey = 127;
+  uint8_t bus = 0; // output pair, folded onto bus 0 if the device lacks it
+  float gain = 1.0f;
+};
+
+struct Layer {
+  Engine *engine = nullptr;
+  LayerConfig config{};
+
+  // Layer output (maxFrames each), written by whichever thread renders it
+  float *buffers[LAYER_CHANNELS] = {};
+};
+
+struct Rack {
+  Layer layers[MAX_LAYERS];
+  uint32_t layerCount = 0;
+
+  // Largest buffer a layer renders in one pass (see processAudioBlock)
+  uint32_t maxFrames = 0;
+
+  // nullptr = layers render one after another on the audio thread
+  voices::VoiceWorkers *workers = nullptr;
+
+  // Task payload of the current chunk (audio thread, before publishing)
+  size_t chunkFrames = 0;
+
+  // Target of processParamEvent (terminal edits, MIDI learn)
+  uint32_t editLayer = 0;
+
+  // Same contract as the Engine methods (see Engine.h)
+  void processNoteEvent(const NoteEvent &event);
+  void processParamEvent(const ParamEvent &event);
+  void processControllerEvent(const ControllerEvent &event);
+
+  /* Render every layer, then mix their buses into _outputBuffer_
+   * - one output channel: each layer's pair is folded to mono
+   * NOTE: host buffers larger than maxFrames render in maxFrames chunks;
+   * events scheduled past the first chunk then land at its end
+   */
+  void processAudioBlock(float **outputBuffer, size_t numChannels,
+                         size_t numFrames);
+};
+
+/* Creates one engine per layer from _config_ (+ the layer's preset)
+ * - numWorkers: rack render threads besides the audio thread
+ *   (config.numVoiceWorkers is ignored, see above)
+ * - returns nullptr if a preset fails to load (reported)
+ * NOTE: allocates, call before the audio session starts
+ */
+Rack *createRack(const EngineConfig &config, const LayerConfig *layers,
+                 uint32_t layerCount, uint32_t numWorkers);
+
+// Releases every layer engine and the workers
+// NOTE: audio session must be stopped first
+void disposeRack(Rack *rack);
+
+// Hooks run on each rack worker thread (see setVoiceWorkerHooks)
+void setRackWorkerHooks(Rack &rack, const voices::WorkerThreadHooks &hooks);
+
+/* Command line layer: <preset|init>[,ch=<1-16>][,keys=<lo>-<hi>][,bus=<n>]
+ *                    [,gain=<linear>]
+ * e.g. `bass.preset,keys=0-59` or `init,ch=2,bus=1`
+ * Returns false on a malformed spec (reported)
+ */
+bool parseLayerSpec(const char *spec, LayerConfig &config);
+
+} // namespace synth::rack
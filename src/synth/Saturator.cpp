@@ -0,0 +1,120 @@
+#include "Saturator.h"
+
+#include "dsp/Effects.h"
+#include "dsp/Oversampling.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace synth::saturator {
+
+// ==== Saturator Oversampling Helpers ====
+namespace {
+namespace os = dsp::oversampling;
+
+// upsample -> soft clip at (1 << factorLog2) * sr -> downsample, in place
+void clipOversampled(Saturator &saturator, float *buffer, size_t numSamples,
+                     uint32_t voiceIndex, float drive, float invDrive,
+                     uint32_t factorLog2, scratch::ScratchArena &scratch) {
+  assert(numSamples <= ENGINE_BLOCK_SIZE);
+
+  scratch::ScratchMark mark = scratch::markScratch(scratch);
+  float *stage1 = scratch::allocateScratch<float>(scratch, numSamples * 2);
+  float *oversampled =
+      scratch::allocateScratch<float>(scratch, numSamples << factorLog2);
+
+  os::OversamplerState &oversampler = saturator.oversamplers[voiceIndex];
+  size_t numOversampled = numSamples << factorLog2;
+
+  if (factorLog2 == 1) {
+    os::upsample2x(oversampler.stages[0], buffer, oversampled, numSamples);
+  } else {
+    os::upsample2x(oversampler.stages[0], buffer, stage1, numSamples);
+    os::upsample2x(oversampler.stages[1], stage1, oversampled,
+                   numSamples * 2);
+  }
+
+  dsp::effects::softClipBlock(oversampled, oversampled, numOversampled, drive,
+                              invDrive);
+
+  if (factorLog2 == 1) {
+    os::downsample2x(oversampler.stages[0], oversampled, buffer, numSamples);
+  } else {
+    os::downsample2x(oversampler.stages[1], oversampled, stage1,
+                     numSamples * 2);
+    os::downsample2x(oversampler.stages[0], stage1, buffer, numSamples);
+  }
+
+  scratch::releaseScratch(scratch, mark);
+}
+} // namespace
+
+// ==== Saturator Helpers ====
+void initSaturator(Saturator &saturator, size_t voiceIndex) {
+  dsp::oversampling::resetOversampler(saturator.oversamplers[voiceIndex]);
+}
+
+uint32_t saturatorOversamplingLog2(const Saturator &saturator,
+                                   QualityMode quality) {
+  if (quality == QualityMode::Draft)
+    return 0;
+
+  auto factorLog2 = static_cast<uint32_t>(std::clamp(
+      static_cast<int>(saturator.oversampling), 0,
+      static_cast<int>(dsp::oversampling::MAX_FACTOR_LOG2)));
+
+  if (quality == QualityMode::Render)
+    return std::max(factorLog2, 1u);
+
+  return factorLog2;
+}
+
+void processSaturatorBlock(Saturator &saturator, float *buffer,
+                           size_t numSamples, uint32_t voiceIndex,
+                           scratch::ScratchArena &scratch,
+                           QualityMode quality) {
+  if (numSamples == 0)
+    return;
+
+  // Block rate: one tanh per voice per block
+  float drive = dsp::effects::denormalizeDrive(saturator.drive);
+  float invDrive = dsp::effects::calcInvDrive(drive);
+  float mix = std::clamp(saturator.mix, 0.0f, 1.0f);
+
+  uint32_t factorLog2 = saturatorOversamplingLog2(saturator, quality);
+  if (factorLog2 == 0) {
+    dsp::effects::softClipBlock(buffer, buffer, numSamples, drive, invDrive,
+                                mix);
+    return;
+  }
+
+  // Dry/wet after the rate conversion (the dry path stays unfiltered)
+  if (mix >= 1.0f) {
+    clipOversampled(saturator, buffer, numSamples, voiceIndex, drive,
+                    invDrive, factorLog2, scratch);
+    return;
+  }
+
+  scratch::ScratchMark mark = scratch::markScratch(scratch);
+  float *dry = scratch::allocateScratch<float>(scratch, numSamples);
+  std::copy(buffer, buffer + numSamples, dry);
+
+  clipOversampled(saturator, buffer, numSamples, voiceIndex, drive, invDrive,
+                  factorLog2, scratch);
+  dsp::effects::mixDryWetBlock(dry, buffer, buffer, numSamples, mix);
+
+  scratch::releaseScratch(scratch, mark);
+}
+
+// ==== DC Blocker Helpers ====
+void initDCBlocker(DCBlocker &dcBlocker, size_t voiceIndex) {
+  dcBlocker.states[voiceIndex] = 0.0f;
+}
+
+void processDCBlockerBlock(DCBlocker &dcBlocker, float *buffer,
+                           size_t numSamples, uint32_t voiceIndex) {
+  dsp::effects::dcBlockBlock(buffer, buffer, numSamples,
+                             dcBlocker.states[voiceIndex]);
+}
+
+} // namespace synth::saturator
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "synth/ScratchArena.h"
+#include "synth/Types.h"
+
+#include "dsp/Oversampling.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::saturator {
+
+using OversamplerState = dsp::oversampling::OversamplerState;
+
+// ==== Saturator (per voice, after the filters) ====
+// Same curve as the master FX saturator, but each voice clips on its own
+// (chords don't intermodulate)
+struct Saturator {
+  // Half-band up/down history for the oversampled path
+  // (only touched when oversampling, see saturatorOversamplingLog2)
+  OversamplerState oversamplers[MAX_VOICES];
+
+  // Global settings (cold)
+  float drive = 0.5f; // normalized (see dsp::effects::denormalizeDrive)
+  float mix = 1.0f;
+  int8_t oversampling = 0; // factor (log2): 0 = 1x, 1 = 2x, 2 = 4x
+  bool enabled = false;
+};
+
+// ==== DC Blocker (per voice, after saturation) ====
+struct DCBlocker {
+  alignas(CACHE_LINE_SIZE) float states[MAX_VOICES]; // (hot path)
+
+  bool enabled = false;
+};
+
+// ==== Saturator Helpers ====
+void initSaturator(Saturator &saturator, size_t voiceIndex);
+
+// Oversampling factor (log2): Draft never oversamples, Render at least 2x
+uint32_t saturatorOversamplingLog2(const Saturator &saturator,
+                                   QualityMode quality);
+
+// In-place, drive/mix read once per block
+// (rate converted + dry buffers come from _scratch_)
+// NOTE: numSamples must be <= ENGINE_BLOCK_SIZE when oversampling
+void processSaturatorBlock(Saturator &saturator, float *buffer,
+                           size_t numSamples, uint32_t voiceIndex,
+                           scratch::ScratchArena &scratch,
+                           QualityMode quality = QualityMode::Live);
+
+// ==== DC Blocker Helpers ====
+void initDCBlocker(DCBlocker &dcBlocker, size_t voiceIndex);
+
+// In-place
+void processDCBlockerBlock(DCBlocker &dcBlocker, float *buffer,
+                           size_t numSamples, uint32_t voiceIndex);
+
+} // namespace synth::saturator
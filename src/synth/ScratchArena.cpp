@@ -0,0 +1,70 @@
+#include "ScratchArena.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+namespace synth::scratch {
+
+ScratchArena createScratchArena(size_t capacityBytes) {
+  ScratchArena arena{};
+
+  // Whole blocks only: every allocation end stays aligned
+  capacityBytes = scratchBytes(capacityBytes);
+
+  arena.data = static_cast<uint8_t *>(::operator new(
+      capacityBytes, std::align_val_t{SCRATCH_ALIGNMENT}));
+  arena.overflow = static_cast<uint8_t *>(::operator new(
+      capacityBytes, std::align_val_t{SCRATCH_ALIGNMENT}));
+  std::memset(arena.overflow, 0, capacityBytes);
+  arena.capacity = capacityBytes;
+
+  return arena;
+}
+
+void disposeScratchArena(ScratchArena &arena) {
+  if (arena.data)
+    ::operator delete(arena.data, std::align_val_t{SCRATCH_ALIGNMENT});
+  if (arena.overflow)
+    ::operator delete(arena.overflow, std::align_val_t{SCRATCH_ALIGNMENT});
+
+  arena = ScratchArena{};
+}
+
+void *allocateScratchBytes(ScratchArena &arena, size_t numBytes) {
+  size_t size = scratchBytes(numBytes);
+
+  // Over budget: wrong audio beats a null write on the audio thread
+  if (size > arena.capacity - arena.offset) {
+    arena.failedCount++;
+    assert(size <= arena.capacity && "scratch allocation over capacity");
+    return arena.overflow;
+  }
+
+  void *ptr = arena.data + arena.offset;
+  arena.offset += size;
+
+  if (arena.offset > arena.highWaterMark)
+    arena.highWaterMark = arena.offset;
+
+  return ptr;
+}
+
+void printScratchReport(const ScratchArena &arena, const char *name) {
+  double percent =
+      arena.capacity ? 100.0 * static_cast<double>(arena.highWaterMark) /
+                           static_cast<double>(arena.capacity)
+                     : 0.0;
+
+  fprintf(stderr, "scratch %s: high water %zu / %zu bytes (%.1f%%)", name,
+          arena.highWaterMark, arena.capacity, percent);
+
+  if (arena.failedCount)
+    fprintf(stderr, ", %u FAILED allocations", arena.failedCount);
+
+  fprintf(stderr, "\n");
+}
+} // namespace synth::scratch
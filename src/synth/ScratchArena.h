@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Types.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::scratch {
+/* Fixed-capacity bump allocator for render temporaries
+ * - one arena per render thread (Engine: audio thread, each voice worker
+ *   slot: its own), never shared between threads
+ * - memory comes from createScratchArena only: allocating/releasing on the
+ *   audio thread is a pointer bump, never malloc
+ * - every allocation is SCRATCH_ALIGNMENT aligned (SIMD loads, no false
+ *   sharing between neighbouring buffers)
+ *
+ * Lifetime: Engine resets its arena at the top of processAudioBlock;
+ * nested users (one voice, one filter block) mark/release around their
+ * buffers so the next voice reuses the same bytes.
+ *
+ * Exhaustion never hands out nullptr (release builds have no assert):
+ * allocations that don't fit get the arena's overflow block instead, the
+ * same preallocated, capacity-sized block for all of them. Memory safe,
+ * but the audio is wrong until the budget is raised (failedCount, see
+ * printScratchReport). The budgets are checked against the worst case at
+ * compile time (VoicePool.cpp, Engine.cpp).
+ */
+inline constexpr size_t SCRATCH_ALIGNMENT = 64;
+
+// Budgets scale with the largest block
+// (worst case ~1070 bytes per voice per sample, see VoicePool.cpp)
+inline constexpr size_t VOICE_SCRATCH_BYTES = 1280 * ENGINE_BLOCK_SIZE;
+inline constexpr size_t ENGINE_SCRATCH_BYTES = 4096 * ENGINE_BLOCK_SIZE;
+
+// Bytes allocateScratch<T>(count) takes from an arena (alignment included)
+constexpr size_t scratchBytes(size_t numBytes) {
+  return (numBytes + SCRATCH_ALIGNMENT - 1) & ~(SCRATCH_ALIGNMENT - 1);
+}
+
+struct ScratchArena {
+  uint8_t *data = nullptr;
+  size_t capacity = 0;
+  size_t offset = 0;
+
+  // Zeroed at creation, _capacity_ bytes: returned for allocations that
+  // don't fit (shared, see above)
+  uint8_t *overflow = nullptr;
+
+  // ==== Debug report (printScratchReport) ====
+  size_t highWaterMark = 0;   // largest offset reached since creation
+  uint32_t failedCount = 0;   // allocations that didn't fit
+};
+
+// Position to release back to (see markScratch/releaseScratch)
+struct ScratchMark {
+  size_t offset = 0;
+};
+
+// NOTE: allocates, call before the audio session starts
+ScratchArena createScratchArena(size_t capacityBytes);
+void disposeScratchArena(ScratchArena &arena);
+
+inline void resetScratchArena(ScratchArena &arena) { arena.offset = 0; }
+
+inline ScratchMark markScratch(const ScratchArena &arena) {
+  return {arena.offset};
+}
+
+inline void releaseScratch(ScratchArena &arena, ScratchMark mark) {
+  assert(mark.offset <= arena.offset);
+  arena.offset = mark.offset;
+}
+
+// The overflow block (and failedCount++) once the arena is full, never
+// nullptr for _numBytes_ <= capacity
+void *allocateScratchBytes(ScratchArena &arena, size_t numBytes);
+
+// Uninitialized storage for _count_ T (trivial types only)
+template <typename T> T *allocateScratch(ScratchArena &arena, size_t count) {
+  return static_cast<T *>(allocateScratchBytes(arena, count * sizeof(T)));
+}
+
+void printScratchReport(const ScratchArena &arena, const char *name);
+
+} // namespace synth::scratch
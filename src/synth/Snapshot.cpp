@@ -0,0 +1,351 @@
+#include "Snapshot.h"
+
+#include "Engine.h"
+#include "Envelope.h"
+#include "ParamBindings.h"
+#include "Patch.h"
+
+#include "dsp/Delay.h"
+#include "dsp/Reverb.h"
+
+#include "synth_io/Trace.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace synth::snapshot {
+namespace pb = param::bindings;
+
+// ==== <Snapshot Helpers> ====
+namespace {
+static_assert(std::is_trivially_copyable<SnapshotState>::value,
+              "snapshot state is copied with memcpy");
+
+// Delay lines, reverb lines, resampler windows
+constexpr uint32_t MAX_LINES =
+    STEREO_CHANNELS + dsp::reverb::REVERB_LINES + STEREO_CHANNELS;
+
+struct LineSpan {
+  float *samples = nullptr;
+  size_t count = 0;
+};
+
+LineSpan getDelayLineSpan(const dsp::delay::DelayLine &line) {
+  return {line.buffer, line.buffer ? line.mask + 1 : 0};
+}
+
+// The engine's heap lines, in snapshot order
+uint32_t collectLines(const Engine &engine, LineSpan *spans) {
+  uint32_t count = 0;
+  for (const dsp::delay::DelayLine &line : engine.fxChain.delay.lines)
+    spans[count++] = getDelayLineSpan(line);
+  for (const dsp::delay::DelayLine &line : engine.fxChain.reverb.state.lines)
+    spans[count++] = getDelayLineSpan(line);
+  for (const dsp::resampler::Resampler &resampler : engine.resamplers)
+    spans[count++] = {resampler.window,
+                      resampler.window ? resampler.windowCapacity : 0};
+  return count;
+}
+
+size_t countLineSamples(const Engine &engine) {
+  LineSpan spans[MAX_LINES];
+  uint32_t numLines = collectLines(engine, spans);
+
+  size_t numSamples = 0;
+  for (uint32_t l = 0; l < numLines; l++)
+    numSamples += spans[l].count;
+  return numSamples;
+}
+
+bool isSizedFor(const Snapshot &snapshot, const Engine &engine) {
+  return snapshot.sampleRate == engine.sampleRate &&
+         snapshot.numLineSamples == countLineSamples(engine);
+}
+
+void copyLines(const Engine &engine, float *lineSamples, bool isCapture) {
+  LineSpan spans[MAX_LINES];
+  uint32_t numLines = collectLines(engine, spans);
+
+  for (uint32_t l = 0; l < numLines; l++) {
+    size_t numBytes = spans[l].count * sizeof(float);
+    if (isCapture)
+      std::memcpy(lineSamples, spans[l].samples, numBytes);
+    else
+      std::memcpy(spans[l].samples, lineSamples, numBytes);
+    lineSamples += spans[l].count;
+  }
+}
+
+// Snapshot FX chain onto the engine's, keeping the engine's line memory
+void restoreFXChain(fx::FXChain &chain, const fx::FXChain &saved) {
+  fx::FXChain restored = saved;
+  for (uint32_t c = 0; c < STEREO_CHANNELS; c++)
+    restored.delay.lines[c].buffer = chain.delay.lines[c].buffer;
+  for (size_t l = 0; l < dsp::reverb::REVERB_LINES; l++)
+    restored.reverb.state.lines[l].buffer = chain.reverb.state.lines[l].buffer;
+
+  chain = restored;
+}
+
+// ==== Snapshot Files ====
+constexpr char SNAPSHOT_MAGIC[4] = {'M', 'E', 'H', 'S'};
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotFileHeader {
+  char magic[4] = {};
+  uint32_t version = 0;
+  uint32_t maxVoices = 0;
+  uint32_t stateBytes = 0; // sizeof(SnapshotState): same build layout
+  uint64_t numLineSamples = 0; // 0 = no tails in the file
+  float sampleRate = 0.0f;
+};
+
+// Pointers saved by another process: engine owned ones are never restored,
+// the rest are looked up again (wavetables fall back to the built-ins)
+void fixupLoadedPointers(SnapshotState &state) {
+  voices::VoicePool &pool = state.voicePool;
+  pool.renderKernel = nullptr; // selected per block
+  pool.voiceStageCount = 0;
+  pool.workers = nullptr;
+
+  oscillator::Oscillator *oscs[] = {&pool.osc1, &pool.osc2, &pool.osc3,
+                                    &pool.subOsc};
+  for (oscillator::Oscillator *osc : oscs)
+    oscillator::setWavetable(*osc, nullptr);
+
+  envelope::Envelope *envs[] = {&pool.ampEnv, &pool.filterEnv, &pool.modEnv};
+  for (envelope::Envelope *env : envs)
+    env->curves = envelope::computeCurves(env->attackCurve, env->decayCurve,
+                                          env->releaseCurve);
+
+  const float *values = state.patch.paramValues;
+  state.patch.ampEnv.curves = envelope::computeCurves(
+      values[pb::AMP_ENV_ATTACK_CURVE], values[pb::AMP_ENV_DECAY_CURVE],
+      values[pb::AMP_ENV_RELEASE_CURVE]);
+  state.patch.filterEnv.curves = envelope::computeCurves(
+      values[pb::FILTER_ENV_ATTACK_CURVE], values[pb::FILTER_ENV_DECAY_CURVE],
+      values[pb::FILTER_ENV_RELEASE_CURVE]);
+
+  for (dsp::delay::DelayLine &line : state.fxChain.delay.lines)
+    line.buffer = nullptr;
+  for (dsp::delay::DelayLine &line : state.fxChain.reverb.state.lines)
+    line.buffer = nullptr;
+  for (dsp::resampler::Resampler &resampler : state.resamplers) {
+    resampler.phases = nullptr;
+    resampler.window = nullptr;
+  }
+}
+
+} // namespace
+// ==== </Snapshot Helpers> ====
+
+Snapshot *createSnapshot(const Engine &engine) {
+  auto *snapshot = new Snapshot();
+  snapshot->sampleRate = engine.sampleRate;
+  snapshot->numLineSamples = countLineSamples(engine);
+  snapshot->lineSamples = new float[snapshot->numLineSamples]();
+  return snapshot;
+}
+
+void disposeSnapshot(Snapshot *snapshot) {
+  if (!snapshot)
+    return;
+
+  delete[] snapshot->lineSamples;
+  delete snapshot;
+}
+
+void captureSnapshot(Engine &engine, Snapshot &snapshot, uint32_t contents) {
+  SYNTH_TRACE_SCOPE("captureSnapshot");
+  SnapshotState &state = snapshot.state;
+
+  // Derived data current first (the next block would do the same)
+  pb::updateDirtyModules(engine);
+  patch::capturePatchState(engine, state.patch);
+  contents |= SNAPSHOT_PATCH;
+
+  if (contents & SNAPSHOT_VOICES) {
+    std::memcpy(&state.voicePool, &engine.voicePool, sizeof(state.voicePool));
+    std::memcpy(&state.arp, &engine.arp, sizeof(state.arp));
+    state.noteCount = engine.noteCount;
+  }
+
+  // Tails only fit the engine the snapshot was sized for
+  if ((contents & SNAPSHOT_TAILS) && isSizedFor(snapshot, engine)) {
+    std::memcpy(&state.fxChain, &engine.fxChain, sizeof(state.fxChain));
+    std::memcpy(state.resamplers, engine.resamplers,
+                sizeof(state.resamplers));
+    copyLines(engine, snapshot.lineSamples, true);
+  } else {
+    contents &= ~static_cast<uint32_t>(SNAPSHOT_TAILS);
+  }
+
+  snapshot.sampleRate = engine.sampleRate;
+  state.contents = contents;
+}
+
+bool restoreSnapshot(Engine &engine, const Snapshot &snapshot) {
+  const SnapshotState &state = snapshot.state;
+  if (!(state.contents & SNAPSHOT_PATCH) ||
+      snapshot.sampleRate != engine.sampleRate)
+    return false;
+
+  bool hasTails = state.contents & SNAPSHOT_TAILS;
+  if (hasTails && !isSizedFor(snapshot, engine))
+    return false;
+
+  SYNTH_TRACE_SCOPE("restoreSnapshot");
+
+  // Params outside the pool (FX, arp, tempo) + derived data
+  patch::applyPatch(engine, state.patch);
+
+  if (state.contents & SNAPSHOT_VOICES) {
+    voices::VoicePool &pool = engine.voicePool;
+
+    // Engine settings, not state (quality: only set at block boundaries,
+    // see setQualityMode)
+    voices::VoiceWorkers *workers = pool.workers;
+    QualityMode quality = pool.quality;
+
+    std::memcpy(&pool, &state.voicePool, sizeof(pool));
+    pool.workers = workers;
+    pool.quality = quality;
+
+    std::memcpy(&engine.arp, &state.arp, sizeof(engine.arp));
+    engine.noteCount = state.noteCount;
+  }
+
+  if (hasTails) {
+    restoreFXChain(engine.fxChain, state.fxChain);
+    for (uint32_t c = 0; c < STEREO_CHANNELS; c++) {
+      engine.resamplers[c].windowCount = state.resamplers[c].windowCount;
+      engine.resamplers[c].position = state.resamplers[c].position;
+    }
+    copyLines(engine, snapshot.lineSamples, false);
+  }
+
+  return true;
+}
+
+// ==== Live Engines ====
+void postSnapshotCapture(Engine &engine, Snapshot &snapshot,
+                         uint32_t contents) {
+  snapshot.requestedContents = contents;
+  engine.pendingSnapshotCapture.store(&snapshot, std::memory_order_release);
+}
+
+bool postSnapshotRestore(Engine &engine, const Snapshot &snapshot) {
+  if (!(snapshot.state.contents & SNAPSHOT_PATCH) ||
+      snapshot.sampleRate != engine.sampleRate)
+    return false;
+
+  engine.pendingSnapshotRestore.store(&snapshot, std::memory_order_release);
+  return true;
+}
+
+bool isSnapshotPending(const Engine &engine) {
+  return engine.pendingSnapshotCapture.load(std::memory_order_acquire) ||
+         engine.pendingSnapshotRestore.load(std::memory_order_acquire);
+}
+
+void applyPendingSnapshots(Engine &engine) {
+  // Slots are cleared after the copy (isSnapshotPending stays true until
+  // the snapshot is safe to touch); a newer post stays for the next block
+  Snapshot *capture =
+      engine.pendingSnapshotCapture.load(std::memory_order_acquire);
+  if (capture) {
+    captureSnapshot(engine, *capture, capture->requestedContents);
+    engine.pendingSnapshotCapture.compare_exchange_strong(
+        capture, nullptr, std::memory_order_acq_rel);
+  }
+
+  const Snapshot *restore =
+      engine.pendingSnapshotRestore.load(std::memory_order_acquire);
+  if (restore) {
+    restoreSnapshot(engine, *restore);
+    engine.pendingSnapshotRestore.compare_exchange_strong(
+        restore, nullptr, std::memory_order_acq_rel);
+  }
+}
+
+// ==== Snapshot Files ====
+bool saveSnapshotFile(const Snapshot &snapshot, const char *path) {
+  if (!(snapshot.state.contents & SNAPSHOT_PATCH))
+    return false;
+
+  bool hasTails = snapshot.state.contents & SNAPSHOT_TAILS;
+
+  SnapshotFileHeader header{};
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.maxVoices = MAX_VOICES;
+  header.stateBytes = sizeof(SnapshotState);
+  header.numLineSamples = hasTails ? snapshot.numLineSamples : 0;
+  header.sampleRate = snapshot.sampleRate;
+
+  FILE *file = fopen(path, "wb");
+  if (!file)
+    return false;
+
+  bool isWritten =
+      fwrite(&header, sizeof(header), 1, file) == 1 &&
+      fwrite(&snapshot.state, sizeof(SnapshotState), 1, file) == 1 &&
+      fwrite(snapshot.lineSamples, sizeof(float), header.numLineSamples,
+             file) == header.numLineSamples;
+  return fclose(file) == 0 && isWritten;
+}
+
+bool loadSnapshotFile(Snapshot &snapshot, const char *path) {
+  FILE *file = fopen(path, "rb");
+  if (!file) {
+    printf("Snapshot: unable to open %s\n", path);
+    return false;
+  }
+
+  SnapshotFileHeader header{};
+  bool isValid = fread(&header, sizeof(header), 1, file) == 1 &&
+                 std::memcmp(header.magic, SNAPSHOT_MAGIC,
+                             sizeof(header.magic)) == 0 &&
+                 header.version == SNAPSHOT_VERSION &&
+                 header.maxVoices == MAX_VOICES &&
+                 header.stateBytes == sizeof(SnapshotState);
+  if (!isValid) {
+    printf("Snapshot: %s is not a snapshot (or from another build)\n", path);
+    fclose(file);
+    return false;
+  }
+
+  if (header.sampleRate != snapshot.sampleRate ||
+      (header.numLineSamples != 0 &&
+       header.numLineSamples != snapshot.numLineSamples)) {
+    printf("Snapshot: %s doesn't fit this engine (taken at %.0f Hz)\n",
+           path, static_cast<double>(header.sampleRate));
+    fclose(file);
+    return false;
+  }
+
+  bool isRead =
+      fread(&snapshot.state, sizeof(SnapshotState), 1, file) == 1 &&
+      fread(snapshot.lineSamples, sizeof(float), header.numLineSamples,
+            file) == header.numLineSamples;
+  fclose(file);
+
+  if (!isRead) {
+    printf("Snapshot: %s is truncated\n", path);
+    snapshot.state.contents = SNAPSHOT_NONE;
+    return false;
+  }
+
+  // Tails in the state but not the file can't be restored
+  if (header.numLineSamples == 0)
+    snapshot.state.contents &= ~static_cast<uint32_t>(SNAPSHOT_TAILS);
+
+  fixupLoadedPointers(snapshot.state);
+  return true;
+}
+
+} // namespace synth::snapshot
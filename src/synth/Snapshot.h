@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Arpeggiator.h"
+#include "MasterFX.h"
+#include "Patch.h"
+#include "Types.h"
+#include "VoicePool.h"
+
+#include "dsp/Resampler.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace synth {
+struct Engine;
+}
+
+/* Engine snapshots: the whole render state copied out at a block boundary
+ * and copied back later (memcpy, no allocation, nothing rebuilt)
+ * - patch: params, routes and derived data (instant A/B, like a program
+ *   change but captured from the running engine)
+ * - voices: the voice pool as it is (phases, envelopes, filter states,
+ *   held notes...), the arpeggiator and the note counter
+ * - tails: FX delay/reverb line memory + resampler history, the bulk of
+ *   the bytes (skip it for A/B, keep it to resume a render exactly)
+ * - the snapshot is sized for one engine (createSnapshot), restoring into
+ *   an engine with another render rate or FX memory size fails
+ * - engine owned pointers (voice workers, FX/resampler memory) are never
+ *   copied; wavetables and envelope curve tables are process wide
+ */
+namespace synth::snapshot {
+
+enum SnapshotContents : uint32_t {
+  SNAPSHOT_NONE = 0,
+  SNAPSHOT_PATCH = 1 << 0,  // always captured
+  SNAPSHOT_VOICES = 1 << 1, // voice pool, arpeggiator
+  SNAPSHOT_TAILS = 1 << 2,  // FX line memory, resampler history
+  SNAPSHOT_ALL = SNAPSHOT_PATCH | SNAPSHOT_VOICES | SNAPSHOT_TAILS,
+};
+
+// Plain state, copied with memcpy (one block in snapshot files)
+struct SnapshotState {
+  patch::Patch patch{};
+
+  // SNAPSHOT_VOICES
+  voices::VoicePool voicePool;
+  arp::Arpeggiator arp{};
+  uint32_t noteCount = 0;
+
+  // SNAPSHOT_TAILS (line pointers are the engine's, only the rest is used)
+  fx::FXChain fxChain{};
+  dsp::resampler::Resampler resamplers[STEREO_CHANNELS] = {};
+
+  uint32_t contents = SNAPSHOT_NONE; // what the last capture holds
+};
+
+struct Snapshot {
+  SnapshotState state{};
+
+  // The engine it was sized for
+  float sampleRate = 0.0f;
+
+  // Delay, reverb and resampler lines back to back (SNAPSHOT_TAILS)
+  float *lineSamples = nullptr;
+  size_t numLineSamples = 0;
+
+  // What postSnapshotCapture asked for
+  uint32_t requestedContents = SNAPSHOT_NONE;
+};
+
+// Sized for _engine_ (line memory included), empty until captured
+// NOTE: allocates, release with disposeSnapshot (not on the audio thread)
+Snapshot *createSnapshot(const Engine &engine);
+void disposeSnapshot(Snapshot *snapshot);
+
+/* Copy the engine into _snapshot_ (_contents_: SnapshotContents bits)
+ * NOTE: block boundary, the audio thread (postSnapshotCapture) or an
+ * offline render loop between processAudioBlock calls
+ */
+void captureSnapshot(Engine &engine, Snapshot &snapshot,
+                     uint32_t contents = SNAPSHOT_ALL);
+
+/* Copy _snapshot_ back into the engine (what it holds, see contents)
+ * - patch only: playing voices carry on with the restored patch
+ * Returns false (engine untouched) for a snapshot sized for another engine
+ * NOTE: same threads as captureSnapshot
+ */
+bool restoreSnapshot(Engine &engine, const Snapshot &snapshot);
+
+// ==== Live Engines (any thread but the audio thread) ====
+
+/* Captured/restored at the start of the next processAudioBlock
+ * - one capture and one restore can wait at a time (latest post wins)
+ * - _snapshot_ is not copied: leave it alone until isSnapshotPending is
+ *   false
+ * Returns false for a snapshot sized for another engine (restore)
+ */
+void postSnapshotCapture(Engine &engine, Snapshot &snapshot,
+                         uint32_t contents = SNAPSHOT_PATCH);
+bool postSnapshotRestore(Engine &engine, const Snapshot &snapshot);
+
+// A posted capture/restore hasn't been taken yet
+bool isSnapshotPending(const Engine &engine);
+
+// Audio thread, block boundary: posted capture, then posted restore
+void applyPendingSnapshots(Engine &engine);
+
+// ==== Snapshot Files (resume a render in a new process) ====
+
+// NOTE: not on the audio thread
+bool saveSnapshotFile(const Snapshot &snapshot, const char *path);
+
+/* Reads into _snapshot_ (created for the engine that will restore it)
+ * - only the same build can read it back (layout and polyphony checked)
+ * - custom wavetables aren't saved: oscillators come back on the built-in
+ *   tables (publish them again after restoring)
+ * Returns false (and prints why) on error
+ */
+bool loadSnapshotFile(Snapshot &snapshot, const char *path);
+
+} // namespace synth::snapshot
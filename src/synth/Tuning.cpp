@@ -0,0 +1,293 @@
+#include "Tuning.h"
+
+#include "utils/Utils.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace synth::tuning {
+
+// Larger files are not tunings (sanity check before reading)
+inline constexpr long MAX_TUNING_FILE_BYTES = 1 << 20;
+
+// ==== <Scala Helpers> ====
+namespace {
+
+// Next line that's not a '!' comment, without its line break
+// Returns false at the end of the text
+bool nextLine(const char *&cursor, std::string &line) {
+  while (*cursor) {
+    const char *end = cursor + strcspn(cursor, "\r\n");
+    bool isComment = *cursor == '!';
+    line.assign(cursor, static_cast<size_t>(end - cursor));
+
+    cursor = end;
+    if (*cursor == '\r')
+      cursor++;
+    if (*cursor == '\n')
+      cursor++;
+
+    if (!isComment)
+      return true;
+  }
+  return false;
+}
+
+// Next non-comment line with something on it
+bool nextValueLine(const char *&cursor, std::string &line) {
+  while (nextLine(cursor, line)) {
+    if (line.find_first_not_of(" \t") != std::string::npos)
+      return true;
+  }
+  return false;
+}
+
+bool parseInt(const std::string &line, long &value) {
+  char *end = nullptr;
+  value = std::strtol(line.c_str(), &end, 10);
+  return end != line.c_str();
+}
+
+// "701.955" (cents) or "3/2", "2" (ratio), anything after it is ignored
+bool parsePitch(const std::string &line, double &cents) {
+  const char *start = line.c_str();
+  while (*start == ' ' || *start == '\t')
+    start++;
+
+  size_t tokenLength = strcspn(start, " \t");
+  if (memchr(start, '.', tokenLength)) {
+    char *end = nullptr;
+    cents = std::strtod(start, &end);
+    return end != start && std::isfinite(cents);
+  }
+
+  char *end = nullptr;
+  long numerator = std::strtol(start, &end, 10);
+  if (end == start)
+    return false;
+
+  long denominator = 1;
+  if (*end == '/') {
+    const char *denominatorStart = end + 1;
+    denominator = std::strtol(denominatorStart, &end, 10);
+    if (end == denominatorStart)
+      return false;
+  }
+
+  if (numerator <= 0 || denominator <= 0)
+    return false;
+
+  cents = 1200.0 * std::log2(static_cast<double>(numerator) /
+                             static_cast<double>(denominator));
+  return true;
+}
+
+void copyName(char *dest, const std::string &src) {
+  size_t start = src.find_first_not_of(" \t");
+  size_t length = start == std::string::npos ? 0 : src.size() - start;
+  if (length > TUNING_NAME_CHARS - 1)
+    length = TUNING_NAME_CHARS - 1;
+
+  if (length > 0)
+    std::memcpy(dest, src.c_str() + start, length);
+  dest[length] = '\0';
+}
+
+// Floor division (negative offsets are below the middle note)
+long floorDivide(long value, long divisor) {
+  long quotient = value / divisor;
+  return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1
+                                                                 : quotient;
+}
+
+double degreeToCents(const ScalaScale &scale, long degree) {
+  auto count = static_cast<long>(scale.degreeCount);
+  long period = floorDivide(degree, count);
+  long step = degree - period * count;
+
+  double cents = step == 0 ? 0.0 : scale.cents[step - 1];
+  return static_cast<double>(period) * scale.cents[count - 1] + cents;
+}
+
+// Cents of _note_ above the middle note (false = unmapped key)
+bool noteToCents(const ScalaScale &scale, const KeyboardMapping &mapping,
+                 int note, double &cents) {
+  long offset = note - mapping.middleNote;
+  if (mapping.mapSize == 0) {
+    cents = degreeToCents(scale, offset);
+    return true;
+  }
+
+  auto mapSize = static_cast<long>(mapping.mapSize);
+  long repeat = floorDivide(offset, mapSize);
+  int degree = mapping.keys[offset - repeat * mapSize];
+  if (degree < 0)
+    return false;
+
+  long octaveDegree = mapping.octaveDegree ? mapping.octaveDegree
+                                           : scale.degreeCount;
+  cents = degreeToCents(scale, degree + repeat * octaveDegree);
+  return true;
+}
+
+bool readTextFile(const char *path, std::string &text) {
+  FILE *file = fopen(path, "rb");
+  if (!file) {
+    printf("Tuning: unable to open %s\n", path);
+    return false;
+  }
+
+  bool isRead = false;
+  if (fseek(file, 0, SEEK_END) == 0) {
+    long size = ftell(file);
+    if (size > 0 && size <= MAX_TUNING_FILE_BYTES) {
+      text.resize(static_cast<size_t>(size));
+      rewind(file);
+      isRead = fread(&text[0], 1, text.size(), file) == text.size();
+    }
+  }
+  fclose(file);
+
+  if (!isRead)
+    printf("Tuning: unable to read %s\n", path);
+  return isRead;
+}
+
+} // namespace
+// ==== </Scala Helpers> ====
+
+void initEqualTemperament(Tuning &tuning) {
+  for (uint32_t n = 0; n < NUM_TUNING_NOTES; n++) {
+    tuning.frequencies[n] = utils::midiToFrequency(static_cast<int>(n));
+    tuning.isMapped[n] = 1;
+  }
+  std::strcpy(tuning.name, "12-TET");
+}
+
+bool parseScala(const char *text, ScalaScale &scale) {
+  const char *cursor = text;
+  std::string line;
+
+  // The description may be an empty line
+  if (!nextLine(cursor, line))
+    return false;
+  copyName(scale.description, line);
+
+  long count = 0;
+  if (!nextValueLine(cursor, line) || !parseInt(line, count) || count < 1 ||
+      count > static_cast<long>(MAX_SCALE_DEGREES))
+    return false;
+
+  scale.degreeCount = static_cast<uint32_t>(count);
+  for (uint32_t d = 0; d < scale.degreeCount; d++) {
+    if (!nextValueLine(cursor, line) || !parsePitch(line, scale.cents[d]))
+      return false;
+  }
+
+  // A period of 0 cents or less would repeat the scale in place
+  return scale.cents[scale.degreeCount - 1] > 0.0;
+}
+
+bool parseKeyboardMapping(const char *text, KeyboardMapping &mapping) {
+  const char *cursor = text;
+  std::string line;
+
+  long header[5] = {};
+  for (long &value : header) {
+    if (!nextValueLine(cursor, line) || !parseInt(line, value))
+      return false;
+  }
+
+  double referenceFrequency = 0.0;
+  if (!nextValueLine(cursor, line))
+    return false;
+  referenceFrequency = std::strtod(line.c_str(), nullptr);
+
+  long octaveDegree = 0;
+  if (!nextValueLine(cursor, line) || !parseInt(line, octaveDegree))
+    return false;
+
+  const long lastKey = static_cast<long>(NUM_TUNING_NOTES) - 1;
+  if (header[0] < 0 || header[0] > static_cast<long>(NUM_TUNING_NOTES) ||
+      header[1] < 0 || header[2] > lastKey || header[1] > header[2] ||
+      header[3] < 0 || header[3] > lastKey || header[4] < 0 ||
+      header[4] > lastKey || !(referenceFrequency > 0.0) ||
+      octaveDegree < 0)
+    return false;
+
+  mapping.mapSize = static_cast<uint32_t>(header[0]);
+  mapping.firstNote = static_cast<int>(header[1]);
+  mapping.lastNote = static_cast<int>(header[2]);
+  mapping.middleNote = static_cast<int>(header[3]);
+  mapping.referenceNote = static_cast<int>(header[4]);
+  mapping.referenceFrequency = referenceFrequency;
+  mapping.octaveDegree = static_cast<uint32_t>(octaveDegree);
+
+  // 'x' (or keys missing at the end of the file) = unmapped
+  for (uint32_t k = 0; k < mapping.mapSize; k++) {
+    long degree = 0;
+    bool isMapped = nextValueLine(cursor, line) && parseInt(line, degree);
+    if (isMapped && degree < 0)
+      return false;
+    mapping.keys[k] = isMapped ? static_cast<int>(degree) : -1;
+  }
+  return true;
+}
+
+bool buildTuning(const ScalaScale &scale, const KeyboardMapping &mapping,
+                 Tuning &tuning) {
+  if (scale.degreeCount == 0)
+    return false;
+
+  double referenceCents = 0.0;
+  if (!noteToCents(scale, mapping, mapping.referenceNote, referenceCents))
+    return false;
+
+  for (uint32_t n = 0; n < NUM_TUNING_NOTES; n++) {
+    int note = static_cast<int>(n);
+    double cents = 0.0;
+    bool isMapped = note >= mapping.firstNote && note <= mapping.lastNote &&
+                    noteToCents(scale, mapping, note, cents);
+
+    double frequency = mapping.referenceFrequency *
+                       std::exp2((cents - referenceCents) / 1200.0);
+    if (isMapped && !(frequency > 0.0 && std::isfinite(frequency)))
+      return false;
+
+    tuning.frequencies[n] = isMapped ? static_cast<float>(frequency) : 0.0f;
+    tuning.isMapped[n] = isMapped ? 1 : 0;
+  }
+
+  std::memcpy(tuning.name, scale.description, sizeof(tuning.name));
+  return true;
+}
+
+bool loadScalaFile(const char *path, ScalaScale &scale) {
+  std::string text;
+  if (!readTextFile(path, text))
+    return false;
+
+  if (!parseScala(text.c_str(), scale)) {
+    printf("Tuning: %s is not a Scala scale (.scl)\n", path);
+    return false;
+  }
+  return true;
+}
+
+bool loadKeyboardMappingFile(const char *path, KeyboardMapping &mapping) {
+  std::string text;
+  if (!readTextFile(path, text))
+    return false;
+
+  if (!parseKeyboardMapping(text.c_str(), mapping)) {
+    printf("Tuning: %s is not a Scala keyboard mapping (.kbm)\n", path);
+    return false;
+  }
+  return true;
+}
+
+} // namespace synth::tuning
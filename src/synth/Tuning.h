@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace synth::tuning {
+
+/* Note -> frequency tables (12-TET by default, or a Scala tuning)
+ * - oscillators turn the table into phase increments once (octave, detune
+ *   and sample rate folded in, see oscillator::updateNoteIncrements):
+ *   note-on is a lookup, whatever the tuning
+ * - Scala files are parsed/built off the audio thread, the table reaches
+ *   the engine with a patch (patch::postTuning)
+ *
+ * .scl: description, degree count, then one pitch per degree: cents if it
+ *       has a '.', otherwise a ratio (3/2, 2). The last degree is the
+ *       period (usually the octave). '!' lines are comments.
+ * .kbm: map size, first/last note, middle note (degree 0), reference note,
+ *       reference frequency, formal octave degree, then one degree per key
+ *       of the map ('x' = unmapped). Map size 0 = a linear mapping.
+ */
+inline constexpr uint32_t NUM_TUNING_NOTES = 128;
+inline constexpr uint32_t MAX_SCALE_DEGREES = 512;
+inline constexpr size_t TUNING_NAME_CHARS = 64;
+
+// Without a .kbm: middle C is degree 0 at its 12-TET pitch
+inline constexpr int DEFAULT_MIDDLE_NOTE = 60;
+inline constexpr double DEFAULT_REFERENCE_FREQUENCY = 261.6255653;
+
+struct Tuning {
+  float frequencies[NUM_TUNING_NOTES] = {}; // Hz, per MIDI note
+  uint8_t isMapped[NUM_TUNING_NOTES] = {};  // 0 = unmapped key (silent)
+  char name[TUNING_NAME_CHARS] = {};
+
+  // Set by patch::postTuning (newer tuning = higher), 0 = the default
+  uint32_t generation = 0;
+};
+
+struct ScalaScale {
+  // Degrees 1..degreeCount (degree 0 is the implicit 0 cents)
+  double cents[MAX_SCALE_DEGREES] = {};
+  uint32_t degreeCount = 0;
+  char description[TUNING_NAME_CHARS] = {};
+};
+
+struct KeyboardMapping {
+  uint32_t mapSize = 0; // 0 = linear (every key is the next degree)
+  int firstNote = 0;
+  int lastNote = NUM_TUNING_NOTES - 1;
+  int middleNote = DEFAULT_MIDDLE_NOTE;
+  int referenceNote = DEFAULT_MIDDLE_NOTE;
+  double referenceFrequency = DEFAULT_REFERENCE_FREQUENCY;
+  uint32_t octaveDegree = 0; // degrees per map repeat (0 = degreeCount)
+
+  int keys[NUM_TUNING_NOTES] = {}; // degree per map key, -1 = unmapped
+};
+
+// 12-TET, A4 = ROOT_NOTE_FREQ (every key mapped)
+void initEqualTemperament(Tuning &tuning);
+
+// Returns false for malformed text (_scale_ is left partially written)
+bool parseScala(const char *text, ScalaScale &scale);
+bool parseKeyboardMapping(const char *text, KeyboardMapping &mapping);
+
+// Returns false when the reference note is unmapped or a pitch is not a
+// usable frequency
+bool buildTuning(const ScalaScale &scale, const KeyboardMapping &mapping,
+                 Tuning &tuning);
+
+// Read + parse, print why on error
+bool loadScalaFile(const char *path, ScalaScale &scale);
+bool loadKeyboardMappingFile(const char *path, KeyboardMapping &mapping);
+
+} // namespace synth::tuning
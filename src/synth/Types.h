@@ -3,19 +3,61 @@
 #include <cstdint>
 
 namespace synth {
-inline constexpr uint32_t ENGINE_BLOCK_SIZE = 64;
-inline constexpr float INV_ENGINE_BLOCK_SIZE =
-    1.0f / static_cast<float>(ENGINE_BLOCK_SIZE);
+/* Engine block = control rate: block-rate modulation (filter/mod
+ * envelopes, LFOs, mod matrix, filter coefficients) updates once per block
+ * - ENGINE_BLOCK_SIZE: largest block, sizes every per-block buffer
+ * - EngineConfig::controlBlockSize picks the rate at runtime, within
+ *   [MIN_CONTROL_BLOCK_SIZE, ENGINE_BLOCK_SIZE]
+ */
+inline constexpr uint32_t ENGINE_BLOCK_SIZE = 256;
+inline constexpr uint32_t MIN_CONTROL_BLOCK_SIZE = 8;
+inline constexpr uint32_t DEFAULT_CONTROL_BLOCK_SIZE = 64;
 
-inline constexpr uint32_t MAX_VOICES = 64;
+/* Hot per-voice arrays start on their own cache line (also SIMD aligned),
+ * so cold settings never share a line with render state
+ */
+inline constexpr uint32_t CACHE_LINE_SIZE = 64;
+
+// Voices, FX and the engine output render one L/R pair
+inline constexpr uint32_t STEREO_CHANNELS = 2;
+
+/* Polyphony is a build setting (make VOICES=<n>), e.g. 16 for small boxes,
+ * 256 for pad/drone rigs
+ * - POLYPHONY: voices the allocator hands out
+ * - MAX_VOICES: per-voice array length, POLYPHONY padded to a full cache
+ *   line of floats (also the widest SIMD width), so block loops over the
+ *   voice arrays never need a scalar tail
+ * NOTE: padding voices are never allocated (never free, never active)
+ */
+#ifndef SYNTH_POLYPHONY
+#define SYNTH_POLYPHONY 64
+#endif
+
+inline constexpr uint32_t POLYPHONY = SYNTH_POLYPHONY;
+inline constexpr uint32_t VOICE_PADDING =
+    static_cast<uint32_t>(CACHE_LINE_SIZE / sizeof(float));
+inline constexpr uint32_t MAX_VOICES =
+    (POLYPHONY + VOICE_PADDING - 1) / VOICE_PADDING * VOICE_PADDING;
+
+static_assert(POLYPHONY >= 1 && POLYPHONY <= 1024,
+              "SYNTH_POLYPHONY must be in [1, 1024]");
 
 inline constexpr int ROOT_NOTE_MIDI{69};
 inline constexpr float ROOT_NOTE_FREQ{440.0f};
 
 using MidiNote = uint8_t;
 
+/* Engine-wide algorithm tier (runtime, see EngineConfig::quality)
+ * Draft:  naive saw/square, fast tanh in the ladder drive, no oversampling
+ *         (previews)
+ * Live:   polyBLEP, fast exp2, tanh ladder (default, real-time)
+ * Render: Live + libm exp2 for pitch/cutoff modulation, ladder drive
+ *         oversampled at least 2x (offline bounces)
+ */
+enum class QualityMode : uint8_t { Draft, Live, Render };
+
 // Adjust/reduce gain based on N voices
-// 1.0f / std::sqrtf(MAX_VOICES);
+// 1.0f / std::sqrtf(POLYPHONY);
 inline constexpr float VOICE_GAIN = 1.0f / 8.0f;
 
 } // namespace synth
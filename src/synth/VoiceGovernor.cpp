@@ -0,0 +1,150 @@
+#include "VoiceGovernor.h"
+#include "Envelope.h"
+#include "VoicePool.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace synth::governor {
+using EnvelopeStatus = envelope::EnvelopeStatus;
+
+// ==== <Governor Helpers> ====
+namespace {
+
+uint32_t countFadingVoices(const VoicePool &pool) {
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < pool.activeCount; i++)
+    count += voices::isVoiceFading(pool, pool.activeIndices[i]) ? 1u : 0u;
+  return count;
+}
+
+// Voices the measured load says fit in TARGET_LOAD (load ~ linear in voices)
+uint32_t computeFittingVoices(uint32_t renderedVoices, float load) {
+  float fits = static_cast<float>(renderedVoices) * TARGET_LOAD / load;
+  return static_cast<uint32_t>(fits);
+}
+
+} // namespace
+// ==== </Governor Helpers> ====
+
+void initVoiceGovernor(VoiceGovernor &governor, bool enabled,
+                       float sampleRate) {
+  governor.enabled = enabled;
+  governor.smoothedLoad = 0.0f;
+  governor.fadeSamples = static_cast<uint32_t>(FADE_MS * 0.001f * sampleRate);
+
+  governor.voiceCap.store(POLYPHONY, std::memory_order_relaxed);
+  governor.lastLoad.store(0.0f, std::memory_order_relaxed);
+  governor.stolenCount.store(0, std::memory_order_relaxed);
+  governor.culledCount.store(0, std::memory_order_relaxed);
+}
+
+float estimateVoiceLoudness(const VoicePool &pool, uint32_t voiceIndex) {
+  float velocity = pool.velocities[voiceIndex];
+
+  switch (pool.ampEnv.states[voiceIndex]) {
+  case EnvelopeStatus::Idle:
+    return 0.0f;
+  case EnvelopeStatus::Attack:
+    return velocity;
+  case EnvelopeStatus::Decay:
+  case EnvelopeStatus::Sustain:
+  case EnvelopeStatus::Release:
+    break;
+  }
+
+  return pool.ampEnv.levels[voiceIndex] * velocity;
+}
+
+void cullInaudibleVoices(VoiceGovernor &governor, VoicePool &pool) {
+  uint32_t culled = 0;
+
+  // Backwards: removeInactiveIndex swaps the last active voice in
+  for (uint32_t i = pool.activeCount; i > 0; i--) {
+    uint32_t voiceIndex = pool.activeIndices[i - 1];
+
+    EnvelopeStatus state = pool.ampEnv.states[voiceIndex];
+    if (state != EnvelopeStatus::Sustain && state != EnvelopeStatus::Release)
+      continue;
+
+    if (estimateVoiceLoudness(pool, voiceIndex) >= CULL_LEVEL)
+      continue;
+
+    pool.ampEnv.states[voiceIndex] = EnvelopeStatus::Idle;
+    voices::removeInactiveIndex(pool, voiceIndex);
+    culled++;
+  }
+
+  if (culled)
+    governor.culledCount.fetch_add(culled, std::memory_order_relaxed);
+}
+
+void enforceVoiceCap(VoiceGovernor &governor, VoicePool &pool) {
+  const uint32_t cap = governor.voiceCap.load(std::memory_order_relaxed);
+  const uint32_t newestVoice = pool.ageList.tail;
+
+  // Steal candidates: not fading, not the newest voice
+  uint32_t candidates[MAX_VOICES];
+  uint32_t candidateCount = 0;
+  uint32_t audibleCount = 0;
+
+  for (uint32_t i = 0; i < pool.activeCount; i++) {
+    uint32_t voiceIndex = pool.activeIndices[i];
+    if (voices::isVoiceFading(pool, voiceIndex))
+      continue;
+
+    audibleCount++;
+    if (voiceIndex != newestVoice)
+      candidates[candidateCount++] = voiceIndex;
+  }
+
+  if (audibleCount <= cap)
+    return;
+
+  // Quietest first (partial sort, no allocation)
+  uint32_t stealCount = std::min(audibleCount - cap, candidateCount);
+  auto isQuieter = [&pool](uint32_t a, uint32_t b) {
+    return estimateVoiceLoudness(pool, a) < estimateVoiceLoudness(pool, b);
+  };
+  if (stealCount < candidateCount)
+    std::nth_element(candidates, candidates + stealCount,
+                     candidates + candidateCount, isQuieter);
+
+  for (uint32_t i = 0; i < stealCount; i++)
+    voices::fadeOutVoice(pool, candidates[i], governor.fadeSamples);
+
+  governor.stolenCount.fetch_add(stealCount, std::memory_order_relaxed);
+}
+
+void updateVoiceGovernor(VoiceGovernor &governor, VoicePool &pool,
+                         double elapsedSeconds, double deadlineSeconds) {
+  if (deadlineSeconds <= 0.0)
+    return;
+
+  auto load = static_cast<float>(elapsedSeconds / deadlineSeconds);
+  governor.lastLoad.store(load, std::memory_order_relaxed);
+
+  // Instant attack, slow release: the cap only grows back once load has
+  // stayed low for a while
+  if (load > governor.smoothedLoad)
+    governor.smoothedLoad = load;
+  else
+    governor.smoothedLoad += (load - governor.smoothedLoad) *
+                             LOAD_RELEASE_WEIGHT;
+
+  uint32_t cap = governor.voiceCap.load(std::memory_order_relaxed);
+
+  // Shed once per overload: fading voices still render (and count in
+  // _load_), wait for them to finish before measuring again
+  if (load > HIGH_LOAD && countFadingVoices(pool) == 0) {
+    uint32_t fits = computeFittingVoices(pool.activeCount, load);
+    cap = std::max(std::min(cap, fits), MIN_VOICE_CAP);
+  } else if (governor.smoothedLoad < LOW_LOAD && cap < POLYPHONY) {
+    cap++;
+  }
+
+  governor.voiceCap.store(cap, std::memory_order_relaxed);
+  enforceVoiceCap(governor, pool);
+}
+
+} // namespace synth::governor
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Types.h"
+#include "VoicePool.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace synth::governor {
+using VoicePool = voices::VoicePool;
+
+/* CPU aware voice budget
+ * - Engine times every processAudioBlock against its deadline
+ *   (numFrames / sampleRate) and feeds the load here
+ * - over HIGH_LOAD: the voice cap drops to what the measured load says fits,
+ *   extra voices are faded out quietest first (amp level * velocity)
+ * - under LOW_LOAD: the cap grows back one voice per buffer
+ * - Sustain/Release voices below CULL_LEVEL are retired right away
+ *   (inaudible tails never cost a deadline)
+ *
+ * Losing a quiet voice beats glitching the whole output.
+ * NOTE: offline renders disable it (EngineConfig::isVoiceGovernorEnabled)
+ */
+inline constexpr float HIGH_LOAD = 0.8f;  // start shedding voices
+inline constexpr float TARGET_LOAD = 0.7f; // shed down to this load
+inline constexpr float LOW_LOAD = 0.5f;   // let the cap grow back
+
+inline constexpr uint32_t MIN_VOICE_CAP = 4;
+inline constexpr float CULL_LEVEL = 0.001f; // -60 dB (level * velocity)
+inline constexpr float FADE_MS = 5.0f;      // stolen voice fade out
+
+// Release weight of the smoothed load (~16 buffer window, attack is instant)
+inline constexpr float LOAD_RELEASE_WEIGHT = 1.0f / 16.0f;
+
+struct VoiceGovernor {
+  bool enabled = true;
+
+  // Audio thread only
+  float smoothedLoad = 0.0f;
+  uint32_t fadeSamples = 0; // FADE_MS at the engine sample rate
+
+  // ==== Read by any thread (relaxed) ====
+  std::atomic<uint32_t> voiceCap{POLYPHONY};
+  std::atomic<float> lastLoad{0.0f};
+  std::atomic<uint32_t> stolenCount{0}; // faded out to meet the cap
+  std::atomic<uint32_t> culledCount{0}; // retired below CULL_LEVEL
+};
+
+void initVoiceGovernor(VoiceGovernor &governor, bool enabled,
+                       float sampleRate);
+
+// Audible level estimate (Attack counts as full level: new notes are
+// never the quietest)
+float estimateVoiceLoudness(const VoicePool &pool, uint32_t voiceIndex);
+
+// Retire active Sustain/Release voices below CULL_LEVEL (before rendering)
+void cullInaudibleVoices(VoiceGovernor &governor, VoicePool &pool);
+
+/* Fade out the quietest voices until at most voiceCap are left
+ * - voices already fading don't count
+ * - the newest voice (just triggered) is never picked
+ */
+void enforceVoiceCap(VoiceGovernor &governor, VoicePool &pool);
+
+/* Once per processAudioBlock, after rendering
+ * - elapsedSeconds: time the block took, deadlineSeconds: its duration
+ * - updates the cap, then enforces it
+ */
+void updateVoiceGovernor(VoiceGovernor &governor, VoicePool &pool,
+                         double elapsedSeconds, double deadlineSeconds);
+
+} // namespace synth::governor
@@ -1,16 +1,27 @@
 #include "VoicePool.h"
 #include "Envelope.h"
+#include "FMMatrix.h"
+#include "Glide.h"
+#include "LFO.h"
+#include "Noise.h"
 #include "Oscillator.h"
 #include "Types.h"
+#include "VoiceWorkers.h"
 
 #include "synth/Filters.h"
 #include "synth/ModMatrix.h"
+#include "synth/ParamRanges.h"
 
-#include "dsp/Effects.h"
+#include "dsp/Dispatch.h"
 #include "dsp/Math.h"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 namespace synth::voices {
 using ModSrc = mod_matrix::ModSrc;
@@ -18,6 +29,9 @@ using ModDest = mod_matrix::ModDest;
 using ModDest2D = mod_matrix::ModDest2D;
 using ModRoute = mod_matrix::ModRoute;
 
+static_assert(VOICE_SCRATCH_WORST_BYTES <= scratch::VOICE_SCRATCH_BYTES,
+              "voice scratch budget below the renderVoice worst case");
+
 // =========================
 // VoicePool Configuration
 // =========================
@@ -26,11 +40,13 @@ void updateVoicePoolConfig(VoicePool &pool, const VoicePoolConfig &config) {
   pool.invSampleRate = 1.0f / config.sampleRate;
 
   pool.masterGain = config.masterGain;
+  pool.quality = config.quality;
 
   oscillator::updateConfig(pool.osc1, config.osc1);
   oscillator::updateConfig(pool.osc2, config.osc2);
   oscillator::updateConfig(pool.osc3, config.osc3);
   oscillator::updateConfig(pool.subOsc, config.subOsc);
+  updatePitchTables(pool);
 
   filters::updateSVFCoefficients(pool.svf, pool.invSampleRate);
   filters::updateLadderCoefficient(pool.ladder, pool.invSampleRate);
@@ -39,26 +55,102 @@ void updateVoicePoolConfig(VoicePool &pool, const VoicePoolConfig &config) {
                        0.0f);
   mod_matrix::addRoute(pool.modMatrix, ModSrc::FilterEnv, ModDest::LadderCutoff,
                        0.0f);
+
+  selectRenderKernel(pool);
+}
+
+void updatePitchTables(VoicePool &pool) {
+  oscillator::updateNoteIncrements(pool.osc1, pool.tuning, pool.sampleRate);
+  oscillator::updateNoteIncrements(pool.osc2, pool.tuning, pool.sampleRate);
+  oscillator::updateNoteIncrements(pool.osc3, pool.tuning, pool.sampleRate);
+  oscillator::updateNoteIncrements(pool.subOsc, pool.tuning, pool.sampleRate);
 }
 
 // =========================
 //  Voice Allocation
 // =========================
-// Find free or oldest voice index for voice Initialization
-uint32_t allocateVoiceIndex(VoicePool &pool) {
-  uint32_t oldestIndex = MAX_VOICES; // out of range
-  uint32_t oldestNoteOnTime = UINT32_MAX;
 
+// ==== <Allocation Helpers> ====
+namespace {
+
+void appendVoice(VoiceList &list, VoiceLinks &links, uint32_t voiceIndex) {
+  links.prev[voiceIndex] = list.tail;
+  links.next[voiceIndex] = NO_VOICE;
+
+  if (list.tail == NO_VOICE)
+    list.head = voiceIndex;
+  else
+    links.next[list.tail] = voiceIndex;
+
+  list.tail = voiceIndex;
+}
+
+void unlinkVoice(VoiceList &list, VoiceLinks &links, uint32_t voiceIndex) {
+  uint32_t prev = links.prev[voiceIndex];
+  uint32_t next = links.next[voiceIndex];
+
+  if (prev == NO_VOICE)
+    list.head = next;
+  else
+    links.next[prev] = next;
+
+  if (next == NO_VOICE)
+    list.tail = prev;
+  else
+    links.prev[next] = prev;
+}
+
+void setVoiceFree(VoicePool &pool, uint32_t voiceIndex, bool isFree) {
+  uint64_t bit = uint64_t{1} << (voiceIndex % 64);
+
+  if (isFree)
+    pool.freeMask[voiceIndex / 64] |= bit;
+  else
+    pool.freeMask[voiceIndex / 64] &= ~bit;
+}
+
+// Voice no longer answers its note's noteOff (released or retired)
+void unholdNote(VoicePool &pool, uint32_t voiceIndex) {
+  if (!pool.isNoteHeld[voiceIndex])
+    return;
+
+  unlinkVoice(pool.noteLists[pool.midiNotes[voiceIndex] % NUM_MIDI_NOTES],
+              pool.noteLinks, voiceIndex);
+  pool.isNoteHeld[voiceIndex] = 0;
+}
+
+} // namespace
+// ==== </Allocation Helpers> ====
+
+void resetVoiceAllocator(VoicePool &pool) {
+  pool.activeCount = 0;
+  pool.ageList = {};
+
+  for (VoiceList &list : pool.noteLists)
+    list = {};
+
+  for (uint64_t &word : pool.freeMask)
+    word = 0;
+
+  // Padding voices (>= POLYPHONY) stay allocated forever
   for (uint32_t i = 0; i < MAX_VOICES; i++) {
-    if (!pool.isActive[i]) {
-      return i; // return available voice index
-    } else {
-      if (pool.noteOnTimes[i] < oldestNoteOnTime) {
-        oldestNoteOnTime = pool.noteOnTimes[i];
-        oldestIndex = i;
-      }
-    }
+    pool.isActive[i] = 0;
+    pool.isNoteHeld[i] = 0;
+    setVoiceFree(pool, i, i < POLYPHONY);
   }
+}
+
+// Find free or oldest voice index for voice Initialization
+uint32_t allocateVoiceIndex(VoicePool &pool) {
+  for (uint32_t w = 0; w < VOICE_MASK_WORDS; w++) {
+    if (pool.freeMask[w])
+      return w * 64 + static_cast<uint32_t>(__builtin_ctzll(pool.freeMask[w]));
+  }
+
+  // Steal the oldest voice
+  uint32_t oldestIndex = pool.ageList.head;
+  assert(oldestIndex != NO_VOICE);
+  pool.stealCount++;
 
   // Need to cleanup otherwise it'll play twice
   // since it'll be added again after initializing voice
@@ -68,28 +160,36 @@ uint32_t allocateVoiceIndex(VoicePool &pool) {
 }
 
 void addActiveIndex(VoicePool &pool, uint32_t voiceIndex) {
+  pool.activePositions[voiceIndex] = pool.activeCount;
   pool.activeIndices[pool.activeCount] = voiceIndex;
   pool.activeCount++;
-}
+  pool.peakActiveCount = std::max(pool.peakActiveCount, pool.activeCount);
 
-// TODO(nico): this is confusing.  there must be a better way
-void removeInactiveIndex(VoicePool &pool, uint32_t voiceIndex) {
-  uint32_t removeIndex = pool.activeCount; // out of range of active
+  setVoiceFree(pool, voiceIndex, false);
+  appendVoice(pool.ageList, pool.ageLinks, voiceIndex);
 
-  for (uint32_t i = 0; i < pool.activeCount; i++) {
-    if (pool.activeIndices[i] == voiceIndex) {
-      removeIndex = i;
-      break;
-    }
-  }
+  appendVoice(pool.noteLists[pool.midiNotes[voiceIndex] % NUM_MIDI_NOTES],
+              pool.noteLinks, voiceIndex);
+  pool.isNoteHeld[voiceIndex] = 1;
+}
 
-  if (removeIndex == pool.activeCount)
+void removeInactiveIndex(VoicePool &pool, uint32_t voiceIndex) {
+  if (!pool.isActive[voiceIndex])
     return;
 
   // Swap current inactive with most recent active
+  uint32_t removeIndex = pool.activePositions[voiceIndex];
   pool.activeCount--;
-  pool.activeIndices[removeIndex] = pool.activeIndices[pool.activeCount];
+
+  uint32_t movedVoice = pool.activeIndices[pool.activeCount];
+  pool.activeIndices[removeIndex] = movedVoice;
+  pool.activePositions[movedVoice] = removeIndex;
+
+  unlinkVoice(pool.ageList, pool.ageLinks, voiceIndex);
+  unholdNote(pool, voiceIndex);
+
   pool.isActive[voiceIndex] = 0;
+  setVoiceFree(pool, voiceIndex, true);
 }
 
 // =========================
@@ -101,32 +201,139 @@ namespace {
 
 bool isValidActiveIndex(uint32_t index) { return index < MAX_VOICES; }
 
-uint32_t findVoiceRelease(VoicePool &pool, uint8_t midiNote) {
-  for (uint32_t i = 0; i < pool.activeCount; i++) {
-    uint32_t voiceIndex = pool.activeIndices[i];
-    if (pool.midiNotes[voiceIndex] == midiNote &&
-        pool.ampEnv.states[voiceIndex] != envelope::EnvelopeStatus::Release &&
-        pool.ampEnv.states[voiceIndex] != envelope::EnvelopeStatus::Idle) {
+// Voice spread slots, dealt out by note-on order: alternating sides, every
+// slot distinct so stacked notes fill the whole width
+constexpr float SPREAD_POSITIONS[] = {-1.0f, 1.0f,   -0.5f,  0.5f,
+                                      -0.75f, 0.75f, -0.25f, 0.25f};
+constexpr uint32_t SPREAD_SLOTS =
+    sizeof(SPREAD_POSITIONS) / sizeof(SPREAD_POSITIONS[0]);
+
+// Oldest voice still holding _midiNote_, on _channel_ when there's one
+// (NO_VOICE if none)
+uint32_t findVoiceRelease(VoicePool &pool, uint8_t midiNote, uint8_t channel) {
+  uint32_t head = pool.noteLists[midiNote % NUM_MIDI_NOTES].head;
+
+  for (uint32_t v = head; v != NO_VOICE; v = pool.noteLinks.next[v]) {
+    if (pool.expression.channels[v] == channel)
+      return v;
+  }
+  return head;
+}
 
-      return voiceIndex;
-    }
+// ==== Mono / legato ====
+bool isMonoMode(const VoicePool &pool) {
+  return pool.voiceMode != static_cast<int8_t>(VoiceMode::Poly);
+}
+
+void removeHeldNote(VoicePool &pool, uint8_t midiNote) {
+  uint32_t kept = 0;
+  for (uint32_t i = 0; i < pool.heldNoteCount; i++) {
+    if (pool.heldNotes[i] != midiNote)
+      pool.heldNotes[kept++] = pool.heldNotes[i];
+  }
+  pool.heldNoteCount = kept;
+}
+
+void pushHeldNote(VoicePool &pool, uint8_t midiNote) {
+  removeHeldNote(pool, midiNote);
+  if (pool.heldNoteCount < NUM_MIDI_NOTES)
+    pool.heldNotes[pool.heldNoteCount++] = midiNote;
+}
+
+// The mono voice, if it's still sounding (not retired, stolen or fading)
+uint32_t findMonoVoice(const VoicePool &pool) {
+  uint32_t v = pool.monoVoice;
+  if (!isValidActiveIndex(v) || !pool.isActive[v] || isVoiceFading(pool, v))
+    return NO_VOICE;
+  return v;
+}
+
+/* Switch a playing voice to _midiNote_ without re-initializing it
+ * Oscillator phases, filters, LFOs and envelopes carry on; the pitch
+ * glides from where it is (mid-glide included) to the new note
+ */
+void retargetVoice(VoicePool &pool, uint32_t voiceIndex, uint8_t midiNote) {
+  uint8_t fromNote = pool.midiNotes[voiceIndex];
+  const float *frequencies = pool.tuning.frequencies;
+
+  float fromSemitones =
+      glide::currentOffset(pool.glide, voiceIndex) +
+      12.0f * std::log2(frequencies[fromNote % tuning::NUM_TUNING_NOTES] /
+                        frequencies[midiNote % tuning::NUM_TUNING_NOTES]);
+
+  // Re-file the voice under its new note (answers that noteOff now)
+  unholdNote(pool, voiceIndex);
+  pool.midiNotes[voiceIndex] = midiNote;
+  appendVoice(pool.noteLists[midiNote % NUM_MIDI_NOTES], pool.noteLinks,
+              voiceIndex);
+  pool.isNoteHeld[voiceIndex] = 1;
+
+  oscillator::retargetOscillator(pool.osc1, voiceIndex, midiNote);
+  oscillator::retargetOscillator(pool.osc2, voiceIndex, midiNote);
+  oscillator::retargetOscillator(pool.osc3, voiceIndex, midiNote);
+  oscillator::retargetOscillator(pool.subOsc, voiceIndex, midiNote);
+
+  glide::startGlide(pool.glide, voiceIndex, fromSemitones, pool.sampleRate);
+}
+
+void retriggerEnvelopes(VoicePool &pool, uint32_t voiceIndex) {
+  envelope::retriggerEnvelope(pool.ampEnv, voiceIndex);
+  envelope::retriggerEnvelope(pool.filterEnv, voiceIndex);
+  envelope::retriggerEnvelope(pool.modEnv, voiceIndex);
+}
+
+// Mono: every note retriggers. Legato: only a note played with no other
+// key held does (and doesn't glide)
+void handleMonoNoteOn(VoicePool &pool, uint8_t midiNote, float velocity,
+                      uint32_t noteOnTime, float sampleRate, uint8_t channel) {
+  bool isOverlapping = pool.heldNoteCount > 0;
+  pushHeldNote(pool, midiNote);
+
+  uint32_t voiceIndex = findMonoVoice(pool);
+  if (voiceIndex == NO_VOICE) {
+    voiceIndex = allocateVoiceIndex(pool);
+    initializeVoice(pool, voiceIndex, midiNote, velocity, noteOnTime,
+                    sampleRate, channel);
+    addActiveIndex(pool, voiceIndex);
+    pool.monoVoice = voiceIndex;
+    return;
   }
-  return MAX_VOICES;
+
+  bool isLegato = pool.voiceMode == static_cast<int8_t>(VoiceMode::Legato);
+  retargetVoice(pool, voiceIndex, midiNote);
+  pool.expression.channels[voiceIndex] = channel;
+
+  if (isLegato && isOverlapping)
+    return;
+
+  if (isLegato)
+    glide::resetGlide(pool.glide, voiceIndex);
+
+  pool.velocities[voiceIndex] = velocity / 127.0f;
+  retriggerEnvelopes(pool, voiceIndex);
 }
 
 } // namespace
 // ==== </Initialization Helpers> ====
 
 void initializeVoice(VoicePool &pool, uint32_t voiceIndex, uint8_t midiNote,
-                     float velocity, uint32_t noteOnTime, float sampleRate) {
+                     float velocity, uint32_t noteOnTime, float sampleRate,
+                     uint8_t channel) {
   // ==== Set Metadata ====
   pool.isActive[voiceIndex] = 1;
   pool.midiNotes[voiceIndex] = midiNote;
   pool.noteOnTimes[voiceIndex] = noteOnTime;
   pool.velocities[voiceIndex] = velocity / 127.0f;
-
-  pool.sampleRate = sampleRate;
-  pool.invSampleRate = 1.0f / sampleRate;
+  pool.spreadPositions[voiceIndex] =
+      SPREAD_POSITIONS[noteOnTime % SPREAD_SLOTS];
+  pool.fadeGains[voiceIndex] = 1.0f;
+  pool.fadeSteps[voiceIndex] = 0.0f;
+
+  if (sampleRate != pool.sampleRate) {
+    pool.sampleRate = sampleRate;
+    pool.invSampleRate = 1.0f / sampleRate;
+    updatePitchTables(pool);
+  }
 
   // ==== Reset Modulation Destination Values ====
   for (int d = 0; d < ModDest::DEST_COUNT; d++) {
@@ -135,16 +342,24 @@ void initializeVoice(VoicePool &pool, uint32_t voiceIndex, uint8_t midiNote,
   }
 
   // ==== Initialize Oscillator 1 ====
-  oscillator::initOscillator(pool.osc1, voiceIndex, midiNote, sampleRate);
+  oscillator::initOscillator(pool.osc1, voiceIndex, midiNote);
 
   // ==== Initialize Oscillator 2 ====
-  oscillator::initOscillator(pool.osc2, voiceIndex, midiNote, sampleRate);
+  oscillator::initOscillator(pool.osc2, voiceIndex, midiNote);
 
   // ==== Initialize Oscillator 3 ====
-  oscillator::initOscillator(pool.osc3, voiceIndex, midiNote, sampleRate);
+  oscillator::initOscillator(pool.osc3, voiceIndex, midiNote);
 
   // ==== Initialize Sub Oscillator ====
-  oscillator::initOscillator(pool.subOsc, voiceIndex, midiNote, sampleRate);
+  oscillator::initOscillator(pool.subOsc, voiceIndex, midiNote);
+
+  glide::resetGlide(pool.glide, voiceIndex);
+
+  // ==== Initialize Noise ====
+  noise::initNoise(pool.noise, voiceIndex, noteOnTime);
+  controllers::initControllers(pool.controllers, voiceIndex, midiNote);
+  controllers::initNoteExpression(pool.controllers, pool.expression,
+                                  voiceIndex, channel);
 
   // ==== Initialize Envelopes ====
   // Amp envelope
@@ -156,28 +371,75 @@ void initializeVoice(VoicePool &pool, uint32_t voiceIndex, uint8_t midiNote,
   // Mod envelope
   envelope::initEnvelope(pool.modEnv, voiceIndex, sampleRate);
 
+  // ==== Initialize LFOs (retrigger mode only reads these) ====
+  lfo::initLFO(pool.lfo1, voiceIndex);
+  lfo::initLFO(pool.lfo2, voiceIndex);
+  lfo::initLFO(pool.lfo3, voiceIndex);
+
   // ==== Initialize Filter States ====
   filters::initSVFilter(pool.svf, voiceIndex);
   filters::initLadderFilter(pool.ladder, voiceIndex);
+  saturator::initSaturator(pool.saturator, voiceIndex);
+  saturator::initDCBlocker(pool.dcBlocker, voiceIndex);
 }
 
-void releaseVoice(VoicePool &pool, uint8_t midiNote) {
-  uint32_t voiceIndex = findVoiceRelease(pool, midiNote);
+void releaseVoice(VoicePool &pool, uint8_t midiNote, uint8_t channel) {
+  if (isMonoMode(pool)) {
+    removeHeldNote(pool, midiNote);
+
+    // Back to the last key still held (no retrigger)
+    uint32_t monoVoice = findMonoVoice(pool);
+    if (monoVoice != NO_VOICE && pool.isNoteHeld[monoVoice] &&
+        pool.midiNotes[monoVoice] == midiNote && pool.heldNoteCount > 0) {
+      retargetVoice(pool, monoVoice, pool.heldNotes[pool.heldNoteCount - 1]);
+      return;
+    }
+  }
+
+  uint32_t voiceIndex = findVoiceRelease(pool, midiNote, channel);
 
   if (!isValidActiveIndex(voiceIndex))
     return;
 
+  unholdNote(pool, voiceIndex);
+
   envelope::triggerRelease(pool.ampEnv, voiceIndex);
   envelope::triggerRelease(pool.filterEnv, voiceIndex);
   envelope::triggerRelease(pool.modEnv, voiceIndex);
 }
 
+void fadeOutVoice(VoicePool &pool, uint32_t voiceIndex, uint32_t numSamples) {
+  if (!pool.isActive[voiceIndex] || isVoiceFading(pool, voiceIndex))
+    return;
+
+  unholdNote(pool, voiceIndex);
+
+  pool.fadeGains[voiceIndex] = 1.0f;
+  pool.fadeSteps[voiceIndex] =
+      1.0f / static_cast<float>(std::max(numSamples, 1u));
+}
+
 // Handle NoteOn Events
 void handleNoteOn(VoicePool &pool, uint8_t midiNote, float velocity,
-                  uint32_t noteOnTime, float sampleRate) {
+                  uint32_t noteOnTime, float sampleRate, uint8_t channel) {
+  // Keys the tuning leaves unmapped stay silent
+  if (!pool.tuning.isMapped[midiNote % tuning::NUM_TUNING_NOTES])
+    return;
+
+  if (isMonoMode(pool)) {
+    handleMonoNoteOn(pool, midiNote, velocity, noteOnTime, sampleRate,
+                     channel);
+    return;
+  }
+
+  // Left mono mode: its voice plays out like any other
+  pool.monoVoice = NO_VOICE;
+  pool.heldNoteCount = 0;
+
   uint32_t voiceIndex = allocateVoiceIndex(pool);
 
-  initializeVoice(pool, voiceIndex, midiNote, velocity, noteOnTime, sampleRate);
+  initializeVoice(pool, voiceIndex, midiNote, velocity, noteOnTime, sampleRate,
+                  channel);
 
   addActiveIndex(pool, voiceIndex);
 }
@@ -189,201 +451,656 @@ void handleNoteOn(VoicePool &pool, uint8_t midiNote, float velocity,
 namespace {
 // ==== <Processing Helpers> ====
 
-/* ==== Pre-pass: once per block, once per active voice ====
- * Advance block-rate envelopes (filterEnv, modEnv).
+/* ==== Pre-pass: once per block ====
+ * Advance block-rate envelopes (filterEnv, modEnv) and gather every source
+ * into dense per-voice rows (activeIndices order).
  * ampEnv is NOT advanced here; it runs per-sample in the hot loop below.
+ * LFOs are sampled at the block start (like the block-rate envelopes).
+ *
+ * Compiled routes then accumulate across voices, one routed destination at
+ * a time; unrouted destinations are never touched (they stay zero).
  * ==================================================================== */
-void preProcessBlock(VoicePool &pool, size_t numSamples) {
+void preProcessBlock(VoicePool &pool, size_t numSamples,
+                     scratch::ScratchArena &scratch) {
   float invNumSamples = 1.0f / static_cast<float>(numSamples);
 
-  mod_matrix::clearModDestSteps(pool.modMatrix);
+  const uint32_t count = pool.activeCount;
+  const mod_matrix::CompiledRoutes &compiled = pool.modMatrix.compiled;
 
-  for (uint32_t i = pool.activeCount; i > 0; i--) {
-    uint32_t voiceIndex = pool.activeIndices[i - 1];
+  // Advance by the block length (blocks can be shorter than
+  // ENGINE_BLOCK_SIZE when split at event frames)
+  auto blockLength = static_cast<uint32_t>(numSamples);
+
+  float smoothing =
+      controllers::computeSmoothingCoeff(blockLength, pool.invSampleRate);
+  controllers::processControllers(pool.controllers, pool.activeIndices,
+                                  pool.midiNotes, count, smoothing);
+  controllers::processNoteExpression(pool.controllers, pool.expression,
+                                     pool.activeIndices, count, smoothing);
+
+  glide::processGlide(pool.glide, pool.activeIndices, count, blockLength);
 
-    // Set initial modulation source values
-    float modSrcs[ModSrc::SRC_COUNT] = {};
+  // ==== Gather modulation sources ====
+  scratch::ScratchMark mark = scratch::markScratch(scratch);
+  auto *modSrcs =
+      scratch::allocateScratch<float[MAX_VOICES]>(scratch, ModSrc::SRC_COUNT);
+
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t voiceIndex = pool.activeIndices[i];
 
     // NOTE(nico): since this is processed in the main loop it's setting the
     // last value of the PRIOR block on first run; should be fine for now
-    modSrcs[ModSrc::AmpEnv] =
+    modSrcs[ModSrc::AmpEnv][i] =
         pool.ampEnv.levels[voiceIndex]; // processed in main loop
 
-    modSrcs[ModSrc::FilterEnv] =
-        envelope::processEnvelope(pool.filterEnv, voiceIndex);
+    modSrcs[ModSrc::FilterEnv][i] =
+        envelope::processEnvelope(pool.filterEnv, voiceIndex, blockLength);
 
-    modSrcs[ModSrc::ModEnv] =
-        envelope::processEnvelope(pool.modEnv, voiceIndex);
+    modSrcs[ModSrc::ModEnv][i] =
+        envelope::processEnvelope(pool.modEnv, voiceIndex, blockLength);
 
-    modSrcs[ModSrc::Velocity] = pool.velocities[voiceIndex];
+    modSrcs[ModSrc::Velocity][i] = pool.velocities[voiceIndex];
 
-    // Accumulate mod destinations
-    float modDests[ModDest::DEST_COUNT] = {};
+    modSrcs[ModSrc::ModWheel][i] = pool.controllers.modWheel;
+    modSrcs[ModSrc::PitchBend][i] = pool.controllers.pitchBend;
+    modSrcs[ModSrc::ChannelPressure][i] = pool.controllers.channelPressure;
+    modSrcs[ModSrc::PolyPressure][i] =
+        pool.controllers.polyPressures[voiceIndex];
 
-    for (uint8_t r = 0; r < pool.modMatrix.count; r++) {
-      const ModRoute &route = pool.modMatrix.routes[r];
+    modSrcs[ModSrc::NoteBend][i] = pool.expression.bends[voiceIndex];
+    modSrcs[ModSrc::NotePressure][i] = pool.expression.pressures[voiceIndex];
+    modSrcs[ModSrc::NoteSlide][i] = pool.expression.slides[voiceIndex];
+  }
 
-      if (route.src == ModSrc::NoSrc || route.dest == ModDest::NoDest)
-        continue;
+  // LFOs: one batch per LFO for every voice (global ones evaluated once)
+  lfo::processLFOBlock(pool.lfo1, pool.activeIndices, count, blockLength,
+                       pool.invSampleRate, modSrcs[ModSrc::LFO1]);
+  lfo::processLFOBlock(pool.lfo2, pool.activeIndices, count, blockLength,
+                       pool.invSampleRate, modSrcs[ModSrc::LFO2]);
+  lfo::processLFOBlock(pool.lfo3, pool.activeIndices, count, blockLength,
+                       pool.invSampleRate, modSrcs[ModSrc::LFO3]);
 
-      modDests[route.dest] += modSrcs[route.src] * route.amount;
+  noise::processNoiseSource(pool.noise, pool.activeIndices, count,
+                            modSrcs[ModSrc::Noise]);
+
+  // ==== Accumulate routed destinations (routes grouped by dest) ====
+  uint8_t r = 0;
+  for (uint8_t d = 0; d < compiled.destCount; d++) {
+    const ModDest dest = compiled.dests[d];
+
+    alignas(16) float modDest[MAX_VOICES];
+    for (uint32_t i = 0; i < count; i++)
+      modDest[i] = 0.0f;
+
+    for (; r < compiled.count && compiled.routes[r].dest == dest; r++) {
+      const float *src = modSrcs[compiled.routes[r].src];
+      const float amount = compiled.routes[r].amount;
+
+      for (uint32_t i = 0; i < count; i++)
+        modDest[i] += src[i] * amount;
     }
 
-    // Set modulation destination values
-    for (int d = 0; d < ModDest::DEST_COUNT; d++)
-      pool.modMatrix.destValues[d][voiceIndex] = modDests[d];
-
-    // Interpolation setup for fast destinations (pitch)
-    mod_matrix::setModDestStep(pool.modMatrix, ModDest::Osc1Pitch, voiceIndex,
-                               invNumSamples);
-    mod_matrix::setModDestStep(pool.modMatrix, ModDest::Osc2Pitch, voiceIndex,
-                               invNumSamples);
-    mod_matrix::setModDestStep(pool.modMatrix, ModDest::Osc3Pitch, voiceIndex,
-                               invNumSamples);
-    mod_matrix::setModDestStep(pool.modMatrix, ModDest::SubOscPitch, voiceIndex,
-                               invNumSamples);
+    // Scatter back to voice slots
+    float *destValues = pool.modMatrix.destValues[dest];
+    for (uint32_t i = 0; i < count; i++)
+      destValues[pool.activeIndices[i]] = modDest[i];
+
+    // Interpolation setup for fast destinations (pitch, wavetable position)
+    if (mod_matrix::isInterpolatedDest(dest)) {
+      for (uint32_t i = 0; i < count; i++)
+        mod_matrix::setModDestStep(pool.modMatrix, dest, pool.activeIndices[i],
+                                   invNumSamples);
+    }
   }
+
+  scratch::releaseScratch(scratch, mark);
 };
 
-// Calculate interpolation for pitch increment (hot-loop)
-float interpolatePitchInc(Oscillator &osc, ModMatrix &matrix, ModDest dest,
-                          uint32_t voiceIndex, uint32_t sampleIndex) {
-  // Calculate pitch modulation
-  float pitchMod = matrix.prevDestValues[dest][voiceIndex] +
-                   (matrix.destStepValues[dest][voiceIndex] *
-                    static_cast<float>(sampleIndex));
-
-  // Calculate and return modulated phase increment
-  return osc.phaseIncrements[voiceIndex] *
-         dsp::math::semitonesToFreqRatio(pitchMod);
-}
-
-// Process Oscillators with interpolation and mix (sum) values
-float processAndMixOscillators(VoicePool &pool, uint32_t voiceIndex,
-                               uint32_t sampleIndex) {
-  // Oscillator 1
-  float osc1PhaseInc = interpolatePitchInc(
-      pool.osc1, pool.modMatrix, ModDest::Osc1Pitch, voiceIndex, sampleIndex);
-  float osc1MixLevel = pool.osc1.mixLevel +
-                       pool.modMatrix.destValues[ModDest::Osc1Mix][voiceIndex];
-  float osc1 = oscillator::processOscillator(pool.osc1, voiceIndex,
-                                             osc1PhaseInc, osc1MixLevel);
-
-  // Oscillator 2
-  float osc2PhaseInc = interpolatePitchInc(
-      pool.osc2, pool.modMatrix, ModDest::Osc2Pitch, voiceIndex, sampleIndex);
-  float osc2MixLevel = pool.osc2.mixLevel +
-                       pool.modMatrix.destValues[ModDest::Osc2Mix][voiceIndex];
-  float osc2 = oscillator::processOscillator(pool.osc2, voiceIndex,
-                                             osc2PhaseInc, osc2MixLevel);
-
-  // Oscillator 3
-  float osc3PhaseInc = interpolatePitchInc(
-      pool.osc3, pool.modMatrix, ModDest::Osc3Pitch, voiceIndex, sampleIndex);
-  float osc3MixLevel = pool.osc3.mixLevel +
-                       pool.modMatrix.destValues[ModDest::Osc3Mix][voiceIndex];
-  float osc3 = oscillator::processOscillator(pool.osc3, voiceIndex,
-                                             osc3PhaseInc, osc3MixLevel);
-
-  // Sub Oscillator
-  float subOscPhaseInc =
-      interpolatePitchInc(pool.subOsc, pool.modMatrix, ModDest::SubOscPitch,
-                          voiceIndex, sampleIndex);
-  float subOscMixLevel =
-      pool.subOsc.mixLevel +
-      pool.modMatrix.destValues[ModDest::SubOscMix][voiceIndex];
-  float subOsc = oscillator::processOscillator(pool.subOsc, voiceIndex,
-                                               subOscPhaseInc, subOscMixLevel);
-
-  return (osc1 + osc2 + osc3 + subOsc) * pool.oscMixGain;
+/* Calculate (interpolated) pitch increments for the whole block
+ * The glide ramp (semitones) adds to the pitch modulation ramp
+ * Fast paths skip the exp2 work:
+ * - unrouted pitch dest, no glide: base increment for every sample
+ * - flat this block (no ramp): one scalar exp2
+ */
+void interpolatePitchIncBlock(Oscillator &osc, ModMatrix &matrix, ModDest dest,
+                              const glide::Glide &glide, uint32_t voiceIndex,
+                              float *phaseIncrements, size_t numSamples,
+                              QualityMode quality) {
+  float baseInc = osc.phaseIncrements[voiceIndex];
+
+  float prevPitchMod = glide.starts[voiceIndex];
+  float pitchModStep = glide.steps[voiceIndex];
+
+  if (matrix.compiled.isDestRouted[dest]) {
+    prevPitchMod += matrix.prevDestValues[dest][voiceIndex];
+    pitchModStep += matrix.destStepValues[dest][voiceIndex];
+  } else if (prevPitchMod == 0.0f && pitchModStep == 0.0f) {
+    for (size_t s = 0; s < numSamples; s++)
+      phaseIncrements[s] = baseInc;
+    return;
+  }
+
+  if (pitchModStep == 0.0f && quality != QualityMode::Render) {
+    float inc = baseInc * dsp::math::semitonesToFreqRatio(prevPitchMod);
+    for (size_t s = 0; s < numSamples; s++)
+      phaseIncrements[s] = inc;
+    return;
+  }
+
+  // Pitch modulation ramp (semitones)
+  for (size_t s = 0; s < numSamples; s++)
+    phaseIncrements[s] = prevPitchMod + pitchModStep * static_cast<float>(s);
+
+  if (quality == QualityMode::Render)
+    dsp::math::semitonesToFreqRatioExactBlock(phaseIncrements, phaseIncrements,
+                                              numSamples);
+  else
+    dsp::dispatch::kernels().semitonesToFreqRatioBlock(
+        phaseIncrements, phaseIncrements, numSamples);
+
+  // Modulated phase increment
+  for (size_t s = 0; s < numSamples; s++)
+    phaseIncrements[s] = baseInc * phaseIncrements[s];
+}
+
+/* Wavetable positions (base + modulation ramp) for the whole block
+ * Returns nullptr when _osc_ isn't scanning or _dest_ isn't routed (the
+ * oscillator plays its base position then)
+ */
+const float *interpolateWavetablePosBlock(const Oscillator &osc,
+                                          const ModMatrix &matrix,
+                                          ModDest dest, uint32_t voiceIndex,
+                                          float *positions,
+                                          size_t numSamples) {
+  if (!oscillator::isScanningWavetable(osc) ||
+      !matrix.compiled.isDestRouted[dest])
+    return nullptr;
+
+  float start = osc.wavetablePosition + matrix.prevDestValues[dest][voiceIndex];
+  float step = matrix.destStepValues[dest][voiceIndex];
+
+  for (size_t s = 0; s < numSamples; s++)
+    positions[s] = start + step * static_cast<float>(s);
+
+  return positions;
+}
+
+// Process a single oscillator for the block and mix (sum) into _output_
+void mixOscillator(Oscillator &osc, ModMatrix &matrix, ModDest pitchDest,
+                   ModDest mixDest, ModDest positionDest,
+                   const glide::Glide &glide, uint32_t voiceIndex,
+                   float *output, size_t numSamples,
+                   scratch::ScratchArena &scratch, QualityMode quality) {
+  alignas(16) float phaseIncrements[ENGINE_BLOCK_SIZE];
+  alignas(16) float positions[ENGINE_BLOCK_SIZE];
+
+  interpolatePitchIncBlock(osc, matrix, pitchDest, glide, voiceIndex,
+                           phaseIncrements, numSamples, quality);
+
+  const float *scanPositions = interpolateWavetablePosBlock(
+      osc, matrix, positionDest, voiceIndex, positions, numSamples);
+
+  float mixLevel = osc.mixLevel + matrix.destValues[mixDest][voiceIndex];
+
+  oscillator::mixOscillatorBlock(osc, voiceIndex, phaseIncrements,
+                                 scanPositions, mixLevel, output, numSamples,
+                                 scratch, quality);
+}
+
+/* ==== Voice topology (render kernel key) ====
+ * Enabled sources of the current patch, read once per block
+ * Each combination gets its own renderVoiceKernel instance (the stages
+ * after the mix are a call list instead, see selectRenderKernel)
+ */
+enum VoiceTopology : uint32_t {
+  TOPOLOGY_OSC1 = 1 << 0,
+  TOPOLOGY_OSC2 = 1 << 1,
+  TOPOLOGY_OSC3 = 1 << 2,
+  TOPOLOGY_SUB_OSC = 1 << 3,
+  TOPOLOGY_NOISE = 1 << 4,
+  TOPOLOGY_COUNT = 1 << 5,
+};
+
+uint32_t computeVoiceTopology(const VoicePool &pool) {
+  uint32_t topology = 0;
+  topology |= pool.osc1.enabled ? TOPOLOGY_OSC1 : 0u;
+  topology |= pool.osc2.enabled ? TOPOLOGY_OSC2 : 0u;
+  topology |= pool.osc3.enabled ? TOPOLOGY_OSC3 : 0u;
+  topology |= pool.subOsc.enabled ? TOPOLOGY_SUB_OSC : 0u;
+  topology |= pool.noise.enabled ? TOPOLOGY_NOISE : 0u;
+  return topology;
+}
+
+/* FM path: oscillators render raw into their own buffers in dependency
+ * order (modulators first), each carrier reads its modulators' block as
+ * per-sample phase offsets, then everything is mixed
+ * Disabled oscillators are skipped (and modulate nothing)
+ */
+template <uint32_t Topology>
+void mixFMOscillators(VoicePool &pool, uint32_t voiceIndex, float *output,
+                      size_t numSamples, scratch::ScratchArena &scratch) {
+  using fm_matrix::FM_OSC_COUNT;
+
+  constexpr uint32_t TOPOLOGY_BITS[FM_OSC_COUNT] = {
+      TOPOLOGY_OSC1, TOPOLOGY_OSC2, TOPOLOGY_OSC3, TOPOLOGY_SUB_OSC};
+  constexpr ModDest PITCH_DESTS[FM_OSC_COUNT] = {
+      ModDest::Osc1Pitch, ModDest::Osc2Pitch, ModDest::Osc3Pitch,
+      ModDest::SubOscPitch};
+  constexpr ModDest MIX_DESTS[FM_OSC_COUNT] = {
+      ModDest::Osc1Mix, ModDest::Osc2Mix, ModDest::Osc3Mix,
+      ModDest::SubOscMix};
+  constexpr ModDest POSITION_DESTS[FM_OSC_COUNT] = {
+      ModDest::Osc1WTPos, ModDest::Osc2WTPos, ModDest::Osc3WTPos,
+      ModDest::SubOscWTPos};
+
+  Oscillator *oscs[FM_OSC_COUNT] = {&pool.osc1, &pool.osc2, &pool.osc3,
+                                    &pool.subOsc};
+
+  const fm_matrix::FMMatrix &fm = pool.fmMatrix;
+  ModMatrix &matrix = pool.modMatrix;
+
+  float depth = 1.0f + param::ranges::mod::clampFMDepthMod(
+                           matrix.destValues[ModDest::FMDepth][voiceIndex]);
+
+  // Modulator blocks stay live until every carrier has read them
+  scratch::ScratchMark mark = scratch::markScratch(scratch);
+  auto *rendered = scratch::allocateScratch<float[ENGINE_BLOCK_SIZE]>(
+      scratch, FM_OSC_COUNT);
+  bool isRendered[FM_OSC_COUNT] = {};
+
+  for (fm_matrix::FMOsc k : fm.order) {
+    if ((Topology & TOPOLOGY_BITS[k]) == 0)
+      continue;
+
+    Oscillator &osc = *oscs[k];
+
+    alignas(16) float phaseIncrements[ENGINE_BLOCK_SIZE];
+    interpolatePitchIncBlock(osc, matrix, PITCH_DESTS[k], pool.glide,
+                             voiceIndex, phaseIncrements, numSamples,
+                             pool.quality);
+
+    // Sum of index * modulator (cycles)
+    alignas(16) float phaseOffsets[ENGINE_BLOCK_SIZE];
+    const float *offsets = nullptr;
+
+    if (fm.isCarrier[k]) {
+      for (size_t s = 0; s < numSamples; s++)
+        phaseOffsets[s] = 0.0f;
+
+      for (uint8_t m = 0; m < FM_OSC_COUNT; m++) {
+        float amount = fm.activeAmounts[m][k] * depth;
+        if (amount == 0.0f || !isRendered[m])
+          continue;
+
+        for (size_t s = 0; s < numSamples; s++)
+          phaseOffsets[s] += rendered[m][s] * amount;
+      }
+      offsets = phaseOffsets;
+    }
+
+    alignas(16) float positions[ENGINE_BLOCK_SIZE];
+    const float *scanPositions = interpolateWavetablePosBlock(
+        osc, matrix, POSITION_DESTS[k], voiceIndex, positions, numSamples);
+
+    oscillator::renderOscillatorBlock(osc, voiceIndex, phaseIncrements,
+                                      offsets, scanPositions, rendered[k],
+                                      numSamples, scratch, pool.quality);
+    isRendered[k] = true;
+
+    float mixLevel = param::ranges::osc::clampMixLevel(
+        osc.mixLevel + matrix.destValues[MIX_DESTS[k]][voiceIndex]);
+    for (size_t s = 0; s < numSamples; s++)
+      output[s] += rendered[k][s] * mixLevel;
+  }
+
+  scratch::releaseScratch(scratch, mark);
+}
+
+// Process enabled Oscillators with interpolation and mix (sum) values
+// Disabled oscillators are skipped entirely (phase holds)
+template <uint32_t Topology>
+void processAndMixOscillators(VoicePool &pool, uint32_t voiceIndex,
+                              float *output, size_t numSamples,
+                              scratch::ScratchArena &scratch) {
+  if (pool.fmMatrix.isActive) {
+    mixFMOscillators<Topology>(pool, voiceIndex, output, numSamples, scratch);
+
+    if constexpr ((Topology & TOPOLOGY_NOISE) != 0)
+      noise::mixNoiseBlock(pool.noise, voiceIndex, output, numSamples);
+
+    for (size_t s = 0; s < numSamples; s++)
+      output[s] *= pool.oscMixGain;
+    return;
+  }
+
+  if constexpr ((Topology & TOPOLOGY_OSC1) != 0)
+    mixOscillator(pool.osc1, pool.modMatrix, ModDest::Osc1Pitch,
+                  ModDest::Osc1Mix, ModDest::Osc1WTPos, pool.glide, voiceIndex,
+                  output, numSamples, scratch, pool.quality);
+
+  if constexpr ((Topology & TOPOLOGY_OSC2) != 0)
+    mixOscillator(pool.osc2, pool.modMatrix, ModDest::Osc2Pitch,
+                  ModDest::Osc2Mix, ModDest::Osc2WTPos, pool.glide, voiceIndex,
+                  output, numSamples, scratch, pool.quality);
+
+  if constexpr ((Topology & TOPOLOGY_OSC3) != 0)
+    mixOscillator(pool.osc3, pool.modMatrix, ModDest::Osc3Pitch,
+                  ModDest::Osc3Mix, ModDest::Osc3WTPos, pool.glide, voiceIndex,
+                  output, numSamples, scratch, pool.quality);
+
+  if constexpr ((Topology & TOPOLOGY_SUB_OSC) != 0)
+    mixOscillator(pool.subOsc, pool.modMatrix, ModDest::SubOscPitch,
+                  ModDest::SubOscMix, ModDest::SubOscWTPos, pool.glide,
+                  voiceIndex, output, numSamples, scratch, pool.quality);
+
+  if constexpr ((Topology & TOPOLOGY_NOISE) != 0)
+    noise::mixNoiseBlock(pool.noise, voiceIndex, output, numSamples);
+
+  for (size_t s = 0; s < numSamples; s++)
+    output[s] *= pool.oscMixGain;
+}
+
+/* ==== Post-mix stages (VoiceStageFn) ====
+ * Each runs over one voice's whole block in place; only the enabled ones
+ * are in VoicePool::voiceStages
+ * Modulation values are constant across the engine block (unrouted cutoff
+ * dests skip the exp2)
+ */
+void processSVFStage(VoicePool &pool, uint32_t voiceIndex, float *buffer,
+                     size_t numSamples, scratch::ScratchArena &) {
+  const ModMatrix &matrix = pool.modMatrix;
+
+  float svfModCutoff =
+      matrix.compiled.isDestRouted[ModDest::SVFCutoff]
+          ? filters::computeEffectiveCutoff(
+                pool.svf.cutoff,
+                matrix.destValues[ModDest::SVFCutoff][voiceIndex],
+                pool.quality)
+          : pool.svf.cutoff;
+  float svfModResonance =
+      pool.svf.resonance +
+      matrix.destValues[ModDest::SVFResonance][voiceIndex];
+
+  // Coefficients once per block (tan), ramped inside the block
+  filters::updateSVFVoiceCoeffs(pool.svf, voiceIndex, svfModCutoff,
+                                svfModResonance, pool.invSampleRate);
+
+  // Recursive per voice, stays scalar (state lives in registers)
+  filters::processSVFilterBlock(pool.svf, buffer, numSamples, voiceIndex);
+}
+
+void processLadderStage(VoicePool &pool, uint32_t voiceIndex, float *buffer,
+                        size_t numSamples, scratch::ScratchArena &scratch) {
+  const ModMatrix &matrix = pool.modMatrix;
+
+  float ladderModCutoff =
+      matrix.compiled.isDestRouted[ModDest::LadderCutoff]
+          ? filters::computeEffectiveCutoff(
+                pool.ladder.cutoff,
+                matrix.destValues[ModDest::LadderCutoff][voiceIndex],
+                pool.quality)
+          : pool.ladder.cutoff;
+  float ladderModResonance =
+      pool.ladder.resonance +
+      matrix.destValues[ModDest::LadderResonance][voiceIndex];
+
+  // Coefficient once per block (sin), ramped inside the block
+  filters::updateLadderVoiceCoeff(pool.ladder, voiceIndex, ladderModCutoff,
+                                  pool.invSampleRate);
+
+  filters::processLadderFilterBlock(pool.ladder, buffer, numSamples,
+                                    voiceIndex, ladderModResonance, scratch,
+                                    pool.quality);
+}
+
+void processSaturatorStage(VoicePool &pool, uint32_t voiceIndex,
+                           float *buffer, size_t numSamples,
+                           scratch::ScratchArena &scratch) {
+  saturator::processSaturatorBlock(pool.saturator, buffer, numSamples,
+                                   voiceIndex, scratch, pool.quality);
+}
+
+void processDCBlockerStage(VoicePool &pool, uint32_t voiceIndex,
+                           float *buffer, size_t numSamples,
+                           scratch::ScratchArena &) {
+  saturator::processDCBlockerBlock(pool.dcBlocker, buffer, numSamples,
+                                   voiceIndex);
 }
 
 /* ==== Post-block: Update prevDestValues with current value ====
  * Will be referenced at the Pre-pass of the next block
- * Active voices only
+ * Active voices and routed interpolated (pitch, position) dests only
  * ============================================================== */
 void postProcessBlock(VoicePool &pool) {
-  for (uint32_t i = 0; i < pool.activeCount; i++) {
-    uint32_t v = pool.activeIndices[i];
-    pool.modMatrix.prevDestValues[ModDest::Osc1Pitch][v] =
-        pool.modMatrix.destValues[ModDest::Osc1Pitch][v];
+  const mod_matrix::CompiledRoutes &compiled = pool.modMatrix.compiled;
+
+  for (uint8_t d = 0; d < compiled.destCount; d++) {
+    const ModDest dest = compiled.dests[d];
+    if (!mod_matrix::isInterpolatedDest(dest))
+      continue;
+
+    for (uint32_t i = 0; i < pool.activeCount; i++) {
+      uint32_t v = pool.activeIndices[i];
+      pool.modMatrix.prevDestValues[dest][v] =
+          pool.modMatrix.destValues[dest][v];
+    }
+  }
+}
+
+// Balance law: unity at center, the far side fades out towards the edge
+// (block-rate, pan/spread are patch params)
+void computePanGains(const VoicePool &pool, uint32_t voiceIndex,
+                     float *panGains) {
+  float position = std::clamp(
+      pool.pan + pool.spread * pool.spreadPositions[voiceIndex], -1.0f, 1.0f);
+  panGains[0] = std::min(1.0f - position, 1.0f);
+  panGains[1] = std::min(1.0f + position, 1.0f);
+}
 
-    pool.modMatrix.prevDestValues[ModDest::Osc2Pitch][v] =
-        pool.modMatrix.destValues[ModDest::Osc2Pitch][v];
+// Fade ramp over _ampEnv_ (in place), false once the fade reached silence
+// (the amp envelope is forced Idle so the voice retires this block)
+bool applyVoiceFade(VoicePool &pool, uint32_t voiceIndex, float *ampEnv,
+                    size_t numSamples) {
+  float gain = pool.fadeGains[voiceIndex];
+  const float step = pool.fadeSteps[voiceIndex];
 
-    pool.modMatrix.prevDestValues[ModDest::Osc3Pitch][v] =
-        pool.modMatrix.destValues[ModDest::Osc3Pitch][v];
+  for (size_t s = 0; s < numSamples; s++) {
+    gain = std::max(gain - step, 0.0f);
+    ampEnv[s] *= gain;
+  }
+  pool.fadeGains[voiceIndex] = gain;
+
+  if (gain > 0.0f)
+    return true;
+
+  pool.ampEnv.states[voiceIndex] = envelope::EnvelopeStatus::Idle;
+  return false;
+}
 
-    pool.modMatrix.prevDestValues[ModDest::SubOscPitch][v] =
-        pool.modMatrix.destValues[ModDest::SubOscPitch][v];
+/* ==== Render a single voice for the whole block ====
+ * Voice-major: every stage runs over the full block for one voice before
+ * moving on, so per-voice state stays in registers and the stateless stages
+ * (pitch ramp, exp2, waveforms, gain) run SIMD across the block.
+ *
+ * One instance per VoiceTopology: disabled sources compile out, disabled
+ * stages aren't in the stage list.
+ * Returns false once the amp envelope went Idle (voice can be retired).
+ * ====================================================================== */
+template <uint32_t Topology>
+bool renderVoiceKernel(VoicePool &pool, uint32_t voiceIndex, float *outputLeft,
+                       float *outputRight, size_t numSamples,
+                       scratch::ScratchArena &scratch) {
+  float *ampEnv = scratch::allocateScratch<float>(scratch, numSamples);
+  float *voiceBuffer = scratch::allocateScratch<float>(scratch, numSamples);
+  for (size_t s = 0; s < numSamples; s++)
+    voiceBuffer[s] = 0.0f;
+
+  // Amp envelope first: it decides how much of the block is audible
+  size_t numAudible = envelope::processEnvelopeBlock(pool.ampEnv, voiceIndex,
+                                                     ampEnv, numSamples);
+  bool isActive =
+      pool.ampEnv.states[voiceIndex] != envelope::EnvelopeStatus::Idle;
+
+  // Process osc1, osc2, osc3, and subOsc
+  // interpolate modulation values and mix
+  processAndMixOscillators<Topology>(pool, voiceIndex, voiceBuffer,
+                                     numAudible, scratch);
+
+  // SVF -> Ladder -> Saturator -> DC blocker (the enabled ones)
+  for (uint32_t i = 0; i < pool.voiceStageCount; i++)
+    pool.voiceStages[i](pool, voiceIndex, voiceBuffer, numAudible, scratch);
+
+  // Governor fade: scale the envelope, retire the voice once silent
+  if (isVoiceFading(pool, voiceIndex) &&
+      !applyVoiceFade(pool, voiceIndex, ampEnv, numAudible))
+    isActive = false;
+
+  // Apply amp envelope, pan into the pool output (one pass, both sides)
+  float velocity = pool.velocities[voiceIndex];
+  float panGains[STEREO_CHANNELS];
+  computePanGains(pool, voiceIndex, panGains);
+
+  for (size_t s = 0; s < numAudible; s++) {
+    float sample = voiceBuffer[s] * ampEnv[s] * velocity * VOICE_GAIN;
+    outputLeft[s] += sample * panGains[0];
+    outputRight[s] += sample * panGains[1];
   }
+
+  return isActive;
+}
+
+// Every topology instantiated at compile time, indexed by VoiceTopology bits
+template <uint32_t... Topologies>
+constexpr std::array<RenderVoiceFn, sizeof...(Topologies)>
+makeRenderKernels(std::integer_sequence<uint32_t, Topologies...>) {
+  return {{&renderVoiceKernel<Topologies>...}};
+}
+
+constexpr auto RENDER_KERNELS = makeRenderKernels(
+    std::make_integer_sequence<uint32_t, TOPOLOGY_COUNT>{});
+
+// Any active voice in a stage faster than _maxIncrement_ (progress/sample)
+bool isEnvelopeFast(const Envelope &env, const VoicePool &pool,
+                    float maxIncrement) {
+  for (uint32_t i = 0; i < pool.activeCount; i++) {
+    float increment = 0.0f;
+    switch (env.states[pool.activeIndices[i]]) {
+    case envelope::EnvelopeStatus::Attack:
+      increment = env.attackIncrement;
+      break;
+    case envelope::EnvelopeStatus::Decay:
+      increment = env.decayIncrement;
+      break;
+    case envelope::EnvelopeStatus::Release:
+      increment = env.releaseIncrement;
+      break;
+    default:
+      continue;
+    }
+
+    if (increment > maxIncrement)
+      return true;
+  }
+  return false;
 }
 
 //==== </Processing Helpers> ====
 } // namespace
 
-void processVoices(VoicePool &pool, float *output, size_t numSamples) {
+bool hasFastModulation(const VoicePool &pool, uint32_t blockLength) {
+  const mod_matrix::CompiledRoutes &compiled = pool.modMatrix.compiled;
+  if (compiled.count == 0 || pool.activeCount == 0)
+    return false;
+
+  bool isSrcRouted[ModSrc::SRC_COUNT] = {};
+  for (uint8_t r = 0; r < compiled.count; r++)
+    isSrcRouted[compiled.routes[r].src] = true;
+
+  // Per-sample change that still gets FAST_MOD_MIN_STEPS blocks
+  float maxIncrement =
+      1.0f / (FAST_MOD_MIN_STEPS * static_cast<float>(blockLength));
+
+  const lfo::LFO *lfos[] = {&pool.lfo1, &pool.lfo2, &pool.lfo3};
+  const ModSrc lfoSrcs[] = {ModSrc::LFO1, ModSrc::LFO2, ModSrc::LFO3};
+  for (size_t k = 0; k < 3; k++) {
+    if (isSrcRouted[lfoSrcs[k]] &&
+        lfos[k]->rate * pool.invSampleRate > maxIncrement)
+      return true;
+  }
+
+  const Envelope *envs[] = {&pool.ampEnv, &pool.filterEnv, &pool.modEnv};
+  const ModSrc envSrcs[] = {ModSrc::AmpEnv, ModSrc::FilterEnv,
+                            ModSrc::ModEnv};
+  for (size_t k = 0; k < 3; k++) {
+    if (isSrcRouted[envSrcs[k]] &&
+        isEnvelopeFast(*envs[k], pool, maxIncrement))
+      return true;
+  }
+
+  return false;
+}
+
+void selectRenderKernel(VoicePool &pool) {
+  pool.renderKernel = RENDER_KERNELS[computeVoiceTopology(pool)];
+
+  uint32_t count = 0;
+  if (pool.svf.enabled)
+    pool.voiceStages[count++] = processSVFStage;
+  if (pool.ladder.enabled)
+    pool.voiceStages[count++] = processLadderStage;
+  if (pool.saturator.enabled)
+    pool.voiceStages[count++] = processSaturatorStage;
+  if (pool.dcBlocker.enabled)
+    pool.voiceStages[count++] = processDCBlockerStage;
+  pool.voiceStageCount = count;
+}
+
+bool renderVoice(VoicePool &pool, uint32_t voiceIndex, float *outputLeft,
+                 float *outputRight, size_t numSamples,
+                 scratch::ScratchArena &scratch) {
+  // Every voice reuses the same bytes
+  scratch::ScratchMark mark = scratch::markScratch(scratch);
+  bool isActive = pool.renderKernel(pool, voiceIndex, outputLeft, outputRight,
+                                    numSamples, scratch);
+  scratch::releaseScratch(scratch, mark);
+
+  return isActive;
+}
+
+void processVoices(VoicePool &pool, float *outputLeft, float *outputRight,
+                   size_t numSamples, scratch::ScratchArena &scratch) {
+  assert(numSamples <= ENGINE_BLOCK_SIZE);
 
   // ==== Set and process Mod Matrix values (per-block) ====
-  preProcessBlock(pool, numSamples);
-
-  // ==== Calculate each sample value (per sample) ====
-  for (uint32_t sampleIndex = 0; sampleIndex < numSamples; sampleIndex++) {
-    float sample = 0.0f;
-
-    // Iterating backwards to more easily deal with swapping voices
-    // that have/will become Idle/inactive after processing
-    for (uint32_t i = pool.activeCount; i > 0; i--) {
-      uint32_t voiceIndex = pool.activeIndices[i - 1];
-
-      // Process osc1, osc2, osc3, and subOsc
-      // interpolate modulation values and mix
-      float mixedOscs = processAndMixOscillators(pool, voiceIndex, sampleIndex);
-
-      // Process SVF with modulation
-      float svfModCutoff = filters::computeEffectiveCutoff(
-          pool.svf.cutoff,
-          pool.modMatrix.destValues[ModDest::SVFCutoff][voiceIndex]);
-      float svfModResonance =
-          pool.svf.resonance +
-          pool.modMatrix.destValues[ModDest::SVFResonance][voiceIndex];
-
-      // Process SVF Filter
-      float filtered = filters::processSVFilter(pool.svf, mixedOscs, voiceIndex,
-                                                svfModCutoff, svfModResonance,
-                                                pool.invSampleRate);
-
-      // Process Ladder with modulation
-      float ladderModCutoff = filters::computeEffectiveCutoff(
-          pool.ladder.cutoff,
-          pool.modMatrix.destValues[ModDest::LadderCutoff][voiceIndex]);
-      float ladderModResonance =
-          pool.ladder.resonance +
-          pool.modMatrix.destValues[ModDest::LadderResonance][voiceIndex];
-      // Process Ladder Filter
-      filtered = filters::processLadderFilter(
-          pool.ladder, filtered, voiceIndex, ladderModCutoff,
-          ladderModResonance, pool.invSampleRate);
-
-      // TODO(nico): Implement Saturator
-      // ==== Apply saturation ====
-      // filtered = processSaturator(pool.saturator, filtered);
-
-      // Process Amp Envelope
-      float ampEnv = envelope::processEnvelope(pool.ampEnv, voiceIndex);
-
-      // Check if amplitude envelope completed - remove immediately
-      if (pool.ampEnv.states[voiceIndex] == envelope::EnvelopeStatus::Idle) {
-        removeInactiveIndex(pool, voiceIndex);
-        // No index adjustment needed - iterating backwards
-      }
+  preProcessBlock(pool, numSamples, scratch);
 
-      sample += filtered * ampEnv * pool.velocities[voiceIndex] * VOICE_GAIN;
-    }
+  // ==== Patch topology -> render kernel (once per block) ====
+  selectRenderKernel(pool);
+
+  for (size_t s = 0; s < numSamples; s++) {
+    outputLeft[s] = 0.0f;
+    outputRight[s] = 0.0f;
+  }
 
-    // TODO(nico): Basic soft clip for now.
-    // Mainly for protection and not as an effect
-    output[sampleIndex] = dsp::effects::softClipFast(sample * pool.masterGain);
+  // ==== Render each voice for the whole block (voice-major) ====
+  if (pool.workers && pool.activeCount >= PARALLEL_MIN_VOICES) {
+    renderVoicesParallel(*pool.workers, pool, outputLeft, outputRight,
+                         numSamples, scratch);
+  } else {
+    for (uint32_t i = pool.activeCount; i > 0; i--)
+      renderVoice(pool, pool.activeIndices[i - 1], outputLeft, outputRight,
+                  numSamples, scratch);
+  }
+
+  // ==== Retire voices that went Idle during this block ====
+  // Iterating backwards to more easily deal with swapping voices
+  for (uint32_t i = pool.activeCount; i > 0; i--) {
+    uint32_t voiceIndex = pool.activeIndices[i - 1];
+
+    if (pool.ampEnv.states[voiceIndex] == envelope::EnvelopeStatus::Idle) {
+      removeInactiveIndex(pool, voiceIndex);
+      // No index adjustment needed - iterating backwards
+    }
   }
 
   // Increment modulation phases
@@ -1,8 +1,16 @@
 #pragma once
 
+#include "Controllers.h"
 #include "Envelope.h"
+#include "FMMatrix.h"
 #include "Filters.h"
+#include "Glide.h"
+#include "LFO.h"
+#include "Noise.h"
 #include "Oscillator.h"
+#include "Saturator.h"
+#include "ScratchArena.h"
+#include "Tuning.h"
 #include "Types.h"
 
 #include "dsp/Waveforms.h"
@@ -21,6 +29,47 @@ using Oscillator = oscillator::Oscillator;
 
 using ModMatrix = mod_matrix::ModMatrix;
 
+struct VoiceWorkers;
+struct VoicePool;
+
+// Per-topology voice renderer (see selectRenderKernel)
+using RenderVoiceFn = bool (*)(VoicePool &pool, uint32_t voiceIndex,
+                               float *outputLeft, float *outputRight,
+                               size_t numSamples,
+                               scratch::ScratchArena &scratch);
+
+/* One post-mix stage over a voice's whole block, in place (see
+ * selectRenderKernel): SVF, ladder, saturator, DC blocker
+ */
+using VoiceStageFn = void (*)(VoicePool &pool, uint32_t voiceIndex,
+                              float *buffer, size_t numSamples,
+                              scratch::ScratchArena &scratch);
+inline constexpr uint32_t MAX_VOICE_STAGES = 4;
+
+// Sentinel for "no voice" in the allocation lists below
+inline constexpr uint32_t NO_VOICE = MAX_VOICES;
+inline constexpr uint32_t NUM_MIDI_NOTES = 128;
+inline constexpr uint32_t VOICE_MASK_WORDS = (MAX_VOICES + 63) / 64;
+
+// Doubly linked list threaded through per-voice link arrays
+struct VoiceList {
+  uint32_t head = NO_VOICE; // oldest
+  uint32_t tail = NO_VOICE; // newest
+};
+
+struct VoiceLinks {
+  uint32_t prev[MAX_VOICES];
+  uint32_t next[MAX_VOICES];
+};
+
+// Note-on behavior (VoicePool::voiceMode)
+// - Poly: a voice per note
+// - Mono: one voice, every note retriggers the envelopes (from their level)
+// - Legato: one voice, overlapping notes keep the envelopes going
+// Mono and Legato retarget the playing voice (no re-initialization) and
+// glide to the new note; a released key returns to the last held one
+enum class VoiceMode : int8_t { Poly, Mono, Legato, MODE_COUNT };
+
 static constexpr OscConfig SUB_OSC_DEFAULT = {WaveformType::Sine, 0.5f, -2,
                                               0.0f, true};
 
@@ -32,25 +81,85 @@ struct VoicePoolConfig {
 
   float masterGain = 1.0f;
   float sampleRate = 48000.0f;
+
+  QualityMode quality = QualityMode::Live;
 };
 
 // VoicePool - top-level container (universal synth)
+// Layout: render state first, then the modules (each with its hot per-voice
+// arrays first), allocation bookkeeping (noteOn/noteOff only) last
 struct VoicePool {
+  // ==== Render state (hot: read every block) ====
+  uint32_t activeCount = 0;
+
+  // Render kernel for the current topology (selectRenderKernel)
+  RenderVoiceFn renderKernel = nullptr;
+
+  // Enabled post-mix stages in chain order (selectRenderKernel)
+  VoiceStageFn voiceStages[MAX_VOICE_STAGES] = {};
+  uint32_t voiceStageCount = 0;
+
+  // Parallel rendering (optional, not owned)
+  // nullptr = render every voice on the audio thread
+  VoiceWorkers *workers = nullptr;
+
+  float sampleRate;
+  float invSampleRate;
+
+  // Audio thread writes it at block boundaries only (setQualityMode posts)
+  QualityMode quality = QualityMode::Live;
+
+  // Reduce gain for multiple oscillators
+  // TODO(nico): this needs to be tide to number of active oscs
+  float oscMixGain = 1.0f / 4.0;
+
+  float masterGain = 1.0f; // range [0.0 - 2.0]
+                           // range [-inf - +6DB]
+
+  // Stereo placement (balance law: centered voices are unity on both sides)
+  // - pan: every voice, [-1 (left), 1 (right)]
+  // - spread: scales each voice's spreadPositions offset, [0, 1]
+  float pan = 0.0f;
+  float spread = 0.0f;
+
+  // Dense array of active indices
+  alignas(CACHE_LINE_SIZE) uint32_t activeIndices[MAX_VOICES];
+
+  // Note-on velocity (0.0-1.0), per voice
+  alignas(CACHE_LINE_SIZE) float velocities[MAX_VOICES];
+
+  // Offset from _pan_ at full spread [-1, 1], dealt out at note-on so
+  // consecutive notes alternate sides
+  alignas(CACHE_LINE_SIZE) float spreadPositions[MAX_VOICES];
+
+  // MPE bend/pressure/slide + note-on channel, per voice
+  controllers::NoteExpression expression;
+
+  // Portamento of retargeted (mono/legato) voices
+  glide::Glide glide;
+
+  // Forced fade out (stolen by the voice governor), see fadeOutVoice
+  // fadeSteps == 0: not fading (fadeGains unused)
+  alignas(CACHE_LINE_SIZE) float fadeGains[MAX_VOICES];
+  float fadeSteps[MAX_VOICES]; // gain drop per sample
+
   // ==== Oscillators (3 main + sub oscillator) ====
   Oscillator osc1;
   Oscillator osc2;
   Oscillator osc3;
   Oscillator subOsc = oscillator::createOscillator(SUB_OSC_DEFAULT);
 
-  // Reduce gain for multiple oscillators
-  // TODO(nico): this needs to be tide to number of active oscs
-  float oscMixGain = 1.0f / 4.0;
-
-  // TODO(nico) ==== Noise Generator ====
-  // NoiseGenerator noise;
+  // ==== Noise Generator ====
+  noise::NoiseGenerator noise;
 
   ModMatrix modMatrix;
 
+  // ==== MIDI controllers (mod sources) ====
+  controllers::Controllers controllers;
+
+  // ==== FM / PM between the oscillators ====
+  fm_matrix::FMMatrix fmMatrix;
+
   // ==== Envelopes ====
   Envelope ampEnv;    // Amplitude envelope
   Envelope filterEnv; // Filter modulation
@@ -60,55 +169,145 @@ struct VoicePool {
   filters::SVFilter svf;
   filters::LadderFilter ladder;
 
-  // TODO(nico)
-  // // ====  LFOs (3 for modulation) ====
-  // LFO lfo1;
-  // LFO lfo2;
-  // LFO lfo3;
+  // ====  LFOs (3 for modulation) ====
+  lfo::LFO lfo1;
+  lfo::LFO lfo2;
+  lfo::LFO lfo3;
 
-  // TODO(nico)
-  // // ==== Effects ====
-  // Saturator saturator;
+  // ==== Saturation (after the filters) ====
+  saturator::Saturator saturator;
+  saturator::DCBlocker dcBlocker;
 
-  float masterGain = 1.0f; // range [0.0 - 2.0]
-                           // range [-inf - +6DB]
+  // ==== Tuning (cold: read by updatePitchTables) ====
+  // Unmapped keys don't start a voice
+  tuning::Tuning tuning;
 
-  // ==== Voice metadata ====
-  uint8_t midiNotes[MAX_VOICES];    // Which MIDI note (0-127)
-  float velocities[MAX_VOICES];     // Note-on velocity (0.0-1.0)
-  uint32_t noteOnTimes[MAX_VOICES]; // NoteOn counter ( 1 is older than 2)
-  uint8_t isActive[MAX_VOICES];     // 1 = active, 0 = free
+  // ==== Mono / legato (cold: noteOn/noteOff) ====
+  int8_t voiceMode = static_cast<int8_t>(VoiceMode::Poly);
+  uint32_t monoVoice = NO_VOICE;
 
-  float sampleRate;
-  float invSampleRate;
+  // Keys held in mono modes, oldest first (the last one sounds)
+  uint8_t heldNotes[NUM_MIDI_NOTES];
+  uint32_t heldNoteCount = 0;
 
-  // ==== Active voice tracking ====
-  uint32_t activeCount = 0;
-  uint32_t activeIndices[MAX_VOICES]; // Dense array of active indices
+  // ==== Voice metadata (cold: noteOn/noteOff) ====
+  alignas(CACHE_LINE_SIZE) uint8_t midiNotes[MAX_VOICES]; // Note (0-127)
+  uint32_t noteOnTimes[MAX_VOICES];     // NoteOn counter ( 1 is older than 2)
+  uint8_t isActive[MAX_VOICES];         // 1 = active, 0 = free
+  uint32_t activePositions[MAX_VOICES]; // voice -> slot in activeIndices
+
+  // ==== O(1) allocation (see resetVoiceAllocator) ====
+  uint64_t freeMask[VOICE_MASK_WORDS]; // bit set = voice is free
+
+  // Active voices in noteOn order (head = steal candidate)
+  VoiceList ageList;
+  VoiceLinks ageLinks;
+
+  // Held (not yet released) voices per MIDI note, oldest first
+  VoiceList noteLists[NUM_MIDI_NOTES];
+  VoiceLinks noteLinks;
+  uint8_t isNoteHeld[MAX_VOICES];
+
+  // Allocation counters (published by the engine, see EngineTelemetry)
+  uint32_t stealCount = 0;      // allocateVoiceIndex took a sounding voice
+  uint32_t peakActiveCount = 0; // most voices active at once
 };
 
 // updating existing Engine member
 void updateVoicePoolConfig(VoicePool &pool, const VoicePoolConfig &config);
 
-// Find free or oldest voice index for voice Initialization
+// Rebuild every oscillator's note increments from the tuning + sample rate
+// (octave/detune params, a new tuning or sample rate)
+void updatePitchTables(VoicePool &pool);
+
+// Mark every voice free and clear the active/age/note lists
+void resetVoiceAllocator(VoicePool &pool);
+
+// Find free (lowest index) or oldest voice index for voice Initialization
 uint32_t allocateVoiceIndex(VoicePool &pool);
 
 // Initial voice state for noteOn event
 void initializeVoice(VoicePool &pool, uint32_t index, uint8_t midiNote,
-                     float velocity, uint32_t noteOnTime, float sampleRate);
+                     float velocity, uint32_t noteOnTime, float sampleRate,
+                     uint8_t channel = 0);
 
-// Trigger envelope release for voice playing midiNote
-void releaseVoice(VoicePool &pool, uint8_t midiNote);
+/* Trigger envelope release for voice playing midiNote (the oldest one on
+ * _channel_ first: MPE can hold one note number on several channels)
+ * Mono modes: while other keys are held the voice glides back to the last
+ * one instead
+ */
+void releaseVoice(VoicePool &pool, uint8_t midiNote, uint8_t channel = 0);
 
-// Add newly active voice (noteOn)
+// Add newly active voice (noteOn), after initializeVoice
 void addActiveIndex(VoicePool &pool, uint32_t voiceIndex);
 
-// Remove an inactive voice (noteOff)
+// Retire a voice (went Idle or stolen) and return it to the free mask
 void removeInactiveIndex(VoicePool &pool, uint32_t voiceIndex);
 
-void processVoices(VoicePool &pool, float *output, size_t numSamples);
+/* Ramp an active voice to silence over _numSamples_, then retire it
+ * - declick for voices cut before their release ends (voice governor)
+ * - the voice stops answering its noteOff right away
+ */
+void fadeOutVoice(VoicePool &pool, uint32_t voiceIndex, uint32_t numSamples);
+
+inline bool isVoiceFading(const VoicePool &pool, uint32_t voiceIndex) {
+  return pool.fadeSteps[voiceIndex] != 0.0f;
+}
+
+// Block temporaries (mod sources, voice buffers) come from _scratch_, the
+// calling thread's arena; worker threads render from their own
+// Overwrites both channels
+void processVoices(VoicePool &pool, float *outputLeft, float *outputRight,
+                   size_t numSamples, scratch::ScratchArena &scratch);
+
+/* True when a routed mod source moves too fast for a _blockLength_ control
+ * rate (steps would be audible), checked over the active voices:
+ * - LFOs: fewer than FAST_MOD_MIN_STEPS blocks per cycle
+ * - envelopes: a voice in attack/decay/release shorter than
+ *   FAST_MOD_MIN_STEPS blocks
+ * Noise and controllers don't count (noise is stepped by design,
+ * controllers are smoothed)
+ */
+inline constexpr float FAST_MOD_MIN_STEPS = 32.0f;
+bool hasFastModulation(const VoicePool &pool, uint32_t blockLength);
+
+/* Pick the render kernel for the enabled oscillators and build the
+ * post-mix stage list (SVF -> ladder -> saturator -> DC blocker, enabled
+ * ones only)
+ * - done by processVoices every block (and by updateVoicePoolConfig), so
+ *   patch changes and toggled modules take effect at the next block
+ * - kernels are template instances, stages a short call list: disabled
+ *   modules cost nothing, not even a per-sample branch
+ */
+void selectRenderKernel(VoicePool &pool);
+
+/* Scratch bytes renderVoice can hold at once, per ENGINE_BLOCK_SIZE block
+ * (counted as if every oscillator's unison buffers stayed live):
+ * - unison: 4 oscillators x 4 buffers x MAX_UNISON lanes
+ * - FM rendered outputs: FM_OSC_COUNT
+ * - amp envelope + voice buffer: 2
+ * - drive path oversampling (filters, saturator): 2 + MAX_FACTOR + dry 1
+ */
+inline constexpr size_t VOICE_SCRATCH_WORST_BYTES =
+    sizeof(float) * ENGINE_BLOCK_SIZE *
+    (4 * 4 * oscillator::MAX_UNISON + fm_matrix::FM_OSC_COUNT + 2 +
+     (2 + dsp::oversampling::MAX_FACTOR + 1));
+
+/* Render a single voice for the whole block and ADD into both outputs
+ * - runs the kernel picked by selectRenderKernel
+ * - mono up to the amp stage, panned into L/R by the final gain pass
+ * - only touches voiceIndex's state (safe to run voices concurrently)
+ * - returns false once the amp envelope went Idle
+ * - temporaries come from _scratch_ (released before returning)
+ * NOTE: numSamples must be <= ENGINE_BLOCK_SIZE
+ */
+bool renderVoice(VoicePool &pool, uint32_t voiceIndex, float *outputLeft,
+                 float *outputRight, size_t numSamples,
+                 scratch::ScratchArena &scratch);
 
+// Poly: allocate + initialize a voice. Mono/Legato: retarget the playing
+// voice when there is one (see VoiceMode)
 void handleNoteOn(VoicePool &pool, uint8_t midiNote, float velocity,
-                  uint32_t noteOnTime, float sampleRate);
+                  uint32_t noteOnTime, float sampleRate, uint8_t channel = 0);
 
 } // namespace synth::voices
@@ -0,0 +1,305 @@
+#include "VoiceWorkers.h"
+#include "VoicePool.h"
+
+#include "synth_io/RtAudit.h"
+#include "synth_io/Trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#include <mach/mach_time.h>
+#include <mach/thread_policy.h>
+#include <pthread.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace synth::voices {
+
+namespace {
+// ==== <Worker Helpers> ====
+
+// ==== Job word: (generation << 32) | (count << 16) | next ====
+constexpr uint64_t FIELD_MASK = 0xFFFF;
+
+uint64_t packJob(uint32_t generation, uint32_t count) {
+  return (static_cast<uint64_t>(generation) << 32) |
+         (static_cast<uint64_t>(count & FIELD_MASK) << 16);
+}
+
+uint32_t jobGeneration(uint64_t job) { return static_cast<uint32_t>(job >> 32); }
+uint32_t jobCount(uint64_t job) {
+  return static_cast<uint32_t>((job >> 16) & FIELD_MASK);
+}
+uint32_t jobNext(uint64_t job) { return static_cast<uint32_t>(job & FIELD_MASK); }
+
+// Claim the next unrendered entry of pool.activeIndices (false = none left)
+bool claimVoice(VoiceWorkers &workers, uint32_t &listIndex,
+                uint32_t &generation) {
+  uint64_t job = workers.job.load(std::memory_order_acquire);
+
+  while (jobNext(job) < jobCount(job)) {
+    if (workers.job.compare_exchange_weak(job, job + 1,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
+      listIndex = jobNext(job);
+      generation = jobGeneration(job);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void cpuRelax() {
+#if defined(__SSE2__) || defined(_M_X64)
+  _mm_pause();
+#elif defined(__aarch64__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+// Spin briefly (next engine block usually follows immediately), then back off
+// so idle workers don't burn a core between audio callbacks
+void idleBackoff(uint32_t idleSpins) {
+  if (idleSpins < 256)
+    cpuRelax();
+  else if (idleSpins < 1024)
+    std::this_thread::yield();
+  else
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+// Best effort: same class of scheduling as the audio callback thread
+void setRealtimePriority(float sampleRate, uint32_t numFrames) {
+#if defined(__APPLE__)
+  mach_timebase_info_data_t timebase;
+  mach_timebase_info(&timebase);
+
+  double ticksPerNs = static_cast<double>(timebase.denom) /
+                      static_cast<double>(timebase.numer);
+  double periodNs = static_cast<double>(numFrames) /
+                    static_cast<double>(sampleRate) * 1.0e9;
+
+  thread_time_constraint_policy_data_t policy;
+  policy.period = static_cast<uint32_t>(periodNs * ticksPerNs);
+  policy.computation = static_cast<uint32_t>(periodNs * 0.5 * ticksPerNs);
+  policy.constraint = policy.period;
+  policy.preemptible = 1;
+
+  thread_policy_set(pthread_mach_thread_np(pthread_self()),
+                    THREAD_TIME_CONSTRAINT_POLICY,
+                    reinterpret_cast<thread_policy_t>(&policy),
+                    THREAD_TIME_CONSTRAINT_POLICY_COUNT);
+#else
+  (void)sampleRate;
+  (void)numFrames;
+
+  // Usually needs privileges; stays a normal thread otherwise
+  sched_param param{};
+  param.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+  pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+#endif
+}
+
+void leaveThreadHooks(VoiceWorkerSlot &slot) {
+  if (slot.leave && slot.membership)
+    slot.leave(slot.membership);
+
+  slot.leave = nullptr;
+  slot.membership = nullptr;
+}
+
+// Worker thread, between voices (never while rendering)
+void applyThreadHooks(VoiceWorkers &workers, VoiceWorkerSlot &slot) {
+  WorkerThreadHooks hooks{};
+  {
+    std::lock_guard<std::mutex> lock(workers.hooksMutex);
+    hooks = workers.hooks;
+    slot.hooksGeneration =
+        workers.hooksGeneration.load(std::memory_order_relaxed);
+  }
+
+  leaveThreadHooks(slot);
+
+  if (hooks.join) {
+    slot.membership = hooks.join(hooks.context);
+    slot.leave = hooks.leave;
+  }
+}
+
+void workerLoop(VoiceWorkers &workers, VoiceWorkerSlot &slot) {
+  setRealtimePriority(workers.sampleRate, workers.numFrames);
+  synth_io::trace::setTraceThreadName("voice worker");
+
+  uint32_t idleSpins = 0;
+
+  while (workers.isRunning.load(std::memory_order_relaxed)) {
+    if (workers.hooksGeneration.load(std::memory_order_acquire) !=
+        slot.hooksGeneration)
+      applyThreadHooks(workers, slot);
+
+    uint32_t listIndex = 0;
+    uint32_t generation = 0;
+
+    if (!claimVoice(workers, listIndex, generation)) {
+      idleBackoff(idleSpins++);
+      continue;
+    }
+    idleSpins = 0;
+
+    // Payload is safe to read: the audio thread can't publish the next job
+    // until this voice completes
+    if (workers.task) {
+      synth_io::rt_audit::ScopedRtSection rtSection;
+      SYNTH_TRACE_SCOPE("runTask");
+      workers.task(workers.taskContext, listIndex);
+
+      workers.completedCount.fetch_add(1, std::memory_order_release);
+      continue;
+    }
+
+    VoicePool &pool = *workers.pool;
+    size_t numSamples = workers.numSamples;
+
+    // First voice of this block for this worker
+    if (slot.bufferGeneration != generation) {
+      for (size_t s = 0; s < numSamples; s++) {
+        slot.buffers[0][s] = 0.0f;
+        slot.buffers[1][s] = 0.0f;
+      }
+      slot.bufferGeneration = generation;
+    }
+
+    {
+      // Real-time while rendering only (idle backoff sleeps)
+      synth_io::rt_audit::ScopedRtSection rtSection;
+      SYNTH_TRACE_SCOPE("renderVoice");
+      renderVoice(pool, pool.activeIndices[listIndex], slot.buffers[0],
+                  slot.buffers[1], numSamples, slot.scratch);
+    }
+
+    workers.completedCount.fetch_add(1, std::memory_order_release);
+  }
+
+  leaveThreadHooks(slot);
+}
+
+// ==== </Worker Helpers> ====
+} // namespace
+
+VoiceWorkers *createVoiceWorkers(uint32_t numWorkers, float sampleRate,
+                                 uint32_t numFrames) {
+  auto *workers = new VoiceWorkers();
+
+  workers->numWorkers =
+      numWorkers < MAX_VOICE_WORKERS ? numWorkers : MAX_VOICE_WORKERS;
+  workers->sampleRate = sampleRate;
+  workers->numFrames = numFrames;
+  workers->isRunning.store(true);
+
+  for (uint32_t i = 0; i < workers->numWorkers; i++) {
+    VoiceWorkerSlot &slot = workers->slots[i];
+    slot.scratch = scratch::createScratchArena(scratch::VOICE_SCRATCH_BYTES);
+    slot.thread = std::thread(workerLoop, std::ref(*workers), std::ref(slot));
+  }
+
+  return workers;
+}
+
+void disposeVoiceWorkers(VoiceWorkers *workers) {
+  if (!workers)
+    return;
+
+  workers->isRunning.store(false);
+
+  for (uint32_t i = 0; i < workers->numWorkers; i++) {
+    if (workers->slots[i].thread.joinable())
+      workers->slots[i].thread.join();
+
+    scratch::disposeScratchArena(workers->slots[i].scratch);
+  }
+
+  delete workers;
+}
+
+void setWorkerThreadHooks(VoiceWorkers &workers,
+                          const WorkerThreadHooks &hooks) {
+  std::lock_guard<std::mutex> lock(workers.hooksMutex);
+  workers.hooks = hooks;
+  workers.hooksGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void renderVoicesParallel(VoiceWorkers &workers, VoicePool &pool,
+                          float *outputLeft, float *outputRight,
+                          size_t numSamples, scratch::ScratchArena &scratch) {
+  uint32_t count = pool.activeCount;
+
+  // ==== Publish job ====
+  uint32_t generation = ++workers.generation;
+  workers.pool = &pool;
+  workers.numSamples = numSamples;
+  workers.task = nullptr;
+  workers.completedCount.store(0, std::memory_order_relaxed);
+  workers.job.store(packJob(generation, count), std::memory_order_release);
+
+  // ==== Help out (the audio thread renders straight into the outputs) ====
+  uint32_t listIndex = 0;
+  uint32_t claimedGeneration = 0;
+  while (claimVoice(workers, listIndex, claimedGeneration)) {
+    renderVoice(pool, pool.activeIndices[listIndex], outputLeft, outputRight,
+                numSamples, scratch);
+    workers.completedCount.fetch_add(1, std::memory_order_release);
+  }
+
+  // ==== Wait for voices still in flight (bounded by one voice render) ====
+  while (workers.completedCount.load(std::memory_order_acquire) < count)
+    cpuRelax();
+
+  // ==== Sum worker scratch buffers ====
+  for (uint32_t i = 0; i < workers.numWorkers; i++) {
+    const VoiceWorkerSlot &slot = workers.slots[i];
+    if (slot.bufferGeneration != generation)
+      continue;
+
+    for (size_t s = 0; s < numSamples; s++) {
+      outputLeft[s] += slot.buffers[0][s];
+      outputRight[s] += slot.buffers[1][s];
+    }
+  }
+}
+
+void runTasksParallel(VoiceWorkers &workers, uint32_t count,
+                      WorkerTaskFn task, void *context) {
+  // ==== Publish job ====
+  uint32_t generation = ++workers.generation;
+  workers.task = task;
+  workers.taskContext = context;
+  workers.completedCount.store(0, std::memory_order_relaxed);
+  workers.job.store(packJob(generation, count), std::memory_order_release);
+
+  // ==== Help out ====
+  uint32_t index = 0;
+  uint32_t claimedGeneration = 0;
+  while (claimVoice(workers, index, claimedGeneration)) {
+    task(context, index);
+    workers.completedCount.fetch_add(1, std::memory_order_release);
+  }
+
+  // ==== Wait for tasks still in flight (bounded by one task) ====
+  while (workers.completedCount.load(std::memory_order_acquire) < count)
+    cpuRelax();
+}
+
+} // namespace synth::voices
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "ScratchArena.h"
+#include "Types.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace synth::voices {
+struct VoicePool;
+
+/* Optional worker pool for rendering voices (or other independent work,
+ * see runTasksParallel) in parallel
+ *
+ * The audio thread publishes a job (one word: generation | count | next) and
+ * then renders voices itself alongside the workers. Voices are claimed one at
+ * a time with a CAS on that word, so a worker that is asleep or late simply
+ * claims nothing and the audio thread picks up the slack.
+ *
+ * Each worker renders into its own scratch buffer (temporaries from its own
+ * arena); the audio thread sums those once every claimed voice has completed.
+ *
+ * NOTE: no locks, allocation or syscalls on the audio thread. Only the
+ * workers ever yield/sleep (while idle).
+ */
+inline constexpr uint32_t MAX_VOICE_WORKERS = 15;
+
+// Below this many active voices the handoff costs more than it saves
+inline constexpr uint32_t PARALLEL_MIN_VOICES = 8;
+
+/* Host hooks run on every worker thread (e.g. joining the audio device's
+ * workgroup)
+ * - each worker calls join on its own thread when the hooks change (and
+ *   leave, with what join returned, before the next join or exiting)
+ */
+using WorkerJoinHook = void *(*)(void *context);
+using WorkerLeaveHook = void (*)(void *membership);
+
+struct WorkerThreadHooks {
+  WorkerJoinHook join = nullptr;
+  WorkerLeaveHook leave = nullptr;
+  void *context = nullptr;
+};
+
+// Task _index_ of a runTasksParallel job (any worker, or the audio thread)
+using WorkerTaskFn = void (*)(void *context, uint32_t index);
+
+struct VoiceWorkerSlot {
+  alignas(64) float buffers[STEREO_CHANNELS][ENGINE_BLOCK_SIZE];
+
+  // Generation the buffers were last cleared for. Written by the worker
+  // before completing a voice, read by the audio thread after all voices
+  // of that generation completed
+  uint32_t bufferGeneration = 0;
+
+  // Voice render temporaries (only ever touched by this worker)
+  scratch::ScratchArena scratch;
+
+  // Worker only: hooks applied to this thread (see WorkerThreadHooks)
+  uint32_t hooksGeneration = 0;
+  WorkerLeaveHook leave = nullptr;
+  void *membership = nullptr;
+
+  std::thread thread;
+};
+
+struct VoiceWorkers {
+  // (generation << 32) | (count << 16) | next
+  alignas(64) std::atomic<uint64_t> job{0};
+  alignas(64) std::atomic<uint32_t> completedCount{0};
+  alignas(64) std::atomic<bool> isRunning{false};
+
+  // Job payload (written before publishing _job_, read after claiming)
+  // _task_ set: a runTasksParallel job, otherwise voices of _pool_
+  VoicePool *pool = nullptr;
+  size_t numSamples = 0;
+  uint32_t generation = 0;
+  WorkerTaskFn task = nullptr;
+  void *taskContext = nullptr;
+
+  // Real-time scheduling hint for workers (one render chunk: the engine's
+  // render rate and maxFrames)
+  float sampleRate = 48000.0f;
+  uint32_t numFrames = 512;
+
+  // Bumped by setWorkerThreadHooks; workers only lock _hooksMutex_ (while
+  // idle) when it changed
+  alignas(64) std::atomic<uint32_t> hooksGeneration{0};
+  std::mutex hooksMutex;
+  WorkerThreadHooks hooks;
+
+  uint32_t numWorkers = 0;
+  VoiceWorkerSlot slots[MAX_VOICE_WORKERS];
+};
+
+// Spawns _numWorkers_ threads (clamped to MAX_VOICE_WORKERS)
+// _sampleRate_/_numFrames_: the engine's render rate and maxFrames
+// NOTE: call before the audio session starts, NOT on the audio thread
+VoiceWorkers *createVoiceWorkers(uint32_t numWorkers, float sampleRate,
+                                 uint32_t numFrames);
+
+// Joins and deletes workers (audio session must be stopped)
+void disposeVoiceWorkers(VoiceWorkers *workers);
+
+// Any non-real-time thread. Workers pick the hooks up asynchronously
+// (empty hooks: leave only)
+void setWorkerThreadHooks(VoiceWorkers &workers,
+                          const WorkerThreadHooks &hooks);
+
+/* Render every active voice of _pool_ across the workers (audio thread)
+ * - accumulates into both outputs (caller zeroes them)
+ * - voices claimed by the audio thread render from _scratch_
+ * - does NOT retire idle voices; that stays on the audio thread
+ */
+void renderVoicesParallel(VoiceWorkers &workers, VoicePool &pool,
+                          float *outputLeft, float *outputRight,
+                          size_t numSamples, scratch::ScratchArena &scratch);
+
+/* Run task(context, 0..count-1) across the workers (audio thread)
+ * - same claiming as voices: the calling thread runs tasks too, returns
+ *   once every task completed
+ * - tasks write their own outputs (nothing is summed)
+ * NOTE: count must fit the job word (< 65536)
+ */
+void runTasksParallel(VoiceWorkers &workers, uint32_t count,
+                      WorkerTaskFn task, void *context);
+
+} // namespace synth::voices
@@ -1,11 +1,22 @@
 #include "InputProcessor.h"
+#include "MidiLearn.h"
+#include "PresetLibrary.h"
+#include "ScriptHost.h"
+#include "TapRecorder.h"
+#include "WavetableImporter.h"
 
 #include "synth/Engine.h"
 #include "synth/ModMatrix.h"
 #include "synth/ParamBindings.h"
+#include "synth/Patch.h"
+#include "synth/Tuning.h"
 
+#include "synth_io/RtAudit.h"
 #include "synth_io/SynthIO.h"
+#include "synth_io/Trace.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cstdint>
 #include <cstdio>
@@ -24,55 +35,205 @@ namespace pb = param::bindings;
 // ==== Internal Helpers ====
 namespace {
 
-// Parse input string and update param value
-int setInputParam(std::istringstream &iss, s_io::hSynthSession session) {
-  std::string paramName;
-  float paramValue;
+// Live recording (record command), one at a time
+TapRecorder tapRecorder{};
 
-  iss >> paramName;
+// Scripted events (script command), one script at a time
+ScriptHost scriptHost{};
+GenerativeScript generativeScript{};
+
+// Preset browsing (preset open/list/next/prev/recall)
+PresetLibrary presetLibrary{};
+
+// WAV imports (wavetable command), opened on first use
+WavetableImporter wavetableImporter{};
+
+std::string getWavetableCacheDirectory() {
+  const char *home = getenv("HOME");
+  return std::string(home ? home : ".") + "/.cache/meh-synth/wavetables";
+}
+
+// osc1|osc2|osc3|sub -> FMOsc (FM_OSC_COUNT = unknown)
+fm_matrix::FMOsc parseOscName(const std::string &name) {
+  const char *names[fm_matrix::FM_OSC_COUNT] = {"osc1", "osc2", "osc3", "sub"};
+  for (uint8_t k = 0; k < fm_matrix::FM_OSC_COUNT; k++) {
+    if (name == names[k])
+      return static_cast<fm_matrix::FMOsc>(k);
+  }
+  return fm_matrix::FM_OSC_COUNT;
+}
+
+void printRecall(const PresetLibrary &library, size_t index,
+                 PresetRecall recall) {
+  if (recall == PresetRecall::Invalid) {
+    printf("Error: No preset %zu\n", index);
+    return;
+  }
+
+  const patch::PresetInfo &info = library.entries[index].info;
+  printf("%zu: %s%s\n", index, info.name,
+         recall == PresetRecall::Loading ? " (loading)" : "");
+}
+
+// Library forms of the preset command ("preset save|load" are files)
+void parsePresetLibraryCommand(const std::string &action,
+                               std::istringstream &iss, Engine &engine) {
+  if (action == "open" || action == "rescan") {
+    std::string directory;
+    iss >> directory;
+    if (directory.empty()) {
+      printf("Usage: preset %s <directory>\n", action.c_str());
+      return;
+    }
+
+    if (openPresetLibrary(presetLibrary, engine, directory,
+                          action == "rescan"))
+      printf("%zu presets in %s\n", presetLibrary.entries.size(),
+             directory.c_str());
+    return;
+  }
+
+  if (!isPresetLibraryOpen(presetLibrary)) {
+    printf("No preset library (preset open <directory> first)\n");
+    return;
+  }
+
+  if (action == "list") {
+    std::string category;
+    iss >> category;
+    printPresetLibrary(presetLibrary,
+                       category.empty() ? nullptr : category.c_str());
+    return;
+  }
+
+  int64_t index = getFocusedPreset(presetLibrary);
+  if (action == "next")
+    index++;
+  else if (action == "prev")
+    index = index > 0 ? index - 1 : 0;
+  else if (action == "recall")
+    iss >> index;
+  else {
+    printf("Usage: preset open|rescan|list|next|prev|recall\n");
+    return;
+  }
+
+  if (index < 0)
+    index = 0;
+  auto entry = static_cast<size_t>(index);
+  printRecall(presetLibrary, entry, recallPreset(presetLibrary, entry));
+}
+
+// <param> [lin|exp|log] [min max] (the tail of midi learn/map)
+bool parseMidiTarget(std::istringstream &iss, const Engine &engine,
+                     MidiLearn &midiLearn, int channel, int cc) {
+  std::string paramName;
+  std::string token;
+  iss >> paramName >> token;
 
   pb::ParamMapping param = pb::findParamByName(paramName.c_str());
-  if (param.id == param::bindings::PARAM_COUNT) {
+  if (param.id == pb::PARAM_COUNT) {
     printf("Error: Unknown parameter '%s'\n", paramName.c_str());
-    return 1;
+    return false;
   }
 
-  // Check if param is setting waveformType (string)
-  switch (param.type) {
-  // Set Oscillator Waveform
-  case pb::ParamValueType::WAVEFORM: {
-    std::string value;
-    iss >> value;
+  MidiCurve curve = MidiCurve::Linear;
+  std::string minValue;
+  if (parseMidiCurve(token.c_str(), curve))
+    iss >> minValue;
+  else
+    minValue = token;
+
+  std::string maxValue;
+  iss >> maxValue;
+
+  // No range: the param's whole range
+  float min = 0.0f;
+  float max = 0.0f;
+  if (!minValue.empty() && !maxValue.empty()) {
+    min = pb::parseParamValue(param.type, minValue.c_str());
+    max = pb::parseParamValue(param.type, maxValue.c_str());
+  }
+
+  if (cc < 0)
+    return learnMidiMapping(midiLearn, engine, param.id, curve, min, max);
+
+  return mapMidiCC(midiLearn, engine, static_cast<uint8_t>(channel - 1),
+                   static_cast<uint8_t>(cc), param.id, curve, min, max);
+}
 
-    auto waveformType = pb::getWaveformType(value.c_str());
-    paramValue = static_cast<float>(waveformType);
+// MIDI learn: knob -> param mappings (resolved on the MIDI thread)
+void parseMidiCommand(std::istringstream &iss, const Engine &engine,
+                      MidiLearn &midiLearn) {
+  std::string action;
+  iss >> action;
+
+  if (action == "learn") {
+    if (parseMidiTarget(iss, engine, midiLearn, 0, -1))
+      printf("Move a knob to map it\n");
+
+  } else if (action == "map") {
+    int channel = 0;
+    int cc = -1;
+    iss >> channel >> cc;
+    if (channel < 1 || channel > static_cast<int>(MIDI_CHANNEL_COUNT) ||
+        cc < 0 || cc >= static_cast<int>(MIDI_CC_COUNT)) {
+      printf("Usage: midi map <channel 1-16> <cc 0-127> <param> [curve] "
+             "[min max]\n");
+      return;
+    }
 
-  } break;
+    if (parseMidiTarget(iss, engine, midiLearn, channel, cc))
+      printf("OK\n");
+    else
+      printf("Error: Unable to map (%u mappings max)\n", MAX_MIDI_MAPPINGS);
+
+  } else if (action == "unmap") {
+    int channel = 0;
+    int cc = -1;
+    iss >> channel >> cc;
+    if (channel < 1 || channel > static_cast<int>(MIDI_CHANNEL_COUNT) ||
+        !unmapMidiCC(midiLearn, static_cast<uint8_t>(channel - 1),
+                     static_cast<uint8_t>(std::max(cc, 0)))) {
+      printf("Error: No mapping for ch %d cc %d\n", channel, cc);
+      return;
+    }
+    printf("OK\n");
 
-  // Enable/Disable Item
-  case pb::ParamValueType::BOOL: {
-    std::string value;
-    iss >> value;
+  } else if (action == "cancel") {
+    cancelMidiLearn(midiLearn);
 
-    paramValue = strcasecmp(value.c_str(), "true") == 0 ? 1.0f : 0.0f;
+  } else if (action == "clear") {
+    clearMidiMappings(midiLearn);
+    printf("OK\n");
 
-  } break;
+  } else if (action == "list") {
+    printMidiMappings(midiLearn);
 
-  // Set SVF Mode
-  case pb::ParamValueType::FILTER_MODE: {
-    std::string value;
-    iss >> value;
+  } else {
+    printf("Usage: midi learn|map|unmap|cancel|clear|list\n");
+  }
+}
 
-    auto filterMode = pb::getSVFModeType(value.c_str());
-    paramValue = static_cast<float>(filterMode);
+// Parse input string and update param value
+int setInputParam(std::istringstream &iss, s_io::hSynthSession session) {
+  std::string paramName;
+  float paramValue;
 
-  } break;
+  iss >> paramName;
 
-  // Treat all other params values as floats (denormalized)
-  default:
-    iss >> paramValue;
+  pb::ParamMapping param = pb::findParamByName(paramName.c_str());
+  if (param.id == param::bindings::PARAM_COUNT) {
+    printf("Error: Unknown parameter '%s'\n", paramName.c_str());
+    return 1;
   }
 
+  // Waveform/bool/filter mode values are strings, the rest are floats
+  std::string value;
+  iss >> value;
+
+  paramValue = pb::parseParamValue(param.type, value.c_str());
+
   /*
    * NOTE(nico): User is entering denormalized value and param is stored
    * denormalized.  May consider normalizing in the future, but seems
@@ -86,10 +247,17 @@ int setInputParam(std::istringstream &iss, s_io::hSynthSession session) {
   return 0;
 }
 
+void printQueueTelemetry(const char *name,
+                         const s_io::QueueTelemetry &queue) {
+  printf("%s queue: high-water %u / %u | dropped %llu\n", name,
+         queue.highWater, queue.capacity,
+         static_cast<unsigned long long>(queue.droppedCount));
+}
+
 } // namespace
 
 void parseCommand(const std::string &line, Engine &engine,
-                  s_io::hSynthSession session) {
+                  s_io::hSynthSession session, MidiLearn &midiLearn) {
   std::istringstream iss(line);
   std::string cmd;
   iss >> cmd;
@@ -132,19 +300,335 @@ void parseCommand(const std::string &line, Engine &engine,
     printf("  set <param> <value>  - Set parameter value\n");
     printf("  get <param>          - Query parameter value\n");
     printf("  list                 - List all parameters\n");
+    printf("  load [reset]         - Show (or reset) DSP load stats\n");
+    printf("  latency [reset]      - Show (or reset) key-to-sound latency "
+           "(--latency-probe)\n");
+    printf("  stats [reset]        - Show (or reset) event queue + voice "
+           "counters\n");
+    printf("  rt                   - Show real-time audit violations\n");
+    printf("  trace [file]         - Save recent audio thread trace (JSON)\n");
+    printf("  record <file>|stop   - Record the output to a WAV file\n");
+    printf("  script gen [bpm] [root]|stop - Run a generative sequence "
+           "(off the audio thread)\n");
+    printf("  preset save|load <f> - Save/load every param + mod route\n");
+    printf("  preset open <dir>    - Browse a preset library (then list, "
+           "next, prev, recall <n>)\n");
+    printf("  wavetable <osc> <f>  - Load a WAV table (osc1-3|sub, played "
+           "with waveform wavetable)\n");
+    printf("  tuning <scl> [kbm]   - Retune (Scala scale + keyboard map), "
+           "tuning reset = 12-TET\n");
+    printf("  midi learn <param>   - Map the next knob moved to a param "
+           "([lin|exp|log] [min max])\n");
+    printf("  midi list|clear      - Show/remove MIDI mappings (also map, "
+           "unmap, cancel)\n");
     printf("  help                 - Show this help\n");
     printf("  quit                 - Exit\n");
     printf("\nNote commands: a-k (play notes)\n");
 
+    // LOAD: print callback timing vs buffer deadline
+  } else if (cmd == "load") {
+    std::string option;
+    iss >> option;
+
+    if (option == "reset") {
+      s_io::resetDspLoadStats(session);
+      printf("OK\n");
+      return;
+    }
+
+    s_io::DspLoadStats stats = s_io::getDspLoadStats(session);
+    printf("DSP load: avg %.1f%% | last %.1f%% | peak %.1f%%\n",
+           stats.averageLoad * 100.0f, stats.lastLoad * 100.0f,
+           stats.peakLoad * 100.0f);
+    printf("Overruns: %u / %llu callbacks\n", stats.overrunCount,
+           static_cast<unsigned long long>(stats.callbackCount));
+
+    s_io::OutputLatency latency = s_io::getOutputLatency(session);
+    printf("Output: %u frame buffer | %.1f ms latency (device %u, safety "
+           "%u frames)\n",
+           latency.bufferFrames, latency.totalSeconds * 1000.0,
+           latency.deviceFrames, latency.safetyOffsetFrames);
+
+    const governor::VoiceGovernor &gov = engine.governor;
+    if (gov.enabled) {
+      printf("Voices: cap %u / %u | stolen %u | culled %u\n",
+             gov.voiceCap.load(std::memory_order_relaxed), POLYPHONY,
+             gov.stolenCount.load(std::memory_order_relaxed),
+             gov.culledCount.load(std::memory_order_relaxed));
+    }
+
+    // LATENCY: note input -> first audible output sample (--latency-probe)
+  } else if (cmd == "latency") {
+    std::string option;
+    iss >> option;
+
+    if (option == "reset") {
+      s_io::resetLatencyStats(session);
+      printf("OK\n");
+      return;
+    }
+
+    s_io::LatencyStats stats = s_io::getLatencyStats(session);
+    printf("Latency: %u notes | %u masked | %u timed out\n", stats.count,
+           stats.maskedCount, stats.timeoutCount);
+    if (stats.count == 0) {
+      printf("No notes measured (start with --latency-probe, play single "
+             "notes)\n");
+      return;
+    }
+
+    printf("  min %.2f | mean %.2f | p50 %.2f | p90 %.2f | p99 %.2f | max "
+           "%.2f ms\n",
+           stats.minMs, stats.meanMs, stats.p50Ms, stats.p90Ms, stats.p99Ms,
+           stats.maxMs);
+    printf("  queued %.2f ms (input -> callback)\n", stats.meanQueueMs);
+
+    // STATS: queue drops/high-water marks, events per callback, voices
+  } else if (cmd == "stats") {
+    std::string option;
+    iss >> option;
+
+    if (option == "reset") {
+      s_io::resetEventTelemetry(session);
+      resetEngineTelemetry(engine);
+      printf("OK\n");
+      return;
+    }
+
+    s_io::EventTelemetry events = s_io::getEventTelemetry(session);
+    printQueueTelemetry("Note", events.noteQueue);
+    printQueueTelemetry("Param", events.paramQueue);
+    printQueueTelemetry("Batch", events.batchQueue);
+    printf("Events: %llu over %llu callbacks | last %u | peak %u per "
+           "callback\n",
+           static_cast<unsigned long long>(events.eventCount),
+           static_cast<unsigned long long>(events.callbackCount),
+           events.lastCallbackEvents, events.peakCallbackEvents);
+
+    EngineTelemetry voices = getEngineTelemetry(engine);
+    printf("Voices: %u active | peak %u / %u | stolen %u (note-on) + %u "
+           "(governor) | culled %u\n",
+           voices.activeVoices, voices.peakActiveVoices, POLYPHONY,
+           voices.voiceSteals, voices.governorSteals, voices.governorCulls);
+    printf("Scheduled: peak %u / %u per buffer | overflowed %u\n",
+           voices.peakScheduledEvents, Engine::MAX_SCHEDULED_EVENTS,
+           voices.scheduleOverflows);
+
+    // RT: audio thread allocations/locks/blocking calls (RT_AUDIT builds)
+  } else if (cmd == "rt") {
+#if SYNTH_RT_AUDIT
+    s_io::rt_audit::printRtViolations(stdout);
+#else
+    printf("Real-time audit is off (build with make rt-audit)\n");
+#endif
+
+    // TRACE: last few seconds of trace scopes as Chrome trace JSON
+  } else if (cmd == "trace") {
+    std::string path;
+    iss >> path;
+    if (path.empty())
+      path = "trace.json";
+
+    if (!s_io::trace::requestTraceDump(path.c_str())) {
+      printf("Tracing is off (build with TRACE=1)\n");
+      return;
+    }
+
+    s_io::trace::TraceStats stats = s_io::trace::getTraceStats();
+    printf("Saving %u events from %u threads (%llu dropped)\n",
+           stats.historyCount, stats.threadCount,
+           static_cast<unsigned long long>(stats.droppedCount));
+
+    // RECORD: stream the output to a WAV file (output tap, off-thread)
+  } else if (cmd == "record") {
+    std::string target;
+    iss >> target;
+
+    if (target.empty() || target == "stop") {
+      if (!isTapRecording(tapRecorder))
+        printf("Not recording\n");
+      stopTapRecorder(tapRecorder);
+      return;
+    }
+
+    if (isTapRecording(tapRecorder)) {
+      printf("Already recording (record stop first)\n");
+      return;
+    }
+
+    if (!startTapRecorder(tapRecorder, session, target,
+                          static_cast<uint32_t>(engine.outputSampleRate))) {
+      printf("Error: Unable to record to '%s'\n", target.c_str());
+      return;
+    }
+    printf("Recording to %s\n", target.c_str());
+
+    // SCRIPT: events placed ahead on the stream clock by the script host
+  } else if (cmd == "script") {
+    std::string name;
+    iss >> name;
+
+    if (name.empty() || name == "stop") {
+      if (!isScriptRunning(scriptHost)) {
+        printf("No script running\n");
+        return;
+      }
+      stopScriptHost(scriptHost);
+      printf("Stopped %s (%llu late blocks)\n", scriptHost.script.name,
+             static_cast<unsigned long long>(
+                 scriptHost.lateBlocks.load(std::memory_order_relaxed)));
+      return;
+    }
+
+    if (name != "gen") {
+      printf("Usage: script gen [bpm] [root note]|stop\n");
+      return;
+    }
+
+    if (isScriptRunning(scriptHost)) {
+      printf("Already running %s (script stop first)\n",
+             scriptHost.script.name);
+      return;
+    }
+
+    // Failed extraction zeroes the value: read tokens, keep the defaults
+    std::string tempoArg;
+    std::string rootArg;
+    iss >> tempoArg >> rootArg;
+    float tempo = tempoArg.empty() ? engine.tempo
+                                    : std::strtof(tempoArg.c_str(), nullptr);
+    int rootNote = rootArg.empty() ? 48 : std::atoi(rootArg.c_str());
+
+    Script script = makeGenerativeScript(
+        generativeScript, tempo,
+        static_cast<uint8_t>(std::clamp(rootNote, 0, 127)));
+    startScriptHost(scriptHost, session, script, engine.outputSampleRate);
+    printf("Running %s at %.0f bpm\n", script.name,
+           static_cast<double>(generativeScript.tempo));
+
+    // PRESET: whole patch in one file, loads swap in at a block boundary
+  } else if (cmd == "preset") {
+    std::string action;
+    iss >> action;
+
+    if (action != "save" && action != "load") {
+      parsePresetLibraryCommand(action, iss, engine);
+      return;
+    }
+
+    std::string path;
+    iss >> path;
+    if (path.empty()) {
+      printf("Usage: preset save <file> [category] [tags] | load <file>\n");
+      return;
+    }
+
+    if (action == "save") {
+      // Name = file name (set by the library scan), category/tags optional
+      patch::PresetInfo info{};
+      std::string category;
+      std::string tags;
+      iss >> category >> tags;
+      std::snprintf(info.category, sizeof(info.category), "%s",
+                    category.c_str());
+      std::snprintf(info.tags, sizeof(info.tags), "%s", tags.c_str());
+
+      if (!patch::savePresetFile(engine, path.c_str(), &info)) {
+        printf("Error: Unable to save '%s'\n", path.c_str());
+        return;
+      }
+      printf("Saved %s\n", path.c_str());
+      return;
+    }
+
+    // Built here (coefficients included), the audio thread only copies it
+    patch::Patch *loaded = patch::loadPresetFile(engine, path.c_str());
+    if (!loaded)
+      return;
+
+    patch::postPatch(engine, loaded);
+    printf("Loaded %s\n", path.c_str());
+
+    // TUNING: tables built here, swapped in with a patch (note-on = lookup)
+  } else if (cmd == "tuning") {
+    std::string sclPath;
+    std::string kbmPath;
+    iss >> sclPath >> kbmPath;
+
+    if (sclPath.empty()) {
+      printf("Tuning: %s\n", engine.voicePool.tuning.name);
+      return;
+    }
+
+    tuning::Tuning retuned{};
+    if (sclPath == "reset") {
+      tuning::initEqualTemperament(retuned);
+    } else {
+      tuning::ScalaScale scale{};
+      tuning::KeyboardMapping mapping{};
+      if (!tuning::loadScalaFile(sclPath.c_str(), scale) ||
+          (!kbmPath.empty() &&
+           !tuning::loadKeyboardMappingFile(kbmPath.c_str(), mapping)))
+        return;
+
+      if (!tuning::buildTuning(scale, mapping, retuned)) {
+        printf("Error: unusable tuning (reference note unmapped?)\n");
+        return;
+      }
+    }
+
+    patch::postTuning(engine, retuned);
+    printf("Tuning: %s\n", retuned.name[0] ? retuned.name : sclPath.c_str());
+
+    // WAVETABLE: imported/mapped off this thread, swapped at a block boundary
+  } else if (cmd == "wavetable") {
+    std::string oscName;
+    std::string path;
+    iss >> oscName >> path;
+
+    fm_matrix::FMOsc osc = parseOscName(oscName);
+    if (osc == fm_matrix::FM_OSC_COUNT || path.empty()) {
+      printf("Usage: wavetable osc1|osc2|osc3|sub <file.wav>\n");
+      return;
+    }
+
+    if (!isWavetableImporterOpen(wavetableImporter) &&
+        !openWavetableImporter(wavetableImporter, engine,
+                               getWavetableCacheDirectory())) {
+      printf("Error: Unable to create the wavetable cache\n");
+      return;
+    }
+
+    requestWavetable(wavetableImporter, path, osc);
+
   } else if (cmd == "clear") {
     // Clear console
     system("clear");
 
+  } else if (cmd == "midi") {
+    parseMidiCommand(iss, engine, midiLearn);
+
   } else if (cmd == "mod") {
-    mm::parseModCommand(iss, engine.voicePool.modMatrix);
+    // Edits a copy of the current patch, the audio thread swaps it in at
+    // the next block (the live matrix is read mid-block)
+    patch::Patch *edited = patch::capturePatch(engine);
+    if (mm::parseModCommand(iss, edited->routes, edited->routeCount)) {
+      patch::buildPatch(engine, *edited);
+      patch::postPatch(engine, edited);
+    } else {
+      patch::disposePatch(edited);
+    }
+
+  } else if (cmd == "quit") {
+    // The tap goes away with the session: finish the file first
+    stopTapRecorder(tapRecorder);
+    stopScriptHost(scriptHost);
+    closePresetLibrary(presetLibrary);
+    // Tables stay mapped: the audio thread may still be playing them
+    stopWavetableImporter(wavetableImporter);
 
     // Invalid command
-  } else if (cmd != "quit") {
+  } else {
     std::cout << "Invalid command: " << cmd << std::endl;
     printf("Enter 'help' for list of valid commands.\n");
   }
@@ -11,8 +11,10 @@ namespace synth {
 struct Engine;
 
 namespace utils {
+struct MidiLearn;
+
 void parseCommand(const std::string &line, Engine &engine,
-                  synth_io::hSynthSession session);
+                  synth_io::hSynthSession session, MidiLearn &midiLearn);
 
 } // namespace utils
 
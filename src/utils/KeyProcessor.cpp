@@ -1,5 +1,6 @@
 #include "KeyProcessor.h"
 #include "Logger.h"
+#include "MidiLearn.h"
 
 #include "synth_io/Events.h"
 #include "synth_io/SynthIO.h"
@@ -10,7 +11,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
-#include <iostream>
+#include <cstdlib>
+#include <cstring>
 
 namespace synth::utils {
 using MidiEvent = device_io::MidiEvent;
@@ -18,17 +20,82 @@ using MidiEvent = device_io::MidiEvent;
 using NoteEvent = synth_io::NoteEvent;
 using NoteEventType = synth_io::NoteEventType;
 
+// MPE "slide" (third expression dimension)
+static constexpr uint8_t MPE_SLIDE_CC = 74;
+
+// midiCallback's context (set once by initMidiSession)
+struct MidiInputContext {
+  hSynthSession session = nullptr;
+  MidiLearn *midiLearn = nullptr;
+};
+static MidiInputContext midiInputContext{};
+
+// Controller 0-127 -> [0, 1]
+static float toUnit(uint8_t value) {
+  return static_cast<float>(value) / 127.0f;
+}
+
+// MPE lane of _channel_ (CONTROLLER_NOTE_* base + channel)
+static void setNoteExpression(hSynthSession sessionPtr, uint16_t lane,
+                              uint8_t channel, float value) {
+  synth_io::setController(sessionPtr,
+                          static_cast<uint16_t>(lane + (channel & 0x0F)),
+                          value);
+}
+
 // Handle MIDI device events
 static void midiCallback(MidiEvent midiEvent, void *context) {
-  auto sessionPtr = static_cast<hSynthSession>(context);
-
+  auto *input = static_cast<MidiInputContext *>(context);
+  hSynthSession sessionPtr = input->session;
+  uint8_t channel = midiEvent.channel;
+
+  /* Controllers are coalesced, never queued per message. Channel messages
+   * feed both the channel-wide source and the channel's MPE lane (voices
+   * hear the lane of the channel their note came in on)
+   */
   // TODO(nico): handle more than just note on/off events
   switch (midiEvent.type) {
   case MidiEvent::Type::NoteOn:
-    synth_io::noteOn(sessionPtr, midiEvent.data1, midiEvent.data2);
+    synth_io::noteOn(sessionPtr, midiEvent.data1, midiEvent.data2, channel);
     break;
   case MidiEvent::Type::NoteOff:
-    synth_io::noteOff(sessionPtr, midiEvent.data1, midiEvent.data2);
+    synth_io::noteOff(sessionPtr, midiEvent.data1, midiEvent.data2, channel);
+    break;
+
+  case MidiEvent::Type::ControlChange:
+    // Learned knobs go straight to their param (resolved + scaled here)
+    if (processMidiCC(*input->midiLearn, sessionPtr, channel, midiEvent.data1,
+                      midiEvent.data2))
+      break;
+
+    synth_io::setController(
+        sessionPtr,
+        static_cast<uint16_t>(synth_io::CONTROLLER_CC + midiEvent.data1),
+        toUnit(midiEvent.data2));
+
+    if (midiEvent.data1 == MPE_SLIDE_CC)
+      setNoteExpression(sessionPtr, synth_io::CONTROLLER_NOTE_SLIDE, channel,
+                        toUnit(midiEvent.data2));
+    break;
+  case MidiEvent::Type::PitchBend: {
+    float bend = static_cast<float>(midiEvent.pitchBendValue) / 8192.0f;
+    synth_io::setController(sessionPtr, synth_io::CONTROLLER_PITCH_BEND, bend);
+    setNoteExpression(sessionPtr, synth_io::CONTROLLER_NOTE_BEND, channel,
+                      bend);
+    break;
+  }
+  case MidiEvent::Type::ChannelPressure:
+    synth_io::setController(sessionPtr, synth_io::CONTROLLER_CHANNEL_PRESSURE,
+                            toUnit(midiEvent.data1));
+    setNoteExpression(sessionPtr, synth_io::CONTROLLER_NOTE_PRESSURE, channel,
+                      toUnit(midiEvent.data1));
+    break;
+  case MidiEvent::Type::Aftertouch:
+    synth_io::setController(
+        sessionPtr,
+        static_cast<uint16_t>(synth_io::CONTROLLER_POLY_PRESSURE +
+                              midiEvent.data1),
+        toUnit(midiEvent.data2));
     break;
 
   default:
@@ -65,47 +132,66 @@ static void keyEventCallback(device_io::KeyEvent event, void *userContext) {
   }
 }
 
-hMidiSession initMidiSession(hSynthSession sessionPtr) {
-  // 1a. Setup MIDI on this thread's run loop for now
+// Index, otherwise a display name substring (nullptr: every source)
+static bool isMidiSourceWanted(const device_io::MidiSource &source,
+                               size_t index, const char *sourceName) {
+  if (!sourceName)
+    return true;
+
+  char *end = nullptr;
+  unsigned long wantedIndex = std::strtoul(sourceName, &end, 10);
+  if (end != sourceName && *end == '\0')
+    return wantedIndex == index;
+
+  return std::strstr(source.displayName, sourceName) != nullptr;
+}
+
+hMidiSession initMidiSession(hSynthSession sessionPtr, MidiLearn &midiLearn,
+                             const char *sourceName) {
   constexpr size_t MAX_MIDI_DEVICES = 16;
   device_io::MidiSource midiSourceBuffer[MAX_MIDI_DEVICES];
   size_t numMidiDevices =
       device_io::getMidiSources(midiSourceBuffer, MAX_MIDI_DEVICES);
 
-  hMidiSession midiSession = nullptr;
-
-  if (numMidiDevices) {
-    // Display MIDI source options
-    for (size_t i = 0; i < numMidiDevices; i++) {
-      printf("%ld. %s\n", i, midiSourceBuffer[i].displayName);
-    }
-
-    uint32_t srcIndex;
-    LogF("Enter midi device number: ");
-    std::cin >> srcIndex;
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-    if (srcIndex < 0 || srcIndex >= numMidiDevices) {
-      printf("Invalid option selected: %d", srcIndex);
-      return midiSession;
-    }
+  if (!numMidiDevices) {
+    synth::utils::LogF("No MIDI devices found\n");
+    return nullptr;
+  }
 
-    midiSession = device_io::setupMidiSession({}, midiCallback, sessionPtr);
+  midiInputContext.session = sessionPtr;
+  midiInputContext.midiLearn = &midiLearn;
+  hMidiSession midiSession =
+      device_io::setupMidiSession({}, midiCallback, &midiInputContext);
 
-    device_io::connectMidiSource(midiSession,
-                                 midiSourceBuffer[srcIndex].uniqueID);
+  size_t numConnected = 0;
+  for (size_t i = 0; i < numMidiDevices; i++) {
+    if (!isMidiSourceWanted(midiSourceBuffer[i], i, sourceName))
+      continue;
 
-    device_io::startMidiSession(midiSession);
+    device_io::connectMidiSource(midiSession, midiSourceBuffer[i].uniqueID);
+    printf("MIDI: %zu. %s\n", i, midiSourceBuffer[i].displayName);
+    numConnected++;
+  }
 
-  } else {
-    synth::utils::LogF("No MIDI devices found\n");
+  if (!numConnected) {
+    printf("MIDI: no source matches '%s'\n", sourceName);
+    device_io::cleanupMidiSession(midiSession);
+    return nullptr;
   }
 
+  device_io::startMidiSession(midiSession);
   return midiSession;
 }
 
-int startKeyInputCapture(hSynthSession sessionPtr,
-                         hMidiSession midiSessionPtr) {
+void disposeMidiSession(hMidiSession midiSessionPtr) {
+  if (!midiSessionPtr)
+    return;
+
+  device_io::stopMidiSession(midiSessionPtr);
+  device_io::cleanupMidiSession(midiSessionPtr);
+}
+
+int startKeyInputCapture(hSynthSession sessionPtr) {
   printf("KeyCapture Example\n");
   printf("------------------\n");
   printf("Press keys to see events. ESC to quit.\n\n");
@@ -157,11 +243,6 @@ int startKeyInputCapture(hSynthSession sessionPtr,
   // 5. Cleanup
   device_io::stopKeyCapture();
 
-  if (midiSessionPtr) {
-    device_io::stopMidiSession(midiSessionPtr);
-    device_io::cleanupMidiSession(midiSessionPtr);
-  }
-
   printf("Done.\n");
   return 0;
 }
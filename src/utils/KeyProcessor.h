@@ -14,9 +14,23 @@ namespace synth::utils {
 using hMidiSession = device_io::MidiSession *;
 using hSynthSession = synth_io::SynthSession *;
 
-hMidiSession initMidiSession(hSynthSession);
+struct MidiLearn;
 
-int startKeyInputCapture(hSynthSession, hMidiSession);
+/* Connects the MIDI sources matching _sourceName_ (an index or a name
+ * substring, nullptr = every source), no prompt: safe on a background
+ * thread while audio is already running
+ * - learned CCs (_midiLearn_) are resolved on the MIDI thread, the rest are
+ *   forwarded as notes/controllers. _midiLearn_ must outlive the session
+ * Returns nullptr when no source is connected
+ */
+hMidiSession initMidiSession(hSynthSession, MidiLearn &midiLearn,
+                             const char *sourceName = nullptr);
+
+// Stops + frees it (nullptr: no-op)
+void disposeMidiSession(hMidiSession);
+
+// Runs the key capture loop (blocks until it is stopped)
+int startKeyInputCapture(hSynthSession);
 
 uint8_t asciiToMidi(char key);
 } // namespace synth::utils
@@ -0,0 +1,228 @@
+#include "MidiLearn.h"
+
+#include "synth/Engine.h"
+#include "synth/ParamBindings.h"
+
+#include "synth_io/SynthIO.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace synth::utils {
+namespace pb = param::bindings;
+
+// ==== <Mapping Helpers> ====
+namespace {
+
+float applyCurve(MidiCurve curve, float x) {
+  switch (curve) {
+  case MidiCurve::Exponential:
+    return x * x;
+  case MidiCurve::Logarithmic:
+    return 1.0f - (1.0f - x) * (1.0f - x);
+  case MidiCurve::Linear:
+    break;
+  }
+  return x;
+}
+
+// Range checks + the value table (terminal thread, no lock needed)
+bool buildMidiMapping(const Engine &engine, ParamID id, MidiCurve curve,
+                      float min, float max, MidiMapping &mapping) {
+  if (id < 0 || id >= ParamID::PARAM_COUNT)
+    return false;
+
+  const ParamBinding &binding = engine.paramBindings[id];
+  if (min == max) {
+    min = binding.min;
+    max = binding.max;
+  }
+
+  mapping.paramID = id;
+  mapping.curve = curve;
+  mapping.min = std::clamp(min, binding.min, binding.max);
+  mapping.max = std::clamp(max, binding.min, binding.max);
+
+  // Exponential over a positive range: equal ratios per CC step
+  bool isGeometric = curve == MidiCurve::Exponential && mapping.min > 0.0f &&
+                     mapping.max > 0.0f;
+  float ratio = isGeometric ? mapping.max / mapping.min : 1.0f;
+
+  for (uint32_t v = 0; v < MIDI_CC_COUNT; v++) {
+    float x = static_cast<float>(v) / static_cast<float>(MIDI_CC_COUNT - 1);
+
+    mapping.values[v] =
+        isGeometric ? mapping.min * std::pow(ratio, x)
+                    : mapping.min +
+                          applyCurve(curve, x) * (mapping.max - mapping.min);
+  }
+
+  return true;
+}
+
+// learn.mutex held. Returns false when the table is full
+bool insertMapping(MidiLearn &learn, const MidiMapping &mapping) {
+  uint8_t &slot = learn.slots[mapping.channel][mapping.cc];
+  if (slot == 0) {
+    if (learn.mappingCount >= MAX_MIDI_MAPPINGS)
+      return false;
+    slot = static_cast<uint8_t>(++learn.mappingCount);
+  }
+
+  learn.mappings[slot - 1] = mapping;
+  return true;
+}
+
+// learn.mutex held: swap the last mapping into the hole
+void removeMapping(MidiLearn &learn, uint8_t slot) {
+  MidiMapping &removed = learn.mappings[slot - 1];
+  learn.slots[removed.channel][removed.cc] = 0;
+
+  uint32_t last = --learn.mappingCount;
+  if (slot - 1u == last)
+    return;
+
+  removed = learn.mappings[last];
+  learn.slots[removed.channel][removed.cc] = slot;
+}
+
+const char *getCurveName(MidiCurve curve) {
+  switch (curve) {
+  case MidiCurve::Exponential:
+    return "exp";
+  case MidiCurve::Logarithmic:
+    return "log";
+  case MidiCurve::Linear:
+    break;
+  }
+  return "lin";
+}
+
+} // namespace
+// ==== </Mapping Helpers> ====
+
+bool mapMidiCC(MidiLearn &learn, const Engine &engine, uint8_t channel,
+               uint8_t cc, ParamID id, MidiCurve curve, float min,
+               float max) {
+  if (channel >= MIDI_CHANNEL_COUNT || cc >= MIDI_CC_COUNT)
+    return false;
+
+  MidiMapping mapping{};
+  if (!buildMidiMapping(engine, id, curve, min, max, mapping))
+    return false;
+
+  mapping.channel = channel;
+  mapping.cc = cc;
+
+  std::lock_guard<std::mutex> lock(learn.mutex);
+  return insertMapping(learn, mapping);
+}
+
+bool learnMidiMapping(MidiLearn &learn, const Engine &engine, ParamID id,
+                      MidiCurve curve, float min, float max) {
+  MidiMapping mapping{};
+  if (!buildMidiMapping(engine, id, curve, min, max, mapping))
+    return false;
+
+  std::lock_guard<std::mutex> lock(learn.mutex);
+  learn.pending = mapping;
+  learn.isLearning = true;
+  return true;
+}
+
+void cancelMidiLearn(MidiLearn &learn) {
+  std::lock_guard<std::mutex> lock(learn.mutex);
+  learn.isLearning = false;
+}
+
+bool unmapMidiCC(MidiLearn &learn, uint8_t channel, uint8_t cc) {
+  if (channel >= MIDI_CHANNEL_COUNT || cc >= MIDI_CC_COUNT)
+    return false;
+
+  std::lock_guard<std::mutex> lock(learn.mutex);
+  uint8_t slot = learn.slots[channel][cc];
+  if (slot == 0)
+    return false;
+
+  removeMapping(learn, slot);
+  return true;
+}
+
+void clearMidiMappings(MidiLearn &learn) {
+  std::lock_guard<std::mutex> lock(learn.mutex);
+  std::memset(learn.slots, 0, sizeof(learn.slots));
+  learn.mappingCount = 0;
+  learn.isLearning = false;
+}
+
+bool processMidiCC(MidiLearn &learn, synth_io::hSynthSession session,
+                   uint8_t channel, uint8_t cc, uint8_t value) {
+  if (channel >= MIDI_CHANNEL_COUNT || cc >= MIDI_CC_COUNT)
+    return false;
+
+  bool isLearned = false;
+  ParamID id = ParamID::PARAM_COUNT;
+  float paramValue = 0.0f;
+  {
+    std::lock_guard<std::mutex> lock(learn.mutex);
+
+    if (learn.isLearning) {
+      learn.pending.channel = channel;
+      learn.pending.cc = cc;
+      isLearned = insertMapping(learn, learn.pending);
+      learn.isLearning = false;
+    }
+
+    uint8_t slot = learn.slots[channel][cc];
+    if (slot == 0)
+      return false;
+
+    const MidiMapping &mapping = learn.mappings[slot - 1];
+    id = mapping.paramID;
+    paramValue = mapping.values[value % MIDI_CC_COUNT];
+  }
+
+  synth_io::storeParam(session, static_cast<uint8_t>(id), paramValue);
+
+  if (isLearned)
+    printf("Learned: ch %u cc %u -> %s\n", channel + 1u, cc,
+           pb::getParamName(id));
+  return true;
+}
+
+void printMidiMappings(MidiLearn &learn) {
+  std::lock_guard<std::mutex> lock(learn.mutex);
+
+  if (learn.mappingCount == 0)
+    printf("No MIDI mappings\n");
+
+  for (uint32_t i = 0; i < learn.mappingCount; i++) {
+    const MidiMapping &mapping = learn.mappings[i];
+    printf("ch %2u cc %3u -> %-24s %s %.2f - %.2f\n", mapping.channel + 1u,
+           mapping.cc, pb::getParamName(mapping.paramID),
+           getCurveName(mapping.curve), static_cast<double>(mapping.min),
+           static_cast<double>(mapping.max));
+  }
+
+  if (learn.isLearning)
+    printf("Learning: %s (move a knob)\n",
+           pb::getParamName(learn.pending.paramID));
+}
+
+bool parseMidiCurve(const char *name, MidiCurve &curve) {
+  const MidiCurve curves[] = {MidiCurve::Linear, MidiCurve::Exponential,
+                              MidiCurve::Logarithmic};
+  for (MidiCurve candidate : curves) {
+    if (strcmp(name, getCurveName(candidate)) == 0) {
+      curve = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace synth::utils
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "synth/ParamBindings.h"
+
+#include <cstdint>
+#include <mutex>
+
+namespace synth {
+struct Engine;
+}
+
+namespace synth_io {
+struct SynthSession;
+using hSynthSession = SynthSession *;
+} // namespace synth_io
+
+namespace synth::utils {
+using ParamID = param::bindings::ParamID;
+
+/* MIDI learn: hardware knobs (channel + CC) -> params
+ * - resolved on the MIDI input thread: a slot lookup, then the param value
+ *   comes from the mapping's table (one entry per CC value, range + curve
+ *   baked in when the mapping is made)
+ * - sent with synth_io::storeParam (coalesced): a knob twisted at full rate
+ *   is one param update per audio buffer, the audio thread never sees CCs
+ * - edited on the terminal thread; the mutex is held for one lookup on the
+ *   MIDI thread, never by the audio thread
+ */
+inline constexpr uint32_t MIDI_CHANNEL_COUNT = 16;
+inline constexpr uint32_t MIDI_CC_COUNT = 128;
+inline constexpr uint32_t MAX_MIDI_MAPPINGS = 64;
+
+enum class MidiCurve : uint8_t {
+  Linear,
+  Exponential, // equal ratios per step (cutoffs, times), x^2 if min <= 0
+  Logarithmic, // fast start, fine control at the top
+};
+
+struct MidiMapping {
+  uint8_t channel = 0; // 0-15
+  uint8_t cc = 0;
+  ParamID paramID = ParamID::PARAM_COUNT;
+  MidiCurve curve = MidiCurve::Linear;
+  float min = 0.0f; // param units (denormalized, like `set`)
+  float max = 0.0f;
+
+  // Param value for each CC value
+  float values[MIDI_CC_COUNT] = {};
+};
+
+struct MidiLearn {
+  std::mutex mutex{};
+
+  // channel x CC -> mappings index + 1 (0 = unmapped)
+  uint8_t slots[MIDI_CHANNEL_COUNT][MIDI_CC_COUNT] = {};
+  MidiMapping mappings[MAX_MIDI_MAPPINGS];
+  uint32_t mappingCount = 0;
+
+  // Armed by learnMidiMapping: the next CC received takes it
+  bool isLearning = false;
+  MidiMapping pending{};
+
+  MidiLearn() = default;
+  MidiLearn(const MidiLearn &) = delete;
+  MidiLearn &operator=(const MidiLearn &) = delete;
+};
+
+/* Bind _channel_/_cc_ to _id_ (replaces the CC's previous mapping)
+ * - _min_/_max_ are clamped to the param's range; min == max = full range
+ * - max < min inverts the knob
+ * Returns false for an invalid param/channel/CC or a full table
+ */
+bool mapMidiCC(MidiLearn &learn, const Engine &engine, uint8_t channel,
+               uint8_t cc, ParamID id, MidiCurve curve, float min = 0.0f,
+               float max = 0.0f);
+
+// Same as mapMidiCC, for whichever CC arrives next (processMidiCC)
+// Returns false for an invalid param
+bool learnMidiMapping(MidiLearn &learn, const Engine &engine, ParamID id,
+                      MidiCurve curve, float min = 0.0f, float max = 0.0f);
+
+void cancelMidiLearn(MidiLearn &learn);
+
+// Returns false when the CC wasn't mapped
+bool unmapMidiCC(MidiLearn &learn, uint8_t channel, uint8_t cc);
+void clearMidiMappings(MidiLearn &learn);
+
+/* MIDI input thread: a CC message
+ * Returns true when it was consumed (mapped, or just learned), false to
+ * let it through (e.g. as a mod source controller)
+ */
+bool processMidiCC(MidiLearn &learn, synth_io::hSynthSession session,
+                   uint8_t channel, uint8_t cc, uint8_t value);
+
+void printMidiMappings(MidiLearn &learn);
+
+// lin|exp|log (false = unknown name)
+bool parseMidiCurve(const char *name, MidiCurve &curve);
+
+} // namespace synth::utils
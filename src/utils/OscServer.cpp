@@ -0,0 +1,353 @@
+#include "OscServer.h"
+
+#include "synth/ParamBindings.h"
+
+#include "synth_io/SynthIO.h"
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace synth::utils {
+namespace pb = param::bindings;
+namespace s_io = synth_io;
+
+// ==== <OSC Helpers> ====
+namespace {
+constexpr uint32_t MAX_BUNDLE_DEPTH = 8;
+constexpr uint32_t TIME_TAG_BYTES = 8;
+
+constexpr char PARAM_PREFIX[] = "/param/";
+constexpr char NOTE_ON_ADDRESS[] = "/note/on";
+constexpr char NOTE_OFF_ADDRESS[] = "/note/off";
+constexpr char BUNDLE_TAG[] = "#bundle";
+
+// OSC separators read as param name dots: /param/svf/cutoff == svf.cutoff
+char toNameChar(char c) { return c == '/' ? '.' : c; }
+
+// FNV-1a (same as preset keys, see Patch.cpp) over the normalized name
+uint32_t hashParamName(const char *name) {
+  uint32_t hash = 2166136261u;
+  for (const char *c = name; *c; c++) {
+    hash ^= static_cast<uint8_t>(toNameChar(*c));
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+bool isSameName(const char *paramName, const char *address) {
+  for (; *paramName && *address; paramName++, address++) {
+    if (*paramName != toNameChar(*address))
+      return false;
+  }
+  return *paramName == *address;
+}
+
+void buildParamTable(OscServer &server) {
+  constexpr uint32_t WRAP = OSC_PARAM_TABLE_SIZE - 1;
+  static_assert((OSC_PARAM_TABLE_SIZE & WRAP) == 0, "Size must be pow2");
+  static_assert(OSC_PARAM_TABLE_SIZE >= 2 * pb::PARAM_NAME_COUNT,
+                "OSC param table too small");
+
+  for (OscParamSlot &slot : server.paramTable)
+    slot = {};
+
+  for (size_t i = 0; i < pb::PARAM_NAME_COUNT; i++) {
+    uint32_t hash = hashParamName(pb::PARAM_NAMES[i].name);
+    uint32_t index = hash & WRAP;
+    while (server.paramTable[index].nameIndex >= 0)
+      index = (index + 1) & WRAP;
+
+    server.paramTable[index] = {hash, static_cast<int32_t>(i)};
+  }
+}
+
+// Linear probe, then one compare to rule out a hash collision
+const pb::ParamMapping *findParam(const OscServer &server, const char *name) {
+  constexpr uint32_t WRAP = OSC_PARAM_TABLE_SIZE - 1;
+
+  uint32_t hash = hashParamName(name);
+  for (uint32_t index = hash & WRAP;; index = (index + 1) & WRAP) {
+    const OscParamSlot &slot = server.paramTable[index];
+    if (slot.nameIndex < 0)
+      return nullptr;
+
+    const pb::ParamMapping &mapping =
+        pb::PARAM_NAMES[static_cast<size_t>(slot.nameIndex)];
+    if (slot.hash == hash && isSameName(mapping.name, name))
+      return &mapping;
+  }
+}
+
+// Big-endian, 4 byte aligned fields of one message/bundle element
+struct OscReader {
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+  size_t pos = 0;
+
+  bool readInt32(int32_t &value) {
+    if (size - pos < 4)
+      return false;
+
+    uint32_t bits = 0;
+    for (size_t i = 0; i < 4; i++)
+      bits = (bits << 8) | data[pos + i];
+    pos += 4;
+
+    value = static_cast<int32_t>(bits);
+    return true;
+  }
+
+  bool readFloat(float &value) {
+    int32_t bits = 0;
+    if (!readInt32(bits))
+      return false;
+
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+  }
+
+  // Null terminated, padded to 4 bytes. Points into the packet
+  bool readString(const char *&value) {
+    const void *end = std::memchr(data + pos, '\0', size - pos);
+    if (!end)
+      return false;
+
+    value = reinterpret_cast<const char *>(data + pos);
+    size_t length = static_cast<size_t>(static_cast<const uint8_t *>(end) -
+                                        (data + pos));
+    pos = std::min(size, pos + (length + 4) / 4 * 4);
+    return true;
+  }
+
+  bool skip(size_t numBytes) {
+    if (size - pos < numBytes)
+      return false;
+    pos += numBytes;
+    return true;
+  }
+};
+
+// One argument as a number (i, f, T, F), false for other types
+bool readNumber(OscReader &reader, char tag, float &value) {
+  int32_t intValue = 0;
+  switch (tag) {
+  case 'f':
+    return reader.readFloat(value);
+  case 'i':
+    if (!reader.readInt32(intValue))
+      return false;
+    value = static_cast<float>(intValue);
+    return true;
+  case 'T':
+    value = 1.0f;
+    return true;
+  case 'F':
+    value = 0.0f;
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Batch full: publish what's there, the rest goes in the next batch
+void flushBatch(OscServer &server) {
+  s_io::EventBatch &batch = server.batch;
+  if (batch.paramCount == 0 && batch.noteCount == 0)
+    return;
+
+  if (!s_io::sendEventBatch(server.session, batch))
+    printf("OSC: batch queue full, %u events dropped\n",
+           batch.paramCount + batch.noteCount);
+
+  batch.paramCount = 0;
+  batch.noteCount = 0;
+}
+
+bool addParam(OscServer &server, const char *name, OscReader &reader,
+              const char *tags) {
+  const pb::ParamMapping *param = findParam(server, name);
+  if (!param) {
+    printf("OSC: unknown parameter '%s'\n", name);
+    return false;
+  }
+
+  // Waveform/bool/filter mode values may come as strings (like `set`)
+  float value = 0.0f;
+  const char *text = nullptr;
+  if (tags[0] == 's') {
+    if (!reader.readString(text))
+      return false;
+    value = pb::parseParamValue(param->type, text);
+  } else if (!readNumber(reader, tags[0], value)) {
+    printf("OSC: '%s' needs one f, i, T, F or s argument\n", name);
+    return false;
+  }
+
+  if (server.batch.paramCount == s_io::MAX_BATCH_PARAMS)
+    flushBatch(server);
+
+  s_io::ParamEvent &event = server.batch.params[server.batch.paramCount++];
+  event = {};
+  event.id = static_cast<uint8_t>(param->id);
+  event.value = value;
+  return true;
+}
+
+// note [velocity] [channel 1-16], missing velocity: _defaultVelocity_
+bool addNote(OscServer &server, s_io::NoteEventType type, OscReader &reader,
+             const char *tags, float defaultVelocity) {
+  float args[3] = {-1.0f, defaultVelocity, 1.0f};
+  uint32_t numArgs = 0;
+  for (; tags[numArgs] && numArgs < 3; numArgs++) {
+    if (!readNumber(reader, tags[numArgs], args[numArgs]))
+      return false;
+  }
+
+  if (numArgs == 0 || args[0] < 0.0f || args[0] > 127.0f) {
+    printf("OSC: note needs a note number 0-127\n");
+    return false;
+  }
+
+  if (server.batch.noteCount == s_io::MAX_BATCH_NOTES)
+    flushBatch(server);
+
+  s_io::NoteEvent &event = server.batch.notes[server.batch.noteCount++];
+  event = {};
+  event.type = type;
+  event.midiNote = static_cast<uint8_t>(args[0]);
+  event.velocity = static_cast<uint8_t>(std::clamp(args[1], 0.0f, 127.0f));
+  event.channel = static_cast<uint8_t>(std::clamp(args[2], 1.0f, 16.0f) - 1);
+  return true;
+}
+
+bool handleMessage(OscServer &server, OscReader &reader) {
+  const char *address = nullptr;
+  if (!reader.readString(address))
+    return false;
+
+  // Type tags (",ffi"), absent in some very old senders: no arguments
+  const char *tags = ",";
+  if (reader.pos < reader.size && !reader.readString(tags))
+    return false;
+  if (tags[0] != ',')
+    return false;
+  tags++;
+
+  if (std::strncmp(address, PARAM_PREFIX, sizeof(PARAM_PREFIX) - 1) == 0)
+    return addParam(server, address + sizeof(PARAM_PREFIX) - 1, reader, tags);
+
+  if (std::strcmp(address, NOTE_ON_ADDRESS) == 0)
+    return addNote(server, s_io::NoteEventType::NoteOn, reader, tags, 100.0f);
+
+  if (std::strcmp(address, NOTE_OFF_ADDRESS) == 0)
+    return addNote(server, s_io::NoteEventType::NoteOff, reader, tags, 0.0f);
+
+  printf("OSC: unknown address '%s'\n", address);
+  return false;
+}
+
+// A message, or a bundle: #bundle, time tag, (int32 size, element)...
+void handleElement(OscServer &server, const uint8_t *data, size_t size,
+                   uint32_t depth) {
+  OscReader reader{data, size, 0};
+
+  if (size < sizeof(BUNDLE_TAG) ||
+      std::memcmp(data, BUNDLE_TAG, sizeof(BUNDLE_TAG)) != 0) {
+    handleMessage(server, reader);
+    return;
+  }
+
+  if (depth == MAX_BUNDLE_DEPTH ||
+      !reader.skip(sizeof(BUNDLE_TAG) + TIME_TAG_BYTES))
+    return;
+
+  int32_t elementSize = 0;
+  while (reader.readInt32(elementSize)) {
+    auto elementBytes = static_cast<size_t>(elementSize);
+    if (elementSize <= 0 || elementBytes > reader.size - reader.pos)
+      return;
+
+    handleElement(server, data + reader.pos, elementBytes, depth + 1);
+    reader.pos += elementBytes;
+  }
+}
+
+void receiveLoop(OscServer &server) {
+  pollfd request{server.socket, POLLIN, 0};
+
+  while (server.isRunning.load(std::memory_order_relaxed)) {
+    if (poll(&request, 1, static_cast<int>(OSC_POLL_MS)) <= 0)
+      continue;
+
+    ssize_t received =
+        recv(server.socket, server.packet, sizeof(server.packet), 0);
+    if (received <= 0)
+      continue;
+
+    // The whole packet is one batch (split only past MAX_BATCH_*)
+    handleElement(server, server.packet, static_cast<size_t>(received), 0);
+    flushBatch(server);
+  }
+}
+
+} // namespace
+// ==== </OSC Helpers> ====
+
+bool startOscServer(OscServer &server, s_io::hSynthSession session,
+                    uint16_t port) {
+  if (server.isRunning.load(std::memory_order_relaxed))
+    return false;
+
+  int udpSocket = ::socket(AF_INET, SOCK_DGRAM, 0);
+  if (udpSocket < 0) {
+    printf("OSC: unable to open a UDP socket\n");
+    return false;
+  }
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(port);
+  if (bind(udpSocket, reinterpret_cast<const sockaddr *>(&address),
+           sizeof(address)) != 0) {
+    printf("OSC: unable to bind UDP port %u\n", port);
+    close(udpSocket);
+    return false;
+  }
+
+  buildParamTable(server);
+  server.session = session;
+  server.socket = udpSocket;
+  server.batch.paramCount = 0;
+  server.batch.noteCount = 0;
+
+  server.isRunning.store(true, std::memory_order_relaxed);
+  server.thread = std::thread(receiveLoop, std::ref(server));
+
+  printf("OSC: listening on UDP port %u\n", port);
+  return true;
+}
+
+void stopOscServer(OscServer &server) {
+  if (!server.isRunning.load(std::memory_order_relaxed))
+    return;
+
+  server.isRunning.store(false, std::memory_order_relaxed);
+  server.thread.join();
+
+  close(server.socket);
+  server.socket = -1;
+}
+
+} // namespace synth::utils
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "synth_io/SynthIO.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace synth::utils {
+
+/* OSC control surface over UDP (show control, remote scene changes)
+ * - a background thread receives, parses and resolves every packet; the
+ *   audio thread only ever sees finished batches
+ * - one packet (a message, or a bundle + its nested bundles) is one
+ *   synth_io::EventBatch: a 40 param scene change lands in a single block
+ * - param names resolve through a hash table built once by startOscServer
+ *   (no string compares beyond the one confirming a hit)
+ *
+ * Addresses (values like the terminal `set` takes them, denormalized):
+ *   /param/<name> <f|i|T|F|s>  e.g. /param/svf.cutoff 800.0,
+ *                              /param/osc1/waveform "saw" ('/' == '.')
+ *   /note/on <note> <velocity> [channel 1-16]   (int32 args)
+ *   /note/off <note> [velocity] [channel 1-16]
+ * NOTE: bundle time tags are ignored, everything applies on arrival
+ */
+inline constexpr uint16_t DEFAULT_OSC_PORT = 9000;
+inline constexpr uint32_t OSC_POLL_MS = 50; // stop latency
+inline constexpr uint32_t MAX_OSC_PACKET_BYTES = 65536;
+
+// Power of two, at least twice the param count (short probe chains)
+inline constexpr uint32_t OSC_PARAM_TABLE_SIZE = 512;
+
+struct OscParamSlot {
+  uint32_t hash = 0;
+  int32_t nameIndex = -1; // into param::bindings::PARAM_NAMES, -1 = empty
+};
+
+struct OscServer {
+  synth_io::hSynthSession session = nullptr;
+  int socket = -1;
+
+  std::thread thread{};
+  std::atomic<bool> isRunning{false};
+
+  OscParamSlot paramTable[OSC_PARAM_TABLE_SIZE];
+
+  // Receive thread only
+  uint8_t packet[MAX_OSC_PACKET_BYTES] = {};
+  synth_io::EventBatch batch{};
+};
+
+/* Binds UDP _port_ (every interface) and starts the receive thread
+ * Returns false if the socket can't be opened/bound (reported)
+ */
+bool startOscServer(OscServer &server, synth_io::hSynthSession session,
+                    uint16_t port);
+
+// Joins the thread and closes the socket. No-op when not running
+void stopOscServer(OscServer &server);
+
+} // namespace synth::utils
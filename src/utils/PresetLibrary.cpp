@@ -0,0 +1,452 @@
+#include "PresetLibrary.h"
+
+#include "synth/ByteOrder.h"
+#include "synth/Engine.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace synth::utils {
+using namespace byte_order;
+
+// Larger files are not presets (sanity check before reading)
+inline constexpr long MAX_PRESET_FILE_BYTES = 1 << 16;
+inline constexpr uint32_t MAX_LIBRARY_ENTRIES = 1 << 16;
+
+// ==== <Library Helpers> ====
+namespace {
+
+// Preset file found by the scan, with its contents
+struct ScannedPreset {
+  PresetEntry entry{};
+  std::vector<uint8_t> bytes{};
+};
+
+bool hasPresetExtension(const char *name) {
+  size_t length = strlen(name);
+  size_t extension = strlen(PRESET_FILE_EXTENSION);
+  return length > extension &&
+         strcmp(name + length - extension, PRESET_FILE_EXTENSION) == 0;
+}
+
+bool isDirectory(const std::string &path) {
+  struct stat info {};
+  return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+void copyField(char *dest, size_t capacity, const char *src, size_t length) {
+  length = std::min(length, capacity - 1);
+  std::memcpy(dest, src, length);
+  dest[length] = '\0';
+}
+
+bool readWholeFile(const std::string &path, std::vector<uint8_t> &bytes) {
+  FILE *file = fopen(path.c_str(), "rb");
+  if (!file)
+    return false;
+
+  bool isRead = false;
+  if (fseek(file, 0, SEEK_END) == 0) {
+    long size = ftell(file);
+    if (size > 0 && size <= MAX_PRESET_FILE_BYTES) {
+      bytes.resize(static_cast<size_t>(size));
+      rewind(file);
+      isRead = fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    }
+  }
+
+  fclose(file);
+  return isRead;
+}
+
+/* Presets directly in _directory_, then one level of subdirectories
+ * (the subdirectory names the category unless the preset has one)
+ */
+void scanDirectory(const std::string &directory, const char *category,
+                   bool isTopLevel, std::vector<ScannedPreset> &presets) {
+  DIR *dir = opendir(directory.c_str());
+  if (!dir)
+    return;
+
+  while (dirent *item = readdir(dir)) {
+    const char *name = item->d_name;
+    if (name[0] == '.')
+      continue;
+
+    std::string path = directory + "/" + name;
+    if (isDirectory(path)) {
+      if (isTopLevel)
+        scanDirectory(path, name, false, presets);
+      continue;
+    }
+
+    ScannedPreset preset{};
+    patch::PresetInfo &info = preset.entry.info;
+    if (!hasPresetExtension(name) || !readWholeFile(path, preset.bytes) ||
+        !patch::decodePresetInfo(preset.bytes.data(), preset.bytes.size(),
+                                 info))
+      continue;
+
+    if (info.name[0] == '\0')
+      copyField(info.name, sizeof(info.name), name,
+                strlen(name) - strlen(PRESET_FILE_EXTENSION));
+    if (info.category[0] == '\0' && category)
+      copyField(info.category, sizeof(info.category), category,
+                strlen(category));
+
+    presets.push_back(std::move(preset));
+  }
+
+  closedir(dir);
+}
+
+bool isSortedBefore(const PresetEntry &a, const PresetEntry &b) {
+  int order = strcmp(a.info.category, b.info.category);
+  if (order != 0)
+    return order < 0;
+  return strcmp(a.info.name, b.info.name) < 0;
+}
+
+void writeEntry(uint8_t *bytes, const PresetEntry &entry) {
+  writeU32(bytes, entry.offset);
+  writeU32(bytes + 4, entry.size);
+  bytes += 8;
+
+  std::memcpy(bytes, entry.info.name, sizeof(entry.info.name));
+  bytes += sizeof(entry.info.name);
+  std::memcpy(bytes, entry.info.category, sizeof(entry.info.category));
+  bytes += sizeof(entry.info.category);
+  std::memcpy(bytes, entry.info.tags, sizeof(entry.info.tags));
+}
+
+void readEntry(const uint8_t *bytes, PresetEntry &entry) {
+  entry.offset = readU32(bytes);
+  entry.size = readU32(bytes + 4);
+  bytes += 8;
+
+  patch::PresetInfo &info = entry.info;
+  copyField(info.name, sizeof(info.name), reinterpret_cast<const char *>(bytes),
+            sizeof(info.name));
+  bytes += sizeof(info.name);
+  copyField(info.category, sizeof(info.category),
+            reinterpret_cast<const char *>(bytes), sizeof(info.category));
+  bytes += sizeof(info.category);
+  copyField(info.tags, sizeof(info.tags),
+            reinterpret_cast<const char *>(bytes), sizeof(info.tags));
+}
+
+// Scan + pack (written next to the presets, renamed into place when done)
+bool buildLibraryFile(const std::string &directory, const std::string &path,
+                      std::vector<PresetEntry> &entries) {
+  std::vector<ScannedPreset> presets;
+  scanDirectory(directory, nullptr, true, presets);
+
+  std::sort(presets.begin(), presets.end(),
+            [](const ScannedPreset &a, const ScannedPreset &b) {
+              return isSortedBefore(a.entry, b.entry);
+            });
+
+  size_t offset =
+      PRESET_LIBRARY_HEADER_BYTES + presets.size() * PRESET_LIBRARY_ENTRY_BYTES;
+  std::vector<uint8_t> index(offset);
+
+  writeU32(index.data(), PRESET_LIBRARY_MAGIC);
+  writeU16(index.data() + 4, PRESET_LIBRARY_VERSION);
+  writeU16(index.data() + 6, 0);
+  writeU32(index.data() + 8, static_cast<uint32_t>(presets.size()));
+
+  entries.clear();
+  for (size_t i = 0; i < presets.size(); i++) {
+    PresetEntry &entry = presets[i].entry;
+    entry.offset = static_cast<uint32_t>(offset);
+    entry.size = static_cast<uint32_t>(presets[i].bytes.size());
+    offset += entry.size;
+
+    writeEntry(index.data() + PRESET_LIBRARY_HEADER_BYTES +
+                   i * PRESET_LIBRARY_ENTRY_BYTES,
+               entry);
+    entries.push_back(entry);
+  }
+
+  std::string tempPath = path + ".tmp";
+  FILE *file = fopen(tempPath.c_str(), "wb");
+  if (!file)
+    return false;
+
+  bool isWritten = fwrite(index.data(), 1, index.size(), file) == index.size();
+  for (const ScannedPreset &preset : presets)
+    isWritten = isWritten && fwrite(preset.bytes.data(), 1, preset.bytes.size(),
+                                    file) == preset.bytes.size();
+
+  if (fclose(file) != 0 || !isWritten) {
+    remove(tempPath.c_str());
+    return false;
+  }
+  return rename(tempPath.c_str(), path.c_str()) == 0;
+}
+
+bool readLibraryFile(const std::string &path,
+                     std::vector<PresetEntry> &entries) {
+  FILE *file = fopen(path.c_str(), "rb");
+  if (!file)
+    return false;
+
+  uint8_t header[PRESET_LIBRARY_HEADER_BYTES] = {};
+  bool isValid = fread(header, 1, sizeof(header), file) == sizeof(header) &&
+                 readU32(header) == PRESET_LIBRARY_MAGIC &&
+                 readU16(header + 4) == PRESET_LIBRARY_VERSION;
+
+  uint32_t count = readU32(header + 8);
+  isValid = isValid && count <= MAX_LIBRARY_ENTRIES;
+
+  if (isValid) {
+    std::vector<uint8_t> index(count * PRESET_LIBRARY_ENTRY_BYTES);
+    isValid = fread(index.data(), 1, index.size(), file) == index.size();
+
+    entries.assign(isValid ? count : 0, PresetEntry{});
+    for (size_t i = 0; i < entries.size(); i++)
+      readEntry(index.data() + i * PRESET_LIBRARY_ENTRY_BYTES, entries[i]);
+  }
+
+  fclose(file);
+  return isValid;
+}
+
+// Engine's current patch with the entry's preset on top (built)
+patch::Patch *loadEntry(Engine &engine, FILE *file,
+                        const PresetEntry &entry) {
+  std::vector<uint8_t> bytes(entry.size);
+  if (fseek(file, static_cast<long>(entry.offset), SEEK_SET) != 0 ||
+      fread(bytes.data(), 1, bytes.size(), file) != bytes.size())
+    return nullptr;
+
+  patch::Patch *loaded = patch::capturePatch(engine);
+  if (!patch::decodePreset(engine, bytes.data(), bytes.size(), *loaded)) {
+    patch::disposePatch(loaded);
+    return nullptr;
+  }
+
+  patch::buildPatch(engine, *loaded);
+  return loaded;
+}
+
+// ==== Cache (library mutex held) ====
+PresetCacheSlot *findCacheSlot(PresetLibrary &library, int64_t entry) {
+  for (PresetCacheSlot &slot : library.cache)
+    if (slot.entry == entry)
+      return &slot;
+  return nullptr;
+}
+
+bool isNearFocus(const PresetLibrary &library, int64_t entry) {
+  int64_t distance = entry - library.focusEntry;
+  return library.focusEntry >= 0 &&
+         distance >= -static_cast<int64_t>(PRESET_PREFETCH_RADIUS) &&
+         distance <= static_cast<int64_t>(PRESET_PREFETCH_RADIUS);
+}
+
+// Least recently used, sparing the neighbors of the focused preset
+PresetCacheSlot &findEvictionSlot(PresetLibrary &library) {
+  PresetCacheSlot *oldest = nullptr;
+  PresetCacheSlot *oldestNear = nullptr;
+
+  for (PresetCacheSlot &slot : library.cache) {
+    if (slot.entry < 0)
+      return slot;
+
+    PresetCacheSlot *&pick = isNearFocus(library, slot.entry) ? oldestNear
+                                                             : oldest;
+    if (!pick || slot.lastUse < pick->lastUse)
+      pick = &slot;
+  }
+
+  return oldest ? *oldest : *oldestNear;
+}
+
+// Wanted preset first, then the focus' neighbors nearest first (-1 = done)
+int64_t findNextPrefetch(PresetLibrary &library) {
+  if (library.wantedEntry >= 0 &&
+      !findCacheSlot(library, library.wantedEntry))
+    return library.wantedEntry;
+
+  if (library.focusEntry < 0)
+    return -1;
+
+  const auto count = static_cast<int64_t>(library.entries.size());
+  for (int64_t d = 0; d <= static_cast<int64_t>(PRESET_PREFETCH_RADIUS); d++) {
+    for (int64_t entry : {library.focusEntry + d, library.focusEntry - d}) {
+      if (entry >= 0 && entry < count && !findCacheSlot(library, entry))
+        return entry;
+    }
+  }
+
+  return -1;
+}
+
+void prefetchLoop(PresetLibrary &library) {
+  FILE *file = fopen(library.libraryPath.c_str(), "rb");
+
+  std::unique_lock<std::mutex> lock(library.mutex);
+  while (library.isRunning) {
+    int64_t next = findNextPrefetch(library);
+    if (next < 0) {
+      library.wake.wait(lock);
+      continue;
+    }
+
+    lock.unlock();
+    const PresetEntry &entry = library.entries[static_cast<size_t>(next)];
+    patch::Patch *loaded =
+        file ? loadEntry(*library.engine, file, entry) : nullptr;
+    lock.lock();
+
+    // Failed loads stay cached too (patch == nullptr), no retry loop
+    PresetCacheSlot &slot = findEvictionSlot(library);
+    patch::disposePatch(slot.patch);
+    slot.entry = next;
+    slot.patch = loaded;
+    slot.lastUse = ++library.useClock;
+
+    if (next != library.wantedEntry)
+      continue;
+
+    library.wantedEntry = -1;
+    if (!loaded) {
+      printf("Preset: unable to load '%s'\n", entry.info.name);
+      continue;
+    }
+
+    // The cache keeps its copy (browsing back is a hit)
+    auto *posted = new patch::Patch(*loaded);
+    lock.unlock();
+    patch::postPatch(*library.engine, posted);
+    lock.lock();
+  }
+
+  if (file)
+    fclose(file);
+}
+
+} // namespace
+// ==== </Library Helpers> ====
+
+bool openPresetLibrary(PresetLibrary &library, Engine &engine,
+                       const std::string &directory, bool rescan) {
+  closePresetLibrary(library);
+
+  std::string path = directory + "/" + PRESET_LIBRARY_FILE;
+  std::vector<PresetEntry> entries;
+
+  bool isRead = !rescan && readLibraryFile(path, entries);
+  if (!isRead && !buildLibraryFile(directory, path, entries)) {
+    printf("Preset: unable to write %s\n", path.c_str());
+    return false;
+  }
+
+  library.engine = &engine;
+  library.libraryPath = path;
+  library.entries = std::move(entries);
+  library.focusEntry = -1;
+  library.wantedEntry = -1;
+  library.hitCount = 0;
+  library.missCount = 0;
+
+  library.isRunning = true;
+  library.thread = std::thread(prefetchLoop, std::ref(library));
+  return true;
+}
+
+void closePresetLibrary(PresetLibrary &library) {
+  if (!isPresetLibraryOpen(library))
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(library.mutex);
+    library.isRunning = false;
+  }
+  library.wake.notify_one();
+  library.thread.join();
+
+  for (PresetCacheSlot &slot : library.cache) {
+    patch::disposePatch(slot.patch);
+    slot = PresetCacheSlot{};
+  }
+
+  library.entries.clear();
+  library.engine = nullptr;
+}
+
+PresetRecall recallPreset(PresetLibrary &library, size_t index) {
+  if (!isPresetLibraryOpen(library) || index >= library.entries.size())
+    return PresetRecall::Invalid;
+
+  auto entry = static_cast<int64_t>(index);
+  patch::Patch *posted = nullptr;
+  bool isFailed = false;
+  {
+    std::lock_guard<std::mutex> lock(library.mutex);
+    library.focusEntry = entry;
+
+    PresetCacheSlot *slot = findCacheSlot(library, entry);
+    if (slot) {
+      library.hitCount++;
+      library.wantedEntry = -1;
+      slot->lastUse = ++library.useClock;
+
+      if (slot->patch)
+        posted = new patch::Patch(*slot->patch);
+      else
+        isFailed = true;
+    } else {
+      library.missCount++;
+      library.wantedEntry = entry;
+    }
+  }
+
+  // New focus: the prefetch thread moves its window along
+  library.wake.notify_one();
+
+  if (isFailed)
+    return PresetRecall::Invalid;
+  if (!posted)
+    return PresetRecall::Loading;
+
+  patch::postPatch(*library.engine, posted);
+  return PresetRecall::Posted;
+}
+
+int64_t getFocusedPreset(PresetLibrary &library) {
+  std::lock_guard<std::mutex> lock(library.mutex);
+  return library.focusEntry;
+}
+
+void printPresetLibrary(PresetLibrary &library, const char *category) {
+  std::lock_guard<std::mutex> lock(library.mutex);
+
+  for (size_t i = 0; i < library.entries.size(); i++) {
+    const patch::PresetInfo &info = library.entries[i].info;
+    if (category && strcmp(info.category, category) != 0)
+      continue;
+
+    auto entry = static_cast<int64_t>(i);
+    printf("%c%c %4zu  %-16s %-24s %s\n",
+           entry == library.focusEntry ? '>' : ' ',
+           findCacheSlot(library, entry) ? '*' : ' ', i, info.category,
+           info.name, info.tags);
+  }
+
+  printf("%zu presets | cache hits %u, misses %u (* = cached)\n",
+         library.entries.size(), library.hitCount, library.missCount);
+}
+
+} // namespace synth::utils
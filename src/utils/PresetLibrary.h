@@ -0,0 +1,107 @@
+#pragma once
+
+#include "synth/Patch.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace synth::utils {
+
+/* Preset browsing without disk I/O on the UI thread
+ * - openPresetLibrary scans a directory once (*.mehp, subdirectories are
+ *   categories) and packs every preset into one library file behind a
+ *   fixed size index; later opens only read that index
+ * - a prefetch thread decodes + builds the presets around the current one
+ *   into a small LRU cache of ready-to-post patches
+ * - recallPreset from the cache is a patch copy + postPatch (microseconds);
+ *   a miss is loaded by the prefetch thread, which posts it when ready
+ *
+ * Library file (little-endian):
+ *   header  | magic u32 | version u16 | reserved u16 | count u32
+ *   entries | offset u32 | size u32 | name | category | tags   x count
+ *   presets | the preset files back to back (offset from file start)
+ */
+inline constexpr const char *PRESET_FILE_EXTENSION = ".mehp";
+inline constexpr const char *PRESET_LIBRARY_FILE = "library.mehl";
+
+inline constexpr uint32_t PRESET_LIBRARY_MAGIC = 0x4C48454D; // "MEHL"
+inline constexpr uint16_t PRESET_LIBRARY_VERSION = 1;
+
+inline constexpr size_t PRESET_LIBRARY_HEADER_BYTES = 12;
+inline constexpr size_t PRESET_LIBRARY_ENTRY_BYTES =
+    8 + patch::PRESET_NAME_CHARS + patch::PRESET_CATEGORY_CHARS +
+    patch::PRESET_TAGS_CHARS;
+
+inline constexpr size_t PRESET_CACHE_SLOTS = 8;
+inline constexpr size_t PRESET_PREFETCH_RADIUS = 2; // neighbors each side
+
+struct PresetEntry {
+  patch::PresetInfo info{};
+  uint32_t offset = 0; // into the library file
+  uint32_t size = 0;
+};
+
+struct PresetCacheSlot {
+  int64_t entry = -1; // -1 = empty
+  patch::Patch *patch = nullptr;
+  uint64_t lastUse = 0;
+};
+
+enum class PresetRecall { Posted, Loading, Invalid };
+
+struct PresetLibrary {
+  Engine *engine = nullptr;
+  std::string libraryPath{};
+
+  // Sorted by category, then name. Fixed while the library is open
+  std::vector<PresetEntry> entries{};
+
+  // ==== Shared with the prefetch thread (mutex) ====
+  std::mutex mutex{};
+  std::condition_variable wake{};
+  PresetCacheSlot cache[PRESET_CACHE_SLOTS];
+  uint64_t useClock = 0;
+  int64_t focusEntry = -1;  // prefetch around this one
+  int64_t wantedEntry = -1; // recalled on a miss: posted once loaded
+  bool isRunning = false;
+
+  uint32_t hitCount = 0;
+  uint32_t missCount = 0;
+
+  std::thread thread{};
+
+  PresetLibrary() = default;
+  PresetLibrary(const PresetLibrary &) = delete;
+  PresetLibrary &operator=(const PresetLibrary &) = delete;
+};
+
+/* Reads <directory>/library.mehl, or scans _directory_ and writes it
+ * (_rescan_ forces the scan). Starts the prefetch thread
+ * Returns false when nothing could be read or written
+ */
+bool openPresetLibrary(PresetLibrary &library, Engine &engine,
+                       const std::string &directory, bool rescan = false);
+
+// Stops the prefetch thread and frees the cache. No-op when not open
+void closePresetLibrary(PresetLibrary &library);
+
+inline bool isPresetLibraryOpen(const PresetLibrary &library) {
+  return library.engine != nullptr;
+}
+
+// Program change to entries[_index_] (never reads the disk)
+PresetRecall recallPreset(PresetLibrary &library, size_t index);
+
+// Index of the last recalled preset (-1 = none yet)
+int64_t getFocusedPreset(PresetLibrary &library);
+
+// Entries (optionally one category only) + cache hits/misses
+void printPresetLibrary(PresetLibrary &library, const char *category);
+
+} // namespace synth::utils
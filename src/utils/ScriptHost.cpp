@@ -0,0 +1,215 @@
+#include "ScriptHost.h"
+
+#include "synth_io/SynthIO.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+namespace synth::utils {
+namespace s_io = synth_io;
+
+// ==== <Host Helpers> ====
+namespace {
+
+s_io::TimelineEvent *addEvent(ScriptBlock &block, uint64_t frame) {
+  if (block.numEvents == s_io::MAX_TIMELINE_BLOCK_EVENTS)
+    return nullptr;
+
+  s_io::TimelineEvent &event = block.events[block.numEvents++];
+  event = {};
+  event.frame = std::clamp(frame, block.startFrame,
+                           block.startFrame + block.numFrames - 1);
+  return &event;
+}
+
+// Fill + publish the host's next block with _process_
+void runBlock(ScriptHost &host, ScriptProcess process) {
+  ScriptBlock &block = host.block;
+  block.startFrame = host.nextBlock * s_io::TIMELINE_BLOCK_FRAMES;
+  block.numFrames = s_io::TIMELINE_BLOCK_FRAMES;
+  block.sampleRate = host.sampleRate;
+  block.numEvents = 0;
+
+  process(block, host.script.state);
+
+  if (!s_io::writeTimelineBlock(host.session, host.nextBlock, block.events,
+                                block.numEvents))
+    host.lateBlocks.fetch_add(1, std::memory_order_relaxed);
+
+  host.nextBlock++;
+}
+
+void hostLoop(ScriptHost &host) {
+  while (host.isRunning.load(std::memory_order_relaxed)) {
+    uint64_t streamFrame = s_io::getStreamFrame(host.session);
+
+    // Fell behind (stalled thread): skip to the playing block, the script
+    // sees the gap as time passing
+    uint64_t playingBlock = streamFrame / s_io::TIMELINE_BLOCK_FRAMES;
+    if (host.nextBlock < playingBlock) {
+      host.lateBlocks.fetch_add(playingBlock - host.nextBlock,
+                                std::memory_order_relaxed);
+      host.nextBlock = playingBlock;
+    }
+
+    while (host.nextBlock * s_io::TIMELINE_BLOCK_FRAMES <
+           streamFrame + host.lookaheadFrames)
+      runBlock(host, host.script.process);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(SCRIPT_POLL_MS));
+  }
+
+  if (host.script.release)
+    runBlock(host, host.script.release);
+}
+
+} // namespace
+// ==== </Host Helpers> ====
+
+bool scriptNoteOn(ScriptBlock &block, uint64_t frame, uint8_t midiNote,
+                  uint8_t velocity, uint8_t channel) {
+  s_io::TimelineEvent *event = addEvent(block, frame);
+  if (!event)
+    return false;
+
+  event->type = s_io::TimelineEventType::Note;
+  event->note = {s_io::NoteEventType::NoteOn, midiNote, velocity, 0, 0,
+                 channel};
+  return true;
+}
+
+bool scriptNoteOff(ScriptBlock &block, uint64_t frame, uint8_t midiNote,
+                   uint8_t channel) {
+  s_io::TimelineEvent *event = addEvent(block, frame);
+  if (!event)
+    return false;
+
+  event->type = s_io::TimelineEventType::Note;
+  event->note = {s_io::NoteEventType::NoteOff, midiNote, 0, 0, 0, channel};
+  return true;
+}
+
+bool scriptSetParam(ScriptBlock &block, uint64_t frame, uint8_t id,
+                    float value) {
+  s_io::TimelineEvent *event = addEvent(block, frame);
+  if (!event)
+    return false;
+
+  event->type = s_io::TimelineEventType::Param;
+  event->param = {id, value, 0, 0};
+  return true;
+}
+
+bool startScriptHost(ScriptHost &host, s_io::hSynthSession session,
+                     const Script &script, float sampleRate,
+                     uint32_t lookaheadMs) {
+  if (isScriptRunning(host) || !script.process)
+    return false;
+
+  // The timeline ring caps the lookahead (one block spare for the edge)
+  constexpr uint64_t MAX_LOOKAHEAD_FRAMES =
+      (s_io::TIMELINE_BLOCKS - 1) * s_io::TIMELINE_BLOCK_FRAMES;
+
+  host.session = session;
+  host.script = script;
+  host.sampleRate = sampleRate;
+  host.lookaheadFrames = std::min(
+      static_cast<uint64_t>(sampleRate * static_cast<float>(lookaheadMs) /
+                            1000.0f),
+      MAX_LOOKAHEAD_FRAMES);
+  host.lateBlocks.store(0, std::memory_order_relaxed);
+
+  // First block after the one playing now (never written late)
+  host.nextBlock =
+      s_io::getStreamFrame(session) / s_io::TIMELINE_BLOCK_FRAMES + 1;
+
+  host.isRunning.store(true, std::memory_order_relaxed);
+  host.thread = std::thread(hostLoop, std::ref(host));
+  return true;
+}
+
+void stopScriptHost(ScriptHost &host) {
+  if (!isScriptRunning(host))
+    return;
+
+  host.isRunning.store(false, std::memory_order_relaxed);
+  host.thread.join();
+}
+
+// ==== Built-in Scripts ====
+namespace {
+constexpr int32_t PENTATONIC[] = {0, 2, 4, 7, 9};
+constexpr int32_t SCALE_SIZE = sizeof(PENTATONIC) / sizeof(PENTATONIC[0]);
+constexpr int32_t MAX_DEGREE = 2 * SCALE_SIZE; // two octaves
+
+// xorshift32: cheap, deterministic per start
+uint32_t nextRandom(uint32_t &state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+void processGenerative(ScriptBlock &block, void *statePtr) {
+  auto &state = *static_cast<GenerativeScript *>(statePtr);
+
+  auto stepFrames = static_cast<uint64_t>(block.sampleRate * 60.0f /
+                                          (state.tempo * 4.0f));
+  stepFrames = std::max<uint64_t>(stepFrames, 1);
+
+  // First block (or after a skip): the sequence starts here
+  uint64_t blockEnd = block.startFrame + block.numFrames;
+  if (state.nextStepFrame < block.startFrame)
+    state.nextStepFrame = block.startFrame;
+
+  for (; state.nextStepFrame < blockEnd; state.nextStepFrame += stepFrames) {
+    if (state.heldNote >= 0)
+      scriptNoteOff(block, state.nextStepFrame,
+                    static_cast<uint8_t>(state.heldNote));
+    state.heldNote = -1;
+
+    uint32_t roll = nextRandom(state.rngState);
+    if (roll % 4 == 0)
+      continue; // rest
+
+    // Walk -2..+2 scale degrees, reflected at the range edges
+    state.degree += static_cast<int32_t>((roll >> 8) % 5) - 2;
+    if (state.degree < 0)
+      state.degree = -state.degree;
+    if (state.degree > MAX_DEGREE)
+      state.degree = 2 * MAX_DEGREE - state.degree;
+
+    int32_t note = state.rootNote + 12 * (state.degree / SCALE_SIZE) +
+                   PENTATONIC[state.degree % SCALE_SIZE];
+    auto velocity = static_cast<uint8_t>((roll >> 16) % 4 == 0 ? 120 : 80);
+
+    state.heldNote = static_cast<int16_t>(std::min(note, 127));
+    scriptNoteOn(block, state.nextStepFrame,
+                 static_cast<uint8_t>(state.heldNote), velocity);
+  }
+}
+
+void releaseGenerative(ScriptBlock &block, void *statePtr) {
+  auto &state = *static_cast<GenerativeScript *>(statePtr);
+  if (state.heldNote >= 0)
+    scriptNoteOff(block, block.startFrame,
+                  static_cast<uint8_t>(state.heldNote));
+  state.heldNote = -1;
+}
+
+} // namespace
+
+Script makeGenerativeScript(GenerativeScript &state, float tempo,
+                            uint8_t rootNote) {
+  state = {};
+  state.tempo = std::clamp(tempo, 20.0f, 400.0f);
+  state.rootNote = std::min<uint8_t>(rootNote, 100);
+
+  return {"gen", processGenerative, releaseGenerative, &state};
+}
+
+} // namespace synth::utils
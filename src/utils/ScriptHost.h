@@ -0,0 +1,102 @@
+#pragma once
+
+#include "synth_io/SynthIO.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace synth::utils {
+
+/* Script host: arpeggiators, generative sequences, macros off the audio
+ * thread
+ * - the host thread runs the script one timeline block at a time, keeping
+ *   the session's event timeline lookaheadMs ahead of the stream clock
+ *   (synth_io::writeTimelineBlock), waking every SCRIPT_POLL_MS
+ * - scripts place events on exact stream frames: the audio thread applies
+ *   them where they fall, no queue, no timestamp jitter, no script cost
+ * - lookahead is the latency of anything a script reacts to (and must
+ *   cover a poll + a buffer, or blocks arrive late and are skipped)
+ * NOTE: scripts are native functions; a Lua binding would be one more
+ * ScriptProcess calling into its VM
+ */
+inline constexpr uint32_t SCRIPT_POLL_MS = 5;
+inline constexpr uint32_t DEFAULT_SCRIPT_LOOKAHEAD_MS = 50;
+
+// One timeline block for a script to fill (events on absolute frames)
+struct ScriptBlock {
+  uint64_t startFrame = 0;
+  uint32_t numFrames = synth_io::TIMELINE_BLOCK_FRAMES;
+  float sampleRate = 0.0f;
+
+  synth_io::TimelineEvent events[synth_io::MAX_TIMELINE_BLOCK_EVENTS];
+  uint32_t numEvents = 0;
+};
+
+// Frames outside the block are clamped into it. Return false when full
+bool scriptNoteOn(ScriptBlock &block, uint64_t frame, uint8_t midiNote,
+                  uint8_t velocity, uint8_t channel = 0);
+bool scriptNoteOff(ScriptBlock &block, uint64_t frame, uint8_t midiNote,
+                   uint8_t channel = 0);
+bool scriptSetParam(ScriptBlock &block, uint64_t frame, uint8_t id,
+                    float value);
+
+using ScriptProcess = void (*)(ScriptBlock &block, void *state);
+
+struct Script {
+  const char *name = "";
+  ScriptProcess process = nullptr; // every block, in order
+  ScriptProcess release = nullptr; // optional: last block on stop (note offs)
+  void *state = nullptr;
+};
+
+struct ScriptHost {
+  synth_io::hSynthSession session = nullptr;
+  Script script{};
+  float sampleRate = 0.0f;
+  uint64_t lookaheadFrames = 0;
+
+  // Host thread only: next timeline block to write
+  uint64_t nextBlock = 0;
+  ScriptBlock block{};
+
+  // Blocks the host fell behind on (skipped, their events never played)
+  std::atomic<uint64_t> lateBlocks{0};
+
+  std::thread thread{};
+  std::atomic<bool> isRunning{false};
+};
+
+/* Runs _script_ on the host thread from the next block on
+ * _sampleRate_: the session rate (stream clock)
+ * Returns false when a script is already running
+ */
+bool startScriptHost(ScriptHost &host, synth_io::hSynthSession session,
+                     const Script &script, float sampleRate,
+                     uint32_t lookaheadMs = DEFAULT_SCRIPT_LOOKAHEAD_MS);
+
+// Joins the thread after the script's release block. No-op when stopped
+void stopScriptHost(ScriptHost &host);
+
+inline bool isScriptRunning(const ScriptHost &host) {
+  return host.isRunning.load(std::memory_order_relaxed);
+}
+
+// ==== Built-in Scripts ====
+/* Generative sequence: a random walk over a pentatonic scale, one note per
+ * sixteenth at _tempo_, with random rests and accents
+ */
+struct GenerativeScript {
+  float tempo = 120.0f;
+  uint8_t rootNote = 48;
+
+  uint64_t nextStepFrame = 0;
+  uint32_t rngState = 0x9E3779B9u;
+  int32_t degree = 0;
+  int16_t heldNote = -1;
+};
+
+Script makeGenerativeScript(GenerativeScript &state, float tempo,
+                            uint8_t rootNote);
+
+} // namespace synth::utils
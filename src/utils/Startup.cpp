@@ -0,0 +1,114 @@
+#include "Startup.h"
+#include "KeyProcessor.h"
+#include "MidiLearn.h"
+
+#include "synth/Engine.h"
+#include "synth/Patch.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace synth::utils {
+
+// ==== <Startup Helpers> ====
+namespace {
+
+// The last thread to finish prints the whole report
+void finishThread(BackgroundStartup &startup) {
+  if (startup.pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    printStartupReport(*startup.timer);
+}
+
+void midiLoop(BackgroundStartup &startup) {
+  const StartupAssets &assets = startup.assets;
+
+  double phaseStart = getStartupMs(*startup.timer);
+  startup.midiSession.store(
+      initMidiSession(assets.session, *assets.midiLearn, assets.midiSource),
+      std::memory_order_release);
+  recordStartupPhase(*startup.timer, "midi", phaseStart, true);
+
+  finishThread(startup);
+}
+
+void assetLoop(BackgroundStartup &startup) {
+  const StartupAssets &assets = startup.assets;
+
+  // Posted like a program change: the audio thread swaps it in at a block
+  double phaseStart = getStartupMs(*startup.timer);
+  patch::Patch *patch =
+      patch::loadPresetFile(*assets.engine, assets.presetPath);
+  if (patch)
+    patch::postPatch(*assets.engine, patch);
+  recordStartupPhase(*startup.timer, "preset", phaseStart, true);
+
+  finishThread(startup);
+}
+
+} // namespace
+// ==== </Startup Helpers> ====
+
+double getStartupMs(const StartupTimer &timer) {
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - timer.origin;
+  return elapsed.count();
+}
+
+void recordStartupPhase(StartupTimer &timer, const char *name, double startMs,
+                        bool isBackground) {
+  double endMs = getStartupMs(timer);
+
+  std::lock_guard<std::mutex> lock(timer.mutex);
+  if (timer.numPhases == MAX_STARTUP_PHASES)
+    return;
+
+  timer.phases[timer.numPhases++] = {name, startMs, endMs - startMs,
+                                     isBackground};
+}
+
+void printStartupReport(StartupTimer &timer) {
+  std::lock_guard<std::mutex> lock(timer.mutex);
+
+  printf("Startup (ms since launch):\n");
+  for (uint32_t i = 0; i < timer.numPhases; i++) {
+    const StartupPhase &phase = timer.phases[i];
+    printf("  %-14s %8.1f ms  (%.1f - %.1f)%s\n", phase.name,
+           phase.durationMs, phase.startMs, phase.startMs + phase.durationMs,
+           phase.isBackground ? "  background" : "");
+  }
+}
+
+void startBackgroundStartup(BackgroundStartup &startup, StartupTimer &timer,
+                            const StartupAssets &assets) {
+  startup.assets = assets;
+  startup.timer = &timer;
+
+  uint32_t numThreads = (assets.isMidiEnabled ? 1u : 0u) +
+                        (assets.presetPath ? 1u : 0u);
+  startup.pendingCount.store(numThreads, std::memory_order_relaxed);
+  if (numThreads == 0) {
+    printStartupReport(timer);
+    return;
+  }
+
+  if (assets.isMidiEnabled)
+    startup.midiThread = std::thread(midiLoop, std::ref(startup));
+  if (assets.presetPath)
+    startup.assetThread = std::thread(assetLoop, std::ref(startup));
+}
+
+hMidiSession finishBackgroundStartup(BackgroundStartup &startup) {
+  if (startup.midiThread.joinable())
+    startup.midiThread.join();
+  if (startup.assetThread.joinable())
+    startup.assetThread.join();
+
+  return startup.midiSession.load(std::memory_order_acquire);
+}
+
+} // namespace synth::utils
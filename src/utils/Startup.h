@@ -0,0 +1,85 @@
+#pragma once
+
+#include "KeyProcessor.h"
+
+#include "synth_io/SynthIO.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace synth {
+struct Engine;
+}
+
+namespace synth::utils {
+
+struct MidiLearn;
+
+/* Cold start: audio first, everything else after
+ * - main brings up the engine and the audio stream on its own thread, then
+ *   hands the slow, optional parts to background threads (MIDI enumeration
+ *   on one, asset loading on another) that push results into the running
+ *   engine
+ * - every phase is timed (ms since launch), the report is printed by the
+ *   last background thread to finish
+ */
+inline constexpr uint32_t MAX_STARTUP_PHASES = 16;
+
+struct StartupPhase {
+  const char *name = "";
+  double startMs = 0.0;
+  double durationMs = 0.0;
+  bool isBackground = false;
+};
+
+struct StartupTimer {
+  std::chrono::steady_clock::time_point origin =
+      std::chrono::steady_clock::now();
+
+  std::mutex mutex{};
+  StartupPhase phases[MAX_STARTUP_PHASES];
+  uint32_t numPhases = 0;
+};
+
+// ms since _timer_ was created (launch)
+double getStartupMs(const StartupTimer &timer);
+
+// A phase from _startMs_ to now (any thread)
+void recordStartupPhase(StartupTimer &timer, const char *name, double startMs,
+                        bool isBackground = false);
+
+void printStartupReport(StartupTimer &timer);
+
+// What the background threads bring up (optional parts left null)
+struct StartupAssets {
+  Engine *engine = nullptr;
+  synth_io::hSynthSession session = nullptr;
+  MidiLearn *midiLearn = nullptr;
+
+  bool isMidiEnabled = true;
+  const char *midiSource = nullptr; // index/name substring, nullptr = all
+  const char *presetPath = nullptr; // posted when loaded
+};
+
+struct BackgroundStartup {
+  StartupAssets assets{};
+  StartupTimer *timer = nullptr;
+
+  std::atomic<hMidiSession> midiSession{nullptr};
+  std::atomic<uint32_t> pendingCount{0}; // threads still running
+
+  std::thread midiThread{};
+  std::thread assetThread{};
+};
+
+// Returns right away (the report prints when both threads are done)
+void startBackgroundStartup(BackgroundStartup &startup, StartupTimer &timer,
+                            const StartupAssets &assets);
+
+// Joins the threads. Returns the MIDI session (nullptr: none connected)
+hMidiSession finishBackgroundStartup(BackgroundStartup &startup);
+
+} // namespace synth::utils
@@ -0,0 +1,94 @@
+#include "TapRecorder.h"
+#include "WavWriter.h"
+
+#include "synth_io/SynthIO.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace synth::utils {
+namespace s_io = synth_io;
+
+// ==== <Recorder Helpers> ====
+namespace {
+constexpr uint32_t READ_FRAMES = 4096;
+
+// Returns frames written
+uint32_t drainTap(TapRecorder &recorder, std::vector<float> &scratch) {
+  uint32_t numFrames = s_io::readOutputTap(recorder.tap, scratch.data(),
+                                           READ_FRAMES);
+  if (numFrames)
+    WavWriter::writeInterleaved(recorder.stream, scratch.data(), numFrames);
+  return numFrames;
+}
+
+void recorderLoop(TapRecorder &recorder) {
+  s_io::OutputTapStats stats = s_io::getOutputTapStats(recorder.tap);
+  std::vector<float> scratch(READ_FRAMES * stats.numChannels);
+
+  while (recorder.isRunning.load(std::memory_order_relaxed)) {
+    if (drainTap(recorder, scratch) == 0)
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(TAP_RECORDER_POLL_MS));
+  }
+
+  // Whatever the audio thread wrote before stop
+  while (drainTap(recorder, scratch) != 0) {
+  }
+}
+
+} // namespace
+// ==== </Recorder Helpers> ====
+
+bool startTapRecorder(TapRecorder &recorder, s_io::hSynthSession session,
+                      const std::string &filename, uint32_t sampleRate) {
+  if (isTapRecording(recorder))
+    return false;
+
+  s_io::hOutputTap tap =
+      s_io::attachOutputTap(session, sampleRate * TAP_RECORDER_SECONDS);
+  if (!tap)
+    return false;
+
+  s_io::OutputTapStats stats = s_io::getOutputTapStats(tap);
+  if (!WavWriter::openWavStream(recorder.stream, filename,
+                                static_cast<int32_t>(sampleRate),
+                                static_cast<uint16_t>(stats.numChannels),
+                                WavWriter::SampleFormat::PCM24)) {
+    s_io::detachOutputTap(session, tap);
+    return false;
+  }
+
+  recorder.session = session;
+  recorder.tap = tap;
+  recorder.isRunning.store(true, std::memory_order_relaxed);
+  recorder.thread = std::thread(recorderLoop, std::ref(recorder));
+  return true;
+}
+
+void stopTapRecorder(TapRecorder &recorder) {
+  if (!isTapRecording(recorder))
+    return;
+
+  recorder.isRunning.store(false, std::memory_order_relaxed);
+  recorder.thread.join();
+
+  s_io::OutputTapStats stats = s_io::getOutputTapStats(recorder.tap);
+  bool isWritten = WavWriter::closeWavStream(recorder.stream);
+
+  s_io::detachOutputTap(recorder.session, recorder.tap);
+  recorder.tap = nullptr;
+
+  printf("Recorded %llu frames (%llu dropped)%s\n",
+         static_cast<unsigned long long>(stats.framesWritten),
+         static_cast<unsigned long long>(stats.droppedFrames),
+         isWritten ? "" : " - write error");
+}
+
+} // namespace synth::utils
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "WavWriter.h"
+
+#include "synth_io/SynthIO.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace synth::utils {
+
+/* Live recording of the session output (output tap -> streaming WavWriter)
+ * - a background thread drains the tap and writes to disk, the audio
+ *   thread only copies into the tap ring
+ * - the tap holds TAP_RECORDER_SECONDS of audio, a longer disk stall loses
+ *   whole buffers (reported by stopTapRecorder)
+ */
+inline constexpr uint32_t TAP_RECORDER_SECONDS = 2;
+inline constexpr uint32_t TAP_RECORDER_POLL_MS = 20;
+
+struct TapRecorder {
+  synth_io::hSynthSession session = nullptr;
+  synth_io::hOutputTap tap = nullptr;
+
+  WavWriter::WavStream stream{};
+  std::thread thread{};
+  std::atomic<bool> isRunning{false};
+};
+
+// Returns false if the file can't be created or no tap is free
+bool startTapRecorder(TapRecorder &recorder, synth_io::hSynthSession session,
+                      const std::string &filename, uint32_t sampleRate);
+
+// Drains what's left, closes the file and detaches the tap
+// Prints frames written/dropped. No-op when not recording
+void stopTapRecorder(TapRecorder &recorder);
+
+inline bool isTapRecording(const TapRecorder &recorder) {
+  return recorder.tap != nullptr;
+}
+
+} // namespace synth::utils
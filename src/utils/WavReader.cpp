@@ -0,0 +1,205 @@
+#include "WavReader.h"
+
+#include "synth/ByteOrder.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace WavReader {
+namespace bo = synth::byte_order;
+
+// ==== Format Helpers ====
+namespace {
+constexpr uint16_t FORMAT_PCM = 1;
+constexpr uint16_t FORMAT_IEEE_FLOAT = 3;
+constexpr uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+struct WavFormat {
+  uint16_t tag = 0;
+  uint16_t numChannels = 0;
+  int32_t sampleRate = 0;
+  uint16_t bitsPerSample = 0;
+};
+
+bool readFileBytes(const std::string &filename, std::vector<uint8_t> &bytes) {
+  FILE *file = fopen(filename.c_str(), "rb");
+  if (!file)
+    return false;
+
+  bool isOk = fseek(file, 0, SEEK_END) == 0;
+  long size = isOk ? ftell(file) : -1;
+  isOk = size > 0 && fseek(file, 0, SEEK_SET) == 0;
+
+  if (isOk) {
+    bytes.resize(static_cast<size_t>(size));
+    isOk = fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+  }
+
+  fclose(file);
+  return isOk;
+}
+
+bool isChunk(const uint8_t *bytes, const char *id) {
+  return std::memcmp(bytes, id, 4) == 0;
+}
+
+// Extensible files keep the real tag in the first 2 bytes of the GUID
+bool parseFormat(const uint8_t *bytes, uint32_t size, WavFormat &format) {
+  if (size < 16)
+    return false;
+
+  format.tag = bo::readU16(bytes);
+  format.numChannels = bo::readU16(bytes + 2);
+  format.sampleRate = static_cast<int32_t>(bo::readU32(bytes + 4));
+  format.bitsPerSample = bo::readU16(bytes + 14);
+
+  if (format.tag == FORMAT_EXTENSIBLE) {
+    if (size < 40)
+      return false;
+    format.tag = bo::readU16(bytes + 24);
+  }
+
+  return format.numChannels > 0;
+}
+
+// "<!>2048 ..." -> 2048
+uint32_t parseCycleLength(const uint8_t *bytes, uint32_t size) {
+  if (size < 4 || std::memcmp(bytes, "<!>", 3) != 0)
+    return 0;
+
+  char digits[16] = {};
+  uint32_t count = 0;
+  for (uint32_t i = 3; i < size && count + 1 < sizeof(digits); i++) {
+    if (bytes[i] < '0' || bytes[i] > '9')
+      break;
+    digits[count++] = static_cast<char>(bytes[i]);
+  }
+
+  return static_cast<uint32_t>(std::strtoul(digits, nullptr, 10));
+}
+
+float decodeSample(const uint8_t *bytes, const WavFormat &format) {
+  if (format.tag == FORMAT_IEEE_FLOAT) {
+    if (format.bitsPerSample == 64) {
+      uint64_t bits = bo::readU32(bytes) |
+                      static_cast<uint64_t>(bo::readU32(bytes + 4)) << 32;
+      double value = 0.0;
+      std::memcpy(&value, &bits, sizeof(value));
+      return static_cast<float>(value);
+    }
+    return bo::readF32(bytes);
+  }
+
+  switch (format.bitsPerSample) {
+  case 8: // unsigned
+    return (static_cast<float>(bytes[0]) - 128.0f) / 128.0f;
+  case 16:
+    return static_cast<float>(static_cast<int16_t>(bo::readU16(bytes))) /
+           32768.0f;
+  case 24: {
+    // Sign extend from the top byte
+    auto value = static_cast<int32_t>(static_cast<uint32_t>(bytes[0]) << 8 |
+                                      static_cast<uint32_t>(bytes[1]) << 16 |
+                                      static_cast<uint32_t>(bytes[2]) << 24);
+    return static_cast<float>(value >> 8) / 8388608.0f;
+  }
+  default: // 32
+    return static_cast<float>(static_cast<int32_t>(bo::readU32(bytes))) /
+           2147483648.0f;
+  }
+}
+
+bool isSupported(const WavFormat &format) {
+  if (format.tag == FORMAT_IEEE_FLOAT)
+    return format.bitsPerSample == 32 || format.bitsPerSample == 64;
+
+  return format.tag == FORMAT_PCM &&
+         (format.bitsPerSample == 8 || format.bitsPerSample == 16 ||
+          format.bitsPerSample == 24 || format.bitsPerSample == 32);
+}
+} // namespace
+
+bool readWavFile(const std::string &filename, WavData &data,
+                 bool isInterleaved) {
+  std::vector<uint8_t> bytes;
+  if (!readFileBytes(filename, bytes)) {
+    printf("Error: Unable to read '%s'\n", filename.c_str());
+    return false;
+  }
+
+  if (bytes.size() < 12 || !isChunk(bytes.data(), "RIFF") ||
+      !isChunk(bytes.data() + 8, "WAVE")) {
+    printf("Error: '%s' is not a WAV file\n", filename.c_str());
+    return false;
+  }
+
+  WavFormat format{};
+  bool hasFormat = false;
+  const uint8_t *samples = nullptr;
+  uint32_t sampleBytes = 0;
+  data.cycleLength = 0;
+
+  // Chunks are word aligned; a truncated data chunk keeps what's there
+  size_t offset = 12;
+  while (offset + 8 <= bytes.size()) {
+    const uint8_t *chunk = bytes.data() + offset;
+    size_t available = bytes.size() - offset - 8;
+    uint32_t size = bo::readU32(chunk + 4);
+    if (size > available)
+      size = static_cast<uint32_t>(available);
+
+    if (isChunk(chunk, "fmt "))
+      hasFormat = parseFormat(chunk + 8, size, format);
+    else if (isChunk(chunk, "data")) {
+      samples = chunk + 8;
+      sampleBytes = size;
+    } else if (isChunk(chunk, "clm "))
+      data.cycleLength = parseCycleLength(chunk + 8, size);
+
+    offset += 8 + static_cast<size_t>(size) + (size & 1);
+  }
+
+  if (!hasFormat || !samples || !isSupported(format)) {
+    printf("Error: Unsupported WAV format in '%s'\n", filename.c_str());
+    return false;
+  }
+
+  uint32_t frameBytes = format.bitsPerSample / 8u * format.numChannels;
+  uint32_t numFrames = sampleBytes / frameBytes;
+  if (numFrames == 0) {
+    printf("Error: '%s' has no samples\n", filename.c_str());
+    return false;
+  }
+
+  data.sampleRate = format.sampleRate;
+  data.numChannels = format.numChannels;
+
+  const uint32_t bytesPerSample = format.bitsPerSample / 8u;
+  const float channelScale = 1.0f / static_cast<float>(format.numChannels);
+
+  if (isInterleaved) {
+    size_t numSamples = static_cast<size_t>(numFrames) * format.numChannels;
+    data.samples.resize(numSamples);
+    for (size_t i = 0; i < numSamples; i++)
+      data.samples[i] = decodeSample(samples + i * bytesPerSample, format);
+    return true;
+  }
+
+  data.samples.resize(numFrames);
+  for (uint32_t frame = 0; frame < numFrames; frame++) {
+    const uint8_t *source = samples + static_cast<size_t>(frame) * frameBytes;
+
+    float sum = 0.0f;
+    for (uint16_t ch = 0; ch < format.numChannels; ch++)
+      sum += decodeSample(source + ch * bytesPerSample, format);
+    data.samples[frame] = sum * channelScale;
+  }
+
+  return true;
+}
+
+} // namespace WavReader
@@ -0,0 +1,30 @@
+#ifndef WAV_READER_H
+#define WAV_READER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WavReader {
+
+/* Whole-file WAV reader (imports, not streaming)
+ * - PCM 8/16/24/32 bit and 32/64 bit float, WAVE_FORMAT_EXTENSIBLE too
+ * - channels are averaged down to mono (or kept interleaved, see below)
+ * - picks up the cycle length of wavetable editors ('clm ' chunk, "<!>2048")
+ */
+struct WavData {
+  int32_t sampleRate = 0;
+  uint16_t numChannels = 0; // of the file
+  std::vector<float> samples{}; // mono, or frame-major when interleaved
+
+  // Samples per frame from the 'clm ' chunk (0 = no chunk)
+  uint32_t cycleLength = 0;
+};
+
+// Returns false (and prints why) when the file can't be read or decoded
+// _isInterleaved_: keep every channel (numChannels samples per frame)
+bool readWavFile(const std::string &filename, WavData &data,
+                 bool isInterleaved = false);
+
+} // namespace WavReader
+#endif
@@ -1,8 +1,10 @@
 #include "WavWriter.h"
+#include <algorithm>
 #include <cassert>
 #include <climits>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
@@ -11,6 +13,162 @@
 
 namespace WavWriter {
 
+// ==== Format Helpers ====
+namespace {
+constexpr int16_t FORMAT_PCM = 1;
+constexpr int16_t FORMAT_IEEE_FLOAT = 3;
+
+bool isFloatFormat(SampleFormat format) {
+  return format == SampleFormat::Float32;
+}
+
+// Size of everything before the sample data
+int32_t headerBytes(SampleFormat format) {
+  // RIFF(12) + fmt(8 + 16) + data(8), float adds fmt cbSize(2) + fact(12)
+  return isFloatFormat(format) ? 12 + 8 + 18 + 12 + 8 : 12 + 8 + 16 + 8;
+}
+
+// Convert one sample to little-endian bytes at _dest_
+void encodeSample(float value, SampleFormat format, char *dest) {
+  switch (format) {
+  case SampleFormat::Float32:
+    std::memcpy(dest, &value, 4);
+    return;
+
+  case SampleFormat::PCM24: {
+    value = std::clamp(value, -1.0f, 1.0f);
+    auto pcm = static_cast<int32_t>(value * 8388607.0f);
+    dest[0] = static_cast<char>(pcm & 0xFF);
+    dest[1] = static_cast<char>((pcm >> 8) & 0xFF);
+    dest[2] = static_cast<char>((pcm >> 16) & 0xFF);
+    return;
+  }
+
+  case SampleFormat::PCM16: {
+    // Limit to valid range (-1.0 to 1.0), convert to int16_t
+    value = std::clamp(value, -1.0f, 1.0f);
+    auto pcm = static_cast<int16_t>(value * 32767.0f);
+    std::memcpy(dest, &pcm, 2);
+    return;
+  }
+  }
+}
+
+void flushChunk(WavStream &stream) {
+  if (stream.chunkUsed == 0)
+    return;
+
+  stream.file.write(stream.chunk.data(),
+                    static_cast<std::streamsize>(stream.chunkUsed));
+  stream.chunkUsed = 0;
+}
+
+// Room for at least one more frame, flushing if needed
+char *reserveFrame(WavStream &stream, size_t frameBytes) {
+  if (stream.chunkUsed + frameBytes > stream.chunk.size())
+    flushChunk(stream);
+
+  return stream.chunk.data() + stream.chunkUsed;
+}
+} // namespace
+
+uint16_t bytesPerSample(SampleFormat format) {
+  switch (format) {
+  case SampleFormat::PCM16:
+    return 2;
+  case SampleFormat::PCM24:
+    return 3;
+  case SampleFormat::Float32:
+    return 4;
+  }
+  return 2;
+}
+
+// ==== Streaming API ====
+bool openWavStream(WavStream &stream, const std::string &filename,
+                   int32_t sampleRate, uint16_t numChannels,
+                   SampleFormat format) {
+  stream.file = createWavFile(filename);
+  if (!stream.file)
+    return false;
+
+  stream.sampleRate = sampleRate;
+  stream.numChannels = numChannels;
+  stream.format = format;
+  stream.framesWritten = 0;
+
+  stream.chunk.assign(WAV_CHUNK_BYTES, 0);
+  stream.chunkUsed = 0;
+
+  // Sizes are unknown until close (patched in closeWavStream)
+  writeWavMetadata(stream.file, 0, sampleRate, numChannels, format);
+
+  return static_cast<bool>(stream.file);
+}
+
+void writeInterleaved(WavStream &stream, const float *samples,
+                      size_t numFrames) {
+  const size_t sampleBytes = bytesPerSample(stream.format);
+  const size_t frameBytes = sampleBytes * stream.numChannels;
+
+  for (size_t frame = 0; frame < numFrames; frame++) {
+    char *dest = reserveFrame(stream, frameBytes);
+
+    for (size_t ch = 0; ch < stream.numChannels; ch++)
+      encodeSample(samples[frame * stream.numChannels + ch], stream.format,
+                   dest + ch * sampleBytes);
+
+    stream.chunkUsed += frameBytes;
+  }
+
+  stream.framesWritten += numFrames;
+}
+
+void writePlanar(WavStream &stream, const float *const *channels,
+                 size_t numFrames) {
+  const size_t sampleBytes = bytesPerSample(stream.format);
+  const size_t frameBytes = sampleBytes * stream.numChannels;
+
+  for (size_t frame = 0; frame < numFrames; frame++) {
+    char *dest = reserveFrame(stream, frameBytes);
+
+    for (size_t ch = 0; ch < stream.numChannels; ch++)
+      encodeSample(channels[ch][frame], stream.format, dest + ch * sampleBytes);
+
+    stream.chunkUsed += frameBytes;
+  }
+
+  stream.framesWritten += numFrames;
+}
+
+bool closeWavStream(WavStream &stream) {
+  if (!stream.file.is_open())
+    return false;
+
+  flushChunk(stream);
+
+  // RIFF chunks are word aligned (odd sized data needs a pad byte)
+  uint64_t dataBytes = stream.framesWritten * stream.numChannels *
+                       bytesPerSample(stream.format);
+  if (dataBytes & 1)
+    stream.file.put(0);
+
+  // Patch sizes now that the length is known
+  stream.file.seekp(0);
+  writeWavMetadata(stream.file, stream.framesWritten, stream.sampleRate,
+                   stream.numChannels, stream.format);
+
+  bool isOk = static_cast<bool>(stream.file);
+  stream.file.close();
+
+  // Release the conversion buffer
+  std::vector<char>().swap(stream.chunk);
+  stream.chunkUsed = 0;
+
+  return isOk;
+}
+
+// ==== Low level helpers ====
 // Create WAV file
 // NOTE: std::ofstream doesn't support std::string_view
 std::ofstream createWavFile(const std::string &filename) {
@@ -37,9 +195,19 @@ void writeInt16(std::ofstream &file, int16_t value) {
   file.write(reinterpret_cast<const char *>(&value), 2);
 }
 
-void writeWavMetadata(std::ofstream &file, int32_t numSamples,
-                      int32_t sampleRate) {
-  // WAV files have a specific structure. Let's build it piece by piece:
+void writeWavMetadata(std::ofstream &file, uint64_t numFrames,
+                      int32_t sampleRate, uint16_t numChannels,
+                      SampleFormat format) {
+  const int32_t sampleBytes = bytesPerSample(format);
+  const int32_t blockAlign = numChannels * sampleBytes;
+
+  uint64_t dataBytes64 = numFrames * static_cast<uint64_t>(blockAlign);
+  if (dataBytes64 > static_cast<uint64_t>(INT_MAX - headerBytes(format) - 1))
+    throw std::out_of_range("WAV data too large. Max bytes:" +
+                            std::to_string(INT_MAX));
+
+  const auto dataBytes = static_cast<int32_t>(dataBytes64);
+  const int32_t padByte = dataBytes & 1;
 
   // --- RIFF HEADER ---
   // This identifies the file as a RIFF file (Resource Interchange File
@@ -47,9 +215,7 @@ void writeWavMetadata(std::ofstream &file, int32_t numSamples,
   writeString(file, "RIFF", 4);
 
   // File size minus 8 bytes (for "RIFF" and this size field itself)
-  int32_t fileSize =
-      36 + (numSamples * 2); // 36 = header size, 2 = bytes per sample
-  writeInt32(file, fileSize);
+  writeInt32(file, headerBytes(format) - 8 + dataBytes + padByte);
 
   // WAVE format identifier
   writeString(file, "WAVE", 4);
@@ -58,80 +224,67 @@ void writeWavMetadata(std::ofstream &file, int32_t numSamples,
   // Describes the audio format
   writeString(file, "fmt ", 4); // Note the space after "fmt"
 
-  // Format chunk size (16 bytes for PCM)
-  writeInt32(file, 16);
+  // Format chunk size (16 bytes for PCM, 18 with cbSize for float)
+  bool isFloat = isFloatFormat(format);
+  writeInt32(file, isFloat ? 18 : 16);
 
-  // Audio format (1 = PCM, uncompressed)
-  writeInt16(file, 1);
+  // Audio format (1 = PCM, 3 = IEEE float)
+  writeInt16(file, isFloat ? FORMAT_IEEE_FLOAT : FORMAT_PCM);
 
   // Number of channels (1 = mono, 2 = stereo)
-  writeInt16(file, 1);
+  writeInt16(file, static_cast<int16_t>(numChannels));
 
   // Sample rate (samples per second)
   writeInt32(file, sampleRate);
 
   // Byte rate (sample rate * channels * bytes per sample)
-  writeInt32(file, sampleRate * 1 * 2);
+  writeInt32(file, sampleRate * blockAlign);
 
   // Block align (channels * bytes per sample)
-  writeInt16(file, 1 * 2);
+  writeInt16(file, static_cast<int16_t>(blockAlign));
 
   // Bits per sample
-  writeInt16(file, 16);
+  writeInt16(file, static_cast<int16_t>(sampleBytes * 8));
+
+  if (isFloat) {
+    // cbSize (no extension)
+    writeInt16(file, 0);
+
+    // --- FACT CHUNK (required for non-PCM) ---
+    writeString(file, "fact", 4);
+    writeInt32(file, 4);
+    writeInt32(file, static_cast<int32_t>(numFrames));
+  }
+
+  // --- DATA CHUNK HEADER ---
+  // Samples follow immediately
+  writeString(file, "data", 4);
+  writeInt32(file, dataBytes);
 }
 
 // Write WAV file to disk
-void writeWavFile(const std::string &filename, std::vector<float> &audioBuffer,
-                  int32_t sampleRate) {
+void writeWavFile(const std::string &filename,
+                  const std::vector<float> &audioBuffer, int32_t sampleRate,
+                  SampleFormat format) {
   if (audioBuffer.empty())
     throw std::invalid_argument("Audio buffer is empty");
 
-  if (audioBuffer.size() >= INT_MAX)
-    throw std::out_of_range("Audio buffer is too large. Max:" +
-                            std::to_string(INT_MAX));
-
-  const int32_t TOTAL_SAMPLES{static_cast<int32_t>(audioBuffer.size())};
-
-  std::vector<int16_t> pcmData{};
-  pcmData.reserve(audioBuffer.size());
-
-  for (float sampleValue : audioBuffer) {
-    // Limit to valid range (-1.0 to 1.0)
-    if (sampleValue > 1.0f)
-      sampleValue = 1.0f;
-    if (sampleValue < -1.0f)
-      sampleValue = -1.0f;
-
-    // Convert to int16_t: -32768 to 32767
-    pcmData.push_back(static_cast<int16_t>(sampleValue * 32767.0f));
-  }
-
-  std::ofstream wavFile{createWavFile(filename)};
-
-  if (!wavFile) {
-    std::cerr << "Error: Could not create output.wav\n";
+  WavStream stream{};
+  if (!openWavStream(stream, filename, sampleRate, 1, format)) {
+    std::cerr << "Error: Could not create " << filename << "\n";
+    return;
   }
 
   std::cout << "Writing WAV file...\n";
 
-  writeWavMetadata(wavFile, TOTAL_SAMPLES, sampleRate);
-
-  // --- DATA CHUNK ---
-  // Contains the actual audio samples
-  writeString(wavFile, "data", 4);
+  writeInterleaved(stream, audioBuffer.data(), audioBuffer.size());
 
-  // Data chunk size (number of samples * bytes per sample)
-  writeInt32(wavFile, TOTAL_SAMPLES * 2);
-
-  // Write all the audio samples
-  for (const auto &sample : pcmData) {
-    writeInt16(wavFile, sample);
+  if (!closeWavStream(stream)) {
+    std::cerr << "Error: Could not write " << filename << "\n";
+    return;
   }
 
-  wavFile.close();
-
-  std::cout << "Success! Created output.wav\n";
-  std::cout << "Play it with any audio player to hear your sine wave.\n";
+  std::cout << "Success! Created " << filename << "\n";
 }
 
 } // namespace WavWriter
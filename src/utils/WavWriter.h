@@ -1,12 +1,55 @@
 #ifndef WAV_WRITER_H
 #define WAV_WRITER_H
 
+#include <cstddef>
 #include <cstdint>
 #include <fstream>
 #include <string>
 #include <vector>
 
 namespace WavWriter {
+enum class SampleFormat { PCM16, PCM24, Float32 };
+
+/* Streaming WAV writer
+ * - accepts blocks as they are rendered (memory stays fixed)
+ * - samples are converted into one large chunk buffer and written per chunk
+ * - RIFF/data (and fact) sizes are patched in closeWavStream()
+ */
+struct WavStream {
+  std::ofstream file;
+
+  int32_t sampleRate = 48000;
+  uint16_t numChannels = 1;
+  SampleFormat format = SampleFormat::PCM16;
+
+  uint64_t framesWritten = 0;
+
+  // Conversion buffer (allocated once in openWavStream)
+  std::vector<char> chunk;
+  size_t chunkUsed = 0;
+};
+
+inline constexpr size_t WAV_CHUNK_BYTES = 64 * 1024;
+
+uint16_t bytesPerSample(SampleFormat format);
+
+// Returns false if the file couldn't be created
+bool openWavStream(WavStream &stream, const std::string &filename,
+                   int32_t sampleRate, uint16_t numChannels,
+                   SampleFormat format = SampleFormat::PCM16);
+
+// Interleaved frames (numFrames * numChannels samples)
+void writeInterleaved(WavStream &stream, const float *samples,
+                      size_t numFrames);
+
+// One buffer per channel (numChannels buffers of numFrames samples)
+void writePlanar(WavStream &stream, const float *const *channels,
+                 size_t numFrames);
+
+// Flush and patch the header sizes. Returns false on a write error
+bool closeWavStream(WavStream &stream);
+
+// ==== Low level helpers ====
 // Create WAV file
 std::ofstream createWavFile(const std::string &filename = "output.wav");
 
@@ -19,12 +62,14 @@ void writeInt32(std::ofstream &file, int32_t value);
 // Write int 16 to WAV file
 void writeInt16(std::ofstream &file, int16_t value);
 
-// Write WAV file metadata
-void writeWavMetadata(std::ofstream &file, int32_t numSamples,
-                      int32_t sampleRate);
+// Write RIFF + fmt (+ fact) headers and the data chunk header
+void writeWavMetadata(std::ofstream &file, uint64_t numFrames,
+                      int32_t sampleRate, uint16_t numChannels = 1,
+                      SampleFormat format = SampleFormat::PCM16);
 
-// Write WAVE file to disk
-void writeWavFile(const std::string &filename, std::vector<float> &audioBuffer,
-                  int32_t sampleRate);
+// Write WAVE file to disk (mono, whole buffer at once)
+void writeWavFile(const std::string &filename,
+                  const std::vector<float> &audioBuffer, int32_t sampleRate,
+                  SampleFormat format = SampleFormat::PCM16);
 } // namespace WavWriter
 #endif
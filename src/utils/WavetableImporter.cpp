@@ -0,0 +1,432 @@
+#include "WavetableImporter.h"
+#include "WavReader.h"
+
+#include "synth/Engine.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace synth::utils {
+namespace wt = dsp::wavetable;
+
+// ==== <Source Helpers> ====
+namespace {
+struct SourceFile {
+  std::string path{}; // real path
+  uint64_t bytes = 0;
+  int64_t time = 0;
+};
+
+bool statSource(const std::string &path, SourceFile &source) {
+  char *resolved = realpath(path.c_str(), nullptr);
+  if (!resolved)
+    return false;
+  source.path = resolved;
+  free(resolved);
+
+  struct stat info {};
+  if (stat(source.path.c_str(), &info) != 0)
+    return false;
+
+  source.bytes = static_cast<uint64_t>(info.st_size);
+  source.time = static_cast<int64_t>(info.st_mtime);
+  return true;
+}
+
+// FNV-1a 64 of the real path
+std::string getCachePath(const WavetableImporter &importer,
+                         const std::string &sourcePath) {
+  uint64_t hash = 0xCBF29CE484222325ull;
+  for (char c : sourcePath) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001B3ull;
+  }
+
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx",
+           static_cast<unsigned long long>(hash));
+  return importer.cacheDirectory + "/" + name + WAVETABLE_CACHE_EXTENSION;
+}
+
+// Cycle length + frame count of _wav_ (see Frames in WavetableImporter.h)
+bool splitFrames(const WavReader::WavData &wav, uint32_t &cycleLength,
+                 uint32_t &frameCount) {
+  auto numSamples = static_cast<uint32_t>(wav.samples.size());
+
+  if (wav.cycleLength > 0)
+    cycleLength = wav.cycleLength;
+  else if (numSamples <= wt::MAX_CYCLE_LENGTH)
+    cycleLength = numSamples;
+  else
+    cycleLength = wt::TABLE_SIZE;
+
+  // Cycles need a few samples to hold a shape (and resample from)
+  if (cycleLength < 4 || cycleLength > numSamples)
+    return false;
+
+  frameCount = std::min(numSamples / cycleLength, MAX_WAVETABLE_FRAMES);
+  return true;
+}
+} // namespace
+// ==== </Source Helpers> ====
+
+// ==== <Cache Helpers> ====
+namespace {
+struct CacheHeader {
+  uint32_t magic = WAVETABLE_CACHE_MAGIC;
+  uint32_t version = WAVETABLE_CACHE_VERSION;
+  uint32_t tableSize = wt::TABLE_SIZE;
+  uint32_t mipLevels = wt::MIP_LEVELS;
+  uint32_t frameCount = 0;
+  uint32_t cycleLength = 0;
+  uint64_t sourceBytes = 0;
+  int64_t sourceTime = 0;
+};
+static_assert(sizeof(CacheHeader) <= WAVETABLE_CACHE_HEADER_BYTES);
+
+bool isValidHeader(const CacheHeader &header, const SourceFile &source,
+                   size_t fileBytes) {
+  return header.magic == WAVETABLE_CACHE_MAGIC &&
+         header.version == WAVETABLE_CACHE_VERSION &&
+         header.tableSize == wt::TABLE_SIZE &&
+         header.mipLevels == wt::MIP_LEVELS && header.frameCount > 0 &&
+         header.frameCount <= MAX_WAVETABLE_FRAMES &&
+         header.sourceBytes == source.bytes &&
+         header.sourceTime == source.time &&
+         fileBytes == WAVETABLE_CACHE_HEADER_BYTES +
+                          sizeof(Wavetable) * header.frameCount;
+}
+
+// Read every page once so the audio thread never faults one in, then try
+// to keep them resident (best effort: locking can be refused by limits)
+void prefaultMapping(const void *mapping, size_t numBytes) {
+  const auto *bytes = static_cast<const volatile uint8_t *>(mapping);
+  const auto pageBytes = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+  uint8_t sum = 0;
+  for (size_t offset = 0; offset < numBytes; offset += pageBytes)
+    sum = static_cast<uint8_t>(sum + bytes[offset]);
+  (void)sum;
+
+  mlock(mapping, numBytes);
+}
+
+std::unique_ptr<LoadedWavetable> mapCacheFile(const std::string &cachePath,
+                                              const SourceFile &source) {
+  int fd = open(cachePath.c_str(), O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat info {};
+  CacheHeader header{};
+  bool isValid =
+      fstat(fd, &info) == 0 &&
+      pread(fd, &header, sizeof(header), 0) ==
+          static_cast<ssize_t>(sizeof(header)) &&
+      isValidHeader(header, source, static_cast<size_t>(info.st_size));
+
+  void *mapping = MAP_FAILED;
+  auto numBytes = static_cast<size_t>(info.st_size);
+  if (isValid)
+    mapping = mmap(nullptr, numBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // the mapping keeps the file
+
+  if (mapping == MAP_FAILED)
+    return nullptr;
+
+  prefaultMapping(mapping, numBytes);
+
+  auto table = std::make_unique<LoadedWavetable>();
+  table->mapping = mapping;
+  table->mappingBytes = numBytes;
+  table->frames.frames = reinterpret_cast<const Wavetable *>(
+      static_cast<const uint8_t *>(mapping) + WAVETABLE_CACHE_HEADER_BYTES);
+  table->frames.frameCount = header.frameCount;
+  return table;
+}
+
+bool writeCacheFile(const std::string &cachePath, const SourceFile &source,
+                    const LoadedWavetable &table, uint32_t cycleLength) {
+  uint8_t headerBytes[WAVETABLE_CACHE_HEADER_BYTES] = {};
+  CacheHeader header{};
+  header.frameCount = table.frames.frameCount;
+  header.cycleLength = cycleLength;
+  header.sourceBytes = source.bytes;
+  header.sourceTime = source.time;
+  std::memcpy(headerBytes, &header, sizeof(header));
+
+  std::string tempPath = cachePath + ".tmp";
+  FILE *file = fopen(tempPath.c_str(), "wb");
+  if (!file)
+    return false;
+
+  bool isWritten =
+      fwrite(headerBytes, 1, sizeof(headerBytes), file) ==
+          sizeof(headerBytes) &&
+      fwrite(table.frames.frames, sizeof(Wavetable), table.frames.frameCount,
+             file) == table.frames.frameCount;
+
+  if (fclose(file) != 0 || !isWritten) {
+    remove(tempPath.c_str());
+    return false;
+  }
+  return rename(tempPath.c_str(), cachePath.c_str()) == 0;
+}
+
+void releaseTable(LoadedWavetable &table) {
+  if (table.mapping) {
+    munmap(table.mapping, table.mappingBytes);
+    table.mapping = nullptr;
+  }
+  std::vector<Wavetable>().swap(table.ownedFrames);
+  table.frames = {};
+}
+} // namespace
+// ==== </Cache Helpers> ====
+
+// ==== <Pool Helpers> ====
+namespace {
+void buildBatchFrames(FrameBatch &batch) {
+  for (uint32_t frame = batch.nextFrame.fetch_add(1); frame < batch.frameCount;
+       frame = batch.nextFrame.fetch_add(1)) {
+    wt::buildFromCycle(batch.frames[frame],
+                       batch.samples +
+                           static_cast<size_t>(frame) * batch.cycleLength,
+                       batch.cycleLength);
+  }
+}
+
+void workerLoop(WavetableImporter &importer) {
+  uint64_t seenGeneration = 0;
+
+  std::unique_lock<std::mutex> lock(importer.poolMutex);
+  while (true) {
+    importer.poolWake.wait(lock, [&] {
+      return !importer.isRunning ||
+             importer.batchGeneration != seenGeneration;
+    });
+    if (!importer.isRunning)
+      return;
+
+    seenGeneration = importer.batchGeneration;
+    FrameBatch *batch = importer.batch;
+    if (!batch) // finished before this worker woke up
+      continue;
+
+    importer.busyWorkers++;
+    lock.unlock();
+    buildBatchFrames(*batch);
+    lock.lock();
+
+    if (--importer.busyWorkers == 0)
+      importer.poolDone.notify_all();
+  }
+}
+
+// The calling thread builds frames too; returns once every frame is done
+void buildFrames(WavetableImporter &importer, FrameBatch &batch) {
+  {
+    std::lock_guard<std::mutex> lock(importer.poolMutex);
+    importer.batch = &batch;
+    importer.batchGeneration++;
+  }
+  importer.poolWake.notify_all();
+
+  buildBatchFrames(batch);
+
+  std::unique_lock<std::mutex> lock(importer.poolMutex);
+  importer.batch = nullptr;
+  importer.poolDone.wait(lock, [&] { return importer.busyWorkers == 0; });
+}
+
+std::unique_ptr<LoadedWavetable> importWavFile(WavetableImporter &importer,
+                                               const SourceFile &source,
+                                               const std::string &cachePath) {
+  WavReader::WavData wav{};
+  if (!WavReader::readWavFile(source.path, wav))
+    return nullptr;
+
+  uint32_t cycleLength = 0;
+  uint32_t frameCount = 0;
+  if (!splitFrames(wav, cycleLength, frameCount)) {
+    printf("Error: No wavetable cycle in '%s'\n", source.path.c_str());
+    return nullptr;
+  }
+
+  auto table = std::make_unique<LoadedWavetable>();
+  table->ownedFrames.resize(frameCount);
+
+  FrameBatch batch{};
+  batch.frames = table->ownedFrames.data();
+  batch.samples = wav.samples.data();
+  batch.frameCount = frameCount;
+  batch.cycleLength = cycleLength;
+  buildFrames(importer, batch);
+
+  table->frames.frames = table->ownedFrames.data();
+  table->frames.frameCount = frameCount;
+
+  if (!writeCacheFile(cachePath, source, *table, cycleLength))
+    printf("Wavetable: unable to write cache '%s'\n", cachePath.c_str());
+
+  return table;
+}
+
+LoadedWavetable *findTable(WavetableImporter &importer,
+                           const SourceFile &source) {
+  std::lock_guard<std::mutex> lock(importer.tableMutex);
+  for (const auto &table : importer.tables) {
+    if (table->path == source.path && table->sourceBytes == source.bytes &&
+        table->sourceTime == source.time)
+      return table.get();
+  }
+  return nullptr;
+}
+
+void requestLoop(WavetableImporter &importer) {
+  std::unique_lock<std::mutex> lock(importer.requestMutex);
+  while (true) {
+    importer.requestWake.wait(lock, [&] {
+      return !importer.isRunning || !importer.requests.empty();
+    });
+    if (!importer.isRunning)
+      return;
+
+    WavetableRequest request = std::move(importer.requests.front());
+    importer.requests.pop_front();
+    lock.unlock();
+
+    auto startTime = std::chrono::steady_clock::now();
+    const WavetableFrames *frames = loadWavetable(importer, request.path);
+    if (frames) {
+      publishWavetable(*importer.engine, request.osc, frames);
+
+      std::chrono::duration<double, std::milli> elapsed =
+          std::chrono::steady_clock::now() - startTime;
+      printf("Wavetable: %s (%u frames, %.1f ms)\n", request.path.c_str(),
+             frames->frameCount, elapsed.count());
+    }
+
+    lock.lock();
+  }
+}
+} // namespace
+// ==== </Pool Helpers> ====
+
+bool openWavetableImporter(WavetableImporter &importer, Engine &engine,
+                           const std::string &cacheDirectory) {
+  closeWavetableImporter(importer);
+
+  // mkdir -p
+  for (size_t slash = cacheDirectory.find('/', 1); true;
+       slash = cacheDirectory.find('/', slash + 1)) {
+    std::string directory = cacheDirectory.substr(0, slash);
+    if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST)
+      return false;
+    if (slash == std::string::npos)
+      break;
+  }
+
+  importer.engine = &engine;
+  importer.cacheDirectory = cacheDirectory;
+  importer.isRunning = true;
+
+  uint32_t hardwareThreads = std::thread::hardware_concurrency();
+  uint32_t numWorkers =
+      std::min(hardwareThreads > 1 ? hardwareThreads - 1 : 0,
+               MAX_WAVETABLE_WORKERS);
+
+  for (uint32_t i = 0; i < numWorkers; i++)
+    importer.workers.emplace_back(workerLoop, std::ref(importer));
+  importer.requestThread = std::thread(requestLoop, std::ref(importer));
+
+  return true;
+}
+
+void stopWavetableImporter(WavetableImporter &importer) {
+  {
+    std::lock_guard<std::mutex> requestLock(importer.requestMutex);
+    std::lock_guard<std::mutex> poolLock(importer.poolMutex);
+    importer.isRunning = false;
+    importer.requests.clear();
+  }
+  importer.requestWake.notify_all();
+  importer.poolWake.notify_all();
+
+  if (importer.requestThread.joinable())
+    importer.requestThread.join();
+  for (std::thread &worker : importer.workers)
+    worker.join();
+  importer.workers.clear();
+}
+
+void closeWavetableImporter(WavetableImporter &importer) {
+  stopWavetableImporter(importer);
+
+  for (const auto &table : importer.tables)
+    releaseTable(*table);
+  importer.tables.clear();
+  importer.engine = nullptr;
+}
+
+const WavetableFrames *loadWavetable(WavetableImporter &importer,
+                                     const std::string &path) {
+  SourceFile source{};
+  if (!statSource(path, source)) {
+    printf("Error: Unable to read '%s'\n", path.c_str());
+    return nullptr;
+  }
+
+  if (LoadedWavetable *table = findTable(importer, source))
+    return &table->frames;
+
+  std::lock_guard<std::mutex> loadLock(importer.loadMutex);
+  if (LoadedWavetable *table = findTable(importer, source))
+    return &table->frames; // imported while this load waited
+
+  std::string cachePath = getCachePath(importer, source.path);
+  std::unique_ptr<LoadedWavetable> table = mapCacheFile(cachePath, source);
+  if (!table)
+    table = importWavFile(importer, source, cachePath);
+  if (!table)
+    return nullptr;
+
+  table->path = source.path;
+  table->sourceBytes = source.bytes;
+  table->sourceTime = source.time;
+
+  std::lock_guard<std::mutex> tableLock(importer.tableMutex);
+  importer.tables.push_back(std::move(table));
+  return &importer.tables.back()->frames;
+}
+
+bool requestWavetable(WavetableImporter &importer, const std::string &path,
+                      fm_matrix::FMOsc osc) {
+  {
+    std::lock_guard<std::mutex> lock(importer.requestMutex);
+    if (!importer.isRunning)
+      return false;
+    importer.requests.push_back({path, osc});
+  }
+  importer.requestWake.notify_one();
+  return true;
+}
+
+} // namespace synth::utils
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "synth/FMMatrix.h"
+
+#include "dsp/Wavetable.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace synth {
+struct Engine;
+}
+
+namespace synth::utils {
+using Wavetable = dsp::wavetable::Wavetable;
+using WavetableFrames = dsp::wavetable::WavetableFrames;
+
+/* WAV -> mipmapped wavetable import, all of it off the audio thread
+ * - a cache hit is one mmap: the mips are stored exactly as the oscillator
+ *   reads them, nothing is decoded, transformed or copied
+ * - a miss reads the WAV, builds the frames' mips on a worker pool (frames
+ *   are independent) and writes the cache file (tmp file + rename)
+ * - tables stay loaded until closeWavetableImporter: loading a path again
+ *   (e.g. the next preset using it) costs a lookup
+ * - requestWavetable loads on a background thread, then publishes to the
+ *   oscillator (synth::publishWavetable, swapped at a block boundary)
+ *
+ * Frames: a 'clm ' chunk gives the cycle length; otherwise files up to
+ * MAX_CYCLE_LENGTH samples are one cycle and longer ones are TABLE_SIZE
+ * sample frames (the layout multi-frame editors export)
+ *
+ * Cache file (<cacheDir>/<hash of the WAV's real path>.mwt), host order:
+ *   header | magic u32 | version u32 | tableSize u32 | mipLevels u32 |
+ *            frameCount u32 | cycleLength u32 | sourceBytes u64 |
+ *            sourceTime i64 (mtime, s), zero padded to
+ *            WAVETABLE_CACHE_HEADER_BYTES
+ *   frames | Wavetable x frameCount
+ * Not portable on purpose (a foreign byte order fails the magic check and
+ * is rebuilt); a changed WAV (size/mtime) or version is rebuilt too
+ */
+inline constexpr const char *WAVETABLE_CACHE_EXTENSION = ".mwt";
+
+inline constexpr uint32_t WAVETABLE_CACHE_MAGIC = 0x5748454D; // "MEHW"
+// Bump when the mip generation changes (old caches get rebuilt)
+inline constexpr uint32_t WAVETABLE_CACHE_VERSION = 1;
+
+// Frames start cache line aligned in the mapping
+inline constexpr size_t WAVETABLE_CACHE_HEADER_BYTES = 64;
+
+inline constexpr uint32_t MAX_WAVETABLE_FRAMES = 256;
+
+// Frame builders besides the loading thread (hardware threads - 1, capped)
+inline constexpr uint32_t MAX_WAVETABLE_WORKERS = 8;
+
+struct LoadedWavetable {
+  std::string path{}; // real path of the WAV
+  WavetableFrames frames{};
+
+  // Source state the frames were built from (reloads check it)
+  uint64_t sourceBytes = 0;
+  int64_t sourceTime = 0;
+
+  // Cache mapping (the frames point into it), pages touched + locked
+  void *mapping = nullptr;
+  size_t mappingBytes = 0;
+
+  // Freshly imported frames (the cache file is for the next load)
+  std::vector<Wavetable> ownedFrames{};
+};
+
+// Frames of one table being built, shared by every pool thread
+struct FrameBatch {
+  Wavetable *frames = nullptr;
+  const float *samples = nullptr;
+  uint32_t frameCount = 0;
+  uint32_t cycleLength = 0;
+  std::atomic<uint32_t> nextFrame{0};
+};
+
+struct WavetableRequest {
+  std::string path{};
+  fm_matrix::FMOsc osc = fm_matrix::Osc1;
+};
+
+struct WavetableImporter {
+  Engine *engine = nullptr;
+  std::string cacheDirectory{};
+
+  // ==== Loaded tables (tableMutex), addresses never change ====
+  std::mutex tableMutex{};
+  std::vector<std::unique_ptr<LoadedWavetable>> tables{};
+
+  // One import at a time (the pool splits its frames)
+  std::mutex loadMutex{};
+
+  // ==== Frame pool (poolMutex) ====
+  std::mutex poolMutex{};
+  std::condition_variable poolWake{};
+  std::condition_variable poolDone{};
+  FrameBatch *batch = nullptr;
+  uint64_t batchGeneration = 0;
+  uint32_t busyWorkers = 0;
+  std::vector<std::thread> workers{};
+
+  // ==== Background requests (requestMutex) ====
+  std::mutex requestMutex{};
+  std::condition_variable requestWake{};
+  std::deque<WavetableRequest> requests{};
+  std::thread requestThread{};
+
+  bool isRunning = false; // poolMutex + requestMutex
+
+  WavetableImporter() = default;
+  WavetableImporter(const WavetableImporter &) = delete;
+  WavetableImporter &operator=(const WavetableImporter &) = delete;
+};
+
+// Starts the pool + request thread, creates _cacheDirectory_ if needed
+// Returns false when the directory can't be created
+bool openWavetableImporter(WavetableImporter &importer, Engine &engine,
+                           const std::string &cacheDirectory);
+
+// Joins every thread (pending requests are dropped), tables stay loaded
+// (e.g. quitting while the audio thread may still be playing them)
+void stopWavetableImporter(WavetableImporter &importer);
+
+// Stops, then unmaps/frees every table
+// NOTE: the audio session must be stopped first (oscillators point into
+// the tables)
+void closeWavetableImporter(WavetableImporter &importer);
+
+inline bool isWavetableImporterOpen(const WavetableImporter &importer) {
+  return importer.engine != nullptr;
+}
+
+// Blocking: cache/import _path_ (any thread but the audio thread)
+// Returns nullptr (and prints why) on error
+const WavetableFrames *loadWavetable(WavetableImporter &importer,
+                                     const std::string &path);
+
+// Non-blocking: load on the request thread, then publish to _osc_
+// Returns false when the importer isn't open
+bool requestWavetable(WavetableImporter &importer, const std::string &path,
+                      fm_matrix::FMOsc osc);
+
+} // namespace synth::utils
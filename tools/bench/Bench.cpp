@@ -0,0 +1,281 @@
+/* Render path microbenchmarks (`make bench`)
+ *
+ * Sweeps active voice count, waveform, filter setup and mod route count and
+ * times voices::processVoices (one engine block) and
+ * Engine::processAudioBlock (one audio buffer) in isolation.
+ *
+ * Output is CSV on stdout (one row per case) so runs can be diffed/tracked:
+ *   bench,voices,waveform,filters,routes,ns_per_voice_sample,rt_percent
+ *
+ * rt_percent = time per audio buffer / buffer duration at 48 kHz, 512 frames
+ *
+ * Usage: bench [--blocks <n>] [--quick] [--isa <baseline|avx2>] [--scratch]
+ *              [--layout]
+ *   --isa forces a kernel set (default: best for this CPU, see dsp/Dispatch.h)
+ *   --scratch prints each case's scratch arena high-water mark (stderr)
+ *   --layout prints the Engine hot/cold member layout and exits
+ */
+#include "synth/Engine.h"
+#include "synth/ModMatrix.h"
+#include "synth/ParamBindings.h"
+#include "synth/Types.h"
+#include "synth/VoicePool.h"
+
+#include "synth_io/Events.h"
+
+#include "dsp/Dispatch.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+namespace pb = synth::param::bindings;
+namespace mm = synth::mod_matrix;
+
+using WaveformType = synth::WaveformType;
+using Clock = std::chrono::steady_clock;
+
+constexpr float SAMPLE_RATE = 48000.0f;
+constexpr uint32_t NUM_FRAMES = 512;
+
+// ==== Sweep Dimensions ====
+// Counts above synth::POLYPHONY (build setting) are skipped
+constexpr uint32_t VOICE_COUNTS[] = {1, 2, 4, 8, 16, 32, 64, 128, 256};
+
+struct WaveformCase {
+  const char *name;
+  WaveformType type;
+};
+constexpr WaveformCase WAVEFORMS[] = {
+    {"sine", WaveformType::Sine},         {"saw", WaveformType::Saw},
+    {"square", WaveformType::Square},     {"triangle", WaveformType::Triangle},
+    {"wavetable", WaveformType::Wavetable},
+};
+
+struct FilterCase {
+  const char *name;
+  bool svf;
+  bool ladder;
+  int8_t oversampling; // ladder drive path (log2 factor)
+};
+constexpr FilterCase FILTERS[] = {
+    {"none", false, false, 0},       {"svf", true, false, 0},
+    {"ladder", false, true, 0},      {"svf+ladder", true, true, 0},
+    {"ladder-os2x", false, true, 1}, {"ladder-os4x", false, true, 2},
+};
+
+// Extra routes on top of the two default filterEnv routes
+constexpr uint32_t ROUTE_COUNTS[] = {0, 4, 8, 14};
+
+const mm::ModRoute EXTRA_ROUTES[] = {
+    {mm::ModSrc::FilterEnv, mm::ModDest::SVFCutoff, 2.0f},
+    {mm::ModSrc::ModEnv, mm::ModDest::Osc1Pitch, 0.5f},
+    {mm::ModSrc::Velocity, mm::ModDest::Osc2Mix, -0.2f},
+    {mm::ModSrc::FilterEnv, mm::ModDest::LadderCutoff, 1.5f},
+    {mm::ModSrc::ModEnv, mm::ModDest::Osc2Pitch, 0.25f},
+    {mm::ModSrc::ModEnv, mm::ModDest::SVFResonance, 0.2f},
+    {mm::ModSrc::Velocity, mm::ModDest::Osc1Mix, 0.1f},
+    {mm::ModSrc::AmpEnv, mm::ModDest::Osc3Pitch, 0.1f},
+    {mm::ModSrc::ModEnv, mm::ModDest::SubOscPitch, 0.1f},
+    {mm::ModSrc::Velocity, mm::ModDest::LadderResonance, 0.1f},
+    {mm::ModSrc::FilterEnv, mm::ModDest::Osc3Mix, 0.1f},
+    {mm::ModSrc::ModEnv, mm::ModDest::SubOscMix, -0.1f},
+    {mm::ModSrc::AmpEnv, mm::ModDest::SVFCutoff, 0.5f},
+    {mm::ModSrc::Velocity, mm::ModDest::Osc3Pitch, 0.05f},
+};
+
+struct BenchCase {
+  uint32_t numVoices;
+  const WaveformCase *waveform;
+  const FilterCase *filter;
+  uint32_t numRoutes;
+};
+
+// Keeps the optimizer from dropping the render
+volatile float benchSink = 0.0f;
+
+// ==== Engine Setup ====
+synth::Engine *createBenchEngine(const BenchCase &bench) {
+  synth::EngineConfig config{};
+  config.sampleRate = SAMPLE_RATE;
+  config.numFrames = NUM_FRAMES;
+  config.osc1.waveform = bench.waveform->type;
+  config.osc2 = {bench.waveform->type, 0.5f, -1, -10.0f, true};
+  config.osc3 = {bench.waveform->type, 0.3f, 1, 7.0f, true};
+
+  // Measure every requested voice (no load based voice cap)
+  config.isVoiceGovernorEnabled = false;
+
+  synth::Engine *engine = synth::createEngine(config);
+
+  // Voices hold at sustain for the whole measurement
+  engine->processParamEvent({pb::AMP_ENV_SUSTAIN_LEVEL, 1.0f});
+  engine->processParamEvent({pb::SVF_ENABLED, bench.filter->svf ? 1.0f : 0.0f});
+  engine->processParamEvent(
+      {pb::LADDER_ENABLED, bench.filter->ladder ? 1.0f : 0.0f});
+  engine->processParamEvent({pb::LADDER_DRIVE, 1.5f});
+  engine->processParamEvent({pb::LADDER_OVERSAMPLING,
+                             static_cast<float>(bench.filter->oversampling)});
+
+  for (uint32_t r = 0; r < bench.numRoutes; r++)
+    mm::addRoute(engine->voicePool.modMatrix, EXTRA_ROUTES[r]);
+
+  for (uint32_t v = 0; v < bench.numVoices; v++)
+    engine->processNoteEvent({synth_io::NoteEventType::NoteOn,
+                              static_cast<uint8_t>(36 + v % 64), 100});
+
+  return engine;
+}
+
+// ==== Timed Loops ====
+double timeProcessVoices(synth::Engine &engine, uint32_t numBlocks) {
+  float left[synth::ENGINE_BLOCK_SIZE];
+  float right[synth::ENGINE_BLOCK_SIZE];
+
+  auto start = Clock::now();
+  for (uint32_t b = 0; b < numBlocks; b++) {
+    synth::scratch::resetScratchArena(engine.scratch);
+    synth::voices::processVoices(engine.voicePool, left, right,
+                                 engine.controlBlockSize, engine.scratch);
+    benchSink = benchSink + left[0] + right[0];
+  }
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+      .count();
+}
+
+double timeProcessAudioBlock(synth::Engine &engine, uint32_t numBuffers) {
+  float left[NUM_FRAMES];
+  float right[NUM_FRAMES];
+  float *channels[2] = {left, right};
+
+  auto start = Clock::now();
+  for (uint32_t b = 0; b < numBuffers; b++) {
+    engine.processAudioBlock(channels, 2, NUM_FRAMES);
+    benchSink = benchSink + left[0];
+  }
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+      .count();
+}
+
+void printRow(const char *name, const BenchCase &bench, double elapsedNs,
+              double numSamples) {
+  constexpr double BUFFER_NS =
+      static_cast<double>(NUM_FRAMES) / SAMPLE_RATE * 1.0e9;
+
+  double nsPerSample = elapsedNs / numSamples;
+  double nsPerVoiceSample = nsPerSample / bench.numVoices;
+  double rtPercent = nsPerSample * NUM_FRAMES / BUFFER_NS * 100.0;
+
+  printf("%s,%u,%s,%s,%u,%.3f,%.3f\n", name, bench.numVoices,
+         bench.waveform->name, bench.filter->name, bench.numRoutes,
+         nsPerVoiceSample, rtPercent);
+}
+
+void runCase(const BenchCase &bench, uint32_t numBlocks,
+             bool isScratchReport) {
+  constexpr uint32_t WARMUP_BLOCKS = 32;
+  constexpr uint32_t BLOCKS_PER_BUFFER =
+      NUM_FRAMES / synth::DEFAULT_CONTROL_BLOCK_SIZE;
+
+  // processVoices (one engine block at a time, default control rate)
+  {
+    auto engine = createBenchEngine(bench);
+    timeProcessVoices(*engine, WARMUP_BLOCKS);
+
+    double elapsed = timeProcessVoices(*engine, numBlocks);
+    printRow("processVoices", bench, elapsed,
+             static_cast<double>(numBlocks) *
+                 synth::DEFAULT_CONTROL_BLOCK_SIZE);
+    synth::disposeEngine(engine);
+  }
+
+  // processAudioBlock (includes channel copy)
+  {
+    auto engine = createBenchEngine(bench);
+    uint32_t numBuffers = numBlocks / BLOCKS_PER_BUFFER + 1;
+    timeProcessAudioBlock(*engine, WARMUP_BLOCKS / BLOCKS_PER_BUFFER);
+
+    double elapsed = timeProcessAudioBlock(*engine, numBuffers);
+    printRow("processAudioBlock", bench, elapsed,
+             static_cast<double>(numBuffers) * NUM_FRAMES);
+
+    if (isScratchReport)
+      synth::printScratchReport(*engine);
+
+    synth::disposeEngine(engine);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  uint32_t numBlocks = 2000;
+  bool isQuick = false;
+  bool isScratchReport = false;
+  bool isLayoutReport = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--blocks") == 0 && i + 1 < argc)
+      numBlocks = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    else if (strcmp(argv[i], "--quick") == 0)
+      isQuick = true;
+    else if (strcmp(argv[i], "--scratch") == 0)
+      isScratchReport = true;
+    else if (strcmp(argv[i], "--layout") == 0)
+      isLayoutReport = true;
+    else if (strcmp(argv[i], "--isa") == 0 && i + 1 < argc) {
+      namespace dispatch = dsp::dispatch;
+      const char *name = argv[++i];
+      if (!dispatch::setKernelIsa(dispatch::findKernelIsaByName(name))) {
+        printf("Error: '%s' kernels not available on this CPU\n", name);
+        return 1;
+      }
+    } else {
+      printf("Usage: bench [--blocks <n>] [--quick] [--isa <baseline|avx2>] "
+             "[--scratch] [--layout]\n");
+      return 1;
+    }
+  }
+
+  // Kernel set in use goes to stderr (stdout stays plain CSV)
+  dsp::dispatch::initKernelDispatch();
+  fprintf(stderr, "kernels: %s\n",
+          dsp::dispatch::getKernelIsaName(dsp::dispatch::getKernelIsa()));
+
+  if (isLayoutReport) {
+    synth::EngineConfig config{};
+    config.sampleRate = SAMPLE_RATE;
+    config.numFrames = NUM_FRAMES;
+
+    synth::Engine *engine = synth::createEngine(config);
+    synth::printEngineLayout(*engine);
+    synth::disposeEngine(engine);
+    return 0;
+  }
+
+  printf("bench,voices,waveform,filters,routes,ns_per_voice_sample,"
+         "rt_percent\n");
+
+  for (const FilterCase &filter : FILTERS) {
+    for (const WaveformCase &waveform : WAVEFORMS) {
+      for (uint32_t routes : ROUTE_COUNTS) {
+        for (uint32_t voices : VOICE_COUNTS) {
+          if (voices > synth::POLYPHONY)
+            continue;
+
+          // Quick mode: full voice sweep on a single representative patch
+          if (isQuick && (waveform.type != WaveformType::Saw || routes != 4))
+            continue;
+
+          runCase({voices, &waveform, &filter, routes}, numBlocks,
+                  isScratchReport);
+        }
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,203 @@
+/* Fast math accuracy gate (`make math-accuracy`)
+ *
+ * Sweeps the dsp::math approximations over their documented input ranges
+ * against double precision libm, scalar and block (SIMD) forms, and fails
+ * when a max error goes past the bound documented in dsp/Math.h.
+ *
+ * Output: one row per function/form/range
+ *   function  form  range  error  measured  bound  result
+ *
+ * Usage: math-accuracy [--points <n>]
+ *   --points   inputs per range (default 1048576), log spaced for fastLog2
+ *
+ * Exit code: 0 = every bound held, 1 = a failure
+ *
+ * NOTE: fastCos is scalar only (dsp/Math.h has no block form)
+ */
+#include "dsp/Math.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+namespace dm = dsp::math;
+
+using ScalarFn = float (*)(float);
+using BlockFn = void (*)(const float *, float *, size_t);
+using ReferenceFn = double (*)(double);
+
+enum class ErrorKind : uint8_t { Absolute, Relative };
+
+struct AccuracyCase {
+  const char *name;
+  ScalarFn scalar;
+  BlockFn block; // nullptr: scalar only
+  ReferenceFn reference;
+
+  float lo;
+  float hi;
+  bool isLogSpaced;
+
+  ErrorKind kind;
+  double maxError; // as documented in dsp/Math.h
+};
+
+double sinPhaseReference(double phase) {
+  return std::sin(2.0 * dm::PI_DOUBLE * phase);
+}
+double sinReference(double x) { return std::sin(x); }
+double cosReference(double x) { return std::cos(x); }
+double tanReference(double x) { return std::tan(x); }
+double tanhReference(double x) { return std::tanh(x); }
+double log2Reference(double x) { return std::log2(x); }
+double exp2Reference(double x) { return std::exp2(x); }
+
+// Bounds straight from dsp/Math.h (keep both in sync); fastSin/fastCos
+// evaluate 5e-7 + 2e-7 * |x| at the end of the range
+const AccuracyCase CASES[] = {
+    {"fastSinPhase", dm::fastSinPhase, dm::fastSinPhaseBlock,
+     sinPhaseReference, -1.0f, 1.0f, false, ErrorKind::Absolute, 5e-7},
+    {"fastSinPhase", dm::fastSinPhase, dm::fastSinPhaseBlock,
+     sinPhaseReference, -1000.0f, 1000.0f, false, ErrorKind::Absolute, 5e-7},
+    {"fastSin", dm::fastSin, dm::fastSinBlock, sinReference, -dm::PI_F,
+     dm::PI_F, false, ErrorKind::Absolute, 1.2e-6},
+    {"fastSin", dm::fastSin, dm::fastSinBlock, sinReference, -1000.0f,
+     1000.0f, false, ErrorKind::Absolute, 2e-4},
+    {"fastCos", dm::fastCos, nullptr, cosReference, -dm::PI_F, dm::PI_F,
+     false, ErrorKind::Absolute, 1.2e-6},
+    {"fastCos", dm::fastCos, nullptr, cosReference, -1000.0f, 1000.0f, false,
+     ErrorKind::Absolute, 2e-4},
+    {"fastTan", dm::fastTan, dm::fastTanBlock, tanReference, -1.5f, 1.5f,
+     false, ErrorKind::Relative, 2e-5},
+    {"fastTanh", dm::fastTanh, dm::fastTanhBlock, tanhReference, -8.0f, 8.0f,
+     false, ErrorKind::Absolute, 3e-2},
+    {"fastLog2", dm::fastLog2, dm::fastLog2Block, log2Reference,
+     1.0f / 65536.0f, 65536.0f, true, ErrorKind::Absolute, 5e-6},
+    {"fastExp2", dm::fastExp2, dm::fastExp2Block, exp2Reference, 0.0f, 16.0f,
+     false, ErrorKind::Relative, 1e-5},
+    {"fastExp2", dm::fastExp2, dm::fastExp2Block, exp2Reference, -16.0f,
+     0.0f, false, ErrorKind::Relative, 1e-5},
+};
+
+// Block calls are this long (several SIMD widths plus a ragged tail)
+constexpr size_t CHUNK_SIZE = 4099;
+
+// _numPoints_ inputs over [lo, hi], both ends included
+std::vector<float> makeInputs(const AccuracyCase &accuracyCase,
+                              size_t numPoints) {
+  std::vector<float> inputs(numPoints);
+  double lo = accuracyCase.isLogSpaced ? std::log2(accuracyCase.lo)
+                                       : accuracyCase.lo;
+  double hi = accuracyCase.isLogSpaced ? std::log2(accuracyCase.hi)
+                                       : accuracyCase.hi;
+
+  for (size_t i = 0; i < numPoints; i++) {
+    double t = static_cast<double>(i) / static_cast<double>(numPoints - 1);
+    double x = lo + (hi - lo) * t;
+    inputs[i] = static_cast<float>(accuracyCase.isLogSpaced ? std::exp2(x)
+                                                            : x);
+  }
+
+  // Rounding to float can step just past the range
+  for (float &input : inputs)
+    input = std::clamp(input, accuracyCase.lo, accuracyCase.hi);
+
+  return inputs;
+}
+
+double measureError(const AccuracyCase &accuracyCase, float input,
+                    float output) {
+  double expected = accuracyCase.reference(static_cast<double>(input));
+  double error = std::fabs(static_cast<double>(output) - expected);
+
+  if (accuracyCase.kind == ErrorKind::Relative && expected != 0.0)
+    error /= std::fabs(expected);
+
+  return error;
+}
+
+double sweepScalar(const AccuracyCase &accuracyCase,
+                   const std::vector<float> &inputs) {
+  double maxError = 0.0;
+  for (float input : inputs)
+    maxError = std::max(maxError, measureError(accuracyCase, input,
+                                               accuracyCase.scalar(input)));
+  return maxError;
+}
+
+double sweepBlock(const AccuracyCase &accuracyCase,
+                  const std::vector<float> &inputs) {
+  std::vector<float> outputs(inputs.size());
+  for (size_t start = 0; start < inputs.size(); start += CHUNK_SIZE) {
+    size_t count = std::min(CHUNK_SIZE, inputs.size() - start);
+    accuracyCase.block(inputs.data() + start, outputs.data() + start, count);
+  }
+
+  double maxError = 0.0;
+  for (size_t i = 0; i < inputs.size(); i++)
+    maxError = std::max(maxError,
+                        measureError(accuracyCase, inputs[i], outputs[i]));
+  return maxError;
+}
+
+// Prints the row, returns false past the bound
+bool reportCase(const AccuracyCase &accuracyCase, const char *form,
+                double measured) {
+  bool isOk = measured <= accuracyCase.maxError;
+  printf("%-13s %-7s [%10g, %-9g] %-4s %9.2e %9.2e  %s\n", accuracyCase.name,
+         form, static_cast<double>(accuracyCase.lo),
+         static_cast<double>(accuracyCase.hi),
+         accuracyCase.kind == ErrorKind::Absolute ? "abs" : "rel", measured,
+         accuracyCase.maxError, isOk ? "ok" : "FAIL");
+  return isOk;
+}
+
+void printUsage() { printf("Usage: math-accuracy [--points <n>]\n"); }
+} // namespace
+
+int main(int argc, char **argv) {
+  size_t numPoints = 1u << 20;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--points") == 0 && i + 1 < argc) {
+      numPoints = std::strtoul(argv[++i], nullptr, 10);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  if (numPoints < 2) {
+    printf("Error: --points must be at least 2\n");
+    return 1;
+  }
+
+  printf("%-13s %-7s %-23s %-4s %9s %9s  %s\n", "function", "form", "range",
+         "err", "measured", "bound", "result");
+
+  uint32_t failures = 0;
+  for (const AccuracyCase &accuracyCase : CASES) {
+    std::vector<float> inputs = makeInputs(accuracyCase, numPoints);
+
+    if (!reportCase(accuracyCase, "scalar", sweepScalar(accuracyCase, inputs)))
+      failures++;
+
+    if (accuracyCase.block &&
+        !reportCase(accuracyCase, "block", sweepBlock(accuracyCase, inputs)))
+      failures++;
+  }
+
+  if (failures > 0) {
+    printf("%u case(s) past the documented bound (dsp/Math.h)\n", failures);
+    return 1;
+  }
+
+  printf("All bounds held\n");
+  return 0;
+}
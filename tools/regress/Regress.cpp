@@ -0,0 +1,452 @@
+/* Regression gate: golden output + render time baselines (`make regress`)
+ *
+ * Renders every case of a corpus with the offline renderer (tools/render)
+ * and checks it against baselines recorded by an earlier --update run:
+ * - output: largest sample difference vs the golden render (--tolerance),
+ *   so SIMD/approximation changes pass as long as they stay below it
+ * - time: fastest of --runs renders vs the baseline (--max-slowdown %)
+ *   Cases under --min-time are too short to time on their own, they only
+ *   count towards the corpus total (always checked)
+ *
+ * Usage: regress [options]
+ *   --render <path>        renderer binary (default build/render)
+ *   --corpus <file>        case list (default tools/regress/corpus/cases.txt)
+ *   --dir <path>           goldens + timings (default _regress_)
+ *   --tolerance <linear>   max sample difference (default 1e-4, -80 dBFS)
+ *   --max-slowdown <pct>   default 10
+ *   --min-time <ms>        shortest baseline timed per case (default 10)
+ *   --runs <n>             renders per case, fastest counts (default 5)
+ *   --filter <text>        only cases whose name contains it
+ *   --update               record goldens + timings instead of checking
+ *
+ * Corpus: one case per line, '#' starts a comment
+ *   <name> <events.txt> [render options]
+ * Event paths are relative to the corpus file, options go to render as-is
+ * (--format float is added). Renders of the last check are kept in
+ * <dir>/current for listening/diffing.
+ *
+ * Exit code: 0 = every case passed (or updated), 1 = a failure
+ *
+ * NOTE: baselines are per machine + build flags (-ffast-math, VOICES=...):
+ * record them on the base commit with the same make flags, e.g.
+ *   git stash && make regress-update && git stash pop && make regress
+ */
+#include "utils/WavReader.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct RegressOptions {
+  std::string renderPath = "build/render";
+  std::string corpusPath = "tools/regress/corpus/cases.txt";
+  std::string directory = "_regress_";
+  float tolerance = 1.0e-4f;
+  double maxSlowdownPercent = 10.0;
+  double minTimeMs = 10.0;
+  uint32_t numRuns = 5;
+  std::string filter;
+  bool isUpdate = false;
+};
+
+struct RegressCase {
+  std::string name;
+  std::string eventPath;
+  std::string renderOptions;
+};
+
+struct CaseResult {
+  bool isOutputOk = false;
+  bool isTimed = false; // baseline long enough to check on its own
+  bool isTimeOk = true;
+  float maxError = 0.0f;
+  double seconds = 0.0;
+  double baselineSeconds = 0.0; // 0 = no baseline
+};
+
+constexpr const char *TIMINGS_FILE = "timings.txt";
+constexpr const char *CURRENT_DIRECTORY = "current";
+
+void printUsage() {
+  printf("Usage: regress [options]\n");
+  printf("  --render <path>        default build/render\n");
+  printf("  --corpus <file>        default tools/regress/corpus/cases.txt\n");
+  printf("  --dir <path>           goldens + timings (default _regress_)\n");
+  printf("  --tolerance <linear>   max sample difference (default 1e-4)\n");
+  printf("  --max-slowdown <pct>   default 10\n");
+  printf("  --min-time <ms>        shortest baseline timed per case "
+         "(default 10)\n");
+  printf("  --runs <n>             renders per case (default 5)\n");
+  printf("  --filter <text>        only cases whose name contains it\n");
+  printf("  --update               record goldens + timings\n");
+}
+
+bool parseOptions(int argc, char **argv, RegressOptions &options) {
+  for (int i = 1; i < argc; i++) {
+    const char *flag = argv[i];
+    if (strcmp(flag, "--update") == 0) {
+      options.isUpdate = true;
+      continue;
+    }
+
+    if (i + 1 >= argc) {
+      printf("Error: Missing value for '%s'\n", flag);
+      return false;
+    }
+    const char *value = argv[++i];
+
+    if (strcmp(flag, "--render") == 0)
+      options.renderPath = value;
+    else if (strcmp(flag, "--corpus") == 0)
+      options.corpusPath = value;
+    else if (strcmp(flag, "--dir") == 0)
+      options.directory = value;
+    else if (strcmp(flag, "--tolerance") == 0)
+      options.tolerance = std::max(std::strtof(value, nullptr), 0.0f);
+    else if (strcmp(flag, "--max-slowdown") == 0)
+      options.maxSlowdownPercent = std::max(std::strtod(value, nullptr), 0.0);
+    else if (strcmp(flag, "--min-time") == 0)
+      options.minTimeMs = std::max(std::strtod(value, nullptr), 0.0);
+    else if (strcmp(flag, "--runs") == 0)
+      options.numRuns = std::max(
+          static_cast<uint32_t>(std::strtoul(value, nullptr, 10)), 1u);
+    else if (strcmp(flag, "--filter") == 0)
+      options.filter = value;
+    else {
+      printf("Error: Unknown option '%s'\n", flag);
+      return false;
+    }
+  }
+  return true;
+}
+
+// ==== <Corpus Helpers> ====
+bool loadCorpus(const std::string &path, std::vector<RegressCase> &cases) {
+  std::ifstream file(path);
+  if (!file) {
+    printf("Error: Could not open '%s'\n", path.c_str());
+    return false;
+  }
+
+  size_t slash = path.rfind('/');
+  std::string baseDirectory =
+      slash == std::string::npos ? "" : path.substr(0, slash + 1);
+
+  std::string line;
+  uint32_t lineNumber = 0;
+  while (std::getline(file, line)) {
+    lineNumber++;
+    std::istringstream iss(line.substr(0, line.find('#')));
+
+    RegressCase regressCase{};
+    std::string eventFile;
+    if (!(iss >> regressCase.name))
+      continue; // blank/comment line
+
+    if (!(iss >> eventFile)) {
+      printf("Error (line %u): Expected an event file\n", lineNumber);
+      return false;
+    }
+    regressCase.eventPath = baseDirectory + eventFile;
+
+    std::string option;
+    while (iss >> option)
+      regressCase.renderOptions += " " + option;
+
+    cases.push_back(regressCase);
+  }
+  return true;
+}
+
+// "name seconds" per line
+std::map<std::string, double> loadTimings(const std::string &path) {
+  std::map<std::string, double> timings;
+  std::ifstream file(path);
+
+  std::string name;
+  double seconds = 0.0;
+  while (file >> name >> seconds)
+    timings[name] = seconds;
+  return timings;
+}
+
+bool saveTimings(const std::string &path,
+                 const std::map<std::string, double> &timings) {
+  FILE *file = fopen(path.c_str(), "w");
+  if (!file)
+    return false;
+
+  for (const auto &[name, seconds] : timings)
+    fprintf(file, "%s %.6f\n", name.c_str(), seconds);
+  return fclose(file) == 0;
+}
+
+// mkdir -p
+bool makeDirectories(const std::string &path) {
+  for (size_t slash = path.find('/', 1); true;
+       slash = path.find('/', slash + 1)) {
+    std::string directory = path.substr(0, slash);
+    if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST)
+      return false;
+    if (slash == std::string::npos)
+      return true;
+  }
+}
+// ==== </Corpus Helpers> ====
+
+// ==== <Render Helpers> ====
+std::string quoteArgument(const std::string &argument) {
+  std::string quoted = "'";
+  for (char c : argument)
+    quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+  return quoted + "'";
+}
+
+/* Renders _regressCase_ to _outputPath_, _seconds_ = render loop time as
+ * reported by the renderer (no process start/file IO)
+ * Returns false if the render failed (its output is printed)
+ */
+bool renderCase(const RegressOptions &options, const RegressCase &regressCase,
+                const std::string &outputPath, double &seconds) {
+  std::string command = quoteArgument(options.renderPath) + " " +
+                        quoteArgument(regressCase.eventPath) + " " +
+                        quoteArgument(outputPath) + " --format float" +
+                        regressCase.renderOptions + " 2>&1";
+
+  FILE *pipe = popen(command.c_str(), "r");
+  if (!pipe) {
+    printf("Error: Could not run '%s'\n", options.renderPath.c_str());
+    return false;
+  }
+
+  std::string output;
+  char line[512];
+  bool hasTime = false;
+  while (fgets(line, sizeof(line), pipe)) {
+    output += line;
+    double audioSeconds = 0.0;
+    if (sscanf(line, "Rendered %lfs of audio in %lfs", &audioSeconds,
+               &seconds) == 2)
+      hasTime = true;
+  }
+
+  if (pclose(pipe) != 0 || !hasTime) {
+    printf("Error: Render of '%s' failed:\n%s", regressCase.name.c_str(),
+           output.c_str());
+    return false;
+  }
+  return true;
+}
+
+// Fastest of numRuns renders
+bool renderCaseTimed(const RegressOptions &options,
+                     const RegressCase &regressCase,
+                     const std::string &outputPath, double &seconds) {
+  seconds = 0.0;
+  for (uint32_t run = 0; run < options.numRuns; run++) {
+    double runSeconds = 0.0;
+    if (!renderCase(options, regressCase, outputPath, runSeconds))
+      return false;
+    seconds = run == 0 ? runSeconds : std::min(seconds, runSeconds);
+  }
+  return true;
+}
+
+/* Largest sample difference between two renders
+ * Returns false (and prints why) if they can't be compared at all
+ * (missing golden, different length/channel count)
+ */
+bool compareRenders(const std::string &goldenPath,
+                    const std::string &currentPath, float &maxError) {
+  WavReader::WavData golden{};
+  WavReader::WavData current{};
+  if (!WavReader::readWavFile(goldenPath, golden, true) ||
+      !WavReader::readWavFile(currentPath, current, true))
+    return false;
+
+  if (golden.numChannels != current.numChannels ||
+      golden.sampleRate != current.sampleRate ||
+      golden.samples.size() != current.samples.size()) {
+    printf("Error: '%s' and '%s' differ in format or length\n",
+           goldenPath.c_str(), currentPath.c_str());
+    return false;
+  }
+
+  maxError = 0.0f;
+  for (size_t i = 0; i < golden.samples.size(); i++)
+    maxError =
+        std::max(maxError, std::fabs(golden.samples[i] - current.samples[i]));
+
+  // NaN/inf in the new render can never be within tolerance
+  if (!std::isfinite(maxError))
+    maxError = INFINITY;
+  return true;
+}
+// ==== </Render Helpers> ====
+
+double slowdownPercent(double seconds, double baselineSeconds) {
+  return (seconds / baselineSeconds - 1.0) * 100.0;
+}
+
+void printResult(const char *name, const CaseResult &result,
+                 bool isOutputChecked) {
+  char output[32] = "-";
+  if (isOutputChecked)
+    snprintf(output, sizeof(output), "%s %.1e",
+             result.isOutputOk ? "ok  " : "FAIL", result.maxError);
+
+  char time[48] = "no baseline";
+  if (result.baselineSeconds > 0.0)
+    snprintf(time, sizeof(time), "%s %+6.1f%% (base %.4fs)",
+             !result.isTimed ? "-   " : result.isTimeOk ? "ok  " : "FAIL",
+             slowdownPercent(result.seconds, result.baselineSeconds),
+             result.baselineSeconds);
+
+  printf("%-20s %-14s %9.4fs  %s\n", name, output, result.seconds, time);
+}
+
+int updateBaselines(const RegressOptions &options,
+                    const std::vector<RegressCase> &cases) {
+  std::string timingsPath = options.directory + "/" + TIMINGS_FILE;
+  std::map<std::string, double> timings = loadTimings(timingsPath);
+
+  for (const RegressCase &regressCase : cases) {
+    std::string goldenPath =
+        options.directory + "/" + regressCase.name + ".wav";
+
+    double seconds = 0.0;
+    if (!renderCaseTimed(options, regressCase, goldenPath, seconds))
+      return 1;
+
+    timings[regressCase.name] = seconds;
+    printf("%-20s recorded %9.4fs\n", regressCase.name.c_str(), seconds);
+  }
+
+  if (!saveTimings(timingsPath, timings)) {
+    printf("Error: Could not write '%s'\n", timingsPath.c_str());
+    return 1;
+  }
+  return 0;
+}
+
+int checkBaselines(const RegressOptions &options,
+                   const std::vector<RegressCase> &cases) {
+  std::string currentDirectory = options.directory + "/" + CURRENT_DIRECTORY;
+  if (!makeDirectories(currentDirectory)) {
+    printf("Error: Could not create '%s'\n", currentDirectory.c_str());
+    return 1;
+  }
+
+  std::map<std::string, double> timings =
+      loadTimings(options.directory + "/" + TIMINGS_FILE);
+
+  printf("%-20s %-14s %10s  %s\n", "case", "max error", "time", "vs baseline");
+
+  uint32_t numFailed = 0;
+  CaseResult total{};
+  total.isOutputOk = true;
+
+  for (const RegressCase &regressCase : cases) {
+    std::string goldenPath =
+        options.directory + "/" + regressCase.name + ".wav";
+    std::string currentPath = currentDirectory + "/" + regressCase.name + ".wav";
+
+    CaseResult result{};
+    if (!renderCaseTimed(options, regressCase, currentPath, result.seconds)) {
+      numFailed++;
+      total.isOutputOk = false;
+      continue;
+    }
+
+    result.isOutputOk =
+        compareRenders(goldenPath, currentPath, result.maxError) &&
+        result.maxError <= options.tolerance;
+
+    auto baseline = timings.find(regressCase.name);
+    if (baseline != timings.end() && baseline->second > 0.0) {
+      result.baselineSeconds = baseline->second;
+      total.seconds += result.seconds;
+      total.baselineSeconds += result.baselineSeconds;
+
+      result.isTimed = result.baselineSeconds * 1000.0 >= options.minTimeMs;
+      if (result.isTimed)
+        result.isTimeOk = slowdownPercent(result.seconds,
+                                          result.baselineSeconds) <=
+                          options.maxSlowdownPercent;
+    }
+
+    printResult(regressCase.name.c_str(), result, true);
+
+    if (!result.isOutputOk || !result.isTimeOk)
+      numFailed++;
+    total.isOutputOk = total.isOutputOk && result.isOutputOk;
+    total.maxError = std::max(total.maxError, result.maxError);
+  }
+
+  if (total.baselineSeconds > 0.0) {
+    total.isTimed = true;
+    total.isTimeOk = slowdownPercent(total.seconds, total.baselineSeconds) <=
+                     options.maxSlowdownPercent;
+    if (!total.isTimeOk)
+      numFailed++;
+  }
+  printResult("TOTAL", total, false);
+
+  if (numFailed > 0) {
+    printf("%u failure(s), renders kept in '%s'\n", numFailed,
+           currentDirectory.c_str());
+    return 1;
+  }
+
+  printf("All %zu cases passed\n", cases.size());
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  RegressOptions options{};
+  if (!parseOptions(argc, argv, options)) {
+    printUsage();
+    return 1;
+  }
+
+  std::vector<RegressCase> cases;
+  if (!loadCorpus(options.corpusPath, cases))
+    return 1;
+
+  if (!options.filter.empty())
+    cases.erase(std::remove_if(cases.begin(), cases.end(),
+                               [&](const RegressCase &regressCase) {
+                                 return regressCase.name.find(
+                                            options.filter) ==
+                                        std::string::npos;
+                               }),
+                cases.end());
+
+  if (cases.empty()) {
+    printf("Error: No cases to run\n");
+    return 1;
+  }
+
+  if (!makeDirectories(options.directory)) {
+    printf("Error: Could not create '%s'\n", options.directory.c_str());
+    return 1;
+  }
+
+  return options.isUpdate ? updateBaselines(options, cases)
+                          : checkBaselines(options, cases);
+}
@@ -0,0 +1,522 @@
+/* Offline (faster than real time) renderer
+ *
+ * Drives synth::Engine from a timestamped event file with no audio device
+ * and streams the result to a WAV file.
+ *
+ * Usage: render <events.txt> <output.wav> [options]
+ *   --sample-rate <hz>   default 48000
+ *   --render-rate <hz>   engine's internal rate (default: sample rate)
+ *   --frames <n>         render block size (default 512)
+ *   --tail <seconds>     render past the last event (default 2.0)
+ *   --workers <n>        voice worker threads (default 0), per layer
+ *                        render threads with --layer
+ *   --channels <1|2>     default 1 (mono folds the engine's L/R pair)
+ *   --format <fmt>       pcm16 (default), pcm24, float
+ *   --quality <tier>     draft, live, render (default)
+ *   --control-rate <n>   samples per engine block (default 64, 8-256)
+ *   --fast-control-rate <n>
+ *                        block size while modulation moves fast
+ *                        (default 0 = fixed control rate)
+ *   --preset <file>      patch to start from (terminal `preset save`)
+ *   --tuning <file.scl>  Scala scale (default 12-TET)
+ *   --keymap <file.kbm>  Scala keyboard mapping for --tuning
+ *   --layer <spec>       multitimbral layer (repeatable, see
+ *                        rack::parseLayerSpec), replaces --preset/--tuning
+ *
+ * Event file (one event per line, '#' starts a comment):
+ *   <seconds> on <midiNote> <velocity> [channel 1-16]
+ *   <seconds> off <midiNote> [channel 1-16]
+ *   <seconds> set <param> <value>   same names/values as the terminal `set`
+ *   <seconds> cc <number> <0-127>
+ *   <seconds> bend <-8192-8191>
+ *   <seconds> pressure <0-127>      channel aftertouch
+ *   <seconds> polypressure <midiNote> <0-127>
+ *   <seconds> end                   optional, fixes the render length
+ *
+ * Events are applied sample-accurately (blocks are split at event times).
+ */
+#include "synth/Engine.h"
+#include "synth/ParamBindings.h"
+#include "synth/Patch.h"
+#include "synth/Rack.h"
+#include "synth/Tuning.h"
+
+#include "synth_io/Events.h"
+#include "synth_io/SynthIO.h"
+
+#include "utils/WavWriter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+namespace pb = synth::param::bindings;
+
+enum class RenderEventType { NoteOn, NoteOff, Param, Controller, End };
+
+struct RenderEvent {
+  uint64_t frame;
+  RenderEventType type;
+  uint8_t midiNote;
+  uint8_t velocity;
+  uint8_t channel;
+  pb::ParamID paramID;
+  float paramValue;
+  uint16_t controllerID;
+  float controllerValue;
+};
+
+struct RenderOptions {
+  const char *eventPath = nullptr;
+  const char *outputPath = nullptr;
+  float sampleRate = 48000.0f;
+  float renderSampleRate = 0.0f; // 0 = sampleRate
+  uint32_t numFrames = synth_io::DEFAULT_FRAMES;
+  float tailSeconds = 2.0f;
+  uint32_t numVoiceWorkers = 0;
+  uint16_t numChannels = 1;
+  WavWriter::SampleFormat format = WavWriter::SampleFormat::PCM16;
+  synth::QualityMode quality = synth::QualityMode::Render;
+  uint32_t controlBlockSize = synth::DEFAULT_CONTROL_BLOCK_SIZE;
+  uint32_t fastControlBlockSize = 0;
+  const char *presetPath = nullptr;
+  const char *tuningPath = nullptr;
+  const char *keymapPath = nullptr;
+  synth::rack::LayerConfig layers[synth::rack::MAX_LAYERS];
+  uint32_t layerCount = 0;
+};
+
+constexpr uint16_t MAX_CHANNELS = 2;
+
+void printUsage() {
+  printf("Usage: render <events.txt> <output.wav> [options]\n");
+  printf("  --sample-rate <hz>   default 48000\n");
+  printf("  --render-rate <hz>   internal rate (default: sample rate)\n");
+  printf("  --frames <n>         block size (default %u)\n",
+         synth_io::DEFAULT_FRAMES);
+  printf("  --tail <seconds>     render past the last event (default 2.0)\n");
+  printf("  --workers <n>        voice (or --layer) worker threads "
+         "(default 0)\n");
+  printf("  --channels <1|2>     default 1\n");
+  printf("  --format <fmt>       pcm16 (default), pcm24, float\n");
+  printf("  --quality <tier>     draft, live, render (default)\n");
+  printf("  --control-rate <n>   samples per engine block (default %u)\n",
+         synth::DEFAULT_CONTROL_BLOCK_SIZE);
+  printf("  --fast-control-rate <n>\n"
+         "                       block size while modulation moves fast "
+         "(default 0 = off)\n");
+  printf("  --preset <file>      patch to start from\n");
+  printf("  --tuning <file.scl>  Scala scale (default 12-TET)\n");
+  printf("  --keymap <file.kbm>  Scala keyboard mapping for --tuning\n");
+  printf("  --layer <spec>       <preset|init>[,ch=N][,keys=LO-HI][,bus=N]"
+         "[,gain=G]\n");
+}
+
+bool parseSampleFormat(const char *value, WavWriter::SampleFormat &format) {
+  if (strcmp(value, "pcm16") == 0)
+    format = WavWriter::SampleFormat::PCM16;
+  else if (strcmp(value, "pcm24") == 0)
+    format = WavWriter::SampleFormat::PCM24;
+  else if (strcmp(value, "float") == 0)
+    format = WavWriter::SampleFormat::Float32;
+  else
+    return false;
+
+  return true;
+}
+
+bool parseQualityMode(const char *value, synth::QualityMode &quality) {
+  if (strcmp(value, "draft") == 0)
+    quality = synth::QualityMode::Draft;
+  else if (strcmp(value, "live") == 0)
+    quality = synth::QualityMode::Live;
+  else if (strcmp(value, "render") == 0)
+    quality = synth::QualityMode::Render;
+  else
+    return false;
+
+  return true;
+}
+
+bool parseOptions(int argc, char **argv, RenderOptions &options) {
+  if (argc < 3)
+    return false;
+
+  options.eventPath = argv[1];
+  options.outputPath = argv[2];
+
+  for (int i = 3; i + 1 < argc; i += 2) {
+    const char *flag = argv[i];
+    const char *value = argv[i + 1];
+
+    if (strcmp(flag, "--sample-rate") == 0)
+      options.sampleRate = std::strtof(value, nullptr);
+    else if (strcmp(flag, "--render-rate") == 0)
+      options.renderSampleRate = std::strtof(value, nullptr);
+    else if (strcmp(flag, "--frames") == 0)
+      options.numFrames = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+    else if (strcmp(flag, "--tail") == 0)
+      options.tailSeconds = std::strtof(value, nullptr);
+    else if (strcmp(flag, "--workers") == 0)
+      options.numVoiceWorkers =
+          static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+    else if (strcmp(flag, "--channels") == 0)
+      options.numChannels = static_cast<uint16_t>(
+          std::clamp(std::strtoul(value, nullptr, 10), 1ul,
+                     static_cast<unsigned long>(MAX_CHANNELS)));
+    else if (strcmp(flag, "--format") == 0) {
+      if (!parseSampleFormat(value, options.format)) {
+        printf("Error: Unknown format '%s'\n", value);
+        return false;
+      }
+    } else if (strcmp(flag, "--quality") == 0) {
+      if (!parseQualityMode(value, options.quality)) {
+        printf("Error: Unknown quality '%s'\n", value);
+        return false;
+      }
+    } else if (strcmp(flag, "--control-rate") == 0) {
+      options.controlBlockSize =
+          static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+    } else if (strcmp(flag, "--fast-control-rate") == 0) {
+      options.fastControlBlockSize =
+          static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+    } else if (strcmp(flag, "--preset") == 0) {
+      options.presetPath = value;
+    } else if (strcmp(flag, "--tuning") == 0) {
+      options.tuningPath = value;
+    } else if (strcmp(flag, "--keymap") == 0) {
+      options.keymapPath = value;
+    } else if (strcmp(flag, "--layer") == 0) {
+      if (options.layerCount == synth::rack::MAX_LAYERS) {
+        printf("Error: At most %u layers\n", synth::rack::MAX_LAYERS);
+        return false;
+      }
+      if (!synth::rack::parseLayerSpec(value,
+                                       options.layers[options.layerCount++]))
+        return false;
+    } else {
+      printf("Error: Unknown option '%s'\n", flag);
+      return false;
+    }
+  }
+
+  if (options.sampleRate <= 0.0f)
+    return false;
+
+  options.numFrames = std::max(options.numFrames, 1u);
+
+  return true;
+}
+
+// Returns false on a malformed line (reported with its line number)
+bool parseEventLine(const std::string &line, uint32_t lineNumber,
+                    float sampleRate, std::vector<RenderEvent> &events) {
+  std::istringstream iss(line.substr(0, line.find('#')));
+
+  double seconds = 0.0;
+  std::string cmd;
+  if (!(iss >> seconds)) {
+    if (iss.eof())
+      return true; // blank/comment line
+
+    printf("Error (line %u): Expected a time in seconds\n", lineNumber);
+    return false;
+  }
+
+  iss >> cmd;
+
+  RenderEvent event{};
+  event.frame = static_cast<uint64_t>(
+      std::llround(std::max(seconds, 0.0) * static_cast<double>(sampleRate)));
+
+  if (cmd == "on") {
+    int note = 0;
+    int velocity = 100;
+    int channel = 1;
+    iss >> note >> velocity >> channel;
+
+    event.type = RenderEventType::NoteOn;
+    event.midiNote = static_cast<uint8_t>(std::clamp(note, 0, 127));
+    event.velocity = static_cast<uint8_t>(std::clamp(velocity, 1, 127));
+    event.channel = static_cast<uint8_t>(std::clamp(channel, 1, 16) - 1);
+
+  } else if (cmd == "off") {
+    int note = 0;
+    int channel = 1;
+    iss >> note >> channel;
+
+    event.type = RenderEventType::NoteOff;
+    event.midiNote = static_cast<uint8_t>(std::clamp(note, 0, 127));
+    event.channel = static_cast<uint8_t>(std::clamp(channel, 1, 16) - 1);
+
+  } else if (cmd == "set") {
+    std::string paramName;
+    std::string value;
+    iss >> paramName >> value;
+
+    pb::ParamMapping param = pb::findParamByName(paramName.c_str());
+    if (param.id == pb::PARAM_COUNT) {
+      printf("Error (line %u): Unknown parameter '%s'\n", lineNumber,
+             paramName.c_str());
+      return false;
+    }
+
+    event.type = RenderEventType::Param;
+    event.paramID = param.id;
+    event.paramValue = pb::parseParamValue(param.type, value.c_str());
+
+  } else if (cmd == "cc" || cmd == "polypressure") {
+    int number = 0;
+    int value = 0;
+    iss >> number >> value;
+
+    uint16_t base = cmd == "cc" ? synth_io::CONTROLLER_CC
+                                : synth_io::CONTROLLER_POLY_PRESSURE;
+    event.type = RenderEventType::Controller;
+    event.controllerID =
+        static_cast<uint16_t>(base + std::clamp(number, 0, 127));
+    event.controllerValue =
+        static_cast<float>(std::clamp(value, 0, 127)) / 127.0f;
+
+  } else if (cmd == "bend") {
+    int value = 0;
+    iss >> value;
+
+    event.type = RenderEventType::Controller;
+    event.controllerID = synth_io::CONTROLLER_PITCH_BEND;
+    event.controllerValue =
+        static_cast<float>(std::clamp(value, -8192, 8191)) / 8192.0f;
+
+  } else if (cmd == "pressure") {
+    int value = 0;
+    iss >> value;
+
+    event.type = RenderEventType::Controller;
+    event.controllerID = synth_io::CONTROLLER_CHANNEL_PRESSURE;
+    event.controllerValue =
+        static_cast<float>(std::clamp(value, 0, 127)) / 127.0f;
+
+  } else if (cmd == "end") {
+    event.type = RenderEventType::End;
+
+  } else {
+    printf("Error (line %u): Invalid event '%s'\n", lineNumber, cmd.c_str());
+    return false;
+  }
+
+  events.push_back(event);
+  return true;
+}
+
+bool loadEvents(const char *path, float sampleRate,
+                std::vector<RenderEvent> &events) {
+  std::ifstream file(path);
+  if (!file) {
+    printf("Error: Could not open '%s'\n", path);
+    return false;
+  }
+
+  std::string line;
+  uint32_t lineNumber = 0;
+  while (std::getline(file, line)) {
+    if (!parseEventLine(line, ++lineNumber, sampleRate, events))
+      return false;
+  }
+
+  // Keep file order for events on the same frame
+  std::stable_sort(events.begin(), events.end(),
+                   [](const RenderEvent &a, const RenderEvent &b) {
+                     return a.frame < b.frame;
+                   });
+  return true;
+}
+
+uint64_t computeTotalFrames(const std::vector<RenderEvent> &events,
+                            const RenderOptions &options) {
+  for (const RenderEvent &event : events) {
+    if (event.type == RenderEventType::End)
+      return event.frame;
+  }
+
+  uint64_t lastFrame = events.empty() ? 0 : events.back().frame;
+  float tailSeconds = std::max(options.tailSeconds, 0.0f);
+  return lastFrame +
+         static_cast<uint64_t>(tailSeconds * options.sampleRate);
+}
+
+// Target: synth::Engine or synth::rack::Rack (same event interface)
+template <typename Target>
+void applyEvent(Target &engine, const RenderEvent &event) {
+  switch (event.type) {
+  case RenderEventType::NoteOn:
+    engine.processNoteEvent({synth_io::NoteEventType::NoteOn, event.midiNote,
+                             event.velocity, 0, 0, event.channel});
+    break;
+  case RenderEventType::NoteOff:
+    engine.processNoteEvent({synth_io::NoteEventType::NoteOff, event.midiNote,
+                             0, 0, 0, event.channel});
+    break;
+  case RenderEventType::Param:
+    engine.processParamEvent(
+        {static_cast<uint8_t>(event.paramID), event.paramValue});
+    break;
+  case RenderEventType::Controller:
+    engine.processControllerEvent({event.controllerID, event.controllerValue});
+    break;
+  case RenderEventType::End:
+    break;
+  }
+}
+
+// Target: synth::Engine or synth::rack::Rack
+template <typename Target>
+void renderEvents(Target &target, const std::vector<RenderEvent> &events,
+                  uint64_t totalFrames, const RenderOptions &options,
+                  WavWriter::WavStream &wavStream) {
+  std::vector<float> channelBuffers(MAX_CHANNELS * options.numFrames);
+  float *channels[MAX_CHANNELS] = {channelBuffers.data(),
+                                   channelBuffers.data() + options.numFrames};
+
+  uint64_t frame = 0;
+  size_t nextEvent = 0;
+
+  while (frame < totalFrames) {
+    while (nextEvent < events.size() && events[nextEvent].frame <= frame)
+      applyEvent(target, events[nextEvent++]);
+
+    // Split the block at the next event so it lands on its exact frame
+    uint64_t blockEnd = std::min(totalFrames, frame + options.numFrames);
+    if (nextEvent < events.size())
+      blockEnd = std::min(blockEnd, events[nextEvent].frame);
+
+    auto numFrames = static_cast<size_t>(blockEnd - frame);
+    target.processAudioBlock(channels, options.numChannels, numFrames);
+    WavWriter::writePlanar(wavStream, channels, numFrames);
+
+    frame = blockEnd;
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  RenderOptions options{};
+  if (!parseOptions(argc, argv, options)) {
+    printUsage();
+    return 1;
+  }
+
+  std::vector<RenderEvent> events;
+  if (!loadEvents(options.eventPath, options.sampleRate, events))
+    return 1;
+
+  uint64_t totalFrames = computeTotalFrames(events, options);
+  uint64_t maxFrames = static_cast<uint64_t>(INT32_MAX / 2) /
+                       (options.numChannels *
+                        WavWriter::bytesPerSample(options.format));
+  if (totalFrames >= maxFrames) {
+    printf("Error: Render too long for a WAV file\n");
+    return 1;
+  }
+
+  // ==== Engine ====
+  synth::EngineConfig engineConfig{};
+  engineConfig.sampleRate = options.sampleRate;
+  engineConfig.renderSampleRate = options.renderSampleRate;
+  engineConfig.numFrames = options.numFrames;
+  engineConfig.numVoiceWorkers = options.numVoiceWorkers;
+  engineConfig.quality = options.quality;
+  engineConfig.controlBlockSize = options.controlBlockSize;
+  engineConfig.fastControlBlockSize = options.fastControlBlockSize;
+
+  // Offline: every voice renders, whatever the machine load
+  engineConfig.isVoiceGovernorEnabled = false;
+
+  // Layers: one engine each (own patch), rendered side by side
+  synth::rack::Rack *rack = nullptr;
+  if (options.layerCount > 0) {
+    engineConfig.numVoiceWorkers = 0;
+    rack = synth::rack::createRack(engineConfig, options.layers,
+                                   options.layerCount, options.numVoiceWorkers);
+    if (!rack)
+      return 1;
+  }
+
+  synth::Engine *engine =
+      rack ? nullptr : synth::createEngine(engineConfig);
+
+  // Nothing renders yet: apply directly (no pointer swap needed)
+  if (engine && options.presetPath) {
+    synth::patch::Patch *patch =
+        synth::patch::loadPresetFile(*engine, options.presetPath);
+    if (!patch) {
+      synth::disposeEngine(engine);
+      return 1;
+    }
+
+    synth::patch::applyPatch(*engine, *patch);
+    synth::patch::disposePatch(patch);
+  }
+
+  // Applied at the start of the first block
+  if (engine && options.tuningPath) {
+    synth::tuning::ScalaScale scale{};
+    synth::tuning::KeyboardMapping mapping{};
+    synth::tuning::Tuning tuning{};
+    if (!synth::tuning::loadScalaFile(options.tuningPath, scale) ||
+        (options.keymapPath && !synth::tuning::loadKeyboardMappingFile(
+                                   options.keymapPath, mapping)) ||
+        !synth::tuning::buildTuning(scale, mapping, tuning)) {
+      printf("Error: Unusable tuning '%s'\n", options.tuningPath);
+      synth::disposeEngine(engine);
+      return 1;
+    }
+
+    synth::patch::postTuning(*engine, tuning);
+  }
+
+  // ==== Output ====
+  WavWriter::WavStream wavStream{};
+  if (!WavWriter::openWavStream(wavStream, options.outputPath,
+                                static_cast<int32_t>(options.sampleRate),
+                                options.numChannels, options.format)) {
+    printf("Error: Could not create '%s'\n", options.outputPath);
+    return 1;
+  }
+
+  // ==== Render loop ====
+  auto startTime = std::chrono::steady_clock::now();
+
+  if (rack)
+    renderEvents(*rack, events, totalFrames, options, wavStream);
+  else
+    renderEvents(*engine, events, totalFrames, options, wavStream);
+
+  if (!WavWriter::closeWavStream(wavStream)) {
+    printf("Error: Could not write '%s'\n", options.outputPath);
+    return 1;
+  }
+
+  auto elapsed = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - startTime)
+                     .count();
+  double audioSeconds =
+      static_cast<double>(totalFrames) / static_cast<double>(options.sampleRate);
+
+  printf("Rendered %.2fs of audio in %.4fs (%.1fx real time) -> %s\n",
+         audioSeconds, elapsed, elapsed > 0.0 ? audioSeconds / elapsed : 0.0,
+         options.outputPath);
+
+  synth::rack::disposeRack(rack);
+  synth::disposeEngine(engine);
+  return 0;
+}